@@ -36,16 +36,22 @@ if [ ! -d "${RESULT_DIR}" ];then
     exit -1
 fi
 
-if [ "$3" != "lp_solve" ] && [ "$3" != "cplex" ]
+if [ "$3" != "lp_solve" ] && [ "$3" != "cplex" ] && [ "$3" != "simplex" ]
 then
-    echo ">>> ERROR: Unknown solver: $3 !, waiting for lp_solve or cplex."
+    echo ">>> ERROR: Unknown solver: $3 !, waiting for lp_solve, cplex or simplex."
     exit -1
 fi
 
 if [ "$2" = "MIPS" ] || [ "$2" = "ARM" ]
 then
     cd ${RESULT_DIR}
-    sed  -e "s#BENCH_DIR#${RESULT_DIR}#g" -e "s/X_BENCH/$1/g" -e "s/_SOLVER_/$3/g"  -e "s#_CROSS_COMPILER_DIR_#/home/yixian/heptane_svn/CROSS_COMPILERS/$2/bin#g" /home/yixian/heptane_svn/config_files/configWCET_template_$2.xml > configWCET.xml
+    # The INTERFERENCE step of the template is commented out, unless HEPTANE_INTERFERENCE is set
+    INTERFERENCE=""
+    if [ -n "${HEPTANE_INTERFERENCE}" ]
+    then
+	INTERFERENCE='s#^<!-- \(<INTERFERENCE .*/>\) -->$#\1#'
+    fi
+    sed  -e "s#BENCH_DIR#${RESULT_DIR}#g" -e "s/X_BENCH/$1/g" -e "s/_SOLVER_/$3/g"  -e "s#_CROSS_COMPILER_DIR_#/home/yixian/heptane_svn/CROSS_COMPILERS/$2/bin#g" -e "${INTERFERENCE}" /home/yixian/heptane_svn/config_files/configWCET_template_$2.xml > configWCET.xml
     chmod gou+x configWCET.xml
     #echo "analysis.h The number of paras is \n$*\n"
     /home/yixian/heptane_svn/bin/HeptaneAnalysis $4 ./configWCET.xml | tee analysis_$2_$3.log
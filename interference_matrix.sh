@@ -0,0 +1,61 @@
+#!/bin/sh
+
+#---------------------------------------------------------------------
+#
+# Copyright IRISA, 2003-2017
+#
+# This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+# estimation.
+# APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+#
+# Heptane is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# Heptane is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details (COPYING.txt).
+#
+# See CREDITS.txt for credits of authorship
+#
+#---------------------------------------------------------------------
+
+# Analyses every benchmark once, with the INTERFERENCE step of the
+# template uncommented (it writes the footprint
+# benchmarks/<name>/<name>_footprint.bin), then combines all the
+# footprints into the interference matrices.
+
+if [ $# -lt 2 ]
+then
+    echo "usage: $0 arch solver [benchmark_name ...]"
+    exit 1
+fi
+
+ARCH=$1
+SOLVER=$2
+shift 2
+BENCHS="$*"
+if [ -z "${BENCHS}" ]
+then
+    BENCHS=`ls benchmarks`
+fi
+
+# The binaries are in the bin directory next to this script, unless HEPTANE_ROOT is set
+if [ -z "${HEPTANE_ROOT}" ]
+then
+    HEPTANE_ROOT=`dirname "$(readlink -f "$0")"`
+fi
+
+HEPTANE_INTERFERENCE=1
+export HEPTANE_INTERFERENCE
+FOOTPRINTS=""
+for b in ${BENCHS}
+do
+    ./extract.sh $b ${ARCH}
+    ./analysis.sh $b ${ARCH} ${SOLVER} -t
+    FOOTPRINTS="${FOOTPRINTS} benchmarks/$b/${b}_footprint.bin"
+done
+
+"${HEPTANE_ROOT}/bin/HeptaneInterfere" -o interference_matrix.txt ${FOOTPRINTS}
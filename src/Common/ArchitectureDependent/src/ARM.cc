@@ -53,21 +53,13 @@ ARM::ARM(const bool is_big_endian_p)
   zero_register_num = -1;	// No zero register
 
   // ------------------------------------------
-  // markers for ReadELF and Objdump files
+  // markers for Objdump files
   // ---------------------------------------
-  readelf_sections_markers.push_back("Section Headers:");
-  readelf_sections_markers.push_back("En-têtes de section:");
-
-  readelf_flags_markers.push_back("Key to Flags:");
-  readelf_flags_markers.push_back("Clé des fanions:");
-
   objdump_text_markers.push_back("Disassembly of section .text:");
   objdump_text_markers.push_back("Déassemblage de la section .text:");
 
-  objdump_symboltable_markers.push_back("SYMBOL TABLE:");
-
   // ------------------------------------------
-  // sections to be extracted in ReadELF file
+  // sections to be extracted from the binary
   // ------------------------------------------
   sectionsToExtract.push_back(".text");
   sectionsToExtract.push_back(".bss");
@@ -1732,76 +1724,56 @@ string ARM::getCalleeName(const ObjdumpInstruction & instr)
   return result;
 }
 
-void ARM::parseSymbolTableLine(const string & line, ObjdumpSymbolTable & table)
+void ARM::addSymbol(const ObjdumpSymbol & symbol, ObjdumpSymbolTable & table)
 {
-  /* We assume that the input line is in the format : Value  Location  Type  Section  Size  Name
-     for some lines, the field Type is empty */
-
-  string value, location, type, section, size, name;
-  istringstream parse(line);
-
-  // Extracting each field of the line. Several formats:
+  // Functions are the symbols of type function of the .text section, and the
+  // local symbols without type of the .text section, e.g.:
   // 000082e8 l       .text     00000000 .divsi3_skip_div0_test
   // 000082e0 g     F .text     00000000 .hidden __aeabi_idiv
   // 00008028 g     F .text     0000003c foo
-
-  // parse >> value >> location >> type >> section >> size >> name;
-  parse >> value >> location >> type;
-  if (type == ".text")
-    {
-      section = ".text";
-      type = "UNDEF";
-      parse >> size >> name;
-    }
-  else
-    parse >> section >> size >> name;
-  if (name == ".hidden")
-    parse >> name;		// Added LBesnard.
+  // The mapping symbols ($a, $t, $d, possibly followed by '.' and a suffix), which mark
+  // the start of arm code, thumb code or data, are ignored as by objdump.
+  const string & name = symbol.name;
+  if (name.size () >= 2 && name[0] == '$' && (name[1] == 'a' || name[1] == 't' || name[1] == 'd') && (name.size () == 2 || name[2] == '.'))
+    return;
 
   // Function
-  // if  (type == "F" && section ==".text")
-  if (section == ".text" && (type == "F" || (type == "UNDEF" && location == "l")))
+  if (symbol.section == ".text" && (symbol.type == SYMBOL_FUNCTION || (symbol.type == SYMBOL_NOTYPE && symbol.local)))
     {
-      assert(name != "");
+      assert(symbol.name != "");
       if (BTRACE)
-	cout << " value=" << value << ", location=" << location << ", type= " << type << ", section= " << section << ", size=" << size << ", name=" <<
-	    name << endl;
+	cout << " value=" << symbol.value << ", local=" << symbol.local << ", type= " << symbol.type << ", section= " << symbol.section << ", size=" << symbol.size << ", name=" <<
+	    symbol.name << endl;
 
-      // Converting the string to Unsigned Long
-      t_address addr = strtoul(value.c_str(), NULL, 16);
-      assert((addr != 0) && (addr != ULONG_MAX));
+      t_address addr = symbol.value;
+      assert(addr != 0);
       // Adding the function in the map
       // BUT WE MAY HAVE SAME VALUE FOR TWO FUNCTIONS..
       if (BTRACE)
 	{
 	  ListOfString lnames = table.functions[addr];
 	  if (!lnames.empty())
-	    cout << ">>>>>> Collision for " << name << " and " << *(lnames.begin()) << endl;
+	    cout << ">>>>>> Collision for " << symbol.name << " and " << *(lnames.begin()) << endl;
 	}
       // table.functions[addr] = name; replaced by (Lbesnard)
-      table.functions[addr].push_front(name);
+      table.functions[addr].push_front(symbol.name);
     }
   // Variable
-  else if (type == "O")
+  else if (symbol.type == SYMBOL_OBJECT)
     {
-      assert(section != "");
-      assert(size != "");
-      assert(name != "");
-
-      // Converting the string to Unsigned Long
-      t_address address = strtoul(value.c_str(), NULL, 16);
-      assert(address != 0 && address != ULONG_MAX);
+      assert(symbol.section != "");
+      assert(symbol.name != "");
 
-      // Converting the string to Integer
-      int size_var = (int)strtol(size.c_str(), NULL, 16);
-      assert(size_var != 0 && size_var != INT_MAX);
+      t_address address = symbol.value;
+      assert(address != 0);
+      assert(symbol.size != 0);
 
       // Searching the section of the variable in the vector of ObjdumpSymbolTable
       vector < ObjdumpSection >::const_iterator it;
 
       for (it = table.sections.begin(); it != table.sections.end(); it++)
 	{
-	  if ((*it).name == section)
+	  if ((*it).name == symbol.section)
 	    {
 	      break;
 	    }
@@ -1815,10 +1787,10 @@ void ARM::parseSymbolTableLine(const string & line, ObjdumpSymbolTable & table)
       assert(address >= (*it).addr && address < end_of_section);
 
       ObjdumpVariable var;
-      var.name = name;
+      var.name = symbol.name;
       var.addr = address;
-      var.size = size_var;	// in bytes
-      var.section_name = section;
+      var.size = symbol.size;	// in bytes
+      var.section_name = symbol.section;
 
       // Adding the variable in the vector
       table.variables.push_back(var);
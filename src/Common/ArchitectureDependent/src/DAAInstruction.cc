@@ -2,6 +2,10 @@
 #include "DAAInstruction.h"
 #include "Utl.h"
 #include "math.h"
+#include <sstream>
+#include <stdlib.h>
+#include <cassert>
+#include <algorithm>
 
 #define LOCTRACE(s)
  
@@ -25,210 +29,288 @@ DAAInstruction::~DAAInstruction()
 {
 }
 
-bool DAAInstruction::evalPlus(string &operand1, string &operand2, string &res)
+///-------------------------------
+/// AbstractValue
+///-------------------------------
+static int64_t gcd(int64_t a, int64_t b)
 {
-  int i, n;
-  long val;
-  string codop=" + ";
-  string elemOperand2;
-  
-  LOCTRACE( cout << " Try to simplify = (" << operand1 << ") " << codop << " (" << operand2  << ")" << endl);
-  if (! Utl::isDecNumber(operand1)) return false;
-  if (operand2.find("-") == EOS) 
+  if (a < 0) a = -a;
+  if (b < 0) b = -b;
+  while (b != 0)
     {
-      vector<string> vectOperand2 = Utl::split(operand2, string("+"));
-      if (! Utl::getIndexFirstValue( vectOperand2, &i)) return false;
-      elemOperand2 = vectOperand2[i];
-      n = vectOperand2.size();
-      if (! Utl::eval(operand1, codop, elemOperand2, &val)) return false;
-      vectOperand2[i] = Utl::int2cstring(val);
-      for (i=0; i<n;i++)
-	{
-	  if (i !=0) res = res + codop ;
-	  res = res + vectOperand2[i];
-	}
-      LOCTRACE(cout << " --> Returned value = " << res << endl);
-      return true;
+      int64_t r = a % b;
+      a = b;
+      b = r;
     }
+  return a;
+}
+
+AbstractValue::AbstractValue(t_value_base vbase, int64_t voffset, int64_t vstride, int64_t vcount):base(vbase), offset(voffset), stride(vstride), count(vcount), precise(true)
+{
+  if (base == BASE_NONE)
+    *this = AbstractValue();
+  else if (count <= 1 || stride == 0)
+    {
+      stride = 0;
+      count = 1;
+    }
+  else if (count > MAX_COUNT)
+    *this = AbstractValue(base, offset, false);
+}
+
+/** @return base + the sum of the offsets of v1 and v2, both precise: the strided hull of {o1 + o2}. */
+static AbstractValue sum(t_value_base base, const AbstractValue & v1, const AbstractValue & v2)
+{
+  int64_t offset = v1.offset + v2.offset;
+  if (v1.count == 1) return AbstractValue(base, offset, v2.stride, v2.count);
+  if (v2.count == 1) return AbstractValue(base, offset, v1.stride, v1.count);
+  int64_t g = gcd(v1.stride, v2.stride);
+  return AbstractValue(base, offset, g, (v1.lastOffset() - v1.offset + v2.lastOffset() - v2.offset) / g + 1);
+}
+
+/** @return the opposite of the offsets of v (precise). */
+static AbstractValue opposite(const AbstractValue & v)
+{
+  return AbstractValue(v.base, -v.lastOffset(), v.stride, v.count);
+}
+
+/** @return the offsets of v (precise) multiplied by c. */
+static AbstractValue scale(const AbstractValue & v, int64_t c)
+{
+  if (c == 0) return AbstractValue::constant(0);
+  AbstractValue r(v.base, v.offset * c, v.stride * c, v.count);
+  if (c < 0) r = AbstractValue(v.base, v.lastOffset() * c, -v.stride * c, v.count);
+  return r;
+}
+
+AbstractValue AbstractValue::immediate(const string & operand)
+{
+  int64_t v;
+  if (operand.length() == 0) return AbstractValue();
+  if (Utl::isDecNumber(operand))
+    v = atol(operand.c_str());
+  else if (Utl::isHexNumber(operand))
+    v = strtoul(operand.c_str(), NULL, 16);
+  else
+    return AbstractValue();
+  return constant(v);
+}
+
+bool AbstractValue::contains(const AbstractValue & v) const
+{
+  if (isUnknown()) return true;
+  if (v.base != base) return false;
+  if (!precise) return offset == v.offset;
+  if (!v.precise) return false;
+  if (v.offset < offset || v.lastOffset() > lastOffset()) return false;
+  if (count == 1) return true;	// v.offset == offset == v.lastOffset()
+  return (v.offset - offset) % stride == 0 && v.stride % stride == 0;
+}
+
+AbstractValue AbstractValue::join(const AbstractValue & v1, const AbstractValue & v2)
+{
+  if (v1.base != v2.base || v1.isUnknown()) return AbstractValue();
+  if (!v1.precise || !v2.precise)
+    return (v1.offset == v2.offset ? AbstractValue(v1.base, v1.offset, false) : AbstractValue());
+  if (v1.sameValue(v2)) return v1;
+  int64_t first = min(v1.offset, v2.offset);
+  int64_t last = max(v1.lastOffset(), v2.lastOffset());
+  int64_t g = gcd(gcd(v1.stride, v2.stride), v1.offset - v2.offset);
+  return AbstractValue(v1.base, first, g, (last - first) / g + 1);
+}
 
-  if (operand2.find("+") != EOS) return false;
-  vector<string> vectOperand2 = Utl::split(operand2, string("-"));
-  if (! Utl::getIndexFirstValue( vectOperand2, &i)) return false;
-  elemOperand2 = vectOperand2[i];
-  n = vectOperand2.size();
-  val = - atol (elemOperand2.c_str ());
-  val = val + atol (operand1.c_str ());
-  string nval = Utl::int2cstring(val);
-  int ireplace = i;
-  vectOperand2[ireplace] = nval;
-  for (i=0; i<n;i++)
+AbstractValue AbstractValue::widen(const AbstractValue & previous, const AbstractValue & entry, const AbstractValue & back, long maxiter)
+{
+  AbstractValue r = join(entry, back);
+  if (r.isUnknown()) return r;
+
+  // The bounds of back are the ones of previous moved by [dlo, dhi] (e.g. a pointer incremented at
+  // each iteration, or only on some paths): the values of the (at most maxiter) iterations.
+  if (maxiter > 0 && previous.precise && r.precise && previous.base == r.base)
     {
-      if (i == ireplace)
+      int64_t dlo = back.offset - previous.offset;
+      int64_t dhi = back.lastOffset() - previous.lastOffset();
+      if (dlo != 0 || dhi != 0)
 	{
-	  if (val != 0)
+	  int64_t n = maxiter - 1;
+	  int64_t first = min((int64_t) 0, n * dlo);
+	  int64_t last = max((int64_t) 0, n * dhi);
+	  int64_t g = gcd(gcd(dlo, dhi), back.stride);
+	  AbstractValue iterations(BASE_CONST, first, g, (last - first) / g + 1);
+	  if (iterations.precise)
 	    {
-	      if (val > 0) res = res + " + " ;
-	      res = res + vectOperand2[i];
+	      AbstractValue w = sum(r.base, entry, iterations);
+	      if (w.precise && w.contains(previous)) return w;
 	    }
 	}
-      else
-	{
-	  if (i !=0) res = res + " - " ;
-	  res = res + vectOperand2[i];
-	}
     }
-  LOCTRACE(cout << " --> Returned value = " << res << endl);
-  return true;
+
+  if (previous.contains(r)) return previous;
+  if (previous.isSingle()) return r;
+  if (previous.precise) return AbstractValue(entry.base, entry.offset, false);
+  return AbstractValue();
 }
 
+string AbstractValue::toString() const
+{
+  ostringstream os;
+  switch (base)
+    {
+    case BASE_NONE:
+      return "*";
+    case BASE_CONST:
+      os << offset;
+      break;
+    case BASE_LUI:
+      os << "0x" << std::hex << offset << std::dec << " lui";
+      break;
+    case BASE_SP:
+      os << "sp";
+      break;
+    case BASE_GP:
+      os << "gp";
+      break;
+    }
+  if (base == BASE_SP || base == BASE_GP)
+    {
+      if (offset > 0) os << " + " << offset;
+      if (offset < 0) os << " - " << -offset;
+    }
+  if (count > 1) os << " [" << stride << " x " << count << "]";
+  return os.str();
+}
 
+///-------------------------------
+/// AbstractStack
+///-------------------------------
+AbstractStack::AbstractStack(int vnbSlots):nbSlots(vnbSlots), slots(new slotMap())
+{
+}
 
-bool DAAInstruction::evalMinus(string &operand1, string &operand2, string &res)
+AbstractValue AbstractStack::get(int index) const
 {
-  int i, n;
-  long val;
-  string codop = " - ";
-  string elemOperand2;
+  assert(index >= 0 && index < nbSlots);
+  const slotMap & known = *slots;
+  slotMap::const_iterator it = known.find(index);
+  if (it == known.end()) return AbstractValue();
+  return it->second;
+}
 
-  LOCTRACE( cout << " Try to simplify = (" << operand1 << ") " << codop << " (" << operand2  << ")" << endl);
-  if (Utl::isDecNumber(operand1))
+void AbstractStack::set(int index, const AbstractValue & v)
+{
+  assert(index >= 0 && index < nbSlots);
+  const slotMap & known = getKnownSlots();
+  slotMap::const_iterator it = known.find(index);
+  // The slots are copied (when shared) only when they are actually modified.
+  if (v.isUnknown())
     {
-      if (operand2.find("+") != EOS) return false;
-  
-      vector<string> vectOperand2 = Utl::split(operand2, string("-"));
-      if (! Utl::getIndexFirstValue( vectOperand2, &i)) return false;
-      elemOperand2 = vectOperand2[i];
-      n = vectOperand2.size();
-
-      if (! Utl::eval(operand1, codop, elemOperand2, &val)) return false;
-      vectOperand2[i] = Utl::int2cstring(val);
-      for (i=0; i<n;i++)
-	{
-	  if (i !=0) res = res + codop ;
-	  res = res + vectOperand2[i];
-	}
-      LOCTRACE(cout << " --> Returned value = " << res << endl);
-      return true;
+      if (it != known.end()) slots->erase(index);
     }
-  if (Utl::isDecNumber(operand2))  // arg1 = sp - V1, operand2 = V2
+  else
+    if (it == known.end() || it->second != v)
+      (*slots)[index] = v;
+}
+
+void AbstractStack::join(const AbstractStack & s)
+{
+  assert(nbSlots == s.nbSlots);
+  if (slots == s.slots) return;
+  const slotMap & known = getKnownSlots();
+  const slotMap & known2 = s.getKnownSlots();
+  slotMap res;
+  slotMap::const_iterator it2;
+  for (slotMap::const_iterator it = known.begin(); it != known.end(); it++)
     {
-      if (operand1.find("+") == EOS)
+      it2 = known2.find(it->first);
+      if (it2 != known2.end())
 	{
-	  vector<string> vectOperand2 = Utl::split(operand1, string("-"));
-	  if (! Utl::getIndexFirstValue( vectOperand2, &i)) return false;
-	  elemOperand2 = vectOperand2[i];
-	  n = vectOperand2.size();
-	  string plus("+");
-	  if (! Utl::eval(operand2, plus, elemOperand2, &val)) return false;
-	  vectOperand2[i] = Utl::int2cstring(val);
-	  for (i=0; i<n;i++)
-	    {
-	      if (i !=0) res = res + codop ;
-	      res = res + vectOperand2[i];
-	    }
-	  LOCTRACE(cout << " --> Returned value = " << res << endl);
-	  return true;
+	  AbstractValue v = AbstractValue::join(it->second, it2->second);
+	  if (!v.isUnknown()) res[it->first] = v;
 	}
-      // Try to simplify = (sp + V0)  -  (V1)
-      if (operand1.find("-") != EOS) return false;
-      vector<string> vectOperand2 = Utl::split(operand1, string("+"));
-      if (! Utl::getIndexFirstValue( vectOperand2, &i)) return false;
-      elemOperand2 = vectOperand2[i];
-      n = vectOperand2.size();
-      
-      val = atol (elemOperand2.c_str ());
-      val = val - atol (operand2.c_str ());
-      string nval = Utl::int2cstring(val);
-      int ireplace = i;
-      vectOperand2[ireplace] = nval;
-      for (i=0; i<n;i++)
-	{
-	  if (i == ireplace)
-	    {
-	      if (val != 0)
-		{
-		  if (val > 0) res = res + " + " ;
-		  res = res + vectOperand2[i];
-		}
-	    }
-	  else
-	    {
-	      if (i !=0) res = res + " + " ;
-	      res = res + vectOperand2[i];
-	    }
-	}
-      LOCTRACE(cout << " --> Returned value = " << res << endl);
-      return true;
     }
-
-  return false;
+  if (res != known) slots = res;
 }
 
-/** For codop=+, 
-    - if operand1 is a decimal value
-    - if operand2 is a sum (S1 + ...+Sn) and it exists a decimal value S element of operand2,
-    then the sum of operand1 and S is computed and res = eval(operand1 + S) + elements of operands2 minus S.
-    @return true is the evaluation of operand1 codop operand2 is rewritten in res, false otherwise.
-*/
-bool DAAInstruction::eval(string &operand1, string &codop, string &operand2, string &res)
+void AbstractStack::widen(const AbstractStack & previous, const AbstractStack & back, long maxiter)
 {
-  // Useful for the access to an element of an array (MIPS, example "92" + "0x4lui + 9000").
-  if (codop.find("+") != EOS) return evalPlus(operand1, operand2,res);
-  if (codop.find("-") != EOS) return evalMinus(operand1, operand2,res);
-  return false;
+  assert(nbSlots == previous.nbSlots && nbSlots == back.nbSlots);
+  const slotMap & known = getKnownSlots();
+  slotMap res;
+  for (slotMap::const_iterator it = known.begin(); it != known.end(); it++)
+    {
+      AbstractValue v = AbstractValue::widen(previous.get(it->first), it->second, back.get(it->first), maxiter);
+      if (!v.isUnknown()) res[it->first] = v;
+    }
+  if (res != known) slots = res;
 }
 
+///-------------------------------
+/// DAAInstruction
+///-------------------------------
 
-string DAAInstruction::eval(string operand1, string codop, string operand2)
+/** Evaluation of operand1 codop operand2 (codop in {'+', '-', 'x'}), both operands being known:
+    - constants are computed (the strided hull of the results for strided constants),
+    - a constant is added to (or subtracted from) the offsets of a base (sp, gp, lui),
+    - otherwise the result is unknown.
+    When an operand is not precise, the result is "base + something" for the base (or the
+    address) of the other operand, and keeps its offset, so that it still designates the
+    same variable (e.g. a pointer incremented in a loop, see AbstractValue::widen).
+*/
+AbstractValue DAAInstruction::eval(const AbstractValue & operand1, char codop, const AbstractValue & operand2)
 {
-  long val;
-  string res;
-  if (Utl::eval(operand1, codop, operand2, &val)) return Utl::int2cstring(val);
-  if (eval(operand1, codop, operand2, res)) return res;
-  if ( codop.find("+") != EOS ) // commutativity for +
-    if (eval(operand2, codop, operand1, res)) return res;
-  return (operand1 + codop + operand2);
+  if (!operand1.precise || !operand2.precise)
+    {
+      if (codop == 'x') return AbstractValue();
+      if (operand1.isConstant() && operand2.isConstant())
+	{
+	  // the address is the largest constant
+	  const AbstractValue & address = (codop == '-' || llabs(operand1.offset) >= llabs(operand2.offset) ? operand1 : operand2);
+	  return AbstractValue(BASE_CONST, address.offset, false);
+	}
+      if (operand2.isConstant()) return AbstractValue(operand1.base, operand1.offset, false);
+      if (operand1.isConstant() && codop == '+') return AbstractValue(operand2.base, operand2.offset, false);
+      return AbstractValue();
+    }
+  if (operand1.isConstant() && operand2.isConstant())
+    {
+      if (codop == '+') return sum(BASE_CONST, operand1, operand2);
+      if (codop == '-') return sum(BASE_CONST, operand1, opposite(operand2));
+      if (operand2.count == 1) return scale(operand1, operand2.offset);
+      if (operand1.count == 1) return scale(operand2, operand1.offset);
+      return AbstractValue();
+    }
+  if (operand2.isConstant())
+    {
+      // Useful for the access to an element of an array (MIPS, example "92" + "0x4lui + 9000").
+      if (codop == '+') return sum(operand1.base, operand1, operand2);
+      if (codop == '-') return sum(operand1.base, operand1, opposite(operand2));
+    }
+  if (operand1.isConstant() && codop == '+') // commutativity for +
+    return sum(operand2.base, operand2, operand1);
+  return AbstractValue();
 }
 
-void DAAInstruction::localop(regTable & regs, regPrecisionTable & precision, string vop)
+void DAAInstruction::localop(regTable & regs, char vop)
 {
-  string operand1 = regs[num_register1];
-  string operand2 = regs[num_register2];
+  const AbstractValue & operand1 = regs[num_register1];
+  const AbstractValue & operand2 = regs[num_register2];
 
-  if (operand1 == "*")
-    {
-      regs[num_register0] = "*";
-      assert(!precision[num_register1]);
-    }
+  if (operand1.isUnknown() || operand2.isUnknown())
+    regs[num_register0] = AbstractValue();
   else
-    if (operand2 == "*")
-      {
-	regs[num_register0] = "*";
-	assert(!precision[num_register2]);
-      }
-    else
-      {
-	regs[num_register0] = eval(operand1, vop, operand2);
-	// bool b = precision[num_register1] && precision[num_register2];
-	// if (!b) cout << " assertion not satisfied " << endl;
-	// assert(b);
-      }
-  
-  precision[num_register0] = precision[num_register1] && precision[num_register2];
+    regs[num_register0] = eval(operand1, vop, operand2);
 }
 
 // Consider that all information on the first operand (num_register0) is lost
-void DAAInstruction::killop1(regTable & regs, regPrecisionTable & precision)
+void DAAInstruction::killop1(regTable & regs)
 {
-  regs[num_register0] = "*";
-  precision[num_register0] = false;
+  regs[num_register0] = AbstractValue();
 }
 
 // Consider that all information on the second operand is lost
-void DAAInstruction::killop2(regTable & regs, regPrecisionTable & precision)
+void DAAInstruction::killop2(regTable & regs)
 {
-  regs[num_register1] = "*";
-  precision[num_register1] = false;
+  regs[num_register1] = AbstractValue();
 }
 
 /**
@@ -236,159 +318,144 @@ void DAAInstruction::killop2(regTable & regs, regPrecisionTable & precision)
    - "unknown" if the operands are both unknown.
    - "+" if the operands are both known.
    - "unknown" otherwise when bAugmentPrecision is false.
-   - the value of the known operand when bAugmentPrecision is true.
+   - the value of the known operand, not precise, when bAugmentPrecision is true.
    (Damien 's note: this particular situation is to augment the precision of the analysis when accessing arrays (to detect
    that the array is accessed, even if the precise address in the array is not known)
 */
-void DAAInstruction::add(regTable & regs, regPrecisionTable & precision, bool bAugmentPrecision)
+void DAAInstruction::add(regTable & regs, bool bAugmentPrecision)
 {
 
   if (bAugmentPrecision)
     {
-      string operand1 = regs[num_register1];
-      string operand2 = regs[num_register2];
-      if (operand1 == "*" && operand2 == "*")
-	{
-	  regs[num_register0] = "*";
-	  assert(!precision[num_register1]);
-	  assert(!precision[num_register2]);
-	}
-      else if (operand1 == "*")
-	{
-	  regs[num_register0] = operand2;	// for induction variable
-	  assert(!precision[num_register1]);
-	}
-      else if (operand2 == "*")
-	{
-	  regs[num_register0] = operand1;	// for induction variable
-	  assert(!precision[num_register2]);
-	}
+      const AbstractValue & operand1 = regs[num_register1];
+      const AbstractValue & operand2 = regs[num_register2];
+      if (operand1.isUnknown() && operand2.isUnknown())
+	regs[num_register0] = AbstractValue();
+      else if (operand1.isUnknown())
+	regs[num_register0] = AbstractValue(operand2.base, operand2.offset, false);	// for induction variable
+      else if (operand2.isUnknown())
+	regs[num_register0] = AbstractValue(operand1.base, operand1.offset, false);	// for induction variable
       else
-	{
-	  regs[num_register0] = eval(operand1, " + ", operand2);
-	  //  removed for test lbesnard --- Jul 2017---
-	  // assert(precision[num_register1]);
-	  // assert(precision[num_register2]);
-	}
-
-      precision[num_register0] = precision[num_register1] && precision[num_register2];
+	regs[num_register0] = eval(operand1, '+', operand2);
     }
   else
-    localop(regs, precision, " + ");
+    localop(regs, '+');
 }
 
-void DAAInstruction::minus(regTable & regs, regPrecisionTable & precision)
+void DAAInstruction::minus(regTable & regs)
 {
-  localop(regs, precision, "- ");
+  localop(regs, '-');
 }
 
-void DAAInstruction::mult(regTable & regs, regPrecisionTable & precision)
+void DAAInstruction::mult(regTable & regs)
 {
-  localop(regs, precision, " x ");
+  localop(regs, 'x');
 }
 
 // Keep all information we add on source register on destination register    
-void DAAInstruction::move(regTable & regs, regPrecisionTable & precision)
+void DAAInstruction::move(regTable & regs)
 {
   regs[num_register0] = regs[num_register1];
-  precision[num_register0] = precision[num_register1];
 }
 
 // Loading a constant in a register.
-void DAAInstruction::loadConstant(regTable & regs, regPrecisionTable & precision, string vcste)
+void DAAInstruction::loadConstant(regTable & regs, const AbstractValue & vcste)
 {
-  regs[num_register0] = vcste;
-  precision[num_register0] = true;
+  regs[num_register0] = AbstractValue(vcste.base, vcste.offset, true);
 }
 
-void DAAInstruction::arithmetic_shift_right(regTable & regs, regPrecisionTable & precision)
+void DAAInstruction::arithmetic_shift_right(regTable & regs)
 {
-  killop1(regs, precision);	// NYI
+  killop1(regs);	// NYI
 }
 
 
-bool DAAInstruction::logical_shift(regTable & regs, regPrecisionTable & precision, bool bleft)
+bool DAAInstruction::logical_shift(regTable & regs, bool bleft)
 {
   int n,m,res;
 
-  if (precision[num_register1])
+  const AbstractValue & operand1 = regs[num_register1];
+  // Index of an array in a loop: (i << n) with i in a strided set of values.
+  if (bleft && operand1.precise && operand1.count > 1 && operand1.isConstant() && regs[num_register2].isSingle() && regs[num_register2].isConstant())
     {
-      string operand1 = regs[num_register1];
-      if (Utl::isDecNumber(operand1))
+      n = (int) regs[num_register2].offset;
+      if (n < 0 || n > 31) return false;
+      regs[num_register0] = scale(operand1, (int64_t) 1 << n);
+      return true;
+    }
+  if (operand1.isSingle() && operand1.isConstant())
+    {
+      m = (int) operand1.offset;
+      if (m == 0) 
 	{
-	  m = atoi (operand1.c_str());
-	  if (m == 0) 
-	    {
-	      regs[num_register0] = "0";
-	      precision[num_register0] = true;
-	      return true;
-	    }
-	  else
-	    if (Utl::getintvalue(regs[num_register2], &n))
+	  regs[num_register0] = AbstractValue::constant(0);
+	  return true;
+	}
+      else
+	if (regs[num_register2].isConstant())
+	  {
+	    n = (int) regs[num_register2].offset;
+	    if (bleft)
 	      {
-		if (bleft)
-		  {
-		    if (m < 0) res = -m << n; else res = m << n;
-		    LOCTRACE(cout << "  * Logical shift left( "<< m << ", " << n << ") = " << res << endl;);
-		  }
-		else
-		  {
-		    res = m >> n;
-		    LOCTRACE(cout << "  * Logical shift right( "<<  m << ", " << n << ") = " << res << endl;);
-		  }
-		regs[num_register0] = Utl::int2cstring(res);
-		precision[num_register0] = true;
-		return true;
+		if (m < 0) res = -m << n; else res = m << n;
+		LOCTRACE(cout << "  * Logical shift left( "<< m << ", " << n << ") = " << res << endl;);
 	      }
-	}
+	    else
+	      {
+		res = m >> n;
+		LOCTRACE(cout << "  * Logical shift right( "<<  m << ", " << n << ") = " << res << endl;);
+	      }
+	    regs[num_register0] = AbstractValue::constant(res);
+	    return true;
+	  }
     }
   return false;
 }
 
-void DAAInstruction::logical_shift_left(regTable & regs, regPrecisionTable & precision)
+void DAAInstruction::logical_shift_left(regTable & regs)
 {
-  if (!logical_shift(regs, precision, true))
-    killop1(regs, precision);
+  if (!logical_shift(regs, true))
+    killop1(regs);
 }
 
-void DAAInstruction::logical_shift_right(regTable & regs, regPrecisionTable & precision)
+void DAAInstruction::logical_shift_right(regTable & regs)
 {
- if (!logical_shift(regs, precision, false))
-   killop1(regs, precision);
+ if (!logical_shift(regs, false))
+   killop1(regs);
 }
 
-void DAAInstruction::rotate_right(regTable & regs, regPrecisionTable & precision)
+void DAAInstruction::rotate_right(regTable & regs)
 {
-  killop1(regs, precision);	// NYI
+  killop1(regs);	// NYI
 }
 
-void DAAInstruction::op_and(regTable & regs, regPrecisionTable & precision)
+void DAAInstruction::op_and(regTable & regs)
 {
-  killop1(regs, precision);	// NYI
+  killop1(regs);	// NYI
 }
 
-void DAAInstruction::op_or(regTable & regs, regPrecisionTable & precision)
+void DAAInstruction::op_or(regTable & regs)
 {
-  killop1(regs, precision);	// NYI
+  killop1(regs);	// NYI
 }
 
-void DAAInstruction::op_eor(regTable & regs, regPrecisionTable & precision)
+void DAAInstruction::op_eor(regTable & regs)
 {
-  killop1(regs, precision);	// NYI
+  killop1(regs);	// NYI
 }
 
-void DAAInstruction::op_bic(regTable & regs, regPrecisionTable & precision)
+void DAAInstruction::op_bic(regTable & regs)
 {
-  killop1(regs, precision);	// NYI
+  killop1(regs);	// NYI
 }
 
 /** It provides the value of the contents of a register shifted right one bit. 
     The old carry flag is shifted into bit[31]. 
     If the S suffix is present, the old bit[0] is placed in the carry flag.
 */
-void DAAInstruction::rotate_right_extended(regTable & regs, regPrecisionTable & precision)
+void DAAInstruction::rotate_right_extended(regTable & regs)
 {
-  killop1(regs, precision);	// NYI
+  killop1(regs);	// NYI
 }
 
 
@@ -46,8 +46,11 @@ Rq: The implementation is done for MIPS architecture only !!!
 *****************************************************************/
 #include <vector>
 #include <string>
+#include <map>
 #include <iostream>
+#include <stdint.h>
 #include "arch.h"
+#include "cow_ptr.h"
 
 using namespace std;
 
@@ -57,11 +60,184 @@ using namespace std;
 #ifndef DAAINSTRUCTION
 #define DAAINSTRUCTION
 
-typedef vector < bool > regPrecisionTable;
-typedef vector < string > regTable;
-typedef vector < string > stackType;
-typedef vector < bool > stackPrecType;
+/** Base of the contents of a register or of a stack slot (see AbstractValue) */
+typedef enum
+{
+  BASE_NONE,			///< unknown contents ("*")
+  BASE_SP,			///< stack pointer at the entry of the function ("sp + offset")
+  BASE_GP,			///< global pointer ("gp + offset", MIPS)
+  BASE_LUI,			///< absolute address built by a lui ("val lui + v", MIPS), offset is the address
+  BASE_CONST			///< constant value, offset is the value
+} t_value_base;
+
+/*!
+ * Contents of a register or of a stack slot for the address analysis:
+ * a base, a strided set of offsets from this base and a precision bit.
+ *
+ * The offsets are {offset + k * stride, 0 <= k < count}: a single
+ * offset when count is 1 (stride is then 0), the addresses of the
+ * elements of an array accessed in a loop otherwise (see join and
+ * widen).
+ *
+ * The precision is false when the contents is only known to be
+ * "base + something" (e.g. when accessing the elements of an array
+ * with an unknown index, see DAAInstruction::add); offset then
+ * locates the accessed variable. An unknown contents (BASE_NONE) is
+ * never precise.
+ */
+class AbstractValue
+{
+public:
+  t_value_base base;
+  int64_t offset;
+  int64_t stride;
+  int64_t count;
+  bool precise;
+
+  /** Maximal number of offsets of a strided value, the larger ones are not precise. */
+  static const int64_t MAX_COUNT = 1 << 20;
+
+  /** Unknown contents */
+  AbstractValue ():base (BASE_NONE), offset (0), stride (0), count (1), precise (false)
+  {
+  }
+
+  AbstractValue (t_value_base vbase, int64_t voffset, bool vprecise):base (vbase), offset (voffset), stride (0), count (1), precise (vprecise)
+  {
+    if (base == BASE_NONE)
+      {
+	offset = 0;
+	precise = false;
+      }
+  }
+
+  /** Precise strided value base + {voffset + k * vstride, 0 <= k < vcount} */
+  AbstractValue (t_value_base vbase, int64_t voffset, int64_t vstride, int64_t vcount);
+
+  /** @return a precise constant */
+  static AbstractValue constant (int64_t v)
+  {
+    return AbstractValue (BASE_CONST, v, true);
+  }
+
+  /** @return the value of an immediate operand (decimal or hexadecimal), unknown when it is not a number. */
+  static AbstractValue immediate (const string & operand);
+
+  bool isUnknown () const
+  {
+    return base == BASE_NONE;
+  }
+
+  bool isConstant () const
+  {
+    return base == BASE_CONST;
+  }
+
+  /** @return true if the value is precise and has a single offset. */
+  bool isSingle () const
+  {
+    return precise && count == 1;
+  }
+
+  /** @return the last offset of the value */
+  int64_t lastOffset () const
+  {
+    return offset + (count - 1) * stride;
+  }
+
+  /** @return true if v has the same base and offsets (the precision is not compared). */
+  bool sameValue (const AbstractValue & v) const
+  {
+    return base == v.base && offset == v.offset && stride == v.stride && count == v.count;
+  }
+
+  bool operator== (const AbstractValue & v) const
+  {
+    return sameValue (v) && precise == v.precise;
+  }
+
+  bool operator!= (const AbstractValue & v) const
+  {
+    return !(*this == v);
+  }
+
+  /** @return true if all the contents described by v are described by this value. */
+  bool contains (const AbstractValue & v) const;
+
+  /** @return the join of v1 and v2: the strided hull of their offsets when both are precise
+      with the same base, the common base and first offset not precise when one of them is not
+      precise, unknown otherwise. */
+  static AbstractValue join (const AbstractValue & v1, const AbstractValue & v2);
+
+  /** Widening at the head of a loop executed at most maxiter times for each entry in the loop.
+      previous is the former contents at the head, entry the join of the contents coming from
+      outside the loop and back the join of the contents coming from the backedges.
+      When the bounds of back are the ones of previous moved by [dlo, dhi] (e.g. a pointer
+      incremented by d at each iteration: dlo = dhi = d), the result is entry + [(maxiter-1) * dlo,
+      (maxiter-1) * dhi] (0 included). Otherwise it is the join of entry and back, made not precise
+      when it still grows.
+      @return a value that contains previous, entry and back when the loop bound holds. */
+  static AbstractValue widen (const AbstractValue & previous, const AbstractValue & entry, const AbstractValue & back, long maxiter);
+
+  /** Textual form used by the traces: "*", "val", "sp + val", "gp - val", "val lui", followed by
+      "[stride x count]" for a strided value */
+  string toString () const;
+};
 
+typedef vector < AbstractValue > regTable;
+
+/*!
+ * Contents of the stack frame of a function, indexed by slots of 4
+ * bytes (see the load/store instructions).
+ *
+ * Only the slots that have been written with a known value are kept,
+ * all the others are unknown. The slots are shared by the copies of
+ * a stack until one of them is modified (copy-on-write), so that the
+ * states of the nodes of a cfg do not duplicate the whole frame.
+ */
+class AbstractStack
+{
+public:
+  typedef map < int, AbstractValue > slotMap;
+
+  /** Stack of nbSlots unknown slots */
+  AbstractStack (int nbSlots = 0);
+
+  /** @return the number of slots of the frame */
+  int size () const
+  {
+    return nbSlots;
+  }
+
+  /** @return the contents of the slot index, in [0, size()[ */
+  AbstractValue get (int index) const;
+
+  /** Sets the contents of the slot index, in [0, size()[ */
+  void set (int index, const AbstractValue & v);
+
+  /** @return the slots with a known contents */
+  const slotMap & getKnownSlots () const
+  {
+    return *slots;
+  }
+
+  bool operator== (const AbstractStack & s) const
+  {
+    return nbSlots == s.nbSlots && slots == s.slots;
+  }
+
+  /** Join of the slots (see AbstractValue::join), the slots unknown in one of the stacks stay unknown. */
+  void join (const AbstractStack & s);
+
+  /** Widening at the head of a loop (see AbstractValue::widen): this stack is the join
+      of the stacks coming from outside the loop, previous the former stack at the head
+      and back the join of the stacks coming from the backedges. */
+  void widen (const AbstractStack & previous, const AbstractStack & back, long maxiter);
+
+private:
+  int nbSlots;
+  cow_ptr < slotMap > slots;
+};
 
 /*!  
  * Abstract class to define the methods for all categories of mips
@@ -79,26 +255,25 @@ class DAAInstruction
      * An instruction must implement a method simulate to compute
      * the state of registers after its execution.
      *
-     * regs contains the contents of the machine
-     * registers before the simulation of the instruction. In case some
-     * computation can be done on register contents, simulate keeps the
-     * computation in textual format (ex: "sp+4"). String "*" denote
-     * that nothing is known about the register (and then the precision
-     * for the given register is set to false).
+     * regs contains the contents of the machine registers before the
+     * simulation of the instruction. In case some computation can be
+     * done on register contents, simulate keeps its result as a base
+     * and an offset (ex: sp + 4, see AbstractValue). BASE_NONE denotes
+     * that nothing is known about the register (and then its
+     * precision is false).
      *
-     * asmInstr (input) contains the textual representation of the instruction
+     * There are situations where the contents of a register is known
+     * and its precision is set to false (see for instance,
+     * instructions of category add, used to compute offsets in arrays)
      *
-     * precision contains information on registers whose
-     * contents is known precisely. 
+     * vstack contains the contents of the stack frame.
      *
-     * There are situations where the contents of a register is not set
-     * to "*" and its precision is set to false (see for instance,
-     * instructions of category add, used to compute offsets in arrays)
+     * asmInstr (input) contains the textual representation of the instruction
      *
-     * Rq: regs and precision are modified by the simulate function
+     * Rq: regs and vstack are modified by the simulate function
      *
      */
-  virtual void simulate (regTable &regs, regPrecisionTable &precision, stackType &vstack,  stackPrecType &vStackPrecision, const string & asmInstr) = 0;
+  virtual void simulate (regTable &regs, AbstractStack &vstack, const string & asmInstr) = 0;
 
   /*! Virtual destructor */
   virtual ~ DAAInstruction () = 0;
@@ -106,35 +281,35 @@ class DAAInstruction
   /*! Returns all the operands of an asm instruction in a vector (i.e. simply parse the asm line) */
   static vector < string > getOperands (const string & instructionAsm);
 
-  void killop1(regTable &regs, vector < bool > &precision);
-  void killop2(regTable &regs, vector < bool > &precision);
-  void add(regTable &regs, regPrecisionTable &precision, bool bAugmentPrecision );
-  void minus(regTable &regs, regPrecisionTable &precision);
-  void mult(regTable &regs, regPrecisionTable &precision);
-  void move(regTable &regs, regPrecisionTable &precision);
-  void loadConstant(regTable &regs, regPrecisionTable &precision, string vcste);
-
-
-  void arithmetic_shift_right(regTable &regs, regPrecisionTable &precision);
-  void logical_shift_left(regTable &regs, regPrecisionTable &precision);
-  void logical_shift_right(regTable &regs, regPrecisionTable &precision);
-  void rotate_right(regTable &regs, regPrecisionTable &precision);
-  void rotate_right_extended(regTable &regs, regPrecisionTable &precision);
-
-  void op_and(regTable &regs, regPrecisionTable &precision);
-  void op_or (regTable &regs, regPrecisionTable &precision);
-  void op_eor(regTable &regs, regPrecisionTable &precision);
-  void op_bic(regTable &regs, regPrecisionTable &precision);
+  /*! Returns operand1 codop operand2 (codop in {'+', '-', 'x'}), both operands being known
+      (also used for the addresses of the memory accesses). */
+  static AbstractValue eval(const AbstractValue &operand1, char codop, const AbstractValue &operand2);
+
+  void killop1(regTable &regs);
+  void killop2(regTable &regs);
+  void add(regTable &regs, bool bAugmentPrecision );
+  void minus(regTable &regs);
+  void mult(regTable &regs);
+  void move(regTable &regs);
+  void loadConstant(regTable &regs, const AbstractValue &vcste);
+
+
+  void arithmetic_shift_right(regTable &regs);
+  void logical_shift_left(regTable &regs);
+  void logical_shift_right(regTable &regs);
+  void rotate_right(regTable &regs);
+  void rotate_right_extended(regTable &regs);
+
+  void op_and(regTable &regs);
+  void op_or (regTable &regs);
+  void op_eor(regTable &regs);
+  void op_bic(regTable &regs);
   bool getStackIndex(string &operand1, string &operand2, string &operand3, int *i);
 
  private:
-  void localop(regTable &regs, regPrecisionTable &precision, string vop);
-  bool eval(string &operand1, string &codop, string &operand2, string &res);
-  bool evalPlus(string &operand1, string &operand2, string &res);
-  bool evalMinus(string &operand1, string &operand2, string &res);
-  bool logical_shift(regTable & regs, regPrecisionTable & precision, bool bleft);   
+  void localop(regTable &regs, char vop);
+  bool logical_shift(regTable & regs, bool bleft);   
 
-  string eval(string operand1, string codop, string operand2);
 };
 
 #endif
@@ -19,12 +19,12 @@ using namespace std;
 #define NOT_YET_IMPLEMENTED "--- Not yet implemented ::simulate "
 
 
-void ARM_COMMON::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm)
+void ARM_COMMON::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
   assert(false);
 }
 
-void ARM_COMMON::simulateShifter(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,   string & operand1, string & operand2)
+void ARM_COMMON::simulateShifter(regTable & regs, AbstractStack & vstack, string & operand1, string & operand2)
 {
   string shiftOperator, shiftOperand;
 
@@ -42,7 +42,7 @@ void ARM_COMMON::simulateShifter(regTable & regs, regPrecisionTable & precision,
     }
   ARM_SHIFT *shifter = new ARM_SHIFT();
   string instr = shiftOperator + " raux, " + operand1 + ", " + shiftOperand;
-  shifter->simulate(regs, precision, vstack, vStackPrecision, instr);
+  shifter->simulate(regs, vstack, instr);
   num_register1 = Arch::getRegisterNumber("raux");
   TRACE( cout << " Shift operation = " << instr << endl);
 }
@@ -51,7 +51,7 @@ void ARM_COMMON::simulateShifter(regTable & regs, regPrecisionTable & precision,
    Setting the num of the operand registers for a < code_op Rr, R1, op2> instruction.
    The auxiliary register ARM_AUX_REGISTER is used for immediate values and for scaled register offset.
  */
-void ARM_COMMON::setRegistersInfos3ops(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision)
+void ARM_COMMON::setRegistersInfos3ops(regTable & regs, AbstractStack & vstack)
 {
   num_register0 = Arch::getRegisterNumber(oreg);	// result
   if (TypeOperand != none_offset)
@@ -60,8 +60,7 @@ void ARM_COMMON::setRegistersInfos3ops(regTable & regs, regPrecisionTable & prec
       if (TypeOperand == immediate_offset)	// OP Ri, Rj, #imm8r
 	{
 	  num_register2 = ARM_AUX_REGISTER;
-	  regs[num_register2] = operand2;
-	  precision[num_register2] = true;
+	  regs[num_register2] = AbstractValue::immediate(operand2);
 	}
       else if (TypeOperand == register_offset)	//  OP Ri, Rj, Rk
 	{
@@ -69,7 +68,7 @@ void ARM_COMMON::setRegistersInfos3ops(regTable & regs, regPrecisionTable & prec
 	}
       else if (TypeOperand == scaled_register_offset)	// OP Ri, Rj, Rk, shiftOperator shiftOperand
 	{
-	  simulateShifter(regs, precision, vstack, vStackPrecision, operand2, operand3);
+	  simulateShifter(regs, vstack, operand2, operand3);
 	}
       else
 	assert(false);
@@ -79,7 +78,7 @@ void ARM_COMMON::setRegistersInfos3ops(regTable & regs, regPrecisionTable & prec
 /**
    Setting the num of the operand registers for Multiply umull, smull, umlal, slmal instructions.
  */
-void ARM_COMMON::setRegistersInfosMultLong(regTable & regs, regPrecisionTable & precision)
+void ARM_COMMON::setRegistersInfosMultLong(regTable & regs)
 {
   num_register0 = Arch::getRegisterNumber(oreg);	// result
   num_register1 = Arch::getRegisterNumber(operand1);    // result also
@@ -91,7 +90,7 @@ void ARM_COMMON::setRegistersInfosMultLong(regTable & regs, regPrecisionTable &
    Setting the num of the operand registers for a < code_op Rr, op1> instruction ( ex: mov mvn cmp ...)
    The auxiliary register ARM_AUX_REGISTER is used for immediate values and for scaled register offset.
  */
-void ARM_COMMON::setRegistersInfos2ops(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision)
+void ARM_COMMON::setRegistersInfos2ops(regTable & regs, AbstractStack & vstack)
 {
   num_register0 = Arch::getRegisterNumber(oreg);	// result
 
@@ -100,8 +99,7 @@ void ARM_COMMON::setRegistersInfos2ops(regTable & regs, regPrecisionTable & prec
       if (TypeOperand == immediate_offset)	// OP Ri, #imm8r
 	{
 	  num_register1 = ARM_AUX_REGISTER;
-	  regs[num_register1] = operand1;
-	  precision[num_register1] = true;
+	  regs[num_register1] = AbstractValue::immediate(operand1);
 	}
       else if (TypeOperand == register_offset)	//  OP Ri, Rk
 	{
@@ -111,7 +109,7 @@ void ARM_COMMON::setRegistersInfos2ops(regTable & regs, regPrecisionTable & prec
 	{
 	  if (TypeOperand == scaled_register_offset)	//  OP Ri, Rk, shiftOperator shiftOperand
 	    {
-	      simulateShifter(regs, precision, vstack, vStackPrecision, operand1, operand2);
+	      simulateShifter(regs, vstack, operand1, operand2);
 	    }
 	  else
 	    assert(false);
@@ -120,7 +118,7 @@ void ARM_COMMON::setRegistersInfos2ops(regTable & regs, regPrecisionTable & prec
 }
 
 
-void ARM_ADD::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,   const string & instructionAsm)
+void ARM_ADD::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
   // add*, adc*
   string op = "add";
@@ -129,13 +127,13 @@ void ARM_ADD::simulate(regTable & regs, regPrecisionTable & precision, stackType
   if (Arch::getInstr2ARMInfos(vinstr, codeinstr, oreg, &TypeOperand, operand1, operand2, operand3))
     if (Arch::isARMClassInstr(codeinstr, op))
       {
-	setRegistersInfos3ops(regs, precision, vstack, vStackPrecision);
+	setRegistersInfos3ops(regs, vstack);
 	if (Arch::isConditionnedARMInstr(codeinstr, op))
-	  killop1(regs, precision);
+	  killop1(regs);
 	else
 	  {
 	    // add word : add R, pc, #value à traiter differemment... xxxxxxx
-	    add(regs, precision, precision[num_register1]);
+	    add(regs, regs[num_register1].precise);
 	  }
       }
     else
@@ -144,7 +142,7 @@ void ARM_ADD::simulate(regTable & regs, regPrecisionTable & precision, stackType
     ERROR_ACCESS("ARM_ADD", instructionAsm);
 }
 
-void ARM_SUBTRACT::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,   const string & instructionAsm)
+void ARM_SUBTRACT::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
   string op;
   // sub*, sbc*
@@ -155,19 +153,19 @@ void ARM_SUBTRACT::simulate(regTable & regs, regPrecisionTable & precision, stac
       op = "sub";
       if (Arch::isARMClassInstr(codeinstr, op))
 	{
-	  setRegistersInfos3ops(regs, precision, vstack, vStackPrecision);
+	  setRegistersInfos3ops(regs, vstack);
 	  if (Arch::isConditionnedARMInstr(codeinstr, op))
-	    killop1(regs, precision);
+	    killop1(regs);
 	  else
-	    minus(regs, precision);
+	    minus(regs);
 	}
       else
 	{
 	  string op = "sbc";	// subtract with carry
 	  if (Arch::isARMClassInstr(codeinstr, op))
 	    {
-	      setRegistersInfos3ops(regs, precision, vstack, vStackPrecision);
-	      killop1(regs, precision);
+	      setRegistersInfos3ops(regs, vstack);
+	      killop1(regs);
 	    }
 	  else
 	    ERROR_ACCESS("ARM_SUBTRACT_BAD_OPERATOR", instructionAsm);
@@ -177,7 +175,7 @@ void ARM_SUBTRACT::simulate(regTable & regs, regPrecisionTable & precision, stac
     ERROR_ACCESS("ARM_SUBTRACT", instructionAsm);
 }
 
-void ARM_REVERSE_SUB::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,   const string & instructionAsm)
+void ARM_REVERSE_SUB::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
   string op;
   // rsb*, rsc*
@@ -188,15 +186,15 @@ void ARM_REVERSE_SUB::simulate(regTable & regs, regPrecisionTable & precision, s
       op = "rsb";		// reverse subtract
       if (Arch::isARMClassInstr(codeinstr, op))
 	{
-	  setRegistersInfos3ops(regs, precision, vstack, vStackPrecision);
+	  setRegistersInfos3ops(regs, vstack);
 	  if (Arch::isConditionnedARMInstr(codeinstr, op))
-	    killop1(regs, precision);
+	    killop1(regs);
 	  else
 	    {
 	      int aux = num_register1;
 	      num_register1 = num_register2;
 	      num_register2 = aux;	/* swithing the operands */
-	      minus(regs, precision);
+	      minus(regs);
 	    }
 	}
       else
@@ -204,8 +202,8 @@ void ARM_REVERSE_SUB::simulate(regTable & regs, regPrecisionTable & precision, s
 	  string op = "rsc";	// reverse subtract with carry
 	  if (Arch::isARMClassInstr(codeinstr, op))
 	    {
-	      setRegistersInfos3ops(regs, precision, vstack, vStackPrecision);
-	      killop1(regs, precision);
+	      setRegistersInfos3ops(regs, vstack);
+	      killop1(regs);
 	    }
 	  else
 	    ERROR_ACCESS("ARM_REVERSE_BAD_OPERATOR", instructionAsm);
@@ -215,7 +213,7 @@ void ARM_REVERSE_SUB::simulate(regTable & regs, regPrecisionTable & precision, s
     ERROR_ACCESS("ARM_REVERSE_SUB", instructionAsm);
 }
 
-void ARM_MUL::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,   const string & instructionAsm)
+void ARM_MUL::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
   string op;
   string vinstr = instructionAsm;
@@ -226,11 +224,11 @@ void ARM_MUL::simulate(regTable & regs, regPrecisionTable & precision, stackType
       op = "mul";
       if (Arch::isARMClassInstr(codeinstr, op))
 	{
-	  setRegistersInfos3ops(regs, precision, vstack, vStackPrecision);
+	  setRegistersInfos3ops(regs, vstack);
 	  if (Arch::isConditionnedARMInstr(codeinstr, op))
-	    killop1(regs, precision);
+	    killop1(regs);
 	  else
-	    mult(regs, precision);
+	    mult(regs);
 	}
       else
 	{
@@ -238,14 +236,14 @@ void ARM_MUL::simulate(regTable & regs, regPrecisionTable & precision, stackType
 	  if (Arch::isARMClassInstr(codeinstr, op))
 	    {
 	      if (Arch::isConditionnedARMInstr(codeinstr, op))
-		killop1(regs, precision);
+		killop1(regs);
 	      else
 		{
 		  // mla Rd, Rm, Rs, Rn is simulated by R':= Rm x Rs, Rd := R' + Rn
 		  ARM_MUL *obj = new ARM_MUL();
-		  obj->simulate(regs, precision, vstack, vStackPrecision, "mul raux," + operand1 + " , " + operand2);
+		  obj->simulate(regs, vstack, "mul raux," + operand1 + " , " + operand2);
 		  ARM_ADD *obj_add = new ARM_ADD(); 
-		  obj_add->simulate(regs, precision, vstack, vStackPrecision, "add " + oreg + "raux, " + operand3);
+		  obj_add->simulate(regs, vstack, "add " + oreg + "raux, " + operand3);
 		}
 	    }
 	  else
@@ -254,9 +252,9 @@ void ARM_MUL::simulate(regTable & regs, regPrecisionTable & precision, stackType
 	      op = "smull";  // signed mult long: smull RdLo,RdHi,Rm,Rs is defined by (RdLo,RdHi) = signed(Rm*Rs)
 	      if (Arch::isARMClassInstr(codeinstr, op))
 		{
-		  setRegistersInfosMultLong(regs, precision);
-		  killop1(regs, precision);
-		  killop2(regs, precision);
+		  setRegistersInfosMultLong(regs);
+		  killop1(regs);
+		  killop2(regs);
 		  TRACE(cout << "Information on the output registers is lost for " << instructionAsm << endl);
 		}
 	      else
@@ -264,9 +262,9 @@ void ARM_MUL::simulate(regTable & regs, regPrecisionTable & precision, stackType
 		  op = "umull";  // unsigned mult long: umull RdLo,RdHi,Rm,Rs is defined by (RdLo,RdHi) = unsigned(Rm*Rs)
 		  if (Arch::isARMClassInstr(codeinstr, op))
 		    {
-		      setRegistersInfosMultLong(regs, precision);
-		      killop1(regs, precision);
-		      killop2(regs, precision);
+		      setRegistersInfosMultLong(regs);
+		      killop1(regs);
+		      killop2(regs);
 		      TRACE(cout << "Information on the output registers is lost for " << instructionAsm << endl);
 		    }
 		  else
@@ -274,9 +272,9 @@ void ARM_MUL::simulate(regTable & regs, regPrecisionTable & precision, stackType
 		      op = "umlal";  // unsigned mult with accumulate: umlal RdLo,RdHi,Rm,Rs is defined by (RdLo,RdHi) = unsigned((RdLo,RdHi) + Rm*Rs)
 		      if (Arch::isARMClassInstr(codeinstr, op))
 			{
-			  setRegistersInfosMultLong(regs, precision);
-			  killop1(regs, precision);
-			  killop2(regs, precision);
+			  setRegistersInfosMultLong(regs);
+			  killop1(regs);
+			  killop2(regs);
 			  TRACE(cout << "Information on the output registers is lost for " << instructionAsm << endl);
 			}
 		      else
@@ -284,9 +282,9 @@ void ARM_MUL::simulate(regTable & regs, regPrecisionTable & precision, stackType
 			  op = "smlal";  // signed mult with accumulate: smlal RdLo,RdHi,Rm,Rs is defined by (RdLo,RdHi) = signed((RdLo,RdHi) + Rm*Rs)
 			  if (Arch::isARMClassInstr(codeinstr, op))
 			    {
-			      setRegistersInfosMultLong(regs, precision);
-			      killop1(regs, precision);
-			      killop2(regs, precision);
+			      setRegistersInfosMultLong(regs);
+			      killop1(regs);
+			      killop2(regs);
 			      TRACE(cout << "Information on the output registers is lost for " << instructionAsm << endl);
 			    }
 			  else
@@ -301,25 +299,25 @@ void ARM_MUL::simulate(regTable & regs, regPrecisionTable & precision, stackType
     ERROR_ACCESS("ARM_MUL", instructionAsm);
 }
 
-void ARM_MOV::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,   const string & instructionAsm)
+void ARM_MOV::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
   string op;
   string vinstr = instructionAsm;
 
   if (Arch::getInstr1ARMInfos(vinstr, codeinstr, oreg, &TypeOperand, operand1, operand2))
     {
-      setRegistersInfos2ops(regs, precision, vstack, vStackPrecision);
+      setRegistersInfos2ops(regs, vstack);
       op = "mov";
       if (Arch::isARMClassInstr(codeinstr, op))
 	{
 	  if (Arch::isConditionnedARMInstr(codeinstr, op))
-	    killop1(regs, precision);
+	    killop1(regs);
 	  else
 	    {
 	      if (TypeOperand == immediate_offset)
-		loadConstant(regs, precision, regs[num_register1]);
+		loadConstant(regs, regs[num_register1]);
 	      else
-		move(regs, precision);
+		move(regs);
 	    }
 	}
       else
@@ -328,15 +326,15 @@ void ARM_MOV::simulate(regTable & regs, regPrecisionTable & precision, stackType
 	  if (Arch::isARMClassInstr(codeinstr, op))
 	    {
 	      if (Arch::isConditionnedARMInstr(codeinstr, op))
-		killop1(regs, precision);
+		killop1(regs);
 	      else
 		{
 		  if (TypeOperand == immediate_offset)
 		    {
-		      loadConstant(regs, precision, Utl::complement(regs[num_register1]));
+		      loadConstant(regs, AbstractValue::constant(~ (int) regs[num_register1].offset));
 		    }
 		  else
-		    killop1(regs, precision);
+		    killop1(regs);
 		}
 	    }
 	  else
@@ -347,7 +345,7 @@ void ARM_MOV::simulate(regTable & regs, regPrecisionTable & precision, stackType
     ERROR_ACCESS("ARM_MOV", instructionAsm);
 }
 
-void ARM_LOAD::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision, const string & instructionAsm)
+void ARM_LOAD::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
   // ldr* (32-bits) ; half-word (16-bits): ldrh*, ldrsh* ; byte(8-bits):  ldrb*, ldrsb* 
   // ldrt* ldrbt* used in non-user mode -- IGNORED
@@ -359,9 +357,9 @@ void ARM_LOAD::simulate(regTable & regs, regPrecisionTable & precision, stackTyp
   DAA_TRACE("ARM_LOAD", instructionAsm);
   if (Arch::getLoadStoreARMInfos(true, vinstr, codeinstr, oreg, &vIndexAddressing, &TypeOperand, operand1, operand2, operand3))
     {
-      setRegistersInfos2ops(regs, precision, vstack, vStackPrecision);
+      setRegistersInfos2ops(regs, vstack);
       if (TypeOperand != none_offset && (oreg != operand1))
-	killop1(regs, precision); // result is unknown
+	killop1(regs); // result is unknown
       else ; // ldr ri, [ri]
 
       int i;
@@ -373,19 +371,18 @@ void ARM_LOAD::simulate(regTable & regs, regPrecisionTable & precision, stackTyp
 	    num_register0 = Arch::getRegisterNumber(oreg);
 	    int vindex = indexStack -(i/4)-1;
 	    assert(vindex >= 0);
-	    regs[num_register0] = vstack[vindex];
-	    precision[num_register0] = vStackPrecision[vindex];
-	    TRACE ( cout << "DLOAD, indexStack = " << (indexStack) << " , index =" << vindex << ", Loading " << oreg << " = " << vstack[vindex] << " instr = " << instructionAsm << endl;);
+	    regs[num_register0] = vstack.get(vindex);
+	    TRACE ( cout << "DLOAD, indexStack = " << (indexStack) << " , index =" << vindex << ", Loading " << oreg << " = " << vstack.get(vindex).toString() << " instr = " << instructionAsm << endl;);
 	  }
       if (vIndexAddressing != pre_indexing)	// updating the second register.
 	{
 	  if (Arch::isConditionnedARMInstr(codeinstr, "ldr"))
-	    killop2(regs, precision);
+	    killop2(regs);
 	  else
 	    {
 	      // "LDR R0, [R1, #4]!"  or "LDR R0, [R1] #4". R1 := R1 + 4 after the memory transfert
 	      ARM_ADD *obj_add = new ARM_ADD();
-	      obj_add->simulate(regs, precision, vstack, vStackPrecision, "add " + operand1 + ", " + operand2 + "," + operand3);
+	      obj_add->simulate(regs, vstack, "add " + operand1 + ", " + operand2 + "," + operand3);
 	    }
 	}
     }
@@ -395,31 +392,29 @@ void ARM_LOAD::simulate(regTable & regs, regPrecisionTable & precision, stackTyp
 
 
 
-void ARM_PUSH::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,   const string & instructionAsm)
+void ARM_PUSH::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
   DAA_TRACE("ARM_PUSH", instructionAsm);
   int num_register_v0 = ARM_SP_REGISTER;
   int n = Arch::getNumberOfStores(instructionAsm) * 4;
-  ostringstream ossAddr;
-  ossAddr << n;
 
-  regs[num_register_v0] = regs[num_register_v0] + " + " + ossAddr.str();
+  const AbstractValue & sp = regs[num_register_v0];
+  regs[num_register_v0] = AbstractValue(sp.base, sp.offset + n, sp.precise);
 }
 
-void ARM_POP::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm)
+void ARM_POP::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
   DAA_TRACE("ARM_POP", instructionAsm);
 
   int num_register_v0 = ARM_SP_REGISTER;
   int n = Arch::getNumberOfLoads(instructionAsm) * 4;
-  ostringstream ossAddr;
-  ossAddr << n;
 
-  regs[num_register_v0] = regs[num_register_v0] + " - " + ossAddr.str();
+  const AbstractValue & sp = regs[num_register_v0];
+  regs[num_register_v0] = AbstractValue(sp.base, sp.offset - n, sp.precise);
 }
 
 // Kept, but now the "multiple loads" are rewritten in the Extract step.
-void ARM_LOAD_MULTIPLE::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,   const string & instructionAsm)
+void ARM_LOAD_MULTIPLE::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
   string icode, incr, icodeinit;
   string vinstr = instructionAsm;
@@ -441,7 +436,7 @@ void ARM_LOAD_MULTIPLE::simulate(regTable & regs, regPrecisionTable & precision,
 	  // LDM[IA] Rk, { Ro_1, ... Ro_n} is translated in : (  raux := Rk;  for i=1,n { Ro_i = [ raux ]; raux = raux + 4; end} )
 	  icodeinit = "ldr raux, [ " + oreg + "]";
 
-	  obj_load1->simulate(regs, precision, vstack, vStackPrecision, icodeinit);
+	  obj_load1->simulate(regs, vstack, icodeinit);
 	  TRACE(cout << instructionAsm << " simulée par:" << endl; cout << "            " << icodeinit << endl);
 
 	  obj_add = new ARM_ADD();
@@ -451,9 +446,9 @@ void ARM_LOAD_MULTIPLE::simulate(regTable & regs, regPrecisionTable & precision,
 	      icode = "ldr ";
 	      for ( i = 0; i < (*it).size(); i++) if ((*it)[i] != ' ') icode = icode + (*it)[i];
 	      icode = icode + ", [ raux ]";
-	      obj_load2->simulate(regs, precision, vstack, vStackPrecision, icode);
+	      obj_load2->simulate(regs, vstack, icode);
 	      incr = "add raux, raux, 4";
-	      obj_add->simulate(regs, precision, vstack, vStackPrecision, incr );
+	      obj_add->simulate(regs, vstack, incr );
 	      TRACE(cout << "            " << icode << "   " << incr << endl);
 	    }
 	}
@@ -463,7 +458,7 @@ void ARM_LOAD_MULTIPLE::simulate(regTable & regs, regPrecisionTable & precision,
 	    // LDMIB Rk, { Ro_1, ... Ro_n} is translated in : (  raux := Rk;  for i=1,n { raux = raux + 4; Ro_i = [ raux ];end} )
 	  icodeinit = "ldr raux, [ " + oreg + "]";
 
-	  obj_load1->simulate(regs, precision, vstack, vStackPrecision, icodeinit);
+	  obj_load1->simulate(regs, vstack, icodeinit);
 	  TRACE(cout << " ldr init = " << icodeinit << endl);
 
 	  obj_add = new ARM_ADD();
@@ -471,11 +466,11 @@ void ARM_LOAD_MULTIPLE::simulate(regTable & regs, regPrecisionTable & precision,
 	  for (it = regList.begin(); it != regList.end(); it++)
 	    {
 	      incr = "add raux, raux, 4";
-	      obj_add->simulate(regs, precision, vstack, vStackPrecision, incr );
+	      obj_add->simulate(regs, vstack, incr );
 	      icode = "ldr ";
 	      for ( i = 0; i < (*it).size(); i++) if ((*it)[i] != ' ') icode = icode + (*it)[i];
 	      icode = icode + ", [ raux ]";
-	      obj_load2->simulate(regs, precision, vstack, vStackPrecision, icode);
+	      obj_load2->simulate(regs, vstack, icode);
 	      TRACE( cout << "simulée par " << incr << "   " << icode << endl);
 	    }
 	    
@@ -486,11 +481,11 @@ void ARM_LOAD_MULTIPLE::simulate(regTable & regs, regPrecisionTable & precision,
 	    // LDMDA Rk, { Ro_1, ... Ro_n} is translated in : (  raux := Rk - |regs|*4 + 4;  for i=1,n {  Ro_i = [ raux ]; raux = raux - 4;end} )
 	    int n =  regList.size()*4 + 4;
 	    icodeinit = "ldr raux, [ " + oreg + "]";
-	    obj_load1->simulate(regs, precision, vstack, vStackPrecision, icodeinit);
+	    obj_load1->simulate(regs, vstack, icodeinit);
 
 	    incr = "sub raux, raux," + Utl::int2cstring(n);
 	    obj_sub = new ARM_SUBTRACT();
-	    obj_sub->simulate(regs, precision, vstack, vStackPrecision, incr );
+	    obj_sub->simulate(regs, vstack, incr );
 	    TRACE( cout << " ldr init = " << icodeinit << " " << incr << endl);
 
 	    obj_add = new ARM_ADD();
@@ -500,9 +495,9 @@ void ARM_LOAD_MULTIPLE::simulate(regTable & regs, regPrecisionTable & precision,
 		icode = "ldr ";
 		for ( i = 0; i < (*it).size(); i++) if ((*it)[i] != ' ') icode = icode + (*it)[i];
 		icode = icode + ", [ raux ]";
-		obj_load2->simulate(regs, precision, vstack, vStackPrecision, icode);
+		obj_load2->simulate(regs, vstack, icode);
 		incr = "sub raux, raux, 4";
-		obj_sub->simulate(regs, precision, vstack, vStackPrecision, incr );
+		obj_sub->simulate(regs, vstack, incr );
 		TRACE( cout << "simulée par " << incr << "   " << icode << endl);
 	      }
 	  }
@@ -512,11 +507,11 @@ void ARM_LOAD_MULTIPLE::simulate(regTable & regs, regPrecisionTable & precision,
 	    // LDMDB Rk, { Ro_1, ... Ro_n} is translated in : (  raux := Rk - |regs|*4;  for i=1,n { raux = raux - 4; Ro_i = [ raux ];;end} )
 	    int n =  regList.size()*4 ;
 	    icodeinit = "ldr raux, [ " + oreg + "]";
-	    obj_load1->simulate(regs, precision, vstack, vStackPrecision, icodeinit);
+	    obj_load1->simulate(regs, vstack, icodeinit);
 
 	    incr = "sub raux, raux," + Utl::int2cstring(n);
 	    obj_sub = new ARM_SUBTRACT();
-	    obj_sub->simulate(regs, precision, vstack, vStackPrecision, incr );
+	    obj_sub->simulate(regs, vstack, incr );
 	    
 	    TRACE( cout << " ldr init = " << icodeinit << " " << incr << endl);
 
@@ -525,11 +520,11 @@ void ARM_LOAD_MULTIPLE::simulate(regTable & regs, regPrecisionTable & precision,
 	    for (it = regList.begin(); it != regList.end(); it++)
 	      {
 		incr = "sub raux, raux, 4";
-		obj_sub->simulate(regs, precision, vstack, vStackPrecision, incr );
+		obj_sub->simulate(regs, vstack, incr );
 		icode = "ldr ";
 		for ( i = 0; i < (*it).size(); i++) if ((*it)[i] != ' ') icode = icode + (*it)[i];
 		icode = icode + ", [ raux ]";
-		obj_load2->simulate(regs, precision, vstack, vStackPrecision, icode);
+		obj_load2->simulate(regs, vstack, icode);
 		TRACE( cout << "simulée par " << incr << "   " << icode << endl);
 	      }
 	  }
@@ -542,7 +537,7 @@ void ARM_LOAD_MULTIPLE::simulate(regTable & regs, regPrecisionTable & precision,
 	{
 	  // Rk = raux;
 	  icodeinit = "ldr " + oreg + ",[raux]";
-	  obj_load1->simulate(regs, precision, vstack, vStackPrecision, icodeinit);
+	  obj_load1->simulate(regs, vstack, icodeinit);
 	}
 
     }
@@ -550,12 +545,12 @@ void ARM_LOAD_MULTIPLE::simulate(regTable & regs, regPrecisionTable & precision,
     ERROR_ACCESS(" ARM_LOAD_MULTIPLE", instructionAsm);
 }
 
-void ARM_BRANCH::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,   const string & instructionAsm)
+void ARM_BRANCH::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
   DAA_TRACE("ARM_BRANCH", instructionAsm);
 };
 
-void ARM_SHIFT::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,   const string & instructionAsm)
+void ARM_SHIFT::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
   string op;
   string vinstr = instructionAsm;
@@ -566,14 +561,14 @@ void ARM_SHIFT::simulate(regTable & regs, regPrecisionTable & precision, stackTy
 
   if (Arch::getInstr2ARMInfos(vinstr, codeinstr, oreg, &TypeOperand, operand1, operand2, operand3))
     {
-      setRegistersInfos3ops(regs, precision, vstack, vStackPrecision);
+      setRegistersInfos3ops(regs, vstack);
       op = "rrx";
       if (Arch::isARMClassInstr(codeinstr, op))
 	{
 	  if (Arch::isConditionnedARMInstr(codeinstr, op))
-	    killop1(regs, precision);
+	    killop1(regs);
 	  else
-	    rotate_right_extended(regs, precision);
+	    rotate_right_extended(regs);
 	}
       else
 	{
@@ -581,9 +576,9 @@ void ARM_SHIFT::simulate(regTable & regs, regPrecisionTable & precision, stackTy
 	  if (Arch::isARMClassInstr(codeinstr, op))
 	    {
 	      if (Arch::isConditionnedARMInstr(codeinstr, op))
-		killop1(regs, precision);
+		killop1(regs);
 	      else
-		arithmetic_shift_right(regs, precision);
+		arithmetic_shift_right(regs);
 	    }
 	  else
 	    {
@@ -591,9 +586,9 @@ void ARM_SHIFT::simulate(regTable & regs, regPrecisionTable & precision, stackTy
 	      if (Arch::isARMClassInstr(codeinstr, op))
 		{
 		  if (Arch::isConditionnedARMInstr(codeinstr, op))
-		    killop1(regs, precision);
+		    killop1(regs);
 		  else
-		    logical_shift_left(regs, precision);
+		    logical_shift_left(regs);
 		}
 	      else
 		{
@@ -601,9 +596,9 @@ void ARM_SHIFT::simulate(regTable & regs, regPrecisionTable & precision, stackTy
 		  if (Arch::isARMClassInstr(codeinstr, op))
 		    {
 		      if (Arch::isConditionnedARMInstr(codeinstr, op))
-			killop1(regs, precision);
+			killop1(regs);
 		      else
-			logical_shift_right(regs, precision);
+			logical_shift_right(regs);
 		    }
 		  else
 		    {
@@ -611,9 +606,9 @@ void ARM_SHIFT::simulate(regTable & regs, regPrecisionTable & precision, stackTy
 		      if (Arch::isARMClassInstr(codeinstr, op))
 			{
 			  if (Arch::isConditionnedARMInstr(codeinstr, op))
-			    killop1(regs, precision);
+			    killop1(regs);
 			  else
-			    rotate_right(regs, precision);
+			    rotate_right(regs);
 			}
 		      else
 			ERROR_ACCESS("ARM_SHIFT_BAD_OPERATOR", instructionAsm);
@@ -626,7 +621,7 @@ void ARM_SHIFT::simulate(regTable & regs, regPrecisionTable & precision, stackTy
     ERROR_ACCESS("(ARM_SHIFT ", instructionAsm);
 }
 
-void ARM_LOGICAL::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,   const string & instructionAsm)
+void ARM_LOGICAL::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
   // and*, orr*,eor*, bic* (and not)
   string op;
@@ -635,14 +630,14 @@ void ARM_LOGICAL::simulate(regTable & regs, regPrecisionTable & precision, stack
   DAA_TRACE("ARM_LOGICAL", instructionAsm);
   if (Arch::getInstr2ARMInfos(vinstr, codeinstr, oreg, &TypeOperand, operand1, operand2, operand3))
     {
-      setRegistersInfos3ops(regs, precision, vstack, vStackPrecision);
+      setRegistersInfos3ops(regs, vstack);
       op = "and";
       if (Arch::isARMClassInstr(codeinstr, op))
 	{
 	  if (Arch::isConditionnedARMInstr(codeinstr, op))
-	    killop1(regs, precision);
+	    killop1(regs);
 	  else
-	    op_and(regs, precision);
+	    op_and(regs);
 	}
       else
 	{
@@ -650,9 +645,9 @@ void ARM_LOGICAL::simulate(regTable & regs, regPrecisionTable & precision, stack
 	  if (Arch::isARMClassInstr(codeinstr, op))
 	    {
 	      if (Arch::isConditionnedARMInstr(codeinstr, op))
-		killop1(regs, precision);
+		killop1(regs);
 	      else
-		op_or(regs, precision);
+		op_or(regs);
 	    }
 	  else
 	    {
@@ -660,9 +655,9 @@ void ARM_LOGICAL::simulate(regTable & regs, regPrecisionTable & precision, stack
 	      if (Arch::isARMClassInstr(codeinstr, op))
 		{
 		  if (Arch::isConditionnedARMInstr(codeinstr, op))
-		    killop1(regs, precision);
+		    killop1(regs);
 		  else
-		    op_eor(regs, precision);
+		    op_eor(regs);
 		}
 	      else
 		{
@@ -670,9 +665,9 @@ void ARM_LOGICAL::simulate(regTable & regs, regPrecisionTable & precision, stack
 		  if (Arch::isARMClassInstr(codeinstr, op))
 		    {
 		      if (Arch::isConditionnedARMInstr(codeinstr, op))
-			killop1(regs, precision);
+			killop1(regs);
 		      else
-			op_bic(regs, precision);
+			op_bic(regs);
 		    }
 		  else
 		    ERROR_ACCESS("ARM_SHIFT_BAD_OPERATOR", instructionAsm);
@@ -688,7 +683,7 @@ void ARM_LOGICAL::simulate(regTable & regs, regPrecisionTable & precision, stack
    No effects on output register, but on the operand register in auto_indexing or post_indexing.
    Example : "STR R0, [R1, #4]!"  or "STR R0, [R1] #4". R1 := R1 + 4 after the memory transfert
 */
-void ARM_STORE::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,   const string & instructionAsm)
+void ARM_STORE::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
   string vinstr = instructionAsm;
   offsetType TypeOperand;
@@ -700,11 +695,11 @@ void ARM_STORE::simulate(regTable & regs, regPrecisionTable & precision, stackTy
       if (vIndexAddressing != pre_indexing)	// updating the second register.
 	{
 	  if (Arch::isConditionnedARMInstr(codeinstr, "str"))
-	    killop2(regs, precision);
+	    killop2(regs);
 	  else
 	    {
 	      ARM_ADD *obj_add = new ARM_ADD();
-	      obj_add->simulate(regs, precision, vstack, vStackPrecision, "add " + operand1 + ", " + operand2 + "," + operand3);
+	      obj_add->simulate(regs, vstack, "add " + operand1 + ", " + operand2 + "," + operand3);
 	    }
 	}
 
@@ -717,33 +712,32 @@ void ARM_STORE::simulate(regTable & regs, regPrecisionTable & precision, stackTy
 	      num_register0 = Arch::getRegisterNumber(oreg);
 	      int vindex = indexStack -(i/4)-1;
 	      assert(vindex >= 0);
-	      TRACE( cout << "DSTORE index =" << vindex << " , Store " <<  regs[num_register0] << " to stack [" <<  vindex << "]" << " instr = " << instructionAsm << endl;);
-	      vstack[vindex] =  regs[num_register0];
-	      vStackPrecision[vindex] = precision[num_register0];
+	      TRACE( cout << "DSTORE index =" << vindex << " , Store " <<  regs[num_register0].toString() << " to stack [" <<  vindex << "]" << " instr = " << instructionAsm << endl;);
+	      vstack.set(vindex, regs[num_register0]);
 	    }
     }
 }
 
-void ARM_COMPARE::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,   const string & instructionAsm)
+void ARM_COMPARE::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
   // DAA_TRACE("ARM_COMPARE", instructionAsm);
   // cpm*, cmn*, tst*; teq* : update the CPSR flags 
   // no effects on registers ( the flags are not managed , useful Damien ?)
 };
 
-void ARM_NOP::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,   const string & instructionAsm)
+void ARM_NOP::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
   //  No effects on registers 
   //  DAA_TRACE("ARM_NOP", instructionAsm);
 };
 
-void ARM_STORE_MULTIPLE::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,   const string & instructionAsm)
+void ARM_STORE_MULTIPLE::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
   // DAA_TRACE("ARM_STORE_MULTIPLE", instructionAsm);
   // No effects on registers
 };
 
-void ARM_TODO_LOIC::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,   const string & instructionAsm)
+void ARM_TODO_LOIC::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
   DAA_TRACE("ARM_TODO_LOIC", instructionAsm);
 };
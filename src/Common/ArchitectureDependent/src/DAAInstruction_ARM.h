@@ -14,12 +14,12 @@ class ARM_COMMON :public DAAInstruction
   string oreg, operand1, operand2, operand3;
   offsetType TypeOperand;
 
-  void simulateShifter(regTable &regs, regPrecisionTable &precision, stackType &vstack, stackPrecType &vStackPrecision,   string &operand1, string &operand2);
-  void setRegistersInfos2ops(regTable &regs, regPrecisionTable &precision, stackType &vstack, stackPrecType &vStackPrecision);
-  void setRegistersInfos3ops(regTable &regs, regPrecisionTable &precision, stackType &vstack, stackPrecType &vStackPrecision);
-  void setRegistersInfosMultLong(regTable & regs, regPrecisionTable & precision);
+  void simulateShifter(regTable & regs, AbstractStack & vstack, string &operand1, string &operand2);
+  void setRegistersInfos2ops(regTable & regs, AbstractStack & vstack);
+  void setRegistersInfos3ops(regTable & regs, AbstractStack & vstack);
+  void setRegistersInfosMultLong(regTable & regs);
  public:
-  void simulate (regTable &regs, regPrecisionTable &precision, stackType &vstack, stackPrecType &vStackPrecision,   const string &instructionAsm);
+  void simulate (regTable & regs, AbstractStack & vstack, const string &instructionAsm);
 
 };
 
@@ -29,7 +29,7 @@ class ARM_COMMON :public DAAInstruction
 class ARM_ADD:public ARM_COMMON
 {
  public:
-  void simulate (regTable &regs, regPrecisionTable &precision, stackType &vstack, stackPrecType &vStackPrecision,   const string &instructionAsm);
+  void simulate (regTable & regs, AbstractStack & vstack, const string &instructionAsm);
 };
 
 ///-------------------------------
@@ -38,7 +38,7 @@ class ARM_ADD:public ARM_COMMON
 class ARM_SUBTRACT:public ARM_COMMON
 {
  public:
-  void simulate (regTable &regs, regPrecisionTable &precision, stackType &vstack, stackPrecType &vStackPrecision,   const string &instructionAsm);
+  void simulate (regTable & regs, AbstractStack & vstack, const string &instructionAsm);
 };
 
 
@@ -48,7 +48,7 @@ class ARM_SUBTRACT:public ARM_COMMON
 class ARM_REVERSE_SUB:public ARM_COMMON
 {
  public:
-  void simulate (regTable &regs, regPrecisionTable &precision,  stackType &vstack, stackPrecType &vStackPrecision,   const string &instructionAsm);
+  void simulate (regTable & regs, AbstractStack & vstack, const string &instructionAsm);
 };
 
 ///-------------------------------
@@ -57,7 +57,7 @@ class ARM_REVERSE_SUB:public ARM_COMMON
 class ARM_MUL:public ARM_COMMON
 {
  public:
-  void simulate (regTable &regs, regPrecisionTable &precision,  stackType &vstack, stackPrecType &vStackPrecision,   const string &instructionAsm);
+  void simulate (regTable & regs, AbstractStack & vstack, const string &instructionAsm);
 };
 
 ///-------------------------------
@@ -66,7 +66,7 @@ class ARM_MUL:public ARM_COMMON
 class ARM_MOV:public  ARM_COMMON
 {
  public:
-  void simulate (regTable &regs, regPrecisionTable &precision,  stackType &vstack, stackPrecType &vStackPrecision,   const string &instructionAsm);
+  void simulate (regTable & regs, AbstractStack & vstack, const string &instructionAsm);
 };
 
 ///-------------------------------
@@ -75,18 +75,18 @@ class ARM_MOV:public  ARM_COMMON
 class ARM_LOAD:public ARM_COMMON
 {
  public:
-  void simulate (regTable &regs, regPrecisionTable &precision, stackType &vstack, stackPrecType &vStackPrecision,   const string &instructionAsm);
+  void simulate (regTable & regs, AbstractStack & vstack, const string &instructionAsm);
 };
 
 class ARM_LOAD_MULTIPLE:public ARM_COMMON
 {
  public:
-  void simulate (regTable &regs, regPrecisionTable &precision, stackType &vstack, stackPrecType &vStackPrecision,   const string &instructionAsm);
+  void simulate (regTable & regs, AbstractStack & vstack, const string &instructionAsm);
 };
 
 class ARM_POP:public DAAInstruction
 {
-  public:void simulate (regTable &regs, regPrecisionTable &precision,  stackType &vstack, stackPrecType &vStackPrecision,   const string &instructionAsm);
+  public:void simulate (regTable & regs, AbstractStack & vstack, const string &instructionAsm);
 };
 
 ///-------------------------------
@@ -94,7 +94,7 @@ class ARM_POP:public DAAInstruction
 ///-------------------------------
 class ARM_NOP:public DAAInstruction
 {
- public:void simulate (regTable &regs, regPrecisionTable &precision,  stackType &vstack, stackPrecType &vStackPrecision,   const string &instructionAsm);
+ public:void simulate (regTable & regs, AbstractStack & vstack, const string &instructionAsm);
 };
 
 ///-------------------------------
@@ -102,18 +102,18 @@ class ARM_NOP:public DAAInstruction
 ///-------------------------------
 class ARM_PUSH:public DAAInstruction
 {
-  public:void simulate (regTable &regs, regPrecisionTable &precision,  stackType &vstack, stackPrecType &vStackPrecision,   const string &instructionAsm);
+  public:void simulate (regTable & regs, AbstractStack & vstack, const string &instructionAsm);
 };
 
 
 class ARM_STORE:public  ARM_COMMON
 {
-  public:void simulate (regTable &regs, regPrecisionTable &precision,  stackType &vstack, stackPrecType &vStackPrecision,   const string &instructionAsm);
+  public:void simulate (regTable & regs, AbstractStack & vstack, const string &instructionAsm);
 };
 
 class ARM_STORE_MULTIPLE:public DAAInstruction
 {
-  public:void simulate (regTable &regs, regPrecisionTable &precision,  stackType &vstack, stackPrecType &vStackPrecision,   const string &instructionAsm);
+  public:void simulate (regTable & regs, AbstractStack & vstack, const string &instructionAsm);
 };
 
 ///-------------------------------
@@ -121,7 +121,7 @@ class ARM_STORE_MULTIPLE:public DAAInstruction
 ///-------------------------------
 class ARM_BRANCH:public DAAInstruction
 {
-  public:void simulate (regTable &regs, regPrecisionTable &precision,  stackType &vstack, stackPrecType &vStackPrecision,   const string &instructionAsm);
+  public:void simulate (regTable & regs, AbstractStack & vstack, const string &instructionAsm);
 };
 
 ///-------------------------------
@@ -129,7 +129,7 @@ class ARM_BRANCH:public DAAInstruction
 ///-------------------------------
 class  ARM_SHIFT:public  ARM_COMMON
 {
-  public:void simulate (regTable &regs, regPrecisionTable &precision,  stackType &vstack, stackPrecType &vStackPrecision,   const string &instructionAsm);
+  public:void simulate (regTable & regs, AbstractStack & vstack, const string &instructionAsm);
 };
 
 ///-------------------------------
@@ -137,7 +137,7 @@ class  ARM_SHIFT:public  ARM_COMMON
 ///-------------------------------
 class  ARM_LOGICAL:public ARM_COMMON
 {
-  public:void simulate (regTable &regs, regPrecisionTable &precision,  stackType &vstack, stackPrecType &vStackPrecision,   const string &instructionAsm);
+  public:void simulate (regTable & regs, AbstractStack & vstack, const string &instructionAsm);
 };
 
 ///-------------------------------
@@ -145,13 +145,13 @@ class  ARM_LOGICAL:public ARM_COMMON
 ///-------------------------------
 class  ARM_COMPARE:public DAAInstruction
 {
-  public:void simulate (regTable &regs, regPrecisionTable &precision,  stackType &vstack, stackPrecType &vStackPrecision,   const string &instructionAsm);
+  public:void simulate (regTable & regs, AbstractStack & vstack, const string &instructionAsm);
 };
 
 // for test.
 class ARM_TODO_LOIC:public DAAInstruction
 {
- public:void simulate (regTable &regs, regPrecisionTable &precision,  stackType &vstack, stackPrecType &vStackPrecision,   const string &instructionAsm);
+ public:void simulate (regTable & regs, AbstractStack & vstack, const string &instructionAsm);
 };
 
 
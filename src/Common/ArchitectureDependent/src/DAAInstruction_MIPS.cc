@@ -44,7 +44,7 @@ using namespace std;
 // registers -> no impact on address analysis
 //--------------------------------------------
 void
-Nop::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm)
+Nop::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
 }
 
@@ -54,7 +54,7 @@ Nop::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack,
 // Classes of instruction that load information from memory
 //
 //---------------------------------------------
-void DLoad::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm)
+void DLoad::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
   bool b;
   int i;
@@ -67,15 +67,14 @@ void DLoad::simulate(regTable & regs, regPrecisionTable & precision, stackType &
       num_register0 = Arch::getRegisterNumber(reg);
       int vindex = indexStack - (i/4)-1;
       assert(vindex >= 0);
-      LOCTRACE ( cout << "DLOAD, indexStack = " << (indexStack) << " , index =" << vindex << ", Loading " << reg << " = " << vstack[vindex] << " instr = " << instructionAsm << endl;);
-      regs[num_register0] = vstack[vindex];
-      precision[num_register0] = vStackPrecision[vindex];
+      LOCTRACE ( cout << "DLOAD, indexStack = " << (indexStack) << " , index =" << vindex << ", Loading " << reg << " = " << vstack.get(vindex).toString() << " instr = " << instructionAsm << endl;);
+      regs[num_register0] = vstack.get(vindex);
     }
   else
     {
       vector < string > operands = getOperands(instructionAsm);
       num_register0 = Arch::getRegisterNumber(operands[0]);
-      killop1(regs, precision);
+      killop1(regs);
     }
 }
 
@@ -86,7 +85,7 @@ void DLoad::simulate(regTable & regs, regPrecisionTable & precision, stackType &
 // Classes of instruction that load information from memory
 //
 //---------------------------------------------
-void DStore::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,   const string & instructionAsm)
+void DStore::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
   bool b;
   int i;
@@ -101,9 +100,8 @@ void DStore::simulate(regTable & regs, regPrecisionTable & precision, stackType
       num_register0 = Arch::getRegisterNumber(reg);
       int vindex = indexStack -(i/4)-1;
       assert(vindex >= 0);
-      LOCTRACE(  cout << "DSTORE index =" << vindex << " , Store " <<  regs[num_register0] << " to stack [" <<  vindex << "]" << " instr = " << instructionAsm << endl;);
-      vstack[vindex] =  regs[num_register0];
-      vStackPrecision[vindex] = precision[num_register0];
+      LOCTRACE(  cout << "DSTORE index =" << vindex << " , Store " <<  regs[num_register0].toString() << " to stack [" <<  vindex << "]" << " instr = " << instructionAsm << endl;);
+      vstack.set(vindex, regs[num_register0]);
     }
 }
 
@@ -115,15 +113,15 @@ void DStore::simulate(regTable & regs, regPrecisionTable & precision, stackType
 // because in the MIPS they kill the registers
 // used for the return values of functions
 //---------------------------------------------
-void DCall::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm)
+void DCall::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
   num_register0 = Arch::getRegisterNumber("v0");
   num_register1 = Arch::getRegisterNumber("v1");
 
   // Contents of registers $v0 and $v1, used to return function results,
   // are possibly destroyed, which is reflected in regs and precision
-  killop1(regs, precision);
-  killop2(regs, precision);
+  killop1(regs);
+  killop2(regs);
 }
 
 //---------------------------------------------
@@ -131,12 +129,12 @@ void DCall::simulate(regTable & regs, regPrecisionTable & precision, stackType &
 //
 // Transfer from register to register
 //---------------------------------------------
-void Move::simulate(regTable & regs, regPrecisionTable & precision,  stackType &vstack, stackPrecType &vStackPrecision, const string & instructionAsm)
+void Move::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
   vector < string > operands = getOperands(instructionAsm);
   num_register0 = Arch::getRegisterNumber(operands[0]);
   num_register1 = Arch::getRegisterNumber(operands[1]);
-  move(regs, precision);
+  move(regs);
 }
 
 //---------------------------------------------
@@ -151,11 +149,11 @@ void Move::simulate(regTable & regs, regPrecisionTable & precision,  stackType &
 // operand and not the first one, category KILL_OP2
 // should be used instead.
 //---------------------------------------------
-void KillOp1::simulate(regTable & regs, regPrecisionTable & precision,  stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm)
+void KillOp1::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
   vector < string > operands = getOperands(instructionAsm);
   num_register0 = Arch::getRegisterNumber(operands[0]);
-  killop1(regs, precision);
+  killop1(regs);
 }
 
 //---------------------------------------------
@@ -169,11 +167,11 @@ void KillOp1::simulate(regTable & regs, regPrecisionTable & precision,  stackTyp
 // In case the instruction kills the first register operand and not
 // the second one, category KILL_OP1 should be used instead.
 // ---------------------------------------------
-void KillOp2::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm)
+void KillOp2::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
   vector < string > operands = getOperands(instructionAsm);
   num_register1 = Arch::getRegisterNumber(operands[1]);
-  killop2(regs, precision);
+  killop2(regs);
 }
 
 ///------------------------------------------------------------
@@ -185,13 +183,13 @@ void KillOp2::simulate(regTable & regs, regPrecisionTable & precision, stackType
 //
 // Signed addition on registers
 //---------------------------------------------
-void Add::simulate(regTable & regs, regPrecisionTable & precision,stackType &vstack, stackPrecType &vStackPrecision,   const string & instructionAsm)
+void Add::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
   vector < string > operands = getOperands(instructionAsm);
   num_register0 = Arch::getRegisterNumber(operands[0]);
   num_register1 = Arch::getRegisterNumber(operands[1]);
   num_register2 = Arch::getRegisterNumber(operands[2]);
-  add(regs, precision, true);
+  add(regs, true);
 }
 
 //---------------------------------------------
@@ -200,7 +198,7 @@ void Add::simulate(regTable & regs, regPrecisionTable & precision,stackType &vst
 // Unsigned addition of immediate to register
 // (rt <- rs + immediate)
 //---------------------------------------------
-void Addiu::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm)
+void Addiu::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
   vector < string > operands = getOperands(instructionAsm);
  
@@ -212,9 +210,8 @@ void Addiu::simulate(regTable & regs, regPrecisionTable & precision, stackType &
       num_register0 = Arch::getRegisterNumber(operands[0]);
       num_register1 = Arch::getRegisterNumber(operands[1]);
       num_register2 = MIPS_AUX_REGISTER;
-      regs[num_register2] = operands[2];
-      precision[num_register2] = true;
-      add(regs, precision, false);
+      regs[num_register2] = AbstractValue::immediate(operands[2]);
+      add(regs, false);
     }
 }
 
@@ -257,13 +254,13 @@ void Subu::simulate(vector<string>& regs, vector<bool>& precision, stackType &vs
 }
 */
 
-void Subu::simulate(regTable & regs, regPrecisionTable & precision,stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm)
+void Subu::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
   vector < string > operands = getOperands(instructionAsm);
   num_register0 = Arch::getRegisterNumber(operands[0]);
   num_register1 = Arch::getRegisterNumber(operands[1]);
   num_register2 = Arch::getRegisterNumber(operands[2]);
-  minus(regs, precision);
+  minus(regs);
 }
 
 ///------------------------------------------------------------
@@ -273,35 +270,35 @@ void Subu::simulate(regTable & regs, regPrecisionTable & precision,stackType &vs
 ///-------------------------------
 ///     LUI
 ///-------------------------------
-void Lui::simulate(regTable & regs, regPrecisionTable & precision,stackType &vstack, stackPrecType &vStackPrecision,  const string & instructionAsm)
+void Lui::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
   vector < string > operands = getOperands(instructionAsm);
   num_register0 = Arch::getRegisterNumber(operands[0]);
-  // the lui flag is used to specify that the immediate value must be shifted left 16 bits.
-  loadConstant(regs, precision, operands[1] + "lui");
+  // the immediate value is shifted left 16 bits, the lui base denotes an absolute address.
+  AbstractValue imm = AbstractValue::immediate(operands[1]);
+  loadConstant(regs, (imm.isUnknown() ? imm : AbstractValue(BASE_LUI, imm.offset << 16, true)));
 }
 
 ///-------------------------------
 ///     LI
 ///-------------------------------
-void Li::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision, const string & instructionAsm)
+void Li::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
   vector < string > operands = getOperands(instructionAsm);
   num_register0 = Arch::getRegisterNumber(operands[0]);
-  loadConstant(regs, precision, operands[1]);
+  loadConstant(regs, AbstractValue::immediate(operands[1]));
 }
 
 
 /// SHIFT 
 // ssl R1,R2,i with i in [0,31], ssl v0,v0,0  is a nop.
-void Shift::simulate(regTable & regs, regPrecisionTable & precision, stackType &vstack, stackPrecType &vStackPrecision, const string & instructionAsm)
+void Shift::simulate(regTable & regs, AbstractStack & vstack, const string & instructionAsm)
 {
   vector < string > operands = getOperands(instructionAsm);
   num_register0 = Arch::getRegisterNumber(operands[0]);
   num_register1 = Arch::getRegisterNumber(operands[1]);
   num_register2 = MIPS_AUX_REGISTER;
-  regs[num_register2] = operands[2];
-  precision[num_register2] = true;
+  regs[num_register2] = AbstractValue::immediate(operands[2]);
   //   num_register2 = Arch::getRegisterNumber(operands[2]);
-  logical_shift_left(regs, precision);
+  logical_shift_left(regs);
 }
@@ -72,7 +72,7 @@ using namespace std;
 //--------------------------------------------
 class Nop:public DAAInstruction
 {
-  public:void simulate (vector < string > &, vector < bool > &,stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (regTable &, AbstractStack &, const string &);
 };
 
 
@@ -83,7 +83,7 @@ class Nop:public DAAInstruction
 //---------------------------------------------
 class DLoad:public DAAInstruction
 {
-  public:void simulate (vector < string > &, vector < bool > &,stackType &vstack, stackPrecType &vStackPrecision,   const string &);
+  public:void simulate (regTable &, AbstractStack &, const string &);
 };
 
 
@@ -94,7 +94,7 @@ class DLoad:public DAAInstruction
 //---------------------------------------------
 class DStore:public DAAInstruction
 {
- public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+ public:void simulate (regTable &, AbstractStack &, const string &);
 };
 
 //---------------------------------------------
@@ -107,7 +107,7 @@ class DStore:public DAAInstruction
 //---------------------------------------------
 class DCall:public DAAInstruction
 {
-  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (regTable &, AbstractStack &, const string &);
 };
 
 //---------------------------------------------
@@ -117,7 +117,7 @@ class DCall:public DAAInstruction
 //---------------------------------------------
 class Move:public DAAInstruction
 {
-  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (regTable &, AbstractStack &, const string &);
 };
 
 //---------------------------------------------
@@ -134,7 +134,7 @@ class Move:public DAAInstruction
 //---------------------------------------------
 class KillOp1:public DAAInstruction
 {
-  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (regTable &, AbstractStack &, const string &);
 };
 
 //---------------------------------------------
@@ -150,7 +150,7 @@ class KillOp1:public DAAInstruction
 // ---------------------------------------------
 class KillOp2:public DAAInstruction
 {
-  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (regTable &, AbstractStack &, const string &);
 };
 
 ///------------------------------------------------------------
@@ -164,7 +164,7 @@ class KillOp2:public DAAInstruction
 //---------------------------------------------
 class Add:public DAAInstruction
 {
-  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (regTable &, AbstractStack &, const string &);
 };
 
 //---------------------------------------------
@@ -175,7 +175,7 @@ class Add:public DAAInstruction
 //---------------------------------------------
 class Addiu:public DAAInstruction
 {
-  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (regTable &, AbstractStack &, const string &);
 };
 
 //---------------------------------------------
@@ -185,7 +185,7 @@ class Addiu:public DAAInstruction
 //---------------------------------------------
 class Subu:public DAAInstruction
 {
-  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (regTable &, AbstractStack &, const string &);
 };
 
 ///------------------------------------------------------------
@@ -197,7 +197,7 @@ class Subu:public DAAInstruction
 ///-------------------------------
 class Lui:public DAAInstruction
 {
-  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (regTable &, AbstractStack &, const string &);
 };
 
 ///-------------------------------
@@ -205,7 +205,7 @@ class Lui:public DAAInstruction
 ///-------------------------------
 class Li:public DAAInstruction
 {
-  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (regTable &, AbstractStack &, const string &);
 };
 
 ///-------------------------------
@@ -213,7 +213,7 @@ class Li:public DAAInstruction
 ///-------------------------------
 class Shift:public DAAInstruction
 {
-  public:void simulate (vector < string > &, vector < bool > &, stackType &vstack, stackPrecType &vStackPrecision,  const string &);
+  public:void simulate (regTable &, AbstractStack &, const string &);
 };
 
 #endif
@@ -0,0 +1,96 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+
+/*****************************************************************
+
+                         DecodedInstruction
+
+    Result of the decoding of the asm code of an instruction
+    (mnemonic operands), computed once by Arch::decode.
+
+    The analyses query this record instead of parsing the asm
+    code again (split of the operands, lookup of the mnemonic)
+    each time a property of the instruction is needed.
+
+    The resources (registers, "mem", functional units) are
+    numbered by Arch::getResourceId: identical names have the
+    same identifier, so that the dependencies can be checked
+    on the identifiers or on the masks.
+
+ *****************************************************************/
+
+#ifndef DECODED_INSTRUCTION_H
+#define DECODED_INSTRUCTION_H
+
+#include <string>
+#include <vector>
+#include <bitset>
+
+using namespace std;
+
+class InstructionType;
+
+/*! Maximum number of resource identifiers (see Arch::getResourceId) */
+#define MAX_DECODED_RESOURCES 256
+
+/*! Set of resources, indexed by resource identifier */
+typedef bitset < MAX_DECODED_RESOURCES > ResourceSet;
+
+class DecodedInstruction
+{
+public:
+  /*! asm code of the instruction */
+  string code;
+
+  /*! mnemonic, its identifier (see Arch::decode) and InstructionType */
+  string mnemonic;
+  int mnemonicId;
+  InstructionType *type;
+
+  /*! Arch::isLoad (pc loads excluded) and Arch::isStore */
+  bool load, store;
+
+  /*! Arch::getSizeOfMemoryAccess, 0 for the instructions which are neither loads nor stores */
+  int accessSize;
+
+  /*! Arch::getLatency */
+  int latency;
+
+  /*! false if the operands match no format of the InstructionType (resources not decoded) */
+  bool hasFormat;
+
+  /*! Arch::getResourceInputs, Arch::getResourceOutputs, Arch::getResourceFunctionalUnits
+      (same order, duplicates included) */
+  vector < string > inputs, outputs, functionalUnits;
+
+  /*! identifiers of inputs, outputs and functionalUnits */
+  vector < int > inputIds, outputIds, functionalUnitIds;
+
+  /*! sets of the input and output resources */
+  ResourceSet inputMask, outputMask;
+
+  DecodedInstruction ():mnemonicId (-1), type (NULL), load (false), store (false), accessSize (0), latency (0), hasFormat (false)
+  {
+  }
+};
+
+#endif
@@ -36,21 +36,13 @@ MIPS::MIPS(const bool is_big_endian_p)
   zero_register_num = 0;
 
   //------------------------------------------
-  // markers for ReadELF and Objdump files
+  // markers for Objdump files
   //---------------------------------------
-  readelf_sections_markers.push_back("Section Headers:");
-  readelf_sections_markers.push_back("En-têtes de section:");
-
-  readelf_flags_markers.push_back("Key to Flags:");
-  readelf_flags_markers.push_back("Clé des fanions:");
-
   objdump_text_markers.push_back("Disassembly of section .text:");
   objdump_text_markers.push_back("Déassemblage de la section .text:");
 
-  objdump_symboltable_markers.push_back("SYMBOL TABLE:");
-
   //------------------------------------------
-  // sections to be extracted in ReadELF file
+  // sections to be extracted from the binary
   //------------------------------------------
   sectionsToExtract.push_back(".text");
   sectionsToExtract.push_back(".bss");
@@ -656,50 +648,34 @@ string MIPS::getCalleeName(const ObjdumpInstruction & instr)
   return result;
 }
 
-void MIPS::parseSymbolTableLine(const string & line, ObjdumpSymbolTable & table)
+void MIPS::addSymbol(const ObjdumpSymbol & symbol, ObjdumpSymbolTable & table)
 {
-  /* We assume that the input line is in the format : Value  Location  Type  Section  Size  Name
-     for some lines, the field Type is empty */
-
-  //Extracting each field of the line
-  string value, location, type, section, size, name;
-  istringstream parse(line);
-  parse >> value >> location >> type >> section >> size >> name;
-
   //Function
-  if (type == "F" && section == ".text")
+  if (symbol.type == SYMBOL_FUNCTION && symbol.section == ".text")
     {
-      assert(name != "");
-
-      //Converting the string to Unsigned Long
-      t_address addr = strtoul(value.c_str(), NULL, 16);
-      assert(addr != 0 && addr != ULONG_MAX);
+      assert(symbol.name != "");
+      assert(symbol.value != 0);
 
       //Adding the function in the map
-      table.functions[addr].push_front(name);
+      table.functions[symbol.value].push_front(symbol.name);
     }
 
   //Variable
-  else if (type == "O")
+  else if (symbol.type == SYMBOL_OBJECT)
     {
-      assert(section != "");
-      assert(size != "");
-      assert(name != "");
+      assert(symbol.section != "");
+      assert(symbol.name != "");
 
-      //Convert the string to Unsigned Long
-      t_address address = strtoul(value.c_str(), NULL, 16);
-      assert(address != 0 && address != ULONG_MAX);
-
-      //Convert the string to Integer
-      int size_var = (int)strtol(size.c_str(), NULL, 16);
-      assert(size_var != 0 && size_var != INT_MAX);
+      t_address address = symbol.value;
+      assert(address != 0);
+      assert(symbol.size != 0);
 
       //Search for the section of the variable in the vector of ObjdumpSymbolTable
       //to check if the section of the variable is a section we extracted
       vector < ObjdumpSection >::const_iterator it;
       for (it = table.sections.begin(); it != table.sections.end(); it++)
 	{
-	  if ((*it).name == section)
+	  if ((*it).name == symbol.section)
 	    {
 	      break;
 	    }
@@ -712,26 +688,20 @@ void MIPS::parseSymbolTableLine(const string & line, ObjdumpSymbolTable & table)
 
       //create the ObjdumpVariable
       ObjdumpVariable var;
-      var.name = name;
+      var.name = symbol.name;
       var.addr = address;
-      var.size = size_var;	//in bytes
-      var.section_name = section;
+      var.size = symbol.size;	//in bytes
+      var.section_name = symbol.section;
 
       //Add the variable in the vector
       table.variables.push_back(var);
     }
 
-  //global pointer
-  //In this case, Size is the Name because the field Type is empty so there is a shift in the parsing
-  //like this  : 004096a0 g        *ABS*        00000000 _gp
-  //instead of : 004004b0 g     F .text 000000f0 main
-  else if (size == "_gp")
+  //global pointer (symbol without type, like this : 004096a0 g        *ABS*        00000000 _gp)
+  else if (symbol.type == SYMBOL_NOTYPE && symbol.name == "_gp")
     {
-      //Convert the string to unsigned Long
-      t_address address = strtoul(value.c_str(), NULL, 16);
-      assert(address != 0 && address != ULONG_MAX);
-
-      table.MIPS_gp = address;
+      assert(symbol.value != 0);
+      table.MIPS_gp = symbol.value;
     }
 }
 
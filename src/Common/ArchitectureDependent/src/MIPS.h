@@ -129,8 +129,8 @@ public:
     /*! Returns the name of the function called in a Call Instruction */
     string getCalleeName(const ObjdumpInstruction& instr);
 
-    /*! Parse a line of the symbol table and update the ObjdumpSymbolTable object in parameter */
-    void parseSymbolTableLine(const string& line, ObjdumpSymbolTable& table);
+    /*! Add a symbol of the binary to the ObjdumpSymbolTable object in parameter if it is a function or a variable */
+    void addSymbol(const ObjdumpSymbol& symbol, ObjdumpSymbolTable& table);
     
     /*! Returns a Word object containing all the useful information from instr */
     /*! NEVER used in MIPS */
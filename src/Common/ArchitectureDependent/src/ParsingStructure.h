@@ -22,11 +22,12 @@
 
 /*****************************************************************
  
- Definition of 6 classes basically used as struct
+ Definition of 7 classes basically used as struct
  - ObjdumpFunction
  - ObjdumpInstruction
  - ObjdumpSymbolTable
  - ObjdumpSection
+ - ObjdumpSymbol
  - ObjdumpVariable
  - ObjdumpWord (ONLY USED WITH ARM)
  
@@ -78,6 +79,20 @@ public:
     int size; //in bytes
 };
 
+/* Entry of the symbol table of the binary */
+typedef enum { SYMBOL_NOTYPE, SYMBOL_FUNCTION, SYMBOL_OBJECT, SYMBOL_OTHER } t_symbol_type;
+
+class ObjdumpSymbol
+{
+public:
+    string name;
+    t_address value;
+    int size; //in bytes
+    string section; //"*ABS*" or "*UND*" for absolute or undefined symbols
+    bool local;
+    t_symbol_type type;
+};
+
 typedef list<std::string> ListOfString;
 typedef  map<t_address, ListOfString > typeTableFunctions;
 class ObjdumpSymbolTable
@@ -35,45 +35,71 @@
 //singleton declaration
 Arch_dep *Arch::instance = NULL;
 
-//architecture name declaration
-string Arch::architecture_name = "";
+//instance bound to the calling thread
+thread_local Arch_dep **Arch::bound = NULL;
+
+//name of the instance being built by Arch::create on the calling thread
+//(the constructors of the instruction types check the architecture name)
+static thread_local const string *building_name = NULL;
 
 //public constructor
 void Arch::init(const string & arch, const bool is_big_endian)
 {
-  if (instance != NULL)
+  Arch_dep *&target = bound ? *bound : instance;
+  if (target != NULL)
     {
-      delete instance;
+      delete target;
+      target = NULL;
     }
+  target = create(arch, is_big_endian);
+}
 
-  architecture_name = arch;
-
+Arch_dep *Arch::create(const string & arch, const bool is_big_endian)
+{
+  Arch_dep *a = NULL;
+  building_name = &arch;
   if (arch == "MIPS")
     {
-      instance = new MIPS(is_big_endian);
+      a = new MIPS(is_big_endian);
     }
   else if (arch == "ARM")
     {
-      instance = new ARM(is_big_endian);
+      a = new ARM(is_big_endian);
     }
   else
     {
+      building_name = NULL;
       Logger::addFatal("Error: architecture '" + arch + "' not supported");
     }
+  building_name = NULL;
+  a->architecture_name = arch;
+  return a;
+}
+
+Arch_dep **Arch::bind(Arch_dep ** slot)
+{
+  Arch_dep **previous = bound;
+  bound = slot;
+  return previous;
 }
 
 //public destructor
 void Arch::kill()
 {
-  if (instance != NULL)
-    delete instance;
+  Arch_dep *&target = bound ? *bound : instance;
+  if (target != NULL)
+    {
+      delete target;
+      target = NULL;
+    }
 }
 
 //public accessor
 Arch_dep *Arch::getInstance()
 {
-  assert(instance != NULL);
-  return instance;
+  Arch_dep *a = bound ? *bound : instance;
+  assert(a != NULL);
+  return a;
 }
 
 /* bypass getInstance to specific public functions of Arch_dep */
@@ -194,6 +220,16 @@ DAAInstruction *Arch::getDAAInstruction(const string & instr)
   return getInstance()->getDAAInstruction(instr);
 }
 
+const DecodedInstruction *Arch::decode(const string & instr)
+{
+  return getInstance()->decode(instr);
+}
+
+int Arch::getResourceId(const string & name)
+{
+  return getInstance()->getResourceId(name);
+}
+
 int Arch::getLatency(const string & instr)
 {
   return getInstance()->getLatency(instr);
@@ -279,7 +315,10 @@ int Arch_dep::getSizeOfMemoryAccess(const string & instr)
 
 //IP: to avoid warnings with recent compilers
 Arch_dep::~Arch_dep()
-{ }
+{
+  for (map < string, DecodedInstruction * >::iterator it = decodedInstructions.begin(); it != decodedInstructions.end(); it++)
+    delete it->second;
+}
 
 vector < string > Arch_dep::splitInstruction(const string & instr)
 {
@@ -311,6 +350,74 @@ int Arch_dep::getLatency(const string & instr)
   return getInstructionTypeFromAsm(instr)->getLatency();
 }
 
+int Arch_dep::getResourceId(const string & name)
+{
+  map < string, int >::iterator it = resourceIds.find(name);
+  if (it != resourceIds.end()) return it->second;
+
+  int id = resourceIds.size();
+  if (id >= MAX_DECODED_RESOURCES)
+    Logger::addFatal("Error: too many resources in the decoded instructions (" + name + ")");
+  resourceIds[name] = id;
+  return id;
+}
+
+const DecodedInstruction *Arch_dep::decode(const string & instr)
+{
+  map < string, DecodedInstruction * >::iterator it = decodedInstructions.find(instr);
+  if (it != decodedInstructions.end()) return it->second;
+
+  DecodedInstruction *d = new DecodedInstruction();
+  d->code = instr;
+
+  //Extracting the mnemonic and the operands
+  string operands(instr);
+  istringstream parse(instr);
+  parse >> d->mnemonic;
+  operands.erase(0, d->mnemonic.length());
+  vector < string > v_operands = splitOperands(operands);
+
+  d->type = getInstructionTypeFromMnemonic(d->mnemonic);
+  map < string, int >::iterator itm = mnemonicIds.find(d->mnemonic);
+  if (itm == mnemonicIds.end())
+    {
+      d->mnemonicId = mnemonicIds.size();
+      mnemonicIds[d->mnemonic] = d->mnemonicId;
+    }
+  else
+    d->mnemonicId = itm->second;
+
+  // Same results as the string based functions (isLoad, isStore, ...)
+  d->load = isLoad(instr);
+  d->store = d->type->isStore();
+  if (d->type->isLoad() || d->store) d->accessSize = d->type->getSizeOfMemoryAccess();
+  d->latency = d->type->getLatency();
+
+  // The resources are only defined when the operands match a format of the instruction
+  d->hasFormat = d->type->checkFormat(v_operands);
+  if (d->hasFormat)
+    {
+      d->inputs = d->type->getResourceInputs(v_operands);
+      d->outputs = d->type->getResourceOutputs(v_operands);
+      d->functionalUnits = getResourceFunctionalUnits(instr);
+      for (size_t i = 0; i < d->inputs.size(); i++)
+	{
+	  d->inputIds.push_back(getResourceId(d->inputs[i]));
+	  d->inputMask.set(d->inputIds.back());
+	}
+      for (size_t i = 0; i < d->outputs.size(); i++)
+	{
+	  d->outputIds.push_back(getResourceId(d->outputs[i]));
+	  d->outputMask.set(d->outputIds.back());
+	}
+      for (size_t i = 0; i < d->functionalUnits.size(); i++)
+	d->functionalUnitIds.push_back(getResourceId(d->functionalUnits[i]));
+    }
+
+  decodedInstructions[instr] = d;
+  return d;
+}
+
 
 
 /***************************************************************
@@ -323,7 +430,9 @@ int Arch_dep::getLatency(const string & instr)
 
 string Arch::getArchitectureName()
 {
-  return architecture_name;
+  if (building_name != NULL) return *building_name;
+  Arch_dep *a = bound ? *bound : instance;
+  return a != NULL ? a->architecture_name : "";
 }
 
 vector < string > Arch::extractInputRegistersFromMem(const string & operand)
@@ -376,19 +485,19 @@ string Arch::getCalleeName(const ObjdumpInstruction & instr)
   return getInstance()->getCalleeName(instr);
 }
 
-void Arch::parseSymbolTableLine(const string & line, ObjdumpSymbolTable & table)
+void Arch::addSymbol(const ObjdumpSymbol & symbol, ObjdumpSymbolTable & table)
 {
-  getInstance()->parseSymbolTableLine(line, table);
+  getInstance()->addSymbol(symbol, table);
 }
 
-void Arch::parseReadElfLine(const string & line, ObjdumpSymbolTable & table)
+void Arch::addSection(const ObjdumpSection & section, ObjdumpSymbolTable & table)
 {
-  getInstance()->parseReadElfLine(line, table);
+  getInstance()->addSection(section, table);
 }
 
 bool Arch::isWord(const ObjdumpInstruction & instr)
 {
-  assert(architecture_name == "ARM");
+  assert(getInstance()->architecture_name == "ARM");
   return getInstance()->isWord(instr);
 }
 
@@ -397,21 +506,6 @@ ObjdumpWord Arch::readWordInstruction(const ObjdumpInstruction & instr, ObjdumpS
   return getInstance()->readWordInstruction(instr, table);
 }
 
-bool Arch::isReadelfSectionsMarker(const string & line)
-{
-  return getInstance()->isReadelfSectionsMarker(line);
-}
-
-bool Arch::isReadelfFlagsMarker(const string & line)
-{
-  return getInstance()->isReadelfFlagsMarker(line);
-}
-
-bool Arch::isObjdumpSymbolTableMarker(const string & line)
-{
-  return getInstance()->isObjdumpSymbolTableMarker(line);
-}
-
 bool Arch::isObjdumpTextMarker(const string & line)
 {
   return getInstance()->isObjdumpTextMarker(line);
@@ -560,57 +654,14 @@ vector < string > Arch_dep::getResourceOutputs(const string & instr)
   return getInstructionTypeFromMnemonic(mnemonic)->getResourceOutputs(v_operands);
 }
 
-void Arch_dep::parseReadElfLine(const string & line, ObjdumpSymbolTable & table)
+void Arch_dep::addSection(const ObjdumpSection & section, ObjdumpSymbolTable & table)
 {
-  //We assume that the input line is in the format : [Nr]  Name  Type  Addr  Off  Size  ES  Flg  Lk  Inf  A
-  string local_line(line);
-
-  //Removing character '[' from the line
-  if (!Utl::replace(local_line, '[', ' '))
-    {
-      Logger::addFatal("Error: character '[' not found in the ReadELF line : " + line);
-    }
-
-  //Removing character ']' from the line
-  if (!Utl::replace(local_line, ']', ' '))
+  //Checking if the section is a section to be extracted
+  if (find(sectionsToExtract.begin(), sectionsToExtract.end(), section.name) != sectionsToExtract.end())
     {
-      Logger::addFatal("Error: character ']' not found in the ReadELF line : " + line);
-    }
-  //Extracting each field
-  istringstream parse(local_line);
-  string number, name, type, addr, off, size;
-  parse >> number >> name >> type >> addr >> off >> size;
-
-  if (name != "NULL")
-    {
-      assert(number != "");
-      assert(name != "");
-
-      //Checking if the current line corresponds to a section to be extracted
-      if (find(sectionsToExtract.begin(), sectionsToExtract.end(), name) != sectionsToExtract.end())
-	{
-	  assert(type != "");
-	  assert(addr != "");
-	  assert(off != "");
-	  assert(size != "");
-
-	  //Converting the string to Unsigned Long
-	  t_address address = strtoul(addr.c_str(), NULL, 16);
-	  assert(address != 0 && address != ULONG_MAX);
-
-	  //Converting the string to Integer
-	  int size_sect = (int)strtol(size.c_str(), NULL, 16);
-	  assert(size_sect != 0 && size_sect != INT_MAX);
-
-	  //create the section object
-	  ObjdumpSection sect;
-	  sect.name = name;
-	  sect.addr = address;
-	  sect.size = size_sect;
-
-	  //and store it
-	  table.sections.push_back(sect);
-	}
+      assert(section.addr != 0);
+      assert(section.size != 0);
+      table.sections.push_back(section);
     }
 }
 
@@ -619,21 +670,6 @@ bool Arch_dep::isWord(const ObjdumpInstruction & instr)
   return getInstructionTypeFromMnemonic(instr.mnemonic)->isWord();
 }
 
-bool Arch_dep::isReadelfSectionsMarker(const string & line)
-{
-  return (find(readelf_sections_markers.begin(), readelf_sections_markers.end(), line) != readelf_sections_markers.end());
-}
-
-bool Arch_dep::isReadelfFlagsMarker(const string & line)
-{
-  return (find(readelf_flags_markers.begin(), readelf_flags_markers.end(), line) != readelf_flags_markers.end());
-}
-
-bool Arch_dep::isObjdumpSymbolTableMarker(const string & line)
-{
-  return (find(objdump_symboltable_markers.begin(), objdump_symboltable_markers.end(), line) != objdump_symboltable_markers.end());
-}
-
 bool Arch_dep::isObjdumpTextMarker(const string & line)
 {
   return (find(objdump_text_markers.begin(), objdump_text_markers.end(), line) != objdump_text_markers.end());
@@ -53,6 +53,7 @@ See CREDITS.txt for credits of authorship
 #include "InstructionType.h"
 #include "InstructionFormat.h"
 #include "DAAInstruction.h"
+#include "DecodedInstruction.h"
 
 using namespace std;
 
@@ -80,18 +81,25 @@ private:
     /*!unique instance of the arch_dep class (singleton) */
     static Arch_dep* instance;
     
-    /*! string which contains the Architecture's name of the current instance */
-    static string architecture_name;
+    /*! instance used by the calling thread instead of the singleton (see bind), NULL if none */
+    static thread_local Arch_dep** bound;
     
 public :
-    /*!public constructor of the singleton*/
+    /*!public constructor of the singleton (of the bound instance, if any)*/
     static void init(const string& arch, const bool is_big_endian);
 
-    /*!public destructor of the singleton*/
+    /*!public destructor of the singleton (of the bound instance, if any)*/
     static void kill();
     
-    /*!public accessor to the singleton*/
+    /*!public accessor to the singleton (to the bound instance, if any)*/
     static Arch_dep* getInstance();
+
+    /*! Creates an instance which is not the singleton, for a given analysis session */
+    static Arch_dep* create(const string& arch, const bool is_big_endian);
+
+    /*! The calling thread uses *slot instead of the singleton (slot NULL: back to the singleton);
+        init and kill replace *slot. Returns the slot previously bound. */
+    static Arch_dep** bind(Arch_dep** slot);
     
     /* bypass getInstance() to specific public functions of arch_dep*/
     //static const string &getObjdumpTextMarker();
@@ -125,6 +133,9 @@ public :
     
     static DAAInstruction* getDAAInstruction(const string& instr);
     static int getLatency(const string& instr);
+
+    static const DecodedInstruction* decode(const string& instr);
+    static int getResourceId(const string& name);
     /*********************************************************
 		    MODIFICATIONS FOR ARM
     *********************************************************/
@@ -154,10 +165,9 @@ public :
 
     static string getCalleeName(const ObjdumpInstruction& instr);
 
-    static void parseSymbolTableLine(const string& line, ObjdumpSymbolTable& table);
+    static void addSymbol(const ObjdumpSymbol& symbol, ObjdumpSymbolTable& table);
 
-    //added
-    static void parseReadElfLine(const string& line, ObjdumpSymbolTable& table);
+    static void addSection(const ObjdumpSection& section, ObjdumpSymbolTable& table);
     
     static bool isWord(const ObjdumpInstruction& instr);
     
@@ -165,12 +175,6 @@ public :
     
     static string getArchitectureName();
     
-    static bool isReadelfSectionsMarker(const string& line);
-    
-    static bool isReadelfFlagsMarker(const string& line);
-    
-    static bool isObjdumpSymbolTableMarker(const string& line);
-    
     static bool isObjdumpTextMarker(const string& line);
     
     
@@ -310,12 +314,11 @@ public:
   virtual string getCalleeName(const ObjdumpInstruction& instr)=0;
 
 
-  /*! Parse a line of the symbol table and update the ObjdumpSymbolTable object in parameter */
-  virtual void parseSymbolTableLine(const string& line, ObjdumpSymbolTable& table)=0;
+  /*! Add a symbol of the binary to the ObjdumpSymbolTable object in parameter if it is a function or a variable */
+  virtual void addSymbol(const ObjdumpSymbol& symbol, ObjdumpSymbolTable& table)=0;
 
-  //added
-    /*! Parse a line of the ReadELF file and update the ObjdumpSymbolTable object in parameter */
-    void parseReadElfLine(const string& line, ObjdumpSymbolTable& table);
+    /*! Add a section of the binary to the ObjdumpSymbolTable object in parameter if it is a section to be extracted */
+    void addSection(const ObjdumpSection& section, ObjdumpSymbolTable& table);
     
     
     /*! Returns true if instr is a Word (not really an instruction) */
@@ -327,15 +330,6 @@ public:
     virtual ObjdumpWord readWordInstruction(const ObjdumpInstruction& instr, ObjdumpSymbolTable& table)=0;
     
     
-    /*! Returns true if the input line is a marker of Sections in a ReadELF file */
-    bool isReadelfSectionsMarker(const string& line);
-    
-    /*! Returns true if the input line is a marker of Flags in a ReadELF file */
-    bool isReadelfFlagsMarker(const string& line);
-    
-    /*! Returns true if the input line is a marker of Symbol Table in an Objdump file */
-    bool isObjdumpSymbolTableMarker(const string& line);
-    
     /*! Returns true if the input line is a marker of Text Section in an Objdump file */
     bool isObjdumpTextMarker(const string& line);
     
@@ -475,6 +469,18 @@ public:
 
   /*! Returns the latency of the instruction */
   int getLatency(const string& instr);
+
+  /*! Returns the decoded form of instr (decoded on the first call only) */
+  //assume instr: mnemonic operands
+  //the records are shared by the instructions with the same asm code,
+  //and kept until the destruction of the architecture.
+  // /!\ Warning /!\ not thread-safe: the instructions should be decoded
+  // before running parallel analyses (see AnalysisHelper::decodeInstructions)
+  const DecodedInstruction* decode(const string& instr);
+
+  /*! Returns the identifier of a resource name (register, mem, functional unit) */
+  //the identifiers are consecutive from 0, in the order of the first calls
+  int getResourceId(const string& name);
     
 protected:
     
@@ -503,20 +509,25 @@ protected:
   /*! map which associate a string format with an InstructionFormat object*/
   map<string, set<InstructionFormat*> > formats;
     
-    /*! vector which contains all the sections (name) to extract from the ReadELF file */
+    /*! vector which contains all the sections (name) to extract from the binary */
     vector<string> sectionsToExtract;
     
-    /*! vector which contains section list indicators of a readelf file */
-    vector<string> readelf_sections_markers;
-    
-    /*! vector which contains flag list indicators of a readelf file */
-    vector<string> readelf_flags_markers;
-    
     /*! vector which contains code section indicators of an objdump file */
     vector<string> objdump_text_markers;
-    
-    /*! vector which contains symbol table section indicators of an objdump file */
-    vector<string> objdump_symboltable_markers;
+
+    /*! map which associate an asm code with its decoded form (see decode) */
+    map<string, DecodedInstruction*> decodedInstructions;
+
+    /*! map which associate a mnemonic with its identifier in the decoded instructions */
+    map<string, int> mnemonicIds;
+
+    /*! map which associate a resource name with its identifier (see getResourceId) */
+    map<string, int> resourceIds;
+
+    /*! Architecture's name of this instance (set by Arch::create) */
+    string architecture_name;
+
+    friend class Arch;
     
 };
 
@@ -26,15 +26,26 @@
 #include <sstream>
 
 #include <cassert>
+#include <cstdlib>
 #include "GlobalAttributes.h"
 
 using namespace cfglib;
 
 ///----------------------------------------
 
+AddressRange::AddressRange (uint64_t b, uint32_t s, uint32_t st, uint32_t c):base (b), size (s), stride (st), count (c)
+{
+  if (count <= 1 || stride == 0)
+    {
+      stride = 0;
+      count = 1;
+    }
+}
+
+///----------------------------------------
+
 AddressInfo::AddressInfo ()
 {
-  adrsize = vector < pair < string, string > >();
   name = "";
   type = "";
   segment = "";
@@ -42,19 +53,19 @@ AddressInfo::AddressInfo ()
 }
 
 void
-AddressInfo::setName (string n)
+AddressInfo::setName (const string & n)
 {
   name = n;
 }
 
 void
-AddressInfo::setType (string t)
+AddressInfo::setType (const string & t)
 {
   type = t;
 }
 
 void
-AddressInfo::setSegment (string seg)
+AddressInfo::setSegment (const string & seg)
 {
   segment = seg;
 }
@@ -66,51 +77,20 @@ AddressInfo::setPrecision (bool p)
 }
 
 void
-AddressInfo::addAdrSize (string adr, string size)
-{
-  pair < string, string > tmp = pair < string, string > (adr, size);
-  adrsize.push_back (tmp);
-}
-
-vector < pair < string, string > >AddressInfo::getAdrSize ()
-{
-  return adrsize;
-}
-
-
-string
-AddressInfo::getType ()
+AddressInfo::addRange (uint64_t base, uint32_t size, uint32_t stride, uint32_t count)
 {
-  return type;
-}
-
-string
-AddressInfo::getName ()
-{
-  return name;
-}
-
-string
-AddressInfo::getSegment ()
-{
-  return segment;
-}
-
-bool
-AddressInfo::getPrecision ()
-{
-  return precision;
+  ranges.push_back (AddressRange (base, size, stride, count));
 }
 
 void
-AddressInfo::print ()
+AddressInfo::print () const
 {
   cout << "---- AddressInfo\n";
-  int sizeAdrSize = adrsize.size ();
-  for (int i = 0; i < sizeAdrSize; i++)
+  for (size_t i = 0; i < ranges.size (); i++)
     {
-      string addr = adrsize[i].first;
-      cout << "\t adrSize = (0x" << std::hex << atol(addr.c_str()) << ", " << adrsize[i].second << std::dec << ")" << endl;
+      cout << "\t adrSize = (0x" << std::hex << ranges[i].base << ", " << std::dec << ranges[i].size << ")";
+      if (ranges[i].count > 1) cout << " [" << ranges[i].stride << " x " << ranges[i].count << "]";
+      cout << endl;
     }
   cout << "\t type=" << type << "\n";
   cout << "\t name=" << name << "\n";
@@ -125,15 +105,9 @@ AddressAttribute::AddressAttribute ()
   listInfo = vector < AddressInfo > ();
 }
 
-vector < AddressInfo > AddressAttribute::getListInfo ()
-{
-  return listInfo;
-}
-
-
 //
 void
-AddressAttribute::setInfo (vector < AddressInfo > list)
+AddressAttribute::setInfo (const vector < AddressInfo > &list)
 {
   listInfo = list;
 }
@@ -142,7 +116,7 @@ AddressAttribute::setInfo (vector < AddressInfo > list)
 
 //add an object AddressInfo (equivalent to an access to memory) to the AddressInfo list of this
 void
-AddressAttribute::addInfo (AddressInfo info)
+AddressAttribute::addInfo (const AddressInfo & info)
 {
   listInfo.push_back (info);
 }
@@ -152,7 +126,7 @@ AddressAttribute *
 AddressAttribute::clone ()
 {
   AddressAttribute *result = new AddressAttribute ();
-  result->setInfo (this->getListInfo ());
+  result->setInfo (listInfo);
   return result;
 }
 
@@ -170,19 +144,18 @@ ostream & AddressAttribute::WriteXml (std::ostream & os, Handle & hand)
 
   for (int i = 0; i < sizeAddressInfo; i++)
     {
-      AddressInfo current = listInfo[i];
+      const AddressInfo & current = listInfo[i];
       os << "  <ACCES "
 	<< "type=\"" << current.getType () << "\" seg=\"" << current.getSegment () << "\" varname=\"" << current.
 	getName () << "\" precision=\"" << current.getPrecision () << "\">" << std::endl;
 
-      vector < pair < string, string > >adrSize = current.getAdrSize ();
-      pair < string, string > currentPair;
-      int
-	size = adrSize.size ();
-      for (int j = 0; j < size; j++)
+      const AddressRanges & ranges = current.getRanges ();
+      for (size_t j = 0; j < ranges.size (); j++)
 	{
-	  currentPair = adrSize[j];
-	  os << "      <ADDRSIZE  begin=\"0x" << std::hex << atol (currentPair.first.c_str ()) << std::dec << "\" size=\"" << currentPair.second << "\"/>" << std::endl;
+	  os << "      <ADDRSIZE  begin=\"0x" << std::hex << ranges[j].base << std::dec << "\" size=\"" << ranges[j].size << "\"";
+	  if (ranges[j].count > 1)
+	    os << " stride=\"" << ranges[j].stride << "\" count=\"" << ranges[j].count << "\"";
+	  os << "/>" << std::endl;
 	}
 
       os << "  </ACCES>" << std::endl;
@@ -224,17 +197,17 @@ AddressAttribute::ReadXml (XmlTag const *tag, Handle & hand)
 	{
 	  XmlTag grandchild = grandchildren[gc];
 	  string adrBegin = grandchild.getAttributeString (std::string ("begin"));
-	  string size = grandchild.getAttributeString (std::string ("size"));
+	  uint32_t size = grandchild.getAttributeInt (std::string ("size"));
+	  uint32_t stride = grandchild.getAttributeInt (std::string ("stride"));	// optional (0 when absent)
+	  uint32_t count = grandchild.getAttributeInt (std::string ("count"));	// optional (0 when absent)
 
-	  //convert adrBegin in decimal if the value is in hexa
+	  // the begin address is in hexa, or in decimal in the older files
+	  uint64_t base;
 	  if (adrBegin.length () >= 2 && adrBegin[0] == '0' && adrBegin[1] == 'x')
-	    {
-	      long dec_value = strtoul (adrBegin.c_str (), NULL, 16);
-	      std::ostringstream sdec_value;
-	      sdec_value << dec_value;
-	      adrBegin = sdec_value.str ();
-	    }
-	  info.addAdrSize (adrBegin, size);
+	    base = strtoull (adrBegin.c_str (), NULL, 16);
+	  else
+	    base = strtoull (adrBegin.c_str (), NULL, 10);
+	  info.addRange (base, size, stride, count);
 	}
       this->listInfo.push_back (info);
     }
@@ -242,13 +215,13 @@ AddressAttribute::ReadXml (XmlTag const *tag, Handle & hand)
 
 
 long
-AddressAttribute::getCodeAddress ()
+AddressAttribute::getCodeAddress () const
 {
   for (unsigned int i = 0; i < listInfo.size (); i++)
     {
       if (listInfo[i].getSegment () == "code")
 	{
-	  return atol (listInfo[i].getAdrSize ()[0].first.c_str ());
+	  return (long) listInfo[i].getRanges ()[0].base;
 	}
     }
   return (long) -1;
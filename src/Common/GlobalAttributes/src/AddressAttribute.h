@@ -40,11 +40,36 @@
 #include <utility>
 #include <string>
 #include <vector>
+#include <stdint.h>
 #include "CfgLib.h"
+#include "SmallVector.h"
 
 #ifndef ADDRESSINFO
 #define ADDRESSINFO
 
+/*!
+ * Memory area accessed by an instruction: count blocks of size bytes,
+ * stride bytes apart, from base (stride == 0 and count == 1 for a single block)
+ */
+class AddressRange{
+ public:
+  uint64_t base;
+  uint32_t size;
+  uint32_t stride;
+  uint32_t count;
+
+  AddressRange() : base(0), size(0), stride(0), count(1) {}
+  AddressRange(uint64_t b, uint32_t s, uint32_t st = 0, uint32_t c = 1);
+
+  bool operator==(const AddressRange & r) const
+  {
+    return base == r.base && size == r.size && stride == r.stride && count == r.count;
+  }
+};
+
+/*! the ranges of an access, almost always a single one */
+typedef SmallVector<AddressRange, 1> AddressRanges;
+
 /*!
  * The class AddressInfo is a structure to group the informations
  * of 1 access to memory realized by an instruction
@@ -52,8 +77,8 @@
  */
 class AddressInfo{
 
-  // a vector of all possible <begin address to memory area acceded ; size of the access in byte> of the access
-  vector<pair<string,string> > adrsize;
+  // all the possible memory areas acceded by the access
+  AddressRanges ranges;
 
   // the type of access from/to the memory: read or write
   string type;
@@ -74,30 +99,45 @@ class AddressInfo{
   AddressInfo();
 
   /*! accessors */
-  void setName(string n);
-  void setType(string t);
+  void setName(const string & n);
+  void setType(const string & t);
   //void setSizeOfMemoryAcceded(int);
-  void setSegment(string seg);
+  void setSegment(const string & seg);
   void setPrecision(bool p);
 
-  vector<pair<string,string> > getAdrSize(); 
-  string getType();
-  string getName();
-  string getSegment();
-  bool getPrecision();
+  const AddressRanges & getRanges() const
+  {
+    return ranges;
+  }
+  const string & getType() const
+  {
+    return type;
+  }
+  const string & getName() const
+  {
+    return name;
+  }
+  const string & getSegment() const
+  {
+    return segment;
+  }
+  bool getPrecision() const
+  {
+    return precision;
+  }
   //int getSizeOfMemoryAcceded();
 
   /*!
    *
-   * This function is used to add a pair:
-   * <begin address to memory area acceded ; size of the access in byte>
+   * This function is used to add a memory area acceded: size bytes from base,
+   * or count areas of size bytes, stride bytes apart (base, base+stride, ..., base+(count-1)*stride).
    *
    */
-  void addAdrSize(string adr,string size);
+  void addRange(uint64_t base, uint32_t size, uint32_t stride = 0, uint32_t count = 1);
 
 
   //debug
-  void print();
+  void print() const;
 
 };
 #endif
@@ -120,7 +160,7 @@ class AddressAttribute : public cfglib::SerialisableAttribute {
   vector<AddressInfo> listInfo;
 
   /*!accessor only used in the clone function*/
-  void setInfo(vector<AddressInfo>);
+  void setInfo(const vector<AddressInfo> &);
 
  public:
 
@@ -128,7 +168,10 @@ class AddressAttribute : public cfglib::SerialisableAttribute {
   AddressAttribute();
 
   /*!accessor*/
-  vector<AddressInfo> getListInfo();
+  const vector<AddressInfo> & getListInfo() const
+  {
+    return listInfo;
+  }
 
 
 
@@ -142,11 +185,11 @@ class AddressAttribute : public cfglib::SerialisableAttribute {
   /*!
    * This function add an object AddressInfo to the listInfo vector of this
    */
-  void addInfo(AddressInfo);
+  void addInfo(const AddressInfo &);
 
 
   /*!return the code begin address of the code associated to the instruction or -1 if it is not an asm instruction*/
-  long getCodeAddress();
+  long getCodeAddress() const;
 
   SerialisableAttribute *create() ;
 
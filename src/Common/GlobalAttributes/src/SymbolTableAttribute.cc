@@ -84,8 +84,8 @@ SymbolTableAttribute::getCodeStartAddr ()
   return sections[".text"].first;
 }
 
-void
-SymbolTableAttribute::getInfo (unsigned long addr, string * var_name, unsigned long *start_addr, int *size, string * section_name)
+bool
+SymbolTableAttribute::findInfo (unsigned long addr, string * var_name, unsigned long *start_addr, int *size, string * section_name)
 {
   //search in variables
   for (map < std::string, triplet >::const_iterator it = variables.begin (); it != variables.end (); it++)
@@ -97,7 +97,7 @@ SymbolTableAttribute::getInfo (unsigned long addr, string * var_name, unsigned l
 	  *start_addr = current.first;
 	  *size = current.second;
 	  *section_name = current.third;
-	  return;
+	  return true;
 	}
     }
 
@@ -115,15 +115,24 @@ SymbolTableAttribute::getInfo (unsigned long addr, string * var_name, unsigned l
 	      *start_addr = current.first;
 	      *size = current.second;
 	      *section_name = it->first;
-	      return;
+	      return true;
 	    }
 	}
       
     }
 
-  ostringstream oss;
-  oss << "0x" << hex << addr << dec;
-  Logger::addError ("address " + oss.str () + " not found");
+  return false;
+}
+
+void
+SymbolTableAttribute::getInfo (unsigned long addr, string * var_name, unsigned long *start_addr, int *size, string * section_name)
+{
+  if (!findInfo (addr, var_name, start_addr, size, section_name))
+    {
+      ostringstream oss;
+      oss << "0x" << hex << addr << dec;
+      Logger::addError ("address " + oss.str () + " not found");
+    }
 }
 
 
@@ -106,5 +106,9 @@ class SymbolTableAttribute : public cfglib::SerialisableAttribute
     rq: the input address must be in decimal
   */
   void getInfo(unsigned long addr, string* var_name, unsigned long* start_addr, int* size, string* section_name);
+
+  /*! Same as getInfo, without reporting an error: returns false (and leaves the informations unchanged) if addr is not found.
+   */
+  bool findInfo(unsigned long addr, string* var_name, unsigned long* start_addr, int* size, string* section_name);
 }; 
 #endif
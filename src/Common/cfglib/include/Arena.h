@@ -0,0 +1,126 @@
+/* ---------------------------------------------------------------------
+
+   Copyright IRISA, 2003-2017
+
+   This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+   estimation.
+   APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+   Heptane is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Heptane is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details (COPYING.txt).
+
+   See CREDITS.txt for credits of authorship
+
+   ------------------------------------------------------------------------ */
+
+#ifndef _IRISA_CFGLIB_ARENA_H
+#define _IRISA_CFGLIB_ARENA_H
+
+/* #includes and forward declarations */
+#include <cstddef>
+#include <vector>
+#include <mutex>
+#include <atomic>
+
+/*! this namespace is the global namespace */
+namespace cfglib
+{
+
+  /*! Memory of the cfglib objects (Cfg, Node, Edge, Instruction,
+   * Loop) and of the attributes, used by their operators new and
+   * delete.
+   *
+   * Every Program has its own arena: the objects are allocated in
+   * chunks of CHUNK_SIZE bytes, with a free list per size (multiple
+   * of 16 bytes). When the program is deleted, the arena is torn
+   * down first: the deletions of its objects (whose destructors
+   * still free their own strings and vectors) neither lock it nor
+   * fill its free lists. Its chunks are freed at once when its last
+   * object is deleted: at the end of the deletion of the program,
+   * or later if some objects (e.g. attributes) outlive it. The objects are
+   * allocated in the arena bound to the calling thread (see
+   * ArenaScope), which the factories (Program::CreateNewCfg,
+   * Cfg::CreateNewNode, Node::CreateNewInstruction, ...) and
+   * Attributed::SetAttribute bind to the arena of the object they
+   * are called on; in a global arena, never freed, when none is
+   * bound. The attributes of more than MAX_SIZE bytes are allocated
+   * by the global operator new.
+   *
+   * The chunks are aligned on their size, so that the arena of an
+   * object is found from its address (Of). An arena can be used by
+   * several threads (e.g. the cfgs of a program built in parallel). */
+  class Arena {
+  public:
+    /*! Size (and alignment) of the chunks */
+    static const size_t CHUNK_SIZE = 64 * 1024;
+
+    /*! Largest object allocated in an arena */
+    static const size_t MAX_SIZE = 1024;
+
+    /*! New arena, to be released by its owner */
+    static Arena* Create() ;
+
+    /*! The objects of the arena are about to be deleted: Deallocate
+     * ignores their blocks, and no allocation is allowed any more */
+    void TearDown() ;
+
+    /*! Called by the owner of the arena: frees the chunks and the
+     * arena, at once if its objects have been deleted, otherwise when
+     * the last of them is deleted */
+    void Release() ;
+
+    /*! Allocation of size bytes in the arena bound to the calling thread */
+    static void* Allocate(size_t size) ;
+
+    /*! Deallocation of an object of size bytes allocated by Allocate */
+    static void Deallocate(void* p, size_t size) ;
+
+    /*! Arena of an object allocated by Allocate with at most MAX_SIZE bytes */
+    static Arena* Of(const void* p) ;
+
+    /*! Binds arena to the calling thread (NULL: the global one).
+     * @return the arena previously bound */
+    static Arena* Bind(Arena* arena) ;
+
+    /*! Number of allocations made in the arena */
+    size_t GetNbAllocations() const { return nb_allocations; }
+
+    /*! Number of chunks of the arena */
+    size_t GetNbChunks() const { return chunks.size(); }
+
+  private:
+    std::mutex lock;
+    std::vector<char*> chunks;
+    char* next;			///< free space of the last chunk
+    char* end;
+    std::vector<void*> free_lists;	///< first free block of every size
+    size_t nb_allocations;
+    std::atomic<size_t> nb_live;	///< live objects, plus one until Release
+    bool tearing_down;		///< set and read by the thread deleting the objects
+
+    Arena() ;
+    ~Arena() ;
+    void* AllocateBlock(size_t size) ;
+    void DeallocateBlock(void* p, size_t size) ;
+    void Unref() ;
+  } ;
+
+  /*! Binding of an arena to the calling thread for the lifetime of
+   * the scope (see Arena::Bind) */
+  class ArenaScope {
+  private:
+    Arena* previous;
+  public:
+    explicit ArenaScope(Arena* arena) : previous(Arena::Bind(arena)) {}
+    ~ArenaScope() { Arena::Bind(previous); }
+  } ;
+
+} // cfglib::
+#endif // _IRISA_CFGLIB_ARENA_H
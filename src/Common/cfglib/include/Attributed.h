@@ -26,27 +26,70 @@
 /* #includes and forward declarations */
 #include <string>
 #include <map>
+#include <vector>
 #include "Attributes.h"
+#include "AttributeKey.h"
 #include "Serialisable.h"
 #include "CloneHandle.h"
 namespace cfglib { class Handle ; }
+namespace cfglib { class BinaryWriter ; }
+namespace cfglib { class BinaryReader ; }
+namespace cfglib { class AttributeLayer ; }
+namespace cfglib { class Arena ; }
 
 /*! this namespace is the global namespace */
 namespace cfglib 
 {
 
   /*! Attributed. All objects to which we can add
-   * attributes inherit this class. */
+   * attributes inherit this class.
+   * Attributes are stored in a vector sorted by the identifier of
+   * their interned name (see AttributeKey.h), and searched by dichotomy.
+   * Every method taking an attribute name has an overload taking an
+   * AttributeKey, to be preferred in the frequently executed code. */
   class Attributed : public Serialisable {
   private:
-    typedef std::map<std::string, Attribute*> attributes_container;
+    typedef std::vector< std::pair<unsigned int, Attribute*> > attributes_container;
     attributes_container attributes;
+
+    /*! true when the object was read with an ATTRS_LIST, written back even if it has no attribute */
+    bool attrs_list;
+
+    /*! Position of the attribute of identifier id, or of the position where it should be inserted */
+    attributes_container::iterator Position(unsigned int id) ;
+
+    /*! Attribute of identifier id, NULL if absent */
+    Attribute* Find(unsigned int id) const ;
+
+    /*! Positions of the attributes, sorted by name (serialisation order) */
+    std::vector<size_t> SortedByName() const ;
+
+    /*! Attaches attribute (not copied) with identifier id, replacing the former one */
+    void Attach(unsigned int id, Attribute* attribute) ;
+
+    /*! Puts back the attribute of identifier id kept by an AttributeLayer
+     * (removes it when previous is NULL), deleting the current one */
+    void Restore(unsigned int id, Attribute* previous) ;
+
+    friend class AttributeLayer;
+  protected:
+    /*! Deletes all the attributes (and those kept for the object by an AttributeLayer) */
+    void DeleteAttributes() ;
   public:
+    Attributed() : attrs_list(false) {}
+
+    /*! Allocation in the arena bound to the calling thread (see Arena.h) */
+    static void* operator new(size_t size) ;
+    static void operator delete(void* p, size_t size) ;
+
+    /*! Arena of the object, in which its attributes are allocated */
+    virtual Arena* GetArena() ;
 	
     /*! Returns true if the attributed object has an attribute of name 'symbol' attached
      *  Must be called before any attempt to call method GetAttribute
      */
-    bool HasAttribute(std::string symbol) ;
+    bool HasAttribute(std::string const& symbol) ;
+    bool HasAttribute(AttributeKey key) ;
 
     /*! Get a attribute given its name. The method makes a copy of the attribute
      * by calling its method "clone" before the attribute is stored. All attributed
@@ -64,10 +107,11 @@ namespace cfglib
      *       ia=n.GetAttribute("myinteger");    // Retrieve a copy of the attribute in ia
      *       int val = ia.GetValue();           // Get it's value (here, a simple integer)
      */	
-    Attribute &GetAttribute(std::string symbol) ;
+    Attribute &GetAttribute(std::string const& symbol) ;
+    Attribute &GetAttribute(AttributeKey key) ;
 
     //TP
-    /*! return every symbols used in the attribute map */
+    /*! return every symbols used in the attribute map, sorted by name */
     std::vector<string> getAttributeList(void);
     void CloneAttributesFor (Attributed*, CloneHandle&);
     
@@ -76,14 +120,16 @@ namespace cfglib
      * of the attribute is stored.
      * In case an already existing attribute is replaced,
      * the attribute is deleted before the new one is
-     * installed. */
+     * installed (unless an AttributeLayer is open, see AttributeLayer.h). */
     void SetAttribute(std::string const& symbol, Attribute &attribute) ;
+    void SetAttribute(AttributeKey key, Attribute &attribute) ;
     
     /*! Remove an attribute (frees its memory) 
      * (if not removed, an attribute stays attached and consumes memory up
      * to the program termination)
      */
     void RemoveAttribute(std::string const& symbol) ;
+    void RemoveAttribute(AttributeKey key) ;
 
     /*! Print information on the non serialisable attributes, by calling
      * their Print method. Used for debug only, to check that all
@@ -91,13 +137,20 @@ namespace cfglib
      */
     void PrintNonSerialisableAttributes(std::ostream& os);
     
-    /*! Serialise all attributes */
+    /*! Serialise all attributes (sorted by name) */
     std::ostream& WriteXmlAttributes(std::ostream& os,
 				     Handle& hand_ser) const ;
 
     /*! Unserialise all attributes */
     void ReadXmlAttributes(XmlTag const* tag, 
 			   Handle& hand) ;
+
+    /*! Binary serialisation of all attributes (see BinarySerialisation.h) */
+    void WriteBinaryAttributes(BinaryWriter& w, Handle& hand) const ;
+
+    /*! Binary deserialisation of all attributes. When lazy is true, the
+     * attributes are decoded at their first access (LazyAttribute). */
+    void ReadBinaryAttributes(BinaryReader& r, Handle& hand, bool lazy) ;
     
     /*! virtual destructor. */
     virtual ~Attributed();
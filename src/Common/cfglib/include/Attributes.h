@@ -26,6 +26,7 @@ See CREDITS.txt for credits of authorship
 /* #includes and forward declarations. */
 #include <string>
 #include "Serialisable.h"
+#include "Arena.h"
 
 /* Debug of attribute management methods */
 // Uncomment one of these two lines to enter/leave debug mode
@@ -52,12 +53,19 @@ namespace cfglib
     /*! There is only one attribute with a given name attached to an
         Attributed object. */
     std::string name ;
+
+    /*! true for the attributes of a binary file not decoded yet (see LazyAttribute) */
+    bool lazy ;
   public:
     
     /*! Default constructors and destructors */
-    Attribute() {};
+    Attribute() : lazy(false) {};
     virtual ~Attribute(){};
 
+    /*! Allocation in the arena bound to the calling thread (see Arena.h) */
+    static void* operator new(size_t size) { return Arena::Allocate(size); }
+    static void operator delete(void* p, size_t size) { Arena::Deallocate(p, size); }
+
     /*! Attribute cloning function. Used by attribute attachment
      * method SetAttribute of class Attributed when attaching an
      * attribute to an object deriving from class Attributed */
@@ -72,6 +80,14 @@ namespace cfglib
      * used otherwise */
     void SetName(std::string name)
     {	this->name = name ; }
+
+    /*! Name of the attribute (set by the serialisation functions) */
+    std::string const& GetName() const
+    {	return name ; }
+
+    /*! Returns true if the attribute is a LazyAttribute */
+    bool IsLazy() const
+    {	return lazy ; }
   } ;
   
 } // cfglib::
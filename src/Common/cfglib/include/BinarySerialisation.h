@@ -0,0 +1,206 @@
+/* ---------------------------------------------------------------------
+
+   Copyright IRISA, 2003-2017
+
+   This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+   estimation.
+   APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+   Heptane is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Heptane is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details (COPYING.txt).
+
+   See CREDITS.txt for credits of authorship
+
+   ------------------------------------------------------------------------ */
+
+/*********************************************
+
+ Binary snapshot of a Program, an alternative to the XML serialisation
+ (Program::serialise_program_binary, Program::unserialise_program_file).
+
+ Layout (host endianness, offsets in bytes from the beginning of the file):
+   BinaryProgramHeader
+   string table: nb_strings times (length, characters)
+   body: the Program, its Cfgs, Nodes, Instructions, Edges and Loops
+
+ The body is a sequence of unsigned integers (7 bits per byte, the high
+ bit set on all the bytes but the last one), strings (length, characters)
+ and references to the string table (used for the attribute names and
+ types, the asm codes and the function names). The objects are referred
+ to by the integer identifiers of the Handle, as in the XML files.
+
+ The attributes of an object are preceded by 0 when it has no ATTRS_LIST,
+ and by their number plus one otherwise (so that an empty ATTRS_LIST is
+ kept). Every attribute is stored as: name, length of the record, type, then the
+ contents written by SerialisableAttribute::WriteBinary (by default the
+ XML serialisation of the attribute). The file is read through mmap and
+ the attributes of the objects other than the Program are only decoded
+ at their first access (LazyAttribute), the records staying in the
+ mapped file until then.
+
+ The reading errors are fatal (Logger::addFatal).
+
+*********************************************/
+
+#ifndef _IRISA_CFGLIB_BINARY_SERIALISATION_H
+#define _IRISA_CFGLIB_BINARY_SERIALISATION_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <atomic>
+#include "Attributes.h"
+#include "AttributeKey.h"
+
+#define BINARY_PROGRAM_MAGIC "HEPTPROG"
+#define BINARY_PROGRAM_VERSION 2
+
+/*! this namespace is the global namespace */
+namespace cfglib
+{
+  class Handle;
+  class SerialisableAttribute;
+
+  /*! File header, as stored on disk */
+  struct BinaryProgramHeader
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t nb_strings;
+    uint64_t strings_offset;
+    uint64_t strings_length;
+    uint64_t body_offset;
+    uint64_t body_length;
+  };
+
+  /*! Binary output, built in memory then written at once */
+  class BinaryWriter {
+  private:
+    std::string body;
+    std::vector<std::string> strings;
+    std::map<std::string, unsigned int> index;
+  public:
+    void PutByte(unsigned char b);
+    void PutUnsigned(unsigned long long v);
+    /*! signed values are zigzag encoded, so that the small negative values are short */
+    void PutSigned(long long v);
+    void PutDouble(double v);
+    void PutString(std::string const& s);
+    /*! Writes the index of s in the string table (s is added if needed) */
+    void PutName(std::string const& s);
+
+    /*! Reserves the length of a record. @return the position to give to EndRecord */
+    size_t BeginRecord();
+    /*! Sets the length of the record started at pos to the bytes written since */
+    void EndRecord(size_t pos);
+
+    /*! Writes the header, the string table and the body to file_name. @return false on I/O error. */
+    bool WriteFile(std::string const& file_name) const;
+  };
+
+  /*! Mapped binary file: string table and factory lookups. Reference counted,
+   *  the file is unmapped when the last LazyAttribute is decoded or deleted. */
+  class BinarySnapshot {
+  private:
+    const char* base;
+    size_t size;
+    unsigned int nb_strings;
+    std::vector<std::string> strings;
+    std::vector<AttributeKey> keys;	// attribute key of every string, invalid when not computed yet
+    std::vector<SerialisableAttribute*> prototypes;
+    std::vector<bool> known;		// prototypes[i] is computed
+    std::atomic<unsigned int> references;
+
+    BinarySnapshot();
+    ~BinarySnapshot();
+  public:
+    /*! Maps file_name in memory and checks its header and bounds.
+     *  @return NULL (with an explanation in error) when the file cannot be used. */
+    static BinarySnapshot* Open(std::string const& file_name, std::string& error);
+
+    /*! true if file_name starts with the binary magic number */
+    static bool IsBinaryFile(std::string const& file_name);
+
+    void Retain();
+    void Release();
+
+    /*! Beginning and end of the body */
+    const char* GetBody() const;
+    const char* GetBodyEnd() const;
+
+    unsigned int GetNbStrings() const { return nb_strings; }
+    std::string const& GetString(unsigned int i) const;
+    /*! Interned attribute name of string i */
+    AttributeKey GetKey(unsigned int i);
+    /*! Factory prototype of the attribute type of string i, NULL when the type is unknown */
+    SerialisableAttribute* GetPrototype(unsigned int i);
+  };
+
+  /*! Sequential reader of a part of a BinarySnapshot. Reading past the end sets
+   *  the failed flag and returns zeros. */
+  class BinaryReader {
+  private:
+    BinarySnapshot* snapshot;
+    const char* p;
+    const char* end;
+    bool failed;
+  public:
+    BinaryReader(BinarySnapshot* s, const char* begin, const char* end);
+
+    unsigned char GetByte();
+    unsigned long long GetUnsigned();
+    long long GetSigned();
+    double GetDouble();
+    std::string GetString();
+    /*! Number of elements of a sequence, each one taking at least one byte */
+    unsigned long long GetCount();
+    /*! Index in the string table, and the corresponding string */
+    unsigned int GetNameIndex();
+    std::string const& GetName();
+    /*! Record length written by BinaryWriter::EndRecord */
+    uint32_t GetRecordLength();
+
+    const char* Position() const { return p; }
+    void Skip(size_t n);
+    bool Failed() const { return failed; }
+    void SetFailed() { failed = true; }
+    bool AtEnd() const { return p == end; }
+    BinarySnapshot* GetSnapshot() const { return snapshot; }
+  };
+
+  /*! Attribute of a mapped binary file, decoded at its first access
+   * (Attributed::GetAttribute) or when it is cloned. The decoding is
+   * protected by a lock, so that the attributes of a program can be
+   * read by several threads. */
+  class LazyAttribute : public Attribute {
+  private:
+    BinarySnapshot* snapshot;
+    SerialisableAttribute* prototype;
+    unsigned int name_index;
+    const char* data;
+    const char* data_end;
+    Handle* hand;
+    std::atomic<Attribute*> value;
+  public:
+    LazyAttribute(BinarySnapshot* s, SerialisableAttribute* prototype, unsigned int name_index,
+		  const char* data, const char* data_end, Handle* hand);
+    ~LazyAttribute();
+
+    /*! Decoded attribute */
+    Attribute* Get();
+
+    Attribute* clone();
+    Attribute* clone(CloneHandle& handle);
+    void Print(std::ostream& os);
+  };
+
+} // cfglib::
+#endif // _IRISA_CFGLIB_BINARY_SERIALISATION_H
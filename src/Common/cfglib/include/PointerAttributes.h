@@ -26,6 +26,7 @@
 #include <cassert>
 
 #include "Attributes.h"
+#include "BinarySerialisation.h"
 #include "CloneHandle.h"
 #include "Handle.h"
 #include "SerialisableAttributes.h"
@@ -52,6 +53,10 @@
 							\
     void ReadXml(XmlTag const*, Handle&);		\
 							\
+    void WriteBinary(BinaryWriter&,Handle&);		\
+							\
+    void ReadBinary(BinaryReader&,Handle&);		\
+							\
     TYPE* GetValue() const;				\
 							\
     void SetValue(TYPE* ptr);				\
@@ -95,6 +100,15 @@
       string nid = tag->getAttributeString(std::string("ptr_id"));	\
       handle.addID_handle (nid, (Serialisable**)ptr);			\
     }									\
+    void ATTR_NAME::WriteBinary(BinaryWriter& w, Handle& handle) {	\
+      assert (*ptr);							\
+      w.PutName (#TYPE);						\
+      w.PutUnsigned (handle.identifier ((Serialisable*)*(ptr)));	\
+    }									\
+    void ATTR_NAME::ReadBinary(BinaryReader& r, Handle& handle) {	\
+      assert(ptr);							\
+      handle.addID_handle ((int) r.GetUnsigned (), (Serialisable**)ptr); \
+    }									\
     TYPE* ATTR_NAME::GetValue() const					\
       {									\
 	assert (ptr);							\
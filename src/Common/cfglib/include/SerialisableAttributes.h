@@ -38,12 +38,24 @@ See CREDITS.txt for credits of authorship
 namespace cfglib 
 {
   class Handle;
+  class BinaryWriter;
+  class BinaryReader;
 	
   /*! Attribute interface. */
   class SerialisableAttribute : public Attribute, public Serialisable {
   public:
     /*! Atrribute factory */
     virtual SerialisableAttribute *create() = 0 ; 
+
+    /*! Binary serialisation function (see BinarySerialisation.h): writes
+     * the type of the attribute, as registered in the AttributesFactory,
+     * then its contents. The default implementation writes the XML
+     * serialisation of the attribute. */
+    virtual void WriteBinary(BinaryWriter&, Handle&) ;
+
+    /*! Binary deserialisation function: reads the contents written by
+     * WriteBinary (the type has already been read). */
+    virtual void ReadBinary(BinaryReader&, Handle&) ;
   } ;
   
   class SerialisableStringAttribute : public SerialisableAttribute {
@@ -68,6 +80,10 @@ namespace cfglib
     
     /*! deserialisation function */
     virtual void ReadXml(XmlTag const*, cfglib::Handle&) ;
+
+    /*! binary serialisation functions */
+    void WriteBinary(BinaryWriter&, Handle&) ;
+    void ReadBinary(BinaryReader&, Handle&) ;
     
     /*! get std::string value of the String Attribute */
     std::string GetValue() {return value;};
@@ -101,6 +117,10 @@ namespace cfglib
     
     /*! deserialisation function */
     virtual void ReadXml(XmlTag const*, cfglib::Handle&) ;
+
+    /*! binary serialisation functions */
+    void WriteBinary(BinaryWriter&, Handle&) ;
+    void ReadBinary(BinaryReader&, Handle&) ;
     
     /*! get int value of the Integer Attribute */
     int GetValue() {return value;};
@@ -134,6 +154,10 @@ namespace cfglib
     
     /*! deserialisation function */
     virtual void ReadXml(XmlTag const*, cfglib::Handle&) ;
+
+    /*! binary serialisation functions */
+    void WriteBinary(BinaryWriter&, Handle&) ;
+    void ReadBinary(BinaryReader&, Handle&) ;
     
     /*! get int value of the Integer Attribute */
     float GetValue() {return value;};
@@ -167,6 +191,10 @@ namespace cfglib
     
     /*! deserialisation function */
     virtual void ReadXml(XmlTag const*, cfglib::Handle&) ;
+
+    /*! binary serialisation functions */
+    void WriteBinary(BinaryWriter&, Handle&) ;
+    void ReadBinary(BinaryReader&, Handle&) ;
     
     /*! get int value of the UnsignedLong Attribute */
     unsigned long GetValue() {return value;};
@@ -210,6 +238,10 @@ namespace cfglib
     
       /*! deserialisation function */
       virtual void ReadXml(XmlTag const*, cfglib::Handle&) ;
+
+      /*! binary serialisation functions */
+      void WriteBinary(BinaryWriter&, Handle&) ;
+      void ReadBinary(BinaryReader&, Handle&) ;
   
   
       /*! get int value of the SerialisableList Attribute */
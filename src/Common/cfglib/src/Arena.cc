@@ -0,0 +1,156 @@
+/* ---------------------------------------------------------------------
+
+   Copyright IRISA, 2003-2017
+
+   This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+   estimation.
+   APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+   Heptane is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Heptane is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details (COPYING.txt).
+
+   See CREDITS.txt for credits of authorship
+
+   ------------------------------------------------------------------------ */
+
+/* header file */
+#include "Arena.h"
+
+/* forward declarations and #includes */
+#include <cassert>
+#include <cstdlib>
+#include <new>
+#include <stdint.h>
+
+/*! this namespace is the global namespace */
+namespace cfglib
+{
+  /*! Granularity of the sizes, which keeps the alignment of operator new */
+  static const size_t GRAIN = 16;
+
+  /*! Header of a chunk: its arena (followed by padding up to GRAIN bytes) */
+  static const size_t HEADER = GRAIN;
+
+  /*! Arena bound to the calling thread, NULL for the global one */
+  static thread_local Arena *bound_arena = NULL;
+
+  /*! Arena of the objects allocated when none is bound, never freed */
+  static Arena *GlobalArena ()
+  {
+    static Arena *global_arena = Arena::Create ();
+    return global_arena;
+  }
+
+  Arena::Arena ():next (NULL), end (NULL), free_lists (MAX_SIZE / GRAIN + 1, (void *) NULL), nb_allocations (0), nb_live (1), tearing_down (false)
+  {
+  }
+
+  Arena::~Arena ()
+  {
+    for (size_t i = 0; i < this->chunks.size (); i++)
+      free (this->chunks[i]);
+  }
+
+  Arena *Arena::Create ()
+  {
+    return new Arena ();
+  }
+
+  void Arena::TearDown ()
+  {
+    this->tearing_down = true;
+  }
+
+  void Arena::Release ()
+  {
+    assert (this != GlobalArena ());
+    Unref ();
+  }
+
+  /*! The arena is deleted by the thread which drops its last reference */
+  void Arena::Unref ()
+  {
+    if (--this->nb_live == 0)
+      delete this;
+  }
+
+  Arena *Arena::Bind (Arena * arena)
+  {
+    Arena *previous = bound_arena;
+    bound_arena = arena;
+    return previous;
+  }
+
+  Arena *Arena::Of (const void *p)
+  {
+    return *(Arena * const *) ((uintptr_t) p & ~(uintptr_t) (CHUNK_SIZE - 1));
+  }
+
+  void *Arena::Allocate (size_t size)
+  {
+    if (size > MAX_SIZE)
+      return ::operator new (size);
+    Arena *arena = bound_arena != NULL ? bound_arena : GlobalArena ();
+    return arena->AllocateBlock (size);
+  }
+
+  void Arena::Deallocate (void *p, size_t size)
+  {
+    if (p == NULL)
+      return;
+    if (size > MAX_SIZE)
+      {
+	::operator delete (p);
+	return;
+      }
+    Arena *arena = Of (p);
+    // The blocks of an arena torn down are freed with its chunks
+    if (!arena->tearing_down)
+      arena->DeallocateBlock (p, size);
+    arena->Unref ();
+  }
+
+  void *Arena::AllocateBlock (size_t size)
+  {
+    size_t c = (size + GRAIN - 1) / GRAIN;
+    std::lock_guard < std::mutex > guard (this->lock);
+    assert (!this->tearing_down);
+    this->nb_allocations++;
+    this->nb_live++;
+    void *block = this->free_lists[c];
+    if (block != NULL)
+      {
+	this->free_lists[c] = *(void **) block;
+	return block;
+      }
+    if ((size_t) (this->end - this->next) < c * GRAIN)
+      {
+	void *chunk = NULL;
+	if (posix_memalign (&chunk, CHUNK_SIZE, CHUNK_SIZE) != 0)
+	  throw std::bad_alloc ();
+	*(Arena **) chunk = this;
+	this->chunks.push_back ((char *) chunk);
+	this->next = (char *) chunk + HEADER;
+	this->end = (char *) chunk + CHUNK_SIZE;
+      }
+    block = this->next;
+    this->next += c * GRAIN;
+    return block;
+  }
+
+  void Arena::DeallocateBlock (void *p, size_t size)
+  {
+    size_t c = (size + GRAIN - 1) / GRAIN;
+    std::lock_guard < std::mutex > guard (this->lock);
+    *(void **) p = this->free_lists[c];
+    this->free_lists[c] = p;
+  }
+
+}				// cfglib::
@@ -0,0 +1,112 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+
+/* #includes and forward declarations */
+#include <string>
+#include <deque>
+#include <unordered_map>
+#include <shared_mutex>
+#include <mutex>
+#include <cassert>
+#include "AttributeKey.h"
+
+/*! this namespace is the global namespace */
+namespace cfglib
+{
+  /*! Global symbol table of the attribute names.
+   * Built on first use (keys may be built during static initialisation).
+   * The names are stored in a deque so that references returned by
+   * GetName stay valid when new names are interned.
+   * The table is shared by all the threads (and analysis sessions) of
+   * the process, hence the lock.
+   */
+  struct AttributeSymbolTable
+  {
+    std::unordered_map < std::string, unsigned int >ids;
+    std::deque < std::string > names;
+    std::shared_mutex lock;
+
+    static AttributeSymbolTable & Instance ()
+    {
+      static AttributeSymbolTable table;
+      return table;
+    }
+  };
+
+  AttributeKey::AttributeKey (std::string const &name)
+  {
+    AttributeSymbolTable & table = AttributeSymbolTable::Instance ();
+    {
+      std::shared_lock < std::shared_mutex > guard (table.lock);
+      std::unordered_map < std::string, unsigned int >::iterator it (table.ids.find (name));
+      if (it != table.ids.end ())
+	{
+	  id = it->second;
+	  return;
+	}
+    }
+    std::unique_lock < std::shared_mutex > guard (table.lock);
+    std::unordered_map < std::string, unsigned int >::iterator it (table.ids.find (name));
+    if (it != table.ids.end ())
+      {
+	id = it->second;
+      }
+    else
+      {
+	id = table.names.size ();
+	table.names.push_back (name);
+	table.ids[name] = id;
+      }
+  }
+
+  bool AttributeKey::Find (std::string const &name, AttributeKey & key)
+  {
+    AttributeSymbolTable & table = AttributeSymbolTable::Instance ();
+    std::shared_lock < std::shared_mutex > guard (table.lock);
+    std::unordered_map < std::string, unsigned int >::iterator it (table.ids.find (name));
+    if (it == table.ids.end ())
+      return false;
+    key.id = it->second;
+    return true;
+  }
+
+  unsigned int AttributeKey::Count ()
+  {
+    AttributeSymbolTable & table = AttributeSymbolTable::Instance ();
+    std::shared_lock < std::shared_mutex > guard (table.lock);
+    return table.names.size ();
+  }
+
+  std::string const &AttributeKey::GetName () const
+  {
+    return GetName (id);
+  }
+
+  std::string const &AttributeKey::GetName (unsigned int id)
+  {
+    AttributeSymbolTable & table = AttributeSymbolTable::Instance ();
+    std::shared_lock < std::shared_mutex > guard (table.lock);
+    assert (id < table.names.size ());
+    return table.names[id];
+  }
+
+}				// cfglib::
@@ -0,0 +1,95 @@
+/* ---------------------------------------------------------------------
+
+   Copyright IRISA, 2003-2017
+
+   This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+   estimation.
+   APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+   Heptane is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Heptane is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details (COPYING.txt).
+
+   See CREDITS.txt for credits of authorship
+
+   ------------------------------------------------------------------------ */
+
+/* header file */
+#include "AttributeLayer.h"
+
+/* forward declarations and #includes */
+#include <cassert>
+#include "Attributed.h"
+
+/*! this namespace is the global namespace */
+namespace cfglib
+{
+  /*! Layer open on the calling thread */
+  static thread_local AttributeLayer *current_layer = NULL;
+
+  AttributeLayer::AttributeLayer ():nb_written (0), open (true)
+  {
+    assert (current_layer == NULL);
+    current_layer = this;
+  }
+
+  AttributeLayer::~AttributeLayer ()
+  {
+    if (this->open)
+      Discard ();
+  }
+
+  AttributeLayer *AttributeLayer::Current ()
+  {
+    return current_layer;
+  }
+
+  bool AttributeLayer::Keep (Attributed * object, unsigned int id, Attribute * previous)
+  {
+    this->nb_written++;
+    return this->kept[object].insert (std::make_pair (id, previous)).second;
+  }
+
+  void AttributeLayer::Forget (Attributed * object)
+  {
+    std::unordered_map < Attributed *, kept_attributes >::iterator it (this->kept.find (object));
+    if (it == this->kept.end ())
+      return;
+    for (kept_attributes::iterator a (it->second.begin ()); a != it->second.end (); ++a)
+      delete a->second;
+    this->kept.erase (it);
+  }
+
+  void AttributeLayer::Close ()
+  {
+    assert (this->open && current_layer == this);
+    // First, so that the restorations and deletions which follow are not recorded
+    current_layer = NULL;
+    this->open = false;
+  }
+
+  void AttributeLayer::Discard ()
+  {
+    Close ();
+    for (std::unordered_map < Attributed *, kept_attributes >::iterator it (this->kept.begin ()); it != this->kept.end (); ++it)
+      for (kept_attributes::iterator a (it->second.begin ()); a != it->second.end (); ++a)
+	it->first->Restore (a->first, a->second);
+    this->kept.clear ();
+  }
+
+  void AttributeLayer::Commit ()
+  {
+    Close ();
+    for (std::unordered_map < Attributed *, kept_attributes >::iterator it (this->kept.begin ()); it != this->kept.end (); ++it)
+      for (kept_attributes::iterator a (it->second.begin ()); a != it->second.end (); ++a)
+	delete a->second;
+    this->kept.clear ();
+  }
+
+}				// cfglib::
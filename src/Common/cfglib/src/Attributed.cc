@@ -25,11 +25,15 @@ See CREDITS.txt for credits of authorship
 #include <map>
 #include <iostream>
 #include <cassert>
+#include <algorithm>
 #include "Attributed.h"
 #include "Handle.h"
 #include "Factory.h"
 #include "SerialisableAttributes.h"
 #include "NonSerialisableAttributes.h"
+#include "BinarySerialisation.h"
+#include "AttributeLayer.h"
+#include "Arena.h"
 
 namespace cfglib
 {
@@ -42,20 +46,96 @@ namespace cfglib
   /*! Destructor */
   Attributed::~Attributed ()
   {
+    DeleteAttributes ();
+  }
+
+  void Attributed::DeleteAttributes ()
+  {
+    if (AttributeLayer * layer = AttributeLayer::Current ())
+      layer->Forget (this);
     // Deallocate attributes
     for (attributes_container::iterator it (this->attributes.begin ()); it != this->attributes.end (); ++it)
       {
 	delete it->second;
       }
+    this->attributes.clear ();
+  }
+
+  /*! The objects are always allocated in an arena, so that GetArena can find it */
+  void *Attributed::operator new (size_t size)
+  {
+    assert (size <= Arena::MAX_SIZE);
+    return Arena::Allocate (size);
+  }
+
+  void Attributed::operator delete (void *p, size_t size)
+  {
+    Arena::Deallocate (p, size);
+  }
+
+  Arena *Attributed::GetArena ()
+  {
+    return Arena::Of (this);
+  }
+
+  static bool LessId (std::pair < unsigned int, Attribute * >const &a, unsigned int id)
+  {
+    return a.first < id;
+  }
+
+  static bool LessName (std::pair < const std::string *, size_t > const &a, std::pair < const std::string *, size_t > const &b)
+  {
+    return *a.first < *b.first;
+  }
+
+  Attributed::attributes_container::iterator Attributed::Position (unsigned int id)
+  {
+    return std::lower_bound (this->attributes.begin (), this->attributes.end (), id, LessId);
+  }
+
+  Attribute *Attributed::Find (unsigned int id) const
+  {
+    attributes_container::const_iterator it (std::lower_bound (this->attributes.begin (), this->attributes.end (), id, LessId));
+    if (it != this->attributes.end () && it->first == id)
+      return it->second;
+    return NULL;
+  }
+
+  /*! The attributes used to be stored in a map indexed by name:
+   * they are still listed and serialised in that order. */
+  std::vector < size_t > Attributed::SortedByName () const
+  {
+    std::vector < std::pair < const std::string *, size_t > >names;
+    names.reserve (this->attributes.size ());
+    for (size_t i = 0; i < this->attributes.size (); i++)
+      {
+	names.push_back (std::make_pair (&AttributeKey::GetName (this->attributes[i].first), i));
+      }
+    std::sort (names.begin (), names.end (), LessName);
+    std::vector < size_t > order;
+    order.reserve (names.size ());
+    for (size_t i = 0; i < names.size (); i++)
+      {
+	order.push_back (names[i].second);
+      }
+    return order;
   }
 
   /*! Returns true if the attributed object has an attribute of name 'symbol' attached
    *  Must be called before any attempt to call method GetAttribute
    */
-  bool Attributed::HasAttribute (std::string symbol)
+  bool Attributed::HasAttribute (std::string const &symbol)
+  {
+    AttributeKey key;
+    // A name which has never been interned cannot be attached
+    if (!AttributeKey::Find (symbol, key))
+      return false;
+    return HasAttribute (key);
+  }
+
+  bool Attributed::HasAttribute (AttributeKey key)
   {
-    attributes_container::iterator it (this->attributes.find (symbol));
-    return (it != this->attributes.end ());
+    return Find (key.GetId ()) != NULL;
   }
 
   /*! Get a attribute given its name. The method makes a copy of the attribute
@@ -74,24 +154,38 @@ namespace cfglib
    *       ia=n.GetAttribute("myinteger");      // Retrieve a copy of the attribute in ia
    *       int val = ia.GetValue();             // Get it's value (here, a simple integer)
    */
-  Attribute & Attributed::GetAttribute (std::string symbol)
+  Attribute & Attributed::GetAttribute (std::string const &symbol)
   {
-    attributes_container::iterator it (this->attributes.find (symbol));
-    if (it == this->attributes.end ())
+    AttributeKey key;
+    if (!AttributeKey::Find (symbol, key) || !HasAttribute (key))
       {
 	cout << "cfglib::GetAttribute, no attribute found, attribute name " << symbol << endl;
+	assert (false);
       }
-    assert (it != this->attributes.end ());
-    Attribute *res = it->second;
+    return GetAttribute (key);
+  }
+
+  Attribute & Attributed::GetAttribute (AttributeKey key)
+  {
+    Attribute *res = Find (key.GetId ());
+    if (res == NULL)
+      {
+	cout << "cfglib::GetAttribute, no attribute found, attribute name " << (key.IsValid ()? key.GetName () : "") << endl;
+      }
+    assert (res != NULL);
+    if (res->IsLazy ())
+      res = ((LazyAttribute *) res)->Get ();
     return (*res);
   }
 
   std::vector < string > Attributed::getAttributeList (void)
   {
     std::vector < string > attrList;
-    for (attributes_container::iterator it = attributes.begin (); it != attributes.end (); it++)
+    std::vector < size_t > order (SortedByName ());
+    attrList.reserve (order.size ());
+    for (size_t i = 0; i < order.size (); i++)
       {
-	attrList.push_back (it->first);
+	attrList.push_back (AttributeKey::GetName (this->attributes[order[i]].first));
       }
     return attrList;
   }
@@ -99,18 +193,19 @@ namespace cfglib
 
   void Attributed::CloneAttributesFor (Attributed * target, CloneHandle & handle)
   {
+    ArenaScope scope (target->GetArena ());
     for (attributes_container::iterator it = this->attributes.begin (); it != this->attributes.end (); ++it)
       {
 	Attribute *clone = it->second->clone (handle);
-	attributes_container::iterator previous_pos = target->attributes.find (it->first);
-	if (previous_pos != target->attributes.end ())
+	attributes_container::iterator previous_pos = target->Position (it->first);
+	if (previous_pos != target->attributes.end () && previous_pos->first == it->first)
 	  {
 	    delete previous_pos->second;
 	    previous_pos->second = clone;
 	  }
 	else
 	  {
-	    target->attributes[it->first] = clone;
+	    target->attributes.insert (previous_pos, std::make_pair (it->first, clone));
 	  }
       }
 
@@ -120,21 +215,56 @@ namespace cfglib
    * of the attribute is stored.
    * In case an already existing attribute is replaced,
    * the attribute is deleted before the new one is
-   * installed. */
+   * installed (unless an AttributeLayer is open, see AttributeLayer.h). */
   void Attributed::SetAttribute (std::string const &symbol, Attribute & attribute)
   {
-    // cout << " SetAttribute = " << symbol << endl;
-    // Make a copy of the attribute
-    Attribute *new_attribute = attribute.clone ();
-    // Delete the former attribute with same name, if any
-    attributes_container::iterator it (this->attributes.find (symbol));
-    if (it != this->attributes.end ())
+    SetAttribute (AttributeKey (symbol), attribute);
+  }
+
+  void Attributed::SetAttribute (AttributeKey key, Attribute & attribute)
+  {
+    assert (key.IsValid ());
+    // Make a copy of the attribute, in the arena of the object
+    ArenaScope scope (GetArena ());
+    Attach (key.GetId (), attribute.clone ());
+  }
+
+  void Attributed::Attach (unsigned int id, Attribute * new_attribute)
+  {
+    // Delete the former attribute with same name, if any (or let the open layer keep it)
+    AttributeLayer *layer = AttributeLayer::Current ();
+    attributes_container::iterator it (Position (id));
+    if (it != this->attributes.end () && it->first == id)
       {
 	assert (it->second != NULL);
+	if (layer == NULL || !layer->Keep (this, id, it->second))
+	  delete it->second;
+	it->second = new_attribute;
+      }
+    else
+      {
+	if (layer != NULL)
+	  layer->Keep (this, id, NULL);
+	// Store the new attribute
+	this->attributes.insert (it, std::make_pair (id, new_attribute));
+      }
+  }
+
+  void Attributed::Restore (unsigned int id, Attribute * previous)
+  {
+    attributes_container::iterator it (Position (id));
+    if (it != this->attributes.end () && it->first == id)
+      {
 	delete it->second;
+	if (previous != NULL)
+	  it->second = previous;
+	else
+	  this->attributes.erase (it);
+      }
+    else if (previous != NULL)
+      {
+	this->attributes.insert (it, std::make_pair (id, previous));
       }
-    // Store the new attribute
-    (this->attributes)[symbol] = new_attribute;
   }
 
   /*! Remove an attribute (frees its memory) 
@@ -143,11 +273,19 @@ namespace cfglib
    */
   void Attributed::RemoveAttribute (std::string const &symbol)
   {
-    // cout << " removeAttribute = " << symbol << endl;
-    attributes_container::iterator it (this->attributes.find (symbol));
-    if (it != this->attributes.end ())
+    AttributeKey key;
+    if (AttributeKey::Find (symbol, key))
+      RemoveAttribute (key);
+  }
+
+  void Attributed::RemoveAttribute (AttributeKey key)
+  {
+    AttributeLayer *layer = AttributeLayer::Current ();
+    attributes_container::iterator it (Position (key.GetId ()));
+    if (it != this->attributes.end () && it->first == key.GetId ())
       {
-	delete it->second;
+	if (layer == NULL || !layer->Keep (this, key.GetId (), it->second))
+	  delete it->second;
 	this->attributes.erase (it);
       }
   }
@@ -175,13 +313,17 @@ namespace cfglib
   /*! Serialise all attributes */
   std::ostream & Attributed::WriteXmlAttributes (std::ostream & os, Handle & hand_ser) const
   {
-    if (this->attributes.size () != 0)
+    if (this->attributes.size () != 0 || this->attrs_list)
       {
 	os << "<ATTRS_LIST>" << std::endl;
-	for (attributes_container::const_iterator it (this->attributes.begin ()); it != this->attributes.end (); ++it)
+	std::vector < size_t > order (SortedByName ());
+	for (size_t i = 0; i < order.size (); i++)
 	  {
-	    it->second->SetName (it->first);
-	    if (SerialisableAttribute * sa = dynamic_cast < SerialisableAttribute * >(it->second))
+	    Attribute *attr = this->attributes[order[i]].second;
+	    if (attr->IsLazy ())
+	      attr = ((LazyAttribute *) attr)->Get ();
+	    attr->SetName (AttributeKey::GetName (this->attributes[order[i]].first));
+	    if (SerialisableAttribute * sa = dynamic_cast < SerialisableAttribute * >(attr))
 	      {
 		sa->WriteXml (os, hand_ser);
 	      }
@@ -199,6 +341,7 @@ namespace cfglib
     if (children.size () == 0)
       return;			// No attributes
     assert (children.size () == 1);
+    this->attrs_list = true;
     children = children[0].getAllChildren ();
     for (unsigned int c = 0; c < children.size (); c++)
       {
@@ -226,4 +369,91 @@ namespace cfglib
       }
   }
 
+  /*! Binary serialisation of the attributes: 0 when there is no ATTRS_LIST,
+   * otherwise the number of serialisable attributes plus one, then for
+   * every one its name and its record (see BinarySerialisation.h) */
+  void Attributed::WriteBinaryAttributes (BinaryWriter & w, Handle & hand) const
+  {
+    std::vector < std::pair < unsigned int, SerialisableAttribute * > >serialisable;
+    for (attributes_container::const_iterator it (this->attributes.begin ()); it != this->attributes.end (); ++it)
+      {
+	Attribute *attr = it->second;
+	if (attr->IsLazy ())
+	  attr = ((LazyAttribute *) attr)->Get ();
+	if (SerialisableAttribute * sa = dynamic_cast < SerialisableAttribute * >(attr))
+	  {
+	    serialisable.push_back (std::make_pair (it->first, sa));
+	  }
+      }
+    if (this->attributes.size () == 0 && !this->attrs_list)
+      {
+	w.PutUnsigned (0);
+	return;
+      }
+    w.PutUnsigned (serialisable.size () + 1);
+    for (size_t i = 0; i < serialisable.size (); i++)
+      {
+	std::string const &attrname = AttributeKey::GetName (serialisable[i].first);
+	serialisable[i].second->SetName (attrname);
+	w.PutName (attrname);
+	size_t record = w.BeginRecord ();
+	serialisable[i].second->WriteBinary (w, hand);
+	w.EndRecord (record);
+      }
+  }
+
+  /*! Binary deserialisation of the attributes */
+  void Attributed::ReadBinaryAttributes (BinaryReader & r, Handle & hand, bool lazy)
+  {
+    ArenaScope scope (GetArena ());
+    BinarySnapshot *snapshot = r.GetSnapshot ();
+    unsigned long long n = r.GetUnsigned ();
+    if (n == 0)
+      return;			// No attributes
+    this->attrs_list = true;
+    n = n - 1;
+    for (unsigned long long i = 0; i < n && !r.Failed (); i++)
+      {
+	unsigned int name_index = r.GetNameIndex ();
+	uint32_t length = r.GetRecordLength ();
+	if (r.Failed ())
+	  break;
+	const char *data = r.Position ();
+	r.Skip (length);
+
+	BinaryReader record (snapshot, data, data + length);
+	unsigned int type_index = record.GetNameIndex ();
+	if (record.Failed ())
+	  {
+	    r.SetFailed ();
+	    break;
+	  }
+	SerialisableAttribute *prototype = snapshot->GetPrototype (type_index);
+	if (prototype == NULL)
+	  {
+	    std::cerr << "Error: unknown attribute type: " << snapshot->GetString (type_index) << std::endl;
+	    std::cerr << "Attribute ignored in binary file" << std::endl;
+	    continue;
+	  }
+	AttributeKey key = snapshot->GetKey (name_index);
+	if (lazy)
+	  {
+	    Attach (key.GetId (), new LazyAttribute (snapshot, prototype, name_index, record.Position (), data + length, &hand));
+	  }
+	else
+	  {
+	    SerialisableAttribute *new_attribute = prototype->create ();
+	    new_attribute->ReadBinary (record, hand);
+	    if (record.Failed () || !record.AtEnd ())
+	      {
+		r.SetFailed ();
+		delete new_attribute;
+		break;
+	      }
+	    new_attribute->SetName (snapshot->GetString (name_index));
+	    Attach (key.GetId (), new_attribute);
+	  }
+      }
+  }
+
 }				// cfglib::
@@ -0,0 +1,464 @@
+/* ---------------------------------------------------------------------
+
+   Copyright IRISA, 2003-2017
+
+   This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+   estimation.
+   APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+   Heptane is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Heptane is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details (COPYING.txt).
+
+   See CREDITS.txt for credits of authorship
+
+   ------------------------------------------------------------------------ */
+
+/* #includes and forward declarations */
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <cassert>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "BinarySerialisation.h"
+#include "SerialisableAttributes.h"
+#include "Factory.h"
+#include "Handle.h"
+#include "Logger.h"
+
+/*! this namespace is the global namespace */
+namespace cfglib
+{
+  // ---------------------------------------------------
+  // Writing
+  // ---------------------------------------------------
+  void BinaryWriter::PutByte (unsigned char b)
+  {
+    body.push_back ((char) b);
+  }
+
+  void BinaryWriter::PutUnsigned (unsigned long long v)
+  {
+    while (v >= 0x80)
+      {
+	body.push_back ((char) ((v & 0x7f) | 0x80));
+	v >>= 7;
+      }
+    body.push_back ((char) v);
+  }
+
+  void BinaryWriter::PutSigned (long long v)
+  {
+    PutUnsigned (((unsigned long long) v << 1) ^ (unsigned long long) (v >> 63));
+  }
+
+  void BinaryWriter::PutDouble (double v)
+  {
+    body.append ((const char *) &v, sizeof (v));
+  }
+
+  void BinaryWriter::PutString (std::string const &s)
+  {
+    PutUnsigned (s.size ());
+    body.append (s);
+  }
+
+  void BinaryWriter::PutName (std::string const &s)
+  {
+    std::map < std::string, unsigned int >::iterator it (index.find (s));
+    if (it == index.end ())
+      {
+	it = index.insert (std::make_pair (s, (unsigned int) strings.size ())).first;
+	strings.push_back (s);
+      }
+    PutUnsigned (it->second);
+  }
+
+  size_t BinaryWriter::BeginRecord ()
+  {
+    size_t pos = body.size ();
+    body.append (sizeof (uint32_t), '\0');
+    return pos;
+  }
+
+  void BinaryWriter::EndRecord (size_t pos)
+  {
+    uint32_t length = body.size () - pos - sizeof (uint32_t);
+    memcpy (&body[pos], &length, sizeof (length));
+  }
+
+  bool BinaryWriter::WriteFile (std::string const &file_name) const
+  {
+    BinaryWriter table;
+    for (size_t i = 0; i < strings.size (); i++)
+      {
+	table.PutString (strings[i]);
+      }
+
+    BinaryProgramHeader h;
+    memset (&h, 0, sizeof (h));
+    memcpy (h.magic, BINARY_PROGRAM_MAGIC, sizeof (h.magic));
+    h.version = BINARY_PROGRAM_VERSION;
+    h.nb_strings = strings.size ();
+    h.strings_offset = sizeof (BinaryProgramHeader);
+    h.strings_length = table.body.size ();
+    h.body_offset = h.strings_offset + h.strings_length;
+    h.body_length = body.size ();
+
+    std::ofstream os (file_name.c_str (), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!os.is_open ())
+      return false;
+    os.write ((const char *) &h, sizeof (h));
+    os.write (table.body.data (), table.body.size ());
+    os.write (body.data (), body.size ());
+    os.close ();
+    return !os.fail ();
+  }
+
+  // ---------------------------------------------------
+  // Reading
+  // ---------------------------------------------------
+  BinaryReader::BinaryReader (BinarySnapshot * s, const char *begin, const char *end):snapshot (s), p (begin), end (end), failed (false)
+  {
+  }
+
+  unsigned char BinaryReader::GetByte ()
+  {
+    if (p >= end)
+      {
+	failed = true;
+	return 0;
+      }
+    return (unsigned char) *p++;
+  }
+
+  unsigned long long BinaryReader::GetUnsigned ()
+  {
+    unsigned long long v = 0;
+    for (unsigned int shift = 0; shift < 64; shift += 7)
+      {
+	if (p >= end)
+	  {
+	    failed = true;
+	    return 0;
+	  }
+	unsigned char b = (unsigned char) *p++;
+	v |= (unsigned long long) (b & 0x7f) << shift;
+	if ((b & 0x80) == 0)
+	  return v;
+      }
+    failed = true;
+    return 0;
+  }
+
+  long long BinaryReader::GetSigned ()
+  {
+    unsigned long long v = GetUnsigned ();
+    return (long long) (v >> 1) ^ -(long long) (v & 1);
+  }
+
+  double BinaryReader::GetDouble ()
+  {
+    double v = 0.0;
+    if ((size_t) (end - p) < sizeof (v))
+      {
+	failed = true;
+	p = end;
+	return v;
+      }
+    memcpy (&v, p, sizeof (v));
+    p += sizeof (v);
+    return v;
+  }
+
+  std::string BinaryReader::GetString ()
+  {
+    unsigned long long length = GetUnsigned ();
+    if (length > (unsigned long long) (end - p))
+      {
+	failed = true;
+	p = end;
+	return std::string ();
+      }
+    std::string s (p, length);
+    p += length;
+    return s;
+  }
+
+  unsigned long long BinaryReader::GetCount ()
+  {
+    unsigned long long n = GetUnsigned ();
+    if (n > (unsigned long long) (end - p))
+      {
+	failed = true;
+	return 0;
+      }
+    return n;
+  }
+
+  unsigned int BinaryReader::GetNameIndex ()
+  {
+    unsigned long long i = GetUnsigned ();
+    if (snapshot == NULL || i >= snapshot->GetNbStrings ())
+      {
+	failed = true;
+	return 0;
+      }
+    return i;
+  }
+
+  std::string const &BinaryReader::GetName ()
+  {
+    static const std::string empty;
+    unsigned int i = GetNameIndex ();
+    return failed ? empty : snapshot->GetString (i);
+  }
+
+  uint32_t BinaryReader::GetRecordLength ()
+  {
+    uint32_t length = 0;
+    if ((size_t) (end - p) < sizeof (length))
+      {
+	failed = true;
+	p = end;
+	return 0;
+      }
+    memcpy (&length, p, sizeof (length));
+    p += sizeof (length);
+    if (length > (size_t) (end - p))
+      {
+	failed = true;
+	return 0;
+      }
+    return length;
+  }
+
+  void BinaryReader::Skip (size_t n)
+  {
+    if (n > (size_t) (end - p))
+      {
+	failed = true;
+	p = end;
+      }
+    else
+      p += n;
+  }
+
+  // ---------------------------------------------------
+  // Mapped file
+  // ---------------------------------------------------
+  BinarySnapshot::BinarySnapshot ():base (NULL), size (0), nb_strings (0), references (1)
+  {
+  }
+
+  BinarySnapshot::~BinarySnapshot ()
+  {
+    if (base != NULL)
+      munmap ((void *) base, size);
+  }
+
+  bool BinarySnapshot::IsBinaryFile (std::string const &file_name)
+  {
+    char magic[8];
+    std::ifstream is (file_name.c_str (), std::ios::in | std::ios::binary);
+    if (!is.read (magic, sizeof (magic)))
+      return false;
+    return memcmp (magic, BINARY_PROGRAM_MAGIC, sizeof (magic)) == 0;
+  }
+
+  BinarySnapshot *BinarySnapshot::Open (std::string const &file_name, std::string & error)
+  {
+    int fd = ::open (file_name.c_str (), O_RDONLY);
+    if (fd < 0)
+      {
+	error = "unable to open " + file_name;
+	return NULL;
+      }
+    struct stat st;
+    if (fstat (fd, &st) != 0 || (size_t) st.st_size < sizeof (BinaryProgramHeader))
+      {
+	::close (fd);
+	error = file_name + " is not a binary program file (too small)";
+	return NULL;
+      }
+    void *m = mmap (NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close (fd);
+    if (m == MAP_FAILED)
+      {
+	error = "unable to map " + file_name;
+	return NULL;
+      }
+    BinarySnapshot *s = new BinarySnapshot ();
+    s->base = (const char *) m;
+    s->size = st.st_size;
+
+    // Header and bounds checks
+    const BinaryProgramHeader & h = *(const BinaryProgramHeader *) s->base;
+    bool ok = memcmp (h.magic, BINARY_PROGRAM_MAGIC, sizeof (h.magic)) == 0;
+    if (!ok)
+      error = file_name + " is not a binary program file (bad magic)";
+    if (ok && h.version != BINARY_PROGRAM_VERSION)
+      {
+	ok = false;
+	error = file_name + ": unsupported binary program version";
+      }
+    if (ok && (h.strings_offset + h.strings_length > s->size || h.body_offset + h.body_length > s->size))
+      {
+	ok = false;
+	error = file_name + ": truncated binary program file";
+      }
+
+    // String table
+    if (ok)
+      {
+	s->nb_strings = h.nb_strings;
+	s->strings.reserve (h.nb_strings);
+	BinaryReader r (s, s->base + h.strings_offset, s->base + h.strings_offset + h.strings_length);
+	for (unsigned int i = 0; i < h.nb_strings && !r.Failed (); i++)
+	  {
+	    s->strings.push_back (r.GetString ());
+	  }
+	if (r.Failed ())
+	  {
+	    ok = false;
+	    error = file_name + ": corrupted string table";
+	  }
+	s->keys.assign (h.nb_strings, AttributeKey ());
+	s->prototypes.assign (h.nb_strings, (SerialisableAttribute *) NULL);
+	s->known.assign (h.nb_strings, false);
+      }
+    if (!ok)
+      {
+	delete s;
+	return NULL;
+      }
+    return s;
+  }
+
+  void BinarySnapshot::Retain ()
+  {
+    references++;
+  }
+
+  void BinarySnapshot::Release ()
+  {
+    if (--references == 0)
+      delete this;
+  }
+
+  const char *BinarySnapshot::GetBody () const
+  {
+    return base + ((const BinaryProgramHeader *) base)->body_offset;
+  }
+
+  const char *BinarySnapshot::GetBodyEnd () const
+  {
+    return GetBody () + ((const BinaryProgramHeader *) base)->body_length;
+  }
+
+  std::string const &BinarySnapshot::GetString (unsigned int i) const
+  {
+    assert (i < nb_strings);
+    return strings[i];
+  }
+
+  AttributeKey BinarySnapshot::GetKey (unsigned int i)
+  {
+    assert (i < nb_strings);
+    if (!keys[i].IsValid ())
+      {
+	keys[i] = AttributeKey (strings[i]);
+      }
+    return keys[i];
+  }
+
+  SerialisableAttribute *BinarySnapshot::GetPrototype (unsigned int i)
+  {
+    assert (i < nb_strings);
+    if (!known[i])
+      {
+	prototypes[i] = AttributesFactory::GetInstance ()->GetAttributeType (strings[i]);
+	known[i] = true;
+      }
+    return prototypes[i];
+  }
+
+  // ---------------------------------------------------
+  // Lazy attributes
+  // ---------------------------------------------------
+
+  /*! Lock of the decoding of the lazy attributes (and of the snapshot caches it uses) */
+  static std::mutex lazy_mutex;
+
+  LazyAttribute::LazyAttribute (BinarySnapshot * s, SerialisableAttribute * prototype, unsigned int name_index,
+				const char *data, const char *data_end, Handle * hand):snapshot (s), prototype (prototype),
+    name_index (name_index), data (data), data_end (data_end), hand (hand), value (NULL)
+  {
+    lazy = true;
+    snapshot->Retain ();
+  }
+
+  LazyAttribute::~LazyAttribute ()
+  {
+    Attribute *v = value.load ();
+    if (v != NULL)
+      delete v;
+    else
+      snapshot->Release ();
+  }
+
+  Attribute *LazyAttribute::Get ()
+  {
+    Attribute *v = value.load (std::memory_order_acquire);
+    if (v != NULL)
+      return v;
+    std::lock_guard < std::mutex > lock (lazy_mutex);
+    v = value.load (std::memory_order_relaxed);
+    if (v == NULL)
+      {
+	// In the arena of the object the attribute is attached to
+	ArenaScope scope (Arena::Of (this));
+	SerialisableAttribute *a = prototype->create ();
+	BinaryReader r (snapshot, data, data_end);
+	a->ReadBinary (r, *hand);
+	if (r.Failed () || !r.AtEnd ())
+	  {
+	    delete a;
+	    Logger::addFatal ("LazyAttribute: corrupted binary attribute " + snapshot->GetString (name_index));
+	    return NULL;
+	  }
+	a->SetName (snapshot->GetString (name_index));
+	v = a;
+	value.store (v, std::memory_order_release);
+	snapshot->Release ();
+      }
+    return v;
+  }
+
+  Attribute *LazyAttribute::clone ()
+  {
+    return Get ()->clone ();
+  }
+
+  Attribute *LazyAttribute::clone (CloneHandle & handle)
+  {
+    return Get ()->clone (handle);
+  }
+
+  void LazyAttribute::Print (std::ostream & os)
+  {
+    Get ()->Print (os);
+  }
+
+}				// cfglib::
@@ -32,6 +32,7 @@
 #include "Cfg.h"
 #include "Node.h"
 #include "Program.h"
+#include "BinarySerialisation.h"
 
 /*! this namespace is the global namespace */
 namespace cfglib {
@@ -173,6 +174,7 @@ namespace cfglib {
    * the CFG with this function which returns a
    * pointer to the new node. The first created
    * node is automatically set as the start node. */ Node *Cfg::CreateNewNode(enum node_type type) {
+    ArenaScope scope(GetArena());
     external = false;
     Node *pBB_basic_block = new Node(this, type);
     if (this->nodes.empty())
@@ -187,6 +189,7 @@ namespace cfglib {
    * edge from the first to the second. This
    * edge must not yet exist. */
   Edge *Cfg::CreateNewEdge(Node * origin, Node * destination) {
+    ArenaScope scope(GetArena());
     Edge *pE_created = new Edge(origin, destination, this);
     this->edges.push_back(pE_created);
     return pE_created;
@@ -227,6 +230,7 @@ namespace cfglib {
 
   /*! internal function for adding a Edge not-initialised */
   Edge *Cfg::CreateNewEdge() {
+    ArenaScope scope(GetArena());
     Edge *pE_created = new Edge();
     this->edges.push_back(pE_created);
     return pE_created;
@@ -234,6 +238,7 @@ namespace cfglib {
 
   /*! internal function for deserialisation of Loops */
   Loop *Cfg::CreateNewLoop() {
+    ArenaScope scope(GetArena());
     Loop *new_loop = new Loop();
     this->loops.push_back(new_loop);
     return new_loop;
@@ -372,6 +377,7 @@ namespace cfglib {
    * natural loops, with only one entry point.
    * */
   Loop *Cfg::CreateNewLoop(Node * headNode, std::vector < Node * >const &otherNodes) {
+    ArenaScope scope(GetArena());
     Loop *new_loop = new Loop();
     new_loop->AddNode(headNode);
     for (std::vector < Node * >::const_iterator it(otherNodes.begin()); it != otherNodes.end(); ++it)
@@ -501,6 +507,73 @@ namespace cfglib {
       }
   }
 
+  /*! Binary serialisation function (the name is written by Program::WriteBinary). */
+  void Cfg::WriteBinary(BinaryWriter & w, Handle & hand)
+  {
+    w.PutUnsigned(hand.identifier(this));
+    w.PutUnsigned(hand.identifier(this->startNode));
+    w.PutUnsigned(this->endNodes.size());
+    for (std::vector < Node * >::const_iterator it = this->endNodes.begin(); it != this->endNodes.end(); ++it)
+      {
+	w.PutUnsigned(hand.identifier(*it));
+      }
+    w.PutUnsigned(this->nodes.size());
+    for (std::vector < Node * >::const_iterator it = this->nodes.begin(); it != this->nodes.end(); it++)
+      {
+	(*it)->WriteBinary(w, hand);
+      }
+    w.PutUnsigned(this->edges.size());
+    for (std::vector < Edge * >::const_iterator it = this->edges.begin(); it != this->edges.end(); it++)
+      {
+	(*it)->WriteBinary(w, hand);
+      }
+    w.PutUnsigned(this->loops.size());
+    for (std::vector < Loop * >::const_iterator it(this->loops.begin()); it != this->loops.end(); ++it)
+      {
+	(*it)->WriteBinary(w, hand);
+      }
+    this->WriteBinaryAttributes(w, hand);
+  }
+
+  /*! Binary deserialisation function, same construction as ReadXml. */
+  void Cfg::ReadBinary(BinaryReader & r, Handle & hand)
+  {
+    hand.addID_serialisable((int) r.GetUnsigned(), this);
+    int startid = r.GetUnsigned();
+
+    this->endNodes.assign(r.GetCount(), (Node *) NULL);
+    for (unsigned int i = 0; i < this->endNodes.size(); i++)
+      {
+	hand.addID_handle((int) r.GetUnsigned(), (Serialisable **) & (this->endNodes[i]));
+      }
+
+    unsigned long long n = r.GetCount();
+    for (unsigned long long i = 0; i < n && !r.Failed(); i++)
+      {
+	// The type and the identifier are read again by Node::ReadBinary
+	BinaryReader peek(r);
+	bool call = peek.GetByte() != 0;
+	int id = peek.GetUnsigned();
+	Node *bb = this->CreateNewNode(call ? Call : BB);
+	if (!call && id == startid)
+	  this->SetStartNode(bb);
+	bb->ReadBinary(r, hand);
+      }
+    n = r.GetCount();
+    for (unsigned long long i = 0; i < n && !r.Failed(); i++)
+      {
+	Edge *edge = this->CreateNewEdge();
+	edge->ReadBinary(r, hand);
+      }
+    n = r.GetCount();
+    for (unsigned long long i = 0; i < n && !r.Failed(); i++)
+      {
+	Loop *loop = this->CreateNewLoop();
+	loop->ReadBinary(r, hand);
+      }
+    this->ReadBinaryAttributes(r, hand, true);
+  }
+
   void Cfg::YixianTestName(){
     cout << "This is Yixian test" << endl;
   }
@@ -28,6 +28,7 @@
 #include <iostream>
 #include "Cfg.h"
 #include "Handle.h"
+#include "BinarySerialisation.h"
 #include <cassert>
 
 /*! this namespace is the global namespace */
@@ -121,4 +122,24 @@ namespace cfglib
     }
   }
 
+  /*! Binary serialisation function. */
+  void Edge::WriteBinary(BinaryWriter& w, Handle& hand)
+  {
+    w.PutUnsigned(hand.identifier(this));
+    w.PutUnsigned(hand.identifier(this->origin));
+    w.PutUnsigned(hand.identifier(this->destination));
+    this->WriteBinaryAttributes(w, hand);
+  }
+
+  /*! Binary deserialisation function (the Edge is created by Cfg::ReadBinary) */
+  void Edge::ReadBinary(BinaryReader& r, Handle& hand)
+  {
+    hand.addID_serialisable((int) r.GetUnsigned(), this);
+    this->origin = NULL;
+    this->destination = NULL;
+    hand.addID_handle((int) r.GetUnsigned(), (Serialisable **)&(this->origin));
+    hand.addID_handle((int) r.GetUnsigned(), (Serialisable **)&(this->destination));
+    this->ReadBinaryAttributes(r, hand, true);
+  }
+
 } // cfglib::
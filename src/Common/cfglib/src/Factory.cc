@@ -35,6 +35,9 @@ namespace cfglib
   /*! Global attribute factory */
   AttributesFactory *global_factory = NULL;
 
+  /*! Factory bound to the calling thread, NULL for the global one */
+  static thread_local AttributesFactory *bound_factory = NULL;
+
   /* constructor. initialise this factory with basic types
    * `string`, `integer` `unsignedlong` and `attribute_list`. */
   AttributesFactory::AttributesFactory() {
@@ -64,6 +67,11 @@ namespace cfglib
     return 0;
   }
   
+  SerialisableAttribute *AttributesFactory::GetAttributeType(std::string const& type) {
+    std::map<std::string, SerialisableAttribute* >::const_iterator it(this->map.find(type));
+    return (it != this->map.end()) ? it->second : NULL;
+  }
+
   void AttributesFactory::SetAttributeType( std::string const& type, SerialisableAttribute* constructor) 
   {
     std::map<std::string, SerialisableAttribute*>::iterator it(this->map.find(type)) ;
@@ -75,6 +83,7 @@ namespace cfglib
   
   /*! Access to global attribute factory */
   AttributesFactory* AttributesFactory::GetInstance() {
+    if (bound_factory!=NULL) return bound_factory;
     if (global_factory==NULL) {
       global_factory=new AttributesFactory();
     }
@@ -86,4 +95,19 @@ namespace cfglib
     if (global_factory!=NULL) delete global_factory;
   }
 
+  AttributesFactory* AttributesFactory::Create() {
+    return new AttributesFactory();
+  }
+
+  void AttributesFactory::Destroy(AttributesFactory* factory) {
+    if (bound_factory==factory) bound_factory=NULL;
+    delete factory;
+  }
+
+  AttributesFactory* AttributesFactory::Bind(AttributesFactory* factory) {
+    AttributesFactory* previous = bound_factory;
+    bound_factory = factory;
+    return previous;
+  }
+
 } // cfglib::
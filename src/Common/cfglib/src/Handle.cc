@@ -38,11 +38,52 @@ namespace cfglib
 
   Handle::Handle()
   { }
+
+  bool Handle::isIntegerId(std::string const& s, int& id){
+    if (s.empty() || s.size() > 9) return false;
+    id = 0;
+    for (size_t i = 0; i < s.size(); i++) {
+      if (s[i] < '0' || s[i] > '9') return false;
+      id = id * 10 + (s[i] - '0');
+    }
+    // "007" would not be given by identify
+    return s.size() == 1 || s[0] != '0';
+  }
+
+  void Handle::addID_serialisable(int id, Serialisable* attr){
+    assert (id >= 0);
+    if ((size_t) id >= int_serialisable.size()) int_serialisable.resize(id + 1, NULL);
+    assert (int_serialisable[id] == NULL);
+    int_serialisable[id] = attr;
+
+    // Replace known handles with their final values.
+    if (!int_handle.empty()) {
+      std::map<int, std::vector<Serialisable**> >::iterator it = int_handle.find(id);
+      if (it != int_handle.end()) {
+	for (size_t i = 0; i < it->second.size(); i++) *(it->second[i]) = attr;
+	int_handle.erase(it);
+      }
+    }
+  }
+
+  void Handle::addID_handle(int id, Serialisable** ptr){
+    if (id >= 0 && (size_t) id < int_serialisable.size() && int_serialisable[id] != NULL) {
+      *ptr = int_serialisable[id];
+    }
+    else {
+      int_handle[id].push_back(ptr);
+    }
+  }
   
   /*! Declare a Serialisable and its identifier. Objects are
    * declared by the library, not intended for library
    * user. */
   void Handle::addID_serialisable(std::string const& id, Serialisable* attr){
+    int n;
+    if (isIntegerId(id, n)) {
+      addID_serialisable(n, attr);
+      return;
+    }
 		assert (id_serialisable.find(id) == id_serialisable.end());
 		id_serialisable[id]=attr;
 
@@ -62,6 +103,11 @@ namespace cfglib
    * called. The first argument is a string id and the second is a pointer to the memory place of the handle Serialisable*
    * ATTENTION : ptr must be use only with no ordered structure !!! */
   void Handle::addID_handle(std::string const& id,Serialisable** ptr){
+    int n;
+    if (isIntegerId(id, n)) {
+      addID_handle(n, ptr);
+      return;
+    }
 		if(id_serialisable.find(id) != id_serialisable.end()){
 			*ptr=id_serialisable[id];
 		} 
@@ -99,6 +145,8 @@ namespace cfglib
 	*ptr=id_serialisable[currentID];
       }
     }
+    // the integer handles are resolved by addID_serialisable, those left refer to undeclared objects
+    assert(int_handle.empty());
   }
   
 
@@ -108,11 +156,15 @@ namespace cfglib
    * careful to not modify dynamic containers during
    * serialisation. */
   std::string Handle::identify(Serialisable const* obj){
+    return int_to_string(identifier(obj));
+  }
 
-    if(identifiers.count(obj)==1) return int_to_string(identifiers[obj]);
+  int Handle::identifier(Serialisable const* obj){
+    std::map<Serialisable const*, int>::iterator it = identifiers.find(obj);
+    if (it != identifiers.end()) return it->second;
     int id = identifiers.size();
     identifiers[obj]=id;
-    return int_to_string(id);
+    return id;
   }
 
   std::string Handle::getId(Serialisable const* obj){
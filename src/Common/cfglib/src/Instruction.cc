@@ -26,6 +26,7 @@
 #include "Handle.h"
 #include "Helper.h"
 #include "Instruction.h"
+#include "BinarySerialisation.h"
 
 /*! this namespace is the global namespace */
 namespace cfglib
@@ -136,6 +137,25 @@ namespace cfglib
     this->ReadXmlAttributes (tag, hand);
   }
 
+  /*! Binary serialisation function */
+  void Instruction::WriteBinary (BinaryWriter & w, Handle & hand)
+  {
+    w.PutUnsigned (hand.identifier (this));
+    w.PutName (asm_string_from_type (this->type));
+    w.PutName (this->code);
+    this->WriteBinaryAttributes (w, hand);
+  }
+
+  /*! Binary unserialisation function */
+  void Instruction::ReadBinary (BinaryReader & r, Handle & hand)
+  {
+    int id = r.GetUnsigned ();
+    this->type = asm_type_from_string (r.GetName ());
+    this->code = r.GetName ();
+    hand.addID_serialisable (id, this);
+    this->ReadBinaryAttributes (r, hand, true);
+  }
+
   std::string Instruction::GetCode ()
   {
     return this->code;
@@ -31,6 +31,7 @@
 #include "Handle.h"
 #include "Node.h"
 #include "Cfg.h"
+#include "BinarySerialisation.h"
 
 /*! this namespace is the global namespace */
 namespace cfglib 
@@ -148,6 +149,38 @@ namespace cfglib
     }
   }
   
+  /*! Binary serialisation function. */
+  void Loop::WriteBinary(BinaryWriter& w, Handle& hand)
+  {
+    w.PutUnsigned(hand.identifier(this));
+    w.PutUnsigned(hand.identifier(this->head));
+    w.PutUnsigned(this->nodes.size());
+    for (std::vector<Node*>::const_iterator it(this->nodes.begin()); it != this->nodes.end(); ++it) {
+      w.PutUnsigned(hand.identifier(*it));
+    }
+    w.PutUnsigned(this->backedges.size());
+    for (std::vector<Edge*>::const_iterator it(this->backedges.begin()); it != this->backedges.end(); ++it) {
+      w.PutUnsigned(hand.identifier(*it));
+    }
+    this->WriteBinaryAttributes(w, hand);
+  }
+
+  /*! Binary deserialisation function (the Loop is created by Cfg::ReadBinary) */
+  void Loop::ReadBinary(BinaryReader& r, Handle& hand)
+  {
+    hand.addID_serialisable((int) r.GetUnsigned(), this);
+    hand.addID_handle((int) r.GetUnsigned(), (Serialisable **)&(this->head));
+    this->nodes.assign(r.GetCount(), (Node*) NULL);
+    for (unsigned int i = 0; i < this->nodes.size(); i++) {
+      hand.addID_handle((int) r.GetUnsigned(), (Serialisable **)&(this->nodes[i]));
+    }
+    this->backedges.assign(r.GetCount(), (Edge*) NULL);
+    for (unsigned int i = 0; i < this->backedges.size(); i++) {
+      hand.addID_handle((int) r.GetUnsigned(), (Serialisable **)&(this->backedges[i]));
+    }
+    this->ReadBinaryAttributes(r, hand, true);
+  }
+
   /*! Add nodes to the loop, the first Node added must be the head of the loop */
   void Loop::AddNode(Node* new_node) 
   {
@@ -29,6 +29,7 @@
 #include "Handle.h"
 #include "Instruction.h"
 #include "Cfg.h"
+#include "BinarySerialisation.h"
 
 /*! this namespace is the global namespace */
 namespace cfglib 
@@ -182,6 +183,36 @@ namespace cfglib
     this->ReadXmlAttributes(tag, hand) ;
   }
   
+  /*! Binary serialisation function */
+  void Node::WriteBinary(BinaryWriter& w, Handle& hand)
+  {
+    w.PutByte(this->type == Call);
+    w.PutUnsigned(hand.identifier(this));
+    if (Call == this->type) w.PutName(this->callee_name);
+    w.PutUnsigned(this->instructions.size());
+    for (std::vector<Instruction*>::const_iterator it(this->instructions.begin()) ; it != this->instructions.end() ; it++)
+      {
+	(*it)->WriteBinary(w, hand);
+      }
+    this->WriteBinaryAttributes(w, hand);
+  }
+
+  /*! Binary unserialisation function (the node has been created with the type of the record) */
+  void Node::ReadBinary(BinaryReader& r, Handle& hand)
+  {
+    node_type t = r.GetByte() ? Call : BB;
+    assert(r.Failed() || this->type == t);
+    hand.addID_serialisable((int) r.GetUnsigned(), this);
+    if (this->type == Call) this->callee_name = r.GetName();
+    unsigned long long n = r.GetCount();
+    for (unsigned long long i = 0; i < n && !r.Failed(); i++) {
+      Instruction* inst = new Instruction() ;
+      inst->ReadBinary(r, hand) ;
+      this->instructions.push_back(inst) ;
+    }
+    this->ReadBinaryAttributes(r, hand, true);
+  }
+
   /*! Get instructions vector */
   std::vector<Instruction*> Node::GetInstructions()
   {
@@ -205,6 +236,7 @@ namespace cfglib
   Instruction* Node::CreateNewInstruction( std::string const& code, asm_type type, bool ret)
   {
     dbg_instr(std::cerr << "CreateNewInstruction called" << std::endl ;);
+    ArenaScope scope(GetArena()) ;
     Instruction* inst = new Instruction(code, type) ;
     this->instructions.push_back(inst) ;
     this->is_return = (this->is_return || ret) ;
@@ -30,21 +30,24 @@
 #include "Handle.h"
 #include "CloneHandle.h"
 #include "Factory.h"
+#include "BinarySerialisation.h"
+#include "Logger.h"
 
 /* this namespace is the global namespace */
 namespace cfglib 
 {
 
   /* constructors. */
-  Program::Program(string pgm_name) : entry_point(0), name(pgm_name)
+  Program::Program(string pgm_name) : entry_point(0), name(pgm_name), arena(Arena::Create())
   {}
 
-  Program::Program() : entry_point(0), name("")
+  Program::Program() : entry_point(0), name(""), arena(Arena::Create())
   {}
 
   Program* Program::Clone(){
     CloneHandle handle;
     Program *P = new Program(name);
+    ArenaScope scope(P->arena);
 
     handle.RegisterClone (this, P);
     handle.ResolveClone (this->entry_point, (void**)&(P->entry_point));
@@ -68,12 +71,21 @@ namespace cfglib
      entry_point because it is a pointer on a Cfg from the list. */
   Program::~Program()
   {
+    this->arena->TearDown();
     for (listOfCfg::iterator it = this->cfgs_list.begin();
 	 it != this->cfgs_list.end();
 	 it ++)
       {
 	delete (*it) ;
       }
+    // The attributes of the program are in the arena too: deleted before its chunks
+    this->DeleteAttributes();
+    this->arena->Release();
+  }
+
+  Arena* Program::GetArena()
+  {
+    return this->arena;
   }
 
   /* Get program name */
@@ -92,6 +104,7 @@ namespace cfglib
    * entry point. */
   Cfg* Program::CreateNewCfg(ListOfString const& name)
   {
+    ArenaScope scope(this->arena);
     Cfg* cfg = new Cfg(this, name);
     if (NULL == this->entry_point) { this->entry_point = cfg ; }
     this->cfgs_list.push_back(cfg);
@@ -179,6 +192,7 @@ namespace cfglib
   void Program::ReadXml(XmlTag const* tag, Handle& h)
   {
     assert(tag->getName()==string("PROGRAM"));
+    ArenaScope scope(this->arena);
     this->name = tag->getAttributeString("name");
     assert(this->name!="");
     string entry_point_number = tag->getAttributeString("entry");
@@ -208,7 +222,89 @@ namespace cfglib
     h.resolveHandles();
   }
 
+  /* Binary serialisation function, same contents as WriteXml */
+  void Program::WriteBinary(BinaryWriter& w, Handle& hand)
+  {
+    w.PutUnsigned(hand.identifier(this));
+    w.PutString(this->name);
+    w.PutUnsigned(hand.identifier(this->entry_point));
+    w.PutUnsigned(this->cfgs_list.size());
+    for (listOfCfg::const_iterator it = this->cfgs_list.begin(); it != this->cfgs_list.end(); it++)
+      {
+	w.PutString((*it)->getStringName());
+	(*it)->WriteBinary(w, hand);
+      }
+    this->WriteBinaryAttributes(w, hand);
+  }
+
+  /* Binary deserialisation function. The attributes of the program
+     are decoded at once, the other ones at their first access. */
+  void Program::ReadBinary(BinaryReader& r, Handle& h)
+  {
+    ArenaScope scope(this->arena);
+    h.addID_serialisable((int) r.GetUnsigned(), this);
+    this->name = r.GetString();
+    this->entry_point = NULL;
+    h.addID_handle((int) r.GetUnsigned(), (Serialisable **)&(this->entry_point));
+    unsigned long long n = r.GetCount();
+    for (unsigned long long c = 0; c < n && !r.Failed(); c++)
+      {
+	// Same splitting of the names as ReadXml
+	istringstream lnames(r.GetString());
+	string aname;
+	ListOfString names;
+	while (!lnames.eof())
+	  {
+	    getline(lnames, aname,' ');
+	    names.push_front(aname);
+	  }
+	Cfg* cfg = this->CreateNewCfg(names);
+	cfg->ReadBinary(r, h);
+      }
+    this->ReadBinaryAttributes(r, h, false);
+    if (!r.Failed()) h.resolveHandles();
+  }
+
+  Program *Program::unserialise_program_binary(std::string const& file_name) {
+    std::string error;
+    BinarySnapshot *snapshot = BinarySnapshot::Open(file_name, error);
+    if (snapshot == NULL)
+      {
+	Logger::addFatal("Program: " + error);
+	return NULL;
+      }
+    Program *prog_deserialise = new Program();
+    BinaryReader r(snapshot, snapshot->GetBody(), snapshot->GetBodyEnd());
+    prog_deserialise->ReadBinary(r, prog_deserialise->hand);
+    bool ok = !r.Failed() && r.AtEnd();
+    // The lazy attributes keep the file mapped
+    snapshot->Release();
+    if (!ok)
+      {
+	delete prog_deserialise;
+	Logger::addFatal("Program: corrupted binary program file " + file_name);
+	return NULL;
+      }
+    return prog_deserialise;
+  }
+
+  void Program::serialise_program_binary(std::string const& file_name)
+  {
+    BinaryWriter w;
+    this->WriteBinary(w, this->hand);
+    if (!w.WriteFile(file_name))
+      {
+	Logger::addFatal("Program: unable to write the binary program file " + file_name);
+      }
+  }
+
+  bool Program::is_binary_program_file(std::string const& file_name)
+  {
+    return BinarySnapshot::IsBinaryFile(file_name);
+  }
+
   Program *Program::unserialise_program_file(std::string const& file_name) {
+    if (is_binary_program_file(file_name)) return unserialise_program_binary(file_name);
     Program *prog_deserialise = new Program();
     XmlDocument docu(file_name);
     XmlTag root = docu.getRootTag();
@@ -26,12 +26,49 @@ See CREDITS.txt for credits of authorship
 #include <cassert>
 #include <iostream>
 #include <sstream>
+#include <libxml/parser.h>
 #include "SerialisableAttributes.h"
+#include "BinarySerialisation.h"
+#include "Logger.h"
+#include "Factory.h"
 #include "Handle.h"
 
 /*! this namespace is the global namespace */
 namespace cfglib 
 {
+  /*! Default binary serialisation: the type is taken from the XML
+   * serialisation of the attribute (<ATTR type="..." ...>), which is
+   * stored as a string. */
+  void SerialisableAttribute::WriteBinary(BinaryWriter& w, Handle& hand)
+  {
+    std::ostringstream os ;
+    this->WriteXml(os, hand) ;
+    std::string xml = os.str() ;
+    std::string type ;
+    size_t begin = xml.find("type=\"") ;
+    if (begin != std::string::npos)
+      {
+	begin += 6 ;
+	type = xml.substr(begin, xml.find('"', begin) - begin) ;
+      }
+    w.PutName(type) ;
+    w.PutString(xml) ;
+  }
+
+  void SerialisableAttribute::ReadBinary(BinaryReader& r, Handle& hand)
+  {
+    std::string xml = r.GetString() ;
+    xmlDocPtr doc = xmlReadMemory(xml.data(), xml.size(), NULL, NULL, 0) ;
+    if (doc == NULL)
+      {
+	Logger::addFatal("SerialisableAttribute: invalid XML contents in a binary attribute") ;
+	return ;
+      }
+    XmlTag tag(doc) ;
+    this->ReadXml(&tag, hand) ;
+    xmlFreeDoc(doc) ;
+  }
+
   /*! Virtual constructor */
   SerialisableIntegerAttribute* SerialisableIntegerAttribute::clone() 
   {   
@@ -65,6 +102,17 @@ namespace cfglib
     this->value = atoi(val.c_str());	
   }
 
+  void SerialisableIntegerAttribute::WriteBinary(BinaryWriter& w, Handle& hand)
+  {
+    w.PutName("integer") ;
+    w.PutSigned(this->value) ;
+  }
+
+  void SerialisableIntegerAttribute::ReadBinary(BinaryReader& r, Handle& hand)
+  {
+    this->value = r.GetSigned() ;
+  }
+
   /*! Virtual constructor */
   SerialisableFloatAttribute* SerialisableFloatAttribute::clone() 
   {   
@@ -97,6 +145,17 @@ namespace cfglib
     this->value = atof(val.c_str());	
   }
 
+  void SerialisableFloatAttribute::WriteBinary(BinaryWriter& w, Handle& hand)
+  {
+    w.PutName("float") ;
+    w.PutDouble(this->value) ;
+  }
+
+  void SerialisableFloatAttribute::ReadBinary(BinaryReader& r, Handle& hand)
+  {
+    this->value = r.GetDouble() ;
+  }
+
   /*! virtual constructor */
   SerialisableUnsignedLongAttribute* SerialisableUnsignedLongAttribute::clone() 
   {   return new SerialisableUnsignedLongAttribute(*this) ; }
@@ -128,6 +187,17 @@ namespace cfglib
     this->value = atol(val.c_str());
   }
 
+  void SerialisableUnsignedLongAttribute::WriteBinary(BinaryWriter& w, Handle& hand)
+  {
+    w.PutName("unsignedlong") ;
+    w.PutUnsigned(this->value) ;
+  }
+
+  void SerialisableUnsignedLongAttribute::ReadBinary(BinaryReader& r, Handle& hand)
+  {
+    this->value = r.GetUnsigned() ;
+  }
+
   /*! virtual constructor */
   SerialisableStringAttribute* SerialisableStringAttribute::clone() 
   {   return new SerialisableStringAttribute(*this) ; }
@@ -158,6 +228,17 @@ namespace cfglib
     this->value = tag->getAttributeString(std::string("value"));
   }
 
+  void SerialisableStringAttribute::WriteBinary(BinaryWriter& w, Handle& hand)
+  {
+    w.PutName("string") ;
+    w.PutString(this->value) ;
+  }
+
+  void SerialisableStringAttribute::ReadBinary(BinaryReader& r, Handle& hand)
+  {
+    this->value = r.GetString() ;
+  }
+
 ///-----------------------
 /*! Virtual constructor */
   SerialisableListAttribute* SerialisableListAttribute::clone() 
@@ -246,6 +327,34 @@ SerialisableListAttribute::clone(CloneHandle& handle) {
 		}
 	}
   }
+
+  /*! Binary serialisation: number of elements, then the name and the
+   * binary serialisation (type included) of every element */
+  void SerialisableListAttribute::WriteBinary(BinaryWriter& w, Handle& hand)
+  {
+    w.PutName("list") ;
+    w.PutUnsigned(this->value.size()) ;
+    for (list<SerialisableAttribute*>::const_iterator iter = value.begin(); iter != value.end(); iter++)
+      {
+	w.PutName((*iter)->GetName()) ;
+	(*iter)->WriteBinary(w, hand) ;
+      }
+  }
+
+  void SerialisableListAttribute::ReadBinary(BinaryReader& r, Handle& hand)
+  {
+    unsigned long long n = r.GetCount() ;
+    for (unsigned long long i = 0; i < n && !r.Failed(); i++)
+      {
+	std::string const& element_name = r.GetName() ;
+	SerialisableAttribute* prototype = r.GetSnapshot()->GetPrototype(r.GetNameIndex()) ;
+	assert (prototype != 0) ;
+	SerialisableAttribute* current = prototype->create() ;
+	current->ReadBinary(r, hand) ;
+	current->SetName(element_name) ;
+	value.push_back(current) ;
+      }
+  }
 	
 	SerialisableListAttribute::SerialisableListAttribute(SerialisableListAttribute &v){
 	  
@@ -0,0 +1,266 @@
+/* ---------------------------------------------------------------------
+
+   Copyright IRISA, 2003-2017
+
+   This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+   estimation.
+   APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+   Heptane is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Heptane is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details (COPYING.txt).
+
+   See CREDITS.txt for credits of authorship
+
+   ------------------------------------------------------------------------ */
+
+#include "FootprintFile.h"
+#include <fstream>
+#include <string.h>
+#include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/** Rounds offset up to a multiple of 8 */
+static uint64_t
+align8 (uint64_t offset)
+{
+  return (offset + 7) & ~((uint64_t) 7);
+}
+
+FootprintFile::FootprintFile ():base (NULL), size (0)
+{ }
+
+FootprintFile::~FootprintFile ()
+{
+  close ();
+}
+
+// ---------------------------------------------------
+// Writing: the layout is computed first, then the
+// file is written sequentially with zero padding.
+// ---------------------------------------------------
+bool
+FootprintFile::write (const string & file_name, const string & task, const vector < FootprintSection > &sections)
+{
+  FootprintFileHeader fh;
+  memset (&fh, 0, sizeof (fh));
+  memcpy (fh.magic, FOOTPRINT_MAGIC, sizeof (fh.magic));
+  fh.version = FOOTPRINT_VERSION;
+  fh.nb_sections = sections.size ();
+  fh.task_offset = sizeof (FootprintFileHeader) + sections.size () * sizeof (FootprintSectionHeader);
+  fh.task_length = task.size ();
+
+  vector < FootprintSectionHeader > sh (sections.size ());
+  uint64_t offset = align8 (fh.task_offset + fh.task_length);
+  for (size_t i = 0; i < sections.size (); i++)
+    {
+      const FootprintSection & s = sections[i];
+      assert (s.hb.size () == s.nbsets && s.cb.size () == s.nbsets);
+      memset (&sh[i], 0, sizeof (FootprintSectionHeader));
+      sh[i].level = s.level;
+      sh[i].kind = s.kind;
+      sh[i].nbsets = s.nbsets;
+      sh[i].nbways = s.nbways;
+      sh[i].cachelinesize = s.cachelinesize;
+      sh[i].flags = s.flags;
+      sh[i].hb_offset = offset;
+      offset += s.nbsets * sizeof (uint64_t);
+      sh[i].cb_offset = offset;
+      offset += s.nbsets * sizeof (uint64_t);
+      sh[i].hb_blocks_offset = offset;
+      sh[i].hb_blocks_count = s.hbBlocks.size ();
+      offset += s.hbBlocks.size () * sizeof (uint64_t);
+      sh[i].cb_blocks_offset = offset;
+      sh[i].cb_blocks_count = s.cbBlocks.size ();
+      offset += s.cbBlocks.size () * sizeof (uint64_t);
+    }
+
+  ofstream os (file_name.c_str (), ios::out | ios::binary | ios::trunc);
+  if (!os.is_open ()) return false;
+  os.write ((const char *) &fh, sizeof (fh));
+  if (!sh.empty ()) os.write ((const char *) &sh[0], sh.size () * sizeof (FootprintSectionHeader));
+  os.write (task.data (), task.size ());
+  uint64_t padding = align8 (fh.task_offset + fh.task_length) - (fh.task_offset + fh.task_length);
+  static const char zeros[8] = { 0 };
+  os.write (zeros, padding);
+  for (size_t i = 0; i < sections.size (); i++)
+    {
+      const FootprintSection & s = sections[i];
+      if (s.nbsets != 0)
+	{
+	  os.write ((const char *) &s.hb[0], s.nbsets * sizeof (uint64_t));
+	  os.write ((const char *) &s.cb[0], s.nbsets * sizeof (uint64_t));
+	}
+      if (!s.hbBlocks.empty ()) os.write ((const char *) &s.hbBlocks[0], s.hbBlocks.size () * sizeof (uint64_t));
+      if (!s.cbBlocks.empty ()) os.write ((const char *) &s.cbBlocks[0], s.cbBlocks.size () * sizeof (uint64_t));
+    }
+  os.close ();
+  return !os.fail ();
+}
+
+// ---------------------------------------------------
+// Reading
+// ---------------------------------------------------
+
+/** @return true when count elements of elem_size bytes at offset are within a file of size bytes.
+    Written without computing offset + count * elem_size, which may overflow on a corrupted file. */
+static bool
+inFile (uint64_t offset, uint64_t count, uint64_t elem_size, size_t size)
+{
+  return offset <= size && count <= (size - offset) / elem_size;
+}
+
+bool
+FootprintFile::open (const string & file_name, string & error)
+{
+  close ();
+  int fd = ::open (file_name.c_str (), O_RDONLY);
+  if (fd < 0)
+    {
+      error = "unable to open " + file_name;
+      return false;
+    }
+  struct stat st;
+  if (fstat (fd, &st) != 0 || (size_t) st.st_size < sizeof (FootprintFileHeader))
+    {
+      ::close (fd);
+      error = file_name + " is not a footprint file (too small)";
+      return false;
+    }
+  void *m = mmap (NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close (fd);
+  if (m == MAP_FAILED)
+    {
+      error = "unable to map " + file_name;
+      return false;
+    }
+  base = (const char *) m;
+  size = st.st_size;
+
+  // Header and bounds checks, so that the accessors can use the arrays in place.
+  const FootprintFileHeader & fh = header ();
+  bool ok = memcmp (fh.magic, FOOTPRINT_MAGIC, sizeof (fh.magic)) == 0;
+  if (!ok) error = file_name + " is not a footprint file (bad magic)";
+  if (ok && fh.version != FOOTPRINT_VERSION)
+    {
+      ok = false;
+      error = file_name + ": unsupported footprint version";
+    }
+  if (ok && (!inFile (sizeof (FootprintFileHeader), fh.nb_sections, sizeof (FootprintSectionHeader), size)
+	     || !inFile (fh.task_offset, fh.task_length, 1, size)))
+    {
+      ok = false;
+      error = file_name + ": truncated footprint file";
+    }
+  for (uint32_t i = 0; ok && i < fh.nb_sections; i++)
+    {
+      const FootprintSectionHeader & s = getSection (i);
+      if ((s.hb_offset % 8) != 0 || (s.cb_offset % 8) != 0 || (s.hb_blocks_offset % 8) != 0 || (s.cb_blocks_offset % 8) != 0
+	  || !inFile (s.hb_offset, s.nbsets, sizeof (uint64_t), size) || !inFile (s.cb_offset, s.nbsets, sizeof (uint64_t), size)
+	  || !inFile (s.hb_blocks_offset, s.hb_blocks_count, sizeof (uint64_t), size)
+	  || !inFile (s.cb_blocks_offset, s.cb_blocks_count, sizeof (uint64_t), size))
+	{
+	  ok = false;
+	  error = file_name + ": corrupted footprint section";
+	}
+    }
+  if (!ok) close ();
+  return ok;
+}
+
+void
+FootprintFile::close ()
+{
+  if (base != NULL) munmap ((void *) base, size);
+  base = NULL;
+  size = 0;
+}
+
+const FootprintFileHeader &
+FootprintFile::header () const
+{
+  assert (base != NULL);
+  return *(const FootprintFileHeader *) base;
+}
+
+const uint64_t *
+FootprintFile::array (uint64_t offset) const
+{
+  return (const uint64_t *) (base + offset);
+}
+
+string
+FootprintFile::getTask () const
+{
+  return string (base + header ().task_offset, header ().task_length);
+}
+
+uint32_t
+FootprintFile::getNbSections () const
+{
+  return header ().nb_sections;
+}
+
+const FootprintSectionHeader &
+FootprintFile::getSection (uint32_t i) const
+{
+  assert (i < header ().nb_sections);
+  return ((const FootprintSectionHeader *) (base + sizeof (FootprintFileHeader)))[i];
+}
+
+int
+FootprintFile::findSection (uint32_t level, uint32_t kind) const
+{
+  for (uint32_t i = 0; i < getNbSections (); i++)
+    if (getSection (i).level == level && getSection (i).kind == kind) return i;
+  return -1;
+}
+
+const uint64_t *
+FootprintFile::getHB (uint32_t i) const
+{
+  return array (getSection (i).hb_offset);
+}
+
+const uint64_t *
+FootprintFile::getCB (uint32_t i) const
+{
+  return array (getSection (i).cb_offset);
+}
+
+const uint64_t *
+FootprintFile::getHBBlocks (uint32_t i) const
+{
+  return array (getSection (i).hb_blocks_offset);
+}
+
+const uint64_t *
+FootprintFile::getCBBlocks (uint32_t i) const
+{
+  return array (getSection (i).cb_blocks_offset);
+}
+
+// ---------------------------------------------------
+// Branch-free loop over the sets, so that the compiler
+// can vectorise it.
+// ---------------------------------------------------
+uint64_t
+FootprintFile::evictions (const uint64_t * hb, const uint64_t * cb, uint32_t nbsets, uint32_t nbways)
+{
+  uint64_t sum = 0;
+  for (uint32_t s = 0; s < nbsets; s++)
+    {
+      uint64_t m = hb[s] < cb[s] ? hb[s] : cb[s];
+      sum += (hb[s] + cb[s] > nbways) ? m : 0;
+    }
+  return sum;
+}
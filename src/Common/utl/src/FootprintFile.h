@@ -0,0 +1,144 @@
+/* ---------------------------------------------------------------------
+
+   Copyright IRISA, 2003-2017
+
+   This file is part of Heptane, a tool for Worst-Case Execution Time (WCET) estimation.
+   APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+   Heptane is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Heptane is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details (COPYING.txt).
+
+   See CREDITS.txt for credits of authorship
+
+   ------------------------------------------------------------------------ */
+
+/*********************************************
+
+ Binary cache footprint of a task, written by the INTERFERENCE analysis
+ of HeptaneAnalysis and read by HeptaneInterfere.
+
+ A footprint file contains one section per (cache level, code/data) pair.
+ Each section holds, for a cache of nbsets sets:
+ - hb[nbsets]: number of hit blocks (CHMC AH/FM) mapped to every set,
+ - cb[nbsets]: number of conflicting blocks (CAC A/U/UN) mapped to every set,
+ - the sorted addresses of the distinct hit and conflicting cache blocks.
+ The counts are weighted by the loop bounds. When both sections of a level
+ have the FOOTPRINT_UNIFIED flag (unified cache in the configuration), the
+ unified footprint of the level is the sum of its code and data sections.
+
+ Layout (host endianness, all offsets in bytes from the beginning of the
+ file and aligned on 8 bytes):
+   FootprintFileHeader
+   FootprintSectionHeader[nb_sections]
+   task name (task_length chars)
+   per section: hb, cb, hb blocks, cb blocks (uint64_t arrays)
+
+ The file is read through mmap, the arrays are used in place.
+
+*********************************************/
+
+#ifndef FOOTPRINT_FILE_H
+#define FOOTPRINT_FILE_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+#define FOOTPRINT_MAGIC "HEPTFOOT"
+#define FOOTPRINT_VERSION 1
+
+/** Kind of the cache accesses described by a section */
+typedef enum
+{ FOOTPRINT_CODE = 0, FOOTPRINT_DATA = 1 } t_footprint_kind;
+
+/** Flags of a section: the cache is a side of a unified cache */
+#define FOOTPRINT_UNIFIED 1
+
+/** File header, as stored on disk */
+struct FootprintFileHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t nb_sections;
+  uint64_t task_offset;
+  uint64_t task_length;
+};
+
+/** Section descriptor, as stored on disk */
+struct FootprintSectionHeader
+{
+  uint32_t level;
+  uint32_t kind;
+  uint32_t nbsets;
+  uint32_t nbways;
+  uint32_t cachelinesize;
+  uint32_t flags;
+  uint64_t hb_offset;
+  uint64_t cb_offset;
+  uint64_t hb_blocks_offset;
+  uint64_t hb_blocks_count;
+  uint64_t cb_blocks_offset;
+  uint64_t cb_blocks_count;
+};
+
+/** Section contents, as built before writing a footprint file */
+class FootprintSection
+{
+public:
+  uint32_t level, kind, nbsets, nbways, cachelinesize, flags;
+  vector < uint64_t > hb, cb;
+  vector < uint64_t > hbBlocks, cbBlocks;
+};
+
+/** Footprint file, written at once and read through mmap */
+class FootprintFile
+{
+public:
+  FootprintFile ();
+  ~FootprintFile ();
+
+  /** Writes the footprint of task to file_name. @return false on I/O error. */
+  static bool write (const string & file_name, const string & task, const vector < FootprintSection > &sections);
+
+  /** Maps file_name in memory and checks its header and bounds.
+      @return false (with an explanation in error) when the file cannot be used. */
+  bool open (const string & file_name, string & error);
+
+  /** Unmaps the file */
+  void close ();
+
+  string getTask () const;
+  uint32_t getNbSections () const;
+  const FootprintSectionHeader & getSection (uint32_t i) const;
+
+  /** @return the index of the section of the given level and kind, -1 when absent. */
+  int findSection (uint32_t level, uint32_t kind) const;
+
+  /** Per-set arrays and block lists of section i (pointers into the mapped file) */
+  const uint64_t *getHB (uint32_t i) const;
+  const uint64_t *getCB (uint32_t i) const;
+  const uint64_t *getHBBlocks (uint32_t i) const;
+  const uint64_t *getCBBlocks (uint32_t i) const;
+
+  /** Number of blocks of a task with hit blocks hb that may be evicted by a task with conflicting blocks cb:
+      sum over the sets of min(hb[s], cb[s]) when hb[s] + cb[s] > nbways. */
+  static uint64_t evictions (const uint64_t * hb, const uint64_t * cb, uint32_t nbsets, uint32_t nbways);
+
+private:
+  const char *base;
+  size_t size;
+
+  const FootprintFileHeader & header () const;
+  const uint64_t *array (uint64_t offset) const;
+};
+
+#endif
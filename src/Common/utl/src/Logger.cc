@@ -25,15 +25,57 @@
 //singleton declaration
 Logger * Logger::instance = NULL;
 
+thread_local Logger * Logger::bound = NULL;
+
 Logger::Logger ()
 {
   error_state = false;
   TRACE_MODE = true;
+  out = &cout;
+  err = &cerr;
+  throw_fatal = false;
 }
 
 Logger::~Logger ()
 { }
 
+Logger *
+Logger::current ()
+{
+  if (bound) return bound;
+  if (!instance)
+    {
+      instance = new Logger ();
+    }
+  return instance;
+}
+
+Logger *
+Logger::create (ostream & o, ostream & e, bool t)
+{
+  Logger *l = new Logger ();
+  l->TRACE_MODE = current ()->TRACE_MODE;	// trace option of the calling thread
+  l->out = &o;
+  l->err = &e;
+  l->throw_fatal = t;
+  return l;
+}
+
+void
+Logger::destroy (Logger * l)
+{
+  if (bound == l) bound = NULL;
+  delete l;
+}
+
+Logger *
+Logger::bind (Logger * l)
+{
+  Logger *previous = bound;
+  bound = l;
+  return previous;
+}
+
 void
 Logger::kill ()
 {
@@ -47,94 +89,94 @@ Logger::kill ()
 void
 Logger::clean ()
 {
-  if (instance)
-    {
-      instance->error_state = false, instance->infos.clear ();
-      instance->warnings.clear ();
-      instance->errors.clear ();
-    }
+  Logger *l = current ();
+  lock_guard < mutex > guard (l->lock);
+  l->error_state = false, l->infos.clear ();
+  l->warnings.clear ();
+  l->errors.clear ();
 }
 
 bool Logger::getErrorState ()
 {
-  if (!instance)
-    {
-      return false;
-    }
-  return instance->error_state;
+  return current ()->error_state;
 }
 
 bool Logger::isDebugMode ()
 {
-  if (!instance) instance = new Logger ();
-  return instance->TRACE_MODE;
+  return current ()->TRACE_MODE;
 }
 
 void
 Logger::addError (const string & s)
 {
-  if (!instance)
-    {
-      instance = new Logger ();
-    }
-  instance->error_state = true;
-  instance->errors.push_back (s);
+  Logger *l = current ();
+  lock_guard < mutex > guard (l->lock);
+  l->error_state = true;
+  l->errors.push_back (s);
 }
 
 void
 Logger::addWarning (const string & s)
 {
-  if (!instance)
-    {
-      instance = new Logger ();
-    }
-  instance->warnings.push_back (s);
+  Logger *l = current ();
+  lock_guard < mutex > guard (l->lock);
+  l->warnings.push_back (s);
 }
 
 void
 Logger::addInfo (const string & s)
 {
-  if (!instance)
-    {
-      instance = new Logger ();
-    }
-  instance->infos.push_back (s);
+  Logger *l = current ();
+  lock_guard < mutex > guard (l->lock);
+  l->infos.push_back (s);
 }
 
 void
 Logger::addFatal (const string & s)
 {
-  if (instance)
-    {
-      instance->print ();
-    }
-  cerr << "[FATAL]\t" << s << endl;
+  Logger *l = current ();
+  {
+    lock_guard < mutex > guard (l->lock);
+    l->flush ();
+    if (l->throw_fatal) throw s;	// printed by the catcher
+    *l->err << "[FATAL]\t" << s << endl;
+  }
   exit (-1);
 }
 
 void
-Logger::print ()
+Logger::flush ()
 {
-  if (instance && isDebugMode ())
+  if (TRACE_MODE)
     {
-      for (size_t i = 0; i < instance->infos.size (); i++)
-	cout << "[INFO]\t" << instance->infos[i] << endl;
-      for (size_t i = 0; i < instance->warnings.size (); i++)
-	cerr << "[WARNING]\t" << instance->warnings[i] << endl;
-      for (size_t i = 0; i < instance->errors.size (); i++)
-	cerr << "[ERROR]\t" << instance->errors[i] << endl;
-      instance->infos.clear(); 
-      instance->warnings.clear();
-      instance->errors.clear();
+      for (size_t i = 0; i < infos.size (); i++)
+	*out << "[INFO]\t" << infos[i] << endl;
+      for (size_t i = 0; i < warnings.size (); i++)
+	*err << "[WARNING]\t" << warnings[i] << endl;
+      for (size_t i = 0; i < errors.size (); i++)
+	*err << "[ERROR]\t" << errors[i] << endl;
+      infos.clear(); 
+      warnings.clear();
+      errors.clear();
     }
 }
 
+void
+Logger::print ()
+{
+  Logger *l = current ();
+  lock_guard < mutex > guard (l->lock);
+  l->flush ();
+}
+
 void
 Logger::printDebug (const string & mess)
 {
-  if (isDebugMode ())
+  Logger *l = current ();
+  if (l->TRACE_MODE)
     {
-      cout << mess << endl;
+      lock_guard < mutex > guard (l->lock);
+      *l->out << mess << endl;
     }
 }
 
@@ -142,19 +184,24 @@ Logger::printDebug (const string & mess)
 void
 Logger::printVersion()
 {
-  if (isDebugMode ())
-    cout << "Heptane Analysis, version " << HEPTANE_VERSION << endl;
+  Logger *l = current ();
+  if (l->TRACE_MODE)
+    {
+      lock_guard < mutex > guard (l->lock);
+      *l->out << "Heptane Analysis, version " << HEPTANE_VERSION << endl;
+    }
 }
 
 void
 Logger::print (const string & mess)
 {
-  cout << mess << endl;
+  Logger *l = current ();
+  lock_guard < mutex > guard (l->lock);
+  *l->out << mess << endl;
 }
 
 
 void Logger::setOptionTrace(bool b)
 {
- if (!instance) instance = new Logger ();
-  instance->TRACE_MODE = b;
+  current ()->TRACE_MODE = b;
 }
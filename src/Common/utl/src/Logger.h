@@ -38,6 +38,13 @@ See CREDITS.txt for credits of authorship
     Logger::addWarning("mesg");
     Logger::addError("mesg");
     Logger::addFatal("mesg");
+
+ Several analyses may run concurrently in the same process (see
+ AnalysisSession): each one creates its own logger (create) and binds
+ it to its threads (bind). The static functions then use the logger
+ bound to the calling thread, the singleton when there is none.
+ Such a logger may throw the fatal message (as a string) instead of
+ stopping the program execution.
  
 *********************************************/
 
@@ -54,6 +61,7 @@ See CREDITS.txt for credits of authorship
 #include <string>
 #include <iostream>
 #include <stdlib.h>
+#include <mutex>
 
 using namespace std;
 
@@ -61,6 +69,8 @@ class Logger
 {
 private:
   static Logger *instance;
+  /** logger bound to the calling thread, NULL for the singleton */
+  static thread_local Logger *bound;
   Logger ();
   ~Logger ();
   bool error_state;
@@ -68,7 +78,24 @@ private:
   vector < string > infos;
   vector < string > warnings;
   vector < string > errors;
+  /** sinks of the info messages (out) and of the other ones (err) */
+  ostream *out, *err;
+  /** addFatal throws the message instead of exiting */
+  bool throw_fatal;
+  /** the logger may be shared by the threads of an analysis */
+  mutex lock;
+  /** logger of the calling thread (the singleton is created if needed) */
+  static Logger *current ();
+  /** print the stored messages, lock held */
+  void flush ();
  public:
+  /** create a logger, not bound to any thread, with the trace option of the calling thread */
+  static Logger *create (ostream & out, ostream & err, bool throw_fatal);
+  /** delete a logger created by create */
+  static void destroy (Logger * l);
+  /** bind l to the calling thread (NULL: back to the singleton).
+      @return the logger previously bound */
+  static Logger *bind (Logger * l);
   /** delete the singleton */
   static void kill ();
   /** remove all messages and set error_state to false */
@@ -79,7 +106,8 @@ private:
   static void addWarning (const string &);
   /** add an error message and set the error_state to true */
   static void addError (const string &);
-  /** print all stored messages, the fatal message and stop the program execution */
+  /** print all stored messages, the fatal message and stop the program execution
+      (print the stored messages and throw the fatal one for a logger created with throw_fatal) */
   static void addFatal (const string &);
   /** print all the warnings and errors */
   static void print ();
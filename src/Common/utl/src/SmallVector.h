@@ -0,0 +1,111 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+
+/*********************************************
+
+ Vector which keeps up to N elements in place, without allocation,
+ and moves them to the heap beyond N. Used for the small lists
+ attached to each instruction (e.g. the address ranges of an
+ AddressInfo, almost always a single one).
+
+ T must be default constructible and copyable.
+
+*********************************************/
+
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include <vector>
+#include <algorithm>
+#include <stddef.h>
+
+template < typename T, unsigned int N > class SmallVector
+{
+ private:
+  T local[N];			// the elements while there are at most N
+  std::vector < T > heap;	// all the elements when there are more than N
+  size_t nb;
+
+ public:
+  SmallVector ():nb (0) { }
+
+  size_t size () const
+  {
+    return nb;
+  }
+
+  bool empty () const
+  {
+    return nb == 0;
+  }
+
+  const T *begin () const
+  {
+    return nb <= N ? local : &heap[0];
+  }
+
+  const T *end () const
+  {
+    return begin () + nb;
+  }
+
+  const T & operator[] (size_t i) const
+  {
+    return begin ()[i];
+  }
+
+  T & operator[] (size_t i)
+  {
+    return nb <= N ? local[i] : heap[i];
+  }
+
+  void push_back (const T & value)
+  {
+    if (nb < N)
+      local[nb] = value;
+    else
+      {
+	if (nb == N)
+	  heap.assign (local, local + N);
+	heap.push_back (value);
+      }
+    nb++;
+  }
+
+  void clear ()
+  {
+    heap.clear ();
+    nb = 0;
+  }
+
+  bool operator== (const SmallVector & v) const
+  {
+    return nb == v.nb && std::equal (begin (), end (), v.begin ());
+  }
+
+  bool operator!= (const SmallVector & v) const
+  {
+    return !(*this == v);
+  }
+};
+
+#endif
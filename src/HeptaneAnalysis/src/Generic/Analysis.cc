@@ -26,15 +26,30 @@ See CREDITS.txt for credits of authorship
 #include "Generic/CallGraph.h"
 #include "Specific/HtmlPrint/HtmlPrint.h"
 #include "Generic/Timer.h"
+#include "Generic/AnalysisSession.h"
+
+Analysis::Analysis (Program * pp)
+{
+  p = pp;
+  name = "Undefined";
+  time = 0.0;
+  session = AnalysisSession::current ();
+  assert (session != NULL);
+}
 
 Analysis::~Analysis ()
 { }
 
+Config *Analysis::getConfig ()
+{
+  return session->getConfig ();
+}
+
 bool Analysis::CheckPerformCleanup (bool printTime )
 {
   Timer timer_Analysis;
-  float time = 0.0;
 
+  time = 0.0;
   timer_Analysis.initTimer();
   if ( ! CheckInputAttributes () ) 
     { 
@@ -47,9 +62,9 @@ bool Analysis::CheckPerformCleanup (bool printTime )
     }
   RemovePrivateAttributes ();
 
+  timer_Analysis.addTimer(time);
   if (printTime)
     {
-      timer_Analysis.addTimer(time);
       stringstream infostr;
       infostr << "********HH " + name + ": "  << time;
       Logger::addInfo(infostr.str());
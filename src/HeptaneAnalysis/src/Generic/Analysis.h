@@ -45,6 +45,8 @@ See CREDITS.txt for credits of authorship
 using namespace std;
 using namespace cfglib;
 
+class AnalysisSession;
+class Config;
 
 /**
  * Common interface of every analysis step
@@ -67,15 +69,15 @@ protected:
   /** Program on which the analysis is applied */
   Program * p;
   string name;
+  /** Duration of the last CheckPerformCleanup, in seconds */
+  float time;
+  /** Session the analysis is applied in (configuration, architecture, logger) */
+  AnalysisSession *session;
 
 public:
 
-  /** Constructor */
-  Analysis (Program * pp)
-  {
-    p = pp;
-    name = "Undefined";
-  };
+  /** Constructor: the analysis belongs to the session bound to the calling thread */
+  Analysis (Program * pp);
 
   /** Destructor */
   virtual ~ Analysis ();
@@ -106,6 +108,10 @@ public:
   bool CheckPerformCleanup (bool printTime);
   void setName(string v)  { name = v;};
   string getName()  { return name;}
+  float getTime()  { return time;}
+  AnalysisSession *getSession()  { return session;}
+  /** Configuration of the session */
+  Config *getConfig();
 };
 
 #endif
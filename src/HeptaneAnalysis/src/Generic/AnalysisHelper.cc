@@ -79,7 +79,7 @@ bool AnalysisHelper::applyToAllNodesRecursive(Program * p, t_node_function f, vo
   NonSerialisableIntegerAttribute visited(1);
   ncalls = ntrue = 0;
 
-  Cfg *c = config->getEntryPoint();
+  Cfg *c = p->GetEntryPoint();
   assert(c != NULL);
   assert(!(c->IsEmpty()));
   Node *n = c->GetStartNode();
@@ -157,7 +157,7 @@ t_address AnalysisHelper::getStartAddress(Node * n)
   vector < Instruction * >vi = n->GetAsm();
   assert(vi.size() != 0);
   assert(vi[0]->HasAttribute(AddressAttributeName));
-  AddressAttribute attr = (AddressAttribute &) vi[0]->GetAttribute(AddressAttributeName);
+  const AddressAttribute & attr = (AddressAttribute &) vi[0]->GetAttribute(AddressAttributeName);
   return (attr.getCodeAddress());
 }
 
@@ -171,15 +171,15 @@ t_address AnalysisHelper::getStartAddress(Node * n)
 // and the next node in the same cfg has the call_next_number
 //
 //-----------------------------------------------
-bool AnalysisHelper::computeContext(Program * p)
+bool AnalysisHelper::computeContext(Program * p, int max_cache_level)
 {
-  resetContext(p);
+  resetContext(p, max_cache_level);
   
   vector < Cfg * >cfgs = p->GetAllCfgs();
 
   // Create the context tree which hold data for all contexts.
   ContextTree contexts = ContextTree();
-  contexts.initialise(config->getEntryPoint());
+  contexts.initialise(p->GetEntryPoint());
 
   // Attach an empty context list to each cfg.
   ContextList l;
@@ -351,6 +351,55 @@ bool AnalysisHelper::CallerInLoop(Context * c)
   return found;
 }
 
+vector < Loop * >AnalysisHelper::getOuterLoops(Cfg * cfg)
+{
+  vector < Loop * >loops = cfg->GetAllLoops();
+  vector < Loop * >loopsOuter;
+
+  for (size_t k = 0; k < loops.size(); k++)
+    {
+      bool found = false;
+      for (size_t j = 0; j < loops.size() && !found; j++)
+	{
+	  if (k != j && loops[k]->IsNestedIn(loops[j]))
+	    {
+	      found = true;
+	    }	//loop k is nested in loop j
+	}
+      if (!found)
+	{
+	  loopsOuter.push_back(loops[k]);
+	}	//loop k is not nested in other loop
+    }
+  return loopsOuter;
+}
+
+void AnalysisHelper::decodeInstructions(Program * p)
+{
+  vector < Cfg * >lc = p->GetAllCfgs();
+  for (size_t c = 0; c < lc.size(); c++)
+    {
+      vector < Node * >vn = lc[c]->GetAllNodes();
+      for (size_t n = 0; n < vn.size(); n++)
+	{
+	  vector < Instruction * >vi = vn[n]->GetAsm();
+	  for (size_t i = 0; i < vi.size(); i++)
+	    {
+	      if (!vi[i]->IsCode()) continue;
+	      DecodedInstructionAttribute attr(Arch::decode(vi[i]->GetCode()));
+	      vi[i]->SetAttribute(DecodedInstructionAttributeName, attr);
+	    }
+	}
+    }
+}
+
+const DecodedInstruction & AnalysisHelper::getDecoded(Instruction * i)
+{
+  static const AttributeKey key(DecodedInstructionAttributeName);
+  if (i->HasAttribute(key)) return *((DecodedInstructionAttribute &) i->GetAttribute(key)).decoded;
+  return *Arch::decode(i->GetCode());
+}
+
 void AnalysisHelper::AttributeAllInstructions(Node * n, string attrName, SerialisableStringAttribute A)
 {
   vector < Instruction * >vi = n->GetAsm();
@@ -371,12 +420,12 @@ bool AnalysisHelper::checkInstructionsAttributed(Node * n, string attrName)
 }
 
 /* Resets the shared attributes of a program (p).*/
-void AnalysisHelper::resetContext(Program * p)
+void AnalysisHelper::resetContext(Program * p, int max_cache_level)
 {
   Cfg * vcfg;
   if ( p->HasAttribute(ContextTreeAttributeName))
     {
-      removeContextualAttributes(p);
+      removeContextualAttributes(p, max_cache_level);
       p->RemoveAttribute(ContextTreeAttributeName);
       vector < Cfg * >cfgs = p->GetAllCfgs();
       for (size_t c = 0; c < cfgs.size(); ++c)
@@ -477,7 +526,7 @@ void AnalysisHelper::removeContextualInstructionsAttribute (Program * p, string
 }
 
 /* Remove the contextual attributes assigned to a program(p). */
-void AnalysisHelper::removeContextualAttributes(Program * p)
+void AnalysisHelper::removeContextualAttributes(Program * p, int levelmax)
 {
   // AddressAnalysis: from GlobalAttributes.h
   removeContextualInstructionsAttribute(p, string(AddressAttributeName) ); 
@@ -499,7 +548,6 @@ void AnalysisHelper::removeContextualAttributes(Program * p)
 
   // DCacheAnalysis, ICacheAnalysis
   removeContextualInstructionsAttribute(p, CACAttributeNameData(1));
-  int levelmax =config->getMaxLevelCacheAnalysis();
   for (int level = 1; level <= levelmax; level++)
     {
       removeContextualInstructionsAttribute(p, CHMCAttributeNameData(level) );
@@ -679,10 +727,10 @@ void  AnalysisHelper::insertContextualSuccessors(ContextualNode & vContNode, set
   @return the initial contextual node of the program.
   (ie first context of the entry point of the program, the start node of the entry point)
 */
-set < ContextualNode >  AnalysisHelper::initWork( )
+set < ContextualNode >  AnalysisHelper::initWork(Program * p)
 {
   set < ContextualNode > work;
-  Cfg *entry_point = config->getEntryPoint();
+  Cfg *entry_point = p->GetEntryPoint();
   Node *start_node = entry_point->GetStartNode();
   Context *root_context = ((const ContextList &)entry_point->GetAttribute(ContextListAttributeName))[0];
   ContextualNode entry_node(root_context, start_node);
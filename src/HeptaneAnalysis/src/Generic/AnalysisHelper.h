@@ -83,14 +83,23 @@ class AnalysisHelper
   /** Check program for WCET analyzability (no recursion, bounded loops, etc, see exact list in Analysis.cc) */
   static void ProgramCheck (Program * p);
 
+  /** Attaches the decoded form of their asm code (DecodedInstructionAttribute) to all the
+      code instructions of p. Called when the program is loaded, before any analysis. */
+  static void decodeInstructions (Program * p);
+
+  /** Returns the decoded form of the asm code of instruction i (decoded here if not attached).
+      To be preferred to the Arch functions on i->GetCode () (isLoad, getLatency, ...) */
+  static const DecodedInstruction & getDecoded (Instruction * i);
+
 
   /** Compute context for each cfg like main#1#foo for the foo function
       called in main by the first call node.      
       The caller node has the call_number and the next node in the same cfg has the call_next_number.
 
-      It first resets the shared attributes by calling resetContext(), required for the entry-points management.
+      It first resets the shared attributes by calling resetContext(), required for the entry-points management
+      (max_cache_level: highest level of the cache analyses applied so far, see Config::getMaxLevelCacheAnalysis).
   */
-  static bool computeContext (Program * p);
+  static bool computeContext (Program * p, int max_cache_level);
 
   /** Returns the start address of a basic block */
   static t_address getStartAddress (Node * n);
@@ -121,6 +130,9 @@ class AnalysisHelper
   /** return "true" if at least one caller of context c is in a loop, "false" otherwise */
   static bool CallerInLoop(Context * c);
 
+  /** @return the outer loops of a cfg (loops not nested in an other loop) */
+  static vector < Loop * >getOuterLoops(Cfg * cfg);
+
   /** The attribute named attrName is assigned to all the instructions of a node (n) with the value A.*/
   static void AttributeAllInstructions(Node * n, string attrName, SerialisableStringAttribute A);
 
@@ -176,7 +188,7 @@ class AnalysisHelper
 
   /**  @retnru the initial contextual node of the program.
        (ie first context of the entry point of the program, the start node of the entry point) */
- static set < ContextualNode > initWork( );
+ static set < ContextualNode > initWork(Program * p);
   
   /** Debugging: it prints the code of the instructions of a set of contextual nodes (work). */
  static void printSet(set < ContextualNode > &work, string vcaller);
@@ -189,7 +201,7 @@ class AnalysisHelper
   /** Resets the shared attributes of a program (p): the contextual ones (removeContextualAttributes()) 
       and the no-contextual ones (StackInfoAttributeName, ContextListAttributeName, WCETAttributeName).
   */
-  static void resetContext(Program * p);
+  static void resetContext(Program * p, int max_cache_level);
   
   /** Resets the contextual shared attribute (atrName) assigned to the edges of a program (p).*/
   static void removeContextualEdgesAttribute (Program * p, string attrName);
@@ -200,8 +212,8 @@ class AnalysisHelper
   /** Resets the contextual shared attribute (atrName) assigned to the instructions of a program (p).*/
   static void removeContextualInstructionsAttribute (Program * p, string attrName);
 
-  /** Removes the contextual attributes assigned to a program(p) */
-  static void removeContextualAttributes(Program * p);
+  /** Removes the contextual attributes assigned to a program(p), for the cache levels 1..levelmax */
+  static void removeContextualAttributes(Program * p, int levelmax);
 
   /** Removes the context management for FrequencyAttributeName (currently not managed as the other contextual attributes). */
   static void removeFrequencyAttribute(Program * p);
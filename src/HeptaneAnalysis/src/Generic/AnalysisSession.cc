@@ -0,0 +1,127 @@
+/* ---------------------------------------------------------------------
+
+   Copyright IRISA, 2003-2017
+
+   This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+   estimation.
+   APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+   Heptane is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Heptane is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details (COPYING.txt).
+
+   See CREDITS.txt for credits of authorship
+
+   ------------------------------------------------------------------------ */
+
+#include <cassert>
+
+#include "Generic/AnalysisSession.h"
+#include "Generic/Config.h"
+#include "SharedAttributes/SharedAttributes.h"
+#include "Specific/InterferenceAnalysis/InterferenceAnalysis.h"
+#include "Specific/CacheAnalysis/FlatCache.h"
+
+/** Session bound to the calling thread */
+static thread_local AnalysisSession *bound_session = NULL;
+
+AnalysisSession::AnalysisSession (ostream & out, ostream & err):architecture (NULL), err_stream (&err), bb_counter (0)
+{
+  logger = Logger::create (out, err, true);
+  factory = AttributesFactory::Create ();
+  registerAttributeTypes (factory);
+  footprints = new vector < CacheFootprint >;
+  Binding binding (this);	// the configuration may log messages
+  config = new Config ();
+}
+
+AnalysisSession::~AnalysisSession ()
+{
+  {
+    // The program is deleted with the objects of the session
+    Binding binding (this);
+    delete config;
+    for (map < pair < unsigned int, unsigned int >, CacheBlockIndex * >::iterator it = block_indexes.begin (); it != block_indexes.end (); it++)
+      delete it->second;
+    delete footprints;
+    if (architecture != NULL) delete architecture;
+  }
+  AttributesFactory::Destroy (factory);
+  Logger::destroy (logger);
+}
+
+bool
+AnalysisSession::run (string configFile, bool printTime)
+{
+  Binding binding (this);
+  error = "";
+  try
+    {
+      Logger::printVersion ();
+      Logger::printDebug ("Reading configuration file");
+      config->FillArchitectureFromXml (configFile);
+      Logger::printDebug ("Executing from configuration file");
+      config->ExecuteFromXml (configFile, printTime);
+    }
+  catch (string const &e)
+    {
+      // Nothing of the failed run is to be recorded by the next run on this thread
+      if (AttributeLayer * layer = AttributeLayer::Current ()) layer->Discard ();
+      error = e;
+      *err_stream << "[FATAL]\t" << e << endl;
+      return false;
+    }
+  return true;
+}
+
+CacheBlockIndex *
+AnalysisSession::getCacheBlockIndex (unsigned int nbsets, unsigned int cachelinesize)
+{
+  lock_guard < mutex > guard (block_indexes_lock);
+  CacheBlockIndex * &index = block_indexes[make_pair (nbsets, cachelinesize)];
+  if (index == NULL) { index = new CacheBlockIndex (nbsets, cachelinesize); }
+  return index;
+}
+
+AnalysisSession *
+AnalysisSession::current ()
+{
+  return bound_session;
+}
+
+void
+AnalysisSession::registerAttributeTypes (AttributesFactory * af)
+{
+  af->SetAttributeType (AddressAttributeName, new AddressAttribute ());
+  af->SetAttributeType (SymbolTableAttributeName, new SymbolTableAttribute ());
+  af->SetAttributeType (ARMWordsAttributeName, new ARMWordsAttribute ());
+  af->SetAttributeType (StackInfoAttributeName, new StackInfoAttribute ());
+  af->SetAttributeType (CodeLineAttributeName, new CodeLineAttribute ());
+  af->SetAttributeType (ContextListAttributeName, new ContextList ());
+  af->SetAttributeType (ContextTreeAttributeName, new ContextTree ());
+  af->SetAttributeType (MetaInstructionAttributeName, new MetaInstructionAttribute ());
+}
+
+AnalysisSession::Binding::Binding (AnalysisSession * s)
+{
+  assert (s != NULL);
+  previous = bound_session;
+  bound_session = s;
+  previous_logger = Logger::bind (s->logger);
+  previous_architecture = Arch::bind (&s->architecture);
+  previous_factory = AttributesFactory::Bind (s->factory);
+}
+
+AnalysisSession::Binding::~Binding ()
+{
+  AttributesFactory::Bind (previous_factory);
+  Arch::bind (previous_architecture);
+  Logger::bind (previous_logger);
+  bound_session = previous;
+}
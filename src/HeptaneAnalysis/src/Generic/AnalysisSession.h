@@ -0,0 +1,149 @@
+/* ---------------------------------------------------------------------
+
+   Copyright IRISA, 2003-2017
+
+   This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+   estimation.
+   APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+   Heptane is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Heptane is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details (COPYING.txt).
+
+   See CREDITS.txt for credits of authorship
+
+   ------------------------------------------------------------------------ */
+
+/**
+ * \brief Analysis session: the objects shared by the analysis steps applied
+ * to a program (configuration, architecture tables, logger, attribute factory,
+ * and the state kept by the analyses from one step to the next).
+ *
+ * Every Analysis is attached to the session it is created in
+ * (Analysis::getSession), and the configuration is reached through it.
+ * The architecture tables, the logger and the attribute factory are used
+ * through the static functions of Arch, Logger and AttributesFactory by
+ * the whole code: these functions use the objects of the session bound to
+ * the calling thread (AnalysisSession::Binding), so that several sessions
+ * can run concurrently on separate threads of the same process. The worker
+ * threads of a ThreadPool are bound to the session of the thread which
+ * created the pool.
+ *
+ * A fatal error (Logger::addFatal) of a session only stops its run, which
+ * returns false.
+ *
+ * Still shared by all the sessions: the interned attribute names (AttributeKey,
+ * protected by a lock), the current directory and the messages printed
+ * directly on cout/cerr by the analyses (only the Logger messages go to the
+ * streams of the session).
+ */
+#ifndef ANALYSIS_SESSION_H
+#define ANALYSIS_SESSION_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <iostream>
+
+#include "CfgLib.h"
+#include "Logger.h"
+#include "arch.h"
+
+using namespace std;
+using namespace cfglib;
+
+class Config;
+class CacheFootprint;
+class CacheBlockIndex;
+
+/**
+ * \class AnalysisSession
+ */
+class AnalysisSession
+{
+public:
+  /** Constructor: default configuration, no architecture yet (see Config::FillArchitectureFromXml),
+      the Logger messages being printed on out (infos) and err (warnings, errors). */
+  AnalysisSession (ostream & out = cout, ostream & err = cerr);
+
+  /** Destructor: deletes the configuration, the program and the objects of the session. */
+  ~AnalysisSession ();
+
+  /** Reads the architecture then applies the analyses of a configuration file, on the calling thread.
+      @return false if a fatal error stopped the analyses (see getError) */
+  bool run (string configFile, bool printTime);
+
+  /** Message of the fatal error which stopped run, "" if none */
+  string getError () const
+  {
+    return error;
+  }
+
+  Config *getConfig ()
+  {
+    return config;
+  }
+
+  /** Tasks analysed so far in the session by the INTERFERENCE steps, in analysis order */
+  vector < CacheFootprint > &getFootprints ()
+  {
+    return *footprints;
+  }
+
+  /** Next basic block number of the IPET steps (the numbers are unique for the whole session) */
+  int &getBasicBlockCounter ()
+  {
+    return bb_counter;
+  }
+
+  /** Block index shared by the flat abstract caches of a given geometry (see FlatCache.h) */
+  CacheBlockIndex *getCacheBlockIndex (unsigned int nbsets, unsigned int cachelinesize);
+
+  /** @return the session bound to the calling thread, NULL if none */
+  static AnalysisSession *current ();
+
+  /** Registers the attribute types of HeptaneAnalysis in af (for their serialisation) */
+  static void registerAttributeTypes (AttributesFactory * af);
+
+  /**
+   * \class Binding
+   * \brief Binds a session to the calling thread, for the lifetime of the Binding
+   * (the previous binding is restored by the destructor).
+   */
+  class Binding
+  {
+  public:
+    Binding (AnalysisSession * s);
+    ~Binding ();
+  private:
+    AnalysisSession *previous;
+    Logger *previous_logger;
+    Arch_dep **previous_architecture;
+    AttributesFactory *previous_factory;
+  };
+
+private:
+  Config *config;
+  Arch_dep *architecture;	///< NULL until the architecture is read (Arch::init)
+  Logger *logger;
+  AttributesFactory *factory;
+  ostream *err_stream;		///< where the fatal errors are printed
+  string error;
+
+  vector < CacheFootprint > *footprints;
+  int bb_counter;
+  map < pair < unsigned int, unsigned int >, CacheBlockIndex * >block_indexes;
+  mutex block_indexes_lock;	///< the abstract caches are built by the worker threads of the cache analyses
+
+  AnalysisSession (const AnalysisSession &);
+  AnalysisSession & operator= (const AnalysisSession &);
+};
+
+#endif
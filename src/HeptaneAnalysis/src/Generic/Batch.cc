@@ -0,0 +1,332 @@
+/* ---------------------------------------------------------------------
+
+   Copyright IRISA, 2003-2017
+
+   This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+   estimation.
+   APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+   Heptane is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Heptane is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details (COPYING.txt).
+
+   See CREDITS.txt for credits of authorship
+
+   ------------------------------------------------------------------------ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <fstream>
+#include <map>
+
+#include "Generic/Batch.h"
+#include "Generic/Config.h"
+#include "Generic/Timer.h"
+#include "Generic/ThreadPool.h"
+#include "Generic/AnalysisSession.h"
+#include "Logger.h"
+#include "XmlExtra.h"
+
+/** Directory of a file name, with its final '/' ("" for a file of the current directory) */
+static string
+directoryOf (const string & file)
+{
+  size_t i = file.rfind ('/');
+  return (i == string::npos) ? string ("") : file.substr (0, i + 1);
+}
+
+/** file, relative to dir when it is a relative path */
+static string
+relativeTo (const string & dir, const string & file)
+{
+  if (file == "" || file[0] == '/') return file;
+  return dir + file;
+}
+
+/** End of a worker process: its results and its log are flushed, then it
+    exits without running the atexit handlers and the destructors of the
+    static objects inherited from the parent */
+static void
+exitWorker (FILE * result, int status)
+{
+  fflush (result);
+  cout.flush ();
+  cerr.flush ();
+  fflush (stdout);
+  _exit (status);
+}
+
+Batch::Batch (string manifest)
+{
+  XmlDocument xmldoc (manifest);
+  XmlTag root = xmldoc.getRootTag ();
+  if (root.getName () != "BATCH") Logger::addFatal ("Batch: the root tag of " + manifest + " should be BATCH");
+  string dir = directoryOf (manifest);
+
+  output_file = relativeTo (dir, root.getAttributeString ("output"));
+  if (output_file == "") Logger::addFatal ("Batch: no output file in " + manifest);
+  int n = root.getAttributeInt ("workers");
+  if (n <= 0) n = sysconf (_SC_NPROCESSORS_ONLN);
+  nbWorkers = (n > 0) ? n : 1;
+  sessions = root.getAttributeString ("sessions") == "on";
+  nbDone = 0;
+
+  ListXmlTag ljobs = root.searchChildren ("JOB");
+  for (size_t i = 0; i < ljobs.size (); i++)
+    {
+      BatchJob job;
+      job.config_file = relativeTo (dir, ljobs[i].getAttributeString ("config"));
+      if (job.config_file == "") Logger::addFatal ("Batch: JOB without config file in " + manifest);
+      job.name = ljobs[i].getAttributeString ("name");
+      if (job.name == "") job.name = job.config_file;
+      job.log_file = relativeTo (dir, ljobs[i].getAttributeString ("log"));
+      if (job.log_file == "")
+	{
+	  job.log_file = job.config_file;
+	  size_t ext = job.log_file.rfind (".xml");
+	  if (ext != string::npos && ext == job.log_file.size () - 4) job.log_file.erase (ext);
+	  job.log_file += ".log";
+	}
+      jobs.push_back (job);
+    }
+}
+
+void
+Batch::runJob (const BatchJob & job, FILE * result)
+{
+  // The log file is opened first, the paths being relative to the current directory
+  if (freopen (job.log_file.c_str (), "w", stdout) == NULL) _exit (2);
+  dup2 (fileno (stdout), fileno (stderr));
+  string dir = directoryOf (job.config_file);
+  if (dir != "" && chdir (dir.c_str ()) != 0)
+    {
+      cerr << "Batch: cannot change to directory " << dir << endl;
+      exitWorker (result, 2);
+    }
+  string file = job.config_file.substr (dir.size ());
+
+  Timer timer;
+  float time = 0.0;
+  timer.initTimer ();
+  AnalysisSession session;
+  Config *config = session.getConfig ();
+  config->shared_logs = false;
+  if (!session.run (file, true)) exitWorker (result, 1);
+  timer.addTimer (time);
+
+  for (size_t i = 0; i < config->pass_times.size (); i++)
+    fprintf (result, "PASS %s %f\n", config->pass_times[i].first.c_str (), config->pass_times[i].second);
+  if (config->wcet != "") fprintf (result, "WCET %s\n", config->wcet.c_str ());
+  fprintf (result, "TIME %f\n", time);
+  exitWorker (result, 0);
+}
+
+void
+Batch::runSession (BatchJob & job)
+{
+  ofstream log (job.log_file.c_str ());
+  if (!log)
+    {
+      job.status = "exit 2";
+      return;
+    }
+
+  Timer timer;
+  float time = 0.0;
+  timer.initTimer ();
+  AnalysisSession session (log, log);
+  Config *config = session.getConfig ();
+  config->shared_logs = false;
+  // The relative paths are resolved as in the worker processes, which run in the directory of the configuration
+  config->config_dir = directoryOf (job.config_file);
+  job.status = session.run (job.config_file, true) ? "ok" : "fatal";
+  timer.addTimer (time);
+
+  job.pass_times = config->pass_times;
+  job.wcet = config->wcet;
+  job.total_time = time;
+}
+
+void
+Batch::reportJob (const BatchJob & job, size_t done)
+{
+  cout << "[" << done << "/" << jobs.size () << "] " << job.name << ": " << job.status;
+  if (job.wcet != "") cout << ", WCET " << job.wcet;
+  cout << " (" << job.total_time << " s)" << endl;
+}
+
+/** Jobs of a batch in sessions mode, one task per job */
+class BatchSessionTask:public ParallelTask
+{
+  Batch & batch;
+public:
+  BatchSessionTask (Batch & b):batch (b)
+  {
+  }
+
+  void execute (size_t i)
+  {
+    BatchJob & job = batch.jobs[i];
+    batch.runSession (job);
+    lock_guard < mutex > guard (batch.lock);
+    batch.reportJob (job, ++batch.nbDone);
+  }
+};
+
+void
+Batch::readResults (BatchJob & job, FILE * result, int exit_status)
+{
+  if (WIFEXITED (exit_status) && WEXITSTATUS (exit_status) == 0) job.status = "ok";
+  else if (WIFEXITED (exit_status)) job.status = "exit " + to_string (WEXITSTATUS (exit_status));
+  else job.status = "signal " + to_string (WTERMSIG (exit_status));
+
+  rewind (result);
+  char key[16], value[1024];
+  while (fscanf (result, "%15s %1023s", key, value) == 2)
+    {
+      string k (key);
+      if (k == "PASS")
+	{
+	  float t = 0.0;
+	  if (fscanf (result, "%f", &t) != 1) break;
+	  job.pass_times.push_back (make_pair (string (value), t));
+	}
+      else if (k == "WCET") job.wcet = value;
+      else if (k == "TIME") job.total_time = atof (value);
+    }
+}
+
+int
+Batch::run ()
+{
+  map < pid_t, size_t > running;	// worker process -> job
+  vector < FILE * > results (jobs.size (), (FILE *) NULL);
+  size_t next = 0, done = 0;
+  int failed = 0;
+
+  if (sessions)
+    {
+      ThreadPool pool (min (nbWorkers, max ((unsigned int) jobs.size (), 1u)));
+      BatchSessionTask task (*this);
+      pool.run (task, jobs.size ());
+      for (size_t i = 0; i < jobs.size (); i++)
+	if (jobs[i].status != "ok") failed++;
+      done = jobs.size ();
+    }
+
+  while (done < jobs.size ())
+    {
+      if (next < jobs.size () && running.size () < nbWorkers)
+	{
+	  results[next] = tmpfile ();
+	  if (results[next] == NULL) Logger::addFatal ("Batch: cannot create a temporary file");
+	  // Nothing buffered is to be output twice
+	  cout.flush ();
+	  fflush (stdout);
+	  pid_t pid = fork ();
+	  if (pid < 0) Logger::addFatal ("Batch: cannot create a worker process");
+	  if (pid == 0) runJob (jobs[next], results[next]);
+	  running[pid] = next++;
+	  continue;
+	}
+
+      int exit_status;
+      pid_t pid = waitpid (-1, &exit_status, 0);
+      if (pid < 0) Logger::addFatal ("Batch: lost the worker processes");
+      map < pid_t, size_t >::iterator it = running.find (pid);
+      if (it == running.end ()) continue;
+      BatchJob & job = jobs[it->second];
+      readResults (job, results[it->second], exit_status);
+      fclose (results[it->second]);
+      running.erase (it);
+      done++;
+      if (job.status != "ok") failed++;
+      reportJob (job, done);
+    }
+
+  ofstream os (output_file.c_str ());
+  if (!os) Logger::addFatal ("Batch: cannot open the result file " + output_file);
+  if (output_file.size () >= 5 && output_file.compare (output_file.size () - 5, 5, ".json") == 0) writeJSON (os);
+  else writeCSV (os);
+  return failed;
+}
+
+/** CSV field, quoted if needed */
+static string
+csv (const string & s)
+{
+  if (s.find_first_of (",\"\n") == string::npos) return s;
+  string r = "\"";
+  for (size_t i = 0; i < s.size (); i++)
+    {
+      if (s[i] == '"') r += '"';
+      r += s[i];
+    }
+  return r + "\"";
+}
+
+/** JSON string, with the control characters escaped */
+static string
+json (const string & s)
+{
+  string r = "\"";
+  for (size_t i = 0; i < s.size (); i++)
+    {
+      unsigned char c = s[i];
+      if (c == '"' || c == '\\') r += '\\';
+      if (c == '\n') r += "\\n";
+      else if (c == '\t') r += "\\t";
+      else if (c == '\r') r += "\\r";
+      else if (c < 0x20)
+	{
+	  char escaped[8];
+	  snprintf (escaped, sizeof (escaped), "\\u%04x", c);
+	  r += escaped;
+	}
+      else r += c;
+    }
+  return r + "\"";
+}
+
+// One line per analysis step, then a TOTAL line per job
+void
+Batch::writeCSV (ostream & os)
+{
+  os << "job,config,status,wcet,step,analysis,time" << endl;
+  for (size_t j = 0; j < jobs.size (); j++)
+    {
+      const BatchJob & job = jobs[j];
+      string prefix = csv (job.name) + "," + csv (job.config_file) + "," + csv (job.status) + "," + csv (job.wcet) + ",";
+      for (size_t i = 0; i < job.pass_times.size (); i++)
+	os << prefix << i + 1 << "," << job.pass_times[i].first << "," << job.pass_times[i].second << endl;
+      os << prefix << "," << "TOTAL" << "," << job.total_time << endl;
+    }
+}
+
+void
+Batch::writeJSON (ostream & os)
+{
+  os << "[" << endl;
+  for (size_t j = 0; j < jobs.size (); j++)
+    {
+      const BatchJob & job = jobs[j];
+      os << "  {\"job\": " << json (job.name) << ", \"config\": " << json (job.config_file)
+	 << ", \"status\": " << json (job.status) << ", \"wcet\": ";
+      if (job.wcet == "") os << "null";
+      else if (job.wcet.find_first_not_of ("-0123456789") == string::npos) os << job.wcet;
+      else os << json (job.wcet);
+      os << ", \"time\": " << job.total_time << "," << endl << "   \"passes\": [";
+      for (size_t i = 0; i < job.pass_times.size (); i++)
+	os << (i ? ", " : "") << "{\"analysis\": " << json (job.pass_times[i].first) << ", \"time\": " << job.pass_times[i].second << "}";
+      os << "]}" << (j + 1 < jobs.size () ? "," : "") << endl;
+    }
+  os << "]" << endl;
+}
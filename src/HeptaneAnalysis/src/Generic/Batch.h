@@ -0,0 +1,125 @@
+/* ---------------------------------------------------------------------
+
+   Copyright IRISA, 2003-2017
+
+   This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+   estimation.
+   APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+   Heptane is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Heptane is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details (COPYING.txt).
+
+   See CREDITS.txt for credits of authorship
+
+   ------------------------------------------------------------------------ */
+
+/**
+ * \brief Batch mode: analysis of a list of programs by a pool of worker processes
+ * (HeptaneAnalysis -batch manifest.xml).
+ *
+ * The manifest lists the configuration files to analyse:
+ *
+ *   <BATCH workers="8" output="results.csv">
+ *     <JOB name="bs" config="benchmarks/bs/configWCET.xml"/>
+ *     ...
+ *   </BATCH>
+ *
+ * The relative paths are relative to the directory of the manifest. workers
+ * is the number of jobs run at the same time (number of cores by default).
+ * The results are written in JSON when the output file name ends with
+ * .json, in CSV otherwise, in the order of the manifest.
+ *
+ * Every job runs in a process of its own, forked once the attribute types are
+ * registered: the global configuration, the architecture and the Logger are
+ * private to the job, and a fatal error (Logger::addFatal exits) only stops
+ * its job. A job is run from the directory of its configuration file, as
+ * analysis.sh does, with its output redirected to the log file of the JOB
+ * (the configuration file name with a .log extension by default). The shared
+ * text files (WCET1.txt, original_analysis.txt) are not written. The WCET and
+ * the duration of every analysis step are sent back to the batch driver.
+ *
+ * With <BATCH sessions="on" ...>, the jobs are run in the batch process instead,
+ * as analysis sessions (see AnalysisSession) on workers threads. A fatal error
+ * still only stops its job, but the jobs share the current directory: the job
+ * is not run from the directory of its configuration file (the INPUTOUTPUTDIR
+ * should be absolute), and only the Logger messages go to its log file.
+ */
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <stdio.h>
+#include <mutex>
+
+using namespace std;
+
+/**
+ * \class BatchJob
+ * \brief Job of a manifest and its results.
+ */
+class BatchJob
+{
+public:
+  string name;
+  string config_file;
+  string log_file;
+
+  /** Results, filled by Batch::run */
+  string status;		///< "ok", "exit N" or "signal N" ("fatal" for a failed session)
+  string wcet;			///< "" if no IPET step attached the WCET
+  float total_time;		///< duration of the analysis, in seconds
+  vector < pair < string, float > > pass_times;	///< name and duration of every analysis step
+
+  BatchJob ():total_time (0.0)
+  {
+  }
+};
+
+/**
+ * \class Batch
+ */
+class Batch
+{
+public:
+  /** Reads the manifest. */
+  Batch (string manifest);
+
+  /** Runs all the jobs and writes the result file. @return the number of failed jobs */
+  int run ();
+
+private:
+  vector < BatchJob > jobs;
+  string output_file;
+  unsigned int nbWorkers;
+  bool sessions;		///< jobs run as analysis sessions on threads (sessions="on")
+  size_t nbDone;		///< sessions mode: number of completed jobs
+  std::mutex lock;		///< sessions mode: protects nbDone and the progress messages
+
+  /** Body of the worker process of job, which sends its results to result. Does not return. */
+  void runJob (const BatchJob & job, FILE * result);
+
+  /** Runs job in an analysis session of the calling thread (sessions mode) and fills its results. */
+  void runSession (BatchJob & job);
+
+  /** Prints the completion of job, the done-th one. */
+  void reportJob (const BatchJob & job, size_t done);
+
+  friend class BatchSessionTask;
+
+  /** Reads the results sent by the worker process of job, exit_status being its wait status. */
+  void readResults (BatchJob & job, FILE * result, int exit_status);
+
+  void writeCSV (ostream & os);
+  void writeJSON (ostream & os);
+};
+
+#endif
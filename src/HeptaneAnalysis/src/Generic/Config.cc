@@ -21,6 +21,7 @@
 
 #include <stdlib.h>
 #include <queue>
+#include <memory>
 #include "Config.h"
 #include "Specific/CacheAnalysis/ICacheAnalysis.h"
 #include "Specific/CacheAnalysis/CacheStatistics.h"
@@ -36,10 +37,10 @@
 #include "Specific/PipelineAnalysis/ARMPipelineAnalysis.h"
 #include "arch.h"
 #include "Specific/DummyAnalysis/DummyAnalysis.h"
+#include "Specific/InterferenceAnalysis/InterferenceAnalysis.h"
 #include "Generic/Timer.h"
 
 
-Config *config = new Config ();	// global object.
 
 #define ON "on"
 #define OFF "off"
@@ -62,6 +63,10 @@ Config::Config ()
   memory_store_latency = 0;
   input_output_dir = "./";
   entrypoint=string("");
+  p = NULL;
+  shared_logs = true;
+  shared_wcet_file = shared_time_file = "";
+  config_dir = "";
   initParameters();
 }
 
@@ -78,6 +83,15 @@ Config::Config ()
 
 Config::~Config ()
 {
+  if (p != NULL) delete p;
+}
+
+/** path, relative to config_dir when it is a relative path */
+string
+Config::inConfigDir (const string & path)
+{
+  if (config_dir == "" || (path != "" && path[0] == '/')) return path;
+  return config_dir + path;
 }
 
 // ---------------------------------------------------
@@ -103,10 +117,22 @@ Config::FillArchitectureFromXml (string xml_file)
   //for(auto i : lt) cout << "name: " + i.getName() << endl;
 
   assert (lt.size () <= 1);
-  if (lt.size () == 1)
-    input_output_dir = lt[0].getAttributeString ("name");
+  input_output_dir = inConfigDir ((lt.size () == 1) ? lt[0].getAttributeString ("name") : "./");
   //cout << "The attributeString is " + input_output_dir << endl;
 
+  // Optional shared text files, where every run appends its WCET and its
+  // analysis time (relative paths are in the input/output directory)
+  lt = xmldoc.searchChildren ("SHAREDLOGS");
+  if (lt.size () > 1)
+    Logger::addFatal ("Config: there should be at most one SHAREDLOGS tag in your XML");
+  if (lt.size () == 1)
+    {
+      string wcet_file = lt[0].getAttributeString ("wcet_file");
+      string time_file = lt[0].getAttributeString ("time_file");
+      if (wcet_file != "") shared_wcet_file = (wcet_file[0] == '/') ? wcet_file : input_output_dir + "/" + wcet_file;
+      if (time_file != "") shared_time_file = (time_file[0] == '/') ? time_file : input_output_dir + "/" + time_file;
+    }
+
   // Architecture section
   // ----------------------
 
@@ -210,6 +236,8 @@ Config::FillArchitectureFromXml (string xml_file)
   if (!perfectIcache && !perfectDcache && (nb_icache_levels != nb_dcache_levels))
     Logger::addFatal ("Config: configuration file should have the same levels for caches, except the perfect caches.");
   
+  CheckUnifiedCaches ();
+
   if (!has_memory)
     Logger::addFatal ("Config: configuration file should have one unique MEMORY tag");
   if (!target_found)
@@ -301,12 +329,13 @@ ParamAnalysis * Config::getParameters(string directive, string input_output_dir,
   if (directive == "HTMLPRINT") { return new ParamHtmlPrint (analysis); }
   if (directive == "CACHESTATISTICS") { return new ParamCacheStatistics (analysis);}
 
-  // Analysis ::= ICACHE | PIPELINE | IPET | DATAADDRESS | DCACHE | DUMMYANALYSIS
+  // Analysis ::= ICACHE | PIPELINE | IPET | DATAADDRESS | DCACHE | DUMMYANALYSIS | INTERFERENCE
   if (directive == "ICACHE") { return new ParamICache (analysis); }
   if (directive == "DATAADDRESS") { return new ParamDataAddress (analysis); }
   if (directive == "DCACHE") { return new ParamDCache (analysis); }
   if (directive == "PIPELINE") { return  new ParamPipeline (analysis); }
   if (directive == "IPET") { return  new ParamIPET (analysis); }
+  if (directive == "INTERFERENCE") { return new ParamInterference (analysis); }
   // Fatal error otherwise.
   string error_msg = "Config: unknown analysis type " + directive;
   Logger::addFatal (error_msg);
@@ -353,7 +382,7 @@ Analysis* Config::mkAnalyzerObject(string directive, Program *p, ParamAnalysis *
       return new CacheStatistics (p, GetCaches (), perfectIcache, perfectDcache);
     }
 
-  // Analysis ::= ICACHE | DATAADDRESS | DCACHE | PIPELINE | IPET  | DUMMYANALYSIS
+  // Analysis ::= ICACHE | DATAADDRESS | DCACHE | PIPELINE | IPET  | DUMMYANALYSIS | INTERFERENCE
   if (directive == "ICACHE")
     {
       ParamICache *ps = (ParamICache *) pa;
@@ -363,7 +392,7 @@ Analysis* Config::mkAnalyzerObject(string directive, Program *p, ParamAnalysis *
       if ( perfectIcache &&  ps->level != 1)
 	Logger::addFatal ("ICacheAnalysis : bad level for perfect instruction cache");
       if (ps->level > MaxLevelCacheAnalysis) MaxLevelCacheAnalysis=ps->level;
-      return new ICacheAnalysis (p, cp->nbsets, cp->nbways, cp->cachelinesize, cp->replacement_policy, ps->level, ps->apply_must, ps->apply_persistence, ps->apply_may, ps->keep_age, perfectIcache);
+      return new ICacheAnalysis (p, cp->nbsets, cp->nbways, cp->cachelinesize, cp->replacement_policy, ps->level, ps->apply_must, ps->apply_persistence, ps->apply_may, ps->keep_age, perfectIcache, ps->nb_threads, ps->summary, ps->callstring_depth);
     }
 
   if (directive == "DATAADDRESS") 
@@ -382,7 +411,7 @@ Analysis* Config::mkAnalyzerObject(string directive, Program *p, ParamAnalysis *
 	Logger::addFatal ("DCacheAnalysis : bad level for perfect data cache");
 
       if (ps->level > MaxLevelCacheAnalysis) MaxLevelCacheAnalysis=ps->level;
-      return new DCacheAnalysis (p, cp->nbsets, cp->nbways, cp->cachelinesize, cp->replacement_policy, ps->level, ps->apply_must, ps->apply_persistence, ps->apply_may, perfectDcache);
+      return new DCacheAnalysis (p, cp->nbsets, cp->nbways, cp->cachelinesize, cp->replacement_policy, ps->level, ps->apply_must, ps->apply_persistence, ps->apply_may, perfectDcache, ps->nb_threads, ps->summary, ps->callstring_depth);
     }
   if (directive == "PIPELINE")
     {
@@ -395,6 +424,24 @@ Analysis* Config::mkAnalyzerObject(string directive, Program *p, ParamAnalysis *
       ParamIPET *ps = (ParamIPET *) pa;
       return new IPETAnalysis (p, ps->solver, ps->pipeline, ps->attach_WCET_info, ps->generate_node_freq, getNbICacheLevels (), getNbDCacheLevels (), cache_params);
     }
+  if (directive == "INTERFERENCE")
+    {
+      ParamInterference *ps = (ParamInterference *) pa;
+      int level = (ps->level == 0) ? getNbICacheLevels () : ps->level;
+      if (InterferenceAnalysis::getCache (cache_params, ICACHE, level) == NULL || InterferenceAnalysis::getCache (cache_params, DCACHE, level) == NULL)
+	Logger::addFatal ("InterferenceAnalysis: an instruction and a data cache are required at level " + to_string (level));
+
+      string task = (ps->task != "") ? ps->task : program_file + ":" + p->GetEntryPoint ()->getStringName ();
+      string interfering_file = "";
+      if (ps->interfering_file != "")
+	interfering_file = input_output_dir + "/" + ps->interfering_file;
+      else if (interfering_task != "")
+	interfering_file = input_output_dir + "/../" + interfering_task + "/" + "resDCacheL" + to_string (level) + ".xml";
+      string evicted_file = (ps->evicted_file != "") ? input_output_dir + "/" + ps->evicted_file : "";
+      string statistics_file = (ps->statistics_file != "") ? input_output_dir + "/" + ps->statistics_file : "";
+      string footprint_file = (ps->footprint_file != "") ? input_output_dir + "/" + ps->footprint_file : "";
+      return new InterferenceAnalysis (p, task, level, cache_params, interfering_file, evicted_file, statistics_file, footprint_file);
+    }
 
   // Already testesd before in getParameters() ?
   string error_msg = "Config: unknown analysis type " + directive;
@@ -413,14 +460,13 @@ Config::ExecuteFromXml (string xml_file, bool printTime)
 {
   XmlDocument xmldoc (xml_file);
   ListXmlTag lt;
-  bool b;
   string ep;
 
   // Directory section
   // -----------------
   lt = xmldoc.searchChildren ("INPUTOUTPUTDIR");
   assert (lt.size () <= 1);
-  if (lt.size () == 1) { input_output_dir = lt[0].getAttributeString ("name");}
+  if (lt.size () == 1) { input_output_dir = inConfigDir (lt[0].getAttributeString ("name"));}
 
   // Search for analysis section
   // --------------------------
@@ -435,6 +481,15 @@ Config::ExecuteFromXml (string xml_file, bool printTime)
   // --------------------------------------------------------
   ListXmlTag ltanalysis = lt[0].getAllChildren ();
   p= NULL;
+
+  // Cache configuration sweep
+  lt = xmldoc.searchChildren ("SWEEP");
+  if (lt.size () > 1) { Logger::addFatal ("Config: there should be at most one SWEEP tag in your XML");}
+  if (lt.size () == 1)
+    {
+      ExecuteSweep (lt[0], ltanalysis, printTime);
+      return;
+    }
   for (unsigned int i = 0; i < ltanalysis.size (); i++)
     {
      // Logger::print("The ltanalysis is " + to_string(ltanalysis.size()) + "\n");
@@ -458,31 +513,13 @@ Config::ExecuteFromXml (string xml_file, bool printTime)
       // Call the analysis
       // -----------------
       // Decide on which program the analysis should be applied and check the program suitability for WCET before going on
-      b = false;
-      if (pa->input_file != "")
-	{
-	  if (p != NULL) delete p;
-	  p = Program::unserialise_program_file (input_output_dir + "/" + pa->input_file);
-	  AnalysisHelper::ProgramCheck (p);
-	  b = true;
-	}
-      if (analysis_name == "ENTRYPOINT")
-	{
-	  ep = ((ParamEntryPoint*) pa)->entrypoint ;
-	  if (!p->SetEntryPoint(ep)) Logger::addFatal ("Config: Bad entry point name " + ep );
-	  b = true;
-	}
-      if (b)
-	{
-	  AnalysisHelper::computeContext(p);
-	  initParameters();
-	  Logger::print( "\n*** Begin analysis for entry point: " + ep);
-	}
+      SetupProgram (analysis_name, pa, ep);
       
-      // Clone the program should the analysis results are not kept
-      Program *pgm = NULL;
-      if (! pa->keep_results) pgm = p->Clone (); else { pgm = p; entrypoint=ep;}
-      assert (pgm != NULL);
+      // Should the analysis results not be kept, the analysis writes its attributes in a layer
+      // discarded after the output (instead of a clone of the program, see AttributeLayer.h).
+      // The layer is also discarded when a fatal error of a session unwinds this function.
+      unique_ptr < AttributeLayer > layer;
+      if (! pa->keep_results) layer.reset (new AttributeLayer ()); else entrypoint=ep;
 
       if ( analysis_name != "ENTRYPOINT")
 	{
@@ -505,11 +542,14 @@ Config::ExecuteFromXml (string xml_file, bool printTime)
 	      infostr << " =======Yixian> Total time for the analyses = "  << time;
 	      Logger::addInfo(infostr.str());
 	      Logger::print();
-        string tmp = to_string(time);
-        ofstream original_analysis;
-        original_analysis.open("/home/yixian/heptane_svn/original_analysis.txt",ios::app); 
-	      original_analysis << tmp << endl;
-        original_analysis.close();
+	      if (shared_logs && shared_time_file != "")
+		{
+		  string tmp = to_string(time);
+		  ofstream original_analysis;
+		  original_analysis.open(shared_time_file.c_str(),ios::app); 
+		  original_analysis << tmp << endl;
+		  original_analysis.close();
+		}
 
       }
 
@@ -519,7 +559,14 @@ Config::ExecuteFromXml (string xml_file, bool printTime)
 	  bool res = a->CheckPerformCleanup (printTime);
 	  if (!res) Logger::addFatal ("Config: call to analysis failed");
 	  Logger::print ();
-	  if (Logger::getErrorState ()) exit (-1);
+	  if (Logger::getErrorState ()) Logger::addFatal ("Config: errors reported by analysis " + analysis_name);
+	  pass_times.push_back (make_pair (analysis_name, a->getTime ()));
+	  if (analysis_name == "IPET")
+	    {
+	      Cfg *c = p->GetEntryPoint ();
+	      if (c != NULL && c->HasAttribute (WCETAttributeName))
+		wcet = ((SerialisableStringAttribute &) c->GetAttribute (WCETAttributeName)).GetValue ();
+	    }
 	  
 	  // For debug only
 	  if ((analysis_name == "IPET") && Logger::isDebugMode ())
@@ -528,7 +575,7 @@ Config::ExecuteFromXml (string xml_file, bool printTime)
 	      if (res)
 		{
 		  // Retrieve the WCET, stored as an attribute attached to the program entry point
-		  Cfg *c = pgm->GetEntryPoint ();
+		  Cfg *c = p->GetEntryPoint ();
       
 		  // Modified LBesnard, May 2016. When attach_WCET_info is set to false, the value of the WCET is not kept.
 		  if (c->HasAttribute (WCETAttributeName))
@@ -554,10 +601,11 @@ Config::ExecuteFromXml (string xml_file, bool printTime)
       if (ofile != "")
 	{
 	  string xml_file = input_output_dir + "/" + ofile;
-	  pgm->serialise_program (xml_file);
+	  if (pa->binary_format) p->serialise_program_binary (xml_file);
+	  else p->serialise_program (xml_file);
 	}
       
-      if (!pa->keep_results) { delete pgm; }
+      if (layer) { layer->Discard (); layer.reset (); }
 
       // Cleaning for the next step.
       delete pa; pa = NULL;
@@ -566,6 +614,200 @@ Config::ExecuteFromXml (string xml_file, bool printTime)
 }
 
 
+void
+Config::SetupProgram (string analysis_name, ParamAnalysis * pa, string & ep)
+{
+  bool b = false;
+  if (pa->input_file != "")
+    {
+      if (p != NULL) delete p;
+      p = Program::unserialise_program_file (input_output_dir + "/" + pa->input_file);
+      program_file = pa->input_file;
+      AnalysisHelper::ProgramCheck (p);
+      AnalysisHelper::decodeInstructions (p);
+      b = true;
+    }
+  if (analysis_name == "ENTRYPOINT")
+    {
+      ep = ((ParamEntryPoint*) pa)->entrypoint ;
+      if (!p->SetEntryPoint(ep)) Logger::addFatal ("Config: Bad entry point name " + ep );
+      b = true;
+    }
+  if (b)
+    {
+      AnalysisHelper::computeContext(p, MaxLevelCacheAnalysis);
+      initParameters();
+      Logger::print( "\n*** Begin analysis for entry point: " + ep);
+    }
+}
+
+// ---------------------------------------------------
+//
+//  Cache configuration sweep
+//
+//  <SWEEP result_file="resSweep.csv">
+//    <POINT name="...">  CACHE tags, each replacing the cache of the same type and level </POINT>
+//    ...
+//  </SWEEP>
+//
+//  The cache independent steps of the ANALYSIS section (ENTRYPOINT, DATAADDRESS)
+//  are applied once, then the cache dependent ones (ICACHE, DCACHE, PIPELINE, IPET)
+//  are applied for every point in an attribute layer discarded after the point (see
+//  AttributeLayer.h), which leaves the program as it was. The other steps (printers,
+//  statistics, interference) are not applied. The WCET of every point is written
+//  in the result file (one line per point).
+//
+// ---------------------------------------------------
+static bool isCacheDependent (string analysis_name)
+{
+  return analysis_name == "ICACHE" || analysis_name == "DCACHE" || analysis_name == "PIPELINE" || analysis_name == "IPET";
+}
+
+static string cacheTypeName (t_cache_type type)
+{
+  switch (type)
+    {
+    case ICACHE: return "icache";
+    case DCACHE: return "dcache";
+    case PERFECTICACHE: return "picache";
+    default: return "pdcache";
+    }
+}
+
+static string cacheDescription (CacheParam * cp)
+{
+  if (cp->type == PERFECTICACHE || cp->type == PERFECTDCACHE) return "perfect";
+  stringstream s;
+  s << cp->nbsets << "x" << cp->nbways << "x" << cp->cachelinesize;
+  return s.str ();
+}
+
+void
+Config::ExecuteSweep (XmlTag const &sweep, ListXmlTag & ltanalysis, bool printTime)
+{
+  string ep;
+  string result_file = sweep.getAttributeString ("result_file");
+  if (result_file == "") Logger::addFatal ("Config: the SWEEP tag should have a result_file attribute");
+
+  // Cache independent steps, once
+  bool has_ipet = false;
+  for (unsigned int i = 0; i < ltanalysis.size (); i++)
+    {
+      string analysis_name = ltanalysis[i].getName ();
+      if (analysis_name == "comment") continue;
+      ParamAnalysis *pa = getParameters(analysis_name, input_output_dir, ltanalysis[i]);
+      assert (pa != NULL);
+      if (isCacheDependent (analysis_name))
+	{
+	  if (pa->input_file != "") Logger::addFatal ("Config: a " + analysis_name + " step of a SWEEP cannot read an input file");
+	  if (analysis_name == "IPET" && ((ParamIPET *) pa)->attach_WCET_info) has_ipet = true;
+	  delete pa;
+	  continue;
+	}
+      if (analysis_name != "ENTRYPOINT" && analysis_name != "DATAADDRESS")
+	{
+	  Logger::addInfo ("Config: " + analysis_name + " is not applied by a SWEEP");
+	  Logger::print ();
+	  delete pa;
+	  continue;
+	}
+
+      SetupProgram (analysis_name, pa, ep);
+      if (analysis_name != "ENTRYPOINT")
+	{
+	  Analysis *a = mkAnalyzerObject(analysis_name, p, pa);
+	  a->setName(analysis_name);
+	  Logger::clean ();
+	  if (!a->CheckPerformCleanup (printTime)) Logger::addFatal ("Config: call to analysis failed");
+	  Logger::print ();
+	  if (Logger::getErrorState ()) Logger::addFatal ("Config: errors reported by analysis " + analysis_name);
+	  pass_times.push_back (make_pair (analysis_name, a->getTime ()));
+	  delete a;
+	}
+      if (pa->output_file != "")
+	{
+	  string xml_file = input_output_dir + "/" + pa->output_file;
+	  if (pa->binary_format) p->serialise_program_binary (xml_file);
+	  else p->serialise_program (xml_file);
+	}
+      delete pa;
+    }
+  if (p == NULL) Logger::addFatal ("Config: no program to analyse in the SWEEP");
+  if (!has_ipet) Logger::addFatal ("Config: a SWEEP requires an IPET step with attach_WCET_info=\"on\"");
+
+  ofstream os ((input_output_dir + "/" + result_file).c_str ());
+  if (!os) Logger::addFatal ("Config: cannot open the SWEEP result file " + result_file);
+  os << "point";
+  for (map < int, vector < CacheParam * > >::iterator it = cache_params.begin (); it != cache_params.end (); ++it)
+    for (unsigned int j = 0; j < it->second.size (); j++)
+      os << "," << cacheTypeName (it->second[j]->type) << "L" << it->first;
+  os << ",WCET,time" << endl;
+
+  // Cache dependent steps, for every point
+  map < int, vector < CacheParam * > >architecture = cache_params;
+  ListXmlTag points = sweep.searchChildren ("POINT");
+  for (unsigned int ip = 0; ip < points.size (); ip++)
+    {
+      string point = points[ip].getAttributeString ("name");
+      if (point == "") point = to_string (ip);
+
+      // Cache configuration of the point
+      vector < CacheParam * >owned;
+      ListXmlTag caches = points[ip].searchChildren ("CACHE");
+      for (unsigned int ic = 0; ic < caches.size (); ic++)
+	{
+	  CacheParam *cp = new CacheParam (caches[ic]);
+	  owned.push_back (cp);
+	  vector < CacheParam * >&level = cache_params[cp->level];
+	  unsigned int j = 0;
+	  while (j < level.size () && level[j]->type != cp->type) j++;
+	  if (j == level.size ()) Logger::addFatal ("Config: SWEEP point " + point + " has a cache which is not in the ARCHITECTURE");
+	  level[j] = cp;
+	}
+      CheckUnifiedCaches ();
+
+      Timer timer_point;
+      float time = 0.0;
+      timer_point.initTimer ();
+      AttributeLayer layer;
+      initParameters ();
+      Logger::print ("\n*** SWEEP point " + point);
+      for (unsigned int i = 0; i < ltanalysis.size (); i++)
+	{
+	  string analysis_name = ltanalysis[i].getName ();
+	  if (!isCacheDependent (analysis_name)) continue;
+	  ParamAnalysis *pa = getParameters(analysis_name, input_output_dir, ltanalysis[i]);
+	  Analysis *a = mkAnalyzerObject(analysis_name, p, pa);
+	  a->setName(analysis_name);
+	  Logger::clean ();
+	  if (!a->CheckPerformCleanup (printTime)) Logger::addFatal ("Config: call to analysis failed");
+	  Logger::print ();
+	  if (Logger::getErrorState ()) Logger::addFatal ("Config: errors reported by analysis " + analysis_name);
+	  pass_times.push_back (make_pair (analysis_name, a->getTime ()));
+	  delete a;
+	  delete pa;
+	}
+      timer_point.addTimer (time);
+
+      string wcet = "-1";
+      Cfg *c = p->GetEntryPoint ();
+      if (c->HasAttribute (WCETAttributeName))
+	wcet = ((SerialisableStringAttribute &) c->GetAttribute (WCETAttributeName)).GetValue ();
+      os << point;
+      for (map < int, vector < CacheParam * > >::iterator it = cache_params.begin (); it != cache_params.end (); ++it)
+	for (unsigned int j = 0; j < it->second.size (); j++)
+	  os << "," << cacheDescription (it->second[j]);
+      os << "," << wcet << "," << time << endl;
+      Logger::addInfo ("SWEEP point " + point + ": WCET = " + wcet);
+      Logger::print ();
+
+      layer.Discard ();
+      cache_params = architecture;
+      for (unsigned int ic = 0; ic < owned.size (); ic++) delete owned[ic];
+    }
+  os.close ();
+}
+
 
 // ---------------------------------------------------
 //
@@ -648,6 +890,29 @@ Config::GetCacheAtLevel (int level, t_cache_type type)
   return vcp[idx];
 }
 
+void
+Config::CheckUnifiedCaches ()
+{
+  for (map < int, vector < CacheParam * > >::iterator it = cache_params.begin (); it != cache_params.end (); ++it)
+    {
+      CacheParam *icache = NULL, *dcache = NULL;
+      bool unified = false;
+      for (unsigned int j = 0; j < it->second.size (); j++)
+	{
+	  CacheParam *cp = it->second[j];
+	  unified = unified || cp->unified;
+	  if (cp->type == ICACHE) icache = cp;
+	  if (cp->type == DCACHE) dcache = cp;
+	}
+      if (!unified) continue;
+      string level = "Config: unified cache of level " + to_string (it->first);
+      if (icache == NULL || dcache == NULL || !icache->unified || !dcache->unified)
+	Logger::addFatal (level + ": both the icache and the dcache should have unified=\"on\"");
+      if (icache->nbsets != dcache->nbsets || icache->nbways != dcache->nbways || icache->cachelinesize != dcache->cachelinesize)
+	Logger::addFatal (level + ": the icache and the dcache should have the same geometry");
+    }
+}
+
 // --------------------------------
 //
 // Reading of cache parameters
@@ -658,6 +923,13 @@ CacheParam::CacheParam (XmlTag const &tag)
   string stype = tag.getAttributeString ("type");
   assert (stype == "icache" || stype == "dcache" || stype =="pdcache" || stype =="picache");
 
+  // optional, unified="on": the icache and the dcache of the level are the two sides of a unified cache
+  string sunified = tag.getAttributeString ("unified");
+  if (sunified == "") sunified = "off";
+  if (sunified != "on" && sunified != "off")
+    Logger::addFatal ("Config: CACHE unified should be on or off");
+  this->unified = (sunified == "on");
+
   if ((stype == "icache") || (stype == "dcache"))
     {
       if (stype == "icache") this->type = ICACHE; else this->type = DCACHE;
@@ -700,6 +972,10 @@ CacheParam::CacheParam (XmlTag const &tag)
       }
 }
 
+CacheParam::~CacheParam ()
+{
+}
+
 // ---------------------------------------------------
 //
 //  To obtained configuration of all the caches
@@ -716,352 +992,6 @@ int Config::getMaxLevelCacheAnalysis()
   return MaxLevelCacheAnalysis;
 }
 
-int cacheline_size = 32;
-int nb_sets = 128;
-
-  /** Computes the address corresponding to the beginning of the cache line where addr is */
-t_address computeStartLine (t_address addr) 
-  {
-    return addr - (addr % cacheline_size);
-  }
-  /** Computes the set where addr is mapped */
-  unsigned int computeSet (t_address addr) 
-  {
-    int theNumberofComputerSet = (computeStartLine (addr) / cacheline_size) % nb_sets;
-   
-    return (computeStartLine (addr) / cacheline_size) % nb_sets;
-  }
-
-/** Generate the HB block table*/
-vector<Config::HB> 
-Config::GenerateIcacheHB(string xml_file){
-  cout << "xml_file is " << xml_file << endl;
-  XmlDocument xmldoc(xml_file);
-  //xmlDocPtr xmlDocP = (*xmlDocPtr)xmldoc;
-  ListXmlTag lt;
-  vector<Config::HB> hb;
-  lt = xmldoc.searchChildren("PROGRAM");
-  ListXmlTag lanalysis = lt[0].getAllChildren();
-
-  cout << "lanalysis[0] is " << lanalysis[0].getAttributeString("name") << endl;
-  cout << endl;
-  cout << "The lanalysis size is " << dec << lanalysis.size() << endl;
-
-  for(unsigned int i = 0;i < lanalysis.size(); i++){
-    //lanalysis[i].print();
-    //cout << "lanalysis[i] is " << lanalysis[i].getAttributeString("name") << endl;
-    HB tmp;
-    ListXmlTag lsub = lanalysis[i].searchChildren("NODE");
-    for(unsigned int j = 0;j < lsub.size();j++){
-      ListXmlTag linr = lsub[j].searchChildren("INSTRUCTION");
-      for(unsigned int k = 0; k < linr.size();k++){
-        ListXmlTag linc = linr[k].searchChildren("ATTRS_LIST");
-        bool isExistAH = false;
-        for(unsigned int t = 0; t < linc.size();t++){
-          ListXmlTag lind = linc[t].searchChildren("ATTR");
-            for(unsigned int d = 0; d < lind.size();d++){
-             if(lind[d].getAttributeString("type") == "string"
-               && lind[d].getAttributeString("name").find("CHMCL2") != string::npos
-               && (lind[d].getAttributeString("value") == "AH"||
-                   lind[d].getAttributeString("value") == "FM")){
-                 isExistAH = true;
-                 tmp.CHMCValue = lind[d].getAttributeString("name");       
-             }  
-            }        
-          if(isExistAH && (lind[0].getAttributeString("type") == "string" ||
-          lind[1].getAttributeString("type") == "string")){
-            ListXmlTag laccess = lind[lind.size() - 1].searchChildren("ACCES");
-            ListXmlTag laddrsize = laccess[0].searchChildren("ADDRSIZE");
-            tmp.address = laddrsize[0].getAttributeHexa("begin");
-            tmp.cacheset = computeSet(laddrsize[0].getAttributeHexa("begin"));
-            hb.push_back(tmp);
-          }         
-        }
-      } 
-    }
-    
-    
-    
-    ListXmlTag lloop =  lanalysis[i].searchChildren("LOOP");
-    if(!lloop.empty()){
-      for(unsigned int it = 0;it < lloop.size();it++){
-        string slloop = lloop[it].getAttributeString("nodes"); 
-        cout << "lloop is " << slloop << endl;
-        vector<string> lnodes;
-        string tmpNode= "";
-        for(unsigned int il = 0; il < slloop.size();il++){ 
-            if(slloop[il] == ','){
-                lnodes.push_back(tmpNode);
-                tmpNode="";
-            }
-            if(slloop[il] >= '0' && slloop[il] <= '9'){       
-             tmpNode += slloop[il];
-            }
-           
-        }
-        for(auto cc : lnodes) cout << "node: " << cc << endl;
-        ListXmlTag lattrl = lloop[it].searchChildren("ATTRS_LIST");
-        ListXmlTag lattr = lattrl[0].searchChildren("ATTR");
-        int maxiter = lattr[0].getAttributeInt("value");
-        cout << "maxiter: " << maxiter << endl;
-
-        
-        for(auto CertainNode : lnodes){
-          for(unsigned int ii = 0; ii < lanalysis.size();ii++){
-              ListXmlTag lsub = lanalysis[ii].searchChildren("NODE");
-              for(unsigned int j = 0;j < lsub.size();j++){
-                if(lsub[j].getAttributeString("id") == CertainNode){
-                  ListXmlTag linr = lsub[j].searchChildren("INSTRUCTION");
-                  for(unsigned int k = 0; k < linr.size();k++){
-                    ListXmlTag linc = linr[k].searchChildren("ATTRS_LIST");
-                    bool isExistAH = false;
-                    for(unsigned int t = 0; t < linc.size();t++){
-                      ListXmlTag lind = linc[t].searchChildren("ATTR");
-                        for(unsigned int d = 0; d < lind.size();d++){
-                        if(lind[d].getAttributeString("type") == "string"
-                          && lind[d].getAttributeString("name").find("CHMCL2") != string::npos
-                          && (lind[d].getAttributeString("value") == "AH" ||
-                               lind[d].getAttributeString("value") == "FH") ){
-                            isExistAH = true;
-                            tmp.CHMCValue = lind[d].getAttributeString("name");       
-                          }  
-                        }        
-                      if(isExistAH && (lind[0].getAttributeString("type") == "string" ||
-                      lind[1].getAttributeString("type") == "string")){
-                        ListXmlTag laccess = lind[lind.size() - 1].searchChildren("ACCES");
-                        ListXmlTag laddrsize = laccess[0].searchChildren("ADDRSIZE");
-                        tmp.address = laddrsize[0].getAttributeHexa("begin");
-                        tmp.cacheset = computeSet(laddrsize[0].getAttributeHexa("begin"));
-                        for(int itt = 1; itt < maxiter; itt++) {
-                            //cout << "test........***********************>>>>>>>>>>" << endl;
-                            hb.push_back(tmp);
-                        }
-
-                          
-                      }         
-                    }
-                  } 
-                }   
-              }
-            }
-        }
-
-
-       
-        
-      }
-     
-
-
-  }
-   
-  }
-  return hb;
-}
-
-
-
-  /** Generate the CB block table*/
-vector<Config::CB>  Config::GenerateIcacheCB(string xml_file){
-  cout << "xml_file is nn" << xml_file << endl;
-  XmlDocument xmldoc(xml_file);
-  //xmlDocPtr xmlDocP = (*xmlDocPtr)xmldoc;
-  ListXmlTag lt;
-  vector<Config::CB> cb;
-  Config::CB tmp;
-  lt = xmldoc.searchChildren("PROGRAM");
-  ListXmlTag lanalysis = lt[0].getAllChildren();
-  cout << lanalysis[0].getAttributeString("name") << endl;
-  cout << "The lanalysis size is " << lanalysis.size() << endl;
-  for(unsigned int i = 0;i < lanalysis.size(); i++){
-    ListXmlTag lsub = lanalysis[i].searchChildren("NODE");
-    for(unsigned int j = 0;j < lsub.size();j++){
-      ListXmlTag linr = lsub[j].searchChildren("INSTRUCTION"); 
-      for(unsigned int k = 0; k < linr.size();k++){
-        ListXmlTag linc = linr[k].searchChildren("ATTRS_LIST");
-        bool isExistAH = false;
-        for(unsigned int t = 0; t < linc.size();t++){
-          ListXmlTag lind = linc[t].searchChildren("ATTR");
-          for(unsigned int d = 0; d < lind.size();d++){
-             if(lind[d].getAttributeString("type") == "string"
-               && lind[d].getAttributeString("name").find("CACL2") != string::npos
-               && (lind[d].getAttributeString("value") == "A"
-               || lind[d].getAttributeString("value") == "U"
-               || lind[d].getAttributeString("value") == "UN")){
-                isExistAH = true;
-                tmp.CACvalue = lind[d].getAttributeString("value");
-               // cout << "The AH information is " << lind[d].getAttributeString("value") << endl;        
-               
-             }
-             
-            }
-         
-          if(isExistAH && (lind[0].getAttributeString("type") == "string" ||
-          lind[1].getAttributeString("type") == "string")){
-            ListXmlTag laccess = lind[lind.size() - 1].searchChildren("ACCES");
-            ListXmlTag laddrsize = laccess[0].searchChildren("ADDRSIZE");
-            tmp.address = laddrsize[0].getAttributeHexa("begin");
-            tmp.cacheset = computeSet(laddrsize[0].getAttributeHexa("begin"));
-            cb.push_back(tmp);
-          }
-          
-        }
-      }
-    
-    }
-  
-    ListXmlTag lloop =  lanalysis[i].searchChildren("LOOP");
-    if(!lloop.empty()){
-      for(unsigned int it = 0;it < lloop.size();it++){
-        string slloop = lloop[it].getAttributeString("nodes"); 
-        cout << "lloop is " << slloop << endl;
-        vector<string> lnodes;
-        string tmpNode= "";
-        for(unsigned int il = 0; il < slloop.size();il++){ 
-            if(slloop[il] == ','){
-                lnodes.push_back(tmpNode);
-                tmpNode="";
-            }
-            if(slloop[il] >= '0' && slloop[il] <= '9'){       
-             tmpNode += slloop[il];
-            }
-           
-        }
-        for(auto cc : lnodes) cout << "node: " << cc << endl;
-        ListXmlTag lattrl = lloop[it].searchChildren("ATTRS_LIST");
-        ListXmlTag lattr = lattrl[0].searchChildren("ATTR");
-        int maxiter = lattr[0].getAttributeInt("value");
-        cout << "maxiter: " << maxiter << endl;
-
-        for(auto CertainNode : lnodes){
-          for(unsigned int ii = 0; ii < lanalysis.size();ii++){
-              ListXmlTag lsub = lanalysis[ii].searchChildren("NODE");
-              for(unsigned int j = 0;j < lsub.size();j++){
-                if(lsub[j].getAttributeString("id") == CertainNode){
-                  ListXmlTag linr = lsub[j].searchChildren("INSTRUCTION");
-                  for(unsigned int k = 0; k < linr.size();k++){
-                    ListXmlTag linc = linr[k].searchChildren("ATTRS_LIST");
-                    bool isExistAH = false;
-                    for(unsigned int t = 0; t < linc.size();t++){
-                      //cout << "The name is " << linc[t].getName() << endl;
-                      ListXmlTag lind = linc[t].searchChildren("ATTR");
-                      for(unsigned int d = 0; d < lind.size();d++){
-                      if(lind[d].getAttributeString("type") == "string"
-                        && lind[d].getAttributeString("name").find("CACL2") != string::npos
-                        && (lind[d].getAttributeString("value") == "A"
-                        || lind[d].getAttributeString("value") == "U"
-                        || lind[d].getAttributeString("value") == "UN")){
-                        isExistAH = true;
-                        tmp.CACvalue = lind[d].getAttributeString("value");        
-                    }   
-                  }        
-                      if(isExistAH && (lind[0].getAttributeString("type") == "string" ||
-                        lind[1].getAttributeString("type") == "string")){
-                        ListXmlTag laccess = lind[lind.size() - 1].searchChildren("ACCES");
-                        ListXmlTag laddrsize = laccess[0].searchChildren("ADDRSIZE");
-                        tmp.address = laddrsize[0].getAttributeHexa("begin");
-                        tmp.cacheset = computeSet(laddrsize[0].getAttributeHexa("begin"));
-                        for(int iit = 1;iit < maxiter;iit++){
-                          //cout << "***********777" << endl;
-                          cb.push_back(tmp);
-                        } 
-                      }
-          
-                    }
-                  } 
-                }   
-              }
-            }
-        }
-
-
-       
-        
-      }
-     
-
-
-  }
-   
-
-  }
-  
-  return cb;
-}
-
-
-Config::CacheInfo Config::CacheInfoStasticstic(string xml_file){
-  cout << "xml_file is " << xml_file << endl;
-  XmlDocument xmldoc(xml_file);
-  //xmlDocPtr xmlDocP = (*xmlDocPtr)xmldoc;
-  ListXmlTag lt;
-  lt = xmldoc.searchChildren("PROGRAM");
-  ListXmlTag lanalysis = lt[0].getAllChildren();
-  cout << lanalysis[0].getAttributeString("name") << endl;
-  cout << "The lanalysis size is " << lanalysis.size() << endl;
-  Config::CacheInfo tmp{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};
-  for(unsigned int i = 0;i < lanalysis.size(); i++){
-    //lanalysis[i].print();
-    
-    ListXmlTag lsub = lanalysis[i].searchChildren("NODE");
-    for(unsigned int j = 0;j < lsub.size();j++){
-      // INSTRUCTION
-      //lsub[j].print();
-      // ATTRS_LIST
-      ListXmlTag linr = lsub[j].searchChildren("INSTRUCTION");
-      
-      for(unsigned int k = 0; k < linr.size();k++){
-        // ATTR
-        //linr[k].print();
-        ListXmlTag linc = linr[k].searchChildren("ATTRS_LIST");
-        for(unsigned int t = 0; t < linc.size();t++){
-          //cout << "The name is " << linc[t].getName() << endl;
-          ListXmlTag lind = linc[t].searchChildren("ATTR");
-            for(unsigned int d = 0; d < lind.size();d++){
-             if(lind[d].getAttributeString("type") == "string"){
-              if(lind[d].getAttributeString("name").find("CACL1") != string::npos){
-                if(lind[d].getAttributeString("value") == "A") tmp.numberofCACAttrL1A++;
-                else if(lind[d].getAttributeString("value") == "U") tmp.numberofCACAttrL1U++;
-                else if(lind[d].getAttributeString("value") == "N") tmp.numberofCACAttrL1N++;
-                else if(lind[d].getAttributeString("value") == "UN") tmp.numberofCACAttrL1UN++;       
-               
-             }
-             else if(lind[d].getAttributeString("name").find("CACL2") != string::npos){
-                if(lind[d].getAttributeString("value") == "A") tmp.numberofCACAttrL2A++;
-                else if(lind[d].getAttributeString("value") == "U") tmp.numberofCACAttrL2U++;
-                else if(lind[d].getAttributeString("value") == "N") tmp.numberofCACAttrL2N++;
-                else if(lind[d].getAttributeString("value") == "UN") tmp.numberofCACAttrL2UN++;
-
-              }
-            else if(lind[d].getAttributeString("name").find("CHMCL1") != string::npos){
-                if(lind[d].getAttributeString("value") == "AH") tmp.numberofCHMCL1AH++;
-                else if(lind[d].getAttributeString("value") == "AU") tmp.numberofCHMCL1AU++;
-                else if(lind[d].getAttributeString("value") == "AM") tmp.numberofCHMCL1AM++;
-                else if(lind[d].getAttributeString("value") == "NC") tmp.numberofCHMCL1NC++;
-                else if(lind[d].getAttributeString("value") == "FM") tmp.numberofCHMCL1FM++;
-
-              } 
-            else if(lind[d].getAttributeString("name").find("CHMCL2") != string::npos){
-                if(lind[d].getAttributeString("value") == "AH") tmp.numberofCHMCL2AH++;
-                else if(lind[d].getAttributeString("value") == "AU") tmp.numberofCHMCL2AU++;
-                else if(lind[d].getAttributeString("value") == "AM") tmp.numberofCHMCL2AM++;
-                else if(lind[d].getAttributeString("value") == "NC") tmp.numberofCHMCL2NC++;
-                else if(lind[d].getAttributeString("value") == "FM") tmp.numberofCHMCL2FM++;
-                
-              }          
-            }      
-          }   
-        }
-      }
-    }
-  }
-  return tmp;
-}
-
-
-
-
-
 
 // -------------------------------------------
 //
@@ -1075,6 +1005,10 @@ ParamAnalysis::ParamAnalysis (XmlTag const &tag)
   this->output_file = tag.getAttributeString ("output_file");
   string keep_s = tag.getAttributeString ("keepresults");
   this->keep_results = (keep_s == ON);
+  // Format of the output file, the format of the input file is recognised when it is read
+  string format_s = tag.getAttributeString ("format");
+  if (format_s != "" && format_s != "xml" && format_s != "bin") Logger::addFatal ("Config: format must be xml or bin");
+  this->binary_format = (format_s == "bin");
 }
 
 ParamAnalysis::~ParamAnalysis ()
@@ -1160,6 +1094,27 @@ ParamICache::ParamICache (XmlTag const &tag):
   if (s == "") s = "off";
   assert (s == "on" || s == "off");
   this->keep_age = (s == "on");
+
+  // optional, number of threads analysing groups of cache sets in parallel (sequential analysis by default)
+  this->nb_threads = tag.getAttributeInt ("threads");
+  if (this->nb_threads < 1) this->nb_threads = 1;
+
+  // optional, contexts="summary": the functions are analysed once per entry cache state
+  // instead of once per context, with call strings bounded to callstring calls if set
+  s = tag.getAttributeString ("contexts");
+  if (s == "") s = "full";
+  if (s != "full" && s != "summary")
+    Logger::addFatal ("Config: ICACHE contexts should be full or summary");
+  this->summary = (s == "summary");
+
+  this->callstring_depth = -1;
+  s = tag.getAttributeString ("callstring");
+  if (s != "")
+    {
+      this->callstring_depth = tag.getAttributeInt ("callstring");
+      if (this->callstring_depth < 0 || !this->summary)
+	Logger::addFatal ("Config: ICACHE callstring should be a call string depth (>= 0), in the summary mode");
+    }
 }
 
 ParamDCache::ParamDCache (XmlTag const &tag):
@@ -1179,6 +1134,26 @@ ParamDCache::ParamDCache (XmlTag const &tag):
   s = tag.getAttributeString ("may");
   assert (s == "on" || s == "off");
   this->apply_may = (s == "on");
+
+  // optional, number of threads analysing groups of cache sets in parallel (sequential analysis by default)
+  this->nb_threads = tag.getAttributeInt ("threads");
+  if (this->nb_threads < 1) this->nb_threads = 1;
+
+  // optional, contexts="summary": as for ICACHE
+  s = tag.getAttributeString ("contexts");
+  if (s == "") s = "full";
+  if (s != "full" && s != "summary")
+    Logger::addFatal ("Config: DCACHE contexts should be full or summary");
+  this->summary = (s == "summary");
+
+  this->callstring_depth = -1;
+  s = tag.getAttributeString ("callstring");
+  if (s != "")
+    {
+      this->callstring_depth = tag.getAttributeInt ("callstring");
+      if (this->callstring_depth < 0 || !this->summary)
+	Logger::addFatal ("Config: DCACHE callstring should be a call string depth (>= 0), in the summary mode");
+    }
 }
 
 // Data address extraction
@@ -1211,9 +1186,11 @@ ParamIPET::ParamIPET (XmlTag const &tag):
   this->generate_node_freq = (s == ON);
 
   s = tag.getAttributeString ("solver");
-  assert (s == "cplex" || s == "lp_solve");
+  assert (s == "cplex" || s == "lp_solve" || s == "simplex");
   if (s == "cplex")
     this->solver = CPLEX;
+  else if (s == "simplex")
+    this->solver = SIMPLEX;
   else
     this->solver = LP_SOLVE;
 
@@ -1240,6 +1217,24 @@ ParamCacheStatistics::ParamCacheStatistics (XmlTag const &tag):
 }
 
 
+// Inter-task cache interference
+// --------------------------------------
+ParamInterference::ParamInterference (XmlTag const &tag):
+  ParamAnalysis (tag)
+{
+  // level="" stands for the last cache level
+  string s = tag.getAttributeString ("level");
+  this->level = (s == "") ? 0 : tag.getAttributeInt ("level");
+  assert (level >= 0 && level <= NB_MAX_CACHE_LEVEL);
+
+  this->task = tag.getAttributeString ("task");
+  this->interfering_file = tag.getAttributeString ("interfering_file");
+  this->evicted_file = tag.getAttributeString ("evicted_file");
+  this->statistics_file = tag.getAttributeString ("statistics_file");
+  this->footprint_file = tag.getAttributeString ("footprint_file");
+}
+
+
 // DummyAnalysis
 // --------------------------------------
 ParamDummyAnalysis::ParamDummyAnalysis (XmlTag const &tag):
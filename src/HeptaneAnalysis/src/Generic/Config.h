@@ -51,6 +51,7 @@ using namespace cfglib;
 /** Solver */
 #define LP_SOLVE 0
 #define CPLEX 1
+#define SIMPLEX 2
 
 /** Supported architectures */
 
@@ -79,8 +80,9 @@ public:
   t_replacement_policy replacement_policy;
   t_cache_type type;
   int latency;
+  bool unified;			///< code and data share this cache (unified="on" on the icache and dcache of the level)
 public:
-    CacheParam ()
+    CacheParam ():unified (false)
   {;
   }
   CacheParam (XmlTag const &tag);
@@ -127,6 +129,7 @@ private:
 
   string arch_name; ///< architecture name (MIPS or ARM)
   Program *p;
+  string program_file; ///< input file of the analyzed program
   string entrypoint;
   int IPET_method_Applied;
   int MaxLevelCacheAnalysis; // the max level of the ICacheAnalysis, DCacheAnalysis (useful for cleaning the shared attributes)
@@ -134,45 +137,32 @@ private:
   
 
 public:
-struct HB{
-  int cacheset;
-  long address;
-  string CHMCValue;
-} hb;
-
-struct CB{
-  int cacheset;
-  long address;
-  string CACvalue;
-} cb;
-
-struct CacheInfo{
-  int numberofCACAttrL1A;
-  int numberofCACAttrL1N;
-  int numberofCACAttrL1U;
-  int numberofCACAttrL1UN;
-
-  int numberofCHMCL1AH;
-  int numberofCHMCL1AU;
-  int numberofCHMCL1AM;
-  int numberofCHMCL1NC;
-  int numberofCHMCL1FM;
-
-  int numberofCACAttrL2A;
-  int numberofCACAttrL2N;
-  int numberofCACAttrL2U;
-  int numberofCACAttrL2UN;
-
-  int numberofCHMCL2AH;
-  int numberofCHMCL2AU;
-  int numberofCHMCL2AM;
-  int numberofCHMCL2NC;
-  int numberofCHMCL2FM;
-} cacheInfo;
 
   /// Analyzed program location
   string input_output_dir;
 
+  /// Co-running task given on the command line, used by default by INTERFERENCE
+  string interfering_task;
+
+  /// Name and duration (seconds) of every analysis step applied by ExecuteFromXml
+  vector < pair < string, float > > pass_times;
+
+  /// WCET attached to the entry point by the last IPET step, "" if none
+  string wcet;
+
+  /// Append the analysis time and the WCET to the shared text files (turned off by the batch mode)
+  bool shared_logs;
+
+  /// Shared text files of the WCETs and of the analysis times (SHAREDLOGS tag), "" if none
+  string shared_wcet_file, shared_time_file;
+
+  /// Directory (with its final '/') against which a relative INPUTOUTPUTDIR is resolved,
+  /// "" for the current directory (set by the batch sessions, which cannot change it)
+  string config_dir;
+
+  /** path, relative to config_dir when it is a relative path */
+  string inConfigDir (const string & path);
+
 
   /** Constructors - simply sets up the analysis parameters to their default values (architecture, analyses). */
     Config ();
@@ -189,27 +179,6 @@ struct CacheInfo{
   /** Execute the analyses as specified in the given configuration file */
   void ExecuteFromXml (string xml_file, bool printTime);
 
-  /** Generate the HB block table*/
-  vector<HB> GenerateIcacheHB(string xml_file);
-
-  /** Generate the CB block table*/
-  vector<CB> GenerateIcacheCB(string xml_file);
-
-  /** */
-  CacheInfo CacheInfoStasticstic(string xml_file);
-
-
-    /** Generate the HB block table*/
-  void GenerateDcacheL1HB(string xml_file);
-
-  /** Generate the CB block table*/
-  void GenerateDcacheL1CB(string xml_file);
-
-      /** Generate the HB block table*/
-  void GenerateDcacheL2HB(string xml_file);
-
-  /** Generate the CB block table*/
-  void GenerateDcacheL2CB(string xml_file);
   
 
   /** TO BE REVISISTED
@@ -243,11 +212,22 @@ private:
   /** Get cache Configuration at a given cache level */
   CacheParam * GetCacheAtLevel (int level, t_cache_type type);
 
+  /** Checks that a unified cache is declared as an icache and a dcache of the same level
+      and geometry, both with unified="on". A fatal error is emitted otherwise. */
+  void CheckUnifiedCaches ();
+
   /** @return the parameters associated with a directive (directive ::= Printers | anaylsis ).
       When the analysis is unknown, a fatal error is emitted.
   */
   ParamAnalysis * getParameters(string directive, string input_output_dir, XmlTag analysis);
 
+  /** Loads the input file of pa and/or sets the entry point (ENTRYPOINT, ep is updated), then computes the contexts. */
+  void SetupProgram (string analysis_name, ParamAnalysis * pa, string & ep);
+
+  /** Cache configuration sweep: the cache independent analyses of ltanalysis are applied once, the cache
+      dependent ones for every POINT of the sweep tag, the WCETs being written in its result_file. */
+  void ExecuteSweep (XmlTag const &sweep, ListXmlTag & ltanalysis, bool printTime);
+
   /** @return the specific analyzer object associated with the directive ( directive ::= Printers | anaylsis ).
       When the analysis is unknown, a fatal error is emitted.
   */
@@ -255,8 +235,8 @@ private:
 
 };
 
-// Externals: pointer on configuration (global)
-extern Config *config;
+// NB: there is no global configuration, every AnalysisSession owns its own
+// (see Analysis::getConfig).
 
 
 // -------------------------------------------------------
@@ -274,6 +254,7 @@ public:
   string input_file;
   string output_file;
   bool keep_results;
+  bool binary_format; ///< output_file written in the binary format (format="bin")
     ParamAnalysis ();
     ParamAnalysis (XmlTag const &tag);
    ~ParamAnalysis ();
@@ -323,6 +304,9 @@ class ParamICache:public ParamAnalysis
 public:
   int level;
   bool apply_must, apply_persistence, apply_may, keep_age;
+  int nb_threads;
+  bool summary;
+  int callstring_depth;
     ParamICache (XmlTag const &tag);
 };
 class ParamDCache:public ParamAnalysis
@@ -330,6 +314,9 @@ class ParamDCache:public ParamAnalysis
 public:
   int level;
   bool apply_must, apply_persistence, apply_may;
+  int nb_threads;
+  bool summary;
+  int callstring_depth;
     ParamDCache (XmlTag const &tag);
 };
 
@@ -379,6 +366,20 @@ public:
   ParamCacheStatistics (XmlTag const &tag);
 };
 
+// Inter-task cache interference
+// --------------------------------------
+class ParamInterference:public ParamAnalysis
+{
+public:
+  int level;
+  string task;
+  string interfering_file;
+  string evicted_file;
+  string statistics_file;
+  string footprint_file;
+  ParamInterference (XmlTag const &tag);
+};
+
 // DummyAnalysis
 // --------------------------------------
 class ParamDummyAnalysis:public ParamAnalysis
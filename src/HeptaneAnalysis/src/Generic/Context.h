@@ -59,7 +59,7 @@
 #include <ostream>
 
 #include "CfgLib.h"
-#include "Generic/cow_ptr.h"
+#include "cow_ptr.h"
 
 using namespace cfglib;
 
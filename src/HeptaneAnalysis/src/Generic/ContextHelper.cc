@@ -36,6 +36,49 @@ context (context), node (node)
 {
 }
 
+ContextualAttributeKeys::ContextualAttributeKeys (const string & prefix):
+prefix (prefix)
+{
+}
+
+AttributeKey ContextualAttributeKeys::intern (const Context * context)
+{
+  context_id id = context->getId ();
+  if (id >= keys.size ())
+    keys.resize (id + 1);
+  keys[id] = AttributeKey (prefix + context->getStringId ());
+  return keys[id];
+}
+
+void ContextualAttributeKeys::internAll (const ContextTree & tree)
+{
+  for (context_id id = 0; id < tree.getContextsCount (); id++)
+    get (tree.getContext (id));
+}
+
+ContextualNodeIndex::ContextualNodeIndex ():
+count (0)
+{
+}
+
+void ContextualNodeIndex::build (const ContextTree & tree)
+{
+  base.assign (tree.getContextsCount (), 0);
+  local.clear ();
+  count = 0;
+  for (context_id id = 0; id < tree.getContextsCount (); id++)
+    {
+      Cfg *function = tree.getContext (id)->getCurrentFunction ();
+      vector < Node * >nodes = function->GetAllNodes ();
+      base[id] = count;
+      for (size_t i = 0; i < nodes.size (); i++)
+	{
+	  local[nodes[i]] = i;
+	}
+      count += nodes.size ();
+    }
+}
+
 bool AreElemOfSameCfg(const ContextualNode &n1, const ContextualNode &n2)
 {
   return (n1.node->GetCfg () ==  n2.node->GetCfg ());
@@ -31,6 +31,8 @@
 
 #include <functional>
 #include <stack>
+#include <unordered_map>
+#include <assert.h>
 
 #include "Generic/Context.h"
 
@@ -60,6 +62,89 @@ Context * getContext()
 
 };
 
+/**
+ * \class ContextualAttributeKeys
+ * \brief Interned names of a contextual attribute, one per context.
+ *
+ * The name of the attribute in a context is the prefix followed by the
+ * context string id (e.g. "ACSMUST_in" + id, or
+ * AnalysisHelper::mkContextAttrName(attr, "") + id). It is interned the
+ * first time the context is met and cached by context id, so that the
+ * fixed point computations access contextual attributes without building
+ * their names.
+ */
+class ContextualAttributeKeys
+{
+public:
+  /** Constructor. */
+  explicit ContextualAttributeKeys (const string & prefix);
+
+  /** @return the key of the attribute in context. */
+  AttributeKey get (const Context * context)
+  {
+    context_id id = context->getId ();
+    if (id >= keys.size () || !keys[id].IsValid ())
+      return intern (context);
+    return keys[id];
+  }
+
+  /** Interns the names of the attribute in all the contexts of tree, so that get
+      does not modify the keys (e.g. when called by several threads). */
+  void internAll (const ContextTree & tree);
+
+private:
+  string prefix;
+  std::vector < AttributeKey > keys;
+
+  AttributeKey intern (const Context * context);
+};
+
+/**
+ * \class ContextualNodeIndex
+ * \brief Dense numbering of the contextual nodes of a program.
+ *
+ * Built once from the context tree: the nodes of the function of a context
+ * are numbered consecutively, from a base index per context, in the order
+ * of Cfg::GetAllNodes. Used to keep per contextual node data in flat vectors
+ * instead of contextual attributes.
+ */
+class ContextualNodeIndex
+{
+public:
+  /** Constructor (empty numbering). */
+  ContextualNodeIndex ();
+
+  /** Numbers the contextual nodes of all the contexts of tree. */
+  void build (const ContextTree & tree);
+
+  /** @return the number of contextual nodes. */
+  size_t size () const
+  {
+    return count;
+  }
+
+  /** @return the index of a contextual node, in [0, size()[. */
+  size_t get (const ContextualNode & cn) const
+  {
+    std::unordered_map < Node *, size_t >::const_iterator it = local.find (cn.node);
+    assert (it != local.end () && cn.context->getId () < base.size ());
+    return base[cn.context->getId ()] + it->second;
+  }
+
+  /** @return the index of a node in its cfg, in the order of Cfg::GetAllNodes. */
+  size_t getLocal (Node * node) const
+  {
+    std::unordered_map < Node *, size_t >::const_iterator it = local.find (node);
+    assert (it != local.end ());
+    return it->second;
+  }
+
+private:
+  std::vector < size_t > base;	///< first index of the nodes of every context, by context id
+  std::unordered_map < Node *, size_t > local;	///< index of every node in its cfg
+  size_t count;
+};
+
 /** ContextualNode relational operators. */
 inline bool operator== (const ContextualNode &, const ContextualNode &);
 inline bool operator!= (const ContextualNode &, const ContextualNode &);
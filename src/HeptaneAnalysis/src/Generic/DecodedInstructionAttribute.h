@@ -0,0 +1,59 @@
+/* ---------------------------------------------------------------------
+
+   Copyright IRISA, 2003-2017
+
+   This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+   estimation.
+   APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+   Heptane is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Heptane is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details (COPYING.txt).
+
+   See CREDITS.txt for credits of authorship
+
+   ------------------------------------------------------------------------ */
+
+#ifndef DECODED_INSTRUCTION_ATTRIBUTE_H
+#define DECODED_INSTRUCTION_ATTRIBUTE_H
+
+#include "CfgLib.h"
+#include "arch.h"
+
+using namespace cfglib;
+
+/**
+ * Decoded form of the asm code of an instruction (see Arch::decode), attached
+ * to every code instruction when the program is loaded (AnalysisHelper::decodeInstructions).
+ * The record belongs to the architecture and is shared by the clones of the attribute.
+ */
+class DecodedInstructionAttribute:public NonSerialisableAttribute
+{
+ public:
+  const DecodedInstruction *decoded;
+
+  /** Constructor */
+  DecodedInstructionAttribute (const DecodedInstruction * d):decoded (d)
+  {
+  }
+
+  /** Cloning function */
+  DecodedInstructionAttribute *clone ()
+  {
+    return new DecodedInstructionAttribute (decoded);
+  }
+
+  /** Printing function */
+  void Print (std::ostream & os)
+  {
+    os << "(type NonSerialisable DecodedInstructionAttribute, name " << name << ", code " << decoded->code << ")";
+  }
+};
+
+#endif
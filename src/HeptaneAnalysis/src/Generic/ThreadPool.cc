@@ -0,0 +1,107 @@
+/* ---------------------------------------------------------------------
+
+   Copyright IRISA, 2003-2017
+
+   This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+   estimation.
+   APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+   Heptane is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Heptane is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details (COPYING.txt).
+
+   See CREDITS.txt for credits of authorship
+
+   ------------------------------------------------------------------------ */
+
+#include <cassert>
+
+#include "Generic/ThreadPool.h"
+#include "Generic/AnalysisSession.h"
+
+using namespace std;
+
+ThreadPool::ThreadPool (unsigned int nbThreads):task (NULL), nbTasks (0), next (0), nbRunning (0), stop (false), failed (false)
+{
+  session = AnalysisSession::current ();
+  assert (nbThreads > 0);
+  for (unsigned int i = 0; i < nbThreads; i++)
+    {
+      workers.push_back (thread (&ThreadPool::work, this));
+    }
+}
+
+ThreadPool::~ThreadPool ()
+{
+  {
+    unique_lock < mutex > guard (lock);
+    stop = true;
+  }
+  wakeup.notify_all ();
+  for (size_t i = 0; i < workers.size (); i++)
+    {
+      workers[i].join ();
+    }
+}
+
+void
+ThreadPool::run (ParallelTask & t, size_t n)
+{
+  unique_lock < mutex > guard (lock);
+  assert (task == NULL);
+  task = &t;
+  nbTasks = n;
+  next = 0;
+  nbRunning = 0;
+  failed = false;
+  wakeup.notify_all ();
+  while (next < nbTasks || nbRunning > 0)
+    {
+      done.wait (guard);
+    }
+  task = NULL;
+  if (failed) throw error;
+}
+
+void
+ThreadPool::work ()
+{
+  AnalysisSession::Binding *binding = (session != NULL) ? new AnalysisSession::Binding (session) : NULL;
+  unique_lock < mutex > guard (lock);
+  while (true)
+    {
+      while (!stop && (task == NULL || next >= nbTasks))
+	{
+	  wakeup.wait (guard);
+	}
+      if (stop) break;
+
+      size_t i = next++;
+      nbRunning++;
+      ParallelTask *current = task;
+      guard.unlock ();
+      try
+	{
+	  current->execute (i);
+	  guard.lock ();
+	}
+      catch (std::string const &e)
+	{
+	  // The remaining tasks are not started
+	  guard.lock ();
+	  if (!failed) error = e;
+	  failed = true;
+	  next = nbTasks;
+	}
+      nbRunning--;
+      if (next >= nbTasks && nbRunning == 0) done.notify_all ();
+    }
+  guard.unlock ();
+  delete binding;
+}
@@ -0,0 +1,97 @@
+/* ---------------------------------------------------------------------
+
+   Copyright IRISA, 2003-2017
+
+   This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+   estimation.
+   APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+   Heptane is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Heptane is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details (COPYING.txt).
+
+   See CREDITS.txt for credits of authorship
+
+   ------------------------------------------------------------------------ */
+
+/**
+ * \brief Fixed-size pool of worker threads running independent tasks.
+ *
+ * The program representation (attributes, contexts, abstract cache sets
+ * shared by copy-on-write) is not thread-safe: a task may only read the
+ * shared data, and must write to data of its own.
+ *
+ * The worker threads are bound to the analysis session of the thread which
+ * creates the pool (see AnalysisSession). A fatal error raised by a task
+ * (Logger::addFatal in a session) is raised again by run.
+ */
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <string>
+
+class AnalysisSession;
+
+/**
+ * \class ParallelTask
+ * \brief Set of independent tasks, numbered from 0, run by a ThreadPool.
+ */
+class ParallelTask
+{
+public:
+  virtual ~ParallelTask ()
+  {
+  }
+
+  /** Runs the task number i. */
+  virtual void execute (size_t i) = 0;
+};
+
+/**
+ * \class ThreadPool
+ */
+class ThreadPool
+{
+public:
+  /** Constructor: starts nbThreads worker threads. */
+  ThreadPool (unsigned int nbThreads);
+
+  /** Destructor: stops the worker threads. */
+  ~ThreadPool ();
+
+  /** Runs the tasks 0 .. nbTasks-1 of task on the worker threads, and waits for their completion. */
+  void run (ParallelTask & task, size_t nbTasks);
+
+  /** @return the number of worker threads. */
+  unsigned int getNbThreads () const
+  {
+    return workers.size ();
+  }
+
+private:
+  std::vector < std::thread > workers;
+  std::mutex lock;
+  std::condition_variable wakeup;	///< signaled when tasks are submitted, or on stop
+  std::condition_variable done;	///< signaled when the last task completes
+  ParallelTask *task;		///< tasks being run, NULL if none
+  size_t nbTasks, next, nbRunning;	///< number of tasks, next task to start, number of tasks started and not completed
+  bool stop;
+  AnalysisSession *session;	///< session of the worker threads, NULL if none
+  bool failed;			///< a task raised error
+  std::string error;
+
+  /** Body of the worker threads. */
+  void work ();
+};
+
+#endif
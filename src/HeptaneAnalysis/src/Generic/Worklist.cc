@@ -0,0 +1,217 @@
+/* ---------------------------------------------------------------------
+
+   Copyright IRISA, 2003-2017
+
+   This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+   estimation.
+   APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+   Heptane is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Heptane is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details (COPYING.txt).
+
+   See CREDITS.txt for credits of authorship
+
+   ------------------------------------------------------------------------ */
+
+#include <algorithm>
+
+#include "Generic/Worklist.h"
+
+using namespace std;
+
+// ---------------------------------------------------
+// ContextualNodeOrder
+// ---------------------------------------------------
+
+ContextualNodeOrder::ContextualNodeOrder ():index (NULL)
+{
+}
+
+/** Sets innermost[n] to the innermost loop of every node n of function inside a loop. */
+static void
+computeInnermostLoops (Cfg * function, unordered_map < Node *, Loop * >&innermost)
+{
+  vector < Loop * >loops = function->GetAllLoops ();
+  for (size_t l = 0; l < loops.size (); l++)
+    {
+      vector < Node * >nodes = loops[l]->GetAllNodes ();
+      for (size_t i = 0; i < nodes.size (); i++)
+	{
+	  Loop * &current = innermost[nodes[i]];
+	  if (current == NULL || loops[l]->IsNestedIn (current)) current = loops[l];
+	}
+    }
+}
+
+/** True for the contextual nodes of the function of loop which are outside of loop */
+class LeavesLoop
+{
+public:
+  Loop * loop;
+  Cfg *function;
+  LeavesLoop (Loop * l, Cfg * f):loop (l), function (f) {}
+  bool operator () (const ContextualNode & s) const
+  {
+    return s.node->GetCfg () == function && !loop->FindInLoop (s.node);
+  }
+};
+
+/** @return the successors of cn, the ones leaving the innermost loop of cn first. */
+static vector < ContextualNode >
+getOrderedSuccessors (const ContextualNode & cn, const unordered_map < Node *, Loop * >&innermost)
+{
+  vector < ContextualNode > succ = GetContextualSuccessors (cn);
+  unordered_map < Node *, Loop * >::const_iterator it = innermost.find (cn.node);
+  if (it != innermost.end () && succ.size () > 1)
+    {
+      stable_partition (succ.begin (), succ.end (), LeavesLoop (it->second, cn.node->GetCfg ()));
+    }
+  return succ;
+}
+
+void
+ContextualNodeOrder::traverse (const ContextualNode & start, vector < bool > &visited, const unordered_map < Node *, Loop * >&innermost)
+{
+  // Iterative depth-first traversal: (node, successors, next successor to visit)
+  struct Frame
+  {
+    ContextualNode cn;
+    vector < ContextualNode > succ;
+    size_t next;
+    Frame (const ContextualNode & n, const vector < ContextualNode > &s):cn (n), succ (s), next (0) {}
+  };
+  vector < Frame > stack;
+  vector < ContextualNode > postorder;
+
+  visited[index->get (start)] = true;
+  stack.push_back (Frame (start, getOrderedSuccessors (start, innermost)));
+  while (!stack.empty ())
+    {
+      Frame & top = stack.back ();
+      if (top.next < top.succ.size ())
+	{
+	  ContextualNode s = top.succ[top.next++];
+	  size_t i = index->get (s);
+	  if (!visited[i])
+	    {
+	      visited[i] = true;
+	      stack.push_back (Frame (s, getOrderedSuccessors (s, innermost)));
+	    }
+	}
+      else
+	{
+	  postorder.push_back (top.cn);
+	  stack.pop_back ();
+	}
+    }
+
+  for (size_t i = postorder.size (); i > 0; i--)
+    {
+      rank[index->get (postorder[i - 1])] = nodes.size ();
+      nodes.push_back (postorder[i - 1]);
+    }
+}
+
+void
+ContextualNodeOrder::build (const ContextTree & tree, const ContextualNodeIndex & idx, const ContextualNode & entry)
+{
+  index = &idx;
+  rank.assign (idx.size (), 0);
+  nodes.clear ();
+  nodes.reserve (idx.size ());
+
+  unordered_map < Node *, Loop * >innermost;
+  set < Cfg * >functions;
+  for (context_id id = 0; id < tree.getContextsCount (); id++)
+    {
+      Cfg *function = tree.getContext (id)->getCurrentFunction ();
+      if (functions.insert (function).second) computeInnermostLoops (function, innermost);
+    }
+
+  vector < bool > visited (idx.size (), false);
+  traverse (entry, visited, innermost);
+
+  // Nodes not reachable from the entry node
+  for (context_id id = 0; id < tree.getContextsCount (); id++)
+    {
+      Context *context = tree.getContext (id);
+      vector < Node * >fnodes = context->getCurrentFunction ()->GetAllNodes ();
+      for (size_t i = 0; i < fnodes.size (); i++)
+	{
+	  ContextualNode cn (context, fnodes[i]);
+	  if (!visited[idx.get (cn)]) traverse (cn, visited, innermost);
+	}
+    }
+}
+
+// ---------------------------------------------------
+// Worklist
+// ---------------------------------------------------
+
+Worklist::Worklist (const ContextualNodeOrder & o):order (o), nbInEvaluations (0), nbOutEvaluations (0)
+{
+}
+
+void
+Worklist::push (size_t r)
+{
+  if (!queued[r])
+    {
+      queued[r] = true;
+      queue.push (r);
+    }
+}
+
+void
+Worklist::solve (WorklistClient & client, const set < ContextualNode > &start, bool visitAll)
+{
+  queued.assign (order.size (), false);
+  vector < bool > visited (order.size (), false);
+  vector < bool > skipIn (order.size (), false);	// start nodes, whose output state is computed first
+
+  for (set < ContextualNode >::const_iterator it = start.begin (); it != start.end (); it++)
+    {
+      size_t r = order.getRank (order.getIndex (*it));
+      skipIn[r] = true;
+      push (r);
+    }
+
+  while (!queue.empty ())
+    {
+      size_t r = queue.top ();
+      queue.pop ();
+      queued[r] = false;
+      const ContextualNode & cn = order.getNode (r);
+
+      bool update = true;
+      if (skipIn[r])
+	{
+	  skipIn[r] = false;
+	}
+      else
+	{
+	  nbInEvaluations++;
+	  update = client.updateIn (cn) || (visitAll && !visited[r]);
+	}
+      if (!update) continue;
+
+      nbOutEvaluations++;
+      bool changed = client.updateOut (cn) || (visitAll && !visited[r]);
+      visited[r] = true;
+      if (!changed) continue;
+
+      vector < ContextualNode > succ = GetContextualSuccessors (cn);
+      client.addDependents (cn, succ);
+      for (size_t i = 0; i < succ.size (); i++)
+	{
+	  if (client.followEdge (cn, succ[i])) push (order.getRank (order.getIndex (succ[i])));
+	}
+    }
+}
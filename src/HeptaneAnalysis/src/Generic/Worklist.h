@@ -0,0 +1,176 @@
+/* ---------------------------------------------------------------------
+
+   Copyright IRISA, 2003-2017
+
+   This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+   estimation.
+   APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+   Heptane is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Heptane is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details (COPYING.txt).
+
+   See CREDITS.txt for credits of authorship
+
+   ------------------------------------------------------------------------ */
+
+/**
+ * \brief Worklist resolution of the forward data-flow analyses on contextual nodes.
+ *
+ * The fixed point computations (cache analyses, address analysis) share the
+ * same scheme: the input state of a node is the join of the output states of
+ * its predecessors, and its output state is computed from its input state.
+ * The Worklist processes the nodes by increasing rank in a reverse postorder
+ * of the contextual graph where the loop bodies are numbered before the loop
+ * exits, so that the inner loops are stabilised before their successors are
+ * evaluated.
+ */
+#ifndef WORKLIST_H
+#define WORKLIST_H
+
+#include <vector>
+#include <set>
+#include <queue>
+
+#include "Generic/ContextHelper.h"
+
+/**
+ * \class ContextualNodeOrder
+ * \brief Loop-nesting aware reverse postorder of the contextual nodes of a program.
+ *
+ * The depth-first traversal starts from the entry node and visits the
+ * successors leaving the innermost loop of a node before the other ones, so
+ * that a loop body gets the ranks following its head. The nodes not reached
+ * from the entry node are ranked after the others.
+ */
+class ContextualNodeOrder
+{
+public:
+  /** Constructor (empty order). */
+  ContextualNodeOrder ();
+
+  /** Ranks the contextual nodes of tree, numbered by index, from the entry node. */
+  void build (const ContextTree & tree, const ContextualNodeIndex & index, const ContextualNode & entry);
+
+  /** @return the number of ranked contextual nodes. */
+  size_t size () const
+  {
+    return nodes.size ();
+  }
+
+  /** @return the index of a contextual node. */
+  size_t getIndex (const ContextualNode & cn) const
+  {
+    return index->get (cn);
+  }
+
+  /** @return the rank of the contextual node of index i. */
+  size_t getRank (size_t i) const
+  {
+    return rank[i];
+  }
+
+  /** @return the contextual node of rank r. */
+  const ContextualNode & getNode (size_t r) const
+  {
+    return nodes[r];
+  }
+
+private:
+  const ContextualNodeIndex *index;
+  std::vector < size_t > rank;	///< rank of every contextual node, by index
+  std::vector < ContextualNode > nodes;	///< contextual nodes, by rank
+
+  /** Appends to nodes, in reverse postorder, the nodes reached from start and not ranked yet.
+      innermost gives the innermost loop of the nodes inside a loop. */
+  void traverse (const ContextualNode & start, std::vector < bool > &visited, const std::unordered_map < Node *, Loop * >&innermost);
+};
+
+/**
+ * \class WorklistClient
+ * \brief Transfer functions of an analysis solved by a Worklist.
+ */
+class WorklistClient
+{
+public:
+  virtual ~WorklistClient ()
+  {
+  }
+
+  /** Recomputes the input state of cn from the output states of its predecessors.
+      @return true if the output state of cn has to be recomputed. */
+  virtual bool updateIn (const ContextualNode & cn) = 0;
+
+  /** Recomputes the output state of cn from its input state.
+      @return true if it changed. */
+  virtual bool updateOut (const ContextualNode & cn) = 0;
+
+  /** Adds to succ the nodes which are not contextual successors of cn but whose input state
+      depends on the output state of cn (e.g. the return point of a call node). */
+  virtual void addDependents (const ContextualNode & cn, std::vector < ContextualNode > &succ)
+  {
+  }
+
+  /** @return true if succ has to be evaluated when the output state of its predecessor cn changes. */
+  virtual bool followEdge (const ContextualNode & cn, const ContextualNode & succ)
+  {
+    return true;
+  }
+};
+
+/**
+ * \class Worklist
+ * \brief Chaotic iteration of a WorklistClient, by increasing ContextualNodeOrder rank.
+ */
+class Worklist
+{
+public:
+  /** Constructor. */
+  Worklist (const ContextualNodeOrder & order);
+
+  /** Computes the fixed point of client from the start nodes (whose output states are computed first).
+      When visitAll is true, every node reached is evaluated at least once, even if its input state did not change. */
+  void solve (WorklistClient & client, const std::set < ContextualNode > &start, bool visitAll);
+
+  /** @return the number of node input state evaluations (updateIn) since the construction. */
+  unsigned long getNbInEvaluations () const
+  {
+    return nbInEvaluations;
+  }
+
+  /** @return the number of node output state evaluations (updateOut) since the construction. */
+  unsigned long getNbOutEvaluations () const
+  {
+    return nbOutEvaluations;
+  }
+
+  /** Adds the evaluation counts of w to the ones of this worklist. */
+  void addCounts (const Worklist & w)
+  {
+    nbInEvaluations += w.nbInEvaluations;
+    nbOutEvaluations += w.nbOutEvaluations;
+  }
+
+  /** @return the order of the nodes. */
+  const ContextualNodeOrder & getOrder () const
+  {
+    return order;
+  }
+
+private:
+  const ContextualNodeOrder & order;
+  std::priority_queue < size_t, std::vector < size_t >, std::greater < size_t > > queue;	///< ranks of the pending nodes
+  std::vector < bool > queued;	///< by rank
+  unsigned long nbInEvaluations, nbOutEvaluations;
+
+  /** Adds the node of rank r to the pending nodes. */
+  void push (size_t r);
+};
+
+#endif
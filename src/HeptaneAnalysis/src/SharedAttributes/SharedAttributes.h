@@ -46,6 +46,10 @@
 #define StackInfoAttributeName	"stackinfo"
 #include "Specific/DataAddressAnalysis/StackInfoAttribute.h"
 
+// DecodedInstructionAttribute
+#define DecodedInstructionAttributeName "decoded"
+#include "Generic/DecodedInstructionAttribute.h"
+
 
 /** Cache categorization attribute prefix
  * value = AH,AM,FH,FM,AU
@@ -31,11 +31,89 @@
 #include <map>
 #include <utility>
 #include <cassert>
+#include <functional>
 
 #include "Cache.h"
 
 using namespace std;
 
+/** Hash of a set of cache lines */
+static size_t
+hashLines (const set < t_address > &lines)
+{
+  size_t h = lines.size ();
+  for (set < t_address >::const_iterator it = lines.begin (); it != lines.end (); it++)
+    {
+      h = h * 31 + hash < t_address > ()(*it);
+    }
+  return h;
+}
+
+/**************************************************
+ *
+ *  DataAccess implementation
+ *
+ *************************************************/
+
+bool
+DataAccess::SingleLine (unsigned int cacheline_size, t_address & line) const
+{
+  DataAccessLines it (*this, cacheline_size);
+  if (it.End ()) return false;
+  line = it.Line ();
+  for (it.Next (); !it.End (); it.Next ())
+    {
+      if (it.Line () != line) return false;
+    }
+  return true;
+}
+
+size_t
+DataAccess::CountLines (unsigned int cacheline_size) const
+{
+  size_t n = 0;
+  if (ranges.size () == 1)	// the lines of a range are enumerated once
+    {
+      for (DataAccessLines it (*this, cacheline_size); !it.End (); it.Next ()) n++;
+      return n;
+    }
+  set < t_address > lines;
+  for (DataAccessLines it (*this, cacheline_size); !it.End (); it.Next ())
+    {
+      lines.insert (it.Line ());
+    }
+  return lines.size ();
+}
+
+DataAccessLines::DataAccessLines (const DataAccess & a, unsigned int cachelinesize)
+  : access (a), cacheline_size (cachelinesize), range (0), k (0), line (0), end (0)
+{
+  Start ();
+}
+
+void
+DataAccessLines::Start ()
+{
+  for (; range < access.ranges.size (); range++, k = 0)
+    {
+      const AddressRange & r = access.ranges[range];
+      for (; k < r.count && r.size > 0; k++)
+	{
+	  t_address begin = r.base + (t_address) k * r.stride;
+	  t_address first = begin - begin % cacheline_size;
+	  t_address last = begin + r.size - 1;
+	  last -= last % cacheline_size;
+	  if (k > 0 && first <= end) first = end + cacheline_size;	// lines of the previous elements
+	  if (first <= last)
+	    {
+	      line = first;
+	      end = last;
+	      return;
+	    }
+	}
+    }
+}
+
 /**************************************************
  *
  *  MUST implementation
@@ -57,7 +135,7 @@ int nb_sets1 = 64;
     return (computeStartLine1 (addr) / cacheline_size1) % nb_sets1;
   }
 
-MUST::MUST (unsigned int nbways, unsigned int nbways_removed)
+MUSTSet::MUSTSet (unsigned int nbways, unsigned int nbways_removed)
 {
   nb_ways = nbways;
   nb_ways_removed = nbways_removed;
@@ -66,7 +144,7 @@ MUST::MUST (unsigned int nbways, unsigned int nbways_removed)
 
 /** returns true if the cache line containing addr is absent from the abstract cache set and false otherwise */
 bool
-MUST::Absent (t_address addr) const
+MUSTSet::Absent (t_address addr) const
 {
   return GetAge (addr) >= nb_ways;
 }
@@ -76,7 +154,7 @@ MUST::Absent (t_address addr) const
     nb_ways+nb_ways_removed otherwise
 */
 unsigned int
-MUST::GetAge (t_address addr) const
+MUSTSet::GetAge (t_address addr) const
 {
   for (unsigned int i = 0; i < nb_ways; i++)
     {
@@ -88,7 +166,7 @@ MUST::GetAge (t_address addr) const
 
 /** Print the Abstract Cache Set for debugging purpose */
 void
-MUST::Print () const 
+MUSTSet::Print () const 
 {
   //Full
   for(unsigned int i = 0;i < nb_ways;i++){
@@ -132,7 +210,7 @@ MUST::Print () const
 
 /** Update function when only one address is accessed */
 void
-MUST::Update (t_address addr)
+MUSTSet::Update (t_address addr)
 {
   assert (nb_ways > 0);
   assert (contents[0].size () <= 1);
@@ -168,7 +246,7 @@ MUST::Update (t_address addr)
     used by the data cache analysis
 */
 void
-MUST::Update (const set < t_address > &addrs)
+MUSTSet::Update (const set < t_address > &addrs)
 {
   assert (nb_ways > 0);
   assert (contents[0].size () <= 1);
@@ -197,7 +275,7 @@ MUST::Update (const set < t_address > &addrs)
 
 /** Join function */
 void
-MUST::Join (const MUST & c)
+MUSTSet::Join (const MUSTSet & c)
 {
   assert (nb_ways == c.nb_ways);
 
@@ -246,12 +324,24 @@ MUST::Join (const MUST & c)
 
 /** returns true if this is equal to c and false otherwise */
 bool
-MUST::Equals (const MUST & c) const
+MUSTSet::Equals (const MUSTSet & c) const
 {
   assert (nb_ways == c.nb_ways);
   return this->contents == c.contents;
 }
 
+/** returns a hash of the contents */
+size_t
+MUSTSet::Hash () const
+{
+  size_t h = 0;
+  for (size_t i = 0; i < contents.size (); i++)
+    {
+      h = h * 31 + hashLines (contents[i]);
+    }
+  return h;
+}
+
 /**************************************************
  *
  *  MAY implementation
@@ -259,7 +349,7 @@ MUST::Equals (const MUST & c) const
  *************************************************/
 
 /** Constructor */
-MAY::MAY (unsigned int nbways)
+MAYSet::MAYSet (unsigned int nbways)
 {
   nb_ways = nbways;
   contents.resize (nb_ways);
@@ -267,7 +357,7 @@ MAY::MAY (unsigned int nbways)
 
 /** returns true if the cache line containing addr is absent from the abstract cache set and false otherwise */
 bool
-MAY::Absent (t_address addr) const
+MAYSet::Absent (t_address addr) const
 {
   for (unsigned int i = 0; i < nb_ways; i++)
     {
@@ -278,7 +368,7 @@ MAY::Absent (t_address addr) const
 
 /** Print the Abstract Cache Set for debugging purpose */
 void
-MAY::Print () const
+MAYSet::Print () const
 {
   for(unsigned int i = 0;i < nb_ways;i++){
     if(contents[i].size() == nb_ways){
@@ -315,7 +405,7 @@ MAY::Print () const
 
 /** Update function when only one address is accessed */
 void
-MAY::Update (t_address addr)
+MAYSet::Update (t_address addr)
 {
   bool found = false;
   int pos = nb_ways;
@@ -360,7 +450,7 @@ MAY::Update (t_address addr)
     used by the data cache analysis
 */
 void
-MAY::Update (const set < t_address > &addrs)
+MAYSet::Update (const set < t_address > &addrs)
 {
   //remove addrs from the abstractCacheSet
   for (set < t_address >::const_iterator it = addrs.begin (); it != addrs.end (); it++)
@@ -380,7 +470,7 @@ MAY::Update (const set < t_address > &addrs)
 
 /** Join function */
 void
-MAY::Join (const MAY & c)
+MAYSet::Join (const MAYSet & c)
 {
   assert (nb_ways == c.nb_ways);
 
@@ -427,12 +517,24 @@ MAY::Join (const MAY & c)
 
 /** returns true if this is equal to c and false otherwise */
 bool
-MAY::Equals (const MAY & c) const
+MAYSet::Equals (const MAYSet & c) const
 {
   assert (nb_ways == c.nb_ways);
   return this->contents == c.contents;
 }
 
+/** returns a hash of the contents */
+size_t
+MAYSet::Hash () const
+{
+  size_t h = 0;
+  for (size_t i = 0; i < contents.size (); i++)
+    {
+      h = h * 31 + hashLines (contents[i]);
+    }
+  return h;
+}
+
 
 /**************************************************
  *
@@ -441,7 +543,7 @@ MAY::Equals (const MAY & c) const
  *************************************************/
 
 /** Constructor */
-PS::PS (unsigned int nbways, unsigned int nbways_removed)
+PSSet::PSSet (unsigned int nbways, unsigned int nbways_removed)
 {
   nb_ways = nbways;
   nb_ways_removed = nbways_removed;
@@ -449,7 +551,7 @@ PS::PS (unsigned int nbways, unsigned int nbways_removed)
 
 /** returns true if the cache line containing addr is absent from the abstract cache set and false otherwise */
 bool
-PS::Absent (t_address addr) const
+PSSet::Absent (t_address addr) const
 {
   map < t_address, set < t_address > >::const_iterator it_this = contents.find (addr);
   if (it_this == contents.end ())
@@ -465,7 +567,7 @@ PS::Absent (t_address addr) const
     nb_ways+nb_ways_removed otherwise
 */
 unsigned int
-PS::GetAge (t_address addr) const
+PSSet::GetAge (t_address addr) const
 {
   map < t_address, set < t_address > >::const_iterator it_this = contents.find (addr);
   if (it_this == contents.end ())
@@ -478,7 +580,7 @@ PS::GetAge (t_address addr) const
 
 /** Print the Abstract Cache Set for debugging purpose */
 void
-PS::Print () const
+PSSet::Print () const
 {
   //FULL 
   for (map < t_address, set < t_address > >::const_iterator it = contents.begin (); it != contents.end (); it++){
@@ -518,7 +620,7 @@ PS::Print () const
 
 /** Update function when only one address is accessed */
 void
-PS::Update (t_address addr)
+PSSet::Update (t_address addr)
 {
   set < t_address > to_evict;
 
@@ -545,7 +647,7 @@ PS::Update (t_address addr)
     used by the data cache analysis
 */
 void
-PS::Update (const set < t_address > &addrs)
+PSSet::Update (const set < t_address > &addrs)
 {
   set < t_address > absent = addrs;	//used to determine the addrs not already present in the map
   set < t_address > to_evict;	//use to determine the addrs evicted by this access 
@@ -594,7 +696,7 @@ PS::Update (const set < t_address > &addrs)
 
 /** Join function */
 void
-PS::Join (const PS & c)
+PSSet::Join (const PSSet & c)
 {
   assert (nb_ways == c.nb_ways);
 
@@ -623,8 +725,20 @@ PS::Join (const PS & c)
 
 /** returns true if this is equal to c and false otherwise */
 bool
-PS::Equals (const PS & c) const
+PSSet::Equals (const PSSet & c) const
 {
   assert (nb_ways == c.nb_ways);
   return this->contents == c.contents && this->evicted == c.evicted;
 }
+
+/** returns a hash of the contents */
+size_t
+PSSet::Hash () const
+{
+  size_t h = hashLines (evicted);
+  for (map < t_address, set < t_address > >::const_iterator it = contents.begin (); it != contents.end (); it++)
+    {
+      h = (h * 31 + hash < t_address > ()(it->first)) * 31 + hashLines (it->second);
+    }
+  return h;
+}
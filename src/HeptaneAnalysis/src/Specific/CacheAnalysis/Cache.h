@@ -23,6 +23,9 @@
  *
  * AbstractCache implementation and definition of the abstract cache set interface for the MAY, MUST, and PS analysis
  *
+ * MUST, MAY and PS are the set-based abstract cache sets defined below (MUSTSet, MAYSet, PSSet),
+ * or the flat ones of FlatCache.h when compiled with -DFLAT_CACHE_SETS (the default, see GNUmakefile).
+ *
  */
 
 #ifndef CACHE_H
@@ -36,12 +39,82 @@
 #include <algorithm>
 
 
-#include "Generic/cow_ptr.h"
+#include "cow_ptr.h"
 
 #include "Analysis.h"		//useful for t_address type
 
+#ifdef FLAT_CACHE_SETS
+#include "Specific/CacheAnalysis/FlatCache.h"
+#endif
+
 using namespace std;
 
+/**************************************************
+ *
+ * DataAccess
+ *
+ *************************************************/
+
+/** Data addresses possibly accessed by a load, kept as ranges instead of sets of cache lines
+    (see DCacheAnalysis::getDataAddress) */
+class DataAccess
+{
+ public:
+  AddressRanges ranges;
+
+  bool operator== (const DataAccess & a) const
+  {
+    return ranges == a.ranges;
+  }
+  bool operator!= (const DataAccess & a) const
+  {
+    return ranges != a.ranges;
+  }
+
+  /** @return true and sets line to the beginning of the cache line if all the addresses are in a single cache line */
+  bool SingleLine (unsigned int cacheline_size, t_address & line) const;
+
+  /** @return the number of distinct cache lines accessed */
+  size_t CountLines (unsigned int cacheline_size) const;
+};
+
+/** Enumeration of the cache lines of a DataAccess, without building the set of the lines:
+      for (DataAccessLines it (access, cacheline_size); !it.End (); it.Next ()) ... it.Line () ...
+    The lines of a range are enumerated once, in increasing order (the lines shared by several ranges
+    are enumerated for each of them). */
+class DataAccessLines
+{
+ private:
+  const DataAccess & access;
+  t_address cacheline_size;
+  size_t range;			// current range
+  t_address k;			// current element of the range
+  t_address line;		// current line
+  t_address end;		// last line of the current element
+
+  /** Positions on the first line of the element k of the current range not yet enumerated, or on the next ones */
+  void Start ();
+
+ public:
+  DataAccessLines (const DataAccess & a, unsigned int cachelinesize);
+
+  bool End () const
+  {
+    return range == access.ranges.size ();
+  }
+
+  t_address Line () const
+  {
+    return line;
+  }
+
+  void Next ()
+  {
+    if (line < end) line += cacheline_size;
+    else { k++; Start (); }
+  }
+};
+
 /**************************************************
  *
  * AbstractCache
@@ -53,8 +126,10 @@ using namespace std;
 template < typename T > class AbstractCache
 {
  private:
-  /** internal structure */
+  /** internal structure: the sets [first_set .. first_set+contents.size()-1] of the cache
+      (all of them, but in the set groups of a parallel analysis, see CopySets) */
   vector < cow_ptr < T > >contents;
+  unsigned int first_set;
   unsigned int nb_sets;
   unsigned int nb_ways;
   unsigned int cacheline_size;
@@ -76,16 +151,21 @@ template < typename T > class AbstractCache
   /** default constructor */
   AbstractCache ()
     {
-      nb_sets = nb_ways = cacheline_size = 0;
+      first_set = nb_sets = nb_ways = cacheline_size = 0;
     }
 
   /** Constructor for a MAY Abstract cache only */
   AbstractCache (unsigned int nbsets, unsigned int nbways, unsigned int cachelinesize)
     {
+      first_set = 0;
       nb_sets = nbsets;
       nb_ways = nbways;
       cacheline_size = cachelinesize;
+#ifdef FLAT_CACHE_SETS
+      cow_ptr < T > tmp (new T (nb_ways, CacheBlockIndex::Get (nb_sets, cacheline_size)));
+#else
       cow_ptr < T > tmp (new T (nb_ways));
+#endif
       contents.resize (nb_sets, tmp);
     }
 
@@ -94,10 +174,15 @@ template < typename T > class AbstractCache
   */
   AbstractCache (unsigned int nbsets, unsigned int nbways, unsigned int nbways_removed, unsigned int cachelinesize)
     {
+      first_set = 0;
       nb_sets = nbsets;
       nb_ways = nbways;
       cacheline_size = cachelinesize;
+#ifdef FLAT_CACHE_SETS
+      cow_ptr < T > tmp (new T (nb_ways, nbways_removed, CacheBlockIndex::Get (nb_sets, cacheline_size)));
+#else
       cow_ptr < T > tmp (new T (nb_ways, nbways_removed));
+#endif
       contents.resize (nb_sets, tmp);
     }
 
@@ -105,7 +190,7 @@ template < typename T > class AbstractCache
   void Print () const
   {
     //cout << "---------------------------" << endl;
-    for (unsigned int s = 0; s < nb_sets; s++)
+    for (unsigned int s = 0; s < contents.size (); s++)
       {
 	contents[s]->Print ();
       }
@@ -114,12 +199,13 @@ template < typename T > class AbstractCache
   /** returns true if this is equal to c and false otherwise */
   bool Equals (const AbstractCache < T > &c) const
   {
-    if (c.nb_sets != nb_sets || c.nb_ways != nb_ways || c.cacheline_size != cacheline_size)
+    if (c.nb_sets != nb_sets || c.nb_ways != nb_ways || c.cacheline_size != cacheline_size
+	|| c.first_set != first_set || c.contents.size () != contents.size ())
       {
 	return false;
       }
 
-    for (unsigned int s = 0; s < nb_sets; s++)
+    for (unsigned int s = 0; s < contents.size (); s++)
       {
 	if (c.contents[s]->Equals (*(contents[s])) == false)
 	  {
@@ -129,6 +215,18 @@ template < typename T > class AbstractCache
     return true;
   }
 
+  /** @return a hash of the abstract cache, consistent with Equals (used to look up the
+      states already analysed, see CacheSummaryStore) */
+  size_t Hash () const
+  {
+    size_t h = first_set;
+    for (unsigned int s = 0; s < contents.size (); s++)
+      {
+	h = h * 31 + contents[s]->Hash ();
+      }
+    return h;
+  }
+
   /** returns the age in the abstract cache of the cache line containing addr
       between [0..nb_ways-1] if present
       nb_ways otherwise
@@ -141,7 +239,8 @@ template < typename T > class AbstractCache
     //cout << "GetAge Test " << endl;
     //cout << "theNumberOfAge is " << theNumberOfAge << endl;
     //cout << endl;
-    return contents[s]->GetAge (addr);
+    assert (HasSet (s));
+    return contents[s - first_set]->GetAge (addr);
   }
 
   /** returns true if the cache line containing addr is absent from the abstract cache and false otherwise */
@@ -149,7 +248,8 @@ template < typename T > class AbstractCache
   {
     addr = computeStartLine (addr);
     int s = computeSet (addr);
-    return contents[s]->Absent (addr);
+    assert (HasSet (s));
+    return contents[s - first_set]->Absent (addr);
   }
 
   /** returns true if the cache line containing addr is present in the abstract cache and false otherwise */
@@ -158,16 +258,66 @@ template < typename T > class AbstractCache
     return !Absent (addr);
   }
 
+  /** returns the number of sets of the cache */
+  unsigned int GetNbSets () const
+  {
+    return nb_sets;
+  }
+
+  /** returns true if the set s is represented in this abstract cache */
+  bool HasSet (unsigned int s) const
+  {
+    return s >= first_set && s < first_set + contents.size ();
+  }
+
+  /** Returns an abstract cache restricted to the sets [first .. first+count-1] of this one, for the analysis
+      of a group of sets (the accesses to the other sets are ignored by the Update functions).
+      The result shares no abstract cache set with this one, so that the set groups can be analysed by
+      different threads; copies maps the abstract cache sets already copied to their copy, to keep
+      sharing them in the copies. */
+  AbstractCache < T > CopySets (unsigned int first, unsigned int count, map < const T *, cow_ptr < T > >&copies) const
+  {
+    assert (HasSet (first) && HasSet (first + count - 1));
+    AbstractCache < T > result;
+    result.first_set = first;
+    result.nb_sets = nb_sets;
+    result.nb_ways = nb_ways;
+    result.cacheline_size = cacheline_size;
+    result.contents.reserve (count);
+    for (unsigned int s = first; s < first + count; s++)
+      {
+	const T *set = contents[s - first_set].operator-> ();
+	typename map < const T *, cow_ptr < T > >::iterator it = copies.find (set);
+	if (it == copies.end ())
+	  {
+	    it = copies.insert (make_pair (set, cow_ptr < T > (*set))).first;
+	  }
+	result.contents.push_back (it->second);
+      }
+    return result;
+  }
+
+  /** Replaces the sets of this abstract cache by the ones of part (see CopySets) */
+  void SetSets (const AbstractCache < T > &part)
+  {
+    assert (part.nb_sets == nb_sets && part.nb_ways == nb_ways && part.cacheline_size == cacheline_size);
+    for (unsigned int s = 0; s < part.contents.size (); s++)
+      {
+	assert (HasSet (part.first_set + s));
+	contents[part.first_set + s - first_set] = part.contents[s];
+      }
+  }
+
   /** returns the maximal age of all the blocks
       used by the data cache analysis
   */
-  unsigned int GetMaxAge (const set < t_address > &blocks) const
+  unsigned int GetMaxAge (const DataAccess & blocks) const
   {
     unsigned int max_age = 0;
 
-    for (set < t_address >::const_iterator it = blocks.begin (); it != blocks.end () && max_age < nb_ways; it++)
+    for (DataAccessLines it (blocks, cacheline_size); !it.End () && max_age < nb_ways; it.Next ())
       {
-	max_age = max (max_age, GetAge (*it));
+	max_age = max (max_age, GetAge (it.Line ()));
       }
     return max_age;
   }
@@ -175,24 +325,23 @@ template < typename T > class AbstractCache
   /** returns true if all cache blocks are present and false otherwise
       used by the data cache analysis
   */
-  bool AllPresent (const set < t_address > &blocks) const
+  bool AllPresent (const DataAccess & blocks) const
   {
-    bool present = true;
-    for (set < t_address >::const_iterator it = blocks.begin (); it != blocks.end () && present; it++)
+    for (DataAccessLines it (blocks, cacheline_size); !it.End (); it.Next ())
       {
-	present = !Absent (*it);
+	if (Absent (it.Line ())) { return false; }
       }
-    return present;
+    return true;
   }
 
   /** returns true if at least one cache block of blocks is present and false otherwise
       used by the data cache analysis
   */
-  bool OnePresent (const set < t_address > &blocks) const
+  bool OnePresent (const DataAccess & blocks) const
   {
-    for (set < t_address >::const_iterator it = blocks.begin (); it != blocks.end (); it++)
+    for (DataAccessLines it (blocks, cacheline_size); !it.End (); it.Next ())
       {
-	if (Present (*it)) { return true; }
+	if (Present (it.Line ())) { return true; }
       }
     return false;
   }
@@ -201,7 +350,8 @@ template < typename T > class AbstractCache
   void Join (const AbstractCache < T > &c)
   {
     assert (c.nb_sets == nb_sets && c.nb_ways == nb_ways && c.cacheline_size == cacheline_size);
-    for (unsigned int s = 0; s < nb_sets; s++)
+    assert (c.first_set == first_set && c.contents.size () == contents.size ());
+    for (unsigned int s = 0; s < contents.size (); s++)
       {
 	contents[s]->Join (*(c.contents[s]));
       }
@@ -215,7 +365,9 @@ template < typename T > class AbstractCache
     if (nb_sets > 0 && nb_ways > 0)
       {
 	addr = computeStartLine (addr);
-	int s = computeSet (addr);
+	unsigned int s = computeSet (addr);
+	if (!HasSet (s)) return;	// set of an other group
+	s -= first_set;
 	if (cac == "A")
 	  {
       //cout << " CAC" 
@@ -233,7 +385,7 @@ template < typename T > class AbstractCache
   /** Update function when a set of addresses is accessed 
       used by the data cache analysis
   */
-  void Update (const set < t_address > &addrs, string cac)
+  void Update (const DataAccess & addrs, string cac)
   {
     assert (nb_sets > 0 && nb_ways > 0);
 
@@ -242,32 +394,25 @@ template < typename T > class AbstractCache
 	return;
       }
 
-    // Get the sets where addresses should be stored
-    map < int, set < t_address > >inserted;
-    for (set < t_address >::const_iterator it = addrs.begin (); it != addrs.end (); it++)
+    //If the range of accessed addresses fits in a unique cache line,
+    t_address line;
+    if (addrs.SingleLine (cacheline_size, line))
       {
-	inserted[computeSet (*it)].insert (computeStartLine (*it));
+	Update (line, cac);
+	return;
       }
 
-    //If the range of accessed addresses fits in a unique cache line,
-    if (inserted.size () == 1)
+    //Otherwise, we have to use the update function for unpredictable accesses,
+    //on the lines of the sets of this abstract cache only
+    map < unsigned int, set < t_address > >inserted;
+    for (DataAccessLines it (addrs, cacheline_size); !it.End (); it.Next ())
       {
-	map < int, set < t_address > >::iterator it = inserted.begin ();
-	if (it->second.size () == 1)
-	  {
-	    Update (*(it->second.begin ()), cac);
-	  }
-	else
-	  {
-	    contents[it->first]->Update (it->second);
-	  }
+	unsigned int s = computeSet (it.Line ());
+	if (HasSet (s)) inserted[s].insert (it.Line ());
       }
-    else			//Otherwise, we have to use the update function for unpredictable accesses
+    for (map < unsigned int, set < t_address > >::iterator it = inserted.begin (); it != inserted.end (); it++)
       {
-	for (map < int, set < t_address > >::iterator it = inserted.begin (); it != inserted.end (); it++)
-	  {
-	    contents[it->first]->Update (it->second);	//safe for UNCERTAIN AND ALWAYS based on the semantic of unpredictable accesses
-	  }
+	contents[it->first - first_set]->Update (it->second);	//safe for UNCERTAIN AND ALWAYS based on the semantic of unpredictable accesses
       }
   }
 };
@@ -279,7 +424,7 @@ template < typename T > class AbstractCache
  *
  *************************************************/
 
-class MUST
+class MUSTSet
 {
  private:
   unsigned int nb_ways;		//the value corresponds to the number of ways to consider during the analysis
@@ -290,7 +435,7 @@ class MUST
  public:
 
   /** Constructor */
-  explicit MUST (unsigned int nbways, unsigned int nbways_removed);
+  explicit MUSTSet (unsigned int nbways, unsigned int nbways_removed);
 
   /** @return the age in the abstract cache of the cache line containing addr between [0..nb_ways-1] if present,  nb_ways+nb_ways_removed otherwise
    */
@@ -311,10 +456,13 @@ class MUST
   void Update (const set < t_address > &);
 
   /** Join function */
-  void Join (const MUST &);
+  void Join (const MUSTSet &);
 
   /** returns true if this is equal to c and false otherwise */
-  bool Equals (const MUST &) const;
+  bool Equals (const MUSTSet &) const;
+
+  /** @return a hash of the contents (equal sets have the same hash) */
+  size_t Hash () const;
 
 };
 
@@ -324,7 +472,7 @@ class MUST
  *
  *************************************************/
 
-class MAY
+class MAYSet
 {
  private:
   unsigned int nb_ways;		//the value corresponds to the number of ways to consider during the analysis
@@ -334,7 +482,7 @@ class MAY
  public:
 
   /** Constructor */
-  explicit MAY (unsigned int nbways);
+  explicit MAYSet (unsigned int nbways);
 
   //unsigned int GetAge(t_address addr) const; //Not implemented for MAY analysis: semantic issue with different replacement policies
 
@@ -353,10 +501,13 @@ class MAY
   void Update (const set < t_address > &);
 
   /** Join function */
-  void Join (const MAY &);
+  void Join (const MAYSet &);
 
   /** returns true if this is equal to c and false otherwise */
-  bool Equals (const MAY &) const;
+  bool Equals (const MAYSet &) const;
+
+  /** @return a hash of the contents (equal sets have the same hash) */
+  size_t Hash () const;
 
 };
 
@@ -366,7 +517,7 @@ class MAY
  *
  *************************************************/
 
-class PS
+class PSSet
 {
  private:
   unsigned int nb_ways;		//the value corresponds to the number of ways to consider during the analysis
@@ -378,7 +529,7 @@ class PS
  public:
 
   /** Constructor */
-  explicit PS (unsigned int nbways, unsigned int nbways_removed);
+  explicit PSSet (unsigned int nbways, unsigned int nbways_removed);
 
   /** returns the age in the abstract cache of the cache line containing addr
       between [0..nb_ways-1] if present
@@ -401,11 +552,24 @@ class PS
   void Update (const set < t_address > &);
 
   /** Join function */
-  void Join (const PS &);
+  void Join (const PSSet &);
 
   /** returns true if this is equal to c and false otherwise */
-  bool Equals (const PS &) const;
+  bool Equals (const PSSet &) const;
+
+  /** @return a hash of the contents (equal sets have the same hash) */
+  size_t Hash () const;
 
 };
 
+#ifdef FLAT_CACHE_SETS
+typedef FlatMUST MUST;
+typedef FlatMAY MAY;
+typedef FlatPS PS;
+#else
+typedef MUSTSet MUST;
+typedef MAYSet MAY;
+typedef PSSet PS;
+#endif
+
 #endif
@@ -21,71 +21,270 @@ See CREDITS.txt for credits of authorship
 ------------------------------------------------------------------------ */
 
 /**
- AbstractCacheStateAttribute definition with the names used by the Instruction and Data cache analysis
+ AbstractCacheStateStore definition, used by the Instruction and Data cache analysis
   */
 
 #ifndef CACHE_ANALYSIS_H
 #define CACHE_ANALYSIS_H
 
+#include "Specific/CacheAnalysis/Cache.h"
+#include "Generic/ContextHelper.h"
+#include "Generic/Worklist.h"
+#include "Generic/AnalysisHelper.h"
+#include "Generic/ThreadPool.h"
 
 /*************************************************************************************************************************
- Names of internal attributes
+ AbstractCache state store
  **************************************************************************************************************************/
 
-// ACSMAY_in and ACSMAY_out, of type AbstractCacheStateAttribute<MAY>, attached to nodes
-#define ACSMAYInName "ACSMAY_in"
-#define ACSMAYOutName "ACSMAY_out"
+/**
+ * ACS_in of the contextual nodes after a fixed point computation, read by the
+ * classification of the accesses (AbstractCacheStateStore, or CacheSummaryStore
+ * in the summary mode of the instruction cache analysis).
+ */
+template < typename T > class AbstractCacheStates
+{
+public:
+  virtual ~AbstractCacheStates ()
+  {
+  }
 
-// ACSMUST_in and ACSMUST_out, of type AbstractCacheStateAttribute<MUST>, attached to nodes
-#define ACSMUSTInName "ACSMUST_in"
-#define ACSMUSTOutName "ACSMUST_out"
+  /** @return true if cn takes part in the analysis */
+  virtual bool has (const ContextualNode & cn) const = 0;
 
-// ACSPS_in and ACSPS_out, of type AbstractCacheStateAttribute<PS>, attached to nodes (PS: persistent)
-#define ACSPSInName "ACSPS_in"
-#define ACSPSOutName "ACSPS_out"
+  /** @return the ACS_in of cn */
+  virtual AbstractCache < T > &getIn (const ContextualNode & cn) = 0;
+};
 
+/**
+ * Abstract cache states (in and out) of the contextual nodes during a fixed point
+ * computation, stored in flat vectors indexed by a ContextualNodeIndex.
+ *
+ * A state is attached (attach) to the contextual nodes taking part in the analysis
+ * (all of them for the MUST and MAY analyses, the nodes in loops for the PS analysis).
+ * The classification of the accesses reads the states, then the store is cleared:
+ * only the results (CHMC, ages) are attached to the instructions.
+ */
+template < typename T > class AbstractCacheStateStore:public AbstractCacheStates < T >
+{
+private:
+  const ContextualNodeIndex *index;
+  vector < AbstractCache < T > >in;
+  vector < AbstractCache < T > >out;
+  vector < bool >attached;
 
-/*************************************************************************************************************************
- AbstractCache state attribute
- **************************************************************************************************************************/
+public:
+  AbstractCacheStateStore ():index (NULL) {}
+
+  /** Allocates an empty store for the contextual nodes of index (no state attached). */
+  void init (const ContextualNodeIndex & vindex)
+  {
+    index = &vindex;
+    in.assign (index->size (), AbstractCache < T > ());
+    out.assign (index->size (), AbstractCache < T > ());
+    attached.assign (index->size (), false);
+  }
+
+  /** Attaches acs as ACS_in and ACS_out of cn */
+  void attach (const ContextualNode & cn, const AbstractCache < T > &acs)
+  {
+    size_t i = index->get (cn);
+    in[i] = acs;
+    out[i] = acs;
+    attached[i] = true;
+  }
+
+  /** @return true if cn takes part in the analysis */
+  bool has (const ContextualNode & cn) const final
+  {
+    return attached[index->get (cn)];
+  }
+
+  AbstractCache < T > &getIn (const ContextualNode & cn) final
+  {
+    size_t i = index->get (cn);
+    assert (attached[i]);
+    return in[i];
+  }
+
+  AbstractCache < T > &getOut (const ContextualNode & cn)
+  {
+    size_t i = index->get (cn);
+    assert (attached[i]);
+    return out[i];
+  }
+
+  /** Initialises this store with the states of from restricted to the cache sets [first .. first+count-1]
+      (analysis of a group of cache sets, see AbstractCache::CopySets). */
+  void copySets (const AbstractCacheStateStore < T > &from, unsigned int first, unsigned int count)
+  {
+    map < const T *, cow_ptr < T > >copies;
+    init (*from.index);
+    for (size_t i = 0; i < attached.size (); i++)
+      {
+	if (!from.attached[i]) continue;
+	in[i] = from.in[i].CopySets (first, count, copies);
+	out[i] = from.out[i].CopySets (first, count, copies);
+	attached[i] = true;
+      }
+  }
+
+  /** Replaces the cache sets of the states of this store by the ones of part (see copySets). */
+  void setSets (const AbstractCacheStateStore < T > &part)
+  {
+    for (size_t i = 0; i < attached.size (); i++)
+      {
+	if (!attached[i]) continue;
+	in[i].SetSets (part.in[i]);
+	out[i].SetSets (part.out[i]);
+      }
+  }
+
+  /** Frees all the states */
+  void clear ()
+  {
+    vector < AbstractCache < T > >().swap (in);
+    vector < AbstractCache < T > >().swap (out);
+    vector < bool >().swap (attached);
+  }
+};
 
-// ------------------------------------------------------
-// AbstractCache state attribute
-// for now, implements no serialisation function (empty)
-// just want to attach the abstract cache states to the nodes,
-// not to serialise them
-//
-// generic type T stands for MUST, MAY or PS (see Cache.h for more details)
-//
-// -----------------------------------------------------
 /**
- * Abstract cache state attribute (attached to CFG nodes)
+ * Transfer functions of the MUST, MAY and PS fixed points of a cache analysis A
+ * (ICacheAnalysis or DCacheAnalysis) on the ACS of store, solved by a Worklist.
+ * Only the contextual nodes of the store take part in the analysis (e.g. the loops
+ * of the PS analysis). When backedges is not NULL, the backedges are ignored
+ * (first step of the MUST analysis).
  */
-template < typename T > class AbstractCacheStateAttribute:public NonSerialisableAttribute
+template < typename T, typename A > class CacheFixPoint:public WorklistClient
 {
-public:
-  /** corresponding AbstractCache<T> */
-  AbstractCache < T > cache;
+ private:
+  A & analysis;
+  AbstractCacheStateStore < T > &store;
+  set < Edge * >*backedges;
+
+ public:
+  CacheFixPoint (A & a, AbstractCacheStateStore < T > &s, set < Edge * >*b = NULL):analysis (a), store (s), backedges (b)
+  {
+  }
+
+  /** ACS_in = join of the ACS_out of the predecessors */
+  bool updateIn (const ContextualNode & current)
+  {
+    const vector < ContextualNode > &predecessors = GetContextualPredecessors (current);
+    assert (predecessors.size () != 0);	//it should not be the program's entry node
 
-  /** Constructor */
-  AbstractCacheStateAttribute < T > (const AbstractCache < T > &ca)
+    AbstractCache < T > new_ACS_in;
+    bool first = true;
+    for (size_t i = 0; i < predecessors.size (); i++)
+      {
+	const ContextualNode & pred = predecessors[i];
+	if (!store.has (pred)) continue;
+	if (backedges != NULL && !AnalysisHelper::FilterBackedge (current.node, pred.node, *backedges)) continue;
+	if (first)
+	  {
+	    first = false;
+	    new_ACS_in = store.getOut (pred);
+	  }
+	else
+	  {
+	    new_ACS_in.Join (store.getOut (pred));
+	  }
+      }
+
+    AbstractCache < T > &stored_ACS_in = store.getIn (current);
+    if (stored_ACS_in.Equals (new_ACS_in)) return false;
+    stored_ACS_in = new_ACS_in;
+    return true;
+  }
+
+  /** ACS_out = ACS_in updated by the accesses of the node */
+  bool updateOut (const ContextualNode & cn)
   {
-    cache = ca;
-  };
+    ContextualNode current = cn;
+    AbstractCache < T > ACS_out = analysis.template compute_ACS_out < T > (current, store);
+    AbstractCache < T > &stored_ACS_out = store.getOut (current);
+    if (stored_ACS_out.Equals (ACS_out)) return false;
+    stored_ACS_out = ACS_out;
+    return true;
+  }
 
-  /** Cloning function */
-  AbstractCacheStateAttribute < T > *clone ()
+  bool followEdge (const ContextualNode & current, const ContextualNode & succ)
   {
-    return new AbstractCacheStateAttribute < T > (cache);
-  };
+    if (!store.has (succ)) return false;
+    if (backedges != NULL && current.node->GetCfg () == succ.node->GetCfg ())
+      {
+	Edge *edge = current.node->GetCfg ()->FindEdge (current.node, succ.node);
+	return backedges->find (edge) == backedges->end ();	// If backedge, ignore it
+      }
+    return true;
+  }
+};
 
-  /** Printing function */
-  void Print (std::ostream & os)
+/**
+ * Fixed points of CacheFixPoint on groups of cache sets, run by a ThreadPool.
+ * The cache sets of an LRU-like cache do not interact: the accesses to a set
+ * only update this set, and the joins and comparisons are made set by set, so
+ * that the sets can be analysed independently. Every group has its own copy
+ * of the states of its sets (AbstractCacheStateStore::copySets) and its own
+ * Worklist, the other data (program, contexts, node order) are only read.
+ */
+template < typename T, typename A > class CacheSetGroupTask:public ParallelTask
+{
+ public:
+  A & analysis;
+  set < Edge * >*backedges;
+  const set < ContextualNode > &start;
+  vector < AbstractCacheStateStore < T > >groups;	///< states of the sets of every group
+  vector < Worklist > works;	///< worklist of every group
+
+  CacheSetGroupTask (A & a, set < Edge * >*b, const set < ContextualNode > &s):analysis (a), backedges (b), start (s)
   {
-    os << "(type NonSerialisableAbstractCacheStateAttribute, name " << name << ")";
-  };
+  }
 
- 
+  void execute (size_t g)
+  {
+    CacheFixPoint < T, A > fixpoint (analysis, groups[g], backedges);
+    works[g].solve (fixpoint, start, true);
+  }
 };
 
+/**
+ * Computes the fixed point of CacheFixPoint (analysis, store, backedges) from the start nodes (see Worklist::solve).
+ * Every node reached is evaluated at least once: a node whose ACS_in keeps its initial value must still apply
+ * its accesses, and the result does not depend on the cache sets analysed together.
+ * When pool is not NULL, the cache sets are partitioned into groups of consecutive sets (a few per thread,
+ * for load balancing) analysed in parallel, and the states of the groups are copied back in store.
+ * The evaluation counts of all the groups are added to work.
+ */
+template < typename T, typename A > void solveCacheFixPoint (A & analysis, AbstractCacheStateStore < T > &store, const set < ContextualNode > &start,
+							   Worklist & work, ThreadPool * pool, set < Edge * >*backedges = NULL)
+{
+  unsigned int nbSets = analysis.getNbSets ();
+  if (pool == NULL || nbSets < 2)
+    {
+      CacheFixPoint < T, A > fixpoint (analysis, store, backedges);
+      work.solve (fixpoint, start, true);
+      return;
+    }
+
+  unsigned int nbGroups = min (nbSets, 4 * pool->getNbThreads ());
+  CacheSetGroupTask < T, A > task (analysis, backedges, start);
+  task.groups.resize (nbGroups);
+  for (unsigned int g = 0; g < nbGroups; g++)
+    {
+      unsigned int first = g * nbSets / nbGroups;
+      task.groups[g].copySets (store, first, (g + 1) * nbSets / nbGroups - first);
+      task.works.push_back (Worklist (work.getOrder ()));
+    }
+
+  pool->run (task, nbGroups);
+
+  for (unsigned int g = 0; g < nbGroups; g++)
+    {
+      store.setSets (task.groups[g]);
+      work.addCounts (task.works[g]);
+    }
+}
+
 #endif
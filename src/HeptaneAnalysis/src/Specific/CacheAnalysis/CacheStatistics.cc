@@ -23,6 +23,7 @@ See CREDITS.txt for credits of authorship
 #include "Specific/CacheAnalysis/CacheStatistics.h"
 
 #include "Generic/CallGraph.h"
+#include "Specific/CacheAnalysis/Cache.h"
 #include "arch.h"
 
 #include <limits>
@@ -106,7 +107,7 @@ void CacheStatistics::PerformAnalysis ( CacheParam * aCache, const vector < Cfg
 		  const vector < Instruction * >&instr = CurrentNode->GetAsm ();
 		  for (size_t i = 0; i < instr.size (); ++i)
 		    {
-		      if ( (aCache->type == DCACHE || aCache->type == PERFECTDCACHE) && ! Arch::isLoad (instr[i]->GetCode ()))
+		      if ( (aCache->type == DCACHE || aCache->type == PERFECTDCACHE) && ! AnalysisHelper::getDecoded (instr[i]).load)
 			continue;
 		      string chmc = getCHMC (contexts[ct], instr[i], aCache);
 		      size_t occurrences = getOccurrencesCount (frequency, contexts[ct], instr[i], aCache);
@@ -249,7 +250,7 @@ CacheStatistics::getCHMC (Context * context, Instruction * inst, CacheParam * ca
       break;
     case DCACHE:
     case PERFECTDCACHE:
-      assert (Arch::isLoad (inst->GetCode ()));
+      assert (AnalysisHelper::getDecoded (inst).load);
       chmc_name = AnalysisHelper::mkContextAttrName( CHMCAttributeNameData (cache->level), context);
       break;
     default:
@@ -308,23 +309,19 @@ CacheStatistics::countAccessedBlocks (Context * context, Instruction * inst, Cac
 	}
     }
 
-  AddressAttribute address_attr = (AddressAttribute &) inst->GetAttribute (attribute_name);
+  const AddressAttribute & address_attr = (AddressAttribute &) inst->GetAttribute (attribute_name);
 
-  vector < AddressInfo > addresses = address_attr.getListInfo ();
+  const vector < AddressInfo > &addresses = address_attr.getListInfo ();
   for (size_t i = 0; i < addresses.size (); ++i)
     {
       if ((cache->type == ICACHE && addresses[i].getSegment () == "code") || (cache->type == DCACHE && addresses[i].getSegment () != "code"))
 	{
-	  const vector < pair < string, string > >&regions = addresses[i].getAdrSize ();
+	  const AddressRanges & regions = addresses[i].getRanges ();
 	  for (size_t r = 0; r < regions.size (); ++r)
 	    {
-	      t_address from = atol (regions[r].first.c_str ());
-	      unsigned int range = atoi (regions[r].second.c_str ());
-	      for (t_address add = from - (from % cache->cachelinesize);
-		   add <= (from + range - 1) - ((from + range - 1) % cache->cachelinesize); add += cache->cachelinesize)
-		{
-		  ++count;
-		}
+	      DataAccess region;
+	      region.ranges.push_back (regions[r]);
+	      count += region.CountLines (cache->cachelinesize);
 	    }
 	}
     }
@@ -444,7 +441,7 @@ void CacheStatistics::CheckInstrHaveCacheCategorizationAttribute ()
 				  has_icache_info[l-1] = false;
 			      }
 			 
-			    if (has_dcache && Arch::isLoad (instr->GetCode ()))
+			    if (has_dcache && AnalysisHelper::getDecoded (instr).load)
 			      {
 				if (! instr->HasAttribute (AnalysisHelper::mkContextAttrName( CHMCAttributeNameData (l), vcontext)))
 				  has_dcache_info[l-1] = false;
@@ -0,0 +1,507 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+
+/**
+ Function summaries of the cache analyses (summary mode of the instruction and data cache analyses)
+  */
+
+#ifndef CACHE_SUMMARY_H
+#define CACHE_SUMMARY_H
+
+#include <queue>
+#include "Specific/CacheAnalysis/CacheAnalysis.h"
+#include "Generic/CallGraph.h"
+
+/**
+ * Result of the analysis of a part of a function (the whole function, or an outer loop
+ * for the PS analysis) for an abstract cache state at its entry: ACS (in and out) of
+ * its nodes, ACS at the exit of the function, and summaries of the functions called.
+ */
+template < typename T > class CacheSummary
+{
+public:
+  Context *context;		///< context of the first analysis (access classification of the instructions)
+  Loop *loop;			///< analysed loop, NULL for the whole function
+  AbstractCache < T > entry;	///< ACS at the entry (join of the entries of the contexts sharing the summary when the call strings are bounded)
+  AbstractCache < T > exit;	///< join of the ACS_out of the end nodes of the function
+  bool returns;			///< an end node of the function is analysed (exit is valid)
+  vector < AbstractCache < T > >in, out;	///< by node index in the cfg (ContextualNodeIndex::getLocal), out only during the analysis
+  vector < bool >attached;	///< nodes of the analysed part
+  map < Node *, CacheSummary < T > *>callees;	///< summary of the callee of every call node evaluated
+  unsigned int round;		///< last round of analysis (bounded call strings)
+  unsigned long evaluations;	///< node evaluations of the last analysis, callees included (reused callees counted as analysed)
+  unsigned int nbContexts;	///< contexts bound to the summary (bind)
+  bool joined;			///< the entry is the join of several entries (bounded call strings)
+};
+
+/**
+ * Summary-based resolution of the MUST, MAY and PS fixed points of a cache analysis A
+ * (ICacheAnalysis or DCacheAnalysis, see CacheFixPoint), instead of a resolution on
+ * all the contextual nodes.
+ *
+ * A function is analysed once per distinct ACS at its entry: the fixed point is
+ * computed on its nodes only, the call nodes being replaced by the summary of the
+ * callee for the ACS_out of the call node, and the summaries are memoised per
+ * function and hash of their entry ACS (analyse). The contexts reaching a function
+ * with an identical entry ACS share its summary instead of being analysed again: the
+ * number of ACS stored depends on the number of distinct entry states instead of the
+ * number of contexts, and the cache sets of the states are shared by their cow_ptr.
+ *
+ * When the call strings are bounded (depth >= 0), the contexts of a function whose
+ * last depth call nodes are the same share a single summary, analysed for the join
+ * of their entry ACS. The analysis is then repeated by rounds (newRound, stable) until
+ * no entry ACS grows: the summaries analysed before the growth of a callee entry
+ * may have used an outdated exit ACS.
+ *
+ * A summary is only shared by contexts with the same accesses (A::sameAccesses):
+ * the same access classification (CAC) at the levels other than L1, and the same
+ * data addresses for a data cache.
+ *
+ * After the analysis, the summaries used by every context are bound (bind), and the
+ * ACS_in of the contextual nodes is read through the AbstractCacheStates interface.
+ * No state is stored per context: a summary keeps the ACS_in of its nodes only, and
+ * the summaries not bound to any context are deleted. The report gives the number of
+ * contextual nodes classified from a summary shared with other contexts, and among
+ * them the ones whose summary was analysed for the join of several entries (bounded
+ * call strings), where the classification may be less precise than per context.
+ *
+ * This resolution, hence the sharing of the contexts with identical entry states, is
+ * only used with contexts="summary" (ICACHE, DCACHE): by default (contexts="full") every
+ * contextual node is analysed. The report gives the reuse rate and the node evaluations
+ * avoided, i.e. the evaluations done by the first analysis of the summaries reused.
+ */
+template < typename T, typename A > class CacheSummaryStore:public AbstractCacheStates < T >
+{
+private:
+  A & analysis;
+  const ContextualNodeIndex & index;
+  const ContextualNodeOrder & order;
+  AbstractCache < T > empty;	///< initial ACS of the nodes
+  int depth;			///< bound of the call strings, -1 when unbounded
+  bool attachAll;		///< every contextual node takes part in the analysis (MUST and MAY)
+  set < Edge * >*backedges;	///< when not NULL, a first fixed point ignores the backedges (MUST)
+
+  /** Summaries of every part of function (start node), call string and hash of the entry ACS
+      (call string empty when unbounded, hash 0 when bounded) */
+  typedef pair < pair < Node *, vector < Node * > >, size_t > SummaryKey;
+  map < SummaryKey, vector < CacheSummary < T > *> >memo;
+  vector < CacheSummary < T > *>summaries;
+  vector < pair < Context *, CacheSummary < T > *> >roots;	///< summaries analysed from the driver in the last round
+  vector < vector < CacheSummary < T > *> >byContext;	///< summaries of the parts of every context, by context id
+  unsigned int round;
+  bool changed;
+
+  unsigned long nbReused, nbAnalyses, nbInEvaluations, nbOutEvaluations;
+  unsigned long nbAvoided;	///< node evaluations of the summaries reused (not done again)
+
+  /** @return the memo key of the part of the function of context starting at start, for entry */
+  SummaryKey key (Context * context, Node * start, const AbstractCache < T > &entry) const
+  {
+    return SummaryKey (make_pair (start, callString (context)), (depth < 0) ? entry.Hash () : 0);
+  }
+
+  /** @return the last depth call nodes of context (none when unbounded) */
+  vector < Node * >callString (Context * context) const
+  {
+    vector < Node * >calls;
+    for (Context * c = context; depth >= 0 && (int) calls.size () < depth && c->getCallerNode () != NULL; c = c->getCallerContext ())
+      calls.push_back (c->getCallerNode ());
+    return calls;
+  }
+
+  /** Computes the summary s (entry, context and loop set) */
+  void solve (CacheSummary < T > *s)
+  {
+    unsigned long evaluations = nbOutEvaluations, avoided = nbAvoided;
+    nbAnalyses++;
+    s->round = round;
+    Cfg *function = s->context->getCurrentFunction ();
+    vector < Node * >all = function->GetAllNodes ();
+    vector < Node * >nodes = (s->loop != NULL) ? s->loop->GetAllNodes () : all;
+
+    s->in.assign (all.size (), AbstractCache < T > ());
+    s->out.assign (all.size (), AbstractCache < T > ());
+    s->attached.assign (all.size (), false);
+    s->callees.clear ();
+    for (size_t i = 0; i < nodes.size (); i++)
+      {
+	size_t j = index.getLocal (nodes[i]);
+	s->in[j] = empty;
+	s->out[j] = empty;
+	s->attached[j] = true;
+      }
+
+    Node *start = (s->loop != NULL) ? s->loop->GetHead () : function->GetStartNode ();
+    s->in[index.getLocal (start)] = s->entry;
+    if (backedges != NULL)
+      propagate (s, start, true);
+    propagate (s, start, false);
+
+    s->returns = false;
+    if (s->loop == NULL)
+      {
+	vector < Node * >ends = function->GetEndNodes ();
+	for (size_t e = 0; e < ends.size (); e++)
+	  {
+	    size_t j = index.getLocal (ends[e]);
+	    if (!s->returns)
+	      s->exit = s->out[j];
+	    else
+	      s->exit.Join (s->out[j]);
+	    s->returns = true;
+	  }
+      }
+    s->evaluations = (nbOutEvaluations - evaluations) + (nbAvoided - avoided);
+
+    // Only the ACS_in are read after the fixed point (classification of the accesses)
+    vector < AbstractCache < T > >().swap (s->out);
+  }
+
+  /** Fixed point on the nodes of s from start, ignoring the backedges when ignoreBackedges is true
+      (see Worklist::solve: every node reached is evaluated at least once) */
+  void propagate (CacheSummary < T > *s, Node * start, bool ignoreBackedges)
+  {
+    Cfg *function = s->context->getCurrentFunction ();
+    typedef pair < size_t, Node * >Pending;
+    priority_queue < Pending, vector < Pending >, greater < Pending > >queue;
+    vector < bool > queued (s->attached.size (), false);
+    vector < bool > visited (s->attached.size (), false);
+    bool skipIn = true;		// the output state of start is computed first
+
+    queue.push (Pending (rank (s, start), start));
+    queued[index.getLocal (start)] = true;
+    while (!queue.empty ())
+      {
+	Node *node = queue.top ().second;
+	queue.pop ();
+	size_t i = index.getLocal (node);
+	queued[i] = false;
+
+	bool update = true;
+	if (skipIn)
+	  {
+	    skipIn = false;
+	  }
+	else
+	  {
+	    nbInEvaluations++;
+	    update = updateIn (s, node, start, ignoreBackedges) || !visited[i];
+	  }
+	if (!update) continue;
+
+	nbOutEvaluations++;
+	bool modified = updateOut (s, node) || !visited[i];
+	visited[i] = true;
+	if (!modified) continue;
+
+	const vector < Node * >&successors = function->GetSuccessors (node);
+	for (size_t k = 0; k < successors.size (); k++)
+	  {
+	    size_t j = index.getLocal (successors[k]);
+	    if (!s->attached[j] || queued[j]) continue;
+	    if (ignoreBackedges && !node->IsCall () && !AnalysisHelper::FilterBackedge (successors[k], node, *backedges)) continue;
+	    queued[j] = true;
+	    queue.push (Pending (rank (s, successors[k]), successors[k]));
+	  }
+      }
+  }
+
+  /** @return the evaluation rank of node (rank in the ContextualNodeOrder of the context of s) */
+  size_t rank (CacheSummary < T > *s, Node * node) const
+  {
+    return order.getRank (order.getIndex (ContextualNode (s->context, node)));
+  }
+
+  /** ACS_in = join of the ACS_out of the predecessors (exit ACS of the callee for a call node) */
+  bool updateIn (CacheSummary < T > *s, Node * node, Node * start, bool ignoreBackedges)
+  {
+    AbstractCache < T > new_ACS_in;
+    bool first = true;
+    // the entry of a called function is a predecessor of its start node
+    if (node == start && s->loop == NULL && s->context->getCallerNode () != NULL)
+      {
+	new_ACS_in = s->entry;
+	first = false;
+      }
+
+    const vector < Node * >&predecessors = s->context->getCurrentFunction ()->GetPredecessors (node);
+    for (size_t k = 0; k < predecessors.size (); k++)
+      {
+	Node *pred = predecessors[k];
+	if (!s->attached[index.getLocal (pred)]) continue;
+	const AbstractCache < T > *pred_ACS_out = &s->out[index.getLocal (pred)];
+	if (pred->IsCall ())
+	  {
+	    typename map < Node *, CacheSummary < T > *>::const_iterator it = s->callees.find (pred);
+	    if (it == s->callees.end () || !it->second->returns) continue;
+	    pred_ACS_out = &it->second->exit;
+	  }
+	else if (ignoreBackedges && !AnalysisHelper::FilterBackedge (node, pred, *backedges))
+	  continue;
+
+	if (first)
+	  {
+	    first = false;
+	    new_ACS_in = *pred_ACS_out;
+	  }
+	else
+	  {
+	    new_ACS_in.Join (*pred_ACS_out);
+	  }
+      }
+    if (first) return false;
+
+    AbstractCache < T > &stored_ACS_in = s->in[index.getLocal (node)];
+    if (stored_ACS_in.Equals (new_ACS_in)) return false;
+    stored_ACS_in = new_ACS_in;
+    return true;
+  }
+
+  /** ACS_out = ACS_in updated by the accesses of the node, and summary of the callee of a call node */
+  bool updateOut (CacheSummary < T > *s, Node * node)
+  {
+    size_t i = index.getLocal (node);
+    ContextualNode current (s->context, node);
+    AbstractCache < T > ACS_out = analysis.template compute_ACS_out < T > (current, s->in[i]);
+    bool modified = !s->out[i].Equals (ACS_out);
+    if (modified) s->out[i] = ACS_out;
+
+    if (node->IsCall ())
+      {
+	// the exit ACS of the callee may change even if its entry does not (bounded call strings)
+	CacheSummary < T > *&callee = s->callees[node];
+	callee = analyse (s->context->getCalleeContext (node), NULL, s->out[i], callee);
+	modified = true;
+      }
+    return modified;
+  }
+
+  /** Accounts for the reuse of s, unless it was already the summary found for the same call node */
+  void reuse (CacheSummary < T > *s, CacheSummary < T > *previous)
+  {
+    if (s == previous) return;
+    nbReused++;
+    nbAvoided += s->evaluations;
+  }
+
+  /** Binds s and the summaries of its callees to context and its callee contexts */
+  void bindCallees (Context * context, CacheSummary < T > *s)
+  {
+    byContext[context->getId ()].push_back (s);
+    s->nbContexts++;
+    for (typename map < Node *, CacheSummary < T > *>::const_iterator it = s->callees.begin (); it != s->callees.end (); it++)
+      bindCallees (context->getCalleeContext (it->first), it->second);
+  }
+
+  /** @return the number of ACS stored by the summaries (ACS_in of the nodes, entry and exit) */
+  size_t getNbStates () const
+  {
+    size_t n = 0;
+    for (size_t i = 0; i < summaries.size (); i++)
+      n += 2 + getNbNodes (summaries[i]);
+    return n;
+  }
+
+  /** @return the number of nodes analysed by s */
+  static size_t getNbNodes (const CacheSummary < T > *s)
+  {
+    size_t n = 0;
+    for (size_t j = 0; j < s->attached.size (); j++)
+      if (s->attached[j]) n++;
+    return n;
+  }
+
+  /** Starts a round of analysis (the summaries are analysed again when the call strings are bounded) */
+  void newRound ()
+  {
+    round++;
+    changed = false;
+    roots.clear ();
+  }
+
+  /** Records s as analysed for context by a round (bound by bind) */
+  void addRoot (Context * context, CacheSummary < T > *s)
+  {
+    roots.push_back (make_pair (context, s));
+  }
+
+  /** @return true if no entry ACS grew during the last round */
+  bool stable () const
+  {
+    return !changed;
+  }
+
+  /** Binds the summaries of the last round to the contexts of tree. The other summaries
+      (analysed for intermediate entries of the fixed points) are not used any more and are deleted. */
+  void bind (const ContextTree & tree)
+  {
+    byContext.assign (tree.getContextsCount (), vector < CacheSummary < T > *>());
+    for (size_t i = 0; i < roots.size (); i++)
+      bindCallees (roots[i].first, roots[i].second);
+
+    memo.clear ();
+    size_t kept = 0;
+    for (size_t i = 0; i < summaries.size (); i++)
+      if (summaries[i]->nbContexts == 0)
+	delete summaries[i];
+      else
+	summaries[kept++] = summaries[i];
+    summaries.resize (kept);
+  }
+
+public:
+  CacheSummaryStore (A & a, const ContextualNodeIndex & vindex, const ContextualNodeOrder & vorder, const AbstractCache < T > &vempty,
+		     int vdepth, bool vattachAll, set < Edge * >*b = NULL):analysis (a), index (vindex), order (vorder), empty (vempty),
+    depth (vdepth), attachAll (vattachAll), backedges (b), round (0), changed (false), nbReused (0), nbAnalyses (0), nbInEvaluations (0),
+    nbOutEvaluations (0), nbAvoided (0)
+  {
+  }
+
+  ~CacheSummaryStore ()
+  {
+    for (size_t i = 0; i < summaries.size (); i++)
+      delete summaries[i];
+  }
+
+  /** @return the summary of the part of the function of context starting at the head of loop
+      (the whole function when loop is NULL) for the entry ACS. previous is the summary returned
+      for the same call node before: finding it again is not counted as a reuse. */
+  CacheSummary < T > *analyse (Context * context, Loop * loop, const AbstractCache < T > &entry, CacheSummary < T > *previous = NULL)
+  {
+    Node *start = (loop != NULL) ? loop->GetHead () : context->getCurrentFunction ()->GetStartNode ();
+    vector < CacheSummary < T > *>candidates = memo[key (context, start, entry)];
+    for (size_t i = 0; i < candidates.size (); i++)
+      {
+	CacheSummary < T > *s = candidates[i];
+	if (!analysis.sameAccesses (s->context, context)) continue;
+	if (depth < 0)
+	  {
+	    if (!s->entry.Equals (entry)) continue;
+	    reuse (s, previous);
+	    return s;
+	  }
+
+	// bounded call strings: the summary is shared by all the contexts, for the join of their entries
+	AbstractCache < T > joined = s->entry;
+	joined.Join (entry);
+	if (!joined.Equals (s->entry))
+	  {
+	    s->entry = joined;
+	    s->joined = true;
+	    changed = true;
+	    solve (s);
+	  }
+	else if (s->round != round)
+	  solve (s);
+	else
+	  reuse (s, previous);
+	return s;
+      }
+
+    CacheSummary < T > *s = new CacheSummary < T > ();
+    s->context = context;
+    s->loop = loop;
+    s->entry = entry;
+    s->round = round;
+    s->nbContexts = 0;
+    s->joined = false;
+    memo[key (context, start, entry)].push_back (s);
+    summaries.push_back (s);
+    solve (s);
+    return s;
+  }
+
+  /** Analyses the program from the entry of the root context with an empty ACS (MUST, MAY),
+      then binds the summaries to the contexts of tree */
+  void analyseProgram (const ContextTree & tree)
+  {
+    do
+      {
+	newRound ();
+	addRoot (tree.getRoot (), analyse (tree.getRoot (), NULL, empty));
+      }
+    while (!stable ());
+    bind (tree);
+  }
+
+  /** Analyses the outer loops of the contexts not called in a loop with an empty ACS (PS, the
+      contexts called in a loop are analysed as callees), then binds the summaries to the contexts of tree */
+  void analyseLoops (const ContextTree & tree, CallGraph * call_graph)
+  {
+    do
+      {
+	newRound ();
+	for (context_id id = 0; id < tree.getContextsCount (); id++)
+	  {
+	    Context *context = tree.getContext (id);
+	    if (call_graph->isDeadCode (context->getCurrentFunction ()) || AnalysisHelper::CallerInLoop (context)) continue;
+
+	    vector < Loop * >loops = AnalysisHelper::getOuterLoops (context->getCurrentFunction ());
+	    for (size_t j = 0; j < loops.size (); j++)
+	      addRoot (context, analyse (context, loops[j], empty));
+	  }
+      }
+    while (!stable ());
+    bind (tree);
+  }
+
+  /** @return the statistics of the analysis, for the log of the analyses */
+  string getReport (const ContextTree & tree) const
+  {
+    unsigned long entries = nbReused + nbAnalyses;
+    size_t shared = 0, joined = 0;	// contextual nodes classified from a summary shared by several contexts
+    for (size_t i = 0; i < summaries.size (); i++)
+      if (summaries[i]->nbContexts > 1)
+	{
+	  size_t n = summaries[i]->nbContexts * getNbNodes (summaries[i]);
+	  shared += n;
+	  if (summaries[i]->joined) joined += n;
+	}
+    stringstream report;
+    report << nbOutEvaluations << " node evaluations, " << nbInEvaluations << " joins, " << summaries.size () << " summaries for "
+	   << tree.getContextsCount () << " contexts, " << nbReused << " reused (" << ((entries == 0) ? 0 : 100 * nbReused / entries)
+	   << "% of the entries, " << nbAvoided << " node evaluations avoided), " << getNbStates () << " ACS stored for " << index.size () << " contextual nodes, "
+	   << shared << " contextual nodes classified from a shared summary (" << joined << " from a joined entry)";
+    return report.str ();
+  }
+
+  bool has (const ContextualNode & cn) const
+  {
+    const vector < CacheSummary < T > *>&parts = byContext[cn.context->getId ()];
+    size_t i = index.getLocal (cn.node);
+    for (size_t k = 0; k < parts.size (); k++)
+      if (parts[k]->attached[i]) return true;
+    return attachAll;		// nodes never reached keep the initial ACS
+  }
+
+  AbstractCache < T > &getIn (const ContextualNode & cn)
+  {
+    const vector < CacheSummary < T > *>&parts = byContext[cn.context->getId ()];
+    size_t i = index.getLocal (cn.node);
+    for (size_t k = 0; k < parts.size (); k++)
+      if (parts[k]->attached[i]) return parts[k]->in[i];
+    assert (attachAll);
+    return empty;
+  }
+};
+
+#endif
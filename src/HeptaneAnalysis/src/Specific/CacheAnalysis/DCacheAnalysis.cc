@@ -58,8 +58,6 @@
 #include "arch.h"
 
 // inlines...
-#define getACSNode(T, NODE, IDATTR) ((AbstractCacheStateAttribute < T > &)NODE->GetAttribute(IDATTR))
-#define getACSContextualNode(T, ELEM, IDATTR) getACSNode(T, ELEM.node,IDATTR)
 
 /*************************************************************************************************************************
  CacheFactory functions
@@ -227,7 +225,7 @@ static bool CheckInstrHaveDataAccessAttribute(Cfg * c, Node * n, void *param)
       vector < Instruction * >vi = n->GetAsm();
       for (size_t i = 0; i < vi.size(); i++)
 	{
-	  if (Arch::isLoad(vi[i]->GetCode()))
+	  if (AnalysisHelper::getDecoded(vi[i]).load)
 	    {
 	      if (! vi[i]->HasAttribute(id))
 		{
@@ -249,8 +247,8 @@ static bool CheckInstrHaveDataAddresses(Cfg * c, Node * n, void *param)
   vector < Instruction * >vi = n->GetAsm();
   for (size_t i = 0; i < vi.size(); i++)
     {
-      string vinstr = vi[i]->GetCode();
-      if (Arch::isLoad(vinstr) || Arch::isStore(vinstr))
+      const DecodedInstruction & decoded = AnalysisHelper::getDecoded(vi[i]);
+      if (decoded.load || decoded.store)
 	{
 	  assert(c->HasAttribute(ContextListAttributeName));
 	  const ContextList & contexts = (ContextList &) c->GetAttribute(ContextListAttributeName);
@@ -258,14 +256,13 @@ static bool CheckInstrHaveDataAddresses(Cfg * c, Node * n, void *param)
 	    {
 	      if (vi[i]->HasAttribute(AddressAttributeName) == false) return false;
 
-	      AddressAttribute attributeValue = (AddressAttribute &) vi[i]->GetAttribute(AddressAttributeName);
 	      string attributeName = AnalysisHelper::mkContextAttrName( AddressAttributeName, *context);
-
-	      if (vi[i]->HasAttribute(attributeName))
+	      if (!vi[i]->HasAttribute(attributeName))
 		{
-		  attributeValue = (AddressAttribute &) vi[i]->GetAttribute(attributeName);
+		  attributeName = AddressAttributeName;
 		}
-	      vector < AddressInfo > a = attributeValue.getListInfo();
+	      const AddressAttribute & attributeValue = (AddressAttribute &) vi[i]->GetAttribute(attributeName);
+	      const vector < AddressInfo > &a = attributeValue.getListInfo();
 	      //FIXME Not for contextual address information
 	      //if(a.size()<2){return false;} // at least one address for the code and one for the accessed data
 
@@ -312,7 +309,7 @@ static bool initL1AccessAttributeForData(Cfg * c, Node * n, void *param)
       vector < Instruction * >vi = n->GetAsm();
       for (size_t i = 0; i < vi.size(); i++)
 	{
-	  if (Arch::isLoad(vi[i]->GetCode()))
+	  if (AnalysisHelper::getDecoded(vi[i]).load)
 	    {
 	      vi[i]->SetAttribute(AnalysisHelper::mkContextAttrName(CACattName, currentContext), A);
 	    }
@@ -322,38 +319,31 @@ static bool initL1AccessAttributeForData(Cfg * c, Node * n, void *param)
 }
 
 // returns the data addresses accessed by an instruction in a context.
-set < t_address > DCacheAnalysis::getDataAddress(Instruction * instruction, Context * context)
+DataAccess DCacheAnalysis::getDataAddress(Instruction * instruction, Context * context)
 {
-  set < t_address > accessedBlocks;
-  string attributeName = AnalysisHelper::mkContextAttrName(AddressAttributeName, context);
+  DataAccess accessed;
+  AttributeKey attributeKey = addressKeys.get(context);
 
-  if (!instruction->HasAttribute(attributeName))
+  if (!instruction->HasAttribute(attributeKey))
     {
-      attributeName = AddressAttributeName;
+      attributeKey = addressKey;
     }  //stub: the accesses in the stack are contextual but the others
 
-  AddressAttribute & attributeValue = (AddressAttribute &) instruction->GetAttribute(attributeName);
-  vector < AddressInfo > a = attributeValue.getListInfo();
+  AddressAttribute & attributeValue = (AddressAttribute &) instruction->GetAttribute(attributeKey);
+  const vector < AddressInfo > &a = attributeValue.getListInfo();
 
   for (size_t i = 0; i < a.size(); i++)
     {
       if (a[i].getSegment() != "code")
 	{
-	  vector < pair < string, string > >addressRanges = a[i].getAdrSize();
-	  for (size_t j = 0; j < addressRanges.size(); j++)
+	  const AddressRanges & ranges = a[i].getRanges();
+	  for (size_t j = 0; j < ranges.size(); j++)
 	    {
-	      t_address from = atol(addressRanges[j].first.c_str());
-	      unsigned int range = atoi(addressRanges[j].second.c_str());
-	      int unsigned ifrom = (from - (from % cacheline_size));
-	      int unsigned ito = ((from + range - 1) - ((from + range - 1) % cacheline_size));
-	      for (t_address k = ifrom; k <= ito; k += cacheline_size)
-		{
-		  accessedBlocks.insert(k);
-		}
+	      accessed.ranges.push_back(ranges[j]);
 	    }
 	}
     }
-  return accessedBlocks;
+  return accessed;
 }
 
 //------------------------------------------------
@@ -373,11 +363,11 @@ bool static ComputeBlockCountAttribute(Cfg * c, Node * n, void *param)
       vector < Instruction * >vi = n->GetAsm();
       for (size_t i = 0; i < vi.size(); i++)
 	{
-	  if (Arch::isLoad(vi[i]->GetCode()))
+	  if (AnalysisHelper::getDecoded(vi[i]).load)
 	    {
-	      set < t_address > accessedBlocks = ca->getDataAddress(vi[i], (*context));
-	      assert(accessedBlocks.size() > 0);
-	      SerialisableIntegerAttribute blockCountAttribute(accessedBlocks.size());
+	      size_t nbBlocks = ca->getDataAddress(vi[i], (*context)).CountLines(ca->getLineSize());
+	      assert(nbBlocks > 0);
+	      SerialisableIntegerAttribute blockCountAttribute(nbBlocks);
 	      vi[i]->SetAttribute(att_name, blockCountAttribute);
 	    }
 	}
@@ -404,7 +394,7 @@ bool static StubFunction(Cfg * c, Node * n, void *param)
       vector < Instruction * >vi = n->GetAsm();
       for (size_t i = 0; i < vi.size(); i++)
 	{
-	  if (! Arch::isLoad(vi[i]->GetCode()))
+	  if (! AnalysisHelper::getDecoded(vi[i]).load)
 	    {
 	      vi[i]->SetAttribute(CHMCAttName, AUnref);
 	    }
@@ -414,15 +404,15 @@ bool static StubFunction(Cfg * c, Node * n, void *param)
 }
 
 
-template < typename T > void DCacheAnalysis::compute_ACS_out(ContextualNode & current, Instruction *vinstr, AbstractCache < T > &ACS_out, string idAccessName) 
+template < typename T > void DCacheAnalysis::compute_ACS_out(ContextualNode & current, Instruction *vinstr, AbstractCache < T > &ACS_out, AttributeKey idAccessName) 
 {
-  if (Arch::isLoad(vinstr->GetCode()))
+  if (AnalysisHelper::getDecoded(vinstr).load)
     {
       assert(vinstr->HasAttribute(idAccessName));
       string accessValue = ((SerialisableStringAttribute &) (vinstr->GetAttribute(idAccessName))).GetValue();
       if (accessValue != "N")
 	{
-	  set < t_address > add = getDataAddress(vinstr, current.context);
+	  DataAccess add = getDataAddress(vinstr, current.context);
 	  ACS_out.Update(add, accessValue);
     //ACS_out.Print();
 	}
@@ -430,19 +420,23 @@ template < typename T > void DCacheAnalysis::compute_ACS_out(ContextualNode & cu
 }
 
 /*
-   @return the ACS_out, for an analysis T, of a ContextualNode (current). The initial ACS_out is the given by the ACS_in of the current analysis provided by inAnalysisName for the context.
-   (inAnalysisName ::= ACSMUSTInName | ACSMAYInName | ACSPSInName )
+   @return the ACS_out, for an analysis T, of a ContextualNode (current). The initial ACS_out is the given by the ACS_in of the current analysis stored for the context.
+   (store ::= mustStore | mayStore | psStore )
+*/
+template < typename T > AbstractCache < T > DCacheAnalysis::compute_ACS_out(ContextualNode &current, AbstractCacheStateStore < T > &store)
+{
+  return compute_ACS_out<T> (current, store.getIn(current));
+}
+
+/*
+   @return the ACS_out, for an analysis T, of a ContextualNode (current) whose ACS_in is ACS_in (summary mode).
 */
-template < typename T > AbstractCache < T > DCacheAnalysis::compute_ACS_out(ContextualNode & current, string & inAnalysisName)
+template < typename T > AbstractCache < T > DCacheAnalysis::compute_ACS_out(ContextualNode &current, const AbstractCache < T > &ACS_in)
 {
-  string attributeAccessName = CACAttributeNameData(levelAnalysis);
-  string idCurrentContext = current.context->getStringId();
-  string idAccessName;
+  AttributeKey idAccessName = accessKeys.get(current.context);
 
-  AbstractCacheStateAttribute < T > &ca_attr_in = getACSContextualNode(T, current, inAnalysisName + idCurrentContext);
-  AbstractCache < T > ACS_out = ca_attr_in.cache;
+  AbstractCache < T > ACS_out = ACS_in;
 
-  idAccessName = AnalysisHelper::mkContextAttrName(attributeAccessName, idCurrentContext);
   vector < Instruction * >vi = current.node->GetAsm();
   //cout << "********This is Dache ComputerOut*********" << endl;
   for (size_t i = 0; i < vi.size(); i++)
@@ -465,205 +459,37 @@ static bool initACSMUST(Cfg * c, Node * n, void *param)
 {
   DCacheAnalysis *ca = (DCacheAnalysis *) param;
   AbstractCache < MUST > ACS_empty = ca->CacheFactoryMUST();
-  AbstractCacheStateAttribute < MUST > att(ACS_empty);
-
-  string in = ACSMUSTInName;
-  string out = ACSMUSTOutName;
+  AbstractCacheStateStore < MUST > &store = ca->getMustStore();
 
   assert(c->HasAttribute(ContextListAttributeName));
   const ContextList & contexts = (ContextList &) c->GetAttribute(ContextListAttributeName);
   for (ContextList::const_iterator context = contexts.begin(); context != contexts.end(); context++)
     {
-      string currentContext = (*context)->getStringId();
-      n->SetAttribute(in + currentContext, att);
-      n->SetAttribute(out + currentContext, att);
+      store.attach(ContextualNode(*context, n), ACS_empty);
     }
 
   return true;
 }
 
-/* FixPointMust1stStep analysis: Compute the ACS_out a set of nodes (work), without considering backedges.
-   @return a set of nodes for which the ACS_in must be computed. */
-set < ContextualNode > DCacheAnalysis::FixPointMust1stStep_ACS_out(set < ContextualNode > &work, set < Edge * >&backedges)
-{
-  string in = ACSMUSTInName;
-  string out = ACSMUSTOutName;
-  set < ContextualNode > work_in;
-
-  for (set < ContextualNode >::iterator it = work.begin(); it != work.end(); it++)
-    {
-      ContextualNode current = *it;
-      AbstractCache < MUST > ACS_out = compute_ACS_out < MUST > (current, in);
-
-      AbstractCacheStateAttribute < MUST > &ca_attr_out = getACSContextualNode(MUST, current, out + current.context->getStringId());
-      if (!ca_attr_out.cache.Equals(ACS_out))
-	{
-	  ca_attr_out.cache = ACS_out;
-	  AnalysisHelper::insertContextualSuccessorsExcludingBackEdges(current, work_in, backedges);
-	}
-    }
-  return work_in;
-}
-
-/* FixPointMust1stStep analysis: Compute the ACS_in of a set of nodes (work) without considering backedges.
-   @return a set of nodes for which the ACS_out must be computed. */
-set < ContextualNode > DCacheAnalysis::FixPointMust1stStep_ACS_in(set < ContextualNode > &work_in, set < Edge * >&backedges)
-{
-  string in = ACSMUSTInName;
-  string out = ACSMUSTOutName;
-  set < ContextualNode > work_out;
-  string idAttr;
-  bool b;
-  ContextualNode pred;
-
-  for (set < ContextualNode >::iterator it = work_in.begin(); it != work_in.end(); it++)
-    {
-      ContextualNode current = *it;
-
-      const vector < ContextualNode > &predecessors = GetContextualPredecessors(current);
-      assert(predecessors.size() != 0);	//it should not be the program's entry node
-
-      AbstractCache < MUST > new_ACS_in;
-      bool first = true;
-      for (size_t i = 0; i < predecessors.size(); i++)
-	{
-	  pred = predecessors[i];
-	  b = AnalysisHelper::FilterBackedge(current.node, pred.node, backedges);
-	  if (b)
-	    {
-	      idAttr = out + pred.context->getStringId();
-	      if (first)
-		{
-		  first = false;
-		  new_ACS_in = getACSContextualNode(MUST, pred, idAttr).cache;
-		}
-	      else
-		{
-		  new_ACS_in.Join( getACSContextualNode(MUST, pred, idAttr).cache);
-		}
-	    }
-	}
-
-      AbstractCacheStateAttribute < MUST > &ca_attr_in = getACSContextualNode(MUST, current, in + current.context->getStringId());
-
-      if (!ca_attr_in.cache.Equals(new_ACS_in))
-	{
-	  ca_attr_in.cache = new_ACS_in;
-	  work_out.insert(current);
-	}
-    }
-  return work_out;
-}
-
-
 /* First Step of the MUST analysis: Fixed point computation of MUST Abstract Cache States (ACS) without considering backedges.
    Remarks: Introduced for a precise classification of access performed inside loops.
    This approach avoids a bottom state in the ACS as defined in Ferdinand's Thesis.
 */
-bool DCacheAnalysis::FixPointMust1stStep()
+bool DCacheAnalysis::FixPointMust1stStep(Worklist & work)
 {
-  set < ContextualNode > work_in, work;
-
   AnalysisHelper::applyToAllNodesRecursive(p, initACSMUST, (void *)this);
   set < Edge * >backedges = AnalysisHelper::compute_backedges(p, call_graph); // getting the backedges.
-  work = AnalysisHelper::initWork();
- // AnalysisHelper::printSet(work,"DcacheFixPointInitalWork");
-  while (!work.empty())
-    {
-      work_in = FixPointMust1stStep_ACS_out(work, backedges);
-      // AnalysisHelper::printSet(work_in,"DcacheFixPointWork_In");
-      work.clear();
-      work = FixPointMust1stStep_ACS_in(work_in, backedges);
-      // AnalysisHelper::printSet(work,"DcacheFixPointWork***");
-      work_in.clear();
-    }
-
+  solveCacheFixPoint(*this, mustStore, AnalysisHelper::initWork(p), work, pool, &backedges);
   return true;
 }
 
-/* MustAnalysis analysis: Compute the ACS_out a set of nodes (work).
-   @return a set of nodes for which the ACS_in must be computed (all the nodes have to be visited at least once).*/
-set < ContextualNode > DCacheAnalysis::MustAnalysis_ACS_out(set < ContextualNode > &work, set < ContextualNode > &visited)
-{
-  string in = ACSMUSTInName;
-  string out = ACSMUSTOutName;
-  set < ContextualNode > work_in;
-  bool b;
-
-  for (set < ContextualNode >::iterator it = work.begin(); it != work.end(); it++)
-    {
-      ContextualNode current = *it;
-      AbstractCache < MUST > ACS_out = compute_ACS_out < MUST > (current, in);
-      AbstractCacheStateAttribute < MUST > &ca_attr_out = getACSContextualNode( MUST, current, out + current.context->getStringId());
-      b = !ca_attr_out.cache.Equals(ACS_out);
-      if (b) ca_attr_out.cache = ACS_out;
-      
-      //To force the visit of all nodes
-      if (visited.find(current) == visited.end())
-	{
-	  visited.insert(current);
-	  b = true;
-	}
-      if (b) AnalysisHelper::insertContextualSuccessors(current, work_in);
-    }
-  return work_in;
-}
-
-/* MustAnalysis: Compute the ACS_in of a set of nodes (work). 
-   @return a set of nodes for which the ACS_out must be computed (all the nodes have to be visited at least once). */
-set < ContextualNode > DCacheAnalysis::MustAnalysis_ACS_in(set < ContextualNode > &work_in, set < ContextualNode > &visited)
-{
-  bool b;
-  string in = ACSMUSTInName;
-  string out = ACSMUSTOutName;
-  set < ContextualNode > work_out;
-
-  for (set < ContextualNode >::iterator it = work_in.begin(); it != work_in.end(); it++)
-    {
-      ContextualNode current = *it;
-
-      const vector < ContextualNode > &predecessors = GetContextualPredecessors(current);
-      assert(predecessors.size() != 0);	//it should not be the program's entry node
-
-      AbstractCache < MUST > new_ACS_in = getACSContextualNode( MUST, predecessors[0], out + predecessors[0].context->getStringId()).cache;
-      for (size_t i = 1; i < predecessors.size(); i++)
-	{
-	  new_ACS_in.Join(getACSContextualNode (MUST, predecessors[i], out + predecessors[i].context->getStringId()).cache);
-	}
-
-      AbstractCacheStateAttribute < MUST > &ca_attr_in = getACSContextualNode(MUST, current, in + current.context->getStringId());
-      b = ! ca_attr_in.cache.Equals(new_ACS_in);
-      if (b) ca_attr_in.cache = new_ACS_in;
-      // To force the visit of all nodes
-      b = b || (visited.find(current) == visited.end());
-      if (b) work_out.insert(current);
-    }
-  return work_out;
-}
-
-
-
 /* MUST ANALYSIS.
    Fixed point computation of MUST Abstract Cache States (ACS).
    All nodes have to be visited at least once. */
-bool DCacheAnalysis::MustAnalysis()
+bool DCacheAnalysis::MustAnalysis(Worklist & work)
 {
-  set < ContextualNode > work, visited, work_in;
-
-  FixPointMust1stStep();
-  work = AnalysisHelper::initWork();
-  // AnalysisHelper::printSet(work,"DcacheInitalMustAnalysisWork");
-  while (!work.empty())
-    {
-      // AnalysisHelper::printSet(work, "DCacheAnalysis"); // debug
-      work_in = MustAnalysis_ACS_out(work, visited);
-      // AnalysisHelper::printSet(work_in,"DcacheMustAnalysisWork_in");
-      work.clear();
-      work = MustAnalysis_ACS_in(work_in, visited);
-      // AnalysisHelper::printSet(work,"DcacheMustAnalysisWork****");
-      work_in.clear();
-    }
-
+  FixPointMust1stStep(work);
+  solveCacheFixPoint(*this, mustStore, AnalysisHelper::initWork(p), work, pool);
   return true;
 }
 
@@ -678,8 +504,7 @@ bool static ClassifCHMCMust(Cfg * c, Node * n, void *param)
   SerialisableStringAttribute AUnref("AU");	// Always-unreferenced to consider WCET cost = 0
   DCacheAnalysis *ca = (DCacheAnalysis *) param;
   string CHMCAttName = CHMCAttributeNameData(ca->getLevelAnalysis());
-  string in = ACSMUSTInName;
-  string out = ACSMUSTOutName;
+  AbstractCacheStates < MUST > &store = ca->getMustStates();
 
   assert(c->HasAttribute(ContextListAttributeName));
   const ContextList & contexts = (ContextList &) c->GetAttribute(ContextListAttributeName);
@@ -688,13 +513,14 @@ bool static ClassifCHMCMust(Cfg * c, Node * n, void *param)
       string currentContext = (*context)->getStringId();
       string CACattName = AnalysisHelper::mkContextAttrName(CACAttributeNameData(ca->getLevelAnalysis()), currentContext);
 
-      assert(n->HasAttribute(in + currentContext));
-      AbstractCache < MUST > ca_must = getACSNode(MUST, n, in + currentContext).cache;
+      ContextualNode cn(*context, n);
+      assert(store.has(cn));
+      AbstractCache < MUST > ca_must = store.getIn(cn);
 
       vector < Instruction * >vi = n->GetAsm();
       for (size_t i = 0; i < vi.size(); i++)
 	{
-	  if (Arch::isLoad(vi[i]->GetCode()))
+	  if (AnalysisHelper::getDecoded(vi[i]).load)
 	    {
 	      assert(vi[i]->HasAttribute(CACattName));
 	      string accessValue = ((SerialisableStringAttribute &) (vi[i]->GetAttribute(CACattName))).GetValue();
@@ -705,7 +531,7 @@ bool static ClassifCHMCMust(Cfg * c, Node * n, void *param)
 		}
 	      else
 		{
-		  set < t_address > add = ca->getDataAddress(vi[i], (*context));
+		  DataAccess add = ca->getDataAddress(vi[i], (*context));
 		  if (ca_must.AllPresent(add))	//if all present: AH
 		    {
 		      vi[i]->SetAttribute(id, AHatt);
@@ -715,10 +541,6 @@ bool static ClassifCHMCMust(Cfg * c, Node * n, void *param)
 		}
 	    }
 	}
-
-      // Remove the ACS_in and ACS_out attributes
-      n->RemoveAttribute(in + currentContext);
-      n->RemoveAttribute(out + currentContext);
     }
   return true;
 }
@@ -734,105 +556,27 @@ bool static initACSMAY(Cfg * c, Node * n, void *param)
 {
   DCacheAnalysis *ca = (DCacheAnalysis *) param;
   AbstractCache < MAY > ACS_empty = ca->CacheFactoryMAY();
-  AbstractCacheStateAttribute < MAY > att(ACS_empty);
-
-  string in = ACSMAYInName;
-  string out = ACSMAYOutName;
+  AbstractCacheStateStore < MAY > &store = ca->getMayStore();
 
   assert(c->HasAttribute(ContextListAttributeName));
   const ContextList & contexts = (ContextList &) c->GetAttribute(ContextListAttributeName);
   for (ContextList::const_iterator context = contexts.begin(); context != contexts.end(); context++)
     {
-      string currentContext = (*context)->getStringId();
-      n->SetAttribute(in + currentContext, att);
-      n->SetAttribute(out + currentContext, att);
+      store.attach(ContextualNode(*context, n), ACS_empty);
     }
 
   return true;
 }
 
-/* MayAnalysis analysis: Compute the ACS_out a set of nodes (work).
-   @return a set of nodes for which the ACS_in must be computed (all the nodes have to be visited at least once).*/
-set < ContextualNode > DCacheAnalysis::MayAnalysis_ACS_out(set < ContextualNode > &work, set < ContextualNode > &visited)
-{
-  string in = ACSMAYInName;
-  string out = ACSMAYOutName;
-  string attributeAccessName = CACAttributeNameData(levelAnalysis);
-
-  set < ContextualNode > work_in;
-
-  //compute ACS_out
-  for (set < ContextualNode >::iterator it = work.begin(); it != work.end(); it++)
-    {
-      ContextualNode current = *it;
-
-      AbstractCache < MAY > ACS_out = compute_ACS_out < MAY > (current, in);
-      AbstractCacheStateAttribute < MAY > &ca_attr_out =getACSContextualNode(MAY, current, out + current.context->getStringId());
-      bool b = ! ca_attr_out.cache.Equals(ACS_out);
-      if (b) ca_attr_out.cache = ACS_out;
-
-      //To force the visit of all nodes
-      if (visited.find(current) == visited.end())
-	{
-	  visited.insert(current);
-	  b = true;
-	}
-
-      if (b) AnalysisHelper::insertContextualSuccessors(current, work_in);
-
-    }
-  return work_in;
-}
-
-/* MayAnalysis: Compute the ACS_in of a set of nodes (work). 
-   @return a set of nodes for which the ACS_out must be computed (all the nodes have to be visited at least once). */
-set < ContextualNode > DCacheAnalysis::MayAnalysis_ACS_in(set < ContextualNode > &work_in, set < ContextualNode > &visited)
-{
-  string in = ACSMAYInName;
-  string out = ACSMAYOutName;
-  set < ContextualNode > work;
-
-  for (set < ContextualNode >::iterator it = work_in.begin(); it != work_in.end(); it++)
-    {
-      ContextualNode current = *it;
-      const vector < ContextualNode > &predecessors = GetContextualPredecessors(current);
-      assert(predecessors.size() != 0);	//it should not be the program's entry node
-
-      AbstractCache < MAY > new_ACS_in =getACSContextualNode (MAY, predecessors[0], out + predecessors[0].context->getStringId()).cache;
-      for (size_t i = 1; i < predecessors.size(); i++)
-	{
-	  new_ACS_in.Join(getACSContextualNode(MAY, predecessors[i], out + predecessors[i].context->getStringId()).cache);
-	}
-
-      AbstractCacheStateAttribute < MAY > &ca_attr_in =getACSContextualNode ( MAY, current, in + current.context->getStringId());
-      bool b = ! ca_attr_in.cache.Equals(new_ACS_in);
-      if (b) { ca_attr_in.cache = new_ACS_in; }
-
-      // To force the visit of all nodes
-      b = b || (visited.find(current) == visited.end());
-      if (b) work.insert(current);
-    }
-  return work;
-}
-
 /*
   MAY ANALYSIS.
   Fixed point computation of MAY Abstract Cache States (ACS).
   All nodes have to be visited at least once.
 */
-bool DCacheAnalysis::MayAnalysis()
+bool DCacheAnalysis::MayAnalysis(Worklist & work)
 {
-  set < ContextualNode > visited, work_in, work;
-
   AnalysisHelper::applyToAllNodesRecursive(p, initACSMAY, (void *)this);
-  work = AnalysisHelper::initWork();
-  while (!work.empty())
-    {
-      work_in = MayAnalysis_ACS_out(work, visited);
-      work.clear();
-      work = MayAnalysis_ACS_in(work_in, visited);
-      work_in.clear();
-    }
+  solveCacheFixPoint(*this, mayStore, AnalysisHelper::initWork(p), work, pool);
   return true;
 }
 
@@ -847,8 +591,7 @@ bool static ClassifCHMCMay(Cfg * c, Node * n, void *param)
   SerialisableStringAttribute AUnref("AU");	// Always-unreferenced to consider WCET cost = 0
   DCacheAnalysis *ca = (DCacheAnalysis *) param;
   string CHMCAttName = CHMCAttributeNameData(ca->getLevelAnalysis());
-  string in = ACSMAYInName;
-  string out = ACSMAYOutName;
+  AbstractCacheStates < MAY > &store = ca->getMayStates();
 
   assert(c->HasAttribute(ContextListAttributeName));
   const ContextList & contexts = (ContextList &) c->GetAttribute(ContextListAttributeName);
@@ -857,13 +600,14 @@ bool static ClassifCHMCMay(Cfg * c, Node * n, void *param)
       string currentContext = (*context)->getStringId();
       string CACattName = AnalysisHelper::mkContextAttrName( CACAttributeNameData(ca->getLevelAnalysis()), currentContext);
 
-      assert(n->HasAttribute(in + currentContext));
-      AbstractCache < MAY > ca_may = getACSNode(MAY, n, in + currentContext).cache;
+      ContextualNode cn(*context, n);
+      assert(store.has(cn));
+      AbstractCache < MAY > ca_may = store.getIn(cn);
 
       vector < Instruction * >vi = n->GetAsm();
       for (size_t i = 0; i < vi.size(); i++)
 	{
-	  if (Arch::isLoad(vi[i]->GetCode()))
+	  if (AnalysisHelper::getDecoded(vi[i]).load)
 	    {
 	      string id = AnalysisHelper::mkContextAttrName( CHMCAttName, currentContext);
 	      if (!vi[i]->HasAttribute(id))	//if the chmc attribute was not set by the MUST or the PS analysis
@@ -877,7 +621,7 @@ bool static ClassifCHMCMay(Cfg * c, Node * n, void *param)
 		    }
 		  else
 		    {
-		      set < t_address > add = ca->getDataAddress(vi[i], (*context));
+		      DataAccess add = ca->getDataAddress(vi[i], (*context));
 		      if (!ca_may.OnePresent(add))	//if all absent: AM
 			{
 			  vi[i]->SetAttribute(id, AMatt);
@@ -888,10 +632,6 @@ bool static ClassifCHMCMay(Cfg * c, Node * n, void *param)
 		}
 	    }
 	}
-
-      // Remove the ACS_in and ACS_out attributes
-      n->RemoveAttribute(in + currentContext);
-      n->RemoveAttribute(out + currentContext);
     }
   return true;
 }
@@ -915,12 +655,10 @@ bool static ClassifCHMCMay(Cfg * c, Node * n, void *param)
 
 set < ContextualNode > initACSPS(Program * p, DCacheAnalysis * a)
 {
-  string in = ACSPSInName;
-  string out = ACSPSOutName;
+  AbstractCacheStateStore < PS > &store = a->getPSStore();
   set < ContextualNode > result;
 
   AbstractCache < PS > abstractCache = a->CacheFactoryPS();
-  AbstractCacheStateAttribute < PS > ca(abstractCache);
 
   vector < Cfg * >cfgs = p->GetAllCfgs();
 
@@ -934,7 +672,6 @@ set < ContextualNode > initACSPS(Program * p, DCacheAnalysis * a)
 	  for (ContextList::const_iterator context_it = contexts.begin(); context_it != contexts.end(); context_it++)
 	    {
 	      Context *context = *context_it;
-	      string context_id = context->getStringId();
 
 	      if (AnalysisHelper::CallerInLoop(context))	//if the current context is called in a loop
 		{
@@ -942,33 +679,12 @@ set < ContextualNode > initACSPS(Program * p, DCacheAnalysis * a)
 		  for (size_t j = 0; j < nodes.size(); j++)
 		    {
 		      // Attach the attribute to all nodes in the cfg.
-		      nodes[j]->SetAttribute(in + context_id, ca);
-		      nodes[j]->SetAttribute(out + context_id, ca);
+		      store.attach(ContextualNode(context, nodes[j]), abstractCache);
 		    }
 		}
 	      else
 		{
-		  vector < Loop * >loops = cfgs[i]->GetAllLoops();
-		  vector < Loop * >loopsOuter;
-
-		  //get only the outers loops of the current cfg
-		  for (size_t k = 0; k < loops.size(); k++)
-		    {
-		      bool found = false;
-		      for (size_t j = 0; j < loops.size() && !found; j++)
-			{
-			  if (k != j && loops[k]->IsNestedIn(loops[j]))
-			    {
-			      found = true;
-			    }	//loop k is nested in loop j
-			}
-		      if (!found)
-			{
-			  loopsOuter.push_back(loops[k]);
-			}	//loop k is not nested in other loop
-		    }
-		  //now loopOuter contains only the loop not nested
-
+		  vector < Loop * >loopsOuter = AnalysisHelper::getOuterLoops(cfgs[i]);
 		  for (size_t j = 0; j < loopsOuter.size(); ++j)
 		    {
 		      ContextualNode cn(context, loopsOuter[j]->GetHead());
@@ -978,8 +694,7 @@ set < ContextualNode > initACSPS(Program * p, DCacheAnalysis * a)
 		      for (size_t k = 0; k < nodes.size(); ++k)
 			{
 			  // Attach the attribute to all nodes in the loop.
-			  nodes[k]->SetAttribute(in + context_id, ca);
-			  nodes[k]->SetAttribute(out + context_id, ca);
+			  store.attach(ContextualNode(context, nodes[k]), abstractCache);
 			}
 		    }
 		}
@@ -989,109 +704,13 @@ set < ContextualNode > initACSPS(Program * p, DCacheAnalysis * a)
   return result;
 }
 
-/* PSAnalysis: Compute the ACS_out of a set of nodes (work).
-   @return a set of nodes for which the ACS_in must be computed (all the nodes have to be visited at least once). */
-set < ContextualNode > DCacheAnalysis::PSAnalysis_ACS_out(set < ContextualNode > &work, set < ContextualNode > &visited)
-{
-  string in = ACSPSInName;
-  string out = ACSPSOutName;
-  set < ContextualNode > work_in;
-  string attributeAccessName = CACAttributeNameData(levelAnalysis);
-
-  for (set < ContextualNode >::iterator it = work.begin(); it != work.end(); it++)
-    {
-      ContextualNode current = *it;
-      AbstractCache < PS > ACS_out = compute_ACS_out < PS > (current, in);
-
-      AbstractCacheStateAttribute < PS > &ca_attr_out = getACSContextualNode(PS, current, out + current.context->getStringId());
-      bool b = ! ca_attr_out.cache.Equals(ACS_out);
-      if (b) ca_attr_out.cache = ACS_out;
-
-      // To force the visit of all nodes
-      if (visited.find(current) == visited.end())
-	{
-	  b = true;
-	  visited.insert(current);
-	}
-
-      if (b)
-	{
-	  vector < ContextualNode > succ = GetContextualSuccessors(current);
-	  for (size_t i = 0; i < succ.size(); i++)
-	    {
-	      // A successor is added only if it is present in the loop
-	      if (succ[i].node->HasAttribute(in + succ[i].context->getStringId())) 
-		{
-		  work_in.insert(succ[i]);
-		}
-	    }
-	}
-    }
-  return work_in;
-}
-
-/* PSAnalysis: Compute the ACS_in of a set of nodes (work). 
-   @return a set of nodes for which the ACS_out must be computed (all the nodes have to be visited at least once). */
-set < ContextualNode > DCacheAnalysis::PSAnalysis_ACS_in(set < ContextualNode > &work_in, set < ContextualNode > &visited)
-{
-  string in = ACSPSInName;
-  string out = ACSPSOutName;
-  set < ContextualNode > work;
-
-  for (set < ContextualNode >::iterator it = work_in.begin(); it != work_in.end(); it++)
-    {
-      ContextualNode current = *it;
-
-      const vector < ContextualNode > &predecessors = GetContextualPredecessors(current);
-      assert(predecessors.size() != 0);	//it should not be the program's entry node
-
-      AbstractCache < PS > new_ACS_in;
-      bool first = true;
-      for (size_t i = 0; i < predecessors.size(); i++)
-	{
-	  if (predecessors[i].node->HasAttribute(out + predecessors[i].context->getStringId()))
-	    {
-	      if (first)
-		{
-		  first = false;
-		  new_ACS_in =getACSContextualNode(PS, predecessors[i], out + predecessors[i].context->getStringId()).cache;
-		}
-	      else
-		{
-		  new_ACS_in.Join(getACSContextualNode( PS, predecessors[i], out + predecessors[i].context->getStringId()).cache);
-		}
-	    }
-	}
-
-      AbstractCacheStateAttribute < PS > &ca_attr_in =getACSContextualNode(PS, current, in + current.context->getStringId());
-      bool b = ! ca_attr_in.cache.Equals(new_ACS_in);
-      if (b) ca_attr_in.cache = new_ACS_in;
-
-      // To force the visit of all nodes
-      b = b || (visited.find(current) == visited.end());
-      if (b) work.insert(current);
-
-    }
-  return work;
-}
-
 /* PS ANALYSIS.
     Fixed point computation of PS Abstract Cache States (ACS).
     All the nodes have to be visited at least once.
 */
-bool DCacheAnalysis::PSAnalysis()
+bool DCacheAnalysis::PSAnalysis(Worklist & work)
 {
-  set < ContextualNode > work, work_in, visited;
-
-  work = initACSPS(p, this);
-  while (!work.empty())
-    {
-      work_in = PSAnalysis_ACS_out(work, visited);
-      work.clear();
-      work = PSAnalysis_ACS_in(work_in, visited);
-      work_in.clear();
-    }
-
+  solveCacheFixPoint(*this, psStore, initACSPS(p, this), work, pool);
   return true;
 }
 
@@ -1110,8 +729,7 @@ bool static ClassifCHMCPS(Cfg * c, Node * n, void *param)
   SerialisableStringAttribute AUnref("AU");	// Always-unreferenced to consider WCET cost = 0
   DCacheAnalysis *ca = (DCacheAnalysis *) param;
   string CHMCAttName = CHMCAttributeNameData(ca->getLevelAnalysis());
-  string in = ACSPSInName;
-  string out = ACSPSOutName;
+  AbstractCacheStates < PS > &store = ca->getPSStates();
 
   assert(c->HasAttribute(ContextListAttributeName));
   const ContextList & contexts = (ContextList &) c->GetAttribute(ContextListAttributeName);
@@ -1120,14 +738,15 @@ bool static ClassifCHMCPS(Cfg * c, Node * n, void *param)
       string currentContext = (*context)->getStringId();
       string CACattName = AnalysisHelper::mkContextAttrName( CACAttributeNameData(ca->getLevelAnalysis()), currentContext);
 
-      if (n->HasAttribute(in + currentContext))
+      ContextualNode cn(*context, n);
+      if (store.has(cn))
 	{
-	  AbstractCache < PS > ca_ps = getACSNode(PS, n, in + currentContext).cache;
+	  AbstractCache < PS > ca_ps = store.getIn(cn);
 
 	  vector < Instruction * >vi = n->GetAsm();
 	  for (size_t i = 0; i < vi.size(); i++)
 	    {
-	      if (Arch::isLoad(vi[i]->GetCode()))
+	      if (AnalysisHelper::getDecoded(vi[i]).load)
 		{
 		  string id=AnalysisHelper::mkContextAttrName( CHMCAttName, currentContext);
 		  if (!vi[i]->HasAttribute(id))	//if the chmc attribute was not set by the MUST analysis
@@ -1141,7 +760,7 @@ bool static ClassifCHMCPS(Cfg * c, Node * n, void *param)
 			}
 		      else
 			{
-			  set < t_address > add = ca->getDataAddress(vi[i], (*context));
+			  DataAccess add = ca->getDataAddress(vi[i], (*context));
 			  if (ca_ps.AllPresent(add))	//if all present: FM
 			    {
 			      vi[i]->SetAttribute(id , FMatt);
@@ -1152,10 +771,6 @@ bool static ClassifCHMCPS(Cfg * c, Node * n, void *param)
 		    }
 		}
 	    }
-
-	  //remove the ACS_in and ACS_out attributes
-	  n->RemoveAttribute(in + currentContext);
-	  n->RemoveAttribute(out + currentContext);
 	}
     }
   return true;
@@ -1178,7 +793,7 @@ void static ClassifCHMC(Cfg * c, Node * n, string vclassif, string CHMCAttName )
       vector < Instruction * >vi = n->GetAsm();
       for (size_t i = 0; i < vi.size(); i++)
 	{
-	  if (Arch::isLoad(vi[i]->GetCode()))
+	  if (AnalysisHelper::getDecoded(vi[i]).load)
 	    {
 	      if (!vi[i]->HasAttribute(curAttr))	// if not set by the MUST, PS or MAY analysis
 		{
@@ -1232,7 +847,7 @@ bool static ClassifCACNext(Cfg * c, Node * n, void *param)
       vector < Instruction * >vi = n->GetAsm();
       for (size_t i = 0; i < vi.size(); i++)
 	{
-	  if (Arch::isLoad(vi[i]->GetCode()))
+	  if (AnalysisHelper::getDecoded(vi[i]).load)
 	    {
 	      assert(vi[i]->HasAttribute(cur_CHMCAttName));
 	      string chmcValue = ((SerialisableStringAttribute &) (vi[i]->GetAttribute(cur_CHMCAttName))).GetValue();
@@ -1247,6 +862,36 @@ bool static ClassifCACNext(Cfg * c, Node * n, void *param)
   return true;
 }
 
+/*************************************************************************************************************************
+ Summary mode
+*************************************************************************************************************************/
+
+bool DCacheAnalysis::sameAccesses(Context * a, Context * b)
+{
+  if (a == b) return true;
+
+  AttributeKey idAccessA = accessKeys.get(a);
+  AttributeKey idAccessB = accessKeys.get(b);
+  vector < Node * >nodes = a->getCurrentFunction()->GetAllNodes();
+  for (size_t i = 0; i < nodes.size(); i++)
+    {
+      vector < Instruction * >vi = nodes[i]->GetAsm();
+      for (size_t j = 0; j < vi.size(); j++)
+	{
+	  if (!AnalysisHelper::getDecoded(vi[j]).load) continue;
+	  if (levelAnalysis != 1 &&	// L1: CAC=A for each access
+	      ((SerialisableStringAttribute &) vi[j]->GetAttribute(idAccessA)).GetValue() !=
+	      ((SerialisableStringAttribute &) vi[j]->GetAttribute(idAccessB)).GetValue())
+	    return false;
+	  if (getDataAddress(vi[j], a) != getDataAddress(vi[j], b))	// e.g. stack accesses
+	    return false;
+	}
+      if (nodes[i]->IsCall() && !sameAccesses(a->getCalleeContext(nodes[i]), b->getCalleeContext(nodes[i])))
+	return false;
+    }
+  return true;
+}
+
 /*************************************************************************************************************************
  Generic analysis functions
 *************************************************************************************************************************/
@@ -1262,6 +907,21 @@ bool DCacheAnalysis::PerformAnalysis()
       AnalysisHelper::applyToAllNodesRecursive(p, initL1AccessAttributeForData, NULL);
     }
 
+  // Numbering of the contextual nodes, for the ACS stores,
+  // and their evaluation order in the fixed point computations
+  const ContextTree & contextTree = (ContextTree &) p->GetAttribute(ContextTreeAttributeName);
+  nodeIndex.build(contextTree);
+  nodeOrder.build(contextTree, nodeIndex, *AnalysisHelper::initWork(p).begin());
+
+  // Parallel analysis of groups of cache sets: the names of the contextual attributes
+  // read by the threads are interned beforehand
+  if (nb_threads > 1 && nb_sets > 1 && !summary_mode)
+    {
+      pool = new ThreadPool(nb_threads);
+      accessKeys.internAll(contextTree);
+      addressKeys.internAll(contextTree);
+    }
+
   float time = 0.0;
   //------------------------
   // MUST analysis
@@ -1270,12 +930,31 @@ bool DCacheAnalysis::PerformAnalysis()
     {
       Timer timer_must;
       timer_must.initTimer();
-      MustAnalysis();
-      AnalysisHelper::applyToAllNodesRecursive(p, ClassifCHMCMust, (void *)this);
-      timer_must.addTimer(time);
-      stringstream infostr;
-      infostr << "DcacheAnalysis: MUST done: " << time;
-      Logger::addInfo(infostr.str());
+      if (summary_mode)
+	{
+	  set < Edge * >backedges = AnalysisHelper::compute_backedges(p, call_graph);
+	  CacheSummaryStore < MUST, DCacheAnalysis > summaries(*this, nodeIndex, nodeOrder, CacheFactoryMUST(), call_string_depth, true, &backedges);
+	  summaries.analyseProgram(contextTree);
+	  mustStates = &summaries;
+	  AnalysisHelper::applyToAllNodesRecursive(p, ClassifCHMCMust, (void *)this);
+	  mustStates = &mustStore;
+	  timer_must.addTimer(time);
+	  stringstream infostr;
+	  infostr << "DcacheAnalysis: MUST done: " << time << " (" << summaries.getReport(contextTree) << ")";
+	  Logger::addInfo(infostr.str());
+	}
+      else
+	{
+	  mustStore.init(nodeIndex);
+	  Worklist work(nodeOrder);
+	  MustAnalysis(work);
+	  AnalysisHelper::applyToAllNodesRecursive(p, ClassifCHMCMust, (void *)this);
+	  mustStore.clear();
+	  timer_must.addTimer(time);
+	  stringstream infostr;
+	  infostr << "DcacheAnalysis: MUST done: " << time << " (" << work.getNbOutEvaluations() << " node evaluations, " << work.getNbInEvaluations() << " joins)";
+	  Logger::addInfo(infostr.str());
+	}
     }
   //------------------------
   // PS analysis
@@ -1285,12 +964,30 @@ bool DCacheAnalysis::PerformAnalysis()
       time = 0.0;
       Timer timer_ps;
       timer_ps.initTimer();
-      PSAnalysis();
-      AnalysisHelper::applyToAllNodesRecursive(p, ClassifCHMCPS, (void *)this);
-      timer_ps.addTimer(time);
-      stringstream infostr;
-      infostr << "DcacheAnalysis: PS done: " << time;
-      Logger::addInfo(infostr.str());
+      if (summary_mode)
+	{
+	  CacheSummaryStore < PS, DCacheAnalysis > summaries(*this, nodeIndex, nodeOrder, CacheFactoryPS(), call_string_depth, false);
+	  summaries.analyseLoops(contextTree, call_graph);
+	  psStates = &summaries;
+	  AnalysisHelper::applyToAllNodesRecursive(p, ClassifCHMCPS, (void *)this);
+	  psStates = &psStore;
+	  timer_ps.addTimer(time);
+	  stringstream infostr;
+	  infostr << "DcacheAnalysis: PS done: " << time << " (" << summaries.getReport(contextTree) << ")";
+	  Logger::addInfo(infostr.str());
+	}
+      else
+	{
+	  psStore.init(nodeIndex);
+	  Worklist work(nodeOrder);
+	  PSAnalysis(work);
+	  AnalysisHelper::applyToAllNodesRecursive(p, ClassifCHMCPS, (void *)this);
+	  psStore.clear();
+	  timer_ps.addTimer(time);
+	  stringstream infostr;
+	  infostr << "DcacheAnalysis: PS done: " << time << " (" << work.getNbOutEvaluations() << " node evaluations, " << work.getNbInEvaluations() << " joins)";
+	  Logger::addInfo(infostr.str());
+	}
     }
   //------------------------
   // MAY analysis
@@ -1300,12 +997,30 @@ bool DCacheAnalysis::PerformAnalysis()
       time = 0.0;
       Timer timer_may;
       timer_may.initTimer();
-      MayAnalysis();
-      AnalysisHelper::applyToAllNodesRecursive(p, ClassifCHMCMay, (void *)this);
-      timer_may.addTimer(time);
-      stringstream infostr;
-      infostr << "DcacheAnalysis: MAY done: " << time;
-      Logger::addInfo(infostr.str());
+      if (summary_mode)
+	{
+	  CacheSummaryStore < MAY, DCacheAnalysis > summaries(*this, nodeIndex, nodeOrder, CacheFactoryMAY(), call_string_depth, true);
+	  summaries.analyseProgram(contextTree);
+	  mayStates = &summaries;
+	  AnalysisHelper::applyToAllNodesRecursive(p, ClassifCHMCMay, (void *)this);
+	  mayStates = &mayStore;
+	  timer_may.addTimer(time);
+	  stringstream infostr;
+	  infostr << "DcacheAnalysis: MAY done: " << time << " (" << summaries.getReport(contextTree) << ")";
+	  Logger::addInfo(infostr.str());
+	}
+      else
+	{
+	  mayStore.init(nodeIndex);
+	  Worklist work(nodeOrder);
+	  MayAnalysis(work);
+	  AnalysisHelper::applyToAllNodesRecursive(p, ClassifCHMCMay, (void *)this);
+	  mayStore.clear();
+	  timer_may.addTimer(time);
+	  stringstream infostr;
+	  infostr << "DcacheAnalysis: MAY done: " << time << " (" << work.getNbOutEvaluations() << " node evaluations, " << work.getNbInEvaluations() << " joins)";
+	  Logger::addInfo(infostr.str());
+	}
     }
 
   if (perfectDcache)
@@ -1330,6 +1045,9 @@ bool DCacheAnalysis::PerformAnalysis()
   //------------------------
   AnalysisHelper::applyToAllNodesRecursive(p, ClassifCACNext, (void *)this);
 
+  delete pool;
+  pool = NULL;
+
   return true;
 }
 
@@ -1365,7 +1083,10 @@ bool DCacheAnalysis::CheckInputAttributes()
 // and cac_computation map initialization
 //------------------------------------------------
  DCacheAnalysis::DCacheAnalysis(Program * p, int nbsets, int nbways, int cachelinesize, t_replacement_policy r, int levelCache, 
-				bool apply_must, bool apply_persistence, bool apply_may, bool pdcache):Analysis (p)
+				bool apply_must, bool apply_persistence, bool apply_may, bool pdcache, int nbthreads, bool summary, int callstringdepth):Analysis (p),
+  accessKeys (AnalysisHelper::mkContextAttrName (CACAttributeNameData(levelCache), "")),
+  addressKeys (AnalysisHelper::mkContextAttrName (AddressAttributeName, "")),
+  addressKey (AddressAttributeName)
 {
   perfectDcache = pdcache;
   nb_sets = nbsets;
@@ -1373,6 +1094,13 @@ bool DCacheAnalysis::CheckInputAttributes()
   cacheline_size = cachelinesize;
   replacement_policy = r;
   levelAnalysis = levelCache;
+  nb_threads = (nbthreads > 1) ? nbthreads : 1;
+  pool = NULL;
+  summary_mode = summary;
+  call_string_depth = callstringdepth;
+  mustStates = &mustStore;
+  mayStates = &mayStore;
+  psStates = &psStore;
 
   if (perfectDcache)
     {
@@ -29,7 +29,7 @@
 #include "Generic/Analysis.h"
 #include "Specific/CacheAnalysis/Cache.h"
 #include "Specific/CacheAnalysis/CacheAnalysis.h"
-
+#include "Specific/CacheAnalysis/CacheSummary.h"
 
 #include "Generic/CallGraph.h"
 #include "Generic/ContextHelper.h"
@@ -64,6 +64,10 @@
    - Scope-aware data cache analysis for WCET estimation. B. K. Huynh, L. Ju, and A. Roychoudhury. RTAS 2011. (for the persistence analysis)
    - Timing predictability of cache replacement policies. J. Reineke, D. Grund, C. Berg, and R. Wilhelm. RTSJ 2007 (for the replacement policies)
    - WCET analysis of multi-level non-inclusive set-associative instruction caches. D. Hardy, I. Puaut. RTSS 2008 (for the cache hierarchy)
+
+   In the summary mode, the fixed points are computed per function and entry ACS instead of
+   per context (see CacheSummaryStore), as for the instruction caches. Two contexts of a function
+   share a summary only when their loads access the same data addresses.
 */
 class DCacheAnalysis: public Analysis
 {
@@ -82,61 +86,95 @@ private:
   /** multilevel analysis: current level */
   int levelAnalysis;
 
+  /** Interned names of the contextual attributes read by the fixed point computations
+      (access classification of the level, data addresses) */
+  ContextualAttributeKeys accessKeys, addressKeys;
+  AttributeKey addressKey;	///< non contextual data addresses
+
+  /** Numbering and evaluation order of the contextual nodes, and ACS of the MUST, MAY and PS analyses (valid during an analysis only) */
+  ContextualNodeIndex nodeIndex;
+  ContextualNodeOrder nodeOrder;
+  AbstractCacheStateStore < MUST > mustStore;
+  AbstractCacheStateStore < MAY > mayStore;
+  AbstractCacheStateStore < PS > psStore;
+
+  /** Summary mode: the functions are analysed once per entry ACS (see CacheSummaryStore),
+      with call strings bounded to call_string_depth calls (unbounded when -1) */
+  bool summary_mode;
+  int call_string_depth;
+
+  /** ACS_in read by the classification functions: the stores above, or the summaries in the summary mode */
+  AbstractCacheStates < MUST > *mustStates;
+  AbstractCacheStates < MAY > *mayStates;
+  AbstractCacheStates < PS > *psStates;
+
+  /** Parallel analysis: number of threads analysing groups of cache sets (1: sequential analysis),
+      and their pool (valid during an analysis only, NULL for a sequential analysis) */
+  unsigned int nb_threads;
+  ThreadPool *pool;
+
   /** Program call graph (used for detection of dead code to speed up the analysis) */
   CallGraph *call_graph;
 
   /** First Step of the MUST analysis: Fixed point computation of MUST Abstract Cache States (ACS) without considering backedges. */
-  bool FixPointMust1stStep ();
+  bool FixPointMust1stStep (Worklist & work);
 
   /** Fixed point computation of MUST Abstract Cache States (ACS). */
-  bool MustAnalysis ();
+  bool MustAnalysis (Worklist & work);
 
   /** Fixed point computation of MAY Abstract Cache States (ACS). */
-  bool MayAnalysis ();
+  bool MayAnalysis (Worklist & work);
 
   /** Fixed point computation of PS Abstract Cache States (ACS). */
-  bool PSAnalysis ();
-
-  template < typename T > void compute_ACS_out(ContextualNode & current, Instruction *vinstr, AbstractCache < T > &ACS_out, string idAccessName);
-  /** @return the ACS_out, for an analysis T, of a ContextualNode (current). 
-      The initial ACS_out is the ACS_in of the current analysis (given by the attribute inAnalysisName in the context of current).
-      Then the ACS_out is updated for each Load instructions of the node.
-      Remark: inAnalysisName ::= ACSMUSTInName | ACSMAYInName | ACSPSInName. */
-  template<typename T> AbstractCache <T > compute_ACS_out(ContextualNode &current, string &inAnalysisName);
+  bool PSAnalysis (Worklist & work);
 
-  /** FixPointMust1stStep analysis: Compute the ACS_out a set of nodes (work), without considering backedges.
-      @return a set of nodes for which the ACS_in must be computed. */
-  set <ContextualNode> FixPointMust1stStep_ACS_out(set <ContextualNode> &work , set < Edge * > &backedges );
+  template < typename T, typename A > friend class CacheFixPoint;
+  template < typename T, typename A > friend class CacheSummaryStore;
 
-  /** FixPointMust1stStep analysis: Compute the ACS_in of a set of nodes (work) without considering backedges.
-      @return a set of nodes for which the ACS_out must be computed. */
-  set <ContextualNode> FixPointMust1stStep_ACS_in(set <ContextualNode> &work_in , set < Edge * > &backedges );
+  template < typename T > void compute_ACS_out(ContextualNode & current, Instruction *vinstr, AbstractCache < T > &ACS_out, AttributeKey idAccessName);
 
-  /** MustAnalysis analysis: Compute the ACS_out a set of nodes (work).
-      @return a set of nodes for which the ACS_in must be computed (all the nodes have to be visited at least once).*/
-  set < ContextualNode > MustAnalysis_ACS_out(set<ContextualNode> &work, set < ContextualNode > &visited);
+  /** @return the ACS_out of a ContextualNode (current) whose ACS_in is ACS_in. */
+  template < typename T > AbstractCache < T > compute_ACS_out(ContextualNode &current, const AbstractCache < T > &ACS_in);
 
-  /** MustAnalysis: Compute the ACS_in of a set of nodes (work). 
-      @return a set of nodes for which the ACS_out must be computed (all the nodes have to be visited at least once). */
-  set < ContextualNode > MustAnalysis_ACS_in (set<ContextualNode> &work_in, set < ContextualNode > &visited);
+  /** @return the ACS_out, for an analysis T, of a ContextualNode (current). 
+      The initial ACS_out is the ACS_in of the current analysis (given by its store for current).
+      Then the ACS_out is updated for each Load instructions of the node.
+      Remark: store ::= mustStore | mayStore | psStore. */
+  template<typename T> AbstractCache <T > compute_ACS_out(ContextualNode &current, AbstractCacheStateStore < T > &store);
 
-  /** MayAnalysis analysis: Compute the ACS_out a set of nodes (work).
-      @return a set of nodes for which the ACS_in must be computed (all the nodes have to be visited at least once).*/
-  set < ContextualNode > MayAnalysis_ACS_out(set < ContextualNode >&work, set < ContextualNode > &visited );
+public:
 
-  /** MayAnalysis: Compute the ACS_in of a set of nodes (work). 
-      @return a set of nodes for which the ACS_out must be computed (all the nodes have to be visited at least once). */
-  set < ContextualNode > MayAnalysis_ACS_in (set < ContextualNode >&work_in, set < ContextualNode > &visited );
+  /** ACS of the analyses, attached by the initialisation functions and read by the classification functions */
+  AbstractCacheStateStore < MUST > &getMustStore ()
+  {
+    return mustStore;
+  };
+  AbstractCacheStateStore < MAY > &getMayStore ()
+  {
+    return mayStore;
+  };
+  AbstractCacheStateStore < PS > &getPSStore ()
+  {
+    return psStore;
+  };
 
-  /** PSAnalysis: Compute the ACS_out of a set of nodes (work).
-      @return a set of nodes for which the ACS_in must be computed (all the nodes have to be visited at least once). */
-  set < ContextualNode > PSAnalysis_ACS_out(set < ContextualNode >&work, set < ContextualNode > &visited );
+  /** ACS_in of the contextual nodes read by the classification functions */
+  AbstractCacheStates < MUST > &getMustStates ()
+  {
+    return *mustStates;
+  };
+  AbstractCacheStates < MAY > &getMayStates ()
+  {
+    return *mayStates;
+  };
+  AbstractCacheStates < PS > &getPSStates ()
+  {
+    return *psStates;
+  };
 
-  /** PSAnalysis: Compute the ACS_in of a set of nodes (work). 
-      @return a set of nodes for which the ACS_out must be computed (all the nodes have to be visited at least once). */
-  set < ContextualNode > PSAnalysis_ACS_in (set < ContextualNode >&work_in, set < ContextualNode > &visited );
-  
-public:
+  /** @return true if the loads of the contexts a and b, and of their callee contexts, access
+      the same data addresses with the same access classification for the level analysed. */
+  bool sameAccesses (Context * a, Context * b);
 
   /** Returns an empty Must cache */
     AbstractCache < MUST > CacheFactoryMUST () const;
@@ -145,15 +183,16 @@ public:
   /** Returns an empty May cache */
     AbstractCache < MAY > CacheFactoryMAY () const;
 
-  /** Returns the set of addresses possibly accessed by a load */
-    set < t_address > getDataAddress (Instruction * instruction, Context * context);
+  /** Returns the ranges of addresses possibly accessed by a load */
+    DataAccess getDataAddress (Instruction * instruction, Context * context);
 
   /** map used to determine the next level CAC based on current CAC and CHMC */
     map < string, map < string, SerialisableStringAttribute > >cac_computation;
 
   /** Constructor. Sets up cache parameters */
     DCacheAnalysis (Program * p, int nbsets, int nbways, int cachelinesize,
-		    t_replacement_policy r, int cacheLevel, bool apply_must, bool apply_persistence, bool apply_may, bool pdcache);
+		    t_replacement_policy r, int cacheLevel, bool apply_must, bool apply_persistence, bool apply_may, bool pdcache, int nbthreads = 1,
+		    bool summary = false, int callstringdepth = -1);
 
   /** Destructor. */
    ~DCacheAnalysis ()
@@ -0,0 +1,554 @@
+/* ---------------------------------------------------------------------
+
+   Copyright IRISA, 2003-2017
+
+   This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+   estimation.
+   APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+   Heptane is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Heptane is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details (COPYING.txt).
+
+   See CREDITS.txt for credits of authorship
+
+   ------------------------------------------------------------------------ */
+
+/**
+ *
+ * Flat AbstractCacheSet implementation for the MAY, MUST, and PS
+ * (same semantics as the set-based implementation of Cache.cc)
+ *
+ */
+
+#include <iostream>
+#include <utility>
+#include <cassert>
+#include <algorithm>
+
+#include "FlatCache.h"
+#include "Generic/AnalysisSession.h"
+
+using namespace std;
+
+/** Hash of an array of bytes or block numbers */
+template < typename V > static size_t
+hashArray (const vector < V > &values)
+{
+  size_t h = values.size ();
+  for (size_t i = 0; i < values.size (); i++)
+    {
+      h = h * 31 + values[i];
+    }
+  return h;
+}
+
+/** Removes the trailing absent blocks of an array of ages */
+static void
+trimAges (vector < uint8_t > &ages)
+{
+  size_t n = ages.size ();
+  while (n > 0 && ages[n - 1] == FLAT_ABSENT) { n--; }
+  ages.resize (n);
+}
+
+/** Prints an array of ages as {block:age,...} */
+static void
+printAges (const vector < uint8_t > &ages)
+{
+  cout << "{";
+  bool first = true;
+  for (size_t id = 0; id < ages.size (); id++)
+    {
+      if (ages[id] == FLAT_ABSENT) { continue; }
+      if (!first) { cout << ","; }
+      cout << id << ":" << (unsigned int) ages[id];
+      first = false;
+    }
+  cout << "}" << endl;
+}
+
+/** Merges the sorted arrays a and b into out, without skip.
+    @return the number of elements of out */
+static unsigned int
+mergeIds (const uint32_t * a, unsigned int na, const uint32_t * b, unsigned int nb, uint32_t skip, uint32_t * out)
+{
+  unsigned int i = 0, j = 0, n = 0;
+  while (i < na || j < nb)
+    {
+      uint32_t v;
+      if (j == nb || (i < na && a[i] < b[j])) { v = a[i++]; }
+      else if (i == na || b[j] < a[i]) { v = b[j++]; }
+      else { v = a[i++]; j++; }
+      if (v != skip) { out[n++] = v; }
+    }
+  return n;
+}
+
+/**************************************************
+ *
+ *  CacheBlockIndex implementation
+ *
+ *************************************************/
+
+CacheBlockIndex::CacheBlockIndex (unsigned int nbsets, unsigned int cachelinesize)
+{
+  nb_sets = nbsets;
+  cacheline_size = cachelinesize;
+  ids.resize (nb_sets);
+}
+
+uint32_t
+CacheBlockIndex::GetId (t_address addr)
+{
+  unordered_map < t_address, uint32_t > &set_ids = ids[(addr / cacheline_size) % nb_sets];
+  unordered_map < t_address, uint32_t >::iterator it = set_ids.find (addr);
+  if (it != set_ids.end ()) { return it->second; }
+  uint32_t id = set_ids.size ();
+  set_ids[addr] = id;
+  return id;
+}
+
+bool
+CacheBlockIndex::FindId (t_address addr, uint32_t & id) const
+{
+  const unordered_map < t_address, uint32_t > &set_ids = ids[(addr / cacheline_size) % nb_sets];
+  unordered_map < t_address, uint32_t >::const_iterator it = set_ids.find (addr);
+  if (it == set_ids.end ()) { return false; }
+  id = it->second;
+  return true;
+}
+
+CacheBlockIndex *
+CacheBlockIndex::Get (unsigned int nbsets, unsigned int cachelinesize)
+{
+  AnalysisSession *session = AnalysisSession::current ();
+  assert (session != NULL);
+  return session->getCacheBlockIndex (nbsets, cachelinesize);
+}
+
+/**************************************************
+ *
+ *  FlatMUST implementation
+ *
+ *************************************************/
+
+/** Constructor */
+FlatMUST::FlatMUST (unsigned int nbways, unsigned int nbways_removed, CacheBlockIndex * blocks)
+{
+  assert (nbways < FLAT_ABSENT);
+  nb_ways = nbways;
+  nb_ways_removed = nbways_removed;
+  index = blocks;
+}
+
+/** returns true if the cache line containing addr is absent from the abstract cache set and false otherwise */
+bool
+FlatMUST::Absent (t_address addr) const
+{
+  return GetAge (addr) >= nb_ways;
+}
+
+/** returns the age in the abstract cache of the cache line containing addr
+    between [0..nb_ways-1] if present
+    nb_ways+nb_ways_removed otherwise
+*/
+unsigned int
+FlatMUST::GetAge (t_address addr) const
+{
+  uint32_t id;
+  if (index->FindId (addr, id) && Age (id) < nb_ways) { return Age (id); }
+  return nb_ways + nb_ways_removed;
+}
+
+/** Print the Abstract Cache Set for debugging purpose */
+void
+FlatMUST::Print () const
+{
+  printAges (ages);
+}
+
+/** Written without branches so that the compiler can vectorise it */
+void
+FlatMUST::Shift (unsigned int age)
+{
+  uint8_t a = age, w = nb_ways;
+  for (size_t k = 0; k < ages.size (); k++)
+    {
+      uint8_t v = ages[k] + (ages[k] < a);
+      ages[k] = (v == w) ? FLAT_ABSENT : v;
+    }
+}
+
+/** Update function when only one address is accessed */
+void
+FlatMUST::Update (t_address addr)
+{
+  assert (nb_ways > 0);
+
+  uint32_t id = index->GetId (addr);
+  unsigned int age = Age (id);
+  if (age == 0) { return; } //nothing change in the set addr is alone in the first way
+
+  if (id >= ages.size ()) { ages.resize (id + 1, FLAT_ABSENT); }
+  Shift (age);
+  ages[id] = 0;
+  trimAges (ages);
+}
+
+/** Update function when a set of addresses is accessed
+    used by the data cache analysis
+*/
+void
+FlatMUST::Update (const set < t_address > &addrs)
+{
+  assert (nb_ways > 0);
+
+  unsigned int max_age = 0;
+  // Find max_age: the age of the oldest accessed block.
+  for (set < t_address >::const_iterator it = addrs.begin (); it != addrs.end () && max_age < nb_ways; it++)
+    {
+      uint32_t id;
+      max_age = max (max_age, index->FindId (*it, id) ? Age (id) : nb_ways);
+    }
+
+  // only one line in addrs at the MRU position (the cache set is unchanged)
+  if (max_age == 0) { return; }
+
+  Shift (max_age);
+  trimAges (ages);
+}
+
+/** Join function: the maximal age is kept, absent blocks being the oldest ones */
+void
+FlatMUST::Join (const FlatMUST & c)
+{
+  assert (nb_ways == c.nb_ways);
+
+  size_t n = min (ages.size (), c.ages.size ());
+  ages.resize (n);
+  for (size_t k = 0; k < n; k++)
+    {
+      ages[k] = max (ages[k], c.ages[k]);
+    }
+  trimAges (ages);
+}
+
+/** returns true if this is equal to c and false otherwise */
+bool
+FlatMUST::Equals (const FlatMUST & c) const
+{
+  assert (nb_ways == c.nb_ways);
+  return ages == c.ages;
+}
+
+/** returns a hash of the contents */
+size_t
+FlatMUST::Hash () const
+{
+  return hashArray (ages);
+}
+
+/**************************************************
+ *
+ *  FlatMAY implementation
+ *
+ *************************************************/
+
+/** Constructor */
+FlatMAY::FlatMAY (unsigned int nbways, CacheBlockIndex * blocks)
+{
+  assert (nbways < FLAT_ABSENT);
+  nb_ways = nbways;
+  index = blocks;
+}
+
+/** returns true if the cache line containing addr is absent from the abstract cache set and false otherwise */
+bool
+FlatMAY::Absent (t_address addr) const
+{
+  uint32_t id;
+  return !index->FindId (addr, id) || id >= ages.size () || ages[id] == FLAT_ABSENT;
+}
+
+/** Print the Abstract Cache Set for debugging purpose */
+void
+FlatMAY::Print () const
+{
+  printAges (ages);
+}
+
+/** Update function when only one address is accessed */
+void
+FlatMAY::Update (t_address addr)
+{
+  uint32_t id = index->GetId (addr);
+  if (id >= ages.size ()) { ages.resize (id + 1, FLAT_ABSENT); }
+
+  // The blocks younger than addr (or of age 0 if addr is the MRU) are aged by one.
+  uint8_t a = (ages[id] == FLAT_ABSENT) ? nb_ways : ages[id];
+  a = max (a, (uint8_t) 1);
+  uint8_t w = nb_ways;
+  for (size_t k = 0; k < ages.size (); k++)
+    {
+      uint8_t v = ages[k] + (ages[k] < a);
+      ages[k] = (v == w) ? FLAT_ABSENT : v;
+    }
+
+  // Set addr as the most recently used block.
+  ages[id] = 0;
+  trimAges (ages);
+}
+
+/** Update function when a set of addresses is accessed
+    used by the data cache analysis
+*/
+void
+FlatMAY::Update (const set < t_address > &addrs)
+{
+  //add addrs at age 0
+  for (set < t_address >::const_iterator it = addrs.begin (); it != addrs.end (); it++)
+    {
+      uint32_t id = index->GetId (*it);
+      if (id >= ages.size ()) { ages.resize (id + 1, FLAT_ABSENT); }
+      ages[id] = 0;
+    }
+}
+
+/** Join function: the minimal age is kept, absent blocks being the oldest ones */
+void
+FlatMAY::Join (const FlatMAY & c)
+{
+  assert (nb_ways == c.nb_ways);
+
+  if (c.ages.size () > ages.size ()) { ages.resize (c.ages.size (), FLAT_ABSENT); }
+  for (size_t k = 0; k < c.ages.size (); k++)
+    {
+      ages[k] = min (ages[k], c.ages[k]);
+    }
+}
+
+/** returns true if this is equal to c and false otherwise */
+bool
+FlatMAY::Equals (const FlatMAY & c) const
+{
+  assert (nb_ways == c.nb_ways);
+  return ages == c.ages;
+}
+
+/** returns a hash of the contents */
+size_t
+FlatMAY::Hash () const
+{
+  return hashArray (ages);
+}
+
+/**************************************************
+ *
+ *  FlatPS implementation
+ *
+ *************************************************/
+
+/** Constructor */
+FlatPS::FlatPS (unsigned int nbways, unsigned int nbways_removed, CacheBlockIndex * blocks)
+{
+  nb_ways = nbways;
+  nb_ways_removed = nbways_removed;
+  stride = max (nb_ways, 2U) - 1;
+  index = blocks;
+}
+
+void
+FlatPS::Reserve (uint32_t id)
+{
+  if (id < state.size ()) { return; }
+  state.resize (id + 1, PS_ABSENT);
+  nb_conflicts.resize (id + 1, 0);
+  conflicts.resize ((id + 1) * stride, 0);
+}
+
+void
+FlatPS::Evict (uint32_t id)
+{
+  state[id] = PS_EVICTED;
+  nb_conflicts[id] = 0;
+  fill (conflicts.begin () + id * stride, conflicts.begin () + (id + 1) * stride, 0);
+}
+
+void
+FlatPS::SetConflicts (uint32_t id, const uint32_t * ids, unsigned int n)
+{
+  if (n >= nb_ways)
+    {
+      Evict (id);
+      return;
+    }
+  state[id] = PS_PRESENT;
+  nb_conflicts[id] = n;
+  uint32_t *slots = &conflicts[id * stride];
+  copy (ids, ids + n, slots);
+  fill (slots + n, slots + stride, 0);
+}
+
+void
+FlatPS::Trim ()
+{
+  size_t n = state.size ();
+  while (n > 0 && state[n - 1] == PS_ABSENT) { n--; }
+  state.resize (n);
+  nb_conflicts.resize (n);
+  conflicts.resize (n * stride);
+}
+
+/** returns true if the cache line containing addr is absent from the abstract cache set and false otherwise */
+bool
+FlatPS::Absent (t_address addr) const
+{
+  uint32_t id;
+  if (!index->FindId (addr, id) || id >= state.size () || state[id] != PS_PRESENT)
+    {
+      return true;
+    }
+  assert (nb_conflicts[id] < nb_ways);	//check for evicted
+  return false;
+}
+
+/** returns the age in the abstract cache of the cache line containing addr
+    between [0..nb_ways-1] if present
+    nb_ways otherwise
+*/
+unsigned int
+FlatPS::GetAge (t_address addr) const
+{
+  uint32_t id;
+  if (!index->FindId (addr, id) || id >= state.size () || state[id] != PS_PRESENT)
+    {
+      return nb_ways;
+    }
+  assert (nb_conflicts[id] < nb_ways);	//check for evicted
+  return nb_conflicts[id] + nb_ways_removed;
+}
+
+/** Print the Abstract Cache Set for debugging purpose */
+void
+FlatPS::Print () const
+{
+  cout << "{";
+  for (size_t id = 0; id < state.size (); id++)
+    {
+      if (state[id] == PS_PRESENT) { cout << id << ":" << (unsigned int) nb_conflicts[id] << " "; }	//{block:#conflict}
+    }
+  cout << "} | [";
+  for (size_t id = 0; id < state.size (); id++)
+    {
+      if (state[id] == PS_EVICTED) { cout << id << " "; }
+    }
+  cout << "]" << endl;
+}
+
+/** Update function when only one address is accessed */
+void
+FlatPS::Update (t_address addr)
+{
+  uint32_t id = index->GetId (addr);
+  Reserve (id);
+
+  // addr conflicts with all the present blocks
+  for (uint32_t b = 0; b < state.size (); b++)
+    {
+      if (state[b] != PS_PRESENT) { continue; }
+      uint32_t *slots = &conflicts[b * stride];
+      unsigned int n = nb_conflicts[b];
+      uint32_t *pos = lower_bound (slots, slots + n, id);
+      if (pos != slots + n && *pos == id) { continue; }
+      if (n + 1 >= nb_ways)
+	{
+	  Evict (b);
+	  continue;
+	}
+      copy_backward (pos, slots + n, slots + n + 1);
+      *pos = id;
+      nb_conflicts[b] = n + 1;
+    }
+
+  SetConflicts (id, NULL, 0);
+}
+
+/** Update function when a set of addresses is accessed
+    used by the data cache analysis
+*/
+void
+FlatPS::Update (const set < t_address > &addrs)
+{
+  vector < uint32_t > accessed;
+  for (set < t_address >::const_iterator it = addrs.begin (); it != addrs.end (); it++)
+    {
+      accessed.push_back (index->GetId (*it));
+    }
+  sort (accessed.begin (), accessed.end ());
+  if (accessed.empty ()) { return; }
+  Reserve (accessed.back ());
+
+  vector < uint32_t > merged (stride + accessed.size ());
+
+  //add the conflicts to all the blocks present in the cache before the access
+  for (uint32_t b = 0; b < state.size (); b++)
+    {
+      if (state[b] != PS_PRESENT) { continue; }
+      unsigned int n = mergeIds (&conflicts[b * stride], nb_conflicts[b], &accessed[0], accessed.size (), b, &merged[0]);
+      SetConflicts (b, &merged[0], n);
+    }
+
+  //insert the accessed blocks neither present nor evicted before this access
+  for (size_t i = 0; i < accessed.size (); i++)
+    {
+      uint32_t a = accessed[i];
+      if (state[a] != PS_ABSENT) { continue; }
+      unsigned int n = mergeIds (NULL, 0, &accessed[0], accessed.size (), a, &merged[0]);
+      SetConflicts (a, &merged[0], n);
+    }
+  Trim ();
+}
+
+/** Join function */
+void
+FlatPS::Join (const FlatPS & c)
+{
+  assert (nb_ways == c.nb_ways);
+
+  if (c.state.empty ()) { return; }
+  Reserve (c.state.size () - 1);
+
+  vector < uint32_t > merged (2 * stride);
+  for (uint32_t b = 0; b < c.state.size (); b++)
+    {
+      if (c.state[b] == PS_EVICTED) { Evict (b); }
+      else if (c.state[b] == PS_PRESENT && state[b] != PS_EVICTED)	//if in this->evicted no need to insert it
+	{
+	  unsigned int n = mergeIds (&conflicts[b * stride], nb_conflicts[b], &c.conflicts[b * stride], c.nb_conflicts[b],
+				     (uint32_t) - 1, &merged[0]);
+	  SetConflicts (b, &merged[0], n);
+	}
+    }
+}
+
+/** returns true if this is equal to c and false otherwise */
+bool
+FlatPS::Equals (const FlatPS & c) const
+{
+  assert (nb_ways == c.nb_ways);
+  return state == c.state && nb_conflicts == c.nb_conflicts && conflicts == c.conflicts;
+}
+
+/** returns a hash of the contents */
+size_t
+FlatPS::Hash () const
+{
+  return (hashArray (state) * 31 + hashArray (nb_conflicts)) * 31 + hashArray (conflicts);
+}
@@ -0,0 +1,258 @@
+/* ---------------------------------------------------------------------
+
+   Copyright IRISA, 2003-2017
+
+   This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+   estimation.
+   APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+   Heptane is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Heptane is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details (COPYING.txt).
+
+   See CREDITS.txt for credits of authorship
+
+   ------------------------------------------------------------------------------------ */
+
+/**
+ *
+ * Flat implementation of the abstract cache sets of the MUST, MAY and PS analyses.
+ *
+ * The cache lines mapped to a cache set are numbered (0, 1, ...) in the order
+ * they are first accessed, by a block index shared by all the abstract caches of
+ * the same geometry. An abstract cache set is then an array indexed by block number:
+ * - MUST and MAY: the age of every block (uint8_t, FLAT_ABSENT when the block is not in the set),
+ *   the join being an element-wise max (MUST) or min (MAY);
+ * - PS: the state of every block and its conflicting blocks, kept in fixed-size slots.
+ *
+ * The arrays are kept in canonical form (no trailing absent block, unused slots
+ * set to zero), so that the equality test is a comparison of the arrays.
+ *
+ * Selected instead of the set-based implementation (Cache.h) when compiled with -DFLAT_CACHE_SETS,
+ * which HeptaneAnalysis/GNUmakefile sets by default.
+ * Both implementations compute the same abstract cache states.
+ *
+ */
+
+#ifndef FLAT_CACHE_H
+#define FLAT_CACHE_H
+
+#include <set>
+#include <map>
+#include <vector>
+#include <unordered_map>
+#include <stdint.h>
+
+#include "Analysis.h"		//useful for t_address type
+
+using namespace std;
+
+/** Age of a block absent from a MUST or MAY flat abstract cache set */
+#define FLAT_ABSENT 0xFF
+
+/**************************************************
+ *
+ *  CacheBlockIndex
+ *
+ *************************************************/
+
+/**
+ * Numbering of the cache lines in their cache set, for a cache geometry.
+ * The numberings of the different sets are independent, so that the groups of
+ * sets of a parallel analysis can be analysed by different threads. The indexes
+ * belong to the analysis session (AnalysisSession::getCacheBlockIndex).
+ */
+class CacheBlockIndex
+{
+ private:
+  unsigned int nb_sets;
+  unsigned int cacheline_size;
+  vector < unordered_map < t_address, uint32_t > > ids;	// cache line -> number in its set, per set
+
+  CacheBlockIndex (unsigned int nbsets, unsigned int cachelinesize);
+  friend class AnalysisSession;
+
+ public:
+
+  /** @return the number of the cache line addr (beginning of a line) in its set, numbering it if needed */
+  uint32_t GetId (t_address addr);
+
+  /** @return true and sets id to the number of the cache line addr if it is already numbered, false otherwise */
+  bool FindId (t_address addr, uint32_t & id) const;
+
+  /** @return the block index of the caches of nbsets sets with lines of cachelinesize bytes, in the current session */
+  static CacheBlockIndex *Get (unsigned int nbsets, unsigned int cachelinesize);
+};
+
+/**************************************************
+ *
+ *  AbstractCacheSet FlatMUST
+ *
+ *************************************************/
+
+class FlatMUST
+{
+ private:
+  unsigned int nb_ways;		//the value corresponds to the number of ways to consider during the analysis
+  unsigned int nb_ways_removed;	//used in function GetAge and useful when a non LRU policy is used
+  CacheBlockIndex *index;
+  vector < uint8_t > ages;	//age of every block of the set, FLAT_ABSENT if not present
+
+  /** @return the age of block id, nb_ways if absent */
+  unsigned int Age (uint32_t id) const
+  {
+    return (id < ages.size () && ages[id] != FLAT_ABSENT) ? ages[id] : nb_ways;
+  }
+
+  /** Ages by one all the blocks younger than age, evicting those reaching nb_ways */
+  void Shift (unsigned int age);
+
+ public:
+
+  /** Constructor */
+  FlatMUST (unsigned int nbways, unsigned int nbways_removed, CacheBlockIndex * blocks);
+
+  /** @return the age in the abstract cache of the cache line containing addr between [0..nb_ways-1] if present,  nb_ways+nb_ways_removed otherwise
+   */
+  unsigned int GetAge (t_address addr) const;
+
+  /** @return true if the cache line containing addr is absent from the abstract cache set, false otherwise */
+  bool Absent (t_address) const;
+
+  /** Print the Abstract Cache Set for debugging purpose */
+  void Print () const;
+
+  /** Update function when only one address is accessed */
+  void Update (t_address);
+
+  /** Update function when a set of addresses is accessed
+      used by the data cache analysis
+  */
+  void Update (const set < t_address > &);
+
+  /** Join function */
+  void Join (const FlatMUST &);
+
+  /** returns true if this is equal to c and false otherwise */
+  bool Equals (const FlatMUST &) const;
+
+  /** @return a hash of the contents (equal sets have the same hash) */
+  size_t Hash () const;
+};
+
+/**************************************************
+ *
+ *  AbstractCacheSet FlatMAY
+ *
+ *************************************************/
+
+class FlatMAY
+{
+ private:
+  unsigned int nb_ways;		//the value corresponds to the number of ways to consider during the analysis
+  CacheBlockIndex *index;
+  vector < uint8_t > ages;	//age of every block of the set, FLAT_ABSENT if not present
+
+ public:
+
+  /** Constructor */
+  FlatMAY (unsigned int nbways, CacheBlockIndex * blocks);
+
+  /** returns true if the cache line containing addr is absent from the abstract cache set and false otherwise */
+  bool Absent (t_address) const;
+
+  /** Print the Abstract Cache Set for debugging purpose */
+  void Print () const;
+
+  /** Update function when only one address is accessed */
+  void Update (t_address);
+
+  /** Update function when a set of addresses is accessed
+      used by the data cache analysis
+  */
+  void Update (const set < t_address > &);
+
+  /** Join function */
+  void Join (const FlatMAY &);
+
+  /** returns true if this is equal to c and false otherwise */
+  bool Equals (const FlatMAY &) const;
+
+  /** @return a hash of the contents (equal sets have the same hash) */
+  size_t Hash () const;
+};
+
+/**************************************************
+ *
+ *  AbstractCacheSet FlatPS
+ *
+ *************************************************/
+
+class FlatPS
+{
+ private:
+  enum
+  { PS_ABSENT = 0, PS_PRESENT = 1, PS_EVICTED = 2 };
+
+  unsigned int nb_ways;		//the value corresponds to the number of ways to consider during the analysis
+  unsigned int nb_ways_removed;	//used in function GetAge and useful when a non LRU policy is used
+  unsigned int stride;		//number of conflict slots per block (a present block has less than nb_ways conflicts)
+  CacheBlockIndex *index;
+  vector < uint8_t > state;	//PS_ABSENT, PS_PRESENT or PS_EVICTED, for every block of the set
+  vector < uint8_t > nb_conflicts;	//number of conflicting blocks of the present blocks
+  vector < uint32_t > conflicts;	//sorted conflicting blocks of the present blocks (stride slots per block)
+
+  /** Makes room for block id */
+  void Reserve (uint32_t id);
+
+  /** Sets the conflicts of block id (sorted, n elements), evicting it if there are at least nb_ways conflicts */
+  void SetConflicts (uint32_t id, const uint32_t * ids, unsigned int n);
+
+  /** Marks block id as evicted */
+  void Evict (uint32_t id);
+
+  /** Removes the trailing absent blocks */
+  void Trim ();
+
+ public:
+
+  /** Constructor */
+  FlatPS (unsigned int nbways, unsigned int nbways_removed, CacheBlockIndex * blocks);
+
+  /** returns the age in the abstract cache of the cache line containing addr
+      between [0..nb_ways-1] if present
+      nb_ways otherwise
+  */
+  unsigned int GetAge (t_address addr) const;
+
+  /** returns true if the cache line containing addr is absent from the abstract cache set and false otherwise */
+  bool Absent (t_address) const;
+
+  /** Print the Abstract Cache Set for debugging purpose */
+  void Print () const;
+
+  /** Update function when only one address is accessed */
+  void Update (t_address);
+
+  /** Update function when a set of addresses is accessed
+      used by the data cache analysis
+  */
+  void Update (const set < t_address > &);
+
+  /** Join function */
+  void Join (const FlatPS &);
+
+  /** returns true if this is equal to c and false otherwise */
+  bool Equals (const FlatPS &) const;
+
+  /** @return a hash of the contents (equal sets have the same hash) */
+  size_t Hash () const;
+};
+
+#endif
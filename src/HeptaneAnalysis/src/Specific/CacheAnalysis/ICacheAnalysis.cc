@@ -27,8 +27,6 @@ See CREDITS.txt for credits of authorship
 
 
 // inlines...
-#define getACSNode(T, NODE, IDATTR) ((AbstractCacheStateAttribute < T > &)NODE->GetAttribute(IDATTR))
-#define getACSContextualNode(T, ELEM, IDATTR) getACSNode(T, ELEM.node,IDATTR)
 
 
 /*************************************************************************************************************************
@@ -231,7 +229,7 @@ static bool initL1AccessAttributeForInstruction(Cfg * c, Node * n, void *param)
 }
 
 
-template < typename T > void ICacheAnalysis::compute_ACS_out(ContextualNode & current, Instruction *vinstr, AbstractCache < T > &ACS_out, string idAccessName)
+template < typename T > void ICacheAnalysis::compute_ACS_out(ContextualNode & current, Instruction *vinstr, AbstractCache < T > &ACS_out, AttributeKey idAccessName)
 {
   assert(vinstr->HasAttribute(idAccessName));
   string accessValue = ((SerialisableStringAttribute &) (vinstr->GetAttribute(idAccessName))).GetValue();
@@ -248,19 +246,23 @@ template < typename T > void ICacheAnalysis::compute_ACS_out(ContextualNode & cu
 }
 
 /*
-   @return the ACS_out, for an analysis T, of a ContextualNode (current). The initial ACS_out is the given by the ACS_in of the current analysis provided by inAnalysisName for the context.
-   (inAnalysisName ::= ACSMUSTInName | ACSMAYInName | ACSPSInName )
+   @return the ACS_out, for an analysis T, of a ContextualNode (current). The initial ACS_out is the given by the ACS_in of the current analysis stored for the context.
+   (store ::= mustStore | mayStore | psStore )
 */
-template<typename T> AbstractCache < T > ICacheAnalysis::compute_ACS_out(ContextualNode &current, string &inAnalysisName)
+template<typename T> AbstractCache < T > ICacheAnalysis::compute_ACS_out(ContextualNode &current, AbstractCacheStateStore < T > &store)
 {
-  string attributeAccessName = CACAttributeNameCode(levelAnalysis);
-  string idCurrentContext = current.context->getStringId ();
-  string idAccessName;
+  return compute_ACS_out<T> (current, store.getIn(current));
+}
+
+/*
+   @return the ACS_out, for an analysis T, of a ContextualNode (current) whose ACS_in is ACS_in (summary mode).
+*/
+template<typename T> AbstractCache < T > ICacheAnalysis::compute_ACS_out(ContextualNode &current, const AbstractCache < T > &ACS_in)
+{
+  AttributeKey idAccessName = accessKeys.get(current.context);
 
-  AbstractCacheStateAttribute < T > &ca_attr_in = getACSContextualNode( T, current, inAnalysisName + idCurrentContext);
-  AbstractCache < T > ACS_out = ca_attr_in.cache;
+  AbstractCache < T > ACS_out = ACS_in;
 
-  idAccessName = AnalysisHelper::mkContextAttrName( attributeAccessName, idCurrentContext);
   vector < Instruction * >vi = current.node->GetAsm();
   for (size_t i = 0; i < vi.size(); i++)
     {
@@ -284,113 +286,19 @@ static bool initACSMUST(Cfg * c, Node * n, void *param)
 
   ICacheAnalysis *ca = (ICacheAnalysis *) param;
   AbstractCache < MUST > ACS_empty = ca->CacheFactoryMUST();
-  AbstractCacheStateAttribute < MUST > att(ACS_empty);
-
-  string in = ACSMUSTInName;
-  string out = ACSMUSTOutName;
+  AbstractCacheStateStore < MUST > &store = ca->getMustStore();
 
   assert(c->HasAttribute(ContextListAttributeName));
   const ContextList & contexts = (ContextList &) c->GetAttribute(ContextListAttributeName);
 
   for (ContextList::const_iterator context = contexts.begin(); context != contexts.end(); context++)
     {
-      string currentContext = (*context)->getStringId();
-      // cout << "initACSMUST currentContext is " << currentContext << endl;
-      n->SetAttribute(in + currentContext, att);
-      n->SetAttribute(out + currentContext, att);
+      store.attach(ContextualNode(*context, n), ACS_empty);
     }
 
   return true;
 }
 
-/* FixPointMust1stStep analysis: Compute the ACS_out a set of nodes (work), without considering backedges.
-   @return a set of nodes for which the ACS_in must be computed. */
-set < ContextualNode > ICacheAnalysis::FixPointMust1stStep_ACS_out(set < ContextualNode >&work, set < Edge * >& backedges )
-{
-  //cout << "***Let's start FixPointMust1stStep_ACS_out analysis***" << endl;
-  string in = ACSMUSTInName;
-  string out = ACSMUSTOutName;
-  set < ContextualNode > work_in;
-  // cout << "@@@ This is FixPointMustAnalysis @@@" << endl;
-  for (set < ContextualNode >::iterator it = work.begin(); it != work.end(); it++)
-    {
-      ContextualNode current = *it;
-      //current.context->print();
-      AbstractCache < MUST > ACS_out= compute_ACS_out<MUST>( current, in);
-      //cout << "The Fixpointout getStringId is " << current.context->getStringId() << endl;
-      //cout << "The Fixpointout getId is " << current.context->getId() << endl;
-
-
-      AbstractCacheStateAttribute < MUST > &ca_attr_out = getACSContextualNode( MUST, current, out + current.context->getStringId());   
-      if (! ca_attr_out.cache.Equals(ACS_out))
-	{
-	  ca_attr_out.cache = ACS_out;
-	  AnalysisHelper::insertContextualSuccessorsExcludingBackEdges(current, work_in, backedges);
-	}
-    }
-  return work_in;
-}
-
-
-/* FixPointMust1stStep analysis: Compute the ACS_in of a set of nodes (work) without considering backedges.
-   @return a set of nodes for which the ACS_out must be computed. */
-set < ContextualNode > ICacheAnalysis::FixPointMust1stStep_ACS_in(set < ContextualNode >&work_in, set < Edge * >& backedges )
-{
-  //cout << endl;
-  //cout << "***Let's start FixPointMust1stStep_ACS_in analysis***" << endl;
-  string in = ACSMUSTInName;
-  string out = ACSMUSTOutName;
-  set < ContextualNode > work;
-  string idAttr;
-  bool b;
-  ContextualNode pred;
- 
-
-  for (set < ContextualNode >::iterator it = work_in.begin(); it != work_in.end(); it++)
-    {
-      ContextualNode current = *it;
-
-      const vector < ContextualNode > &predecessors = GetContextualPredecessors(current);
-      assert(predecessors.size() != 0);	//it should not be the program's entry node
-
-      
-
-      AbstractCache < MUST > new_ACS_in;
-      bool first = true;
-      for (size_t i = 0; i < predecessors.size(); i++)
-	{
-	  pred = predecessors[i];
-	  b = AnalysisHelper::FilterBackedge(current.node, pred.node, backedges);
-    
-    if (b)
-	    {
-	      idAttr = out + pred.context->getStringId();
-       // cout << "The out Pre.context is " << idAttr << endl;
-	      if (first)
-		{
-		  first = false;
-		  new_ACS_in = getACSContextualNode(MUST, pred, idAttr).cache;
-		}
-	      else
-		{
-		  new_ACS_in.Join(getACSContextualNode(MUST, pred, idAttr).cache); 
-		}
-	    }
-	}
-      idAttr = in + current.context->getStringId();
-      //cout << "The in Current.context is " << idAttr << endl;
-      AbstractCacheStateAttribute < MUST > &ca_attr_in = getACSContextualNode(MUST, current, idAttr);
-
-      if (!ca_attr_in.cache.Equals(new_ACS_in))
-	{
-	  ca_attr_in.cache = new_ACS_in;
-	  work.insert(current);
-	}
-    }
-  return work;
-}
-
-
 /* 
    MUST ANALYSIS
    First Step of the MUST analysis: Fixed point computation of MUST Abstract Cache States (ACS) without considering backedges.
@@ -398,113 +306,22 @@ set < ContextualNode > ICacheAnalysis::FixPointMust1stStep_ACS_in(set < Contextu
    Remarks: Introduces for a precise classification of access performed inside loops.
    This approach avoids a bottom state in the ACS as defined in Ferdinand's Thesis
 */
-bool ICacheAnalysis::FixPointMust1stStep()
+bool ICacheAnalysis::FixPointMust1stStep(Worklist & work)
 {
-  set < ContextualNode > work, work_in;
-
   AnalysisHelper::applyToAllNodesRecursive(p, initACSMUST, (void *)this);
   set < Edge * >backedges = AnalysisHelper::compute_backedges(p, call_graph); // getting the backedges.
-  work = AnalysisHelper::initWork();
-  //AnalysisHelper::printSet(work,"TheFixPointMustIntialwork");
-  while (!work.empty())
-    {
-      work_in = FixPointMust1stStep_ACS_out(work, backedges);
-      //AnalysisHelper::printSet(work_in,"TheFixPointFirstMustWork_in_");
-      work.clear();
-      work = FixPointMust1stStep_ACS_in(work_in, backedges);
-      //AnalysisHelper::printSet(work,"TheFixPointFirstMustWork*");
-      work_in.clear();
-    }
+  solveCacheFixPoint(*this, mustStore, AnalysisHelper::initWork(p), work, pool, &backedges);
   return true;
 }
 
-/* MustAnalysis analysis: Compute the ACS_out a set of nodes (work).
-   @return a set of nodes for which the ACS_in must be computed (all the nodes have to be visited at least once).*/
-set < ContextualNode > ICacheAnalysis::MustAnalysis_ACS_out(set < ContextualNode > &work, set < ContextualNode > &visited)
-{
-  //cout << "***Let's start MustAnalysis_ACS_out analysis***" << endl;
-  string in = ACSMUSTInName;
-  string out = ACSMUSTOutName;
-  set < ContextualNode > work_in;
-  bool b;
-
-  //cout << "@@@ This is MustAnalysis @@@" << endl;
-  for (set < ContextualNode >::iterator it = work.begin(); it != work.end(); it++)
-    {
-      ContextualNode current = *it;
-      //CmpACS_outcout << " ICacheAnalysis::MustAnalysis_ACS_out, Current context = " << getStringContextRepresentation(current.getContext()) << endl;
-      
-      AbstractCache < MUST > ACS_out = compute_ACS_out < MUST > (current, in);
-      AbstractCacheStateAttribute < MUST > &ca_attr_out = getACSContextualNode(MUST, current, out + current.context->getStringId());
-      b = ! ca_attr_out.cache.Equals(ACS_out);
-      if (b) ca_attr_out.cache = ACS_out;
-
-      if (visited.find(current) == visited.end())
-	{
-	  visited.insert(current);
-	  b = true;
-	}
-      if (b) AnalysisHelper::insertContextualSuccessors(current, work_in);
-    }
-  return work_in;
-}
-
-/* MustAnalysis: Compute the ACS_in of a set of nodes (work). 
-   @return a set of nodes for which the ACS_out must be computed (all the nodes have to be visited at least once). */
-set < ContextualNode > ICacheAnalysis::MustAnalysis_ACS_in(set < ContextualNode > & work_in, set < ContextualNode > &visited)
-{
-  //cout << "***Let's start MustAnalysis_ACS_in analysis***" << endl;
-  bool b;
-  string in = ACSMUSTInName;
-  string out = ACSMUSTOutName;
-  set < ContextualNode > work_out;
-
-  for (set < ContextualNode >::iterator it = work_in.begin(); it != work_in.end(); it++)
-    {
-      ContextualNode current = *it;
-
-      const vector < ContextualNode > &predecessors = GetContextualPredecessors(current);
-      assert(predecessors.size() != 0);	//it should not be the program's entry node
-
-      AbstractCache < MUST > new_ACS_in = getACSContextualNode(MUST, predecessors[0], out + predecessors[0].context->getStringId()).cache;
-      for (size_t i = 1; i < predecessors.size(); i++)
-	{
-	  new_ACS_in.Join(  getACSContextualNode(MUST, predecessors[i], out + predecessors[i].context->getStringId()).cache);
-	}
-
-      AbstractCacheStateAttribute < MUST > &ca_attr_in = getACSContextualNode(MUST, current, in + current.context->getStringId());
-      b = !ca_attr_in.cache.Equals(new_ACS_in);
-      if (b) ca_attr_in.cache = new_ACS_in;
-      b = ( b || (visited.find(current) == visited.end()));
-      if (b) work_out.insert(current);
-    }
-  return work_out;
-}
-
-
 /* MUST ANALYSIS.
    Fixed point computation of MUST Abstract Cache States (ACS).
    Remarks:All nodes have to be visited at least once.
 */
-bool ICacheAnalysis::MustAnalysis()
+bool ICacheAnalysis::MustAnalysis(Worklist & work)
 {
-  set < ContextualNode > visited, work, work_in;
-
-  FixPointMust1stStep();// Given a CFG, without loop, fixePoint , Branches, Mark the location of loops
-  // test iteration
-  // while count number stastics the number 
-  work = AnalysisHelper::initWork();
- // AnalysisHelper::printSet(work,"InitalMustWork");
-  while (!work.empty())
-    {
-      //loops analysis, fixed point iterations
-      work_in = MustAnalysis_ACS_out(work, visited);
-      //AnalysisHelper::printSet(work_in,"MustWorkIn");
-      work.clear();
-      work = MustAnalysis_ACS_in(work_in, visited);
-      //AnalysisHelper::printSet(work,"MustWork");
-      work_in.clear();
-    }
+  FixPointMust1stStep(work);
+  solveCacheFixPoint(*this, mustStore, AnalysisHelper::initWork(p), work, pool);
   return true;
 }
 
@@ -519,8 +336,7 @@ bool static ClassifCHMCMust(Cfg * c, Node * n, void *param)
   SerialisableStringAttribute AUnref("AU");	// Always-unreferenced to consider WCET cost = 0
   ICacheAnalysis *ca = (ICacheAnalysis *) param;
   string CHMCAttName = CHMCAttributeNameCode(ca->getLevelAnalysis());
-  string in = ACSMUSTInName;
-  string out = ACSMUSTOutName;
+  AbstractCacheStates < MUST > &store = ca->getMustStates();
 
   assert(c->HasAttribute(ContextListAttributeName));
   const ContextList & contexts = (ContextList &) c->GetAttribute(ContextListAttributeName);
@@ -530,8 +346,9 @@ bool static ClassifCHMCMust(Cfg * c, Node * n, void *param)
       string currentContext = (*context)->getStringId();
       string CACattName = AnalysisHelper::mkContextAttrName( CACAttributeNameCode(ca->getLevelAnalysis()), currentContext);
       //cout << "----The CACattName is " << CACattName << "---"<< endl;
-      assert(n->HasAttribute(in + currentContext));
-      AbstractCache < MUST > ca_must = getACSNode(MUST, n, in + currentContext).cache;
+      ContextualNode cn(*context, n);
+      assert(store.has(cn));
+      AbstractCache < MUST > ca_must = store.getIn(cn);
 
       vector < Instruction * >vi = n->GetAsm();
       for (size_t i = 0; i < vi.size(); i++)
@@ -565,10 +382,6 @@ bool static ClassifCHMCMust(Cfg * c, Node * n, void *param)
 	      ca_must.Update(add, accessValue);	//simulate the access for the next instruction
 	    }
 	}
-
-      //remove the ACS_in and ACS_out attributes
-      n->RemoveAttribute(in + currentContext);
-      n->RemoveAttribute(out + currentContext);
     }
   return true;
 }
@@ -583,99 +396,25 @@ bool static initACSMAY(Cfg * c, Node * n, void *param)
 {
   ICacheAnalysis *ca = (ICacheAnalysis *) param;
   AbstractCache < MAY > ACS_empty = ca->CacheFactoryMAY();
-  AbstractCacheStateAttribute < MAY > att(ACS_empty);
-
-  string in = ACSMAYInName;
-  string out = ACSMAYOutName;
+  AbstractCacheStateStore < MAY > &store = ca->getMayStore();
 
   assert(c->HasAttribute(ContextListAttributeName));
   const ContextList & contexts = (ContextList &) c->GetAttribute(ContextListAttributeName);
   for (ContextList::const_iterator context = contexts.begin(); context != contexts.end(); context++)
     {
-      string currentContext = (*context)->getStringId();
-      n->SetAttribute(in + currentContext, att);
-      n->SetAttribute(out + currentContext, att);
+      store.attach(ContextualNode(*context, n), ACS_empty);
     }
 
   return true;
 }
 
-/* MayAnalysis analysis: Compute the ACS_out a set of nodes (work).
-   @return a set of nodes for which the ACS_in must be computed.*/
-set < ContextualNode >ICacheAnalysis::MayAnalysis_ACS_out(set < ContextualNode > &work)
-{
-  // string attributeAccessName = CACAttributeNameCode(levelAnalysis);
-  string in = ACSMAYInName;
-  string out = ACSMAYOutName;
-  set < ContextualNode > work_in;
-  //cout << "@@@ This is MayAnalysis @@@" << endl;
-  for (set < ContextualNode >::iterator it = work.begin(); it != work.end(); it++)
-    {
-      ContextualNode current = *it;
-      AbstractCache < MAY > ACS_out = compute_ACS_out<MAY>(current, in);
-      AbstractCacheStateAttribute < MAY > &ca_attr_out = getACSContextualNode(MAY, current, out + current.context->getStringId());
-      if (!ca_attr_out.cache.Equals(ACS_out))
-	{
-	  ca_attr_out.cache = ACS_out;
-	  AnalysisHelper::insertContextualSuccessors(current, work_in);
-	}
-    } 
-  return work_in;
-}
-
-/* MayAnalysis: Compute the ACS_in of a set of nodes (work). 
-   @return a set of nodes for which the ACS_out must be computed.*/
-set < ContextualNode > ICacheAnalysis::MayAnalysis_ACS_in(set < ContextualNode > &work_in)
-{
-  //-- string attributeAccessName = CACAttributeNameCode(levelAnalysis);
-  string in = ACSMAYInName;
-  string out = ACSMAYOutName;
-
- set < ContextualNode > work;
-  for (set < ContextualNode >::iterator it = work_in.begin(); it != work_in.end(); it++)
-    {
-      ContextualNode current = *it;
-      
-      const vector < ContextualNode > &predecessors = GetContextualPredecessors(current);
-      assert(predecessors.size() != 0);	//it should not be the program's entry node
-      
-      AbstractCache < MAY > new_ACS_in = getACSContextualNode( MAY, predecessors[0], out + predecessors[0].context->getStringId()).cache;
-      for (size_t i = 1; i < predecessors.size(); i++)
-	{
-	  new_ACS_in.Join( getACSContextualNode(MAY, predecessors[i], out + predecessors[i].context->getStringId()).cache);
-	}
-      
-      AbstractCacheStateAttribute < MAY > &ca_attr_in = getACSContextualNode(MAY, current, in + current.context->getStringId());
-      
-      if (!ca_attr_in.cache.Equals(new_ACS_in))
-	{
-	  ca_attr_in.cache = new_ACS_in;
-	  work.insert(current);
-	}
-    }
-  return work;
-}
-
 /* MAY ANALYSIS.
    Fixed point computation of MAY Abstract Cache States (ACS).
  */
-bool ICacheAnalysis::MayAnalysis()
+bool ICacheAnalysis::MayAnalysis(Worklist & work)
 {
-  set < ContextualNode > work, work_in;
-
   AnalysisHelper::applyToAllNodesRecursive(p, initACSMAY, (void *)this);
-
-  work = AnalysisHelper::initWork();
- // AnalysisHelper::printSet(work,"InitalMayAnalysisWork");
-  while (!work.empty())
-    {
-      work_in = MayAnalysis_ACS_out(work);
-      //AnalysisHelper::printSet(work_in,"MayAnalysisWork_in");
-      work.clear();
-      work = MayAnalysis_ACS_in(work_in);
-      //AnalysisHelper::printSet(work,"MayAnalysisWork*");
-      work_in.clear();
-    }
+  solveCacheFixPoint(*this, mayStore, AnalysisHelper::initWork(p), work, pool);
   return true;
 }
 
@@ -690,8 +429,7 @@ bool static ClassifCHMCMay(Cfg * c, Node * n, void *param)
   SerialisableStringAttribute AUnref("AU");	// Always-unreferenced to consider WCET cost = 0
   ICacheAnalysis *ca = (ICacheAnalysis *) param;
   string CHMCAttName = CHMCAttributeNameCode(ca->getLevelAnalysis());
-  string in = ACSMAYInName;
-  string out = ACSMAYOutName;
+  AbstractCacheStates < MAY > &store = ca->getMayStates();
 
   assert(c->HasAttribute(ContextListAttributeName));
   const ContextList & contexts = (ContextList &) c->GetAttribute(ContextListAttributeName);
@@ -700,8 +438,9 @@ bool static ClassifCHMCMay(Cfg * c, Node * n, void *param)
       string currentContext = (*context)->getStringId();
       string CACattName = AnalysisHelper::mkContextAttrName( CACAttributeNameCode(ca->getLevelAnalysis()), currentContext);
 
-      assert(n->HasAttribute(in + currentContext));
-      AbstractCache < MAY > ca_may = getACSNode(MAY, n, in + currentContext).cache;
+      ContextualNode cn(*context, n);
+      assert(store.has(cn));
+      AbstractCache < MAY > ca_may = store.getIn(cn);
 
       vector < Instruction * >vi = n->GetAsm();
       for (size_t i = 0; i < vi.size(); i++)
@@ -728,10 +467,6 @@ bool static ClassifCHMCMay(Cfg * c, Node * n, void *param)
 		}
 	    }
 	}
-
-      //remove the ACS_in and ACS_out attributes
-      n->RemoveAttribute(in + currentContext);
-      n->RemoveAttribute(out + currentContext);
     }
   return true;
 }
@@ -755,13 +490,11 @@ bool static ClassifCHMCMay(Cfg * c, Node * n, void *param)
 
 set < ContextualNode > initACSPS(Program * p, ICacheAnalysis * a)
 {
-  string in = ACSPSInName;
-  string out = ACSPSOutName;  
+  AbstractCacheStateStore < PS > &store = a->getPSStore();
 
   set < ContextualNode > result;
 
   AbstractCache < PS > abstractCache = a->CacheFactoryPS();
-  AbstractCacheStateAttribute < PS > ca(abstractCache);
 
   vector < Cfg * >cfgs = p->GetAllCfgs();
 
@@ -775,7 +508,6 @@ set < ContextualNode > initACSPS(Program * p, ICacheAnalysis * a)
 	  for (ContextList::const_iterator context_it = contexts.begin(); context_it != contexts.end(); context_it++)
 	    {
 	      Context *context = *context_it;
-	      string context_id = context->getStringId();
 
 	      if (AnalysisHelper::CallerInLoop(context)) // if the current context is called in a loop
 		{
@@ -783,33 +515,12 @@ set < ContextualNode > initACSPS(Program * p, ICacheAnalysis * a)
 		  for (size_t j = 0; j < nodes.size(); j++)
 		    {
 		      // Attach the attribute to all nodes in the cfg.
-		      nodes[j]->SetAttribute(in + context_id, ca);
-		      nodes[j]->SetAttribute(out + context_id, ca);
+		      store.attach(ContextualNode(context, nodes[j]), abstractCache);
 		    }
 		}
 	      else
 		{
-		  vector < Loop * >loops = cfgs[i]->GetAllLoops();
-		  vector < Loop * >loopsOuter;
-
-		  //get only the outers loops of the current cfg
-		  for (size_t k = 0; k < loops.size(); k++)
-		    {
-		      bool found = false;
-		      for (size_t j = 0; j < loops.size() && !found; j++)
-			{
-			  if (k != j && loops[k]->IsNestedIn(loops[j]))
-			    {
-			      found = true;
-			    }	//loop k is nested in loop j
-			}
-		      if (!found)
-			{
-			  loopsOuter.push_back(loops[k]);
-			}	//loop k is not nested in other loop
-		    }
-		  //now loopOuter contains only the loop not nested
-
+		  vector < Loop * >loopsOuter = AnalysisHelper::getOuterLoops(cfgs[i]);
 		  for (size_t j = 0; j < loopsOuter.size(); ++j)
 		    {
 		      ContextualNode cn(context, loopsOuter[j]->GetHead());
@@ -819,8 +530,7 @@ set < ContextualNode > initACSPS(Program * p, ICacheAnalysis * a)
 		      for (size_t k = 0; k < nodes.size(); ++k)
 			{
 			  // Attach the attribute to all nodes in the loop.
-			  nodes[k]->SetAttribute(in + context_id, ca);
-			  nodes[k]->SetAttribute(out + context_id, ca);
+			  store.attach(ContextualNode(context, nodes[k]), abstractCache);
 			}
 		    }
 		}
@@ -830,104 +540,12 @@ set < ContextualNode > initACSPS(Program * p, ICacheAnalysis * a)
   return result;
 }
 
-/* PSAnalysis: Compute the ACS_out of a set of nodes (work).
-   @return a set of nodes for which the ACS_in must be computed. */
-set < ContextualNode > ICacheAnalysis::PSAnalysis_ACS_out(set < ContextualNode >&work)
-{
-  string attributeAccessName = CACAttributeNameCode(levelAnalysis);
-  string in = ACSPSInName;
-  string out = ACSPSOutName;
-  set < ContextualNode > work_in;
-  //cout << "@@@ This is PSAnalysis @@@" << endl;
-  for (set < ContextualNode >::iterator it = work.begin(); it != work.end(); it++)
-    {
-      ContextualNode current = *it;
-      AbstractCache < PS > ACS_out = compute_ACS_out<PS>(current, in);
-
-      AbstractCacheStateAttribute < PS > &ca_attr_out = getACSContextualNode(PS, current, out + current.context->getStringId());
-      if (!ca_attr_out.cache.Equals(ACS_out))
-	{
-	  ca_attr_out.cache = ACS_out;
-
-	  vector < ContextualNode > succ = GetContextualSuccessors(current);
-	  for (size_t i = 0; i < succ.size(); i++)
-	    {
-	      // A successor is added only if it is present in the loop
-	      if (succ[i].node->HasAttribute(in + succ[i].context->getStringId()))
-		{
-		  work_in.insert(succ[i]);
-		}
-	    }
-	}
-    }
-  return work_in;
-}
-
-/* PSAnalysis: Compute the ACS_in of a set of nodes (work_in). 
-   @return a set of nodes for which the ACS_out must be computed. */
-set < ContextualNode > ICacheAnalysis::PSAnalysis_ACS_in(set < ContextualNode >&work_in)
-{
-  //-- string attributeAccessName = CACAttributeNameCode(levelAnalysis);
-  string in = ACSPSInName;
-  string out = ACSPSOutName;
-  set < ContextualNode > work_out;
-  string id;
-
-   for (set < ContextualNode >::iterator it = work_in.begin(); it != work_in.end(); it++)
-	{
-	  ContextualNode current = *it;
-
-	  const vector < ContextualNode > &predecessors = GetContextualPredecessors(current);
-	  assert(predecessors.size() != 0);	//it should not be the program's entry node
-
-	  AbstractCache < PS > new_ACS_in;
-	  bool first = true;
-	  for (size_t i = 0; i < predecessors.size(); i++)
-	    {
-	      id = out + predecessors[i].context->getStringId();
-	      if (predecessors[i].node->HasAttribute(id))
-		{
-		  if (first)
-		    {
-		      first = false;
-		      new_ACS_in = getACSContextualNode(PS, predecessors[i], id).cache;
-		    }
-		  else
-		    {
-		      new_ACS_in.Join( getACSContextualNode( PS, predecessors[i], id).cache);
-		    }
-		}
-	    }
-
-	  AbstractCacheStateAttribute < PS > &ca_attr_in = getACSContextualNode(PS, current, in + current.context->getStringId());
-	  if (!ca_attr_in.cache.Equals(new_ACS_in))
-	    {
-	      ca_attr_in.cache = new_ACS_in;
-	      work_out.insert(current);
-	    }
-	} 
-   return work_out;
-}
-
 /*  PS ANALYSIS.
     Fixed point computation of PS Abstract Cache States (ACS).
 */
-bool ICacheAnalysis::PSAnalysis()
+bool ICacheAnalysis::PSAnalysis(Worklist & work)
 {
-  set < ContextualNode > work, work_in;
-
-  work = initACSPS(p, this);
-  //AnalysisHelper::printSet(work,"InitalPSanalysisWork");
-  while (!work.empty())
-    {
-      work_in = PSAnalysis_ACS_out(work);
-      //AnalysisHelper::printSet(work_in,"PSanalysisWork_in");
-      work.clear();
-      work = PSAnalysis_ACS_in(work_in);
-      //AnalysisHelper::printSet(work,"PSanalysisWork");
-      work_in.clear();
-    }
-
+  solveCacheFixPoint(*this, psStore, initACSPS(p, this), work, pool);
   return true;
 }
 
@@ -942,8 +560,7 @@ bool static ClassifCHMCPS(Cfg * c, Node * n, void *param)
   SerialisableStringAttribute AUnref("AU");	// Always-unreferenced to consider WCET cost = 0
   ICacheAnalysis *ca = (ICacheAnalysis *) param;
   string CHMCAttName = CHMCAttributeNameCode(ca->getLevelAnalysis());
-  string in = ACSPSInName;
-  string out = ACSPSOutName;
+  AbstractCacheStates < PS > &store = ca->getPSStates();
 
   assert(c->HasAttribute(ContextListAttributeName));
   const ContextList & contexts = (ContextList &) c->GetAttribute(ContextListAttributeName);
@@ -952,9 +569,10 @@ bool static ClassifCHMCPS(Cfg * c, Node * n, void *param)
       string currentContext = (*context)->getStringId();
       string CACattName = AnalysisHelper::mkContextAttrName( CACAttributeNameCode(ca->getLevelAnalysis()), currentContext);
       
-      if (n->HasAttribute(in + currentContext))
+      ContextualNode cn(*context, n);
+      if (store.has(cn))
 	{
-	  AbstractCache < PS > ca_ps = getACSNode(PS, n, in + currentContext).cache;
+	  AbstractCache < PS > ca_ps = store.getIn(cn);
 
 	  vector < Instruction * >vi = n->GetAsm();
 	  for (size_t i = 0; i < vi.size(); i++)
@@ -989,10 +607,6 @@ bool static ClassifCHMCPS(Cfg * c, Node * n, void *param)
 		    }
 		}
 	    }
-
-	  //remove the ACS_in and ACS_out attributes
-	  n->RemoveAttribute(in + currentContext);
-	  n->RemoveAttribute(out + currentContext);
 	}
     }
   return true;
@@ -1080,6 +694,60 @@ bool static ClassifCACNext(Cfg * c, Node * n, void *param)
   return true;
 }
 
+/*************************************************************************************************************************
+ Summary mode
+ *************************************************************************************************************************/
+
+bool ICacheAnalysis::sameAccesses(Context * a, Context * b)
+{
+  if (levelAnalysis == 1 || a == b) return true;	// L1: CAC=A for each access
+
+  AttributeKey idAccessA = accessKeys.get(a);
+  AttributeKey idAccessB = accessKeys.get(b);
+  vector < Node * >nodes = a->getCurrentFunction()->GetAllNodes();
+  for (size_t i = 0; i < nodes.size(); i++)
+    {
+      vector < Instruction * >vi = nodes[i]->GetAsm();
+      for (size_t j = 0; j < vi.size(); j++)
+	{
+	  if (((SerialisableStringAttribute &) vi[j]->GetAttribute(idAccessA)).GetValue() !=
+	      ((SerialisableStringAttribute &) vi[j]->GetAttribute(idAccessB)).GetValue())
+	    return false;
+	}
+      if (nodes[i]->IsCall() && !sameAccesses(a->getCalleeContext(nodes[i]), b->getCalleeContext(nodes[i])))
+	return false;
+    }
+  return true;
+}
+
+//------------------------------------------------
+// Number of accesses per CHMC (all contexts),
+// to compare the precision of the modes
+//------------------------------------------------
+struct CHMCCounts
+{
+  string CHMCAttName;
+  map < string, unsigned long >counts;
+};
+
+bool static CountCHMC(Cfg * c, Node * n, void *param)
+{
+  CHMCCounts *counts = (CHMCCounts *) param;
+
+  assert(c->HasAttribute(ContextListAttributeName));
+  const ContextList & contexts = (ContextList &) c->GetAttribute(ContextListAttributeName);
+  for (ContextList::const_iterator context = contexts.begin(); context != contexts.end(); context++)
+    {
+      string id = AnalysisHelper::mkContextAttrName(counts->CHMCAttName, (*context)->getStringId());
+      vector < Instruction * >vi = n->GetAsm();
+      for (size_t i = 0; i < vi.size(); i++)
+	{
+	  counts->counts[((SerialisableStringAttribute &) (vi[i]->GetAttribute(id))).GetValue()]++;
+	}
+    }
+  return true;
+}
+
 /*************************************************************************************************************************
  Generic analysis functions
  *************************************************************************************************************************/
@@ -1095,6 +763,20 @@ bool ICacheAnalysis::PerformAnalysis()
       AnalysisHelper::applyToAllNodesRecursive(p, initL1AccessAttributeForInstruction, NULL);
     }
 
+  // Numbering of the contextual nodes, for the ACS stores,
+  // and their evaluation order in the fixed point computations
+  const ContextTree & contextTree = (ContextTree &) p->GetAttribute(ContextTreeAttributeName);
+  nodeIndex.build(contextTree);
+  nodeOrder.build(contextTree, nodeIndex, *AnalysisHelper::initWork(p).begin());
+
+  // Parallel analysis of groups of cache sets: the names of the contextual attributes
+  // read by the threads are interned beforehand
+  if (nb_threads > 1 && nb_sets > 1 && !summary_mode)
+    {
+      pool = new ThreadPool(nb_threads);
+      accessKeys.internAll(contextTree);
+    }
+
   float time = 0.0;
   //------------------------
   // MUST analysis
@@ -1103,12 +785,31 @@ bool ICacheAnalysis::PerformAnalysis()
     {
       Timer timer_must;
       timer_must.initTimer();
-      MustAnalysis();
-      AnalysisHelper::applyToAllNodesRecursive(p, ClassifCHMCMust, (void *)this);
-      timer_must.addTimer(time);
-      stringstream infostr;
-      infostr << "ICacheAnalysis: MUST done: " << time;
-      Logger::addInfo(infostr.str());
+      if (summary_mode)
+	{
+	  set < Edge * >backedges = AnalysisHelper::compute_backedges(p, call_graph);
+	  CacheSummaryStore < MUST, ICacheAnalysis > summaries(*this, nodeIndex, nodeOrder, CacheFactoryMUST(), call_string_depth, true, &backedges);
+	  summaries.analyseProgram(contextTree);
+	  mustStates = &summaries;
+	  AnalysisHelper::applyToAllNodesRecursive(p, ClassifCHMCMust, (void *)this);
+	  mustStates = &mustStore;
+	  timer_must.addTimer(time);
+	  stringstream infostr;
+	  infostr << "ICacheAnalysis: MUST done: " << time << " (" << summaries.getReport(contextTree) << ")";
+	  Logger::addInfo(infostr.str());
+	}
+      else
+	{
+	  mustStore.init(nodeIndex);
+	  Worklist work(nodeOrder);
+	  MustAnalysis(work);
+	  AnalysisHelper::applyToAllNodesRecursive(p, ClassifCHMCMust, (void *)this);
+	  mustStore.clear();
+	  timer_must.addTimer(time);
+	  stringstream infostr;
+	  infostr << "ICacheAnalysis: MUST done: " << time << " (" << work.getNbOutEvaluations() << " node evaluations, " << work.getNbInEvaluations() << " joins)";
+	  Logger::addInfo(infostr.str());
+	}
     }
   //------------------------
   // PS analysis
@@ -1118,12 +819,30 @@ bool ICacheAnalysis::PerformAnalysis()
       time = 0.0;
       Timer timer_ps;
       timer_ps.initTimer();
-      PSAnalysis();
-      AnalysisHelper::applyToAllNodesRecursive(p, ClassifCHMCPS, (void *)this);
-      timer_ps.addTimer(time);
-      stringstream infostr;
-      infostr << "ICacheAnalysis: PS done: " << time;
-      Logger::addInfo(infostr.str());
+      if (summary_mode)
+	{
+	  CacheSummaryStore < PS, ICacheAnalysis > summaries(*this, nodeIndex, nodeOrder, CacheFactoryPS(), call_string_depth, false);
+	  summaries.analyseLoops(contextTree, call_graph);
+	  psStates = &summaries;
+	  AnalysisHelper::applyToAllNodesRecursive(p, ClassifCHMCPS, (void *)this);
+	  psStates = &psStore;
+	  timer_ps.addTimer(time);
+	  stringstream infostr;
+	  infostr << "ICacheAnalysis: PS done: " << time << " (" << summaries.getReport(contextTree) << ")";
+	  Logger::addInfo(infostr.str());
+	}
+      else
+	{
+	  psStore.init(nodeIndex);
+	  Worklist work(nodeOrder);
+	  PSAnalysis(work);
+	  AnalysisHelper::applyToAllNodesRecursive(p, ClassifCHMCPS, (void *)this);
+	  psStore.clear();
+	  timer_ps.addTimer(time);
+	  stringstream infostr;
+	  infostr << "ICacheAnalysis: PS done: " << time << " (" << work.getNbOutEvaluations() << " node evaluations, " << work.getNbInEvaluations() << " joins)";
+	  Logger::addInfo(infostr.str());
+	}
     }
   //------------------------
   // MAY analysis
@@ -1133,12 +852,30 @@ bool ICacheAnalysis::PerformAnalysis()
       time = 0.0;
       Timer timer_may;
       timer_may.initTimer();
-      MayAnalysis();
-      AnalysisHelper::applyToAllNodesRecursive(p, ClassifCHMCMay, (void *)this);
-      timer_may.addTimer(time);
-      stringstream infostr;
-      infostr << "ICacheAnalysis: MAY done: " << time;
-      Logger::addInfo(infostr.str());
+      if (summary_mode)
+	{
+	  CacheSummaryStore < MAY, ICacheAnalysis > summaries(*this, nodeIndex, nodeOrder, CacheFactoryMAY(), call_string_depth, true);
+	  summaries.analyseProgram(contextTree);
+	  mayStates = &summaries;
+	  AnalysisHelper::applyToAllNodesRecursive(p, ClassifCHMCMay, (void *)this);
+	  mayStates = &mayStore;
+	  timer_may.addTimer(time);
+	  stringstream infostr;
+	  infostr << "ICacheAnalysis: MAY done: " << time << " (" << summaries.getReport(contextTree) << ")";
+	  Logger::addInfo(infostr.str());
+	}
+      else
+	{
+	  mayStore.init(nodeIndex);
+	  Worklist work(nodeOrder);
+	  MayAnalysis(work);
+	  AnalysisHelper::applyToAllNodesRecursive(p, ClassifCHMCMay, (void *)this);
+	  mayStore.clear();
+	  timer_may.addTimer(time);
+	  stringstream infostr;
+	  infostr << "ICacheAnalysis: MAY done: " << time << " (" << work.getNbOutEvaluations() << " node evaluations, " << work.getNbInEvaluations() << " joins)";
+	  Logger::addInfo(infostr.str());
+	}
     }
   
   if (perfectIcache) 
@@ -1146,11 +883,26 @@ bool ICacheAnalysis::PerformAnalysis()
   else
     AnalysisHelper::applyToAllNodesRecursive(p, ClassifCHMCNC, (void *)this); // NC classification
 
+  // Classification of the accesses of all the contexts (precision of the summary mode)
+  CHMCCounts counts;
+  counts.CHMCAttName = CHMCAttributeNameCode(levelAnalysis);
+  AnalysisHelper::applyToAllNodesRecursive(p, CountCHMC, (void *)&counts);
+  stringstream countstr;
+  countstr << "ICacheAnalysis: L" << levelAnalysis << " classification:";
+  for (map < string, unsigned long >::const_iterator it = counts.counts.begin(); it != counts.counts.end(); it++)
+    {
+      countstr << " " << it->first << " " << it->second;
+    }
+  Logger::addInfo(countstr.str());
+
   //------------------------
   // CAC next level
   //------------------------
   AnalysisHelper::applyToAllNodesRecursive(p, ClassifCACNext, (void *)this);
 
+  delete pool;
+  pool = NULL;
+
   return true;
 }
 
@@ -1178,7 +930,8 @@ bool ICacheAnalysis::CheckInputAttributes()
 // Set up cache parameters for the analysis
 // and cac_computation map initialization
 //------------------------------------------------
-ICacheAnalysis::ICacheAnalysis(Program * p, int nbsets, int nbways, int cachelinesize, t_replacement_policy r, int levelCache, bool apply_must, bool apply_persistence, bool apply_may, bool keepage, bool picache):Analysis (p)
+ICacheAnalysis::ICacheAnalysis(Program * p, int nbsets, int nbways, int cachelinesize, t_replacement_policy r, int levelCache, bool apply_must, bool apply_persistence, bool apply_may, bool keepage, bool picache, int nbthreads, bool summary, int callstringdepth):Analysis (p),
+  accessKeys (AnalysisHelper::mkContextAttrName (CACAttributeNameCode(levelCache), ""))
 {
   perfectIcache = picache;
   nb_sets = nbsets;
@@ -1186,6 +939,13 @@ ICacheAnalysis::ICacheAnalysis(Program * p, int nbsets, int nbways, int cachelin
   cacheline_size = cachelinesize;
   replacement_policy = r;
   levelAnalysis = levelCache;
+  nb_threads = (nbthreads > 1) ? nbthreads : 1;
+  pool = NULL;
+  summary_mode = summary;
+  call_string_depth = callstringdepth;
+  mustStates = &mustStore;
+  mayStates = &mayStore;
+  psStates = &psStore;
 
   if (perfectIcache)
     {
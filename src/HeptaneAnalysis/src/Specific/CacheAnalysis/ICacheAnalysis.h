@@ -29,6 +29,7 @@ See CREDITS.txt for credits of authorship
 #include "Generic/Analysis.h"
 #include "Specific/CacheAnalysis/Cache.h"
 #include "Specific/CacheAnalysis/CacheAnalysis.h"
+#include "Specific/CacheAnalysis/CacheSummary.h"
 
 #include "Generic/CallGraph.h"
 #include "Generic/ContextHelper.h"
@@ -64,6 +65,10 @@ See CREDITS.txt for credits of authorship
    - Scope-aware data cache analysis for WCET estimation. B. K. Huynh, L. Ju, and A. Roychoudhury. RTAS 2011. (for the persistence analysis)
    - Timing predictability of cache replacement policies. J. Reineke, D. Grund, C. Berg, and R. Wilhelm. RTSJ 2007 (for the replacement policies)
    - WCET analysis of multi-level non-inclusive set-associative instruction caches. D. Hardy, I. Puaut. RTSS 2008 (for the cache hierarchy)
+
+   In the summary mode, the fixed points are computed per function and entry ACS instead of
+   per context (see CacheSummaryStore), optionally with bounded call strings. The contexts
+   are kept: the classification of the accesses is still attached per context.
 */
 
 class ICacheAnalysis: public Analysis
@@ -86,63 +91,94 @@ private:
   /** multilevel analysis: current level */
   int levelAnalysis;
 
+  /** Interned names of the contextual attributes read by the fixed point computations
+      (access classification of the level) */
+  ContextualAttributeKeys accessKeys;
+
+  /** Numbering and evaluation order of the contextual nodes, and ACS of the MUST, MAY and PS analyses (valid during an analysis only) */
+  ContextualNodeIndex nodeIndex;
+  ContextualNodeOrder nodeOrder;
+  AbstractCacheStateStore < MUST > mustStore;
+  AbstractCacheStateStore < MAY > mayStore;
+  AbstractCacheStateStore < PS > psStore;
+
+  /** Summary mode: the functions are analysed once per entry ACS (see CacheSummaryStore),
+      with call strings bounded to call_string_depth calls (unbounded when -1) */
+  bool summary_mode;
+  int call_string_depth;
+
+  /** ACS_in read by the classification functions: the stores above, or the summaries in the summary mode */
+  AbstractCacheStates < MUST > *mustStates;
+  AbstractCacheStates < MAY > *mayStates;
+  AbstractCacheStates < PS > *psStates;
+
+  /** Parallel analysis: number of threads analysing groups of cache sets (1: sequential analysis),
+      and their pool (valid during an analysis only, NULL for a sequential analysis) */
+  unsigned int nb_threads;
+  ThreadPool *pool;
+
   /** Program call graph (used for detection of dead code to speed up the analysis). */
   CallGraph *call_graph;
 
   /** First Step of the MUST analysis: Fixed point computation of MUST Abstract Cache States (ACS) without considering backedges. */
-  bool FixPointMust1stStep ();
+  bool FixPointMust1stStep (Worklist & work);
 
   /** Fixed point computation of MUST Abstract Cache States (ACS). */
-  bool MustAnalysis ();
+  bool MustAnalysis (Worklist & work);
 
   /** Fixed point computation of MAY Abstract Cache States (ACS). */
-  bool MayAnalysis ();
+  bool MayAnalysis (Worklist & work);
 
   /** Fixed point computation of PS Abstract Cache States (ACS). */
-  bool PSAnalysis ();
+  bool PSAnalysis (Worklist & work);
+
+  template < typename T, typename A > friend class CacheFixPoint;
+  template < typename T, typename A > friend class CacheSummaryStore;
 
+  template < typename T > void compute_ACS_out(ContextualNode & current, Instruction *vinstr, AbstractCache < T > &ACS_out, AttributeKey idAccessName);
 
-  template < typename T > void compute_ACS_out(ContextualNode & current, Instruction *vinstr, AbstractCache < T > &ACS_out, string idAccessName);
+  /** @return the ACS_out of a ContextualNode (current) whose ACS_in is ACS_in. */
+  template < typename T > AbstractCache < T > compute_ACS_out(ContextualNode &current, const AbstractCache < T > &ACS_in);
 
   /** @return the ACS_out, for an analysis T, of a ContextualNode (current). 
-      The initial ACS_out is the ACS_in of the current analysis (given by the attribute inAnalysisName in the context of current).
+      The initial ACS_out is the ACS_in of the current analysis (given by its store for current).
       Then the ACS_out is updated for each Load instructions of the node.
-      Remark: inAnalysisName ::= ACSMUSTInName | ACSMAYInName | ACSPSInName. */
-  template<typename T> AbstractCache < T > compute_ACS_out(ContextualNode &current, string &inAnalysisName);
+      Remark: store ::= mustStore | mayStore | psStore. */
+  template<typename T> AbstractCache < T > compute_ACS_out(ContextualNode &current, AbstractCacheStateStore < T > &store);
 
-  /** FixPointMust1stStep analysis: Compute the ACS_out a set of nodes (work), without considering backedges.
-      @return a set of nodes for which the ACS_in must be computed. */
-  set < ContextualNode > FixPointMust1stStep_ACS_out(set < ContextualNode >&work_in, set < Edge * >& backedges );
-
-  /** FixPointMust1stStep analysis: Compute the ACS_in of a set of nodes (work) without considering backedges.
-      @return a set of nodes for which the ACS_out must be computed. */
-  set < ContextualNode > FixPointMust1stStep_ACS_in(set < ContextualNode >&work, set < Edge * >& backedges );
-
-  /** MustAnalysis analysis: Compute the ACS_out a set of nodes (work).
-      @return a set of nodes for which the ACS_in must be computed (all the nodes have to be visited at least once).*/
-  set < ContextualNode > MustAnalysis_ACS_out(set < ContextualNode >&work, set < ContextualNode > &visited);
-
-  /** MustAnalysis: Compute the ACS_in of a set of nodes (work_in). 
-      @return a set of nodes for which the ACS_out must be computed (all the nodes have to be visited at least once). */
-  set < ContextualNode > MustAnalysis_ACS_in(set < ContextualNode >&work_in, set < ContextualNode > &visited);
-
-  /** MayAnalysis analysis: Compute the ACS_out a set of nodes (work).
-      @return a set of nodes for which the ACS_in must be computed (all the nodes have to be visited at least once).*/
-  set < ContextualNode > MayAnalysis_ACS_out(set < ContextualNode > &work);
-
-  /** MayAnalysis: Compute the ACS_in of a set of nodes (work_in). 
-      @return a set of nodes for which the ACS_out must be computed (all the nodes have to be visited at least once). */
-  set < ContextualNode > MayAnalysis_ACS_in(set < ContextualNode > &work_in);
+public:
 
-  /** PSAnalysis: Compute the ACS_out of a set of nodes (work).
-       @return a set of nodes for which the ACS_in must be computed. */
-  set < ContextualNode > PSAnalysis_ACS_out(set < ContextualNode >&work);
+  /** ACS of the analyses, attached by the initialisation functions and read by the classification functions */
+  AbstractCacheStateStore < MUST > &getMustStore ()
+  {
+    return mustStore;
+  };
+  AbstractCacheStateStore < MAY > &getMayStore ()
+  {
+    return mayStore;
+  };
+  AbstractCacheStateStore < PS > &getPSStore ()
+  {
+    return psStore;
+  };
 
-  /** PSAnalysis: Compute the ACS_in of a set of nodes (work_in). 
-      @return a set of nodes for which the ACS_out must be computed. */
-  set < ContextualNode > PSAnalysis_ACS_in(set < ContextualNode >&work_in);
+  /** ACS_in of the contextual nodes read by the classification functions */
+  AbstractCacheStates < MUST > &getMustStates ()
+  {
+    return *mustStates;
+  };
+  AbstractCacheStates < MAY > &getMayStates ()
+  {
+    return *mayStates;
+  };
+  AbstractCacheStates < PS > &getPSStates ()
+  {
+    return *psStates;
+  };
 
-public:
+  /** @return true if the instructions of the contexts a and b, and of their callee contexts,
+      have the same access classification for the level analysed (always true for the L1 cache). */
+  bool sameAccesses (Context * a, Context * b);
 
   /** @return an empty Must cache */
     AbstractCache < MUST > CacheFactoryMUST () const;
@@ -156,7 +192,8 @@ public:
 
   /** Constructor. Sets up cache parameters */
     ICacheAnalysis (Program * p, int nbsets, int nbways, int cachelinesize,
-		    t_replacement_policy r, int cacheLevel, bool apply_must, bool apply_persistence, bool apply_may, bool keepage, bool picache);
+		    t_replacement_policy r, int cacheLevel, bool apply_must, bool apply_persistence, bool apply_may, bool keepage, bool picache, int nbthreads = 1,
+		    bool summary = false, int callstringdepth = -1);
 
   /** Destructor. */
    ~ICacheAnalysis ()
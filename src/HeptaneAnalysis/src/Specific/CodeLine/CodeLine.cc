@@ -130,7 +130,7 @@ CodeLine::PerformAnalysis ()
 	  for (unsigned int k = 0; k < instructionList.size (); k++)
 	    {
 	      // getting code addresse
-	      AddressAttribute attr = (AddressAttribute &) instructionList[k]->GetAttribute (AddressAttributeName);
+	      const AddressAttribute & attr = (AddressAttribute &) instructionList[k]->GetAttribute (AddressAttributeName);
 	      codeAddrList.push_back (attr.getCodeAddress ());
 	      codeInstructionList.push_back (instructionList[k]);
 	    }
@@ -139,7 +139,7 @@ int ARMAddressAnalysis::getStackMaxOffset(string s_instr, int StackMaxOffset)
 }
 
 // COPY of MIPS
-void ARMAddressAnalysis::analyzeStack (Cfg * cfg, Instruction * Instr, long offset, string access, int sizeOfMemoryAccess, bool precision, Context *context)
+void ARMAddressAnalysis::analyzeStack (Cfg * cfg, Instruction * Instr, long offset, long stride, long count, string access, int sizeOfMemoryAccess, bool precision, Context *context)
 {
 
   //get the StackInfoAttributeName of current cfg
@@ -177,6 +177,9 @@ void ARMAddressAnalysis::analyzeStack (Cfg * cfg, Instruction * Instr, long offs
 	}
       //--
 
+      // strided accesses which go out of the frame: the whole frame may be accessed
+      if (precision && count > 1 && offset + (count - 1) * stride > stack_maxoffset)
+	precision = false;
       if (precision)
 	{
 	  addr = sp + offset;
@@ -185,10 +188,12 @@ void ARMAddressAnalysis::analyzeStack (Cfg * cfg, Instruction * Instr, long offs
       else
 	{
 	  addr = sp;
+	  stride = 0;
+	  count = 1;
 	  // TODO: check the MIPS ABI if the parameters of the caller can be accessed if not stack_size_caller can be used instead
 	  if (stack_size == 0) size = stack_maxoffset_caller; else size = stack_maxoffset;
 	}
-      AddressInfo contextual_info = mkAddressInfo( Instr, access, precision, "stack","", addr, size);
+      AddressInfo contextual_info = mkAddressInfo( Instr, access, precision, "stack","", addr, size, stride, count);
       setContextualAddressAttribute(Instr, context, contextual_info);
     }
 }
@@ -197,14 +202,22 @@ void ARMAddressAnalysis::analyzeStack (Cfg * cfg, Instruction * Instr, long offs
 // COPY OF MIPS !!!
 // set the AddressAttribute for a gp or lui access; 
 // local to setLoadStoreAddressAttribute
-void ARMAddressAnalysis::analyzeReg (Instruction * Instr, long addr, string access, int sizeOfMemoryAccess, bool precision)
+void ARMAddressAnalysis::analyzeReg (Instruction * Instr, long addr, long stride, long count, string access, int sizeOfMemoryAccess, bool precision)
 {
   string var_name;
   unsigned long start_addr = 0;
   int size = 0;
   string section_name;
 
-  symbol_table.getInfo (addr, &var_name, &start_addr, &size, &section_name);
+  // strided accesses beginning out of the variables (e.g. an index bounded by a test ignored by the analysis):
+  // the variable of the first element found may be accessed as a whole
+  bool found = symbol_table.findInfo (addr, &var_name, &start_addr, &size, &section_name);
+  for (long k = 1; !found && k < count; k++)
+    {
+      found = symbol_table.findInfo (addr + k * stride, &var_name, &start_addr, &size, &section_name);
+      precision = false;
+    }
+  if (!found) symbol_table.getInfo (addr, &var_name, &start_addr, &size, &section_name); // reports the error
 
   if (start_addr == 0 || size == 0)
     {
@@ -212,7 +225,13 @@ void ARMAddressAnalysis::analyzeReg (Instruction * Instr, long addr, string acce
     }
   else
     {
-      mkAddressInfoAttribute(Instr, access, precision, section_name, var_name,  ( precision ? addr: start_addr) , ( precision ? sizeOfMemoryAccess : size ) );
+      // strided accesses which go out of the variable: the whole variable may be accessed
+      if (precision && count > 1 && addr + (count - 1) * stride + sizeOfMemoryAccess > (long) start_addr + size)
+	precision = false;
+      if (precision)
+	mkAddressInfoAttribute(Instr, access, true, section_name, var_name, addr, sizeOfMemoryAccess, stride, count);
+      else
+	mkAddressInfoAttribute(Instr, access, false, section_name, var_name, start_addr, size);
     }
 }
 
@@ -226,15 +245,16 @@ bool ARMAddressAnalysis::setLoadStoreAddressAttribute(Cfg * vCfg, Instruction* v
   vector < string > regList;
   long loffset;
 
-  asm_code = vinstr->GetCode ();
+  const DecodedInstruction & decoded = AnalysisHelper::getDecoded (vinstr);
+  asm_code = decoded.code;
 
-  bool isLoad = Arch::isLoad (asm_code);
-  bool isStore = Arch::isStore (asm_code);
+  bool isLoad = decoded.load;
+  bool isStore = decoded.store;
   
   if (!isLoad && ! isStore) return false;
 
   // get the size of the access according to the op code
-  int sizeOfMemoryAccess = Arch::getSizeOfMemoryAccess (asm_code);
+  int sizeOfMemoryAccess = decoded.accessSize;
   
   if (isLoad) access = "read"; else access = "write"; // access type
 
@@ -246,7 +266,7 @@ bool ARMAddressAnalysis::setLoadStoreAddressAttribute(Cfg * vCfg, Instruction* v
       loffset = GetOffsetValue(asm_code);
       TRACE( cout << "ARMAddressAnalysis::setLoadStoreAddressAttribute (sp) instr = " <<  asm_code << ", loffset= "  
 	     << loffset << " , sizeOfMemoryAccess= " << sizeOfMemoryAccess << endl);
-      analyzeStack (vCfg, vinstr, loffset, access, sizeOfMemoryAccess, true, context);
+      analyzeStack (vCfg, vinstr, loffset, 0, 1, access, sizeOfMemoryAccess, true, context);
     }
   else
     {
@@ -261,6 +281,8 @@ bool ARMAddressAnalysis::setLoadStoreAddressAttribute(Cfg * vCfg, Instruction* v
 	    
       string p0 = access_pattern[0];
       bool prec =  access_pattern[2] == "1";
+      long stride, count;
+      getAccessStride(access_pattern, &stride, &count);
       // access using $reg different from $sp
       // Example ldr R, [pc, #val] et MEM[pc + val] is an immediate value ( load a immediate value)
       if (p0 == "immWord")  
@@ -274,19 +296,19 @@ bool ARMAddressAnalysis::setLoadStoreAddressAttribute(Cfg * vCfg, Instruction* v
 	if (p0 == "lui")
 	  {
 	    long addr = Utl::string2long(access_pattern[1]);
-	    analyzeReg (vinstr, addr, access, sizeOfMemoryAccess, prec);
+	    analyzeReg (vinstr, addr, stride, count, access, sizeOfMemoryAccess, prec);
 	  }
 	else
 	  if (p0 == "gp")
 	    {
 	      long addr = Utl::string2long(access_pattern[1]);
-	      analyzeReg (vinstr, addr, access, sizeOfMemoryAccess, prec);
+	      analyzeReg (vinstr, addr, stride, count, access, sizeOfMemoryAccess, prec);
 	    }
 	  else if (p0 == "sp")
 	    {
 	      loffset = Utl::string2long(access_pattern[1]);
 	      TRACE(cout << " Stack pointer ----*****------" << asm_code << endl;);
-	      analyzeStack (vCfg, vinstr, loffset, access, sizeOfMemoryAccess, prec, context);
+	      analyzeStack (vCfg, vinstr, loffset, stride, count, access, sizeOfMemoryAccess, prec, context);
 	    }
 	  else //- unknown- pointer: all addresses can be accessed (stub)
 	    {
@@ -57,8 +57,8 @@ class ARMAddressAnalysis:public AddressAnalysis
  private:
   bool extractRegVal( string mem_pattern, string &reg, string & val);
   long GetOffsetValue(string asm_code);
-  void analyzeStack (Cfg * cfg, Instruction * Instr, long offset, string access, int sizeOfMemoryAccess, bool precision, Context *context);
-  void analyzeReg (Instruction * Instr, long addr, string access, int sizeOfMemoryAccess, bool precision);
+  void analyzeStack (Cfg * cfg, Instruction * Instr, long offset, long stride, long count, string access, int sizeOfMemoryAccess, bool precision, Context *context);
+  void analyzeReg (Instruction * Instr, long addr, long stride, long count, string access, int sizeOfMemoryAccess, bool precision);
   int getStackSize(Instruction * vinstr);
  protected:
   int getStackSize (Cfg * cfg);
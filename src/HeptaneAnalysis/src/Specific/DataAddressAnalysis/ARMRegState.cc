@@ -54,17 +54,15 @@ ARMRegState::ARMRegState (int stackSize):RegState(ARM_NB_REGISTERS)
 }
 
 
+// pc is left unknown: the values relative to pc are replaced by the word they designate (see simulate).
 void ARMRegState::setPredefValues()
 {
   reset_sp();
-  state[ARM_PC_REGISTER] = "pc";
-  precision[ARM_PC_REGISTER] = true;
 }
 
 void ARMRegState::reset_sp()
 {
-  state[ARM_SP_REGISTER] = "sp";
-  precision[ARM_SP_REGISTER] = true;
+  state[ARM_SP_REGISTER] = AbstractValue(BASE_SP, 0, true);
 }
 
 
@@ -118,67 +116,54 @@ void ARMRegState::simulate (Instruction* vinstr)
 	}
       // assumed : instr is NOT RESTRICTED to a load/write instruction.
       DAAInstruction *instruct = Arch::getDAAInstruction (instr);
-      instruct->simulate (state, precision, vStack, vStackPrecision, instr);
+      instruct->simulate (state, vStack, instr);
 
-      assert (precision[ARM_SP_REGISTER]);	// sp
+      assert (state[ARM_SP_REGISTER].precise);	// sp
       TRACE(print(ARM_AUX_REGISTER));
     }
 }
 
 
-bool  ARMRegState::getValueSP( string oper, long * val)
+/**
+   @return the address accessed by a load/store instruction based on the register register_number:
+   - the contents of the register for a post-indexed access or without offset,
+   - the contents of the register plus the immediate offset,
+   - the contents of the register plus the contents of the offset register, shifted by shifter_op
+     ([Rn, Rm, lsl n]: the elements of an array when Rm is the index of a loop), "Rn + something"
+     (not precise) when the offset register is unknown.
+*/
+AbstractValue ARMRegState::getAccessAddress(int register_number, AddressingMode vaddrmode, offsetType TypeOperand, string offset, string shifter_op)
 {
-  size_t found = oper.find ("+");
-  if (found == EOS)
-    {
-      found = oper.find ("-");
-      if (found == EOS)
-	{
-	  assert (oper.length () == 2); //only sp
-	  return false;
-	}
-      oper.erase (oper.begin (), oper.begin () + found );
-    }
-  else
-    oper.erase (oper.begin (), oper.begin () + found + 2);
-  bool b = Utl::isDecNumber (oper);
-  if (!b)
+  const AbstractValue & value = state[register_number];
+  if (value.isUnknown() || vaddrmode == post_indexing || TypeOperand == none_offset) return value;
+  if (TypeOperand == immediate_offset) return addOffset (value, atol (offset.c_str ()));
+
+  bool negative = (offset.length() > 0 && offset[0] == '-');
+  if (negative) offset.erase (0, 1);
+  AbstractValue index = state[Arch::getRegisterNumber (offset)];
+  if (TypeOperand == scaled_register_offset && !index.isUnknown())
     {
-      b = Utl::evalexpr(oper, val);
-      if (!b) cout << " LBesnard: ARMRegState::getValueSP :: not evaluated expression = " << oper << endl;
-      return b;
+      istringstream parse (shifter_op);
+      string shift;
+      int amount = -1;
+      parse >> shift >> amount;
+      if (shift == "lsl" && amount >= 0 && amount < 32)
+	index = DAAInstruction::eval (index, 'x', AbstractValue::constant (1L << amount));
+      else
+	index = AbstractValue ();
     }
-  *val = atol(oper.c_str());
-  return true;
+  if (index.isUnknown()) return AbstractValue (value.base, value.offset, false);
+  return DAAInstruction::eval (value, (negative ? '-' : '+'), index);
 }
 
 /**
    This is the third case, where the address is relative to the stack
    pointer sp, in a transitive fashion, as it  appears.
 */
-bool ARMRegState::isAccessAnalysisSP(int register_number, string offset, vector < string > &result)
+bool ARMRegState::isAccessAnalysisSP(const AbstractValue & address, vector < string > &result)
 { 
-  string value, prec;
-  long loffset, val;
-  
-  value = state[register_number];
-  size_t found = value.find ("sp");
-  if (found == EOS) return false;
-  loffset = atol (offset.c_str ());
-  // assert (Utl::isDecNumber (offset));
-  if (getValueSP(value, &val))
-    {
-      loffset = loffset + val;
-      prec = (precision[register_number] ? "1" :"0");
-    }
-  else
-    {
-      assert (!precision[register_number]);	//not precise (array access)
-      prec = "0";
-    };
-  result.push_back ("sp");
-  result.push_back (Utl::int2cstring(loffset));
-  result.push_back (prec);
+  if (address.base != BASE_SP) return false;
+  result = makeAnalysisAddress ("sp", address);
   return true;
 }
 
@@ -206,17 +191,16 @@ vector < string > ARMRegState::makeAnalysisWordInfos(string vtype, unsigned long
     ldr R3, [ sp, #val2]
     ldr R4, [ R2, R3, lsl 3]  R4 = MEM[ address =word[pc + val1] + (2**val2) * R3 ]  (ie access to an element of an array)
 */
-bool ARMRegState::isAccessAnalysisOtherRegister( Instruction * instr, string codeinstr, int register_number, string offset, offsetType TypeOperand, vector < string > &result)
+bool ARMRegState::isAccessAnalysisOtherRegister( Instruction * instr, string codeinstr, int register_number, string offset, offsetType TypeOperand, const AbstractValue & address, vector < string > &result)
 { 
   unsigned long val, addr;
   string vtype;
 
   // examples: ldr (or str) Ri, [ Rj,...]
-  string value = state[register_number];
-  size_t found = value.find ("*");
-  if (found != EOS) return false;
+  if (address.isUnknown()) return false;
   // Rj is known.
-  if (GetWordAt(instr, value, offset, TypeOperand, codeinstr, &vtype, &val, &addr))
+  const AbstractValue & value = state[register_number];
+  if (value.isSingle() && GetWordAt(instr, value.offset, offset, TypeOperand, codeinstr, &vtype, &val, &addr))
     {
       // unsigned long val0 = atol (value.c_str ()); val = val + val0;
       result = makeAnalysisWordInfos(vtype, val, addr);
@@ -224,9 +208,7 @@ bool ARMRegState::isAccessAnalysisOtherRegister( Instruction * instr, string cod
   else
     {
       // keeping the value but not precise...
-      result.push_back ("lui");
-      result.push_back (value.c_str ());
-      result.push_back ( (precision[register_number] ? "1" :"0"));
+      result = makeAnalysisAddress ("lui", address);
     }
   return true;
 }
@@ -240,12 +222,12 @@ bool ARMRegState::GetWordPCrelative (Instruction * instr, offsetType TypeOperand
 }
 
 
-bool ARMRegState::GetWordAt (Instruction * instr, string regvalue, string offset, offsetType TypeOperand, string codeinstr, string *vtype, unsigned long *val, unsigned long *addr)
+bool ARMRegState::GetWordAt (Instruction * instr, long regvalue, string offset, offsetType TypeOperand, string codeinstr, string *vtype, unsigned long *val, unsigned long *addr)
 {
   if ((TypeOperand != immediate_offset) && (TypeOperand != none_offset)) return false;
   if (Arch::isConditionnedARMInstr(codeinstr, "ldr")) return false;
   // if (Arch::isConditionnedARMInstr(codeinstr, "str")) return false;
-  long addrword  = atol (regvalue.c_str ()) + atol (offset.c_str ());
+  long addrword  = regvalue + atol (offset.c_str ());
   return InstructionARM::GetWordAtAddress(addrword, instr, vtype, val, addr);
 }
 
@@ -291,6 +273,7 @@ bool ARMRegState::isAccessAnalysisPC( Instruction * instr, string codeinstr, int
  *	0   "lui"
  *	1	addr
  *	2	precision (=="1" if precise analysis and "0" otherwise)
+ *	3	stride, 4 count (also for sp, only when count addresses addr + k * stride are accessed)
  *	- in case the address is based on gp
  *	0   "gp"
  *	1	offset
@@ -321,11 +304,12 @@ void ARMRegState::accessAnalysis ( Instruction* vinstr, vector < string > &resul
     {
       register_number = Arch::getRegisterNumber (reg);
       if (! isAccessAnalysisPC(vinstr, codeinstr, register_number, offset, TypeOperand, result))
-	if (! isAccessAnalysisSP(register_number, offset, result))
-	  if (! isAccessAnalysisOtherRegister(vinstr, codeinstr, register_number, offset, TypeOperand, result))
-	    {
-	      assert( AccessAnalysisDefault(register_number, result)); // Default is not allowed for all instructions!
-	    }
+	{
+	  AbstractValue address = getAccessAddress (register_number, vaddrmode, TypeOperand, offset, shifter_op);
+	  if (! isAccessAnalysisSP(address, result))
+	    if (! isAccessAnalysisOtherRegister(vinstr, codeinstr, register_number, offset, TypeOperand, address, result))
+	      result = makeAnalysisDefault();
+	}
     }
   else
     {
@@ -2,12 +2,17 @@
 #ifndef ABSTRACTREGMEM_H
 #define ABSTRACTREGMEM_H
 
+/** Abstract contents of the registers and of the stack frame at a point of the program.
+    It owns its RegState: the copies of an AbstractRegMem are independent (the stack frames
+    are shared until they are modified, see AbstractStack), so that the states at the input
+    and output of the nodes, in every context, can be computed separately. */
 class AbstractRegMem
 {
   RegState* regs;
 
  public:
 
+  /** Constructor, rm is owned by the AbstractRegMem. */
   AbstractRegMem (RegState *rm)
     { 
       regs = rm;
@@ -17,6 +22,27 @@ class AbstractRegMem
     {
       regs = NULL; 
     };
+
+  AbstractRegMem (const AbstractRegMem &c)
+    {
+      regs = (c.regs == NULL ? NULL : c.regs->clone());
+    };
+
+  AbstractRegMem & operator= (const AbstractRegMem &c)
+    {
+      if (this != &c)
+	{
+	  RegState *r = (c.regs == NULL ? NULL : c.regs->clone());
+	  delete regs;
+	  regs = r;
+	}
+      return *this;
+    };
+
+  ~AbstractRegMem ()
+    {
+      delete regs;
+    };
  
   RegState* getRegState()
   {
@@ -55,6 +81,18 @@ class AbstractRegMem
     regs->JoinStacks(c.regs);    
   }
 
+  /** Widening at the head of a loop (see RegState::WidenRegisters) */
+  void WidenRegisters (const AbstractRegMem &previous, const AbstractRegMem &back, long maxiter)
+  {
+    regs->WidenRegisters(previous.regs, back.regs, maxiter);
+  }
+
+  /** Widening at the head of a loop (see RegState::WidenStacks) */
+  void WidenStacks (const AbstractRegMem &previous, const AbstractRegMem &back, long maxiter)
+  {
+    regs->WidenStacks(previous.regs, back.regs, maxiter);
+  }
+
   void reset()
   {
     regs->reset_sp();
@@ -79,7 +117,7 @@ class AbstractRegMemAttribute:public NonSerialisableAttribute
       regmem = rm;
     };
   
-  AbstractRegMem getAbstractRegMem()
+  const AbstractRegMem & getAbstractRegMem()
   {
     return regmem;
   }
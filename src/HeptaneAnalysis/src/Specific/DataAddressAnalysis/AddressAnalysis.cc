@@ -217,13 +217,13 @@ void AddressAnalysis::setPointerAccessInfo(Instruction* vinstr, string access)
 }
 
 
-void AddressAnalysis::mkAddressInfoAttribute(Instruction * Instr, string access, bool precision, string section_name, string var_name, long addr,  int size)
+void AddressAnalysis::mkAddressInfoAttribute(Instruction * Instr, string access, bool precision, string section_name, string var_name, long addr,  int size, long stride, long count)
 {
-  AddressInfo info = mkAddressInfo( Instr, access, precision, section_name,  var_name,  addr,   size);
+  AddressInfo info = mkAddressInfo( Instr, access, precision, section_name,  var_name,  addr,   size, stride, count);
   setAddressAttribute(Instr, info);
 }
 
-AddressInfo AddressAnalysis::mkAddressInfo(Instruction * Instr, string access, bool precision, string section_name, string var_name, long addr,  int size)
+AddressInfo AddressAnalysis::mkAddressInfo(Instruction * Instr, string access, bool precision, string section_name, string var_name, long addr,  int size, long stride, long count)
 {
   AddressInfo info;
 
@@ -231,11 +231,22 @@ AddressInfo AddressAnalysis::mkAddressInfo(Instruction * Instr, string access, b
   info.setPrecision(precision);
   info.setSegment (section_name);
   info.setName (var_name);
-  info.addAdrSize ( Utl::int2cstring (addr), Utl::int2cstring (size));
+  info.addRange (addr, size, stride, count);
   LOCTRACE(info.print());
   return info;
 }
 
+void AddressAnalysis::getAccessStride(const vector < string > &access_pattern, long *stride, long *count)
+{
+  *stride = 0;
+  *count = 1;
+  if (access_pattern.size () == 5 && access_pattern[0] != "immWord")
+    {
+      *stride = Utl::string2long (access_pattern[3]);
+      *count = Utl::string2long (access_pattern[4]);
+    }
+}
+
 //-----------Public -----------------------------------------------------------------
 
 AddressAnalysis::AddressAnalysis (Program * prog, int sp):StackAnalysis (prog, sp)
@@ -305,253 +316,273 @@ AbstractRegMem AddressAnalysis::compute_out(ContextualNode & current, string & i
   return v_out;
 }
 
-set < ContextualNode > AddressAnalysis::intraBlockDataAnalysis_out(set < ContextualNode > &work, set < ContextualNode > &visited)
+/** Transfer functions of the fixed point computations of the address analysis:
+    the initialisation step (init, the backedges are ignored) and the address analysis itself. */
+class AddressFixPoint:public WorklistClient
+{
+public:
+  AddressAnalysis & analysis;
+  bool init;
+
+  AddressFixPoint (AddressAnalysis & a, bool i = false):analysis (a), init (i) {}
+
+  bool updateIn (const ContextualNode & cn)
+  {
+    ContextualNode current = cn;
+    return init ? analysis.FixPointStepInit_in (current) : analysis.intraBlockDataAnalysis_in (current);
+  }
+
+  bool updateOut (const ContextualNode & cn)
+  {
+    ContextualNode current = cn;
+    return init ? analysis.FixPointStepInit_out (current) : analysis.intraBlockDataAnalysis_out (current);
+  }
+
+  /** The stack of the return point of a call comes from the call node. */
+  void addDependents (const ContextualNode & cn, vector < ContextualNode > &succ)
+  {
+    if (!cn.node->IsCall ()) return;
+    const vector < Node * >&next = cn.node->GetCfg ()->GetSuccessors (cn.node);
+    for (size_t i = 0; i < next.size (); i++)
+      succ.push_back (ContextualNode (cn.context, next[i]));
+  }
+
+  bool followEdge (const ContextualNode & cn, const ContextualNode & succ)
+  {
+    if (!init) return true;
+    Cfg *vCfg = cn.node->GetCfg ();
+    if (vCfg != succ.node->GetCfg ()) return true;
+    return analysis.backedges.find (vCfg->FindEdge (cn.node, succ.node)) == analysis.backedges.end ();	// If backedge, ignore it
+  }
+};
+
+bool AddressAnalysis::intraBlockDataAnalysis_out(ContextualNode &current)
 {
   string in = AddressInName;
   string out = AddressOutName;
 
-  LOCTRACE( cout << "intraBlockDataAnalysis_out , BEGIN " << endl;);
+  string NumBlock = current.getNode()->getIdentifier();
+  AbstractRegMemAttribute &ca_attr_out = getRegMemContextualNode(current, out + current.context->getStringId());
 
-  set < ContextualNode > work_in;
-  for (set < ContextualNode >::iterator it = work.begin(); it != work.end(); it++)
-    {
-      ContextualNode current = *it;
-      string NumBlock = current.getNode()->getIdentifier();
-      AbstractRegMemAttribute &ca_attr_out = getRegMemContextualNode(current, out + current.context->getStringId());
-
-      LOCTRACE( cout << "intraBlockDataAnalysis_out , Current context = " << getStringContextRepresentation(current.getContext()) << endl;
-		cout << endl << " ++++  intraBlockDataAnalysis_out START BLOCK " << NumBlock << endl;
-		ca_attr_out.getAbstractRegMem().print(););
-
-      AbstractRegMem v_out = compute_out(current, in);
-
-      bool b = ! ca_attr_out.getAbstractRegMem().EqualsRegisters(v_out);
-      if (b) ca_attr_out.setAbstractRegMemRegisters(v_out);
-      bool b1 = ! ca_attr_out.getAbstractRegMem().EqualsStacks(v_out);
-      if (b1) ca_attr_out.setAbstractRegMemStack(v_out);
-      b = b || b1;
-      // To force the visit of all nodes
-      if (visited.find(current) == visited.end())
-	{
-	  visited.insert(current);
-	  b = true;
-	}
-      
-      if (b) AnalysisHelper::insertContextualSuccessors(current, work_in);
+  LOCTRACE( cout << "intraBlockDataAnalysis_out , Current context = " << getStringContextRepresentation(current.getContext()) << endl;
+	    cout << endl << " ++++  intraBlockDataAnalysis_out START BLOCK " << NumBlock << endl;
+	    ca_attr_out.getAbstractRegMem().print(););
 
-      LOCTRACE(  cout << endl << " ++++  intraBlockDataAnalysis_out END BLOCK " << NumBlock << endl;
-		 ca_attr_out.getAbstractRegMem().print(); );
-    }
+  AbstractRegMem v_out = compute_out(current, in);
+  outComputed[nodeIndex.get(current)] = true;
+
+  bool b = ! ca_attr_out.getAbstractRegMem().EqualsRegisters(v_out);
+  if (b) ca_attr_out.setAbstractRegMemRegisters(v_out);
+  bool b1 = ! ca_attr_out.getAbstractRegMem().EqualsStacks(v_out);
+  if (b1) ca_attr_out.setAbstractRegMemStack(v_out);
 
-  LOCTRACE( cout << "intraBlockDataAnalysis_out , END " << endl; );
-  return work_in;
+  LOCTRACE(  cout << endl << " ++++  intraBlockDataAnalysis_out END BLOCK " << NumBlock << endl;
+	     ca_attr_out.getAbstractRegMem().print(); );
+  return b || b1;
 }
 
-set < ContextualNode > AddressAnalysis::intraBlockDataAnalysis_in(set < ContextualNode > &work_in, set < ContextualNode > &visited)
+bool AddressAnalysis::isBackedge(const ContextualNode &pred, const ContextualNode &current)
+{
+  Cfg *vCfg = current.node->GetCfg();
+  Node *source = pred.node;
+  if (!AreElemOfSameCfg(current, pred))
+    {
+      // End of a callee: the edge comes from the call node, the caller of a function entry has no edge.
+      source = NULL;
+      const vector < Node * >&cfgPreds = vCfg->GetPredecessors(current.node);
+      for (size_t i = 0; i < cfgPreds.size() && source == NULL; i++)
+	if (cfgPreds[i]->IsCall() && current.context->getCalleeContext(cfgPreds[i]) == pred.context)
+	  source = cfgPreds[i];
+      if (source == NULL) return false;
+    }
+  return backedges.find(vCfg->FindEdge(source, current.node)) != backedges.end();
+}
+
+bool AddressAnalysis::intraBlockDataAnalysis_in(ContextualNode &current)
 {
   string in = AddressInName;
   string out = AddressOutName;
-  set < ContextualNode > work;
-  ContextualNode current, pred;
-  string idAttr;
+  ContextualNode pred;
 
-  LOCTRACE( cout << "intraBlockDataAnalysis_IN " << endl;);
-  
-  for (set < ContextualNode >::iterator it = work_in.begin(); it != work_in.end(); it++)
-    {
-      current = *it;
-      string NumBlock = current.node->getIdentifier();
-      // int IBB = Utl::string2int(NumBlock);  // for Debugging.
+  string NumBlock = current.node->getIdentifier();
+  // int IBB = Utl::string2int(NumBlock);  // for Debugging.
 
-      AbstractRegMemAttribute &ca_attr_in = getRegMemContextualNode (current, in + current.context->getStringId());
-      AbstractRegMem vAbstractRegMem_in = ca_attr_in.getAbstractRegMem();
+  AbstractRegMemAttribute &ca_attr_in = getRegMemContextualNode (current, in + current.context->getStringId());
+  const AbstractRegMem & vAbstractRegMem_in = ca_attr_in.getAbstractRegMem();
 
-      LOCTRACE( cout << "      ---> Current context = " << getStringContextRepresentation(current.getContext()) << endl;
-		cout << endl << " ++++  intraBlockDataAnalysis_in START BLOCK " << NumBlock << endl;
-		vAbstractRegMem_in.print(););
+  LOCTRACE( cout << "      ---> Current context = " << getStringContextRepresentation(current.getContext()) << endl;
+	    cout << endl << " ++++  intraBlockDataAnalysis_in START BLOCK " << NumBlock << endl;
+	    vAbstractRegMem_in.print(););
 
-      const vector < ContextualNode > &predecessors = GetContextualPredecessors(current);
-      assert(predecessors.size() != 0);	//it should not be the program's entry node
-      bool b1 = false;
-      
-      int vind = getIndexElemSameCfg(predecessors, current);
-      AbstractRegMem new_in = getRegMemContextualNode (predecessors[vind], out + predecessors[vind].context->getStringId()).getAbstractRegMem();
-      
-      for (size_t i = 0; i < predecessors.size(); i++)
-	{
-	  if ( (int)i != vind)
-	    {
-	      pred = predecessors[i];
-	      AbstractRegMem vout = getRegMemContextualNode(pred, out + pred.context->getStringId()).getAbstractRegMem();
-	      new_in.JoinRegisters(vout);
-	      if (AreElemOfSameCfg(current, pred)) // pred is not the caller.
-		{
-		  new_in.JoinStacks(vout);
-		  b1 = true;
-		}
-	    }
-	}
-   
-      bool b = ! vAbstractRegMem_in.EqualsRegisters(new_in);
-      if (b) ca_attr_in.setAbstractRegMemRegisters(new_in); 
-      if (b1) 
-	{
-	  b1 = ! vAbstractRegMem_in.EqualsStacks(new_in);
-	  if (b1) ca_attr_in.setAbstractRegMemStack(new_in);
-	}
+  const vector < ContextualNode > &predecessors = GetContextualPredecessors(current);
+  assert(predecessors.size() != 0);	//it should not be the program's entry node
 
-      // To force the visit of all nodes
-      b = b1 || b || (visited.find(current) == visited.end());
-      if (b) work.insert(current);
-      LOCTRACE( cout << endl << " ++++  intraBlockDataAnalysis_in END BLOCK " << NumBlock << endl;
-		vAbstractRegMem_in.print(););
+  // Registers: from the contextual predecessors (the caller for the entry of a function, the
+  // end of the callee after a call). The states coming from the backedges are widened.
+  AbstractRegMem new_in, back;
+  bool hasIn = false, hasBack = false;
+  for (size_t i = 0; i < predecessors.size(); i++)
+    {
+      pred = predecessors[i];
+      bool isBack = isBackedge(pred, current);
+      if (isBack && !outComputed[nodeIndex.get(pred)]) continue;
+      const AbstractRegMem & vout = getRegMemContextualNode(pred, out + pred.context->getStringId()).getAbstractRegMem();
+      AbstractRegMem & target = isBack ? back : new_in;
+      bool & has = isBack ? hasBack : hasIn;
+      if (has) target.JoinRegisters(vout); else target = vout;
+      has = true;
     }
-  LOCTRACE( cout << "intraBlockDataAnalysis_IN , END " << endl;);
-  return work;
+  if (!hasIn)
+    {
+      if (!hasBack) return false;	// only backedges, not computed yet
+      new_in = back;
+      hasBack = false;
+    }
+
+  // Stacks: from the predecessors in the cfg (the call node after a call), none for the entry of a function.
+  Cfg *vCfg = current.node->GetCfg();
+  const vector < Node * >&cfgPreds = vCfg->GetPredecessors(current.node);
+  AbstractRegMem stack_in, stack_back;
+  bool b1 = false, hasStackBack = false;
+  for (size_t i = 0; i < cfgPreds.size(); i++)
+    {
+      pred = ContextualNode(current.context, cfgPreds[i]);
+      bool isBack = backedges.find(vCfg->FindEdge(cfgPreds[i], current.node)) != backedges.end();
+      if (isBack && !outComputed[nodeIndex.get(pred)]) continue;
+      const AbstractRegMem & vout = getRegMemContextualNode(pred, out + pred.context->getStringId()).getAbstractRegMem();
+      AbstractRegMem & target = isBack ? stack_back : stack_in;
+      bool & has = isBack ? hasStackBack : b1;
+      if (has) target.JoinStacks(vout); else target = vout;
+      has = true;
+    }
+
+  if (hasBack || hasStackBack)
+    {
+      map < Node *, long >::const_iterator it = loopHeads.find(current.node);
+      long maxiter = (it == loopHeads.end() ? 0 : it->second);
+      if (hasBack) new_in.WidenRegisters(vAbstractRegMem_in, back, maxiter);
+      if (hasStackBack && b1) stack_in.WidenStacks(vAbstractRegMem_in, stack_back, maxiter);
+    }
+   
+  bool b = ! vAbstractRegMem_in.EqualsRegisters(new_in);
+  if (b) ca_attr_in.setAbstractRegMemRegisters(new_in); 
+  if (b1) 
+    {
+      b1 = ! vAbstractRegMem_in.EqualsStacks(stack_in);
+      if (b1) ca_attr_in.setAbstractRegMemStack(stack_in);
+    }
+
+  LOCTRACE( cout << endl << " ++++  intraBlockDataAnalysis_in END BLOCK " << NumBlock << endl;
+	    ca_attr_in.getAbstractRegMem().print(););
+  return b || b1;
 }
 
 
 /* 
-   FixPointStepInit_out analysis: Compute the "Stack_out" a set of nodes (work), without considering backedges.
-   @return a set of nodes for which the Stack_in must be computed.
+   FixPointStepInit_out analysis: Compute the "Stack_out" of a node (current), without considering backedges.
+   @return true if it changed.
 */
-set < ContextualNode > AddressAnalysis::FixPointStepInit_out(set < ContextualNode > &work, set < Edge * >&backedges, set < ContextualNode > &visited)
+bool AddressAnalysis::FixPointStepInit_out(ContextualNode &current)
 {
   string in = AddressInName;
   string out = AddressOutName;
 
-  set < ContextualNode > work_in;
-  for (set < ContextualNode >::iterator it = work.begin(); it != work.end(); it++)
-    {
-      ContextualNode current = *it;
-      string NumBlock = current.node->getIdentifier();
-      // int IBB = Utl::string2int(NumBlock); // For debugging
+  string NumBlock = current.node->getIdentifier();
+  // int IBB = Utl::string2int(NumBlock); // For debugging
 
-      LOCTRACE( cout << endl << "========================================================================================" << endl;
-		cout << " FixPointStepInit_out Num Node = " <<  NumBlock << endl;);
+  LOCTRACE( cout << endl << "========================================================================================" << endl;
+	    cout << " FixPointStepInit_out Num Node = " <<  NumBlock << endl;);
 
-      AbstractRegMem v_out = compute_out(current, in);
-      AbstractRegMemAttribute &ca_attr_out = getRegMemContextualNode(current, out + current.context->getStringId());
-      AbstractRegMem vAbstractRegMem_out = ca_attr_out.getAbstractRegMem();
+  AbstractRegMem v_out = compute_out(current, in);
+  AbstractRegMemAttribute &ca_attr_out = getRegMemContextualNode(current, out + current.context->getStringId());
+  AbstractRegMem vAbstractRegMem_out = ca_attr_out.getAbstractRegMem();
 
-     LOCTRACE(  cout << endl << " ++++ FixPointStepInit_out START BLOCK " << NumBlock << endl;
-		vAbstractRegMem_out.print(); );
+  LOCTRACE(  cout << endl << " ++++ FixPointStepInit_out START BLOCK " << NumBlock << endl;
+	     vAbstractRegMem_out.print(); );
 
-      bool b = ! vAbstractRegMem_out.EqualsRegisters(v_out);
-      if (b) ca_attr_out.setAbstractRegMemRegisters(v_out);
-      bool b1 = ! vAbstractRegMem_out.EqualsStacks(v_out);
-      if (b1)  ca_attr_out.setAbstractRegMemStack(v_out);
-      if (visited.find(current) == visited.end())
-	{
-	  visited.insert(current);
-	  b = true;
-	} 
-      if (b1 || b) AnalysisHelper::insertContextualSuccessorsExcludingBackEdges(current, work_in, backedges);
+  bool b = ! vAbstractRegMem_out.EqualsRegisters(v_out);
+  if (b) ca_attr_out.setAbstractRegMemRegisters(v_out);
+  bool b1 = ! vAbstractRegMem_out.EqualsStacks(v_out);
+  if (b1)  ca_attr_out.setAbstractRegMemStack(v_out);
       
-      LOCTRACE( cout << endl << " ++++  FixPointStepInit_out END BLOCK " << NumBlock << endl;
-		vAbstractRegMem_out.print(););
-    }
-  return work_in;
+  LOCTRACE( cout << endl << " ++++  FixPointStepInit_out END BLOCK " << NumBlock << endl;
+	    vAbstractRegMem_out.print(););
+  return b || b1;
 }
 
-/* FixPointStepInit_out analysis: Compute the "Stack_in" a set of nodes (work), without considering backedges.
-   @return a set of nodes for which the Stack_out must be computed. */
-set < ContextualNode > AddressAnalysis::FixPointStepInit_in(set < ContextualNode > &work_in, set < Edge * >&backedges, set < ContextualNode > &visited)
+/* FixPointStepInit_in analysis: Compute the "Stack_in" of a node (current), without considering backedges.
+   @return true if the Stack_out of current must be computed. */
+bool AddressAnalysis::FixPointStepInit_in(ContextualNode &current)
 {
   string in = AddressInName;
   string out = AddressOutName;
-  set < ContextualNode > work;
-  ContextualNode current, pred;
-  string idAttr;
-  bool b, first;
-  AbstractRegMem vout, new_in;
-
-  for (set < ContextualNode >::iterator it = work_in.begin(); it != work_in.end(); it++)
-    {
-      current = *it;
-      string NumBlock = current.node->getIdentifier();
-      // int IBB = Utl::string2int(NumBlock);
-      AbstractRegMemAttribute &ca_attr_in = getRegMemContextualNode (current, in + current.context->getStringId());      
-      AbstractRegMem vAbstractRegMem_in = ca_attr_in.getAbstractRegMem();
-
-      LOCTRACE( cout << endl << "========================================================================================" << endl;
-		cout <<  endl << " ++++ FixPointStepInit_in START BLOCK " << NumBlock << endl;
-		vAbstractRegMem_in.print(););
+  ContextualNode pred;
+  bool first;
+  AbstractRegMem new_in;
+
+  string NumBlock = current.node->getIdentifier();
+  // int IBB = Utl::string2int(NumBlock);
+  AbstractRegMemAttribute &ca_attr_in = getRegMemContextualNode (current, in + current.context->getStringId());      
+  AbstractRegMem vAbstractRegMem_in = ca_attr_in.getAbstractRegMem();
+
+  LOCTRACE( cout << endl << "========================================================================================" << endl;
+	    cout <<  endl << " ++++ FixPointStepInit_in START BLOCK " << NumBlock << endl;
+	    vAbstractRegMem_in.print(););
       
-      const vector < ContextualNode > &predecessors = GetContextualPredecessors(current);
-      assert(predecessors.size() != 0);	// not the program's entry node
-      first = true;  
-      for (size_t i = 0; i < predecessors.size(); i++)
+  const vector < ContextualNode > &predecessors = GetContextualPredecessors(current);
+  assert(predecessors.size() != 0);	// not the program's entry node
+
+  // The predecessors in the cfg (the call node after a call).
+  Cfg *vCfg = current.node->GetCfg();
+  const vector < Node * >&cfgPreds = vCfg->GetPredecessors(current.node);
+  first = true;  
+  for (size_t i = 0; i < cfgPreds.size(); i++)
+    {
+      if (backedges.find(vCfg->FindEdge(cfgPreds[i], current.node)) == backedges.end())
 	{
-	  pred = predecessors[i];
-	  if (AreElemOfSameCfg(current, pred))
+	  pred = ContextualNode(current.context, cfgPreds[i]);
+	  const AbstractRegMem & vout = getRegMemContextualNode(pred, out + pred.context->getStringId()).getAbstractRegMem();
+	  if (first)
 	    {
-	      b =  AnalysisHelper::FilterBackedge(current.node, pred.node, backedges);
-	      if (b)
-		{
-		  idAttr = out + pred.context->getStringId();
-		  vout = getRegMemContextualNode(pred, idAttr).getAbstractRegMem();
-		  if (first)
-		    {
-		      new_in = vout;
-		      first = false;  
-		    }
-		  else
-		    new_in.JoinStacks(vout);
-		}
+	      new_in = vout;
+	      first = false;  
 	    }
+	  else
+	    new_in.JoinStacks(vout);
 	}
+    }
 
-      bool bb = true;     
-      if (first)
-	{
-	  pred = predecessors[0];
-	  new_in = getRegMemContextualNode (pred, out + pred.context->getStringId()).getAbstractRegMem();
-	  Node * callernode = getContextualNodeCallerNode (current);
-	  // Registers used for argmuments of a function call must be copied.
-	  if (pred.node == callernode)
-	    importCallerArguments(new_in, vAbstractRegMem_in);
-	  // Otherwise it is a return of a function call (callernode =NULL).
-	  work.insert(current);
-	  bb = false;
-	}
+  if (first)
+    {
+      pred = predecessors[0];
+      new_in = getRegMemContextualNode (pred, out + pred.context->getStringId()).getAbstractRegMem();
+      Node * callernode = getContextualNodeCallerNode (current);
+      // Registers used for argmuments of a function call must be copied.
+      if (pred.node == callernode && importCallerArguments(new_in, vAbstractRegMem_in))
+	ca_attr_in.setAbstractRegMemRegisters(vAbstractRegMem_in);
+      LOCTRACE( cout << endl << " ++++  FixPointStepInit_in END BLOCK " << NumBlock << endl;
+		vAbstractRegMem_in.print(););
+      return true;
+    }
 
-      if (bb)
-	{
-	  bool b = ! vAbstractRegMem_in.EqualsRegisters(new_in);
-	  if (b) ca_attr_in.setAbstractRegMemRegisters(new_in); 
-	  bool b1 = ! vAbstractRegMem_in.EqualsStacks(new_in);
-	  if (b1) ca_attr_in.setAbstractRegMemStack(new_in);
-	  b = b1 || b || (visited.find(current) == visited.end());
-	  if (b) work.insert(current);
-	}
+  bool b = ! vAbstractRegMem_in.EqualsRegisters(new_in);
+  if (b) ca_attr_in.setAbstractRegMemRegisters(new_in); 
+  bool b1 = ! vAbstractRegMem_in.EqualsStacks(new_in);
+  if (b1) ca_attr_in.setAbstractRegMemStack(new_in);
 
-    LOCTRACE( cout << endl << " ++++  FixPointStepInit_in END BLOCK " << NumBlock << endl;
-	      vAbstractRegMem_in.print(););
-    }
-  return work;
+  LOCTRACE( cout << endl << " ++++  FixPointStepInit_in END BLOCK " << NumBlock << endl;
+	    new_in.print(););
+  return b || b1;
 }
 
 
 
-/* blabla blabla blabla 
+/* First step of the address analysis: fixed point computation of the stacks without considering backedges.
 */
-bool AddressAnalysis::FixPointInit()
+bool AddressAnalysis::FixPointInit(Worklist & work)
 {
-  set < ContextualNode > visited, work_in, work;
-  set < Edge * >backedges = AnalysisHelper::compute_backedges(p, call_graph);
-  work = AnalysisHelper::initWork();
- // AnalysisHelper::printSet(work,"FixpointInitWork");
-  while (!work.empty())
-    {
-      work_in = FixPointStepInit_out(work, backedges, visited);
-      //AnalysisHelper::printSet(work_in,"FixpointWork_in");
-      work.clear();
-      work = FixPointStepInit_in(work_in, backedges, visited);
-      //AnalysisHelper::printSet(work,"FixpointWork*");
-      work_in.clear();
-    }
-
+  AddressFixPoint fixpoint(*this, true);
+  work.solve(fixpoint, AnalysisHelper::initWork(p), true);
   return true;
 }
 
@@ -561,27 +592,44 @@ bool AddressAnalysis::FixPointInit()
 */
 bool AddressAnalysis::intraBlockDataAnalysis()
 {
-  set < ContextualNode > visited, work_in, work;
-
   this->call_graph = new CallGraph(p);
 
   // Initialising.
   symbol_table = (SymbolTableAttribute &) p->GetAttribute (SymbolTableAttributeName);
   AnalysisHelper::applyToAllNodesRecursive(p, initAddressAnalysis, (void *)this);
 
-  FixPointInit();
-  // fix point
-  work = AnalysisHelper::initWork();
-  //AnalysisHelper::printSet(work,"AddressInitalWork");
-  while (!work.empty())
+  const ContextTree & contextTree = (ContextTree &) p->GetAttribute(ContextTreeAttributeName);
+  ContextualNodeOrder nodeOrder;
+  nodeIndex.build(contextTree);
+  outComputed.assign(nodeIndex.size(), false);
+  nodeOrder.build(contextTree, nodeIndex, *AnalysisHelper::initWork(p).begin());
+
+  // Loops: the states of the loop heads are widened with the maxiter of the loop.
+  backedges = AnalysisHelper::compute_backedges(p, call_graph);
+  const vector < Cfg * >&cfgs = p->GetAllCfgs();
+  for (size_t c = 0; c < cfgs.size(); c++)
     {
-      work_in = intraBlockDataAnalysis_out(work, visited);
-      //AnalysisHelper::printSet(work_in,"AddressWork_in");
-      work.clear();
-      work = intraBlockDataAnalysis_in(work_in, visited);
-      //AnalysisHelper::printSet(work,"AddressWork***");
-      work_in.clear();
+      vector < Loop * >loops = cfgs[c]->GetAllLoops();
+      for (size_t l = 0; l < loops.size(); l++)
+	{
+	  long maxiter = 0;
+	  if (loops[l]->HasAttribute(MaxiterAttributeName))
+	    maxiter = ((SerialisableIntegerAttribute &) loops[l]->GetAttribute(MaxiterAttributeName)).GetValue();
+	  loopHeads[loops[l]->GetHead()] = maxiter;
+	}
     }
+
+  Worklist initWork(nodeOrder);
+  FixPointInit(initWork);
+  // fix point
+  Worklist work(nodeOrder);
+  AddressFixPoint fixpoint(*this);
+  work.solve(fixpoint, AnalysisHelper::initWork(p), true);
+
+  ostringstream os;
+  os << "AddressAnalysis: " << initWork.getNbOutEvaluations() + work.getNbOutEvaluations() << " node evaluations, "
+     << initWork.getNbInEvaluations() + work.getNbInEvaluations() << " joins";
+  Logger::addInfo(os.str());
   return true;
 }
 
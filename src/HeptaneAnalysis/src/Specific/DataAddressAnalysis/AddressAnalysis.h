@@ -54,6 +54,7 @@ This analysis is very basic in the sense:
 #include "AbstractRegMem.h"
 #include "Generic/CallGraph.h"
 #include "Generic/ContextHelper.h"
+#include "Generic/Worklist.h"
 using namespace std;
 
 /*************************************************************************************************************************
@@ -69,9 +70,15 @@ using namespace std;
 
 class AddressAnalysis: public StackAnalysis
 {
+  friend class AddressFixPoint;
+
  private:
   Program *p;
   CallGraph *call_graph;
+  set < Edge * >backedges;	///< backedges of all the cfgs (set in intraBlockDataAnalysis())
+  map < Node *, long >loopHeads;	///< maxiter of the loops, by loop head (0 when unknown)
+  ContextualNodeIndex nodeIndex;
+  vector < bool >outComputed;	///< by nodeIndex, true once the out state of the node is computed by the address analysis itself
 
  private:
   bool CheckExternalCfg(Program *p); ///< return true if the program reference an external CFG, false otherwise.
@@ -84,29 +91,37 @@ class AddressAnalysis: public StackAnalysis
   void setContextualAddressAttribute(Instruction* Instr, Context *context, AddressInfo &contextual_info);
   void setPointerAccessInfo(Instruction* vinstr, string access);
   void intraBlockDataAnalysis (Cfg * vCfg, Node * aNode, RegState *state);
-  void mkAddressInfoAttribute(Instruction *  Instr, string access, bool precision, string section_name, string var_name, long addr, int size);
-  AddressInfo mkAddressInfo(Instruction * Instr, string access, bool precision, string section_name, string var_name, long addr, int size);
+  /** Address information of the accesses to [addr + k * stride, addr + k * stride + size[, 0 <= k < count. */
+  void mkAddressInfoAttribute(Instruction *  Instr, string access, bool precision, string section_name, string var_name, long addr, int size, long stride = 0, long count = 1);
+  AddressInfo mkAddressInfo(Instruction * Instr, string access, bool precision, string section_name, string var_name, long addr, int size, long stride = 0, long count = 1);
+  /** Reads the <stride, count> of an access pattern returned by RegState::accessAnalysis, <0, 1> for a single address. */
+  static void getAccessStride(const vector < string > &access_pattern, long *stride, long *count);
 
   /** @return the AbstractRegMem of a ContextualNode (current). The initial value is the given by the of the current 
       analysis provided by inAnalysisName for the context.*/
   AbstractRegMem compute_out(ContextualNode & current, string & inAnalysisName);  
 
-  /** Address Analysis: Compute the "AddressAttribute"_in of a set of nodes (work_in). 
-      @return a set of nodes for which the "AddressAttribute"_out must be computed (all the nodes have to be visited at least once). */
-  set < ContextualNode > intraBlockDataAnalysis_out(set < ContextualNode > &work, set < ContextualNode > &visited);
+  /** Address Analysis: Compute the "AddressAttribute"_out of a node (current).
+      @return true if it changed. */
+  bool intraBlockDataAnalysis_out(ContextualNode &current);
   
-  /** Address Analysis: Compute the "AddressAttribute"_in of a set of nodes (work_in). 
-      @return a set of nodes for which the "AddressAttribute"_out must be computed (all the nodes have to be visited at least once). */
-  set < ContextualNode > intraBlockDataAnalysis_in(set < ContextualNode > &work_in, set < ContextualNode > &visited);
+  /** Address Analysis: Compute the "AddressAttribute"_in of a node (current) from its predecessors.
+      @return true if it changed (the "AddressAttribute"_out of current must be computed). */
+  bool intraBlockDataAnalysis_in(ContextualNode &current);
+
+  /** @return true if the edge from pred to current is a backedge (the states of such predecessors
+      are widened with the bound of the loop instead of being joined, once they are computed by
+      the address analysis: the ones of the initialisation step are ignored). */
+  bool isBackedge(const ContextualNode &pred, const ContextualNode &current);
   
-  /** Address Analysis implemented as a data flow analysis. Set the address attribute for all nodes of the entry point.
+  /** Address Analysis implemented as a data flow analysis (see Worklist). Set the address attribute for all nodes of the entry point.
       All nodes have to be visited at least once.
   */
   bool intraBlockDataAnalysis (); 
   
-  set < ContextualNode > FixPointStepInit_out(set < ContextualNode > &work, set < Edge * >&backedges, set < ContextualNode > &visited);
-  set < ContextualNode > FixPointStepInit_in(set < ContextualNode > &work_in, set < Edge * >&backedges, set < ContextualNode > &visited);
-  bool FixPointInit();
+  bool FixPointStepInit_out(ContextualNode &current);
+  bool FixPointStepInit_in(ContextualNode &current);
+  bool FixPointInit(Worklist & work);
   virtual bool importCallerArguments(AbstractRegMem &vAbstractRegMemCaller, AbstractRegMem &vAbstractRegMemCalled)=0;
 
  public:
@@ -84,7 +84,7 @@ int MIPSAddressAnalysis::getStackMaxOffset(string s_instr, int StackMaxOffset)
 //Intra block data analysis related functions
 
 // Set the AddressAttribute for a sp access
-void MIPSAddressAnalysis::analyzeStack (Cfg * cfg, Instruction * Instr, long offset, string access, int sizeOfMemoryAccess, bool precision, Context *context)
+void MIPSAddressAnalysis::analyzeStack (Cfg * cfg, Instruction * Instr, long offset, long stride, long count, string access, int sizeOfMemoryAccess, bool precision, Context *context)
 {
 
   //get the StackInfoAttributeName of current cfg
@@ -142,6 +142,9 @@ void MIPSAddressAnalysis::analyzeStack (Cfg * cfg, Instruction * Instr, long off
 	}
       //--
       
+      // strided accesses which go out of the frame: the whole frame may be accessed
+      if (precision && count > 1 && offset + (count - 1) * stride > stack_maxoffset)
+	precision = false;
       if (precision)
 	{
 	  addr = sp + offset;
@@ -150,10 +153,12 @@ void MIPSAddressAnalysis::analyzeStack (Cfg * cfg, Instruction * Instr, long off
       else
 	{
 	  addr = sp;
+	  stride = 0;
+	  count = 1;
 	  // TODO: check the MIPS ABI if the parameters of the caller can be accessed if not stack_size_caller can be used instead
 	  if (stack_size == 0) size = stack_maxoffset_caller; else size = stack_maxoffset;
 	}
-      AddressInfo contextual_info = mkAddressInfo(Instr, access, precision, "stack","", addr, size);
+      AddressInfo contextual_info = mkAddressInfo(Instr, access, precision, "stack","", addr, size, stride, count);
       setContextualAddressAttribute(Instr, context, contextual_info);
     }
 }
@@ -161,14 +166,22 @@ void MIPSAddressAnalysis::analyzeStack (Cfg * cfg, Instruction * Instr, long off
 
 // set the AddressAttribute for a gp or lui access; 
 // local to setLoadStoreAddressAttribute
-void MIPSAddressAnalysis::analyzeReg (Instruction * Instr, long addr, string access, int sizeOfMemoryAccess, bool precision)
+void MIPSAddressAnalysis::analyzeReg (Instruction * Instr, long addr, long stride, long count, string access, int sizeOfMemoryAccess, bool precision)
 {
   string var_name;
   unsigned long start_addr = 0;
   int size = 0;
   string section_name;
 
-  symbol_table.getInfo (addr, &var_name, &start_addr, &size, &section_name);
+  // strided accesses beginning out of the variables (e.g. an index bounded by a test ignored by the analysis):
+  // the variable of the first element found may be accessed as a whole
+  bool found = symbol_table.findInfo (addr, &var_name, &start_addr, &size, &section_name);
+  for (long k = 1; !found && k < count; k++)
+    {
+      found = symbol_table.findInfo (addr + k * stride, &var_name, &start_addr, &size, &section_name);
+      precision = false;
+    }
+  if (!found) symbol_table.getInfo (addr, &var_name, &start_addr, &size, &section_name); // reports the error
 
   if (start_addr == 0 || size == 0)
     {
@@ -176,7 +189,13 @@ void MIPSAddressAnalysis::analyzeReg (Instruction * Instr, long addr, string acc
     }
   else
     {
-      mkAddressInfoAttribute(Instr, access, precision, section_name, var_name,  ( precision ? addr: start_addr) , ( precision ? sizeOfMemoryAccess : size ) );
+      // strided accesses which go out of the variable: the whole variable may be accessed
+      if (precision && count > 1 && addr + (count - 1) * stride + sizeOfMemoryAccess > (long) start_addr + size)
+	precision = false;
+      if (precision)
+	mkAddressInfoAttribute(Instr, access, true, section_name, var_name, addr, sizeOfMemoryAccess, stride, count);
+      else
+	mkAddressInfoAttribute(Instr, access, false, section_name, var_name, start_addr, size);
     }
 }
 
@@ -202,9 +221,10 @@ bool MIPSAddressAnalysis::setLoadStoreAddressAttribute(Cfg * vCfg, Instruction*
 {
   string access, asm_code;
 
-  asm_code = vinstr->GetCode ();
-  bool isLoad = Arch::isLoad (asm_code);
-  bool isStore = Arch::isStore (asm_code);
+  const DecodedInstruction & decoded = AnalysisHelper::getDecoded (vinstr);
+  asm_code = decoded.code;
+  bool isLoad = decoded.load;
+  bool isStore = decoded.store;
   if (!isLoad && !isStore) return false;
 
   // lui is not a load. --See MIPS.cc : mnemonicToInstructionTypes["lui"]    =new Basic("alu",formats["rd_hex"],new Lui())--; 
@@ -212,7 +232,7 @@ bool MIPSAddressAnalysis::setLoadStoreAddressAttribute(Cfg * vCfg, Instruction*
   // Store MIPS = { ["sw"], ["swc1"], ["sh"], ["sb"], ["sdc1"] }
 
   // get the size of the access according to the op code
-  int sizeOfMemoryAccess = Arch::getSizeOfMemoryAccess (asm_code);
+  int sizeOfMemoryAccess = decoded.accessSize;
 
   //define the access type
   if (isLoad) { access = "read"; } else { access = "write"; }
@@ -224,14 +244,14 @@ bool MIPSAddressAnalysis::setLoadStoreAddressAttribute(Cfg * vCfg, Instruction*
       long loffset = GetOffsetValue(asm_code); //mnemonic op1,offset(gp)
       long addr = symbol_table.getGP ();
       addr = addr + loffset;
-      analyzeReg (vinstr, addr, access, sizeOfMemoryAccess, true);
+      analyzeReg (vinstr, addr, 0, 1, access, sizeOfMemoryAccess, true);
       TRACE( cout << " analyzeReg (gp) " << endl);
     }
   //access using $sp register
   else if (asm_code.find ("sp") != EOS)
     {
       long loffset = GetOffsetValue(asm_code); // mnemonic op1,offset(sp)
-      analyzeStack (vCfg, vinstr, loffset, access, sizeOfMemoryAccess, true, context);
+      analyzeStack (vCfg, vinstr, loffset, 0, 1, access, sizeOfMemoryAccess, true, context);
       TRACE( cout << " analyzeStack (sp) " << endl);
     }
   else
@@ -243,22 +263,24 @@ bool MIPSAddressAnalysis::setLoadStoreAddressAttribute(Cfg * vCfg, Instruction*
       TRACE( cout << " === state->accessAnalysis returns, code = " << access_pattern[0] << endl);
       TRACE( cout << " === state->accessAnalysis returns, value = " << access_pattern[1] << endl);
       TRACE( cout << " === state->accessAnalysis returns, precision = " << access_pattern[2] << endl);
+      long stride, count;
+      getAccessStride(access_pattern, &stride, &count);
 
       if (access_pattern[0] == "lui")
 	{
 	  long addr = Utl::string2long(access_pattern[1]);
-	  analyzeReg (vinstr, addr, access, sizeOfMemoryAccess, access_pattern[2] == "1");
+	  analyzeReg (vinstr, addr, stride, count, access, sizeOfMemoryAccess, access_pattern[2] == "1");
 	}
       else if (access_pattern[0] == "gp")
 	{
 	  long addr = symbol_table.getGP () + Utl::string2long(access_pattern[1]);
-	  analyzeReg (vinstr, addr , access, sizeOfMemoryAccess, access_pattern[2] == "1");
+	  analyzeReg (vinstr, addr, stride, count, access, sizeOfMemoryAccess, access_pattern[2] == "1");
 	}
       else if (access_pattern[0] == "sp")
 	{
 	  long loffset = Utl::string2long(access_pattern[1]);
 	  TRACE(cout << " Stack pointer ----*****------" << asm_code << endl;);
-	  analyzeStack (vCfg, vinstr, loffset, access, sizeOfMemoryAccess, access_pattern[2] == "1", context);
+	  analyzeStack (vCfg, vinstr, loffset, stride, count, access, sizeOfMemoryAccess, access_pattern[2] == "1", context);
 	}
       else //pointer: all addresses can be accessed (stub)
 	{
@@ -60,8 +60,8 @@ class MIPSAddressAnalysis:public AddressAnalysis
  private:
   long GetOffsetValue(string asm_code);
 
-  void analyzeStack (Cfg * cfg, Instruction * Instr, long offset, string access, int sizeOfMemoryAccess, bool precision, Context *context);
-  void analyzeReg (Instruction * Instr, long addr, string access, int sizeOfMemoryAccess, bool precision);
+  void analyzeStack (Cfg * cfg, Instruction * Instr, long offset, long stride, long count, string access, int sizeOfMemoryAccess, bool precision, Context *context);
+  void analyzeReg (Instruction * Instr, long addr, long stride, long count, string access, int sizeOfMemoryAccess, bool precision);
   void updateStack(Instruction *Instr, string access, bool precision, long addr, long size, RegState* state);
 
  protected:
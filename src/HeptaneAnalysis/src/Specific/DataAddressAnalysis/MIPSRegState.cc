@@ -58,18 +58,15 @@ void MIPSRegState::setPredefValues()
   reset_sp();
   // gp is  known precisely
   // symbolic value, to be evaluated later
-  state[28] = "gp";
-  precision[28] = true;
+  state[28] = AbstractValue(BASE_GP, 0, true);
 
-  state[0] = "0";
-  precision[0] = true;
+  state[0] = AbstractValue::constant(0);
 }
 
 void MIPSRegState::reset_sp()
 {
   // sp is known precisely
-  state[29] = "sp";
-  precision[29] = true;
+  state[29] = AbstractValue(BASE_SP, 0, true);
 }
 
 int MIPSRegState::getAuxRegister()
@@ -86,83 +83,32 @@ MIPSRegState::simulate (Instruction * vinstr)
   // cout << " simulate = " << instr << endl << " the stack before = " << endl;  printStack();
 
   DAAInstruction *instruct = Arch::getDAAInstruction (instr);
-  instruct->simulate (state, precision, vStack, vStackPrecision, instr);
+  instruct->simulate (state, vStack, instr);
 
-  assert (precision[0]);  // zero
-  assert (precision[28]); // gp
-  assert (precision[29]); // sp
+  assert (state[0].precise);  // zero
+  assert (state[28].precise); // gp
+  assert (state[29].precise); // sp
   LOCTRACE(print(MIPS_AUX_REGISTER));
 }
 
 /** 
-    @return true if value is a "lui" instruction, false otherwise.
-    pattern: 68lui [+ decimal_value]
-    value = state[register_number]
+    @return true if the register contains an address built by a "lui" instruction, false otherwise.
+    pattern: val lui [+ decimal_value]
 */
 bool MIPSRegState::isAccessAnalysisLui (int register_number, string offset, vector < string > &result)
 {
   // Warning: the state of a register is modified by the state->simulate() method.
 
-  // examples : MIPS (I): lui v0, 0x40 ==> state[0] = "lui64" in simulate() method. 0x40(hexa) = 64 (dec)
-  // if (state[0] == f("lui")) may be true (if not modified from (I))
-
-  unsigned long addr;
-  string value = state[register_number];
-  size_t found = value.find ("lui");
-  if (found == EOS) return false;
-
-  // -------------------------------------
-  // Computing v * (2**16) + v' + offset, with  state[register_number] = vlui + v'
-
-  // Getting the base address from the lui.
-  // addr can be in two distinct part: Addrh bits and Addrl bits
-  string Addrh = value;
-  Addrh.erase (found); // remove 'lui'
-
-  // check that Addrh is a number
-  // DH: FIXME: faire plus clean et voir pourquoi ici c'est en hexa
-  if (! Utl::isDecNumber(Addrh))
-    {
-      addr = strtoul (value.c_str (), NULL, 16);
-      assert (addr != 0 && addr != ULONG_MAX);
-    }
-  else
-    {
-      addr = atol (Addrh.c_str ());
-    }
-  addr = addr * 65536; // the immediate value is shifted left 16 bits (see LUI instruction)
-
-  found = value.find ("+");
-  if (found != EOS)
-    {
-      string Addrl = value;
-      Addrl.erase (Addrl.begin (), Addrl.begin () + found + 2);	//remove '... + '
-      //check that Addrl is a number
-      bool bb = Utl::isDecNumber (Addrl);
-      assert (bb);	
-      addr = addr + atol (Addrl.c_str ());
-    }
-  else //check that 'lui' is not followed by something else in the register value
-    {
-      if (value.find ("lui") + 3 != value.length ())
-	{
-	  Logger::addError ("accessAnalysis -> LUI access");
-	  assert (value.find ("lui") + 3 == value.length ());
-	}
-    }
+  // examples : MIPS (I): lui v0, 0x40 ==> state[2] = 0x400000 lui in simulate() method.
+  const AbstractValue & value = state[register_number];
+  if (value.base != BASE_LUI) return false;
 
   // Add the offset to the base address
-  long loffset = atol (offset.c_str ());
   assert (Utl::isDecNumber (offset));
-  addr = addr + loffset;
-  ostringstream ossAddr;
-  ossAddr << addr;
-  // ------------------------------- 
-
-  result.push_back ("lui");
-  result.push_back (ossAddr.str ());
-  result.push_back ( (precision[register_number] ? "1" :"0")); 
-  LOCTRACE( cout << " DEBUG_LB, MIPSRegState::isAccessAnalysisLui. Registre = " << register_number <<", ossADDR = " << ossAddr.str () << endl);
+  AbstractValue address = addOffset (value, atol (offset.c_str ()));
+
+  result = makeAnalysisAddress ("lui", address);
+  LOCTRACE( cout << " DEBUG_LB, MIPSRegState::isAccessAnalysisLui. Registre = " << register_number <<", ossADDR = " << address.toString () << endl);
   return true;
 }
 
@@ -176,34 +122,14 @@ bool MIPSRegState::isAccessAnalysisLui (int register_number, string offset, vect
 bool MIPSRegState::isAccessAnalysisGP (int register_number, string offset, vector < string > &result)
 {
   // Warning: the state of a register is modified by the state->simulate() method.
-  ostringstream ossOffset;
-
-  string value = state[register_number];
-  size_t found = value.find ("gp"); // Not only for register_number=28, but mov ... copies the value.
-  if (found == EOS) return false;
+  const AbstractValue & value = state[register_number]; // Not only for register_number=28, but mov ... copies the value.
+  if (value.base != BASE_GP) return false;
   
-  long loffset = atol (offset.c_str ());
   assert (Utl::isDecNumber (offset));
-  string oper = value;
-  found = oper.find ("-");
-  if (found == EOS)
-    {
-      Logger::addError ("reg analysis -> '-' not found for gp + -value");
-    }
-  else
-    {
-      oper.erase (oper.begin (), oper.begin () + found + 1);
-      assert (Utl::isDecNumber (oper));	//check it is a number
-      assert (oper[0] != '-');	//check it is a positive number
-      assert (Utl::isDecNumber (oper));
-      loffset = loffset - atol (oper.c_str ());
-      ossOffset << loffset;
-
-      result.push_back ("gp");
-      result.push_back (ossOffset.str ());
-      result.push_back ( (precision[register_number] ? "1" :"0"));
-    }
-  LOCTRACE(cout << " DEBUG_LB, MIPSRegState::isAccessAnalysisGP. Registre = " << register_number <<", ossADDR = " << ossOffset.str () << endl);
+  AbstractValue address = addOffset (value, atol (offset.c_str ()));
+
+  result = makeAnalysisAddress ("gp", address);
+  LOCTRACE(cout << " DEBUG_LB, MIPSRegState::isAccessAnalysisGP. Registre = " << register_number <<", ossADDR = " << address.toString () << endl);
   return true;
 }
 
@@ -214,45 +140,21 @@ bool MIPSRegState::isAccessAnalysisGP (int register_number, string offset, vecto
 bool MIPSRegState::isAccessAnalysisSP(int register_number,string offset, vector < string > &result)
 { 
   // Warning: the state of a register is modified by the state->simulate() method.
-
-  ostringstream ossOffset;
-  string prec;
-
-  string value = state[register_number];
-  size_t found = value.find ("sp");
-  if (found == EOS) return false;
-
-  long loffset = atol (offset.c_str ());
+  const AbstractValue & value = state[register_number];
+  if (value.base != BASE_SP) return false;
+
+  //that case can be found in case of an array in the stack (then the register is not precise)
+  //benchmark: ud
+  //4006b0:   8fa20004        lw      v0,4(sp)
+  //4006b4:   00000000        nop
+  //4006b8:   00021080        sll     v0,v0,0x2
+  //4006bc:   03a21021        addu    v0,sp,v0
+  //4006c0:   8c420010        lw      v0,16(v0)
   assert (Utl::isDecNumber (offset));
+  AbstractValue address = addOffset (value, atol (offset.c_str ()));
 
-  string oper = value;
-  found = oper.find ("+");
-  if (found == EOS)
-    {
-      //that case can be found in case of an array in the stack
-      //benchmark: ud
-      //4006b0:   8fa20004        lw      v0,4(sp)
-      //4006b4:   00000000        nop
-      //4006b8:   00021080        sll     v0,v0,0x2
-      //4006bc:   03a21021        addu    v0,sp,v0
-      //4006c0:   8c420010        lw      v0,16(v0)
-
-      assert (oper.length () == 2);	//only sp
-      assert (!precision[register_number]);	//not precise (array access)
-      prec = "0";
-    }
-  else
-    {
-      oper.erase (oper.begin (), oper.begin () + found + 2);
-      assert (Utl::isDecNumber (oper));	//check it is a number
-      loffset = loffset + atol (oper.c_str ());
-      prec = (precision[register_number] ? "1" :"0");
-    }
-  ossOffset << loffset;
-  result.push_back ("sp");
-  result.push_back (ossOffset.str ());
-  result.push_back (prec);
-  LOCTRACE( cout << " DEBUG_LB, MIPSRegState::isAccessAnalysisSP. Registre = " << register_number <<", ossADDR = " << ossOffset.str () << endl);
+  result = makeAnalysisAddress ("sp", address);
+  LOCTRACE( cout << " DEBUG_LB, MIPSRegState::isAccessAnalysisSP. Registre = " << register_number <<", ossADDR = " << address.toString () << endl);
  return true;
 }
 
@@ -265,6 +167,7 @@ bool MIPSRegState::isAccessAnalysisSP(int register_number,string offset, vector
  *	0   "lui"
  *	1	addr
  *	2	precision (=="1" if precise analysis and "0" otherwise)
+ *	3	stride, 4 count (also for gp and sp, only when count addresses addr + k * stride are accessed)
  *	- in case the address is based on gp
  *	0   "gp"
  *	1	offset
@@ -20,8 +20,7 @@ using namespace std;
 RegState::RegState (int nbRegisters)
 {
   // All contents are assumed unknown
-  state.resize (nbRegisters, "*");
-  precision.resize (nbRegisters, false);
+  state.resize (nbRegisters);
 }
 
 vector < string > RegState::makeAnalysisDefault()
@@ -35,13 +34,32 @@ vector < string > RegState::makeAnalysisDefault()
   return result;
 }
 
+vector < string > RegState::makeAnalysisAddress(string kind, const AbstractValue & address)
+{
+  vector < string > result;
+  result.push_back (kind);
+  result.push_back (Utl::int2cstring (address.offset));
+  result.push_back ((address.precise ? "1" : "0"));
+  if (address.precise && address.count > 1)
+    {
+      result.push_back (Utl::int2cstring (address.stride));
+      result.push_back (Utl::int2cstring (address.count));
+    }
+  return result;
+}
+
+AbstractValue RegState::addOffset(const AbstractValue & value, long offset)
+{
+  if (value.precise) return AbstractValue (value.base, value.offset + offset, value.stride, value.count);
+  return AbstractValue (value.base, value.offset + offset, false);
+}
+
 // If the address construction does not fit the previously-handled cases, then I raise an error 
 //     pattern: most likely pointer shape
 bool RegState::AccessAnalysisDefault(int register_number, vector < string > &result)
 {
-  string value = state[register_number];
-  // if (value != "*") return false;
-  if ((value != "*")  && precision[register_number] ) return false;
+  const AbstractValue & value = state[register_number];
+  if (!value.isUnknown() && value.precise) return false;
   result = makeAnalysisDefault();
   return true;
 }
@@ -52,29 +70,16 @@ bool RegState::AccessAnalysisDefault(int register_number, vector < string > &res
  */
 void RegState::print(int vmax)
 {
-  string vstr;
-
   int auxReg = getAuxRegister();
 
   cout << "---- Registers ----" << endl;
   for (int i = 0; i < vmax; i++)
     {
-      if (i != auxReg) 
+      if (i != auxReg && !state[i].isUnknown())
 	{
-	  vstr = state[i];
-	  if (vstr != "*")
-	    {
-	      cout << std::dec << "\t state[" << i << "]= " 
-		   << vstr << ", " << (precision[i] ? "précis" : " non précis")  
-		   << endl; 
-	    }
-	  else
-	    if (precision[i])
-	      {
-		cout <<  " ERREUR :" <<  std::dec << "\t state[" << i << "]= " 
-		   << vstr << ", " << (precision[i] ? "précis" : " non précis")  
-		   << endl; 
-	      }
+	  cout << std::dec << "\t state[" << i << "]= " 
+	       << state[i].toString() << ", " << (state[i].precise ? "précis" : " non précis")  
+	       << endl; 
 	}
     }
 }
@@ -83,8 +88,7 @@ void RegState::print(int vmax)
 bool RegState::EqualsRegisters(RegState *r)
 {
   int n = state.size();
-  regTable state2= r->state;
-  regPrecisionTable precision2= r->precision;
+  const regTable & state2 = r->state;
 
   int auxReg = getAuxRegister();
   for (int i = 0; i < n; i++)   
@@ -92,7 +96,6 @@ bool RegState::EqualsRegisters(RegState *r)
       if ( i != auxReg)
 	{
 	  if (state[i] != state2[i]) return false;
-	  if (precision[i] != precision2[i]) return false;
 	}
     }
   return true;
@@ -100,55 +103,18 @@ bool RegState::EqualsRegisters(RegState *r)
 
 bool RegState::EqualsStacks(RegState *r)
 {
-  stackType vStack2 = r-> vStack;
-  stackPrecType vStackPrecision2 = r-> vStackPrecision;
-  if ( vStack.size() != vStack2.size()) return false;
-  for (int j = 0; j< (int) vStack.size(); j++)
-    {
-      if (vStack[j] != vStack2[j]) return false;
-      if (vStackPrecision[j] != vStackPrecision2[j]) return false;
-    }
-    return true;
+  return vStack == r->vStack;
 }
 
 void RegState::JoinStacks(RegState *r)
 {
-  int i, n = state.size();
-  bool b;
-  string v1, v2;
-  stackType new_vStack, vStack2 = r-> vStack;
-  stackPrecType new_vStackPrecision, vStackPrecision2 = r-> vStackPrecision;
-  
-  n = vStack.size();
-  int m = vStack2.size();
-  assert (n == m);
-  for (i = 0; i < n; i++)
-    {
-      b = false;
-      v1 = vStack[i];
-      v2 = vStack2[i];
-      if (v1 == v2)
-	{
-	  if (vStackPrecision[i] == vStackPrecision2[i]) b = vStackPrecision[i];
-	}
-      else
-	v1 = "*";
-      new_vStack.push_back(v1);
-      new_vStackPrecision.push_back(b);
-    }
-  vStack.swap(new_vStack);
-  vStackPrecision.swap(new_vStackPrecision);
+  vStack.join(r->vStack);
 }
 
 void RegState::JoinRegisters(RegState *r)
 {
-  int i, n = state.size();
-  regTable state2= r->state;
-  regPrecisionTable precision2 = r->precision;
- // int m = state2.size(); assert(n==m);
-
- regTable new_State;
- regPrecisionTable new_Precision;
+ int i, n = state.size();
+ const regTable & state2 = r->state;
  LOCTRACE(int auxReg = getAuxRegister());
 
  LOCTRACE(cout << " JOIN--JOIN--JOIN--JOIN--JOIN--JOIN--JOIN " << endl;
@@ -156,60 +122,46 @@ void RegState::JoinRegisters(RegState *r)
 	  cout << " Second ****"  << endl; r->print(n)
 	  );
  for (i = 0; i < n; i++)   
-   if (state[i] == state2[i])
-     {
-       new_State.push_back(state[i]);
-       if (precision[i] == precision2[i]) new_Precision.push_back(precision[i]); else new_Precision.push_back(false);
-     }
-   else
-     {
-       LOCTRACE (  if ( i != auxReg) { cout << " JOIN JOIN JOIN JOIN JOIN JOIN JOIN  set *, i =" << i << ", state[i]= " << state[i] << ", state2[i]= " << state2[i] << endl;});
-       new_State.push_back("*");
-       new_Precision.push_back(false);
-     }
- state.swap(new_State);
- precision.swap(new_Precision);
+   {
+     LOCTRACE (  if ( i != auxReg && !state[i].sameValue(state2[i])) { cout << " JOIN JOIN JOIN JOIN JOIN JOIN JOIN  i =" << i << ", state[i]= " << state[i].toString() << ", state2[i]= " << state2[i].toString() << endl;});
+     state[i] = AbstractValue::join(state[i], state2[i]);
+   }
  LOCTRACE (cout << " Result ****"  << endl; print(n));
 }
 
 
-string RegState::getRegisterValue(int register_number)
+void RegState::WidenRegisters(RegState *previous, RegState *back, long maxiter)
 {
-  return state[register_number];
+  int n = state.size();
+  for (int i = 0; i < n; i++)
+    state[i] = AbstractValue::widen(previous->state[i], state[i], back->state[i], maxiter);
 }
 
-bool RegState::getRegisterPrecision(int register_number)
+void RegState::WidenStacks(RegState *previous, RegState *back, long maxiter)
 {
-  return precision[register_number];
+  vStack.widen(previous->vStack, back->vStack, maxiter);
 }
 
-void RegState::setRegisterValue(int register_number, string val)
+AbstractValue RegState::getRegisterValue(int register_number)
 {
-  state[register_number] = val;
+  return state[register_number];
 }
 
-void RegState::setRegisterPrecision(int register_number, bool val)
+void RegState::setRegisterValue(int register_number, const AbstractValue & val)
 {
-  precision[register_number] = val;
+  state[register_number] = val;
 }
 
   
 void RegState::printStack()
 {
-  bool b=false;
-  int i, n = vStack.size();
-  if ( n>0 )
+  if (vStack.size() > 0)
     {
       cout << "---- Stack ----" << endl;
-      for ( i= 0; i < n; i++)
-	{
-	  if (vStack[i] != "*")
-	    {
-	      cout << "\t stack [" <<  i << "] = " << vStack[i] << ", precision = " << vStackPrecision[i] << endl;
-	      b=true;
-	    }
-	}
-      if (!b)
+      const AbstractStack::slotMap & known = vStack.getKnownSlots();
+      for (AbstractStack::slotMap::const_iterator it = known.begin(); it != known.end(); it++)
+	cout << "\t stack [" <<  it->first << "] = " << it->second.toString() << ", precision = " << it->second.precise << endl;
+      if (known.empty())
 	cout << "\t stack [for all indexes] = * " <<  endl;
     }
 }
@@ -222,72 +174,53 @@ void RegState::printStates()
 
 void RegState::initStackInfos(int stackSize)
 {
-  for (int i=0; i < stackSize; i++) {
-    vStack.push_back("*");	
-    vStackPrecision.push_back(false);	
-  }
+  vStack = AbstractStack(stackSize);
 }
 
 
 void RegState::cloneStack(RegState *r)
 {
   state = r ->state;
-  precision = r ->precision;
-  int n = r->vStack.size();
-  vStack.clear();
-  vStackPrecision.clear();
-  if (n >0)
-    {
-      for (int i = 0; i < n; i++) {
-	vStack.push_back(r->vStack[i]);
-	vStackPrecision.push_back(r->vStackPrecision[i]);
-      }
-    }
+  vStack = r->vStack;
 }
 
 void RegState::setRegisters(RegState *other)
 {
   state = other ->state;
-  precision = other ->precision;
 }
 
 
 void RegState::setStack(RegState *other)
 {
   vStack = other ->vStack;
-  vStackPrecision = other ->vStackPrecision;
 }
 
+/**
+   Imports the contents of the register numreg of the caller state (other), e.g. for a parameter.
+   An address in the stack frame of the caller (sp + k, k > 0) is rebased on the stack pointer
+   of the called function.
+   @return false when the contents of the register in the caller was already the one of this state.
+*/
 bool RegState::importRegister(RegState *other, int numreg)
 {
-  string vregCaller, vregCalled;
-  vregCaller = other->getRegisterValue(numreg);
-  vregCalled = this->getRegisterValue(numreg);
+  AbstractValue vregCaller = other->getRegisterValue(numreg);
+  AbstractValue vregCalled = this->getRegisterValue(numreg);
 
-  bool b = true;
-  size_t found = vregCaller.find ("sp");
-  if (found != EOS)
+  bool rebased = (vregCaller.base == BASE_SP && vregCaller.offset > 0);
+  if (rebased)
     {
-      string oper = vregCaller;
-      found = oper.find ("+");
-      if (found!= EOS)
-	{
-	  oper.erase (oper.begin (), oper.begin () + found + 2);
-	  if (!Utl::isDecNumber (oper))
-	    assert (Utl::isDecNumber (oper));	//check it is a number
-	  int n = vStack.size();
-	  long loffset = n + atol (oper.c_str ());
-	  ostringstream ossOffset;
-	  ossOffset << loffset;
-	  this->setRegisterValue(numreg, "sp + " + ossOffset.str ());
-	  b = false;
-	}
+      AbstractValue v = vregCaller;
+      v.offset = vStack.size() + vregCaller.offset;
+      v.precise = vregCalled.precise;
+      this->setRegisterValue(numreg, v);
     }
 
-  if (vregCaller == vregCalled)
+  if (vregCaller.sameValue(vregCalled))
     return false;
 
-  if (b) this->setRegisterValue(numreg, vregCaller);
-  this->setRegisterPrecision(numreg, other->getRegisterPrecision(numreg));
+  if (rebased)
+    state[numreg].precise = vregCaller.precise;
+  else
+    this->setRegisterValue(numreg, vregCaller);
   return true;
 }
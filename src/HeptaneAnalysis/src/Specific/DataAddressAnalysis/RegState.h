@@ -35,19 +35,14 @@ using namespace cfglib;
 class RegState {
  protected:
 
-  /** Content of each register, stored as a string.
-     "*" denotes an unknown contents, if the contents is known, the string contains
-     the operation that allows to compute the register contents.
+  /** Content of each register, a base (sp, gp, ...) and an offset (see AbstractValue).
+     BASE_NONE denotes an unknown contents.
+     The precision of a register is true when its contents is known precisely.
+     It is false when the register contents is not known precisely. In some situations, the base
+     is known and may contain useful information.
    */
   regTable state;
 
-  /** Precision of each register.
-     True means that the register contents is known precisely (then 'state' allows to compute its value).
-     False means that the register contents is not known precisely. In some situations, 'state' is not "*"
-     and may contain useful information.
-   */
-  regPrecisionTable precision;
-
  public:
 
   /** Default constructor.*/
@@ -55,10 +50,14 @@ class RegState {
 
   RegState(int nbRegisters);
 
+  virtual ~RegState() {};
+
+  /** @return a copy of this state (of the same architecture). */
+  virtual RegState * clone() = 0;
+
   void cloneStack(RegState * r);
 
-  stackType vStack;		// stack precision
-  stackPrecType vStackPrecision;	// stack precision 
+  AbstractStack vStack;		// stack frame, shared with the copies of the state until modified
 
   /** This function is used to compute the state of each register after the execution of the instruction.
       'instr' is the full text of the instruction.
@@ -75,26 +74,31 @@ class RegState {
 
   bool EqualsStacks(RegState * r);
 
-  /** Merging  two RegState objects:
-      - if the state of a register is different, the register is reset to undefined("*") and its precison is false, 
-      - otherwise the state is unchanged. The precision of the result is false if one of the precisions is false.
+  /** Merging  two RegState objects, register by register (see AbstractValue::join):
+      - two precise contents with the same base give the strided hull of their offsets,
+      - otherwise, if the state of a register is different, the register is reset to undefined (BASE_NONE),
+      - and the precision of the result is false if one of the precisions is false.
    */
   void JoinRegisters(RegState * r);
   void JoinStacks(RegState * r);
+
+  /** Widening at the head of a loop executed at most maxiter times for each entry (see AbstractValue::widen):
+      this state is the join of the states coming from outside the loop, previous the former state at the
+      head and back the join of the states coming from the backedges. */
+  void WidenRegisters(RegState * previous, RegState * back, long maxiter);
+  void WidenStacks(RegState * previous, RegState * back, long maxiter);
   void setRegisters(RegState * other);
   void setStack(RegState * other);
 
   /** 
       It resets the status of the stack pointer register (sp): 
-      - the state is set to "sp" 
+      - the state is set to sp + 0
       - and its precision is true.
   */
   virtual void reset_sp() = 0;
 
-  string getRegisterValue(int register_number);
-  bool getRegisterPrecision(int register_number);
-  void setRegisterValue(int register_number, string val);
-  void setRegisterPrecision(int register_number, bool val);
+  AbstractValue getRegisterValue(int register_number);
+  void setRegisterValue(int register_number, const AbstractValue & val);
 
   bool importRegister(RegState * other, int numreg);
 
@@ -106,6 +110,11 @@ class RegState {
   virtual int getAuxRegister() = 0;
 
   vector < string > makeAnalysisDefault();
+  /** @return the description of an access to address (see accessAnalysis): <kind, offset, precision>
+      followed by <stride, count> when the offsets of address are strided (e.g. "lui", "99024", "1", "4", "10"). */
+  vector < string > makeAnalysisAddress(string kind, const AbstractValue & address);
+  /** @return value + offset, the offset being added to the offset of a value which is not precise. */
+  static AbstractValue addOffset(const AbstractValue & value, long offset);
   bool AccessAnalysisDefault(int register_number, vector < string > &result);
   void print(int vmax);
 
@@ -124,14 +133,11 @@ of the instruction using the instruction categorization stored
 in mnemonicToInstructionTypes (see files MIPS.h/cc)
 
 The possible values of a register are:
- - "*"
- - "val"
- - "gp"
- - "gp + val"
- - "sp"
- - "sp + val"
- - "val lui"
- - "val lui + val"
+ - unknown (BASE_NONE)
+ - val (BASE_CONST)
+ - gp + val (BASE_GP)
+ - sp + val (BASE_SP)
+ - val lui + val (BASE_LUI, the offset is the address)
  
  where val represents an integer value.
  
@@ -145,6 +151,8 @@ class MIPSRegState:public RegState {
    */
   MIPSRegState(int stackSize);
 
+  RegState * clone() { return new MIPSRegState(*this); }
+
   /**
    * This function is used to compute the state of each register
    * after the execution of the instruction.
@@ -185,13 +193,13 @@ of the instruction using the instruction categorization stored
 in mnemonicToInstructionTypes (see files ARM.h/cc)
 
 The possible values of a register are:
- - "*"
- - "val"
- - "sp"
- - "sp + val"
- - "pc + val"
+ - unknown (BASE_NONE)
+ - val (BASE_CONST)
+ - sp + val (BASE_SP)
  
- where val represents an integer value.
+ where val represents an integer value. The values relative to pc are
+ replaced by the word they designate (see simulate), when they cannot
+ be the register is unknown.
  
 *****************************************************************/
 class ARMRegState:public RegState {
@@ -202,6 +210,8 @@ class ARMRegState:public RegState {
    */
   ARMRegState(int stackSize);
 
+  RegState * clone() { return new ARMRegState(*this); }
+
   /**
    * This function is used to compute the state of each register
    * after the execution of the instruction.
@@ -226,14 +236,14 @@ class ARMRegState:public RegState {
 
  private:
   bool GetWordPCrelative(Instruction * instr, offsetType TypeOperand, string offset, string codeinstr, string * vtype, unsigned long *val, unsigned long *addr);
-  bool GetWordAt(Instruction * instr, string regvalue, string offset, offsetType TypeOperand, string codeinstr, string * vtype, unsigned long *val, unsigned long *addr);
+  bool GetWordAt(Instruction * instr, long regvalue, string offset, offsetType TypeOperand, string codeinstr, string * vtype, unsigned long *val, unsigned long *addr);
   bool isAccessAnalysisPC(Instruction * instr, string codeinstr, int register_number, string offset, offsetType TypeOperand, vector < string > &result);
-  bool isAccessAnalysisSP(int register_number, string offset, vector < string > &result);
-  bool isAccessAnalysisOtherRegister(Instruction * instr, string codeinstr, int register_number, string offset, offsetType TypeOperand, vector < string > &result);
+  AbstractValue getAccessAddress(int register_number, AddressingMode vaddrmode, offsetType TypeOperand, string offset, string shifter_op);
+  bool isAccessAnalysisSP(const AbstractValue & address, vector < string > &result);
+  bool isAccessAnalysisOtherRegister(Instruction * instr, string codeinstr, int register_number, string offset, offsetType TypeOperand, const AbstractValue & address, vector < string > &result);
   void printInstrInfos(string & instr, string & codeinstr, string & oregister, bool & pre_indexed_addr, offsetType & TypeOperand, bool & updateBaseRegisterAfterMemoryTransfer, string & operand1,
 		       string & operand2, string & operand3);
   vector < string > makeAnalysisWordInfos(string vtype, unsigned long val, unsigned long addr);
-  bool getValueSP(string oper, long *val);
 };
 
 #endif
@@ -23,8 +23,7 @@ bool StackAnalysis::VerifModifStack (Cfg * cfg)
 	  // For each instruction in node
 	  for (size_t i = 0; i < listInstr.size (); i++)
 	    {
-	      string s_instr = listInstr[i]->GetCode ();
-	      vector < string > output_registers = Arch::getResourceOutputs (s_instr);
+	      const vector < string > &output_registers = AnalysisHelper::getDecoded (listInstr[i]).outputs;
 	      for (size_t j = 0; j < output_registers.size (); j++)
 		{
 		  if (output_registers[j] == "sp") return true;
@@ -52,9 +51,9 @@ int StackAnalysis::getStackMaxOffset (Cfg * cfg, int stack_size)
 	{
 	  // if (! instructions[i]->HasAttribute(MetaInstructionAttributeName)) // Added lbesnard Sept 2017.
 	    {
-	      string s_instr = instructions[i]->GetCode ();
-	      if (Arch::isLoad (s_instr) || Arch::isStore (s_instr))
-		result = getStackMaxOffset(s_instr, result); // ARCH Dependant.
+	      const DecodedInstruction & decoded = AnalysisHelper::getDecoded (instructions[i]);
+	      if (decoded.load || decoded.store)
+		result = getStackMaxOffset(decoded.code, result); // ARCH Dependant.
 	    }
 	}
     }
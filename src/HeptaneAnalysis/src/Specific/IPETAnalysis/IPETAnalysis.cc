@@ -83,8 +83,10 @@
 
 #include "Analysis.h"
 #include "Generic/Config.h"
+#include "Generic/AnalysisSession.h"
 #include "Specific/IPETAnalysis/IPETAnalysis.h"
 #include "Specific/IPETAnalysis/Solver.h"
+#include "Specific/IPETAnalysis/TreeIPET.h"
 #include "SharedAttributes/SharedAttributes.h"
 
 #include "arch.h"
@@ -144,7 +146,7 @@ int IPETAnalysis::getIPETMethodToApply(bool pipeline, bool perfectIcache, bool p
 // -----------
 // - p: program whose WCET is to be computed
 // - m: WCET computation method (METHOD_NOPIPELINE_ICACHE_DCACHE, METHOD_NOPIPELINE_PERFECTICACHE_PERFECTDCACHE, METHOD_PIPELINE_ICACHE_DCACHE, ....)
-// - used_solver: used solver (LP_SOLVE or CPLEX)
+// - used_solver: used solver (LP_SOLVE, CPLEX or SIMPLEX)
 // - generate_wcet_info: true if WCET information is attached to the CFG of entry point
 // - generate_node_freq: true if frequency information is attached to the nodes (one value per execution context)
 // - latencyPerfectIcache : useful only for PerfectIcache method
@@ -157,19 +159,21 @@ IPETAnalysis::IPETAnalysis(Program * p, int used_solver, bool pipeline, bool gen
   bool perfectIcache = false;
   
   // Check solver parameter is correct and create associated object
-  assert(used_solver == LP_SOLVE || used_solver == CPLEX);
+  assert(used_solver == LP_SOLVE || used_solver == CPLEX || used_solver == SIMPLEX);
   if (used_solver == LP_SOLVE)
     solver = new LpsolveSolver((IPETAnalysis *) this);
-  else
+  else if (used_solver == CPLEX)
     solver = new CPLEXSolver((IPETAnalysis *) this);
+  else
+    solver = new SimplexSolver((IPETAnalysis *) this);
 
   // Fill-in member variables from parameters
   generate_wcet_information = generate_wcet_info;
   generate_node_frequencies = generate_node_freq;
   NbICacheLevels = nb_icache_levels;
   NbDCacheLevels = nb_dcache_levels;
-  MemoryStoreLatency = config->getMemoryStoreLatency();
-  MemoryLoadLatency = config->getMemoryLoadLatency();
+  MemoryStoreLatency = getConfig()->getMemoryStoreLatency();
+  MemoryLoadLatency = getConfig()->getMemoryLoadLatency();
 
   this->call_graph = new CallGraph(p);
 
@@ -455,7 +459,7 @@ static long getIntegerAttribute(Node * n, string name)
   int val;
   assert(n != NULL);
   if (!n->HasAttribute(name))
-    exit(-1);
+    Logger::addFatal("IPETAnalysis: missing attribute " + name);
   assert(n->HasAttribute(name));
   NonSerialisableIntegerAttribute ai = (NonSerialisableIntegerAttribute &) n->GetAttribute(name);
   val = ai.GetValue();
@@ -707,7 +711,7 @@ bool IPETAnalysis::ComputeInstrExecutionTime_NOPIPELINE_STORE_DCACHE(Instruction
 {
   // This is introduce to not count for instance the next of an always miss 
   // in the current cache level while in previous level it is a First miss
-  if (Arch::isStore(vinstr->GetCode()))
+  if (AnalysisHelper::getDecoded(vinstr).store)
     {
       *wcet_first = *wcet_first + MemoryStoreLatency;
       *wcet_next = *wcet_next + MemoryStoreLatency;
@@ -746,7 +750,7 @@ void IPETAnalysis::ComputeInstrExecutionTime_NOPIPELINE_ICACHE_DCACHE(Instructio
   unsigned int occurrence_bound_data;
 
   ComputeInstrExecutionTime_NOPIPELINE_STORE_DCACHE(vinstr, wcet_first, wcet_next);
-  bisLoad =  Arch::isLoad(vinstr->GetCode());
+  bisLoad =  AnalysisHelper::getDecoded(vinstr).load;
 
   countFirst = true;	// to know if we count the first access for the current cache level
   countNext = true;	// to know if we count the next access for the current cache level
@@ -777,7 +781,7 @@ void IPETAnalysis::ComputeInstrExecutionTime_NOPIPELINE_PERFECTICACHE_DCACHE(Ins
 
 
   ComputeInstrExecutionTime_NOPIPELINE_STORE_DCACHE(vinstr, wcet_first, wcet_next);
-  if ( Arch::isLoad(vinstr->GetCode()))
+  if ( AnalysisHelper::getDecoded(vinstr).load)
     {
       always_accessed_data = true;
       never_accessed_data = false;
@@ -853,8 +857,8 @@ void IPETAnalysis::ComputeNodeExecutionTime_NOPIPELINE_CACHE(Node * n, Context *
 bool IPETAnalysis::generateNodeIds(ostringstream & os, Cfg * c)
 {
   // Used to generate BB numbers
-  // NB: should be static, because BB numbers should be unique for all Cfgs
-  static int bb_id = 0;
+  // NB: kept by the session, because BB numbers should be unique for all Cfgs
+  int &bb_id = session->getBasicBlockCounter();
 
   vector < Node * >vn = c->GetAllNodes();
 
@@ -1282,32 +1286,59 @@ void IPETAnalysis::generateConstraints_PIPELINE_ICACHE_PERFECTDCACHE(ostringstre
 
 void IPETAnalysis::generateConstraints_NOPIPELINE_ICACHE_DCACHE(ostringstream & os, Cfg * c, vector < Node * >&vn, const ContextList & contexts, vector < string > &vid, vector < long >&vwcet)
 {
-  ComputeNodesExecutionTime_NOPIPELINE_CACHE(vn, contexts, false, false);
   generateConstraints_NOPIPELINE_CACHE(vn, contexts, vid, vwcet);
   generateConstraints_inside_CACHE_BB(os, vn, contexts);
 }
 
 void IPETAnalysis::generateConstraints_NOPIPELINE_ICACHE_PERFECTDCACHE(ostringstream & os, Cfg * c, vector < Node * >&vn, const ContextList & contexts, vector < string > &vid, vector < long >&vwcet)
 {
-  ComputeNodesExecutionTime_NOPIPELINE_CACHE(vn, contexts, false, true);
   generateConstraints_NOPIPELINE_CACHE(vn, contexts, vid, vwcet);
   generateConstraints_inside_CACHE_BB(os, vn, contexts);
 }
 
 void IPETAnalysis::generateConstraints_NOPIPELINE_PERFECTICACHE_DCACHE(ostringstream & os, Cfg * c, vector < Node * >&vn, const ContextList & contexts, vector < string > &vid, vector < long >&vwcet)
 {
-  ComputeNodesExecutionTime_NOPIPELINE_CACHE(vn, contexts, true, false);
   generateConstraints_NOPIPELINE_CACHE(vn, contexts, vid, vwcet);
   generateConstraints_inside_CACHE_BB(os, vn, contexts);
 }
 
 void IPETAnalysis::generateConstraints_NOPIPELINE_PERFECTICACHE_PERFECTDCACHE(ostringstream & os, Cfg * c, vector < Node * >&vn, const ContextList & contexts, vector < string > &vid, vector < long >&vwcet)
 {
-  ComputeNodesExecutionTime_NOPIPELINE_NOCACHE(vn, contexts);
   generateConstraints_NOPIPELINE_NOCACHE(vn, contexts, vid, vwcet);
 }
 
 
+/* Attach the execution times of the nodes of c (InternalAttributeWCETfirst/next),
+   used by both the tree-based computation and the ILP system of the NOPIPELINE methods.
+   The PIPELINE methods compute theirs during constraint generation.
+*/
+void IPETAnalysis::ComputeNodesExecutionTime(Cfg * c)
+{
+  vector < Node * >vn = IsolatedNopNode(c);
+  const ContextList & contexts = (ContextList &) c->GetAttribute(ContextListAttributeName);
+  switch (method)
+    {
+    case METHOD_NOPIPELINE_ICACHE_DCACHE:
+      ComputeNodesExecutionTime_NOPIPELINE_CACHE(vn, contexts, false, false);
+      break;
+
+    case METHOD_NOPIPELINE_ICACHE_PERFECTDCACHE:
+      ComputeNodesExecutionTime_NOPIPELINE_CACHE(vn, contexts, false, true);
+      break;
+
+    case METHOD_NOPIPELINE_PERFECTICACHE_DCACHE:
+      ComputeNodesExecutionTime_NOPIPELINE_CACHE(vn, contexts, true, false);
+      break;
+
+    case METHOD_NOPIPELINE_PERFECTICACHE_PERFECTDCACHE:
+      ComputeNodesExecutionTime_NOPIPELINE_NOCACHE(vn, contexts);
+      break;
+
+    default:
+      ;
+    }
+}
+
 /* Fill-in vid and WCET to be able to generate the objective function
    This part is dependent on the type of IPET method selected,
    which fixes the naming convention of variables
@@ -1397,8 +1428,8 @@ void IPETAnalysis::printIPETCommand()
 //
 // Constraint generation is not directly done in this method.
 // A generic interface for constraint generation is
-// provided in Solver.h and implemented for two solvers
-// (lp_solve and CPLEX)
+// provided in Solver.h and implemented for three solvers
+// (lp_solve, CPLEX and the in-process simplex)
 //
 // Assumes each node has a node Id (done by function
 // generateNodeIds)
@@ -1428,33 +1459,16 @@ bool IPETAnalysis::generateConstraints(ostringstream & os, Cfg * c, vector < str
 #include<errno.h>
 
 // -------------------------------------------
-// Core of the analysis
-// generate an ILP problem to compute
-// the program WCET
+// Generates the whole ILP system of the program:
+// objective function in strf, constraints in strc
+// and declarations in stde (the in-process solver
+// builds its model at the same time)
 // -------------------------------------------
-bool IPETAnalysis::PerformAnalysis()
+void IPETAnalysis::generateSystem(ostringstream & strc, ostringstream & strf, ostringstream & stde)
 {
-  if (method == NOT_YET_IMPLEMENTED) return false;
-
-  ostringstream strc;		// objective function
-  ostringstream strf;		// flow constraints
-  ostringstream stde;		// declarations
-
-  char buffer[25] = "/tmp/IPETAnalysis_XXXXXX";
-  mkstemp(buffer);
-  ofstream os(buffer);
-  string fout = buffer;
-
-  // Get the Cfg of the program entry point
-  // --------------------------------------
   vector < string > vid;
   vector < long >vwcet;
   vector < Cfg * >lcfg = p->GetAllCfgs();
-  for (unsigned int c = 0; c < lcfg.size(); c++)
-    {
-      generateNodeIds(strc, lcfg[c]);
-    }
-
   for (unsigned int c = 0; c < lcfg.size(); c++)
     {
       if (!call_graph->isDeadCode(lcfg[c]))
@@ -1467,7 +1481,7 @@ bool IPETAnalysis::PerformAnalysis()
 
   // Constraint for entry point
   {
-    Cfg *c = config->getEntryPoint();
+    Cfg *c = p->GetEntryPoint();
     assert(c != NULL);
     assert(!(c->IsEmpty()));
     Node *start_node = c->GetStartNode();
@@ -1478,30 +1492,60 @@ bool IPETAnalysis::PerformAnalysis()
     vs.push_back("n_" + nid.str() + "_c0");
     solver->generate_equality(strc, vs, 1);
   }
+}
 
-  // Write everything (objective first, constraints, then declarations last) in the output file Objective function
-  os << strf.str();
-  // All the constraints (except statistics)
-  os << strc.str();
-  // Declarations
-  os << stde.str();
-  os.close();
-
-  // Launch the solver
-  // char fileNameTemplate[19] = "/tmp/solver_XXXXXX";
-  // string tmpFileName = mktemp(fileNameTemplate);  replaced by mkstemp (lbesnard) because ...
-  // Compiler: the use of `mktemp' is dangerous, better use `mkstemp'
-
-  string tmpFileName;
-  if (!Utl::mktmpfile("/tmp/solver_", tmpFileName) ) return false;
-  if (!solver->solve(fout, tmpFileName))
-    return false;
-
-  // Parse the solver output
+// -------------------------------------------
+// Core of the analysis
+// compute the program WCET on the loop trees
+// when possible, otherwise generate an ILP
+// problem and solve it
+// -------------------------------------------
+bool IPETAnalysis::PerformAnalysis()
+{
+  if (method == NOT_YET_IMPLEMENTED) return false;
+
+  ostringstream strc;		// objective function
+  ostringstream strf;		// flow constraints
+  ostringstream stde;		// declarations
+
+  vector < Cfg * >lcfg = p->GetAllCfgs();
+  for (unsigned int c = 0; c < lcfg.size(); c++)
+    {
+      generateNodeIds(strc, lcfg[c]);
+    }
+  for (unsigned int c = 0; c < lcfg.size(); c++)
+    {
+      if (!call_graph->isDeadCode(lcfg[c]))
+	ComputeNodesExecutionTime(lcfg[c]);
+    }
+
+  // Tree-based computation when the system only contains flow, loop bound and call constraints
   string wcet;
-  if (solver->parse_output(tmpFileName, wcet)) ;
+  bool solved = false;
+  if (method == METHOD_PIPELINE_ICACHE_DCACHE || method == METHOD_PIPELINE_ICACHE_PERFECTDCACHE)
+    Logger::addInfo("IPET: ILP solver used (pipeline timing of the edges)");
+  else
+    {
+      TreeIPET tree(this, method != METHOD_NOPIPELINE_PERFECTICACHE_PERFECTDCACHE);
+      solved = tree.solve(wcet);
+      ostringstream info;
+      if (solved)
+	info << "IPET: tree-based computation (" << tree.getNbContexts() << " function contexts, " << tree.getNbLoops() << " loop contexts)";
+      else
+	info << "IPET: ILP solver used (" << tree.getReason() << ")";
+      Logger::addInfo(info.str());
+    }
+
+  if (!solved)
+    {
+      // The ILP system is only generated when the tree-based computation failed
+      generateSystem(strc, strf, stde);
+      // Everything: objective first, constraints (except statistics), then declarations last
+      if (!solver->solve(strf.str() + strc.str() + stde.str(), wcet))
+	return false;
+    }
 
-  Cfg *c = config->getEntryPoint();
+  Cfg *c = p->GetEntryPoint();
 
   // Attach result to entry point
   if (this->generate_wcet_information)
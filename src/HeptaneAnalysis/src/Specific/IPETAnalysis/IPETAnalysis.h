@@ -56,7 +56,9 @@ class IPETAnalysis:public Analysis
   /** Method to parse lp_solve solver */
   friend bool LpsolveSolver::parse_output (string file_name, string &);
   friend bool CPLEXSolver::parse_output (string file_name, string &);
-  friend void Solver::setFrequencyAttribute(string VariableName, string freq);
+  friend bool SimplexSolver::solve (const string &, string &);
+  friend void Solver::setFrequencyAttribute(string VariableName, unsigned long freq);
+  friend class TreeIPET;
 
   /** Map to store node_ids, used for naming variables in the ILP
       system (numbers from 0 to number of BBs in the program) Avoids
@@ -76,7 +78,7 @@ class IPETAnalysis:public Analysis
       The analysis fails with a "false" error code when the call graph is cyclic*/
   CallGraph *call_graph;
 
-  /** Used solver (lp_solve or CPLEX). Built in the constructor
+  /** Used solver (lp_solve, CPLEX or in-process simplex). Built in the constructor
       depending on the value of parameter "used_solver"*/
   Solver *solver;
 
@@ -150,6 +152,8 @@ class IPETAnalysis:public Analysis
   void generateConstraints_NOPIPELINE_CACHE( vector < Node * > vn, const ContextList &contexts, vector < string > &vid, vector < long >&vwcet);
 
   void ComputeNodesExecutionTime_NOPIPELINE_NOCACHE( vector < Node * > vn, const ContextList & contexts);
+  /** Attach the execution times of the nodes of c for the NOPIPELINE methods (before the tree-based computation or the ILP generation) */
+  void ComputeNodesExecutionTime(Cfg * c);
   void generateConstraints_NOPIPELINE_NOCACHE(vector < Node * >vn, const ContextList & contexts, vector < string > &vid, vector < long >&vwcet);
 
   void generateConstraints_NOPIPELINE_ICACHE_DCACHE(ostringstream & os, Cfg * c, vector < Node * >&vn, const ContextList & contexts, vector < string > &vid, vector < long >&vwcet);
@@ -196,7 +200,7 @@ class IPETAnalysis:public Analysis
   /** Constructor
       - p: program whose WCET is to be computed
       - method: WCET computation method (METHOD_INSTR, METHOD_BB, METHOD_NOCACHE)
-      - used_solver: used solver (LP_SOLVE or CPLEX)
+      - used_solver: used solver (LP_SOLVE, CPLEX or SIMPLEX)
       - generate_wcet_info: true if WCET information is attached to the CFG of entry
       - generate_node_freq: true if frequency information is attached to the nodes (one value per execution context) .
   */
@@ -224,7 +228,10 @@ class IPETAnalysis:public Analysis
   /** Generate structural and loop constraints */
   bool generateConstraints (ostringstream & os, Cfg * c, vector < string > &vid, vector < long >&vwcet);
     
-  /** Perform the computation (generates constraints, calls the solver and attaches the results to the program CFG/BB) */
+  /** Generate the whole ILP system (objective function, constraints, declarations) */
+  void generateSystem (ostringstream & strc, ostringstream & strf, ostringstream & stde);
+    
+  /** Perform the computation (tree-based computation when possible, otherwise generates constraints, calls the solver and attaches the results to the program CFG/BB) */
   bool PerformAnalysis ();
 
   /** Remove all private attributes*/ 
@@ -0,0 +1,452 @@
+/* ---------------------------------------------------------------------
+
+   Copyright IRISA, 2003-2017
+
+   This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+   estimation.
+   APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+   Heptane is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Heptane is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details (COPYING.txt).
+
+   See CREDITS.txt for credits of authorship
+
+   ------------------------------------------------------------------------ */
+
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+
+#include "Specific/IPETAnalysis/LinearProgram.h"
+
+using namespace std;
+
+/** Tolerance on the pivots and on the reduced costs */
+static const double EPS = 1e-9;
+/** Tolerance on the integrality of the solutions and on the feasibility of phase 1 */
+static const double INT_EPS = 1e-6;
+/** Number of consecutive degenerate pivots before switching to Bland's rule */
+static const unsigned int MAX_DEGENERATE = 50;
+
+/**
+ * Sparse row of the simplex tableau: the non-zero coefficients, by increasing column.
+ */
+class TableauRow
+{
+public:
+  vector < unsigned int > columns;
+  vector < double > values;
+
+  /** @return the coefficient of column j */
+  double get (unsigned int j) const
+  {
+    vector < unsigned int >::const_iterator it = lower_bound (columns.begin (), columns.end (), j);
+    if (it == columns.end () || *it != j) return 0.0;
+    return values[it - columns.begin ()];
+  }
+
+  /** Appends the coefficient v of column j, greater than the columns already set */
+  void push (unsigned int j, double v)
+  {
+    assert (columns.empty () || columns.back () < j);
+    columns.push_back (j);
+    values.push_back (v);
+  }
+};
+
+/** Orders the coefficients of a LinearProgram::SparseRow by variable */
+struct CompareColumns
+{
+  bool operator () (const pair < unsigned int, double >&a, const pair < unsigned int, double >&b) const
+  {
+    return a.first < b.first;
+  }
+};
+
+/**
+ * Simplex tableau of a linear program in standard form (B^-1 A | B^-1 b),
+ * with sparse rows (the IPET constraints have a few variables each), the
+ * right-hand side in a separate column, and the reduced costs in a dense
+ * objective row (the last entry of which is minus the objective value).
+ */
+class SimplexTableau
+{
+public:
+  vector < TableauRow > t;		///< rows
+  vector < double > rhs;		///< right-hand side of every row
+  vector < double > obj;		///< reduced costs, -z in the last column
+  vector < unsigned int > basis;	///< basic variable of every row
+  unsigned int nbColumns;		///< number of columns, right-hand side excluded
+  unsigned long nbPivots;
+
+  SimplexTableau (unsigned int nbRows, unsigned int nbCols):nbColumns (nbCols), nbPivots (0)
+  {
+    t.assign (nbRows, TableauRow ());
+    rhs.assign (nbRows, 0.0);
+    obj.assign (nbCols + 1, 0.0);
+    basis.assign (nbRows, 0);
+  }
+
+  /** Pivots on row r and column e: the rows with a non-zero coefficient in column e
+      are combined with the pivot row, on its non-zero entries. */
+  void pivot (unsigned int r, unsigned int e)
+  {
+    TableauRow & pr = t[r];
+    double p = pr.get (e);
+    for (size_t k = 0; k < pr.values.size (); k++)
+      pr.values[k] = (pr.columns[k] == e) ? 1.0 : pr.values[k] / p;
+    if (rhs[r] != 0.0) rhs[r] /= p;
+
+    TableauRow combined;
+    for (unsigned int i = 0; i < t.size (); i++)
+      {
+	if (i == r) continue;
+	double f = t[i].get (e);
+	if (f == 0.0) continue;
+	eliminate (t[i], pr, f, e, combined);
+	if (rhs[r] != 0.0) rhs[i] = clean (rhs[i] - f * rhs[r]);
+      }
+    double f = obj[e];
+    if (f != 0.0)
+      {
+	for (size_t k = 0; k < pr.columns.size (); k++)
+	  obj[pr.columns[k]] = clean (obj[pr.columns[k]] - f * pr.values[k]);
+	if (rhs[r] != 0.0) obj[nbColumns] = clean (obj[nbColumns] - f * rhs[r]);
+	obj[e] = 0.0;
+      }
+    basis[r] = e;
+    nbPivots++;
+  }
+
+  /** Runs primal simplex iterations on the allowed columns until optimality.
+      @return OPTIMAL, UNBOUNDED or LIMIT (more than maxPivots pivots) */
+  LinearProgram::Status iterate (const vector < bool > &allowed, unsigned long maxPivots)
+  {
+    bool bland = false;
+    unsigned int degenerate = 0;
+    while (true)
+      {
+	// Entering column: largest reduced cost (first positive one with Bland's rule)
+	int e = -1;
+	double best = EPS;
+	for (unsigned int j = 0; j < nbColumns; j++)
+	  {
+	    if (!allowed[j] || obj[j] <= EPS) continue;
+	    if (bland)
+	      {
+		e = j;
+		break;
+	      }
+	    if (obj[j] > best)
+	      {
+		best = obj[j];
+		e = j;
+	      }
+	  }
+	if (e < 0) return LinearProgram::OPTIMAL;
+
+	// Leaving row: minimum ratio, ties broken by the smallest basic variable
+	int r = -1;
+	double ratio = 0.0;
+	for (unsigned int i = 0; i < t.size (); i++)
+	  {
+	    double a = t[i].get (e);
+	    if (a <= EPS) continue;
+	    double q = rhs[i] / a;
+	    if (q < 0.0) q = 0.0;
+	    if (r < 0 || q < ratio - EPS || (q <= ratio + EPS && basis[i] < basis[r]))
+	      {
+		r = i;
+		ratio = q;
+	      }
+	  }
+	if (r < 0) return LinearProgram::UNBOUNDED;
+
+	if (ratio <= EPS)
+	  {
+	    if (++degenerate > MAX_DEGENERATE) bland = true;
+	  }
+	else
+	  {
+	    degenerate = 0;
+	    bland = false;
+	  }
+	pivot (r, e);
+	if (nbPivots > maxPivots) return LinearProgram::LIMIT;
+      }
+  }
+
+private:
+  /** @return v, or 0 when v is a rounding residue */
+  static double clean (double v)
+  {
+    return (fabs (v) < 1e-12) ? 0.0 : v;
+  }
+
+  /** row -= f * pr (f = row[e]) by a merge of the two rows, column e being removed from row.
+      combined is a buffer, swapped with row. */
+  static void eliminate (TableauRow & row, const TableauRow & pr, double f, unsigned int e, TableauRow & combined)
+  {
+    combined.columns.clear ();
+    combined.values.clear ();
+    size_t a = 0, b = 0;
+    while (a < row.columns.size () || b < pr.columns.size ())
+      {
+	unsigned int j;
+	double v;
+	if (b == pr.columns.size () || (a < row.columns.size () && row.columns[a] < pr.columns[b]))
+	  {
+	    j = row.columns[a];
+	    v = row.values[a++];
+	  }
+	else if (a == row.columns.size () || pr.columns[b] < row.columns[a])
+	  {
+	    j = pr.columns[b];
+	    v = clean (0.0 - f * pr.values[b++]);
+	  }
+	else
+	  {
+	    j = row.columns[a];
+	    v = clean (row.values[a++] - f * pr.values[b++]);
+	  }
+	if (j != e && v != 0.0) combined.push (j, v);
+      }
+    swap (row.columns, combined.columns);
+    swap (row.values, combined.values);
+  }
+};
+
+LinearProgram::LinearProgram ():solutionObjective (0.0), nbPivots (0), nbNodes (0)
+{
+}
+
+unsigned int
+LinearProgram::addVariable ()
+{
+  objective.push_back (0.0);
+  integer.push_back (false);
+  return objective.size () - 1;
+}
+
+void
+LinearProgram::addObjective (unsigned int v, double c)
+{
+  assert (v < objective.size ());
+  objective[v] += c;
+}
+
+void
+LinearProgram::setInteger (unsigned int v)
+{
+  assert (v < integer.size ());
+  integer[v] = true;
+}
+
+void
+LinearProgram::addRow (const SparseRow & coefs, RowType type, double rhs)
+{
+  Row row;
+  row.coefs = coefs;
+  row.type = type;
+  row.rhs = rhs;
+  rows.push_back (row);
+}
+
+// Two-phase simplex on the tableau:
+// - columns: the variables, one slack per LE row, one surplus per GE row, then one artificial per GE and EQ row
+//   (the rows are first normalised to a non-negative right-hand side),
+// - phase 1 maximizes -sum(artificials) from the basis of the slacks and artificials,
+// - the remaining artificials (at 0) are pivoted out of the basis when possible (otherwise the row is redundant),
+// - phase 2 maximizes the objective without the artificials.
+LinearProgram::Status LinearProgram::solveRelaxation (const vector < Row > &bounds, vector < double >&x, double &z)
+{
+  unsigned int n = objective.size ();
+  unsigned int m = rows.size () + bounds.size ();
+  vector < const Row * >all;
+  for (size_t i = 0; i < rows.size (); i++) all.push_back (&rows[i]);
+  for (size_t i = 0; i < bounds.size (); i++) all.push_back (&bounds[i]);
+
+  // Normalised row types and signs, number of columns
+  vector < RowType > types (m);
+  vector < double > signs (m);
+  unsigned int nbSlacks = 0, nbArtificials = 0;
+  for (unsigned int i = 0; i < m; i++)
+    {
+      types[i] = all[i]->type;
+      signs[i] = 1.0;
+      if (all[i]->rhs < 0.0)
+	{
+	  signs[i] = -1.0;
+	  if (types[i] == LE) types[i] = GE;
+	  else if (types[i] == GE) types[i] = LE;
+	}
+      if (types[i] != EQ) nbSlacks++;
+      if (types[i] != LE) nbArtificials++;
+    }
+  unsigned int firstArtificial = n + nbSlacks;
+  unsigned int nbColumns = firstArtificial + nbArtificials;
+
+  SimplexTableau tab (m, nbColumns);
+  unsigned int slack = n, artificial = firstArtificial;
+  for (unsigned int i = 0; i < m; i++)
+    {
+      // Coefficients of the variables, the ones of the same variable being summed up
+      SparseRow coefs = all[i]->coefs;
+      stable_sort (coefs.begin (), coefs.end (), CompareColumns ());
+      TableauRow & row = tab.t[i];
+      for (size_t k = 0; k < coefs.size ();)
+	{
+	  unsigned int j = coefs[k].first;
+	  assert (j < n);
+	  double v = 0.0;
+	  for (; k < coefs.size () && coefs[k].first == j; k++)
+	    v += signs[i] * coefs[k].second;
+	  if (v != 0.0) row.push (j, v);
+	}
+      tab.rhs[i] = signs[i] * all[i]->rhs;
+      if (types[i] == LE)
+	{
+	  row.push (slack, 1.0);
+	  tab.basis[i] = slack++;
+	}
+      else
+	{
+	  if (types[i] == GE) row.push (slack++, -1.0);
+	  row.push (artificial, 1.0);
+	  tab.basis[i] = artificial++;
+	}
+    }
+
+  unsigned long maxPivots = 50UL * (m + nbColumns) + 1000;
+  vector < bool > allowed (nbColumns, true);
+
+  // Phase 1
+  if (nbArtificials > 0)
+    {
+      for (unsigned int j = firstArtificial; j < nbColumns; j++) tab.obj[j] = -1.0;
+      for (unsigned int i = 0; i < m; i++)
+	{
+	  if (tab.basis[i] < firstArtificial) continue;
+	  const TableauRow & row = tab.t[i];
+	  for (size_t k = 0; k < row.columns.size (); k++) tab.obj[row.columns[k]] += row.values[k];
+	  tab.obj[nbColumns] += tab.rhs[i];
+	}
+      Status s = tab.iterate (allowed, maxPivots);
+      nbPivots += tab.nbPivots;
+      tab.nbPivots = 0;
+      if (s == LIMIT) return LIMIT;
+      if (tab.obj[nbColumns] > INT_EPS) return INFEASIBLE;	// sum(artificials) > 0
+
+      for (unsigned int i = 0; i < m; i++)
+	{
+	  if (tab.basis[i] < firstArtificial) continue;
+	  const TableauRow & row = tab.t[i];
+	  for (size_t k = 0; k < row.columns.size () && row.columns[k] < firstArtificial; k++)
+	    {
+	      if (fabs (row.values[k]) > EPS)
+		{
+		  tab.pivot (i, row.columns[k]);
+		  break;
+		}
+	    }
+	}
+      for (unsigned int j = firstArtificial; j < nbColumns; j++) allowed[j] = false;
+    }
+
+  // Phase 2
+  tab.obj.assign (nbColumns + 1, 0.0);
+  for (unsigned int j = 0; j < n; j++) tab.obj[j] = objective[j];
+  for (unsigned int i = 0; i < m; i++)
+    {
+      unsigned int b = tab.basis[i];
+      double cb = (b < n) ? objective[b] : 0.0;
+      if (cb == 0.0) continue;
+      const TableauRow & row = tab.t[i];
+      for (size_t k = 0; k < row.columns.size (); k++) tab.obj[row.columns[k]] -= cb * row.values[k];
+      tab.obj[nbColumns] -= cb * tab.rhs[i];
+    }
+  Status s = tab.iterate (allowed, maxPivots);
+  nbPivots += tab.nbPivots;
+  if (s != OPTIMAL) return s;
+
+  x.assign (n, 0.0);
+  for (unsigned int i = 0; i < m; i++)
+    {
+      if (tab.basis[i] < n) x[tab.basis[i]] = tab.rhs[i];
+    }
+  z = 0.0;
+  for (unsigned int j = 0; j < n; j++) z += objective[j] * x[j];
+  return OPTIMAL;
+}
+
+// Depth-first branch and bound on the most fractional integer variable
+LinearProgram::Status LinearProgram::solve (unsigned int maxNodes)
+{
+  nbPivots = nbNodes = 0;
+  bool found = false;
+  double best = 0.0;
+  vector < double > bestX;
+
+  vector < vector < Row > > pending (1);
+  while (!pending.empty ())
+    {
+      vector < Row > bounds = pending.back ();
+      pending.pop_back ();
+      if (++nbNodes > maxNodes) return LIMIT;
+
+      vector < double > x;
+      double z;
+      Status s = solveRelaxation (bounds, x, z);
+      if (s == INFEASIBLE) continue;
+      if (s != OPTIMAL) return s;
+      if (found && z <= best + INT_EPS) continue;
+
+      int v = -1;
+      double fraction = INT_EPS;
+      for (unsigned int j = 0; j < x.size (); j++)
+	{
+	  if (!integer[j]) continue;
+	  double f = fabs (x[j] - floor (x[j] + 0.5));
+	  if (f > fraction)
+	    {
+	      fraction = f;
+	      v = j;
+	    }
+	}
+      if (v < 0)
+	{
+	  found = true;
+	  best = z;
+	  bestX = x;
+	  continue;
+	}
+
+      Row branch;
+      branch.coefs.push_back (make_pair ((unsigned int) v, 1.0));
+      branch.type = LE;
+      branch.rhs = floor (x[v]);
+      pending.push_back (bounds);
+      pending.back ().push_back (branch);
+      branch.type = GE;
+      branch.rhs = ceil (x[v]);
+      pending.push_back (bounds);
+      pending.back ().push_back (branch);
+    }
+  if (!found) return INFEASIBLE;
+
+  solution = bestX;
+  solutionObjective = 0.0;
+  for (unsigned int j = 0; j < solution.size (); j++)
+    {
+      if (integer[j]) solution[j] = floor (solution[j] + 0.5);
+      solutionObjective += objective[j] * solution[j];
+    }
+  return OPTIMAL;
+}
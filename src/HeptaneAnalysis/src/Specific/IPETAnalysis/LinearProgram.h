@@ -0,0 +1,127 @@
+/* ---------------------------------------------------------------------
+
+   Copyright IRISA, 2003-2017
+
+   This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+   estimation.
+   APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+   Heptane is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Heptane is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details (COPYING.txt).
+
+   See CREDITS.txt for credits of authorship
+
+   ------------------------------------------------------------------------ */
+
+/**
+ * \brief In-memory integer linear program, solved in process.
+ *
+ * The constraints are kept as sparse rows. The linear relaxation is solved
+ * by a two-phase primal simplex (Dantzig's rule, Bland's rule on degenerate
+ * pivots to avoid cycling), and the integer variables are enforced by a
+ * depth-first branch and bound. The IPET systems are flow problems whose
+ * relaxation is integral most of the time, so that branching is rare.
+ */
+#ifndef LINEAR_PROGRAM_H
+#define LINEAR_PROGRAM_H
+
+#include <vector>
+#include <utility>
+
+/**
+ * \class LinearProgram
+ * \brief Maximisation of a linear objective over non-negative variables.
+ */
+class LinearProgram
+{
+public:
+  /** Types of the constraints: sum(coefs) <= rhs, = rhs, >= rhs */
+  enum RowType { LE, EQ, GE };
+
+  /** Status of solve */
+  enum Status { OPTIMAL, INFEASIBLE, UNBOUNDED, LIMIT };
+
+  /** A sparse row: (variable, coefficient) pairs */
+  typedef std::vector < std::pair < unsigned int, double > > SparseRow;
+
+  /** Constructor (no variable, no constraint). */
+  LinearProgram ();
+
+  /** Adds a variable (>= 0, objective coefficient 0, continuous) and returns its number. */
+  unsigned int addVariable ();
+
+  /** @return the number of variables. */
+  unsigned int getNbVariables () const
+  {
+    return objective.size ();
+  }
+
+  /** Adds c to the coefficient of variable v in the objective function (maximized). */
+  void addObjective (unsigned int v, double c);
+
+  /** Declares variable v as an integer variable. */
+  void setInteger (unsigned int v);
+
+  /** Adds the constraint sum(coefs) type rhs. */
+  void addRow (const SparseRow & coefs, RowType type, double rhs);
+
+  /** @return the number of constraints. */
+  unsigned int getNbRows () const
+  {
+    return rows.size ();
+  }
+
+  /** Solves the program. maxNodes bounds the number of branch and bound nodes (LIMIT when exceeded). */
+  Status solve (unsigned int maxNodes = 10000);
+
+  /** @return the value of variable v in the solution (valid after an OPTIMAL solve). */
+  double getValue (unsigned int v) const
+  {
+    return solution[v];
+  }
+
+  /** @return the value of the objective function in the solution (valid after an OPTIMAL solve). */
+  double getObjective () const
+  {
+    return solutionObjective;
+  }
+
+  /** @return the number of simplex pivots and branch and bound nodes of the last solve. */
+  unsigned long getNbPivots () const
+  {
+    return nbPivots;
+  }
+  unsigned long getNbNodes () const
+  {
+    return nbNodes;
+  }
+
+private:
+  struct Row
+  {
+    SparseRow coefs;
+    RowType type;
+    double rhs;
+  };
+
+  std::vector < Row > rows;
+  std::vector < double > objective;
+  std::vector < bool > integer;
+
+  std::vector < double > solution;
+  double solutionObjective;
+  unsigned long nbPivots, nbNodes;
+
+  /** Solves the linear relaxation of the program with the additional constraints bounds.
+      On OPTIMAL, x and z are the solution and its objective value. */
+  Status solveRelaxation (const std::vector < Row > &bounds, std::vector < double > &x, double &z);
+};
+
+#endif
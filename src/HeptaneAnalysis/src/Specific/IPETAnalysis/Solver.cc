@@ -32,6 +32,7 @@
 #include <map>
 #include <string>
 #include <cassert>
+#include <cmath>
 #include "Specific/IPETAnalysis/Solver.h"
 #include "Specific/IPETAnalysis/IPETAnalysis.h"
 #include "Utl.h"
@@ -45,6 +46,11 @@
   The names are generated in the method IPETAnalysis::generateNodeIds().
 */
 void Solver::setFrequencyAttribute(string VariableName, string freq)
+{
+  setFrequencyAttribute(VariableName, (unsigned long) atol ((char *) freq.c_str()));
+}
+
+void Solver::setFrequencyAttribute(string VariableName, unsigned long freq)
 {
   Node *n;
   string ctxName;
@@ -60,12 +66,38 @@ void Solver::setFrequencyAttribute(string VariableName, string freq)
 	  Logger::addFatal ("LpsolveSolver: Variable " + VariableName + " already has a frequency ...");
 	}
 
-      SerialisableUnsignedLongAttribute frequency (atol ((char *) freq.c_str()));
+      SerialisableUnsignedLongAttribute frequency (freq);
       TRACE(cout << "attr = " <<  attr << ", variable = " << VariableName << endl);
       n->SetAttribute (attr, frequency);
     }
 }
 
+// External solvers: the system is written in a temporary file, given to the solver, the output of which is parsed
+// ---------------------------------------------------------------------------------------------------------------
+bool
+ExternalSolver::solve (const string & system, string & wcet)
+{
+  char buffer[25] = "/tmp/IPETAnalysis_XXXXXX";
+  mkstemp(buffer);
+  ofstream os(buffer);
+  string fout = buffer;
+  os << system;
+  os.close();
+
+  // Launch the solver
+  // char fileNameTemplate[19] = "/tmp/solver_XXXXXX";
+  // string tmpFileName = mktemp(fileNameTemplate);  replaced by mkstemp (lbesnard) because ...
+  // Compiler: the use of `mktemp' is dangerous, better use `mkstemp'
+
+  string tmpFileName;
+  if (!Utl::mktmpfile("/tmp/solver_", tmpFileName) ) return false;
+  if (!run(fout, tmpFileName))
+    return false;
+
+  // Parse the solver output
+  if (parse_output(tmpFileName, wcet)) ;
+  return true;
+}
 
 // Constraint generation functions (specific to lp_solve so far)
 // -------------------------------------------------------------
@@ -185,7 +217,7 @@ LpsolveSolver::generate_equality (ostringstream & os, vector < string > vid, int
 }
 
 bool
-LpsolveSolver::solve (string file_name, string fout)
+LpsolveSolver::run (string file_name, string fout)
 {
 
   string lp_solve_command = "lp_solve < " + file_name + " > " + fout;
@@ -239,6 +271,119 @@ LpsolveSolver::parse_output (string file_name, string & wcet)
   return true;
 }
 
+// In-process solver: the constraints are added to lp (os is not used)
+// --------------------------------------------------------------------
+
+unsigned int
+SimplexSolver::getVariable (const string & id)
+{
+  map < string, unsigned int >::iterator it = variables.find (id);
+  if (it != variables.end ())
+    return it->second;
+  unsigned int v = lp.addVariable ();
+  variables[id] = v;
+  names.push_back (id);
+  return v;
+}
+
+LinearProgram::SparseRow
+SimplexSolver::makeRow (const vector < string > &ids)
+{
+  LinearProgram::SparseRow row;
+  for (unsigned int i = 0; i < ids.size (); i++)
+    row.push_back (make_pair (getVariable (ids[i]), 1.0));
+  return row;
+}
+
+// MAXIMIZE sum(ids*cst)
+void
+SimplexSolver::generate_objective_function (ostringstream & os, vector < string > ids, vector < long >cst)
+{
+  assert (ids.size () == cst.size ());
+  for (unsigned int i = 0; i < ids.size (); i++)
+    lp.addObjective (getVariable (ids[i]), cst[i]);
+}
+
+// sum (ids*cst) <= N
+void
+SimplexSolver::generate_linear_inequality (ostringstream & os, vector < string > ids, vector < long >cst, int N)
+{
+  assert (ids.size () == cst.size ());
+  LinearProgram::SparseRow row;
+  for (unsigned int i = 0; i < ids.size (); i++)
+    row.push_back (make_pair (getVariable (ids[i]), (double) cst[i]));
+  lp.addRow (row, LinearProgram::LE, N);
+}
+
+// Integer variables
+void
+SimplexSolver::generate_declarations (ostringstream & os, vector < string > ids)
+{
+  for (unsigned int i = 0; i < ids.size (); i++)
+    lp.setInteger (getVariable (ids[i]));
+}
+
+// vid[0] = sum(vid[1..n])
+void
+SimplexSolver::generate_flow_constraint (ostringstream & os, vector < string > vid)
+{
+  assert (vid.size () > 0);
+  if (vid.size () > 1)
+    {
+      LinearProgram::SparseRow row = makeRow (vector < string > (vid.begin () + 1, vid.end ()));
+      row.push_back (make_pair (getVariable (vid[0]), -1.0));
+      lp.addRow (row, LinearProgram::EQ, 0);
+    }
+}
+
+// Sum(vids) <= N
+void
+SimplexSolver::generate_inequality (ostringstream & os, vector < string > vid, int N)
+{
+  assert (vid.size () > 0);
+  lp.addRow (makeRow (vid), LinearProgram::LE, N);
+}
+
+// Sum(vids) = N
+void
+SimplexSolver::generate_equality (ostringstream & os, vector < string > vid, int N)
+{
+  assert (vid.size () > 0);
+  lp.addRow (makeRow (vid), LinearProgram::EQ, N);
+}
+
+// The system is the one kept in lp, the text one is not used
+bool
+SimplexSolver::solve (const string & system, string & wcet)
+{
+  LinearProgram::Status status = lp.solve ();
+  if (status != LinearProgram::OPTIMAL)
+    {
+      stringstream errorstr;
+      errorstr << "SimplexSolver: no solution found for the " << lp.getNbVariables () << " variables, " << lp.getNbRows () << " constraints system (";
+      if (status == LinearProgram::INFEASIBLE) errorstr << "infeasible";
+      else if (status == LinearProgram::UNBOUNDED) errorstr << "unbounded";
+      else errorstr << "iteration limit reached";
+      errorstr << ")";
+      Logger::addFatal (errorstr.str ());
+      return false;
+    }
+
+  stringstream infostr;
+  infostr << "SimplexSolver: " << lp.getNbVariables () << " variables, " << lp.getNbRows () << " constraints, "
+	  << lp.getNbPivots () << " pivots, " << lp.getNbNodes () << " branch and bound nodes";
+  Logger::addInfo (infostr.str ());
+
+  char buf[256];
+  sprintf (buf, "%.0f", lp.getObjective ());
+  wcet = string (buf);
+
+  if (analysis->generate_node_frequencies)
+    for (unsigned int v = 0; v < names.size (); v++)
+      setFrequencyAttribute (names[v], (unsigned long) floor (lp.getValue (v) + 0.5));
+  return true;
+}
+
 // generate_objective_function MAXIMIZE sum(ids*cst)
 //
 // - os: stream where to output the constrain system
@@ -366,7 +511,7 @@ CPLEXSolver::generate_equality (ostringstream & os, vector < string > vid, int N
 }
 
 bool
-CPLEXSolver::solve (string file_name, string fout)
+CPLEXSolver::run (string file_name, string fout)
 {
   ofstream file;
   file.open (file_name.c_str (), ios_base::app);
@@ -24,19 +24,21 @@
 #define IPET_SOLVER_H
 
 #include <vector>
+#include <map>
 #include <string>
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
 #include "SharedAttributes/SharedAttributes.h"
+#include "Specific/IPETAnalysis/LinearProgram.h"
 // #include <libxml/parser.h>  removed because it induces "memory leaks".
 
 using namespace std;
 class IPETAnalysis;
 
 /**
-   Encapsulation of ILP solver (lp_solve and CPLEX so far)
+   Encapsulation of ILP solver (lp_solve, CPLEX and the in-process simplex so far)
 */
 class Solver
 {
@@ -77,28 +79,46 @@ class Solver
   /** Generate an inequality: Sum(vids) = N */
   virtual void generate_equality (ostringstream & os, vector < string > vid, int N) = 0;
 
-  /** Solve the constraint system */
-  virtual bool solve (string file_name, string fout) = 0;
+  /** Solve the constraint system, wcet is the value of the objective function.
+      system is the text output by the generate functions (not used by the in-process solver). */
+  virtual bool solve (const string & system, string & wcet) = 0;
 
-  /** Parse solver output */
-  virtual bool parse_output (string file_name, string & wcet) = 0;
-
-  
   /** It assigns the frequency (freq) to the node (Basic block) associated with a variable (VariableName).
       The frequency is the result provided by a linear programming solver (cplex or lp_solve) for such a variable.
       The variable is a symbol n_NID_cCNB", where NID is the cCNB is the name of a context (currently it is not the contextual context used in other analysis).
       The names are generated in the method IPETAnalysis::generateNodeIds().
   */
   void setFrequencyAttribute(string VariableName, string freq);
+  void setFrequencyAttribute(string VariableName, unsigned long freq);
+};
+
+/**
+ * ILP solver run as an external command on the constraint system written in a temporary file
+ */
+class ExternalSolver:public Solver
+{
+ public:
+  ExternalSolver (IPETAnalysis * a):Solver (a)
+  { };
+  virtual ~ ExternalSolver ()
+  { };
+
+  bool solve (const string & system, string & wcet);
+
+  /** Run the solver on the constraint system file_name, its output is written in fout */
+  virtual bool run (string file_name, string fout) = 0;
+
+  /** Parse solver output */
+  virtual bool parse_output (string file_name, string & wcet) = 0;
 };
 
 /**
  * lp_solve ILP solver
  */
-class LpsolveSolver:public Solver
+class LpsolveSolver:public ExternalSolver
 {
  public:
-  LpsolveSolver (IPETAnalysis * a):Solver (a)
+  LpsolveSolver (IPETAnalysis * a):ExternalSolver (a)
   { };
 
   ~LpsolveSolver ()
@@ -109,17 +129,49 @@ class LpsolveSolver:public Solver
   void generate_inequality (ostringstream & os, vector < string > vid, int N);
   void generate_linear_inequality (ostringstream & os, vector < string > vid, vector < long >cst, int N);
   void generate_equality (ostringstream & os, vector < string > vid, int N);
-  bool solve (string file_name, string fout);
+  bool run (string file_name, string fout);
   bool parse_output (string file_name, string & wcet);
 };
 
+/**
+ * In-process ILP solver: the constraints are built directly as the sparse rows
+ * of a LinearProgram, solved without any subprocess or temporary file, and the
+ * frequencies are attached to the nodes from the solution.
+ */
+class SimplexSolver:public Solver
+{
+ private:
+  LinearProgram lp;
+  vector < string > names;	///< name of every variable of lp
+  map < string, unsigned int > variables;	///< variable of lp of every name
+
+  /** @return the variable of lp named id (created if needed) */
+  unsigned int getVariable (const string & id);
+  /** @return the row sum(ids) */
+  LinearProgram::SparseRow makeRow (const vector < string > &ids);
+
+ public:
+  SimplexSolver (IPETAnalysis * a):Solver (a)
+  { };
+
+  ~SimplexSolver ()
+  { };
+  void generate_objective_function (ostringstream & os, vector < string > ids, vector < long >cst);
+  void generate_declarations (ostringstream & os, vector < string > ids);
+  void generate_flow_constraint (ostringstream & os, vector < string > vid);
+  void generate_inequality (ostringstream & os, vector < string > vid, int N);
+  void generate_linear_inequality (ostringstream & os, vector < string > vid, vector < long >cst, int N);
+  void generate_equality (ostringstream & os, vector < string > vid, int N);
+  bool solve (const string & system, string & wcet);
+};
+
 /**
  * CPLEX ILP solver
  */
-class CPLEXSolver:public Solver
+class CPLEXSolver:public ExternalSolver
 {
  public:
-  CPLEXSolver (IPETAnalysis * a):Solver (a)
+  CPLEXSolver (IPETAnalysis * a):ExternalSolver (a)
   { };
 
   ~CPLEXSolver ()
@@ -130,7 +182,7 @@ class CPLEXSolver:public Solver
   void generate_inequality (ostringstream & os, vector < string > vid, int N);
   void generate_linear_inequality (ostringstream & os, vector < string > vid, vector < long >cst, int N);
   void generate_equality (ostringstream & os, vector < string > vid, int N);
-  bool solve (string file_name, string fout);
+  bool run (string file_name, string fout);
   bool parse_output (string file_name, string & wcet);
 };
 
@@ -0,0 +1,633 @@
+/* ---------------------------------------------------------------------
+
+   Copyright IRISA, 2003-2017
+
+   This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+   estimation.
+   APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+   Heptane is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Heptane is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details (COPYING.txt).
+
+   See CREDITS.txt for credits of authorship
+
+   ------------------------------------------------------------------------ */
+
+// Notations (see generateConstraints in IPETAnalysis.cc for the ILP system):
+//
+// - in a context, a node n of cost c (next executions) and b (additional cost of the
+//   first execution) contributes c * n + b * min(n, 1). When the context is executed
+//   at most once and n is out of loops, n <= 1 and the cost is simply max(wcet_first, wcet_next).
+//
+// - a loop of bound N is collapsed into a super node of the enclosing region (loop or function),
+//   whose value depends on its exit edge x. In the acyclic graph of its region (backedges removed,
+//   inner loops collapsed), let I be the longest iteration (head to backedge), P(x) the longest pass
+//   (head to x), and B the bounded nodes (all the nodes of the region but the head, the head only
+//   when it is alone, see generateConstraints_back_edges_loops). When a bounded node v belongs to
+//   every iteration, any solution of the relaxation is bounded per entry by
+//      UB(x) = max(P(x) + (N-1) * I, P_v(x) + N * I)      (P_v: longest pass avoiding v)
+//   while the integer solutions "P(x) + (N-1) iterations I" and "pass avoiding the bounded nodes of I
+//   + N iterations I" are feasible. When one of them reaches UB(x), it is the value of the exit.
+//
+// - the first execution costs are added afterwards: the result is kept when all the nodes having
+//   such a cost are executed by the longest path (the upper bound sum of b is then reached).
+
+#include <cassert>
+#include <algorithm>
+#include <sstream>
+
+#include "Generic/AnalysisHelper.h"
+#include "Specific/IPETAnalysis/IPETAnalysis.h"
+#include "Specific/IPETAnalysis/TreeIPET.h"
+#include "SharedAttributes/SharedAttributes.h"
+
+/** Kinds of the edges of a region */
+#define REGION_INTERNAL 0
+#define REGION_LATCH 1
+#define REGION_EXIT 2
+
+/** Acyclic graph of a region (loop or function): nodes of the region and super nodes of its inner loops */
+class RegionGraph
+{
+public:
+  struct Out
+  {
+    int target;			///< vertex (REGION_INTERNAL only)
+    Edge *edge;
+    long weight;
+    int kind;
+  };
+
+  struct Vertex
+  {
+    Node *node;			///< NULL for a super node
+    Loop *loop;
+    long cost;
+    bool sink;			///< node without successor
+    vector < Out > out;
+  };
+
+  vector < Vertex > vertices;
+  vector < int >order;		///< topological order of the vertices reachable from source
+  int source;
+
+  /** Longest paths from source, avoiding the excluded vertices (-1 when not reachable) */
+  vector < long >dist;
+  vector < pair < int, int > >pred;
+
+  /** Computes order. @return false if the region is not acyclic. */
+  bool sort ()
+  {
+    vector < int >indegree (vertices.size (), 0);
+    vector < bool > reached (vertices.size (), false);
+    vector < int >stack (1, source);
+    reached[source] = true;
+    while (!stack.empty ())
+      {
+	int v = stack.back ();
+	stack.pop_back ();
+	for (size_t e = 0; e < vertices[v].out.size (); e++)
+	  {
+	    const Out & o = vertices[v].out[e];
+	    if (o.kind != REGION_INTERNAL) continue;
+	    indegree[o.target]++;
+	    if (!reached[o.target])
+	      {
+		reached[o.target] = true;
+		stack.push_back (o.target);
+	      }
+	  }
+      }
+    unsigned int nbReached = count (reached.begin (), reached.end (), true);
+    order.clear ();
+    stack.assign (1, source);
+    while (!stack.empty ())
+      {
+	int v = stack.back ();
+	stack.pop_back ();
+	order.push_back (v);
+	for (size_t e = 0; e < vertices[v].out.size (); e++)
+	  {
+	    const Out & o = vertices[v].out[e];
+	    if (o.kind == REGION_INTERNAL && --indegree[o.target] == 0) stack.push_back (o.target);
+	  }
+      }
+    return order.size () == nbReached;
+  }
+
+  void longest (const vector < bool > &excluded)
+  {
+    dist.assign (vertices.size (), -1);
+    pred.assign (vertices.size (), make_pair (-1, -1));
+    if (excluded[source]) return;
+    dist[source] = vertices[source].cost;
+    for (size_t i = 0; i < order.size (); i++)
+      {
+	int v = order[i];
+	if (dist[v] < 0) continue;
+	for (size_t e = 0; e < vertices[v].out.size (); e++)
+	  {
+	    const Out & o = vertices[v].out[e];
+	    if (o.kind != REGION_INTERNAL || excluded[o.target]) continue;
+	    long d = dist[v] + o.weight + vertices[o.target].cost;
+	    if (d > dist[o.target])
+	      {
+		dist[o.target] = d;
+		pred[o.target] = make_pair (v, (int) e);
+	      }
+	  }
+      }
+  }
+
+  /** @return the longest path value from source to the edge e of v (to v itself when e < 0), -1 if none */
+  long value (int v, int e) const
+  {
+    if (dist[v] < 0) return -1;
+    return (e < 0) ? dist[v] : dist[v] + vertices[v].out[e].weight;
+  }
+
+  /** @return the longest path value from source to one of the latches (-1 if none), latch is set to its index */
+  long longestIteration (const vector < pair < int, int > >&latches, int &latch) const
+  {
+    long best = -1;
+    latch = -1;
+    for (size_t i = 0; i < latches.size (); i++)
+      {
+	long d = value (latches[i].first, latches[i].second);
+	if (d > best)
+	  {
+	    best = d;
+	    latch = i;
+	  }
+      }
+    return best;
+  }
+
+  /** Longest path from source to the edge e of v (to v itself when e < 0) */
+  template < typename S > void path (int v, int e, vector < S > &steps) const
+  {
+    vector < S > reversed;
+    while (v >= 0)
+      {
+	S s;
+	s.node = vertices[v].node;
+	s.loop = vertices[v].loop;
+	s.exit = (e >= 0 && s.loop != NULL) ? vertices[v].out[e].edge : NULL;
+	reversed.push_back (s);
+	e = pred[v].second;
+	v = pred[v].first;
+      }
+    steps.assign (reversed.rbegin (), reversed.rend ());
+  }
+};
+
+TreeIPET::TreeIPET (IPETAnalysis * a, bool fn):analysis (a), firstNext (fn), nbLoops (0)
+{
+}
+
+bool
+TreeIPET::buildLoops (Cfg * c)
+{
+  CfgLoops & cl = cfgLoops[c];
+  cl.loops = c->GetAllLoops ();
+  // Inner loops are strictly included in their enclosing loops
+  vector < pair < size_t, Loop * > >sized;
+  for (size_t l = 0; l < cl.loops.size (); l++)
+    sized.push_back (make_pair (cl.loops[l]->GetAllNodes ().size (), cl.loops[l]));
+  sort (sized.begin (), sized.end ());
+  for (size_t l = 0; l < sized.size (); l++)
+    cl.loops[l] = sized[l].second;
+
+  for (size_t l = 0; l < cl.loops.size (); l++)
+    {
+      Loop *loop = cl.loops[l];
+      cl.parent[loop] = NULL;
+      for (size_t o = l + 1; o < cl.loops.size (); o++)
+	{
+	  if (cl.loops[o]->FindInLoop (loop->GetHead ()) && cl.loops[o]->GetAllNodes ().size () > loop->GetAllNodes ().size ())
+	    {
+	      cl.parent[loop] = cl.loops[o];
+	      break;
+	    }
+	}
+      if (!loop->HasAttribute (MaxiterAttributeName))
+	return fail ("loop without bound in " + c->getStringName ());
+    }
+
+  vector < Node * >vn = c->GetAllNodes ();
+  for (size_t i = 0; i < vn.size (); i++)
+    {
+      cl.innermost[vn[i]] = NULL;
+      for (size_t l = 0; l < cl.loops.size (); l++)
+	{
+	  if (cl.loops[l]->FindInLoop (vn[i]))
+	    {
+	      cl.innermost[vn[i]] = cl.loops[l];
+	      break;
+	    }
+	}
+      // Every loop of a node is an ancestor of its innermost loop
+      for (size_t l = 0; l < cl.loops.size (); l++)
+	{
+	  if (!cl.loops[l]->FindInLoop (vn[i])) continue;
+	  Loop *ancestor = cl.innermost[vn[i]];
+	  while (ancestor != NULL && ancestor != cl.loops[l])
+	    ancestor = cl.parent[ancestor];
+	  if (ancestor == NULL)
+	    return fail ("loops not properly nested in " + c->getStringName ());
+	}
+    }
+  return true;
+}
+
+long
+TreeIPET::getCost (Node * n, Context * ctx)
+{
+  long cost = costs[make_pair (n, ctx)].first;
+  map < pair < Node *, Context * >, Context * >::iterator it = callees.find (make_pair (n, ctx));
+  if (it != callees.end ())
+    cost += instances[it->second].value;
+  return cost;
+}
+
+bool
+TreeIPET::solveRegion (Cfg * c, Context * ctx, Loop * l, Instance & instance)
+{
+  CfgLoops & cl = cfgLoops[c];
+  RegionGraph g;
+  map < Node *, int >nodeVertex;
+  map < Loop *, int >loopVertex;
+
+  // Vertices: the nodes of the region, and its inner loops
+  vector < Node * >vn = (l != NULL) ? l->GetAllNodes () : c->GetAllNodes ();
+  for (size_t i = 0; i < vn.size (); i++)
+    {
+      Node *n = vn[i];
+      if (n->isIsolatedNopNode ()) continue;
+      RegionGraph::Vertex v;
+      v.node = NULL;
+      v.loop = NULL;
+      v.cost = 0;
+      v.sink = false;
+      Loop *inner = cl.innermost[n];
+      if (inner == l)
+	{
+	  v.node = n;
+	  v.cost = getCost (n, ctx);
+	  v.sink = c->GetOutgoingEdges (n).empty ();
+	  nodeVertex[n] = g.vertices.size ();
+	  g.vertices.push_back (v);
+	  continue;
+	}
+      while (cl.parent[inner] != l)
+	inner = cl.parent[inner];
+      if (loopVertex.find (inner) == loopVertex.end ())
+	{
+	  v.loop = inner;
+	  loopVertex[inner] = g.vertices.size ();
+	  g.vertices.push_back (v);
+	}
+    }
+
+  // Edges, from the CFG edges of the nodes and the feasible exits of the inner loops
+  for (size_t iv = 0; iv < g.vertices.size (); iv++)
+    {
+      RegionGraph::Vertex & v = g.vertices[iv];
+      vector < pair < Edge *, long > >edges;
+      if (v.node != NULL)
+	{
+	  if (v.sink && l != NULL)
+	    return fail ("end node in a loop of " + c->getStringName ());
+	  vector < Edge * >out = c->GetOutgoingEdges (v.node);
+	  for (size_t e = 0; e < out.size (); e++)
+	    edges.push_back (make_pair (out[e], 0L));
+	}
+      else
+	{
+	  LoopSolution & ls = instance.loops[v.loop];
+	  for (map < Edge *, LoopExit >::iterator it = ls.exits.begin (); it != ls.exits.end (); ++it)
+	    if (it->second.value >= 0)
+	      edges.push_back (make_pair (it->first, it->second.value));
+	}
+
+      for (size_t e = 0; e < edges.size (); e++)
+	{
+	  Node *t = c->GetTargetNode (edges[e].first);
+	  RegionGraph::Out o;
+	  o.edge = edges[e].first;
+	  o.weight = edges[e].second;
+	  o.target = -1;
+	  if (l != NULL && !l->FindInLoop (t)) o.kind = REGION_EXIT;
+	  else if (l != NULL && t == l->GetHead ()) o.kind = REGION_LATCH;
+	  else
+	    {
+	      o.kind = REGION_INTERNAL;
+	      map < Node *, int >::iterator itn = nodeVertex.find (t);
+	      if (itn != nodeVertex.end ()) o.target = itn->second;
+	      else
+		{
+		  Loop *inner = cl.innermost[t];
+		  while (inner != NULL && cl.parent[inner] != l)
+		    inner = cl.parent[inner];
+		  if (inner == NULL || inner->GetHead () != t)
+		    return fail ("irreducible control flow in " + c->getStringName ());
+		  o.target = loopVertex[inner];
+		}
+	    }
+	  v.out.push_back (o);
+	}
+    }
+
+  Node *source = (l != NULL) ? l->GetHead () : c->GetStartNode ();
+  if (nodeVertex.find (source) == nodeVertex.end ())
+    return fail ("loops sharing their head in " + c->getStringName ());
+  g.source = nodeVertex[source];
+  if (!g.sort ())
+    return fail ("irreducible control flow in " + c->getStringName ());
+
+  vector < bool > none (g.vertices.size (), false);
+  if (l == NULL)
+    {
+      // Function: longest path from the start node to an end node
+      g.longest (none);
+      int best = -1;
+      for (size_t iv = 0; iv < g.vertices.size (); iv++)
+	if (g.vertices[iv].sink && g.dist[iv] >= 0 && (best < 0 || g.dist[iv] > g.dist[best]))
+	  best = iv;
+      if (best < 0)
+	return fail ("no path to the end of " + c->getStringName ());
+      instance.value = g.dist[best];
+      g.path (best, -1, instance.path);
+      return true;
+    }
+
+  // Loop
+  LoopSolution & ls = instance.loops[l];
+  SerialisableIntegerAttribute bound = (SerialisableIntegerAttribute &) l->GetAttribute (MaxiterAttributeName);
+  long maxiter = max (0, bound.GetValue ());
+  vector < Node * >notNested = l->GetAllNodesNotNested ();
+  vector < bool > bounded (g.vertices.size (), false);
+  for (size_t iv = 0; iv < g.vertices.size (); iv++)
+    if (g.vertices[iv].node != NULL)
+      bounded[iv] = (g.vertices[iv].node != source || notNested.size () == 1);
+
+  vector < pair < int, int > >latches, exits;
+  for (size_t iv = 0; iv < g.vertices.size (); iv++)
+    for (size_t e = 0; e < g.vertices[iv].out.size (); e++)
+      {
+	if (g.vertices[iv].out[e].kind == REGION_LATCH) latches.push_back (make_pair (iv, e));
+	if (g.vertices[iv].out[e].kind == REGION_EXIT) exits.push_back (make_pair (iv, e));
+      }
+
+  int latch;
+  if (maxiter == 0)
+    {
+      // No iteration: the passes avoid the bounded nodes
+      g.longest (bounded);
+      if (g.longestIteration (latches, latch) >= 0)
+	return fail ("unbounded iterations in a loop of " + c->getStringName ());
+      for (size_t i = 0; i < exits.size (); i++)
+	{
+	  LoopExit & le = ls.exits[g.vertices[exits[i].first].out[exits[i].second].edge];
+	  le.value = g.value (exits[i].first, exits[i].second);
+	  le.k = 0;
+	  if (le.value >= 0) g.path (exits[i].first, exits[i].second, le.pass);
+	}
+      return true;
+    }
+
+  g.longest (none);
+  long iteration = g.longestIteration (latches, latch);
+  vector < long >pass (exits.size ());
+  for (size_t i = 0; i < exits.size (); i++)
+    {
+      LoopExit & le = ls.exits[g.vertices[exits[i].first].out[exits[i].second].edge];
+      le.value = pass[i] = g.value (exits[i].first, exits[i].second);
+      le.k = (iteration >= 0) ? maxiter - 1 : 0;
+      if (le.value >= 0)
+	{
+	  g.path (exits[i].first, exits[i].second, le.pass);
+	  le.value += le.k * max (iteration, 0L);
+	}
+    }
+  if (iteration < 0) return true;	// no iteration can be made
+  g.path (latches[latch].first, latches[latch].second, ls.iteration);
+
+  // Bounded nodes of the longest iteration
+  vector < bool > boundedIteration (g.vertices.size (), false);
+  vector < int >candidates;
+  for (size_t s = 0; s < ls.iteration.size (); s++)
+    {
+      if (ls.iteration[s].node == NULL) continue;
+      int iv = nodeVertex[ls.iteration[s].node];
+      if (!bounded[iv]) continue;
+      boundedIteration[iv] = true;
+      candidates.push_back (iv);
+    }
+
+  // Lower bounds: passes avoiding the bounded nodes of the longest iteration, then N iterations
+  g.longest (boundedIteration);
+  for (size_t i = 0; i < exits.size (); i++)
+    {
+      long d = g.value (exits[i].first, exits[i].second);
+      LoopExit & le = ls.exits[g.vertices[exits[i].first].out[exits[i].second].edge];
+      if (d >= 0 && d + maxiter * iteration > le.value)
+	{
+	  le.value = d + maxiter * iteration;
+	  le.k = maxiter;
+	  g.path (exits[i].first, exits[i].second, le.pass);
+	}
+    }
+
+  // Upper bounds, for the bounded nodes common to all the iterations
+  vector < long >upper (exits.size (), -1);
+  bool cut = false;
+  for (size_t ic = 0; ic < candidates.size (); ic++)
+    {
+      vector < bool > excluded (g.vertices.size (), false);
+      excluded[candidates[ic]] = true;
+      g.longest (excluded);
+      int other;
+      if (g.longestIteration (latches, other) >= 0) continue;
+      cut = true;
+      for (size_t i = 0; i < exits.size (); i++)
+	{
+	  if (pass[i] < 0) continue;
+	  long ub = pass[i] + (maxiter - 1) * iteration;
+	  long d = g.value (exits[i].first, exits[i].second);
+	  if (d >= 0) ub = max (ub, d + maxiter * iteration);
+	  if (upper[i] < 0 || ub < upper[i]) upper[i] = ub;
+	}
+    }
+  if (!cut)
+    return fail ("no bounded node common to all the iterations of a loop of " + c->getStringName ());
+
+  for (size_t i = 0; i < exits.size (); i++)
+    {
+      LoopExit & le = ls.exits[g.vertices[exits[i].first].out[exits[i].second].edge];
+      if (le.value != upper[i])
+	return fail ("loop bound not certified in " + c->getStringName ());
+    }
+  return true;
+}
+
+bool
+TreeIPET::solveInstance (Context * ctx)
+{
+  if (instances.find (ctx) != instances.end ()) return true;
+  Cfg *c = ctx->getCurrentFunction ();
+  if (cfgLoops.find (c) == cfgLoops.end () && !buildLoops (c)) return false;
+  CfgLoops & cl = cfgLoops[c];
+  string ctxName = ctx->getStringId ();
+
+  vector < Node * >vn = c->GetAllNodes ();
+  for (size_t i = 0; i < vn.size (); i++)
+    {
+      Node *n = vn[i];
+      if (n->isIsolatedNopNode ()) continue;
+      string first = AnalysisHelper::mkContextAttrName (InternalAttributeWCETfirst, ctxName);
+      string next = AnalysisHelper::mkContextAttrName (InternalAttributeWCETnext, ctxName);
+      if (!n->HasAttribute (first) || (firstNext && !n->HasAttribute (next)))
+	return fail ("missing node cost in " + c->getStringName ());
+      long wf = ((NonSerialisableIntegerAttribute &) n->GetAttribute (first)).GetValue ();
+      long wn = firstNext ? ((NonSerialisableIntegerAttribute &) n->GetAttribute (next)).GetValue () : wf;
+      if (wf < 0 || wn < 0)
+	return fail ("negative node cost in " + c->getStringName ());
+      bool single = once[ctx] && cl.innermost[n] == NULL;
+      if (!firstNext || single) costs[make_pair (n, ctx)] = make_pair (max (wf, wn), 0L);
+      else costs[make_pair (n, ctx)] = make_pair (wn, max (wf - wn, 0L));
+
+      map < pair < Node *, Context * >, Context * >::iterator it = callees.find (make_pair (n, ctx));
+      if (it != callees.end ())
+	{
+	  once[it->second] = single;
+	  if (!solveInstance (it->second)) return false;
+	}
+    }
+
+  Instance & instance = instances[ctx];
+  instance.value = -1;
+  for (size_t l = 0; l < cl.loops.size (); l++)
+    {
+      if (!solveRegion (c, ctx, cl.loops[l], instance)) return false;
+      nbLoops++;
+    }
+  return solveRegion (c, ctx, NULL, instance);
+}
+
+void
+TreeIPET::expand (const vector < Step > &path, Context * ctx, long m, map < pair < Node *, Context * >, long >&freq, map < Context *, long >&calls)
+{
+  for (size_t s = 0; s < path.size (); s++)
+    {
+      const Step & step = path[s];
+      if (step.node != NULL)
+	{
+	  freq[make_pair (step.node, ctx)] += m;
+	  map < pair < Node *, Context * >, Context * >::iterator it = callees.find (make_pair (step.node, ctx));
+	  if (it != callees.end ()) calls[it->second] += m;
+	  continue;
+	}
+      LoopSolution & ls = instances[ctx].loops[step.loop];
+      LoopExit & le = ls.exits[step.exit];
+      expand (le.pass, ctx, m, freq, calls);
+      if (le.k > 0) expand (ls.iteration, ctx, m * le.k, freq, calls);
+    }
+}
+
+bool
+TreeIPET::solve (string & wcet)
+{
+  Program *p = analysis->p;
+  CallGraph *call_graph = analysis->call_graph;
+  reason = "";
+  nbLoops = 0;
+  cfgLoops.clear ();
+  callees.clear ();
+  once.clear ();
+  instances.clear ();
+  costs.clear ();
+
+  // Structural checks and call sites (see generateConstraints and generateCallConstraints)
+  vector < Cfg * >lcfg = p->GetAllCfgs ();
+  for (size_t ic = 0; ic < lcfg.size (); ic++)
+    {
+      Cfg *c = lcfg[ic];
+      if (call_graph->isDeadCode (c) || c->IsExternal ()) continue;
+      vector < Node * >vn = c->GetAllNodes ();
+      for (size_t i = 0; i < vn.size (); i++)
+	{
+	  if (vn[i]->isIsolatedNopNode ()) continue;
+	  bool start = (vn[i] == c->GetStartNode ());
+	  if (start != c->GetIncomingEdges (vn[i]).empty ())
+	    return fail (start ? "start node in a loop in " + c->getStringName () : "unreachable node in " + c->getStringName ());
+	}
+      const ContextList & contexts = (ContextList &) c->GetAttribute (ContextListAttributeName);
+      for (size_t i = 0; i < contexts.size (); i++)
+	if (contexts[i]->getCallerNode () != NULL)
+	  callees[make_pair (contexts[i]->getCallerNode (), contexts[i]->getCallerContext ())] = contexts[i];
+    }
+
+  Cfg *entry = analysis->p->GetEntryPoint ();
+  const ContextList & entryContexts = (ContextList &) entry->GetAttribute (ContextListAttributeName);
+  Context *root = NULL;
+  for (size_t i = 0; i < entryContexts.size (); i++)
+    if (entryContexts[i]->getCallerNode () == NULL) root = entryContexts[i];
+  if (root == NULL || root->getStringId () != "0")
+    return fail ("no root context");
+
+  once[root] = true;
+  if (!solveInstance (root)) return false;
+
+  // Frequencies, from the root context to the callees
+  map < pair < Node *, Context * >, long >freq;
+  map < Context *, long >calls;
+  vector < pair < unsigned int, Context * > >depths;
+  for (map < Context *, Instance >::iterator it = instances.begin (); it != instances.end (); ++it)
+    {
+      unsigned int depth = 0;
+      for (Context * c = it->first; c->getCallerContext () != NULL; c = c->getCallerContext ())
+	depth++;
+      depths.push_back (make_pair (depth, it->first));
+    }
+  sort (depths.begin (), depths.end ());
+  calls[root] = 1;
+  for (size_t i = 0; i < depths.size (); i++)
+    {
+      Context *ctx = depths[i].second;
+      if (calls[ctx] > 0) expand (instances[ctx].path, ctx, calls[ctx], freq, calls);
+    }
+
+  // First execution costs: certified when all of them are reached
+  long bonus = 0;
+  for (map < pair < Node *, Context * >, pair < long, long > >::iterator it = costs.begin (); it != costs.end (); ++it)
+    {
+      if (it->second.second == 0) continue;
+      if (freq[it->first] == 0)
+	return fail ("first execution cost not certified in " + it->first.first->GetCfg ()->getStringName ());
+      bonus += it->second.second;
+    }
+
+  ostringstream os;
+  os << instances[root].value + bonus;
+  wcet = os.str ();
+
+  if (analysis->generate_node_frequencies)
+    {
+      // Every node of every context, as the ILP solvers do
+      for (map < pair < Node *, Context * >, pair < long, long > >::iterator it = costs.begin (); it != costs.end (); ++it)
+	{
+	  string attr = FrequencyAttributeName + string ("_c") + it->first.second->getStringId ();
+	  SerialisableUnsignedLongAttribute frequency (freq[it->first]);
+	  it->first.first->SetAttribute (attr, frequency);
+	}
+    }
+  return true;
+}
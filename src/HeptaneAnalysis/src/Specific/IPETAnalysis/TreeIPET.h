@@ -0,0 +1,159 @@
+/* ---------------------------------------------------------------------
+
+   Copyright IRISA, 2003-2017
+
+   This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+   estimation.
+   APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+   Heptane is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Heptane is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details (COPYING.txt).
+
+   See CREDITS.txt for credits of authorship
+
+   ------------------------------------------------------------------------ */
+
+/**
+ * \brief Tree-based computation of the WCET, without ILP solver.
+ *
+ * When the IPET system only contains the flow, loop bound and call
+ * constraints (NOPIPELINE methods), the longest path is computed on the
+ * loop tree of every function and context: the loops are collapsed into
+ * super nodes from the innermost ones, the value of a loop for every exit
+ * edge being the longest exit path plus the loop bound times the longest
+ * iteration. The functions are collapsed into their call nodes.
+ *
+ * The result is only returned when it is proved equal to the optimum of
+ * the ILP system (upper bound of the relaxation reached by an integer
+ * solution), otherwise solve fails and the ILP solver has to be used
+ * (irreducible control flow, iterations that may avoid all the bounded
+ * nodes, first iteration costs not reached by the longest path, ...).
+ */
+#ifndef TREE_IPET_H
+#define TREE_IPET_H
+
+#include <vector>
+#include <map>
+#include <string>
+#include "Analysis.h"
+#include "Generic/CallGraph.h"
+#include "Generic/ContextHelper.h"
+
+using namespace std;
+class IPETAnalysis;
+
+/**
+ * \class TreeIPET
+ * \brief Longest path on the loop trees of the contexts of an IPETAnalysis.
+ */
+class TreeIPET
+{
+public:
+  /** Constructor. firstNext: the costs of the nodes are given for their first and next executions
+      (NOPIPELINE cache methods), otherwise by the first execution cost only. */
+  TreeIPET (IPETAnalysis * a, bool firstNext);
+
+  /** Computes the WCET (attaches the frequencies of the nodes when the analysis generates them).
+      @return false when the WCET cannot be computed without the ILP solver, see getReason. */
+  bool solve (string & wcet);
+
+  /** @return why solve failed. */
+  const string & getReason () const
+  {
+    return reason;
+  }
+
+  /** @return the number of function contexts and of loop contexts of the last successful solve. */
+  unsigned int getNbContexts () const
+  {
+    return instances.size ();
+  }
+  unsigned int getNbLoops () const
+  {
+    return nbLoops;
+  }
+
+private:
+  /** An element of a path: a node, or a loop left by its exit edge exit */
+  struct Step
+  {
+    Node *node;
+    Loop *loop;
+    Edge *exit;
+  };
+
+  /** Solution of a loop in a context for one of its exit edges: passes through pass, plus k iterations */
+  struct LoopExit
+  {
+    long value;
+    vector < Step > pass;
+    long k;
+  };
+
+  /** Solution of a loop in a context: exits (value < 0 when not feasible) and longest iteration */
+  struct LoopSolution
+  {
+    map < Edge *, LoopExit > exits;
+    vector < Step > iteration;
+  };
+
+  /** Solution of a function in a context: value and longest path, solutions of its loops */
+  struct Instance
+  {
+    long value;
+    vector < Step > path;
+    map < Loop *, LoopSolution > loops;
+  };
+
+  /** Loop structure of a Cfg (independent of the contexts) */
+  struct CfgLoops
+  {
+    vector < Loop * >loops;	///< innermost first
+    map < Loop *, Loop * >parent;	///< NULL for the outermost loops
+    map < Node *, Loop * >innermost;	///< NULL for the nodes out of loops
+  };
+
+  IPETAnalysis *analysis;
+  bool firstNext;
+  string reason;
+  unsigned int nbLoops;
+
+  map < Cfg *, CfgLoops > cfgLoops;
+  map < pair < Node *, Context * >, Context * >callees;	///< callee context of a call node in a context
+  map < Context *, bool >once;	///< true if the context is executed at most once
+  map < Context *, Instance > instances;
+
+  /** Per node and context cost of the next executions and additional cost of the first one */
+  map < pair < Node *, Context * >, pair < long, long > >costs;
+
+  /** Fills-in cfgLoops for c. @return false (and sets reason) if the loops are not properly nested. */
+  bool buildLoops (Cfg * c);
+
+  /** Computes the solution of the function of context ctx (and the ones of its callees) */
+  bool solveInstance (Context * ctx);
+
+  /** Computes the solution of loop l (or of the whole function when l is NULL) in instance,
+      the solutions of the inner loops being known. */
+  bool solveRegion (Cfg * c, Context * ctx, Loop * l, Instance & instance);
+
+  /** Adds m times the path to the frequencies (calls and loops are expanded). */
+  void expand (const vector < Step > &path, Context * ctx, long m, map < pair < Node *, Context * >, long >&freq, map < Context *, long >&calls);
+
+  /** @return the cost of the next executions of n in ctx (callee value included for calls) */
+  long getCost (Node * n, Context * ctx);
+
+  bool fail (const string & why)
+  {
+    reason = why;
+    return false;
+  }
+};
+
+#endif
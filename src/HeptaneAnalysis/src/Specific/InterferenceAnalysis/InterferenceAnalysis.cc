@@ -0,0 +1,483 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <sstream>
+#include "Specific/InterferenceAnalysis/InterferenceAnalysis.h"
+#include "Generic/AnalysisSession.h"
+#include "SharedAttributes/SharedAttributes.h"
+#include "FootprintFile.h"
+#include "arch.h"
+
+
+// ----------------------
+// SetFootprint class
+// ----------------------
+
+SetFootprint::SetFootprint ():nbsets (0), nbways (0), cachelinesize (0), unified (false)
+{ }
+
+void
+SetFootprint::init (const CacheParam * cp)
+{
+  nbsets = cp->nbsets;
+  nbways = cp->nbways;
+  cachelinesize = cp->cachelinesize;
+  unified = cp->unified;
+  hb.assign (nbsets, 0);
+  cb.assign (nbsets, 0);
+}
+
+unsigned int
+SetFootprint::computeSet (t_address addr) const
+{
+  return (addr / cachelinesize) % nbsets;
+}
+
+bool
+SetFootprint::sameGeometry (const SetFootprint & f) const
+{
+  return nbsets == f.nbsets && nbways == f.nbways && cachelinesize == f.cachelinesize;
+}
+
+void
+SetFootprint::addBlock (t_address addr, bool isHB, bool isCB, unsigned long weight)
+{
+  unsigned int s = computeSet (addr);
+  t_address line = addr - (addr % cachelinesize);
+  if (isHB)
+    {
+      hb[s] += weight;
+      hbBlocks.insert (line);
+    }
+  if (isCB)
+    {
+      cb[s] += weight;
+      cbBlocks.insert (line);
+    }
+}
+
+// ----------------------------------------------------------------
+// Footprint collection helpers
+// ----------------------------------------------------------------
+
+/** Weight of every node of c: 1 + sum of (maxiter - 1) over the loops of c containing the node. */
+static map < Node *, unsigned long >
+computeNodeWeights (Cfg * c)
+{
+  map < Node *, unsigned long >weights;
+  vector < Loop * >loops = c->GetAllLoops ();
+  for (size_t l = 0; l < loops.size (); l++)
+    {
+      if (!loops[l]->HasAttribute (MaxiterAttributeName)) continue;
+      long maxiter = ((SerialisableIntegerAttribute &) loops[l]->GetAttribute (MaxiterAttributeName)).GetValue ();
+      if (maxiter <= 1) continue;
+      vector < Node * >nodes = loops[l]->GetAllNodes ();
+      for (size_t n = 0; n < nodes.size (); n++)
+	weights[nodes[n]] += maxiter - 1;
+    }
+  return weights;
+}
+
+/** Adds to blocks the data cache blocks of the non-code ranges of an address attribute. */
+static void
+addDataBlocks (AddressAttribute & attr, int cachelinesize, set < t_address > &blocks)
+{
+  const vector < AddressInfo > &a = attr.getListInfo ();
+  for (size_t i = 0; i < a.size (); i++)
+    {
+      if (a[i].getSegment () == "code") continue;
+      const AddressRanges & ranges = a[i].getRanges ();
+      for (size_t j = 0; j < ranges.size (); j++)
+	{
+	  unsigned int range = ranges[j].size;
+	  if (range == 0) continue;
+	  for (t_address n = 0; n < ranges[j].count; n++)
+	    {
+	      t_address from = ranges[j].base + n * ranges[j].stride;
+	      t_address ifrom = from - (from % cachelinesize);
+	      t_address ito = (from + range - 1) - ((from + range - 1) % cachelinesize);
+	      for (t_address k = ifrom; k <= ito; k += cachelinesize)
+		blocks.insert (k);
+	    }
+	}
+    }
+}
+
+// ----------------------
+// InterferenceAnalysis class
+// ----------------------
+
+InterferenceAnalysis::InterferenceAnalysis (Program * p, string vtask, int vlevel, const map < int, vector < CacheParam * > >&vhierarchy_configuration,
+					    string vinterfering_file, string vevicted_file, string vstatistics_file, string vfootprint_file):
+Analysis (p), hierarchy_configuration (vhierarchy_configuration)
+{
+  task = vtask;
+  level = vlevel;
+  interfering_file = vinterfering_file;
+  evicted_file = vevicted_file;
+  statistics_file = vstatistics_file;
+  footprint_file = vfootprint_file;
+}
+
+const CacheParam *
+InterferenceAnalysis::getCache (const map < int, vector < CacheParam * > >&hierarchy_configuration, t_cache_type cache_type, int level)
+{
+  map < int, vector < CacheParam * > >::const_iterator it = hierarchy_configuration.find (level);
+  if (it == hierarchy_configuration.end ()) return NULL;
+  for (size_t i = 0; i < it->second.size (); i++)
+    if (it->second[i]->type == cache_type) return it->second[i];
+  return NULL;
+}
+
+// ----------------------------------------------------------------
+// Checks if all required attributes are in the CFG
+// Here, at least one instruction must hold a CHMC attribute of the
+// analysed level (the cache analyses of that level have been applied).
+// ----------------------------------------------------------------
+static bool
+HasCHMCAttribute (Cfg * c, Node * n, void *param)
+{
+  string prefix = *(string *) param;
+  const vector < Instruction * >&vi = n->GetAsm ();
+  for (size_t i = 0; i < vi.size (); i++)
+    {
+      vector < string > names = vi[i]->getAttributeList ();
+      for (size_t a = 0; a < names.size (); a++)
+	if (names[a].compare (0, prefix.size (), prefix) == 0) return false;	// found
+    }
+  return true;
+}
+
+bool
+InterferenceAnalysis::CheckInputAttributes ()
+{
+  string prefix = string (CHMCAttributeName) + "L" + to_string (level);
+  if (AnalysisHelper::applyToAllNodesRecursive (p, HasCHMCAttribute, &prefix))
+    {
+      Logger::addFatal ("InterferenceAnalysis: no " + prefix + " attribute found, the cache analyses of level " + to_string (level) + " should be applied first");
+    }
+  return true;
+}
+
+// ----------------------------------------------------------------
+// Collects the footprint of a program in a single scan of all its
+// instructions. Every attribute whose name starts with a CHMC or CAC
+// prefix is counted, contextual or not, so that the scan also applies
+// to a program unserialised from a result file.
+// An instruction is a hit (resp. conflicting) block as soon as one of
+// its contexts is classified AH/FM (resp. A/U/UN).
+// ----------------------------------------------------------------
+void
+InterferenceAnalysis::collectFootprint (Program * prog, int vlevel, CacheFootprint & fp)
+{
+  string chmcCode = CHMCAttributeNameCode (vlevel), chmcData = CHMCAttributeNameData (vlevel);
+  string cacCode = CACAttributeNameCode (vlevel), cacData = CACAttributeNameData (vlevel);
+  string addrContextPrefix = string (AddressAttributeName) + "#";
+
+  fp.level = vlevel;
+  const vector < Cfg * >&cfgs = prog->GetAllCfgs ();
+  for (size_t c = 0; c < cfgs.size (); c++)
+    {
+      if (cfgs[c]->IsExternal ()) continue;
+      map < Node *, unsigned long >weights = computeNodeWeights (cfgs[c]);
+      const vector < Node * >&nodes = cfgs[c]->GetAllNodes ();
+      for (size_t n = 0; n < nodes.size (); n++)
+	{
+	  unsigned long weight = 1 + weights[nodes[n]];
+	  const vector < Instruction * >&vi = nodes[n]->GetAsm ();
+	  for (size_t i = 0; i < vi.size (); i++)
+	    {
+	      Instruction *instr = vi[i];
+	      bool codeHB = false, codeCB = false, dataHB = false, dataCB = false;
+	      vector < string > contextualAddresses;
+
+	      vector < string > names = instr->getAttributeList ();
+	      for (size_t a = 0; a < names.size (); a++)
+		{
+		  const string & name = names[a];
+		  if (name.compare (0, addrContextPrefix.size (), addrContextPrefix) == 0)
+		    {
+		      contextualAddresses.push_back (name);
+		      continue;
+		    }
+		  bool isCHMC = name.compare (0, strlen (CHMCAttributeName) + 1, string (CHMCAttributeName) + "L") == 0;
+		  bool isCAC = name.compare (0, strlen (CACAttributeName) + 1, string (CACAttributeName) + "L") == 0;
+		  if (!isCHMC && !isCAC) continue;
+
+		  string base = name.substr (0, name.find ('#'));
+		  string value = ((SerialisableStringAttribute &) instr->GetAttribute (name)).GetValue ();
+		  fp.categories[base][value]++;
+
+		  bool hit = (value == "AH" || value == "FM");
+		  bool conflict = (value == "A" || value == "U" || value == "UN");
+		  if (base == chmcCode && hit) codeHB = true;
+		  else if (base == chmcData && hit) dataHB = true;
+		  else if (base == cacCode && conflict) codeCB = true;
+		  else if (base == cacData && conflict) dataCB = true;
+		}
+
+	      if ((codeHB || codeCB) && instr->HasAttribute (AddressAttributeName))
+		{
+		  long addr = ((AddressAttribute &) instr->GetAttribute (AddressAttributeName)).getCodeAddress ();
+		  if (addr != -1) fp.code.addBlock (addr, codeHB, codeCB, weight);
+		}
+
+	      if ((dataHB || dataCB) && AnalysisHelper::getDecoded (instr).load)
+		{
+		  // Stack accesses are contextual, the others are not (see DCacheAnalysis::getDataAddress).
+		  set < t_address > blocks;
+		  if (contextualAddresses.empty ())
+		    contextualAddresses.push_back (AddressAttributeName);
+		  for (size_t a = 0; a < contextualAddresses.size (); a++)
+		    if (instr->HasAttribute (contextualAddresses[a]))
+		      addDataBlocks ((AddressAttribute &) instr->GetAttribute (contextualAddresses[a]), fp.data.cachelinesize, blocks);
+		  for (set < t_address >::iterator it = blocks.begin (); it != blocks.end (); ++it)
+		    fp.data.addBlock (*it, dataHB, dataCB, weight);
+		}
+	    }
+	}
+    }
+}
+
+// ----------------------------------------------------------------
+// One linear pass over the cache sets:
+// set s contributes min(hb[s], cb[s]) when hb[s] + cb[s] > nbways
+// ----------------------------------------------------------------
+void
+InterferenceAnalysis::computeInterference (const vector < unsigned long >&hb, const vector < unsigned long >&cb, int nbways, InterferenceResult & res)
+{
+  assert (hb.size () == cb.size ());
+  res.evicted = 0;
+  res.conflicts.clear ();
+  for (size_t s = 0; s < hb.size (); s++)
+    {
+      if (hb[s] == 0 || cb[s] == 0 || hb[s] + cb[s] <= (unsigned long) nbways) continue;
+      unsigned long evicted = min (hb[s], cb[s]);
+      res.conflicts[s] = evicted;
+      res.evicted += evicted;
+    }
+}
+
+const vector < CacheFootprint > &
+InterferenceAnalysis::getFootprints ()
+{
+  return session->getFootprints ();
+}
+
+static void
+printConflicts (ostream & os, const string & title, const InterferenceResult & res)
+{
+  os << "******The conflict cache set of " << title << " Interference*****" << endl;
+  for (map < int, unsigned long >::const_iterator it = res.conflicts.begin (); it != res.conflicts.end (); ++it)
+    os << "Conflict Set: " << it->first << " Evicted Items: " << it->second << endl;
+}
+
+void
+InterferenceAnalysis::reportInterference (const CacheFootprint & fp, const CacheFootprint & other)
+{
+  InterferenceResult resI, resD, resU;
+
+  if (!fp.code.sameGeometry (other.code) || !fp.data.sameGeometry (other.data))
+    {
+      Logger::addWarning ("InterferenceAnalysis: task " + other.task + " was analysed with a different cache geometry, skipped");
+      return;
+    }
+  computeInterference (fp.code.hb, other.code.cb, fp.code.nbways, resI);
+  computeInterference (fp.data.hb, other.data.cb, fp.data.nbways, resD);
+
+  // Unified cache (unified="on" in the cache configuration): code and data blocks share the same sets.
+  bool unified = fp.code.unified;
+  if (unified)
+    {
+      vector < unsigned long >hbU (fp.code.hb), cbU (other.code.cb);
+      for (int s = 0; s < fp.code.nbsets; s++)
+	{
+	  hbU[s] += fp.data.hb[s];
+	  cbU[s] += other.data.cb[s];
+	}
+      computeInterference (hbU, cbU, fp.code.nbways, resU);
+    }
+
+  // Report on the output of the logger (the one of the session in batch mode)
+  ostringstream report;
+  report << endl << "*** Cache interference on L" << level << " of task " << fp.task << " by task " << other.task << endl;
+  printConflicts (report, "Instruction cache", resI);
+  printConflicts (report, "Data cache", resD);
+  report << "The instruction interference is " << resI.evicted << endl;
+  report << "The Data Cache Interference is " << resD.evicted << endl;
+  report << "Interfered by program " << other.task << " , The times of the evicted item is " << resI.evicted + resD.evicted;
+  if (unified)
+    {
+      report << endl;
+      printConflicts (report, "Unified cache", resU);
+      report << "Unified cache: interfered by program " << other.task << " , The times of the evicted item is " << resU.evicted;
+    }
+  Logger::print (report.str ());
+
+  if (evicted_file != "")
+    {
+      ofstream os (evicted_file.c_str (), ios::app);
+      if (!os.is_open ()) Logger::addFatal ("InterferenceAnalysis: unable to open " + evicted_file);
+      os << resI.evicted << "\t" << resD.evicted << "\t" << resI.evicted + resD.evicted << "\t";
+      if (unified) os << resU.evicted; else os << "-";
+      os << endl;
+    }
+}
+
+static void
+printCategories (ostream & os, const CacheFootprint & fp, const string & attrName, const char *values[], size_t nbValues)
+{
+  map < string, map < string, unsigned long > >::const_iterator it = fp.categories.find (attrName);
+  for (size_t v = 0; v < nbValues; v++)
+    {
+      unsigned long count = 0;
+      if (it != fp.categories.end () && it->second.count (values[v]) != 0) count = it->second.find (values[v])->second;
+      os << values[v] << " \t" << count << "\t";
+    }
+  os << endl;
+}
+
+void
+InterferenceAnalysis::reportStatistics (const CacheFootprint & fp)
+{
+  static const char *cacValues[] = { "A", "U", "UN", "N" };
+  static const char *chmcValues[] = { "AH", "FM", "NC", "AM" };
+
+  ofstream os (statistics_file.c_str (), ios::app);
+  if (!os.is_open ()) Logger::addFatal ("InterferenceAnalysis: unable to open " + statistics_file);
+
+  os << "Task " << fp.task << endl;
+  os << "Instruction cache state" << endl;
+  for (int l = 1; l <= level; l++)
+    {
+      printCategories (os, fp, CACAttributeNameCode (l), cacValues, 4);
+      printCategories (os, fp, CHMCAttributeNameCode (l), chmcValues, 4);
+    }
+  os << endl << "Data cache state" << endl;
+  for (int l = 1; l <= level; l++)
+    {
+      printCategories (os, fp, CACAttributeNameData (l), cacValues, 4);
+      printCategories (os, fp, CHMCAttributeNameData (l), chmcValues, 4);
+    }
+}
+
+static void
+addSection (vector < FootprintSection > &sections, int level, t_footprint_kind kind, const SetFootprint & f)
+{
+  FootprintSection s;
+  s.level = level;
+  s.kind = kind;
+  s.nbsets = f.nbsets;
+  s.nbways = f.nbways;
+  s.cachelinesize = f.cachelinesize;
+  s.flags = f.unified ? FOOTPRINT_UNIFIED : 0;
+  s.hb.assign (f.hb.begin (), f.hb.end ());
+  s.cb.assign (f.cb.begin (), f.cb.end ());
+  s.hbBlocks.assign (f.hbBlocks.begin (), f.hbBlocks.end ());
+  s.cbBlocks.assign (f.cbBlocks.begin (), f.cbBlocks.end ());
+  sections.push_back (s);
+}
+
+void
+InterferenceAnalysis::saveFootprints (const CacheFootprint & fp)
+{
+  vector < FootprintSection > sections;
+  for (map < int, vector < CacheParam * > >::const_iterator it = hierarchy_configuration.begin (); it != hierarchy_configuration.end (); ++it)
+    {
+      int l = it->first;
+      if (l == level)
+	{
+	  addSection (sections, l, FOOTPRINT_CODE, fp.code);
+	  addSection (sections, l, FOOTPRINT_DATA, fp.data);
+	  continue;
+	}
+      const CacheParam *icache = getCache (hierarchy_configuration, ICACHE, l);
+      const CacheParam *dcache = getCache (hierarchy_configuration, DCACHE, l);
+      if (icache == NULL || dcache == NULL) continue;
+
+      // Levels whose cache analyses have not been applied have no CHMC attribute, and are skipped.
+      CacheFootprint lfp;
+      lfp.code.init (icache);
+      lfp.data.init (dcache);
+      collectFootprint (p, l, lfp);
+      if (lfp.categories.count (CHMCAttributeNameCode (l)) == 0 && lfp.categories.count (CHMCAttributeNameData (l)) == 0) continue;
+      addSection (sections, l, FOOTPRINT_CODE, lfp.code);
+      addSection (sections, l, FOOTPRINT_DATA, lfp.data);
+    }
+  if (!FootprintFile::write (footprint_file, task, sections))
+    Logger::addFatal ("InterferenceAnalysis: unable to write footprint file " + footprint_file);
+}
+
+// ----------------------------------------------
+// Performs the analysis
+// Returns true if successful, false otherwise
+// ----------------------------------------------
+bool
+InterferenceAnalysis::PerformAnalysis ()
+{
+  const CacheParam *icache = getCache (hierarchy_configuration, ICACHE, level);
+  const CacheParam *dcache = getCache (hierarchy_configuration, DCACHE, level);
+  assert (icache != NULL && dcache != NULL);
+
+  CacheFootprint fp;
+  fp.task = task;
+  fp.code.init (icache);
+  fp.data.init (dcache);
+  collectFootprint (p, level, fp);
+
+  if (interfering_file != "")
+    {
+      // Co-running task stored in a result file
+      Program *other = Program::unserialise_program_file (interfering_file);
+      CacheFootprint ofp;
+      ofp.task = interfering_file;
+      ofp.code.init (icache);
+      ofp.data.init (dcache);
+      collectFootprint (other, level, ofp);
+      delete other;
+      reportInterference (fp, ofp);
+    }
+  else
+    {
+      // Co-running tasks analysed before in the same run, in both directions
+      vector < CacheFootprint > &footprints = session->getFootprints ();
+      for (size_t t = 0; t < footprints.size (); t++)
+	{
+	  if (footprints[t].level != level || footprints[t].task == task) continue;
+	  reportInterference (fp, footprints[t]);
+	  reportInterference (footprints[t], fp);
+	}
+    }
+
+  if (statistics_file != "") reportStatistics (fp);
+  if (footprint_file != "") saveFootprints (fp);
+
+  session->getFootprints ().push_back (fp);
+  return true;
+}
+
+/* Remove all private attributes */
+void
+InterferenceAnalysis::RemovePrivateAttributes ()
+{ }
@@ -0,0 +1,159 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+
+#ifndef INTERFERENCE_ANALYSIS_H
+#define INTERFERENCE_ANALYSIS_H
+
+#include "Generic/Analysis.h"
+#include "Generic/Config.h"
+
+/**
+ * Footprint of a task on a single cache, as flat arrays indexed by cache set.
+ *
+ * hb[s] is the number of hit blocks (CHMC AH or FM) of the task mapped to set s,
+ * cb[s] the number of conflicting blocks (CAC A, U or UN) mapped to set s.
+ * Both counts are weighted by the bounds of the loops enclosing the accesses.
+ */
+class SetFootprint
+{
+public:
+  int nbsets, nbways, cachelinesize;
+  bool unified;			///< the cache is a side of a unified cache (see CacheParam::unified)
+  vector < unsigned long >hb;
+  vector < unsigned long >cb;
+  set < t_address > hbBlocks;	///< distinct hit blocks (cache line addresses)
+  set < t_address > cbBlocks;	///< distinct conflicting blocks (cache line addresses)
+
+  SetFootprint ();
+
+  /** Size the per-set arrays according to the cache geometry. */
+  void init (const CacheParam * cp);
+
+  /** Return the set where address addr is mapped. */
+  unsigned int computeSet (t_address addr) const;
+
+  /** Return true when both footprints describe caches of the same geometry. */
+  bool sameGeometry (const SetFootprint & f) const;
+
+  /** Account for an access to the cache line of addr, as hit and/or conflicting block. */
+  void addBlock (t_address addr, bool isHB, bool isCB, unsigned long weight);
+};
+
+/**
+ * Cache footprint of a task at a given cache level, for code and data,
+ * plus the number of CHMC/CAC classifications found per attribute name.
+ */
+class CacheFootprint
+{
+public:
+  string task;
+  int level;
+  SetFootprint code;
+  SetFootprint data;
+
+  /** categories[attribute name][value] = number of (contextual) attributes, e.g. categories["CHMCL2Code"]["AH"]. */
+    map < string, map < string, unsigned long > >categories;
+};
+
+/**
+ * Result of the interference of a task with a co-running task on one cache:
+ * conflicts[s] is the number of blocks of the task that may be evicted from set s.
+ */
+class InterferenceResult
+{
+public:
+  unsigned long evicted;
+  map < int, unsigned long >conflicts;
+  InterferenceResult ():evicted (0) {}
+};
+
+/**
+ * Inter-task cache interference analysis.
+ *
+ * Collects the HB/CB footprint of the analysed program from the CHMC and CAC
+ * attributes left by ICacheAnalysis/DCacheAnalysis and bounds the number of
+ * evictions it may suffer from the co-running tasks, for the instruction
+ * and data caches of a given level, and for the unified cache when the level
+ * is configured as unified (CacheParam::unified). A set s contributes
+ * min(hb[s], cb'[s]) evictions when hb[s] + cb'[s] exceeds the associativity.
+ *
+ * The co-running tasks are the ones analysed before in the same run (several
+ * ENTRYPOINT steps), or the one stored in an interfering result file.
+ *
+ * The footprints of all the analysed cache levels can also be saved in a
+ * binary footprint file (see FootprintFile.h), combined by HeptaneInterfere.
+ *
+ * Used in:
+ *  - GNUmakefile
+ *  - Generic/Config.h
+ *  - Generic/Config.cc
+ */
+class InterferenceAnalysis:public Analysis
+{
+public:
+
+  /** Constructor */
+  InterferenceAnalysis (Program * p, string task, int level, const map < int, vector < CacheParam * > >&hierarchy_configuration,
+			string interfering_file, string evicted_file, string statistics_file, string footprint_file);
+
+  /** Checks that the program has been analysed by the cache analyses of the specified level. */
+  bool CheckInputAttributes ();
+
+  /** Collects the footprint of the program and computes the interference with the co-running tasks. */
+  bool PerformAnalysis ();
+
+  /** Remove all private attributes */
+  void RemovePrivateAttributes ();
+
+  /** Collects the footprint of program prog at cache level vlevel in a single scan of its instructions. */
+  static void collectFootprint (Program * prog, int vlevel, CacheFootprint & fp);
+
+  /** Computes the evictions suffered by a task with hit blocks hb from a task with conflicting blocks cb. */
+  static void computeInterference (const vector < unsigned long >&hb, const vector < unsigned long >&cb, int nbways, InterferenceResult & res);
+
+  /** Footprints of the tasks already analysed in the current run (session). */
+  const vector < CacheFootprint > &getFootprints ();
+
+  /** Return the cache of the specified type at the specified level. NULL if no such cache exists.*/
+  static const CacheParam *getCache (const map < int, vector < CacheParam * > >&hierarchy_configuration, t_cache_type cache_type, int level);
+
+private:
+  string task;
+  int level;
+  const map < int, vector < CacheParam * > >&hierarchy_configuration;
+  string interfering_file;
+  string evicted_file;
+  string statistics_file;
+  string footprint_file;
+
+  /** Computes and reports the interference of task fp with co-running task other. */
+  void reportInterference (const CacheFootprint & fp, const CacheFootprint & other);
+
+  /** Appends the CHMC/CAC classification counts of fp to the statistics file. */
+  void reportStatistics (const CacheFootprint & fp);
+
+  /** Writes the footprints of the program for all the analysed cache levels to the footprint file,
+      fp being the (already collected) footprint of the current level. */
+  void saveFootprints (const CacheFootprint & fp);
+};
+
+#endif
@@ -36,9 +36,9 @@ bool ARMPipelineAnalysis::PerformAnalysis()
   return PipelineAnalysis::PerformAnalysis();
 }
 
-int ARMPipelineAnalysis::getLatency( const string codeInstr, bool BarrelShifterUsed)
+int ARMPipelineAnalysis::getLatency( const DecodedInstruction & decoded, bool BarrelShifterUsed)
 {
-  int lat = Arch::getLatency(codeInstr);
+  int lat = decoded.latency;
   if ( BarrelShifterUsed ) lat = lat + LATENCY_BARREL_SHIFTER;  // to be verified !!!
   return lat;
 }
@@ -46,44 +46,43 @@ int ARMPipelineAnalysis::getLatency( const string codeInstr, bool BarrelShifterU
 /**
  * Schedule the first instruction of a basic bloc.
  * 
- * \param inst instruction to insert in the pipeline
- * \param IP 
- * \param context context of the instruction
- * \param first first occurence of the instruction
+ * \param decoded instruction to insert in the pipeline
+ * \param fetchLatency fetch latency of the instruction (for its context and occurence)
+ * \param IP schedule of the previous instructions
  */
-void ARMPipelineAnalysis::scheduleFirstInst(Instruction & inst, vector < InstructionPipeline * >&IP, Context * context, bool first)
+void ARMPipelineAnalysis::scheduleFirstInst(const DecodedInstruction & decoded, unsigned int fetchLatency, PipelineSchedule & IP)
 {
   // ----------------------------------------------------------------------------------------------------
   // il faut tenir compte du barrel_shifter pour les instruction avec en second opereande un shift/rotate.
   // it is necessary to take into account the barrel_shifter for the instructions with in second opereande a shift / rotate.
   // ----------------------------------------------------------------------------------------------------
 
-  string codeInstr = inst.GetCode();
-  InstructionPipeline *instTmp = new InstructionPipeline(PIPELINEDEPTH);
+  assert(decoded.hasFormat);
+  InstructionPipeline & instTmp = IP.newInstruction(PIPELINEDEPTH, decoded);
   pipeStage *pipeStageTmp;
 
-  TRACE_PIPELINEANALYSIS(cout << " -- begin scheduleFirstInst() instr = " << codeInstr << endl);
-  unsigned int fetchAt = getFetchLatency(inst, context, first);
+  TRACE_PIPELINEANALYSIS(cout << " -- begin scheduleFirstInst() instr = " << decoded.code << endl);
+  unsigned int fetchAt = fetchLatency;
   //fetch stage
-  instTmp->insertInstruction(fetchAt);
+  instTmp.insertInstruction(fetchAt);
   //decode stage
-  instTmp->propagateInstruction(1);
+  instTmp.propagateInstruction(1);
 
   //execution stage 
-  vector < string > FU = Arch::getResourceFunctionalUnits(codeInstr);
-  int lat = getLatency(codeInstr, FU.size() > 1);
-  pipeStageTmp = instTmp->propagateInstruction(lat);
-  pipeStageTmp->FU = FU;
-  pipeStageTmp->in = Arch::getResourceInputs(codeInstr);
+  const vector < int > &FU = decoded.functionalUnitIds;
+  int lat = getLatency(decoded, FU.size() > 1);
+  pipeStageTmp = instTmp.propagateInstruction(lat);
+  pipeStageTmp->FU = &decoded.functionalUnitIds;
+  pipeStageTmp->in = &decoded.inputIds;
 
   // assert (pipeStageTmp->FU.size () == 1); Not for ARM; the "barrel shifter" may be required.
 
   //WB stage
-  pipeStageTmp = instTmp->propagateInstruction(1);
-  pipeStageTmp->out = Arch::getResourceOutputs(codeInstr);
+  pipeStageTmp = instTmp.propagateInstruction(1);
+  pipeStageTmp->out = &decoded.outputIds;
 
-  IP.push_back(instTmp);
-  TRACE_PIPELINEANALYSIS(instTmp->Print());
+  IP.commit();
+  TRACE_PIPELINEANALYSIS(instTmp.Print());
   TRACE_PIPELINEANALYSIS(cout << " -- end scheduleFirstInst " << endl);
 
 }
@@ -91,52 +90,43 @@ void ARMPipelineAnalysis::scheduleFirstInst(Instruction & inst, vector < Instruc
 /**
  * Schedule the first instruction of a basic bloc.
  * 
- * \param inst instruction to insert in the pipeline
- * \param IP 
- * \param context context of the instruction
- * \param first first occurence of the instruction
+ * \param decoded instruction to insert in the pipeline
+ * \param fetchLatency fetch latency of the instruction (for its context and occurence)
+ * \param IP schedule of the previous instructions
  */
-void ARMPipelineAnalysis::scheduleNextInst(Instruction & inst, vector < InstructionPipeline * >&IP, Context * context, bool first)
+void ARMPipelineAnalysis::scheduleNextInst(const DecodedInstruction & decoded, unsigned int fetchLatency, PipelineSchedule & IP)
 {
   // ----------------------------------------------------------------------------------------------------
   // il faut tenir compte du barrel_shifter pour les instruction avec en second opereande un shift/rotate.
   // it is necessary to take into account the barrel_shifter for the instructions with in second opereande a shift / rotate.
   // ----------------------------------------------------------------------------------------------------
 
-  string codeInstr = inst.GetCode();
-  InstructionPipeline *instTmp = new InstructionPipeline(PIPELINEDEPTH);
+  assert(decoded.hasFormat);
+  InstructionPipeline & instTmp = IP.newInstruction(PIPELINEDEPTH, decoded);
 
-  TRACE_PIPELINEANALYSIS(cout << " -- begin scheduleNextInst() instr = " << codeInstr << endl);
-  unsigned int fetchAt = IP[IP.size() - 1]->getPipeStage(0)->tick + getFetchLatency(inst, context, first);
+  TRACE_PIPELINEANALYSIS(cout << " -- begin scheduleNextInst() instr = " << decoded.code << endl);
+  unsigned int fetchAt = IP.last().getPipeStage(0)->tick + fetchLatency;
 
   //fetch stage
-  instTmp->insertInstruction(fetchAt);
+  instTmp.insertInstruction(fetchAt);
   //decode stage
-  instTmp->propagateInstruction(1);
+  instTmp.propagateInstruction(1);
 
   //check for dependencies
-  //goes backward through instructions and stops at the first dependency found
-  vector < string > inputs = Arch::getResourceInputs(codeInstr);
-  unsigned int i = IP.size() - 1;
-  unsigned int depTick = IP[i]->getDependencies(inputs);	// return the clock tick were the data needed by "inputs" are available or 0 if no dependencies
-  while (depTick == 0 && i > 0)
-    {
-      i--;
-      depTick = IP[i]->getDependencies(inputs);
-    }
+  //on the last instruction writing one of the inputs
+  unsigned int depTick = IP.getDependencies(decoded.inputIds);	// return the clock tick were the data needed by the inputs are available or 0 if no dependencies
 
   //check FU avaliability
-  vector < string > FUs = Arch::getResourceFunctionalUnits(codeInstr);
+  const vector < int > &FUs = decoded.functionalUnitIds;
   unsigned int FUTick = 0;
-  for (i = 0; i < IP.size(); i++)
-    for (unsigned int j = 0; j < FUs.size(); j++)
-      {
-	unsigned int t = IP[i]->checkAvaliability(FUs[j]);
-	if (t > FUTick)
-	  {
-	    FUTick = t;
-	  }
-      }
+  for (unsigned int j = 0; j < FUs.size(); j++)
+    {
+      unsigned int t = IP.checkAvaliability(FUs[j]);
+      if (t > FUTick)
+	{
+	  FUTick = t;
+	}
+    }
 
   //get the max of depTick FUTick and depTick
   int execLat = 0;
@@ -149,25 +139,25 @@ void ARMPipelineAnalysis::scheduleNextInst(Instruction & inst, vector < Instruct
     execLat = 0;
 
   //execution stage
-  pipeStage *pipeStageTmp = instTmp->propagateInstruction(execLat + 1);
-  pipeStageTmp->FU = FUs;
-  pipeStageTmp->in = Arch::getResourceInputs(codeInstr);
+  pipeStage *pipeStageTmp = instTmp.propagateInstruction(execLat + 1);
+  pipeStageTmp->FU = &FUs;
+  pipeStageTmp->in = &decoded.inputIds;
 
-  int lat = getLatency(codeInstr, FUs.size() > 1);
+  int lat = getLatency(decoded, FUs.size() > 1);
   if (lat <= 1)			//allow bypass
-    pipeStageTmp->out = Arch::getResourceOutputs(codeInstr);
-  //  else pipeStageTmp->FU = FUs; // already set
+    pipeStageTmp->out = &decoded.outputIds;
+  //  else pipeStageTmp->FU = &FUs; // already set
 
   //WB stage, do WB only after preceding inst WB
-  unsigned int WBAt = IP[IP.size() - 1]->getPipeStage(PIPELINEDEPTH - 1)->tick + 1;
+  unsigned int WBAt = IP.last().getPipeStage(PIPELINEDEPTH - 1)->tick + 1;
   int WBLat = WBAt - pipeStageTmp->tick;
   if (WBLat < 0)
     WBLat = 1;
-  pipeStageTmp = instTmp->propagateInstruction(WBLat);
-  pipeStageTmp->out = Arch::getResourceOutputs(codeInstr);
+  pipeStageTmp = instTmp.propagateInstruction(WBLat);
+  pipeStageTmp->out = &decoded.outputIds;
 
-  IP.push_back(instTmp);
-  TRACE_PIPELINEANALYSIS(instTmp->Print());
+  IP.commit();
+  TRACE_PIPELINEANALYSIS(instTmp.Print());
   TRACE_PIPELINEANALYSIS(cout << " -- end scheduleNextInst()" << endl);
 
 }
@@ -37,13 +37,13 @@ class ARMPipelineAnalysis:public PipelineAnalysis
  protected:
 
   /** Implementation of Pipeline::scheduleFirstInst() for ARM */
-  void scheduleFirstInst (Instruction & inst, vector < InstructionPipeline * >&IP, Context * context, bool first);
+  void scheduleFirstInst (const DecodedInstruction & decoded, unsigned int fetchLatency, PipelineSchedule & IP);
   /** Implementation of  Pipeline::scheduleNextInst() for ARM  */
-  void scheduleNextInst (Instruction & inst, vector < InstructionPipeline * >&IP, Context * context, bool first);
+  void scheduleNextInst (const DecodedInstruction & decoded, unsigned int fetchLatency, PipelineSchedule & IP);
 
  private:
   /** return the latency of the operand instruction(codeinstr), requiring the "barrel shifter" when BarrelShifterUsed. */
-  int getLatency( const string codeInstr , bool BarrelShifterUsed);
+  int getLatency( const DecodedInstruction & decoded , bool BarrelShifterUsed);
 
  public:
 
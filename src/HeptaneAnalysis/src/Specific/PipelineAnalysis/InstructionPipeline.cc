@@ -21,138 +21,117 @@ See CREDITS.txt for credits of authorship
 ------------------------------------------------------------------------ */
 
 #include <assert.h>
+#include <string.h>
 #include "InstructionPipeline.h"
 
-InstructionPipeline::InstructionPipeline(unsigned int size)
+void InstructionPipeline::init(unsigned int vsize, const DecodedInstruction * d)
 {
-  Pipe = new vector < pipeStage > (size);
-
+  assert(vsize <= PIPELINE_MAX_DEPTH);
+  size = vsize;
   currentStage = 0;
-}
-
-InstructionPipeline::~InstructionPipeline(void)
-{
-  delete Pipe;
+  decoded = d;
+  for (unsigned int i = 0; i < size; i++)
+    {
+      Pipe[i].tick = 0;
+      Pipe[i].in = Pipe[i].out = Pipe[i].FU = NULL;
+    }
 }
 
 pipeStage *InstructionPipeline::insertInstruction(unsigned int tick)
 {
-  Pipe->at(0).tick = tick;
-  return &Pipe->at(0);
+  Pipe[0].tick = tick;
+  return &Pipe[0];
 }
 
 pipeStage *InstructionPipeline::propagateInstruction(unsigned int lat)
 {
-  Pipe->at(currentStage + 1).tick = Pipe->at(currentStage).tick + lat;
+  assert(currentStage + 1 < size);
+  Pipe[currentStage + 1].tick = Pipe[currentStage].tick + lat;
   currentStage++;
-  return &Pipe->at(currentStage);
+  return &Pipe[currentStage];
 }
 
-pipeStage *InstructionPipeline::getPipeStage(unsigned int stageNum)
-{
-  return &Pipe->at(stageNum);
-}
-
-unsigned int InstructionPipeline::getDependencySource(vector < string > &inputs, string & source)
+// Print the content of the instruction pipeline
+void InstructionPipeline::Print(void)
 {
-  unsigned int v, tick = 0;
-  source = string("");
-  for (unsigned int i = Pipe->size() - 1; i > 0; i--)
+  cout << "\t" << decoded->code << endl;
+  for (unsigned int i = 0; i < size; i++)
     {
-      vector < string > outputs = Pipe->at(i).out;
-
-      // Look for a match between inputs and outputs
-      for (unsigned int j = 0; j < outputs.size(); j++)
-	{
-	  for (unsigned int k = 0; k < inputs.size(); k++)
-	    {
-	      if (outputs[j].compare(inputs[k]) == 0 /* && outputs[j].compare("mem")!=0 */ )
-		{
-		  v = Pipe->at(i).tick;;
-		  if (v > tick)
-		    {
-		      tick = v;
-		      source = outputs[j];
-		    }
-		}
-	    }
-	}
+      cout << "\tStage " << i << " tick " << Pipe[i].tick;
+      cout << "\tFU: ";
+      if (Pipe[i].FU != NULL)
+	for (unsigned int j = 0; j < decoded->functionalUnits.size(); j++)
+	  cout << decoded->functionalUnits[j] << " ";
+      cout << "\t In: ";
+      if (Pipe[i].in != NULL)
+	for (unsigned int j = 0; j < decoded->inputs.size(); j++)
+	  cout << decoded->inputs[j] << " ";
+      cout << "\t Out: ";
+      if (Pipe[i].out != NULL)
+	for (unsigned int j = 0; j < decoded->outputs.size(); j++)
+	  cout << decoded->outputs[j] << " ";
+      cout << endl;
     }
-
-  return tick;
 }
 
-unsigned int InstructionPipeline::getDependencies(vector < string > &inputs)
+void PipelineSchedule::clear()
 {
-  string source;
-  return getDependencySource(inputs, source);
+  count = 0;
+  memset(writer, 0, sizeof(writer));
+  memset(writeTick, 0, sizeof(writeTick));
+  memset(FUTick, 0, sizeof(FUTick));
 }
 
-string InstructionPipeline::getDependencySource(vector < string > &inputs)
+InstructionPipeline & PipelineSchedule::newInstruction(unsigned int size, const DecodedInstruction & d)
 {
-  string source;
-  getDependencySource(inputs, source);
-  return source;
+  InstructionPipeline & ip = ring[count % PIPELINE_RING_SIZE];
+  ip.init(size, &d);
+  return ip;
 }
 
-unsigned int InstructionPipeline::checkAvaliability(string FU)
+void PipelineSchedule::commit()
 {
-  unsigned int v, tick = 0;
-  int vsize;
-
-  // Generalized by LBesnard for ARM: an instruction may require more thant one FU, when the "barrel shifter" is used.
-  // For MIPS: the assert ( FUs.size () == 1) has already be verified before this call.
-  for (unsigned int i = Pipe->size() - 1; i > 0; i--)
+  InstructionPipeline & ip = ring[count % PIPELINE_RING_SIZE];
+  count++;
+  // The first stage (fetch) uses no resource
+  for (unsigned int i = 1; i < ip.getSize(); i++)
     {
-      vector < string > FUs = Pipe->at(i).FU;
-      vsize = FUs.size();
-      // assert (vsize <= 1); for MIPS but ARM, an instruction may require the barrel shifter. // if (vsize != 0) 
-      for (int j = 0; j < vsize; j++)
-	{
-	  string fu = FUs[j];
-	  if (fu.compare(FU) == 0)
-	    {
-	      v = Pipe->at(i).tick;
-	      if (v > tick)
-		{
-		  tick = v;
-		}
-	    }
-	}
+      pipeStage *stage = ip.getPipeStage(i);
+      if (stage->out != NULL)
+	for (size_t j = 0; j < stage->out->size(); j++)
+	  {
+	    int r = (*stage->out)[j];
+	    if (writer[r] != count)
+	      {
+		writer[r] = count;
+		writeTick[r] = 0;
+	      }
+	    if (stage->tick > writeTick[r]) writeTick[r] = stage->tick;
+	  }
+      if (stage->FU != NULL)
+	for (size_t j = 0; j < stage->FU->size(); j++)
+	  {
+	    int f = (*stage->FU)[j];
+	    if (stage->tick > FUTick[f]) FUTick[f] = stage->tick;
+	  }
     }
-  return tick;
 }
 
-unsigned int InstructionPipeline::execFinished(void)
+unsigned int PipelineSchedule::getDependencies(const vector < int >&inputs)
 {
-  unsigned int tick = 0;
-
-  for (unsigned int i = Pipe->size() - 1; i > 0; i--)
+  // Same result as a backward search through the instructions, stopping at the first
+  // one writing an input: the latest write of an input by this instruction.
+  unsigned int last = 0, tick = 0;
+  for (size_t k = 0; k < inputs.size(); k++)
     {
-      if (!Pipe->at(i).FU.empty())
+      int r = inputs[k];
+      if (writer[r] > last)
 	{
-	  tick = Pipe->at(i).tick + 1;
+	  last = writer[r];
+	  tick = writeTick[r];
 	}
+      else if (writer[r] == last && last != 0 && writeTick[r] > tick)
+	tick = writeTick[r];
     }
-
   return tick;
 }
-
-// Print the content of the instruction pipeline
-void InstructionPipeline::Print(void)
-{
-  for (unsigned int i = 0; i < Pipe->size(); i++)
-    {
-      cout << "\tStage " << i << " tick " << Pipe->at(i).tick;
-      cout << "\tFU: ";
-      for (unsigned int j = 0; j < Pipe->at(i).FU.size(); j++)
-	cout << Pipe->at(i).FU[j] << " ";
-      cout << "\t In: ";
-      for (unsigned int j = 0; j < Pipe->at(i).in.size(); j++)
-	cout << Pipe->at(i).in[j] << " ";
-      cout << "\t Out: ";
-      for (unsigned int j = 0; j < Pipe->at(i).out.size(); j++)
-	cout << Pipe->at(i).out[j] << " ";
-      cout << endl;
-    }
-}
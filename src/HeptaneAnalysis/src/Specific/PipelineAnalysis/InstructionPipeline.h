@@ -26,12 +26,21 @@ See CREDITS.txt for credits of authorship
 #include <string>
 #include <vector>
 #include <iostream>
+#include "arch.h"
+
 using namespace std;
 
+/** Maximum number of stages of the pipeline */
+#define PIPELINE_MAX_DEPTH 8
+
+/** Number of the last scheduled instructions kept by a PipelineSchedule */
+#define PIPELINE_RING_SIZE 4
 
 /**
  * Represent the state (clock tick and ressource used) of an
  * instruction for a particular pipeline stage.
+ * The resources are the identifiers of the decoded instruction
+ * (see Arch::getResourceId), NULL when the stage uses none.
  */
 class pipeStage
 {
@@ -40,34 +49,33 @@ public:
   unsigned int tick;
 
   ///Set of register read by the instruction at this pipeline stage
-    vector < string > in;
+  const vector < int > *in;
+
   ///Set of register write by the instruction at this pipeline stage
-    vector < string > out;
+  const vector < int > *out;
 
   /// Functionnal units used by the instruction at this pipeline stage
-    vector < string > FU;
+  const vector < int > *FU;
 };
 
-
-
 /** 
  * contain the timing and ressources of one instruction for each pipeline stage 
  */
 class InstructionPipeline
 {
 private:
-  vector < pipeStage > *Pipe;
+  pipeStage Pipe[PIPELINE_MAX_DEPTH];
+  unsigned int size;
   unsigned int currentStage;
+  const DecodedInstruction *decoded;
 
-private:
-  unsigned int getDependencySource (vector < string > &inputs,  string & source );
 public:
-  /** create an instruction pipeline of "size" stages */
-    InstructionPipeline (unsigned int size);
-   ~InstructionPipeline (void);
 
-   /** insert instruction in the first stage of the pipeline
-       return the corresponding pipeStage structure*/
+  /** reset to an instruction pipeline of "size" stages for instruction d */
+  void init (unsigned int size, const DecodedInstruction * d);
+
+  /** insert instruction in the first stage of the pipeline
+      return the corresponding pipeStage structure*/
   pipeStage *insertInstruction (unsigned int tick);
 
   /** propagate the instruction to the next stage
@@ -75,26 +83,80 @@ public:
   pipeStage *propagateInstruction (unsigned int lat);
 
   /** return the pipeStage structure of the stage "stageNum" */
-  pipeStage *getPipeStage (unsigned int stageNum);
+  pipeStage *getPipeStage (unsigned int stageNum)
+  {
+    return &Pipe[stageNum];
+  }
+
+  /** return the number of stages */
+  unsigned int getSize ()
+  {
+    return size;
+  }
+
+  /** Print the content of the instruction pipeline */
+  void Print (void);
+};
+
+/**
+ * Schedule of a sequence of instructions (basic block, or pair of basic blocks for a delta).
+ *
+ * Only the last instructions are kept, in a ring. The dependencies and the availability
+ * of the functional units are given by tables indexed by resource identifier, updated when
+ * an instruction is committed: the cost of scheduling an instruction does not depend on
+ * the length of the sequence, and nothing is allocated per instruction.
+ */
+class PipelineSchedule
+{
+private:
+  InstructionPipeline ring[PIPELINE_RING_SIZE];
+  unsigned int count;		///< number of committed instructions
 
-  /** return the clock tick were the data needed by "inputs" are available
-      return 0 if no dependencies
-  */
-  unsigned int getDependencies (vector < string > &inputs);
+  ///per resource: 1 + number of the last instruction writing it (0 if none), and the tick of this write
+  unsigned int writer[MAX_DECODED_RESOURCES];
+  unsigned int writeTick[MAX_DECODED_RESOURCES];
 
+  ///per functional unit: last tick of use (0 if not used)
+  unsigned int FUTick[MAX_DECODED_RESOURCES];
 
-  string getDependencySource (vector < string > &inputs);
+public:
+  PipelineSchedule ()
+  {
+    clear ();
+  }
 
-  /** return the clock tick were the "FU" is free
-      return 0 if "FU" is not used*/
-  unsigned int checkAvaliability (string FU);
+  /** Empties the schedule */
+  void clear ();
 
-  /** return the clock tick were the execution in the FU finish*/
-  unsigned int execFinished (void);
+  /** return true if no instruction is scheduled */
+  bool empty ()
+  {
+    return count == 0;
+  }
 
-  /** Print the content of the instruction pipeline */
-  void Print (void);
-};
+  /** return the last committed instruction */
+  InstructionPipeline & last ()
+  {
+    return ring[(count - 1) % PIPELINE_RING_SIZE];
+  }
+
+  /** return the pipeline of a new instruction of "size" stages, to be committed once scheduled */
+  InstructionPipeline & newInstruction (unsigned int size, const DecodedInstruction & d);
+
+  /** Adds the instruction returned by newInstruction to the schedule */
+  void commit ();
+
+  /** return the clock tick were the data needed by "inputs" are available:
+      the last write of the last instruction writing one of the inputs,
+      0 if no dependencies */
+  unsigned int getDependencies (const vector < int >&inputs);
 
+  /** return the clock tick were the "FU" is free
+      return 0 if "FU" is not used*/
+  unsigned int checkAvaliability (int FU)
+  {
+    return FUTick[FU];
+  }
+};
 
 #endif
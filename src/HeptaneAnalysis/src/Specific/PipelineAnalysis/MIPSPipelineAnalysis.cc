@@ -37,42 +37,41 @@ bool MIPSPipelineAnalysis::PerformAnalysis()
 /**
  * Schedule the first instruction of a basic bloc.
  * 
- * \param inst instruction to insert in the pipeline
- * \param IP 
- * \param context context of the instruction
- * \param first first occurence of the instruction
+ * \param decoded instruction to insert in the pipeline
+ * \param fetchLatency fetch latency of the instruction (for its context and occurence)
+ * \param IP schedule of the previous instructions
  */
-void MIPSPipelineAnalysis::scheduleFirstInst(Instruction & inst, vector < InstructionPipeline * >&IP, Context * context, bool first)
+void MIPSPipelineAnalysis::scheduleFirstInst(const DecodedInstruction & decoded, unsigned int fetchLatency, PipelineSchedule & IP)
 {
-  string codeInstr = inst.GetCode();
-  InstructionPipeline *instTmp = new InstructionPipeline(PIPELINEDEPTH);
+  assert(decoded.hasFormat);
+  InstructionPipeline & instTmp = IP.newInstruction(PIPELINEDEPTH, decoded);
   pipeStage *pipeStageTmp;
 
-  TRACE_PIPELINEANALYSIS(cout << " -- begin scheduleFirstInst() instr = " << codeInstr << endl);
-  unsigned int fetchAt = getFetchLatency(inst, context, first);
+  TRACE_PIPELINEANALYSIS(cout << " -- begin scheduleFirstInst() instr = " << decoded.code << endl);
+  unsigned int fetchAt = fetchLatency;
   //fetch stage
-  instTmp->insertInstruction(fetchAt);
+  instTmp.insertInstruction(fetchAt);
   //decode stage
-  instTmp->propagateInstruction(1);
+  instTmp.propagateInstruction(1);
 
   //execution stage 
-  unsigned int lat = Arch::getLatency(codeInstr);
-  pipeStageTmp = instTmp->propagateInstruction(lat);
-  pipeStageTmp->FU = Arch::getResourceFunctionalUnits(codeInstr);
-  pipeStageTmp->in = Arch::getResourceInputs(codeInstr);
+  unsigned int lat = decoded.latency;
+  pipeStageTmp = instTmp.propagateInstruction(lat);
+  pipeStageTmp->FU = &decoded.functionalUnitIds;
+  pipeStageTmp->in = &decoded.inputIds;
 
-  assert(pipeStageTmp->FU.size() == 1);
+  assert(pipeStageTmp->FU->size() == 1);
   // Memory stage
   // TODO DataCache. 
   // si load  calcul avec chmc des DataCache
   // si store alors write immediate sans allocation 
 
   //WB stage
-  pipeStageTmp = instTmp->propagateInstruction(1);
-  pipeStageTmp->out = Arch::getResourceOutputs(codeInstr);
+  pipeStageTmp = instTmp.propagateInstruction(1);
+  pipeStageTmp->out = &decoded.outputIds;
 
-  IP.push_back(instTmp);
-  TRACE_PIPELINEANALYSIS(instTmp->Print());
+  IP.commit();
+  TRACE_PIPELINEANALYSIS(instTmp.Print());
   TRACE_PIPELINEANALYSIS(cout << " -- end scheduleFirstInst " << endl);
 
 }
@@ -80,49 +79,33 @@ void MIPSPipelineAnalysis::scheduleFirstInst(Instruction & inst, vector < Instru
 /**
  * Schedule the instruction (not the first one) of a basic bloc.
  * 
- * \param inst instruction to insert in the pipeline
- * \param IP 
- * \param context context of the instruction
- * \param first first occurence of the instruction
+ * \param decoded instruction to insert in the pipeline
+ * \param fetchLatency fetch latency of the instruction (for its context and occurence)
+ * \param IP schedule of the previous instructions
  */
-void MIPSPipelineAnalysis::scheduleNextInst(Instruction & inst, vector < InstructionPipeline * >&IP, Context * context, bool first)
+void MIPSPipelineAnalysis::scheduleNextInst(const DecodedInstruction & decoded, unsigned int fetchLatency, PipelineSchedule & IP)
 {
 
-  string codeInstr = inst.GetCode();
-  InstructionPipeline *instTmp = new InstructionPipeline(PIPELINEDEPTH);
+  assert(decoded.hasFormat);
+  InstructionPipeline & instTmp = IP.newInstruction(PIPELINEDEPTH, decoded);
 
-  TRACE_PIPELINEANALYSIS(cout << " -- begin scheduleNextInst() instr = " << codeInstr << endl);
+  TRACE_PIPELINEANALYSIS(cout << " -- begin scheduleNextInst() instr = " << decoded.code << endl);
 
-  unsigned int fetchAt = IP[IP.size() - 1]->getPipeStage(0)->tick + getFetchLatency(inst, context, first);
+  unsigned int fetchAt = IP.last().getPipeStage(0)->tick + fetchLatency;
 
   //fetch stage
-  instTmp->insertInstruction(fetchAt);
+  instTmp.insertInstruction(fetchAt);
   //decode stage
-  instTmp->propagateInstruction(1);
+  instTmp.propagateInstruction(1);
 
   //check for dependencies
-  //goes backward through instructions and stops at the first dependency found
-  vector < string > inputs = Arch::getResourceInputs(codeInstr);
-  unsigned int i = IP.size() - 1;
-  unsigned int depTick = IP[i]->getDependencies(inputs);	// return the clock tick were the data needed by "inputs" are available or 0 if no dependencies
-  while (depTick == 0 && i > 0)
-    {
-      i--;
-      depTick = IP[i]->getDependencies(inputs);
-    }
+  //on the last instruction writing one of the inputs
+  unsigned int depTick = IP.getDependencies(decoded.inputIds);	// return the clock tick were the data needed by the inputs are available or 0 if no dependencies
 
   //check FU avaliability : for MIPS only one FU.
-  vector < string > FUs = Arch::getResourceFunctionalUnits(codeInstr);
+  const vector < int > &FUs = decoded.functionalUnitIds;
   assert(FUs.size() == 1);
-  unsigned int FUTick = 0;
-  for (i = 0; i < IP.size(); i++)
-    {
-      unsigned int t = IP[i]->checkAvaliability(FUs[0]);
-      if (t > FUTick)
-	{
-	  FUTick = t;
-	}
-    }
+  unsigned int FUTick = IP.checkAvaliability(FUs[0]);
 
   //get the max of depTick FUTick and depTick
   int execLat = 0;
@@ -135,23 +118,23 @@ void MIPSPipelineAnalysis::scheduleNextInst(Instruction & inst, vector < Instruc
     execLat = 0;
 
   //execution stage
-  pipeStage *pipeStageTmp = instTmp->propagateInstruction(execLat + 1);
-  pipeStageTmp->FU = FUs;
-  pipeStageTmp->in = Arch::getResourceInputs(codeInstr);
-  unsigned int lat = Arch::getLatency(codeInstr);
+  pipeStage *pipeStageTmp = instTmp.propagateInstruction(execLat + 1);
+  pipeStageTmp->FU = &FUs;
+  pipeStageTmp->in = &decoded.inputIds;
+  unsigned int lat = decoded.latency;
   if (lat <= 1)			//allow bypass
-    pipeStageTmp->out = Arch::getResourceOutputs(codeInstr);
-  // else pipeStageTmp->FU = FUs; // ???? already set
+    pipeStageTmp->out = &decoded.outputIds;
+  // else pipeStageTmp->FU = &FUs; // ???? already set
 
   //WB stage, do WB only after preceding inst WB
-  unsigned int WBAt = IP[IP.size() - 1]->getPipeStage(PIPELINEDEPTH - 1)->tick + 1;	// WB previous instruction + 1
+  unsigned int WBAt = IP.last().getPipeStage(PIPELINEDEPTH - 1)->tick + 1;	// WB previous instruction + 1
   int WBLat = WBAt - pipeStageTmp->tick;
   if (WBLat < 0)
     WBLat = 1;			// max(0, (WB previous instruction + 1) - exec (instruction))
-  pipeStageTmp = instTmp->propagateInstruction(WBLat);
-  pipeStageTmp->out = Arch::getResourceOutputs(codeInstr);
+  pipeStageTmp = instTmp.propagateInstruction(WBLat);
+  pipeStageTmp->out = &decoded.outputIds;
 
-  IP.push_back(instTmp);
-  TRACE_PIPELINEANALYSIS(instTmp->Print());
+  IP.commit();
+  TRACE_PIPELINEANALYSIS(instTmp.Print());
   TRACE_PIPELINEANALYSIS(cout << " -- end scheduleNextInst()" << endl);
 }
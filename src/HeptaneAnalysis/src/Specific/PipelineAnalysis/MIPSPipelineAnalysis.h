@@ -51,9 +51,9 @@ class MIPSPipelineAnalysis:public PipelineAnalysis
 
  protected:
   /** See Pipeline::scheduleFirstInst() */
-  void scheduleFirstInst (Instruction & inst, vector < InstructionPipeline * >&IP, Context * context, bool first);
+  void scheduleFirstInst (const DecodedInstruction & decoded, unsigned int fetchLatency, PipelineSchedule & IP);
   /** See Pipeline::scheduleFirstInst() */
-  void scheduleNextInst (Instruction & inst, vector < InstructionPipeline * >&IP, Context * context, bool first);
+  void scheduleNextInst (const DecodedInstruction & decoded, unsigned int fetchLatency, PipelineSchedule & IP);
 
  public:
 
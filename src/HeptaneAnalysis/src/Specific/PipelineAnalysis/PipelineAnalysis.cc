@@ -35,8 +35,8 @@ See CREDITS.txt for credits of authorship
  */
 unsigned int PipelineAnalysis::getFetchLatency(Instruction & inst, Context * context, bool first)
 {
-  unsigned int latency = config->getICacheLatency(1);	// By default, hit in the L1 cache
-  int l = config->getMemoryLoadLatency();
+  unsigned int latency = getConfig()->getICacheLatency(1);	// By default, hit in the L1 cache
+  int l = getConfig()->getMemoryLoadLatency();
 
   //get instruction latency (cache access)
   for (int i = 1; i <= nbCacheLevel; i++)
@@ -46,7 +46,7 @@ unsigned int PipelineAnalysis::getFetchLatency(Instruction & inst, Context * con
       if (first)
 	{
 	  if (classif == string("FM") || classif == string("AM") || classif == string("NC"))	//miss
-	    latency += (i == nbCacheLevel) ? l: config->getICacheLatency(i + 1);
+	    latency += (i == nbCacheLevel) ? l: getConfig()->getICacheLatency(i + 1);
 	  else			//hit
 	    break;
 	}
@@ -54,7 +54,7 @@ unsigned int PipelineAnalysis::getFetchLatency(Instruction & inst, Context * con
 	{ //next
 	  if ( // classif == string("FH") ||     FH does not exist now
 	      classif == string("AM") || classif == string("NC"))	//miss
-	    latency += (i == nbCacheLevel) ? l: config->getICacheLatency(i + 1);
+	    latency += (i == nbCacheLevel) ? l: getConfig()->getICacheLatency(i + 1);
 	  else //hit
 	    break;
 	}
@@ -63,37 +63,64 @@ unsigned int PipelineAnalysis::getFetchLatency(Instruction & inst, Context * con
   return latency;
 }
 
-unsigned int PipelineAnalysis::computeBB(Node & BB, Context * context, bool first)
+const PipelineAnalysis::DecodedCode & PipelineAnalysis::getCode(Node * n)
 {
-  unsigned int Time = 0;
-  vector < InstructionPipeline * >IP;
+  map < Node *, DecodedCode >::iterator it = nodeCode.find(n);
+  if (it != nodeCode.end()) return it->second;
 
-  vector < Instruction * >insts = BB.GetInstructions();
-  vector < Instruction * >::iterator it = insts.begin();
-
-  if (insts.size() == 0) return 0;
-  while (!(*it)->IsCode()) it++;
+  DecodedCode & code = nodeCode[n];
+  vector < Instruction * >insts = n->GetInstructions();
+  for (size_t i = 0; i < insts.size(); i++)
+    {
+      if (insts[i]->IsCode()) code.push_back(&AnalysisHelper::getDecoded(insts[i]));
+    }
+  return code;
+}
 
-  //schedule first instruction
-  scheduleFirstInst(*(*it), IP, context, first);
+const vector < unsigned int > & PipelineAnalysis::getFetchLatencies(Node * n, Context * context, bool first)
+{
+  pair < pair < Node *, Context * >, bool > key(make_pair(n, context), first);
+  map < pair < pair < Node *, Context * >, bool >, vector < unsigned int > >::iterator it = fetchLatencies.find(key);
+  if (it != fetchLatencies.end()) return it->second;
 
-  //schedule next instructions
-  it++;
-  while (it < insts.end())
+  vector < unsigned int > &latencies = fetchLatencies[key];
+  vector < Instruction * >insts = n->GetInstructions();
+  for (size_t i = 0; i < insts.size(); i++)
     {
-      if ((*it)->IsCode())
-	scheduleNextInst(*(*it), IP, context, first);
-      it++;
+      if (insts[i]->IsCode()) latencies.push_back(getFetchLatency(*insts[i], context, first));
     }
+  return latencies;
+}
 
-  Time = IP[IP.size() - 1]->getPipeStage(PIPELINEDEPTH - 1)->tick;
+void PipelineAnalysis::scheduleNode(Node * n, const vector < unsigned int > & latencies)
+{
+  const DecodedCode & code = getCode(n);
+  assert(code.size() == latencies.size());
+  for (size_t i = 0; i < code.size(); i++)
+    {
+      if (schedule.empty())
+	scheduleFirstInst(*code[i], latencies[i], schedule);
+      else
+	scheduleNextInst(*code[i], latencies[i], schedule);
+    }
+}
 
-  // delete allocated InstructionPipeline
-  for (unsigned int i = 0; i < IP.size(); i++)
+unsigned int PipelineAnalysis::computeBB(Node & BB, Context * context, bool first)
+{
+  ScheduleKey key(&BB, getFetchLatencies(&BB, context, first));
+  map < ScheduleKey, unsigned int >::iterator it = nodeTimes.find(key);
+  if (it != nodeTimes.end())
     {
-      delete IP[i];
+      nbReused++;
+      return it->second;
     }
 
+  schedule.clear();
+  scheduleNode(&BB, key.second);
+  nbScheduled++;
+
+  unsigned int Time = schedule.empty() ? 0 : schedule.last().getPipeStage(PIPELINEDEPTH - 1)->tick;
+  nodeTimes[key] = Time;
   return Time;
 }
 
@@ -102,42 +129,28 @@ int PipelineAnalysis::Delta(Node * pred, Node * dest, Context * predContext, Con
 
   int delta;
   unsigned int Time = 0;
-  vector < InstructionPipeline * >IP;
 
-  vector < Instruction * >insts = pred->GetInstructions();
-  vector < Instruction * >::iterator it = insts.begin();
-
-  if (insts.size() == 0)
+  if (getCode(pred).empty())
     return 0;
 
-  while (!(*it)->IsCode())
-    it++;
-  //schedule first instruction
-  scheduleFirstInst(*(*it), IP, predContext, predOccur);
-
-  //schedule next instructions from the source BB
-  it++;
-  while (it < insts.end())
+  // Execution time of the sequence pred, dest
+  pair < ScheduleKey, ScheduleKey > key(ScheduleKey(pred, getFetchLatencies(pred, predContext, predOccur)),
+					ScheduleKey(dest, getFetchLatencies(dest, destContext, destOccur)));
+  map < pair < ScheduleKey, ScheduleKey >, unsigned int >::iterator it = pairTimes.find(key);
+  if (it != pairTimes.end())
     {
-      if ((*it)->IsCode())
-	scheduleNextInst(*(*it), IP, predContext, predOccur);
-      it++;
+      nbReused++;
+      Time = it->second;
     }
-  //schedule instruction from the destination BB
-  insts = dest->GetInstructions();
-  it = insts.begin();
-
-  while (it < insts.end())
+  else
     {
-      if ((*it)->IsCode())
-	scheduleNextInst(*(*it), IP, destContext, destOccur);
-      it++;
+      schedule.clear();
+      scheduleNode(pred, key.first.second);
+      scheduleNode(dest, key.second.second);
+      nbScheduled++;
+      Time = schedule.last().getPipeStage(PIPELINEDEPTH - 1)->tick;
+      pairTimes[key] = Time;
     }
-  Time = IP[IP.size() - 1]->getPipeStage(PIPELINEDEPTH - 1)->tick;
-
-  //delete allocated InstructionPipeline
-  for (unsigned int i = 0; i < IP.size(); i++)
-    delete IP[i];
 
   // compute the delta
   string predAttrName;
@@ -199,7 +212,7 @@ int PipelineAnalysis::computeReturnDelta(vector < Node * >endNodes, Node * retur
 
 // Public -------------------------------------------------------
 
- PipelineAnalysis::PipelineAnalysis(Program * p, int nbcache):Analysis(p)
+ PipelineAnalysis::PipelineAnalysis(Program * p, int nbcache):Analysis(p), nbScheduled(0), nbReused(0)
 {
   PIPELINEDEPTH = 4;
   nbCacheLevel = nbcache;
@@ -435,6 +448,15 @@ bool PipelineAnalysis::PerformAnalysis()
 	  TRACE_PIPELINEANALYSIS(cout << attrName << " = " << time.GetValue() << endl);
 	}
     }
+  stringstream infostr;
+  infostr << "PipelineAnalysis: " << nbScheduled << " schedules computed, " << nbReused << " reused (same fetch latencies)";
+  Logger::addInfo(infostr.str());
+
+  nodeCode.clear();
+  fetchLatencies.clear();
+  nodeTimes.clear();
+  pairTimes.clear();
+
   TRACE_PIPELINEANALYSIS(cout << " PipelineAnalysis::PerformAnalysis () : END " << endl);
   TRACE_PIPELINEANALYSIS(cout << " ############################################################################" << endl);
   return true;
@@ -45,6 +45,31 @@ class PipelineAnalysis:public Analysis
   map < int, string > CodeCHMC;
   map < int, string > DataCHMC;
 
+  /** Decoded code instructions of a node */
+  typedef vector < const DecodedInstruction * > DecodedCode;
+
+  /** A node and the fetch latencies of its code instructions: the schedule of the
+      node only depends on them, whatever the context and the occurence.
+      The data cache classifications are not part of the key because nothing uses
+      them with a pipeline: the MIPS and ARM models go from the execution stage
+      (latency of the decoded instruction) to the write back, without memory stage
+      (see the DataCache TODO of MIPSPipelineAnalysis), and the PIPELINE methods of
+      IPETAnalysis add no data cache cost. A memory stage using the data latencies
+      would have to add them to the key. */
+  typedef pair < Node *, vector < unsigned int > > ScheduleKey;
+
+  // Schedule of the instructions, reused by all the computations
+  PipelineSchedule schedule;
+
+  // Caches of the decoded instructions and fetch latencies of the nodes (per context and occurence)
+  map < Node *, DecodedCode > nodeCode;
+  map < pair < pair < Node *, Context * >, bool >, vector < unsigned int > > fetchLatencies;
+
+  // Execution times of the nodes, and of the pairs of nodes (deltas), already computed
+  map < ScheduleKey, unsigned int > nodeTimes;
+  map < pair < ScheduleKey, ScheduleKey >, unsigned int > pairTimes;
+  unsigned long nbScheduled, nbReused;
+
  protected:
   unsigned int PIPELINEDEPTH;
 
@@ -68,26 +93,21 @@ class PipelineAnalysis:public Analysis
  private:
 
   /**
-     Insert the first instruction in the pipeline according its
-     context and its occurence. 
-     An InstructionPipeline is created for the instruction inst. Each
-     pipeStage is set according to progression of the instruction. 
-     This InstructionPipeline is inserted in IP.
+     Insert the first instruction (decoded) of a sequence in the pipeline,
+     its fetch latency (fetchLatency) being given by its context and its occurence.
+     An InstructionPipeline of IP is set according to progression of the instruction
+     in the pipeline stages, and committed in IP.
    
      This function is architecture dependant.
   */
-  virtual void scheduleFirstInst (Instruction & inst, vector < InstructionPipeline * >&IP, Context * context, bool first)=0;
+  virtual void scheduleFirstInst (const DecodedInstruction & decoded, unsigned int fetchLatency, PipelineSchedule & IP)=0;
 
   /**
-     Insert subsequent instructions in the pipelineaccording its
-     context and its occurence. 
-     An InstructionPipeline is created for the instruction inst. Each
-     pipeStage is set according to progression of the instruction. 
-     This InstructionPipeline is inserted in IP.
+     Insert subsequent instructions in the pipeline (see scheduleFirstInst).
     
      This function is architecture dependant.
   */
- virtual void scheduleNextInst (Instruction & inst, vector < InstructionPipeline * >&IP, Context * context, bool first)=0;
+ virtual void scheduleNextInst (const DecodedInstruction & decoded, unsigned int fetchLatency, PipelineSchedule & IP)=0;
  
   /** 
       Used to check the validity of cache attribute on an instruction.
@@ -140,6 +160,15 @@ class PipelineAnalysis:public Analysis
   */
   int computeReturnDelta (vector < Node * >endNodes, Node * returnNode, Context * context, bool Occur);
 
+  /** Return the decoded code instructions of n */
+  const DecodedCode & getCode (Node * n);
+
+  /** Return the fetch latencies of the code instructions of n for a context and an occurence (first) */
+  const vector < unsigned int > & getFetchLatencies (Node * n, Context * context, bool first);
+
+  /** Appends the code instructions of node n to the schedule, with the fetch latencies latencies */
+  void scheduleNode (Node * n, const vector < unsigned int > & latencies);
+
   /**
      Return true if the set of names contains a register name
   */
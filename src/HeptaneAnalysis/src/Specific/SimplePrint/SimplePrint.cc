@@ -51,7 +51,7 @@ SimplePrint::SimplePrint (Program * p, bool printcallgraph, bool printloopnest,
 bool
 SimplePrint::CheckInputAttributes ()
 {
-  Cfg *c = config->getEntryPoint ();
+  Cfg *c = p->GetEntryPoint ();
   assert (c != NULL);
   assert (!(c->IsEmpty ()));
   return true;
@@ -103,7 +103,7 @@ displayNode (Cfg * c, Node * n, void *param)
       cout << "    " << vi[i]->GetCode ();
       if (vi[i]->HasAttribute (AddressAttributeName))
 	{
-	  AddressAttribute attr = (AddressAttribute &) vi[i]->GetAttribute (AddressAttributeName);
+	  const AddressAttribute & attr = (AddressAttribute &) vi[i]->GetAttribute (AddressAttributeName);
 	  t_address add = attr.getCodeAddress ();
 	  cout << "\t address " << hex << add << endl;
 	}
@@ -187,7 +187,7 @@ SimplePrint::PerformAnalysis ()
   if (outputwcetinfo)
     {
       string WCET;
-      Cfg *c = config->getEntryPoint ();
+      Cfg *c = p->GetEntryPoint ();
       if (c->HasAttribute (WCETAttributeName))
 	{
 	  SerialisableStringAttribute ba = (SerialisableStringAttribute &) c->GetAttribute (WCETAttributeName);
@@ -198,9 +198,12 @@ SimplePrint::PerformAnalysis ()
       
       ofstream outWCET;
       cout << "WCET: "  << WCET << endl;	
-      outWCET.open("/home/yixian/heptane_svn/WCET1.txt",ios::app);
-      outWCET << WCET << endl;
-      outWCET.close();
+      if (getConfig ()->shared_logs && getConfig ()->shared_wcet_file != "")
+	{
+	  outWCET.open(getConfig ()->shared_wcet_file.c_str(),ios::app);
+	  outWCET << WCET << endl;
+	  outWCET.close();
+	}
     }
   return true;
 }
@@ -32,20 +32,6 @@ using namespace cfglib;
 
 static bool opt_verbose= false;
 
-/**
-   Change endianness of a 32-bits word.
-*/
-static uint32_t
-ChangeEndianness (uint32_t word)
-{
-  register uint32_t result;
-  result = (word >> 24) & 0x000000ff;
-  result |= (word >> 8) & 0x0000ff00;
-  result |= (word << 8) & 0x00ff0000;
-  result |= (word << 24) & 0xff000000;
-  return result;
-}
-
 /**
    Utility function to get first dans last code addresses in Cfg nodes.
    NB: Addresses should have been attached to instructions before.
@@ -263,60 +249,16 @@ GenerateAnnotationXMLFile (cfglib::Program & p, string annotfilename, bool verbo
     Get annotations from the binary
     Parameters:
     - Program
-    - File containing the dump of the annotation section, obtained previously
-    using objdump -j
-    NB: This function might be sensitive to the format of objdump output
+    - Contents of the annotation section, as 32-bit words in the endianness
+    of the binary (see ElfFile::getSectionWords)
 */
 void
-AttachAnnotationFromBinary (cfglib::Program & cfglib_program, string annot_section_dump_file, bool verbose)
+AttachAnnotationFromBinary (cfglib::Program & cfglib_program, const vector < unsigned long >&annot_section_words, bool verbose)
 {
  opt_verbose = verbose;
- // Read the annotations from the objdump of the annotations section 
-  // (raw format, only read list of long integers)
-  // Assumes the following obdump output format:
-  // Address data data data data ascii representation of contents
-  vector < unsigned long >raw_annots;
-  FILE *f = fopen (annot_section_dump_file.c_str (), "r");
-  bool started = false;
-  unsigned int nb_vals_total = 0;
-  char mark[STRMAX];
-
-  bool bigIndian = Arch::isBigEndian ();
-  snprintf (mark, STRMAX, "%s:", ANNOT_SECTION_NAME);
-  while (1)
-    {
-      char buf[STRMAX];
-      int nb_vals;
-      char address[STRMAX], v1[STRMAX], v2[STRMAX], v3[STRMAX], v4[STRMAX], ascii[STRMAX];
-      if (fgets (buf, STRMAX, f) == NULL)
-	break;
-      nb_vals = sscanf (buf, "%s %s %s %s %s %s", address, v1, v2, v3, v4, ascii);
-      if (nb_vals >= 4 && strcmp (v3, mark) == 0)
-	{
-	  started = true;
-	  continue;
-	}
-      if (started)
-	{
-	  nb_vals_total += nb_vals - 2;
-	  // lbesnard: strtol replaced by strtoll, for 64-bits archi.
-	  if (!bigIndian)
-	    {
-	      raw_annots.push_back (ChangeEndianness (strtoll (v1, (char **) NULL, 16)));
-	      raw_annots.push_back (ChangeEndianness (strtoll (v2, (char **) NULL, 16)));
-	      raw_annots.push_back (ChangeEndianness (strtoll (v3, (char **) NULL, 16)));
-	      raw_annots.push_back (ChangeEndianness (strtoll (v4, (char **) NULL, 16)));
-	    }
-	  else
-	    {
-	      raw_annots.push_back (strtoll (v1, (char **) NULL, 16));
-	      raw_annots.push_back (strtoll (v2, (char **) NULL, 16));
-	      raw_annots.push_back (strtoll (v3, (char **) NULL, 16));
-	      raw_annots.push_back (strtoll (v4, (char **) NULL, 16));
-	    }
-	}
-    }
-  fclose (f);
+  // The annotation section is a list of (address, type, values) records
+  const vector < unsigned long >&raw_annots = annot_section_words;
+  unsigned int nb_vals_total = raw_annots.size ();
   /* --- trace lbesnard
   for (size_t i = 0; i <  nb_vals_total;)
   { cout << "[ " << raw_annots[i++] << "," << raw_annots[i++] << "," << raw_annots[i++] << "]" << endl; }
@@ -324,7 +266,7 @@ AttachAnnotationFromBinary (cfglib::Program & cfglib_program, string annot_secti
 
   // Fill-in the vector of annotations (vector of structures <address,type,values>)
   vector < t_annotation > annots;
-  for (unsigned int i = 0; i < nb_vals_total;)
+  for (unsigned int i = 0; i + 1 < nb_vals_total;)
     {
       t_annotation a;
       a.address = raw_annots[i++];
@@ -332,6 +274,8 @@ AttachAnnotationFromBinary (cfglib::Program & cfglib_program, string annot_secti
       switch (a.type)
 	{
 	case LOOP_MAXITER:
+	  if (i >= nb_vals_total)
+	    Logger::addFatal ("AttachAnnotationFromBinary: truncated loop bound annotation in section " ANNOT_SECTION_NAME);
 	  a.values.push_back (raw_annots[i++]);
 	  // cout << "Maxiter found xxxxx = " << raw_annots[i-1] << endl;
 	  break;
@@ -429,52 +373,3 @@ AttachAnnotationFromBinary (cfglib::Program & cfglib_program, string annot_secti
     }
   loopVerifications(lc);
 }
-
-static void addAddress( char address[STRMAX], vector < t_address> &laddr, bool bigIndian)
-{
-  t_address addr = strtoll (address, (char **) NULL, 16);
-  if (!bigIndian) addr = ChangeEndianness (addr);
-  laddr.push_back (addr);
-}
-
-
-vector < t_address > getSwitchInfos(string switch_section_dump_file)
-{
-  vector < t_address> laddr;
-
-  FILE *f = fopen (switch_section_dump_file.c_str (), "r");
-  bool started = false;
-  char mark[STRMAX];
-  char buf[STRMAX];
-  char address[STRMAX], v1[STRMAX], v2[STRMAX], v3[STRMAX], v4[STRMAX], ascii[STRMAX];
-  int nb_vals;
-
-  bool bigIndian = Arch::isBigEndian ();
-  snprintf (mark, STRMAX, "%s:", ANNOT_SWITCH_BEGIN);
-  while (1) 
-    {
-
-      if (fgets (buf, STRMAX, f) == NULL)
-	break;
-      nb_vals = sscanf (buf, "%s %s %s %s %s %s", address, v1, v2, v3, v4, ascii);
-      if (nb_vals >= 4 && strcmp (v3, mark) == 0)
-	{
-	  started = true;
-	  continue;
-	}
-      if (started)
-	{
-	  // first and last are not "switch address" values.
-	  nb_vals = nb_vals - 2;
-	  if (nb_vals >= 1) addAddress(v1, laddr, bigIndian);
-	  if (nb_vals >= 2) addAddress(v2, laddr, bigIndian);
-	  if (nb_vals >= 3) addAddress(v3, laddr, bigIndian);
-	  if (nb_vals == 4) addAddress(v4, laddr, bigIndian);
-	}
-    }
-  fclose (f);
-  return laddr;
-}
-
-
-
@@ -40,9 +40,6 @@ typedef struct
 // Loop bounds or basic block annotations should be integers
 #define ANNOT_START_MARK ".lflags"
 
-// Max string size in objdump files
-#define STRMAX 80
-
 // Annotation types
 #define LOOP_MAXITER 1
 
@@ -69,16 +66,10 @@ extern void AttachAnnotationsFromXML (cfglib::Program & cfglib_program, string a
     Get annotations from the binary
     Parameters:
     - Program
-    - File containing the dump of the annotation section, obtained previously
-    using objdump -j
-    NB: This function might be sensitive to the format of objdump output
+    - Contents of the annotation section, as 32-bit words in the endianness
+    of the binary (see ElfFile::getSectionWords)
  */
-extern void AttachAnnotationFromBinary (cfglib::Program & cfglib_program, string annot_section_dump_file, bool verbose);
-
-/**
-   @return the list of the addresses (decimal) of the beginning "switch" blocks 
-*/
-extern vector < t_address > getSwitchInfos(string switch_section_dump_file);
+extern void AttachAnnotationFromBinary (cfglib::Program & cfglib_program, const vector < unsigned long >&annot_section_words, bool verbose);
 
 
 #endif
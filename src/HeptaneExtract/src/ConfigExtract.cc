@@ -40,7 +40,8 @@ void ConfigExtract::copy( string ipath, string opath)
    - Compile to asm
    - Assemble
    - Link to obtain a binary file
-   - Use objdump to have instruction addresses and annotations, stored in a specific section in binary
+   - Use objdump -d to disassemble the code (the section headers, the symbol table and the annotations,
+     stored in a specific section in binary, are read by HeptaneExtract from the binary itself, see ElfFile.h)
    - Output intermediate files if asked for in the configuration file
 */
 void ConfigExtract::CompileAll(ListXmlTag & lt)
@@ -132,12 +133,10 @@ void ConfigExtract::CompileAll(ListXmlTag & lt)
       copy(lt[0].getAttributeString("NAME"), prefix_tmpfile);
     }
 
-  // Apply readelf if required, and generate the output file
-  if (1 /*output_readelf */ )	//FIXME: readelf is now always needed for the extraction
-    //TODO: find a better way to force it
+  // Apply readelf if specified, and generate the output file
+  // (the sections, the symbol table and the annotations are read from the binary by HeptaneExtract)
+  if (readelf != "")
     {
-      if (readelf == "")
-	Logger::addFatal("ConfigExtract error: READELF should be specified");
       string readelfcmd = readelf + " " + readelf_args + " -S " + prefix_tmpfile + ">" + result_dir + "/" + program_name + ".readelf";
       execute_cmd(readelfcmd);
     }
@@ -147,21 +146,13 @@ void ConfigExtract::CompileAll(ListXmlTag & lt)
     Logger::addFatal("ConfigExtract error: OBJDUMP should be specified");
 
   string objdumpcmd;
-  objdumpcmd = objdump + " " + objdump_args + " -t -d -z  " + prefix_tmpfile + " > " + prefix_tmpfile + ".objdump";
+  objdumpcmd = objdump + " " + objdump_args + " -d -z  " + prefix_tmpfile + " > " + prefix_tmpfile + ".objdump";
   execute_cmd(objdumpcmd);
   dbg_extract(cout << "Objdump done (address extraction)" << endl);
 
   // Output objdump file if required
   if (output_objdump)
     copy(prefix_tmpfile + ".objdump", result_dir + "/" + program_name + ".objdump");
-  
-  // Use objdump to dump the annotation section
-  objdumpcmd = objdump + " " + objdump_args + " -s -z --section=.wcet_annot " + prefix_tmpfile + " >  " + prefix_tmpfile + ".annot";
-  execute_cmd(objdumpcmd);
-
-  // Use objdump to dump the "switch" annotation section
-  objdumpcmd = objdump + " " + objdump_args + " -s -z --section=.switch_begin " + prefix_tmpfile + " > " + prefix_tmpfile + ".switch";
-  execute_cmd(objdumpcmd);
 
   // Create the Cfg once all files are generated
   cout << "Heptane extract::Creating Cfg" << endl << endl;
@@ -190,6 +181,7 @@ ConfigExtract::ConfigExtract(string filename, bool verbose)
   output_readelf = true;
   output_cfg = true;
   output_code_addresses = true;
+  nb_threads = 1;
 
   // Open the config file
   ifstream cf;
@@ -298,6 +290,17 @@ ConfigExtract::ConfigExtract(string filename, bool verbose)
       result_dir = "./";
     }
 
+  // Optional, number of threads building the cfgs of the functions
+  lt = xmldoc.searchChildren("THREADS");
+  assert(lt.size() <= 1);
+  if (lt.size() == 1)
+    {
+      int n = lt[0].getAttributeInt("NUMBER");
+      if (n < 1)
+	Logger::addFatal("ConfigExtract error: THREADS NUMBER should be at least 1");
+      nb_threads = n;
+    }
+
   lt = xmldoc.searchChildren("INPUTDIR");
   assert(lt.size() <= 1);
   if (lt.size() == 1)
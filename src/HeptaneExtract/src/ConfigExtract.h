@@ -102,6 +102,7 @@ public:
 
   // option
   bool overbose;
+  unsigned int nb_threads;	// number of threads building and analysing the cfgs (1: sequential extraction)
   // Exported methods
   // -----------------
 
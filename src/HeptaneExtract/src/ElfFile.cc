@@ -0,0 +1,232 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+
+#include "ElfFile.h"
+#include <stddef.h>
+#include <string.h>
+#include <elf.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+ElfFile::ElfFile ():base (NULL), size (0), big_endian (false)
+{ }
+
+ElfFile::~ElfFile ()
+{
+  close ();
+}
+
+void
+ElfFile::close ()
+{
+  if (base != NULL)
+    munmap ((void *) base, size);
+  base = NULL;
+  size = 0;
+  sections.clear ();
+  symbols.clear ();
+}
+
+uint16_t
+ElfFile::read16 (size_t offset) const
+{
+  const unsigned char *p = base + offset;
+  if (big_endian)
+    return (uint16_t) ((p[0] << 8) | p[1]);
+  return (uint16_t) ((p[1] << 8) | p[0]);
+}
+
+uint32_t
+ElfFile::read32 (size_t offset) const
+{
+  const unsigned char *p = base + offset;
+  if (big_endian)
+    return ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) | ((uint32_t) p[2] << 8) | (uint32_t) p[3];
+  return ((uint32_t) p[3] << 24) | ((uint32_t) p[2] << 16) | ((uint32_t) p[1] << 8) | (uint32_t) p[0];
+}
+
+string
+ElfFile::readString (size_t offset) const
+{
+  if (offset >= size)
+    return "";
+  const char *s = (const char *) base + offset;
+  return string (s, strnlen (s, size - offset));
+}
+
+bool
+ElfFile::open (const string & file_name, string & error)
+{
+  close ();
+  int fd = ::open (file_name.c_str (), O_RDONLY);
+  if (fd < 0)
+    {
+      error = "unable to open " + file_name;
+      return false;
+    }
+  struct stat st;
+  if (fstat (fd, &st) != 0 || (size_t) st.st_size < sizeof (Elf32_Ehdr))
+    {
+      ::close (fd);
+      error = file_name + " is not an ELF file (too small)";
+      return false;
+    }
+  void *m = mmap (NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close (fd);
+  if (m == MAP_FAILED)
+    {
+      error = "unable to map " + file_name;
+      return false;
+    }
+  base = (const unsigned char *) m;
+  size = st.st_size;
+
+  if (!decode (file_name, error))
+    {
+      close ();
+      return false;
+    }
+  return true;
+}
+
+// ---------------------------------------------------
+// Decoding of the header, the section headers and
+// the symbol table, with bounds checks so that the
+// accessors can read the file in place.
+// ---------------------------------------------------
+bool
+ElfFile::decode (const string & file_name, string & error)
+{
+  if (memcmp (base, ELFMAG, SELFMAG) != 0)
+    {
+      error = file_name + " is not an ELF file (bad magic)";
+      return false;
+    }
+  if (base[EI_CLASS] != ELFCLASS32)
+    {
+      error = file_name + ": only 32-bit ELF files are supported";
+      return false;
+    }
+  if (base[EI_DATA] != ELFDATA2LSB && base[EI_DATA] != ELFDATA2MSB)
+    {
+      error = file_name + ": unknown ELF data encoding";
+      return false;
+    }
+  big_endian = base[EI_DATA] == ELFDATA2MSB;
+
+  uint32_t shoff = read32 (offsetof (Elf32_Ehdr, e_shoff));
+  uint16_t shentsize = read16 (offsetof (Elf32_Ehdr, e_shentsize));
+  uint16_t shnum = read16 (offsetof (Elf32_Ehdr, e_shnum));
+  uint16_t shstrndx = read16 (offsetof (Elf32_Ehdr, e_shstrndx));
+  if (shnum == 0 || shentsize < sizeof (Elf32_Shdr) || (uint64_t) shoff + (uint64_t) shnum * shentsize > size || shstrndx >= shnum)
+    {
+      error = file_name + ": corrupted ELF section header table";
+      return false;
+    }
+
+  // All the section headers (the null one included, so that the indexes are those of the file)
+  vector < ElfSection > all (shnum);
+  vector < uint32_t > name_offsets (shnum), links (shnum), entsizes (shnum);
+  for (uint16_t i = 0; i < shnum; i++)
+    {
+      size_t sh = shoff + (size_t) i * shentsize;
+      name_offsets[i] = read32 (sh + offsetof (Elf32_Shdr, sh_name));
+      all[i].type = read32 (sh + offsetof (Elf32_Shdr, sh_type));
+      all[i].addr = read32 (sh + offsetof (Elf32_Shdr, sh_addr));
+      all[i].offset = read32 (sh + offsetof (Elf32_Shdr, sh_offset));
+      all[i].size = read32 (sh + offsetof (Elf32_Shdr, sh_size));
+      links[i] = read32 (sh + offsetof (Elf32_Shdr, sh_link));
+      entsizes[i] = read32 (sh + offsetof (Elf32_Shdr, sh_entsize));
+      if (all[i].type != SHT_NOBITS && (uint64_t) all[i].offset + all[i].size > size)
+	{
+	  error = file_name + ": truncated ELF section";
+	  return false;
+	}
+    }
+  for (uint16_t i = 0; i < shnum; i++)
+    all[i].name = readString ((size_t) all[shstrndx].offset + name_offsets[i]);
+  sections.assign (all.begin () + 1, all.end ());
+
+  // Symbol table
+  int symtab = -1;
+  for (uint16_t i = 0; i < shnum && symtab == -1; i++)
+    if (all[i].type == SHT_SYMTAB)
+      symtab = i;
+  if (symtab == -1)
+    {
+      error = file_name + ": no symbol table (stripped binary?)";
+      return false;
+    }
+  uint32_t symentsize = entsizes[symtab];
+  uint32_t strtab = links[symtab];
+  if (symentsize < sizeof (Elf32_Sym) || strtab >= shnum)
+    {
+      error = file_name + ": corrupted ELF symbol table";
+      return false;
+    }
+  uint32_t nbsyms = all[symtab].size / symentsize;
+  for (uint32_t i = 1; i < nbsyms; i++)
+    {
+      size_t sym = all[symtab].offset + (size_t) i * symentsize;
+      ElfSymbol s;
+      s.name = readString ((size_t) all[strtab].offset + read32 (sym + offsetof (Elf32_Sym, st_name)));
+      s.value = read32 (sym + offsetof (Elf32_Sym, st_value));
+      s.size = read32 (sym + offsetof (Elf32_Sym, st_size));
+      unsigned char info = base[sym + offsetof (Elf32_Sym, st_info)];
+      s.binding = ELF32_ST_BIND (info);
+      s.type = ELF32_ST_TYPE (info);
+      uint16_t shndx = read16 (sym + offsetof (Elf32_Sym, st_shndx));
+      if (shndx == SHN_UNDEF)
+	s.section = "*UND*";
+      else if (shndx == SHN_ABS)
+	s.section = "*ABS*";
+      else if (shndx == SHN_COMMON)
+	s.section = "*COM*";
+      else if (shndx < shnum)
+	s.section = all[shndx].name;
+      symbols.push_back (s);
+    }
+  return true;
+}
+
+int
+ElfFile::findSection (const string & name) const
+{
+  for (size_t i = 0; i < sections.size (); i++)
+    if (sections[i].name == name)
+      return (int) i;
+  return -1;
+}
+
+vector < unsigned long >
+ElfFile::getSectionWords (const string & name) const
+{
+  vector < unsigned long >words;
+  int i = findSection (name);
+  if (i == -1 || sections[i].type == SHT_NOBITS)
+    return words;
+  for (uint32_t w = 0; w + 4 <= sections[i].size; w += 4)
+    words.push_back (read32 (sections[i].offset + w));
+  return words;
+}
@@ -0,0 +1,126 @@
+/* ---------------------------------------------------------------------
+
+Copyright IRISA, 2003-2017
+
+This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+estimation.
+APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+Heptane is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Heptane is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details (COPYING.txt).
+
+See CREDITS.txt for credits of authorship
+
+------------------------------------------------------------------------ */
+
+/*********************************************
+
+ In-process reader of the ELF32 binaries (MIPS and ARM, big or little
+ endian) produced by the cross compilers.
+
+ Replaces the text outputs of "readelf -S", "objdump -t" and
+ "objdump -s --section=..." that were generated then parsed again by
+ HeptaneExtract: the file is read through mmap, the section headers
+ and the symbol table (.symtab) are decoded once when it is opened,
+ and the contents of a section are read in place.
+
+ Only the sections, the symbols and the annotation sections are read
+ here. The instructions still come from the text output of "objdump -d"
+ (parsed by Arch::parseInstruction): the tree has no decoder of the MIPS
+ and ARM instruction encodings.
+
+*********************************************/
+
+#ifndef ELF_FILE_H
+#define ELF_FILE_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/** Section header of an ELF file */
+class ElfSection
+{
+public:
+  string name;
+  uint32_t type;		///< sh_type (SHT_PROGBITS, SHT_NOBITS, ...)
+  uint32_t addr;
+  uint32_t offset;
+  uint32_t size;		///< in bytes
+};
+
+/** Entry of the symbol table of an ELF file */
+class ElfSymbol
+{
+public:
+  string name;
+  uint32_t value;
+  uint32_t size;		///< in bytes
+  unsigned char binding;	///< STB_LOCAL, STB_GLOBAL, STB_WEAK
+  unsigned char type;		///< STT_NOTYPE, STT_OBJECT, STT_FUNC, STT_SECTION, STT_FILE
+  string section;		///< name of the section, "*UND*", "*ABS*" or "*COM*" as printed by objdump
+};
+
+/** ELF32 file, read through mmap */
+class ElfFile
+{
+public:
+  ElfFile ();
+  ~ElfFile ();
+
+  /** Maps file_name in memory and decodes its section headers and symbol table.
+      @return false (with an explanation in error) when the file cannot be used. */
+  bool open (const string & file_name, string & error);
+
+  /** Unmaps the file */
+  void close ();
+
+  bool isBigEndian () const
+  {
+    return big_endian;
+  }
+
+  /** Sections in the order of the section header table (the null section excluded) */
+  const vector < ElfSection > &getSections () const
+  {
+    return sections;
+  }
+
+  /** Symbols in the order of the symbol table (the null symbol excluded) */
+  const vector < ElfSymbol > &getSymbols () const
+  {
+    return symbols;
+  }
+
+  /** @return the index in getSections() of the section called name, -1 when absent. */
+  int findSection (const string & name) const;
+
+  /** @return the contents of the section called name as 32-bit words in the endianness of the file,
+      empty when the section is absent or has no contents in the file (e.g. .bss). The bytes after
+      the last complete word are ignored. */
+  vector < unsigned long > getSectionWords (const string & name) const;
+
+private:
+  const unsigned char *base;
+  size_t size;
+  bool big_endian;
+  vector < ElfSection > sections;
+  vector < ElfSymbol > symbols;
+
+  uint16_t read16 (size_t offset) const;
+  uint32_t read32 (size_t offset) const;
+  /** @return the null terminated string at offset in the mapped file, "" when out of bounds. */
+  string readString (size_t offset) const;
+  bool decode (const string & file_name, string & error);
+};
+
+#endif
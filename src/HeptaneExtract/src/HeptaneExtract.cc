@@ -45,13 +45,17 @@
 #include <vector>
 #include <set>
 #include <map>
+#include <thread>
+#include <atomic>
 #include <stdlib.h>
+#include <elf.h>
 
 #include "ConfigExtract.h"
 #include "dominatorAnalysis.h"
 #include "loopAnalysis.h"
 #include "switchAnalysis.h"
 #include "Annotations.h"
+#include "ElfFile.h"
 #include "GlobalAttributes.h"
 #include "Utl.h"
 
@@ -59,6 +63,49 @@ using namespace std;
 static bool isARMArchi= false, isMIPSArchi = false;
 static bool opt_verbose = false;
 
+/**
+   Instructions of a function collected by the parser, from which its cfg is built
+   (see build_heptane_cfg)
+*/
+struct FunctionCode
+{
+  ObjdumpFunction function;
+  cfglib::Cfg * cfg;
+  vector < ObjdumpInstruction > instructions;
+  map < int, ObjdumpInstruction > MetaInstructionsTable;
+  set < t_address > bb_start_addr;
+  map < t_address, set < t_address > >succs;
+  // call nodes and call instructions, linked to the called functions once all the cfgs are built
+  vector < pair < cfglib::Node *, ObjdumpInstruction > >calls;
+};
+
+/**
+   Applies task to 0 .. nbTasks-1 on nb_threads threads (in the calling thread when nb_threads is 1).
+   The tasks are the functions of the program: a task may only modify the cfg of its function,
+   so that the program does not depend on the order of the tasks.
+*/
+template < typename Task > static void
+forEachFunction (size_t nbTasks, unsigned int nb_threads, Task task)
+{
+  if (nb_threads <= 1 || nbTasks <= 1)
+    {
+      for (size_t i = 0; i < nbTasks; i++)
+	task (i);
+      return;
+    }
+
+  atomic < size_t > next (0);
+  vector < thread > workers;
+  for (unsigned int t = 0; t < nb_threads && t < nbTasks; t++)
+    workers.push_back (thread ([&] ()
+			       {
+				 for (size_t i = next++; i < nbTasks; i = next++)
+				   task (i);
+			       }));
+  for (size_t t = 0; t < workers.size (); t++)
+    workers[t].join ();
+}
+
 /**
    Exporting a program (cfg form) in xml form.
 */
@@ -105,32 +152,32 @@ static void cleanCfg(Cfg * vcfg)
 }
 
 /** 
-    Create a new cfg from the information obtained by the parser
+    Populate the cfg of a function from the information obtained by the parser (code)
     
-    - cfglib_program: the program itself (created by the parser)
-    - bb_start_addr: the basic block start address (except the first basic block, which is surprizingly not provided by the parser
-    - instructions: the list of instructions by increasing address
-    - function: information on the function whose cfg is under construction
-    - succs: successors. in case of a jump/call, this is known at the instructions level, not at the BB level, 
+    - code.cfg: the cfg of the function, created from the symbol table
+    - code.bb_start_addr: the basic block start address (except the first basic block, which is surprizingly not provided by the parser
+    - code.instructions: the list of instructions by increasing address
+    - code.succs: successors. in case of a jump/call, this is known at the instructions level, not at the BB level, 
              explaning why the cfg is constructed by scnanning all the cfg instructions
     - instrWithWords: (ARM SPECIFIC) mapping between instruction (t_address)
     that use .word and the corresponding words
-    
+
+    Only the cfg of the function is modified (the functions are built in parallel): the call nodes
+    are stored in code.calls, and linked to the called functions by link_calls.
 */
 static void
-build_heptane_cfg (cfglib::Program & cfglib_program, const set < t_address > &bb_start_addr, const vector < ObjdumpInstruction > &instructions,
-		   const ObjdumpFunction & function, const map < t_address, set < t_address > >&succs, const map < t_address,
-		   vector < ObjdumpWord > >&instrWithWords, map < int, ObjdumpInstruction > &MetaInstructionsTable )
+build_heptane_cfg (FunctionCode & code, const map < t_address, vector < ObjdumpWord > >&instrWithWords)
 {
+  const vector < ObjdumpInstruction > &instructions = code.instructions;
+  const set < t_address > &bb_start_addr = code.bb_start_addr;
+  const map < t_address, set < t_address > >&succs = code.succs;
+  map < int, ObjdumpInstruction > &MetaInstructionsTable = code.MetaInstructionsTable;
 
   // Association of Node* to addresses to properly create the list of successors
   map < t_address, cfglib::Node * >address_to_node;
   map<int, ObjdumpInstruction>::iterator iter;
 
-  // Create the cfg and add it to the program
-  cfglib::Cfg * cfgcur = cfglib_program.GetCfgByName (function.name);
-  if (cfgcur == (cfglib::Cfg *) 0)
-    Logger::addFatal ("CFG extractor: cfg does not exist in symbol table " + function.name);
+  cfglib::Cfg * cfgcur = code.cfg;
 
   // Populate the cfg
   // ----------------
@@ -167,12 +214,7 @@ build_heptane_cfg (cfglib::Program & cfglib_program, const set < t_address > &bb
       info.setType ("read");
       info.setSegment ("code");
       info.setPrecision(true);
-      ostringstream ossCodeAdr, ossSize;
-      ossCodeAdr << current_instruction.addr;
-      ossSize << Arch::getInstructionSize ();
-      info.addAdrSize (ossCodeAdr.str (), ossSize.str ());
-      ossCodeAdr.str ("");
-      ossSize.str ("");
+      info.addRange (current_instruction.addr, Arch::getInstructionSize ());
       attribute.addInfo (info);
       inst->SetAttribute (AddressAttributeNameExtract, attribute);
 
@@ -186,13 +228,7 @@ build_heptane_cfg (cfglib::Program & cfglib_program, const set < t_address > &bb
 	}
       
       if (Arch::isCall (current_instruction))
-	{
-	  // Set the node type to call, with the called function as parameter
-	  if (Arch::getCalleeName (current_instruction) == "")
-	    Logger::addFatal ("CFG extractor: name of called empty returned by getCalleeName \n\t(probably an indirect call or a switch), instruction: "
-			      + current_instruction.asm_code);
-	  current_node->SetCall (Arch::getCalleeName (current_instruction), true);
-	}
+	code.calls.push_back (make_pair (current_node, current_instruction));
 
       if (isARMArchi) // ARM SPECIFIC: attach .word information
 	{
@@ -250,18 +286,35 @@ build_heptane_cfg (cfglib::Program & cfglib_program, const set < t_address > &bb
 	}
       prev_addr = current_addr;
     }
+}
 
-  cleanCfg(cfgcur); 
+/**
+   Set the type of the call nodes of the functions (code) to call, with the called function as parameter.
+   The functions are taken in the order of the objdump file, so that the cfgs of the external
+   functions are created in the same order as by a sequential construction.
+*/
+static void
+link_calls (const vector < FunctionCode > &code)
+{
+  for (size_t f = 0; f < code.size (); f++)
+    for (size_t i = 0; i < code[f].calls.size (); i++)
+      {
+	const ObjdumpInstruction & call_instruction = code[f].calls[i].second;
+	if (Arch::getCalleeName (call_instruction) == "")
+	  Logger::addFatal ("CFG extractor: name of called empty returned by getCalleeName \n\t(probably an indirect call or a switch), instruction: "
+			    + call_instruction.asm_code);
+	code[f].calls[i].first->SetCall (Arch::getCalleeName (call_instruction), true);
+      }
 }
 
 /**
    - Make sure functions are correctly linked for call nodes,
    - Set the program entry entry point,
-   - Create loops,
-   - Manage annotations.
+   - Create loops (the functions are analysed on config.nb_threads threads),
+   - Manage annotations (the switch and loop bound annotations are read from the sections of the binary elf).
  */
 static void
-finalize_program_construction (const ConfigExtract & config, cfglib::Program & cfglib_program)
+finalize_program_construction (const ConfigExtract & config, cfglib::Program & cfglib_program, const ElfFile & elf)
 {
   // Make sure functions are correctly linked for call nodes
   vector < cfglib::Cfg * >lcfg = cfglib_program.GetAllCfgs ();
@@ -271,27 +324,30 @@ finalize_program_construction (const ConfigExtract & config, cfglib::Program & c
   if (entry_cfg == NULL) Logger::addFatal ("CFG extractor: can't set entry point to undefined Cfg " + config.entry_point_name);
   cfglib_program.SetEntryPoint (entry_cfg);
 
-  vector < t_address> lswitches = getSwitchInfos( config.tmp_dir + "/" + config.program_name + ".switch" );
+  // Addresses of the beginning of the "switch" blocks
+  vector < unsigned long > switch_words = elf.getSectionWords (ANNOT_SWITCH_BEGIN);
+  vector < t_address> lswitches (switch_words.begin (), switch_words.end ());
   bool bswitch = lswitches.size() > 0;
 
   // Create loops
-  for (unsigned int c = 0; c < lcfg.size (); c++)
+  forEachFunction (lcfg.size (), config.nb_threads, [&] (size_t c)
     {
       Cfg * acfg =lcfg[c];
       vector < cfglib::Node * >vn = acfg->GetAllNodes ();
       if (vn.size () != 0)
 	{
+	  cleanCfg(acfg);
 	  if (bswitch) SwitchComputer::computeSwitch( acfg, lswitches, isMIPSArchi);
 	  cfglib::helper::DominatorComputer::computeDominator (acfg);
 	  cfglib::LoopComputer::computeLoop (acfg);
 	}
-    }
+    });
 
   // Manage annotations
   // If there is an annotation XML file, use it first
   if (config.binary_only) AttachAnnotationsFromXML (cfglib_program, config.annotation_file, opt_verbose);
   // Get the other annotations from the binary file
-  AttachAnnotationFromBinary (cfglib_program, config.tmp_dir + "/" + config.program_name + ".annot", opt_verbose);
+  AttachAnnotationFromBinary (cfglib_program, elf.getSectionWords (ANNOT_SECTION_NAME), opt_verbose);
   // Output the final annotation file if required
   if (config.output_annot) GenerateAnnotationXMLFile (cfglib_program, config.result_dir + "/" + config.annotation_file, opt_verbose);
 }
@@ -374,9 +430,9 @@ static int kernel(vector < ObjdumpInstruction > &instructions, ObjdumpInstructio
   return nbadded;
 }
 
-/** Parser: parse the objdump file and generate the CFG and the readelf file
-    - First step: parsing of the readelf file  
-    - Second step: parsing of the objdump file: parsing of the symbol table and if arch == ARM then search for .word in the .text and store them in wordsPerFunction
+/** Parser: read the binary elf and parse the objdump file to generate the CFG
+    - First step: reading of the sections and of the symbol table of the binary elf
+    - Second step: parsing of the objdump file: if arch == ARM then search for .word in the .text and store them in wordsPerFunction
     - Third step: parsing of the objdump file (ARM specific: Detection of instructions using .word and store them in instrWithWords)
     
     - Program & Cfgs creation
@@ -390,16 +446,13 @@ BuildCfg (const ConfigExtract & config)
   string objdumpname = config.program_name + ".objdump";
   ifstream input (objdumpname.c_str (), ios::in);
   if (!input.is_open ()) Logger::addFatal ("Error: file " + objdumpname + " not present");
-  string readelfname = config.program_name + ".readelf";
-  ifstream input_readelf (readelfname.c_str (), ios::in);
-  if (!input_readelf.is_open ()) Logger::addFatal ("Error: file " + readelfname + " not present");
+  ElfFile elf;
+  string elf_error;
+  if (!elf.open (config.tmp_dir + "/" + config.program_name, elf_error)) Logger::addFatal ("Error: " + elf_error);
 
   // Variables for function parsing
-  vector < ObjdumpInstruction > instructions;
-  map < int, ObjdumpInstruction > MetaInstructionsTable;
+  vector < FunctionCode > code;	// functions of the .text section
   ObjdumpFunction function;
-  set < t_address > bb_start_addr;
-  map < t_address, set < t_address > >succs;
   ObjdumpSymbolTable symbol_table;
 
   isARMArchi = Arch::getArchitectureName () == "ARM";
@@ -411,47 +464,53 @@ BuildCfg (const ConfigExtract & config)
   string line = "";
 
   /**********************************************************/
-  /******     First step: parsing of the readelf file  ******/
+  /******     First step: reading of the binary elf    ******/
   /**********************************************************/
 
-  // go to the Section Headers:
-  while (!input_readelf.eof () && ! Arch::isReadelfSectionsMarker (line))
-    getline (input_readelf, line);
-
-  // Skipping the first line of the List (This line :   [Nr]  Name  Type  Addr  Off  Size  ES  Flg  Lk  Inf  Al)
-  getline (input_readelf, line);
-
-  while (!input_readelf.eof ())
+  // the sections to be extracted
+  for (size_t i = 0; i < elf.getSections ().size (); i++)
     {
-      getline (input_readelf, line);
-      if (Arch::isReadelfFlagsMarker (line)) break; // If the line is "Key to Flags:"
-      Arch::parseReadElfLine (line, symbol_table);
+      const ElfSection & es = elf.getSections ()[i];
+      ObjdumpSection sect;
+      sect.name = es.name;
+      sect.addr = es.addr;
+      sect.size = es.size;
+      Arch::addSection (sect, symbol_table);
     }
-  input_readelf.close ();
   assert (symbol_table.sections.empty () == false);
-  line = "";
+
+  // the functions and variables of the symbol table
+  for (size_t i = 0; i < elf.getSymbols ().size (); i++)
+    {
+      const ElfSymbol & es = elf.getSymbols ()[i];
+      ObjdumpSymbol sym;
+      sym.name = es.name;
+      sym.value = es.value;
+      sym.size = es.size;
+      sym.section = es.section;
+      sym.local = es.binding == STB_LOCAL;
+      switch (es.type)
+	{
+	case STT_NOTYPE: sym.type = SYMBOL_NOTYPE; break;
+	case STT_FUNC: sym.type = SYMBOL_FUNCTION; break;
+	case STT_OBJECT: sym.type = SYMBOL_OBJECT; break;
+	default: sym.type = SYMBOL_OTHER;
+	}
+      Arch::addSymbol (sym, symbol_table);
+    }
 
   /**********************************************************/
   /******     Second step: parsing of the objdump file  *****/
   /**********************************************************/
-  //  - parsing of the symbol table
   //  - if arch == ARM    then search for .word in the .text and store them in wordsPerFunction
 
-  // go to the SYMBOL TABLE:
-  while (!input.eof () && ! Arch::isObjdumpSymbolTableMarker (line))
-    getline (input, line);
-
-  // parsing the symbol table until the Disassembly of section .text:
-  while (!input.eof () && ! Arch::isObjdumpTextMarker (line) )
-    {
-      getline (input, line);
-      if (line.length () == 0 || Arch::isObjdumpTextMarker (line)) continue;
-      Arch::parseSymbolTableLine (line, symbol_table);
-    }
-
   // ARM specific
   if (isARMArchi)
     {
+      // go to the Disassembly of section .text:
+      while (!input.eof () && ! Arch::isObjdumpTextMarker (line))
+	getline (input, line);
+
       // parsing the code (searching for .word)
       while (!input.eof ())
 	{
@@ -592,9 +651,8 @@ BuildCfg (const ConfigExtract & config)
   /**********************************************************/
   /******     Last step: parsing of the objdump file   ******/
   /**********************************************************/
+  // The instructions of all the functions are collected, then the cfgs are built in parallel
 
-  function.name = "";
-  
   input.open (objdumpname.c_str (), ios::in);
   // Go to the Disassembly of section .text:
   while (!input.eof () && ! Arch::isObjdumpTextMarker (line)) getline (input, line);
@@ -607,24 +665,19 @@ BuildCfg (const ConfigExtract & config)
 
       if (Arch::isFunction (line))	// function
 	{
-	  // if it is not the first function
-	  if (function.name != "")
-	    {
-	      // build the previously parsed function
-	      build_heptane_cfg (cfglib_program, bb_start_addr, instructions, function, succs, instrWithWords, MetaInstructionsTable);
-
-	      // and clean the variables for the current function
-	      instructions.clear ();
-	      bb_start_addr.clear ();
-	      succs.clear ();
-	      MetaInstructionsTable.clear();
-	    }
-
-	  function = Arch::parseFunction (line);
+	  code.push_back (FunctionCode ());
+	  code.back ().function = Arch::parseFunction (line);
+	  code.back ().cfg = cfglib_program.GetCfgByName (code.back ().function.name);
+	  if (code.back ().cfg == (cfglib::Cfg *) 0)
+	    Logger::addFatal ("CFG extractor: cfg does not exist in symbol table " + code.back ().function.name);
 	}
-      else if (Arch::isInstruction (line)) // instruction
+      else if (Arch::isInstruction (line) && !code.empty ()) // instruction
 	{
 	  ObjdumpInstruction instr = Arch::parseInstruction (line);
+	  vector < ObjdumpInstruction > &instructions = code.back ().instructions;
+	  map < int, ObjdumpInstruction > &MetaInstructionsTable = code.back ().MetaInstructionsTable;
+	  set < t_address > &bb_start_addr = code.back ().bb_start_addr;
+	  map < t_address, set < t_address > >&succs = code.back ().succs;
 
 	  // .word for ARM are not attached as instruction but as an attribute of an instruction
 	  if (isARMArchi && Arch::isWord (instr)) continue;
@@ -666,10 +719,31 @@ BuildCfg (const ConfigExtract & config)
     }
   input.close ();
 
-  // Build the last function
-  build_heptane_cfg (cfglib_program, bb_start_addr, instructions, function, succs, instrWithWords, MetaInstructionsTable);
+  // Build the functions. The parts of the code with the same function name, if any, share
+  // their cfg: they are built in order by the same task.
+  vector < vector < size_t > >parts;
+  map < cfglib::Cfg *, size_t > cfg_parts;
+  for (size_t f = 0; f < code.size (); f++)
+    {
+      map < cfglib::Cfg *, size_t >::const_iterator itp = cfg_parts.find (code[f].cfg);
+      if (itp == cfg_parts.end ())
+	{
+	  cfg_parts[code[f].cfg] = parts.size ();
+	  parts.push_back (vector < size_t > (1, f));
+	}
+      else
+	parts[itp->second].push_back (f);
+    }
+  forEachFunction (parts.size (), config.nb_threads, [&] (size_t c)
+    {
+      for (size_t j = 0; j < parts[c].size (); j++)
+	build_heptane_cfg (code[parts[c][j]], instrWithWords);
+    });
+  link_calls (code);
+  code.clear ();
+
   // Finalize program construction
-  finalize_program_construction (config, cfglib_program);
+  finalize_program_construction (config, cfglib_program, elf);
 
   // Export program in xml form
   exportCfg(cfglib_program);
@@ -0,0 +1,208 @@
+/* ---------------------------------------------------------------------
+
+   Copyright IRISA, 2003-2017
+
+   This file is part of Heptane, a tool for Worst-Case Execution Time (WCET) estimation.
+   APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+   Heptane is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Heptane is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details (COPYING.txt).
+
+   See CREDITS.txt for credits of authorship
+
+   ------------------------------------------------------------------------ */
+
+/** *****************************************************
+
+    Main file of the interference combiner
+
+    Loads the cache footprints of K tasks (written by the INTERFERENCE
+    analysis of HeptaneAnalysis, see FootprintFile.h) and prints, for
+    every cache level and for the instruction and data caches (and the
+    unified cache, when configured so), the K x K matrix of the number of blocks of the row task that may be
+    evicted by the column task.
+
+   ********************************************************/
+
+#include <vector>
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <set>
+#include <stdlib.h>
+
+#include "Logger.h"
+#include "FootprintFile.h"
+
+using namespace std;
+
+/** Kind of cache of an interference matrix */
+typedef enum
+{ INSTRUCTION_CACHE, DATA_CACHE, UNIFIED_CACHE } t_matrix_kind;
+
+/** Per-set arrays of a task for one cache (pointers into the mapped file, or into unified) */
+class TaskCache
+{
+public:
+  bool present;
+  uint32_t nbsets, nbways, cachelinesize;
+  const uint64_t *hb;
+  const uint64_t *cb;
+  vector < uint64_t > unified;	///< storage of hb and cb (2 x nbsets) for a unified cache
+
+    TaskCache ():present (false), nbsets (0), nbways (0), cachelinesize (0), hb (NULL), cb (NULL) {}
+};
+
+/** Fills tc with the arrays of task fp for the cache kind at level level. */
+static void
+getTaskCache (const FootprintFile & fp, uint32_t level, t_matrix_kind kind, TaskCache & tc)
+{
+  int ic = fp.findSection (level, FOOTPRINT_CODE);
+  int id = fp.findSection (level, FOOTPRINT_DATA);
+  int is = (kind == INSTRUCTION_CACHE) ? ic : id;
+
+  if (kind != UNIFIED_CACHE)
+    {
+      if (is < 0) return;
+      const FootprintSectionHeader & s = fp.getSection (is);
+      tc.present = true;
+      tc.nbsets = s.nbsets;
+      tc.nbways = s.nbways;
+      tc.cachelinesize = s.cachelinesize;
+      tc.hb = fp.getHB (is);
+      tc.cb = fp.getCB (is);
+      return;
+    }
+
+  // Unified cache: code and data blocks share the sets, when the cache of the level is configured as unified.
+  if (ic < 0 || id < 0) return;
+  const FootprintSectionHeader & c = fp.getSection (ic);
+  const FootprintSectionHeader & d = fp.getSection (id);
+  if (!(c.flags & FOOTPRINT_UNIFIED) || !(d.flags & FOOTPRINT_UNIFIED)) return;
+  if (c.nbsets != d.nbsets || c.nbways != d.nbways || c.cachelinesize != d.cachelinesize) return;
+  tc.present = true;
+  tc.nbsets = c.nbsets;
+  tc.nbways = c.nbways;
+  tc.cachelinesize = c.cachelinesize;
+  tc.unified.resize (2 * c.nbsets);
+  const uint64_t *hbc = fp.getHB (ic), *hbd = fp.getHB (id), *cbc = fp.getCB (ic), *cbd = fp.getCB (id);
+  for (uint32_t s = 0; s < c.nbsets; s++)
+    {
+      tc.unified[s] = hbc[s] + hbd[s];
+      tc.unified[c.nbsets + s] = cbc[s] + cbd[s];
+    }
+  tc.hb = &tc.unified[0];
+  tc.cb = &tc.unified[c.nbsets];
+}
+
+/** Prints the K x K eviction matrix of a cache kind at a level. */
+static void
+printMatrix (ostream & os, const vector < FootprintFile * >&footprints, const vector < string >&tasks, uint32_t level, t_matrix_kind kind)
+{
+  static const char *names[] = { "instruction", "data", "unified" };
+  size_t k = footprints.size ();
+
+  vector < TaskCache > caches (k);
+  bool any = false;
+  for (size_t t = 0; t < k; t++)
+    {
+      getTaskCache (*footprints[t], level, kind, caches[t]);
+      any = any || caches[t].present;
+    }
+  if (!any) return;
+
+  os << "# L" << level << " " << names[kind] << " cache: blocks of the row task evicted by the column task" << endl;
+  os << "task";
+  for (size_t j = 0; j < k; j++) os << "\t" << tasks[j];
+  os << endl;
+  for (size_t i = 0; i < k; i++)
+    {
+      os << tasks[i];
+      for (size_t j = 0; j < k; j++)
+	{
+	  const TaskCache & ci = caches[i];
+	  const TaskCache & cj = caches[j];
+	  if (i == j || !ci.present || !cj.present) { os << "\t-"; continue; }
+	  if (ci.nbsets != cj.nbsets || ci.nbways != cj.nbways || ci.cachelinesize != cj.cachelinesize)
+	    {
+	      Logger::addWarning ("HeptaneInterfere: " + tasks[i] + " and " + tasks[j] + " were analysed with different cache geometries");
+	      os << "\t-";
+	      continue;
+	    }
+	  os << "\t" << FootprintFile::evictions (ci.hb, cj.cb, ci.nbsets, ci.nbways);
+	}
+      os << endl;
+    }
+  os << endl;
+}
+
+/*!
+ * Entry point of the interference combiner
+ * Usage: HeptaneInterfere [-l level] [-o outputFile] footprintFile...
+ */
+int
+main (int argc, char **argv)
+{
+  int level = 0;		// 0: all the levels present in the footprints
+  string output_file;
+  vector < string > files;
+
+  for (int i = 1; i < argc; i++)
+    {
+      string arg = argv[i];
+      if (arg == "-l" && i + 1 < argc) level = atoi (argv[++i]);
+      else if (arg == "-o" && i + 1 < argc) output_file = argv[++i];
+      else files.push_back (arg);
+    }
+  if (files.empty () || level < 0)
+    Logger::addFatal ("Usage: HeptaneInterfere [-l level] [-o outputFile] footprintFile...");
+
+  // Load the footprints (mapped in memory, arrays used in place)
+  vector < FootprintFile * >footprints;
+  vector < string > tasks;
+  set < uint32_t > levels;
+  for (size_t f = 0; f < files.size (); f++)
+    {
+      string error;
+      FootprintFile *fp = new FootprintFile ();
+      if (!fp->open (files[f], error)) Logger::addFatal ("HeptaneInterfere: " + error);
+      footprints.push_back (fp);
+      tasks.push_back (fp->getTask ());
+      for (uint32_t s = 0; s < fp->getNbSections (); s++)
+	levels.insert (fp->getSection (s).level);
+    }
+  if (level != 0)
+    {
+      levels.clear ();
+      levels.insert (level);
+    }
+
+  ofstream ofs;
+  if (output_file != "")
+    {
+      ofs.open (output_file.c_str ());
+      if (!ofs.is_open ()) Logger::addFatal ("HeptaneInterfere: unable to open " + output_file);
+    }
+  ostream & os = (output_file != "") ? ofs : cout;
+
+  for (set < uint32_t >::iterator it = levels.begin (); it != levels.end (); ++it)
+    {
+      printMatrix (os, footprints, tasks, *it, INSTRUCTION_CACHE);
+      printMatrix (os, footprints, tasks, *it, DATA_CACHE);
+      printMatrix (os, footprints, tasks, *it, UNIFIED_CACHE);
+    }
+  Logger::print ();
+
+  // Cleaning
+  for (size_t f = 0; f < footprints.size (); f++)
+    delete footprints[f];
+  Logger::kill ();
+  return 0;
+}
@@ -0,0 +1,86 @@
+/* ---------------------------------------------------------------------
+
+   Copyright IRISA, 2003-2017
+
+   This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+   estimation.
+   APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+   Heptane is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Heptane is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details (COPYING.txt).
+
+   See CREDITS.txt for credits of authorship
+
+   ------------------------------------------------------------------------ */
+
+#ifndef _IRISA_CFGLIB_ATTRIBUTEKEY_H
+#define _IRISA_CFGLIB_ATTRIBUTEKEY_H
+
+/* #includes and forward declarations */
+#include <string>
+
+/*! this namespace is the global namespace */
+namespace cfglib
+{
+
+  /*! Interned attribute name.
+   * Attribute names are registered once in a global symbol table which maps
+   * them to small integer identifiers. Attributed objects store their
+   * attributes by identifier, so that an access through a key involves no
+   * string construction nor comparison. Keys of frequently accessed
+   * attributes should be built once and reused.
+   * Example:
+   *       static const AttributeKey k("myinteger");   // Interned once
+   *       n.SetAttribute(k, ia);
+   *       if (n.HasAttribute(k)) ia = n.GetAttribute(k);
+   * The string APIs of Attributed intern the name on each call.
+   */
+  class AttributeKey {
+  public:
+    /*! Invalid key, designates no name */
+    static const unsigned int NoId = (unsigned int) -1;
+
+    /*! Builds an invalid key */
+    AttributeKey() : id(NoId) {}
+
+    /*! Interns name (registers it when not already known) */
+    explicit AttributeKey(std::string const& name);
+
+    /*! Returns true, and sets key, when name has already been interned.
+     * The symbol table is not modified, so that looking up an absent
+     * attribute by name does not grow it.
+     */
+    static bool Find(std::string const& name, AttributeKey& key);
+
+    /*! Returns the number of interned names */
+    static unsigned int Count();
+
+    /*! Identifier of the key, in [0, Count()[ */
+    unsigned int GetId() const { return id; }
+
+    /*! Returns true for a key built from a name */
+    bool IsValid() const { return id != NoId; }
+
+    /*! Returns the interned name */
+    std::string const& GetName() const;
+
+    /*! Returns the name interned with identifier id */
+    static std::string const& GetName(unsigned int id);
+
+    bool operator==(AttributeKey const& k) const { return id == k.id; }
+    bool operator!=(AttributeKey const& k) const { return id != k.id; }
+    bool operator<(AttributeKey const& k) const { return id < k.id; }
+
+  private:
+    unsigned int id;
+  };
+
+} // cfglib::
+#endif // _IRISA_CFGLIB_ATTRIBUTEKEY_H
@@ -0,0 +1,97 @@
+/* ---------------------------------------------------------------------
+
+   Copyright IRISA, 2003-2017
+
+   This file is part of Heptane, a tool for Worst-Case Execution Time (WCET)
+   estimation.
+   APP deposit IDDN.FR.001.510039.000.S.P.2003.000.10600
+
+   Heptane is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   Heptane is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details (COPYING.txt).
+
+   See CREDITS.txt for credits of authorship
+
+   ------------------------------------------------------------------------ */
+
+#ifndef _IRISA_CFGLIB_ATTRIBUTELAYER_H
+#define _IRISA_CFGLIB_ATTRIBUTELAYER_H
+
+/* #includes and forward declarations */
+#include <cstddef>
+#include <map>
+#include <unordered_map>
+namespace cfglib { class Attribute ; }
+namespace cfglib { class Attributed ; }
+
+/*! this namespace is the global namespace */
+namespace cfglib
+{
+
+  /*! Discardable layer of attribute writes, used instead of a clone of
+   * the program when the results of an analysis are not kept.
+   *
+   * While a layer is open on a thread, the first time an attribute of
+   * an object is set or removed by this thread, the attribute it
+   * replaces is not deleted but kept by the layer. Discard puts the
+   * kept attributes back (and deletes the ones written since the
+   * opening), Commit deletes them. Both cost O(number of attributes
+   * written), whatever the size of the program.
+   *
+   * The program is shared, not copied, so that while a layer is open:
+   * - the nodes, edges, loops and cfgs must not be added or removed
+   *   (the objects created then deleted before the end of the layer,
+   *   e.g. a program read from a file, are allowed);
+   * - the attributes attached before the opening must be replaced by
+   *   SetAttribute, not modified in place through GetAttribute.
+   * Layers are not nested: at most one is open per thread. */
+  class AttributeLayer {
+  private:
+    /*! Attributes replaced by the layer, for every object written:
+     * identifier -> former attribute (NULL when there was none) */
+    typedef std::map< unsigned int, Attribute* > kept_attributes;
+    std::unordered_map< Attributed*, kept_attributes > kept;
+    size_t nb_written;
+    bool open;
+
+    /*! Called before the attribute of identifier id of object is
+     * replaced or removed. @return true when previous (possibly NULL)
+     * is kept by the layer, false when the attribute had already been
+     * written since the opening (it is to be deleted by the caller). */
+    bool Keep(Attributed* object, unsigned int id, Attribute* previous) ;
+
+    /*! Called when object is deleted: the attributes kept for it are deleted */
+    void Forget(Attributed* object) ;
+
+    /*! Unbinds the layer from the calling thread */
+    void Close() ;
+
+    friend class Attributed;
+  public:
+    /*! Opens the layer on the calling thread */
+    AttributeLayer() ;
+
+    /*! Discards the writes, if neither Commit nor Discard was called */
+    ~AttributeLayer() ;
+
+    /*! Puts back the attributes as they were at the opening and closes the layer */
+    void Discard() ;
+
+    /*! Keeps the attributes written and closes the layer */
+    void Commit() ;
+
+    /*! Number of attributes written (set or removed) since the opening */
+    size_t GetNbWritten() const { return nb_written; }
+
+    /*! Layer open on the calling thread, NULL if none */
+    static AttributeLayer* Current() ;
+  } ;
+
+} // cfglib::
+#endif // _IRISA_CFGLIB_ATTRIBUTELAYER_H
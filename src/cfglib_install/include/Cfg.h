@@ -202,6 +202,10 @@ namespace cfglib
 
     /*! Deserialisation function. */
     virtual void ReadXml(XmlTag const* tag, Handle& hand);
+
+    /*! Binary serialisation functions (see BinarySerialisation.h) */
+    void WriteBinary(BinaryWriter& w, Handle& hand);
+    void ReadBinary(BinaryReader& r, Handle& hand);
     
     /** Prints the associated names of the CFG */
     // void printNames(); void printNames(std::ostream& os) ;
@@ -24,7 +24,10 @@ See CREDITS.txt for credits of authorship
 #define _IRISA_CFGLIB_H
 
 /* #includes and forward declarations : */
+#include "Arena.h"
+#include "AttributeKey.h"
 #include "Attributed.h"
+#include "AttributeLayer.h"
 #include "NonSerialisableAttributes.h"
 #include "SerialisableAttributes.h"
 #include "Node.h"
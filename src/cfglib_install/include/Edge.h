@@ -88,6 +88,10 @@ namespace cfglib
      * which initialize the object with correct values. */
     virtual void ReadXml(XmlTag const* tag, Handle& handle);
 
+    /*! Binary serialisation functions (see BinarySerialisation.h) */
+    void WriteBinary(BinaryWriter& w, Handle& hand);
+    void ReadBinary(BinaryReader& r, Handle& hand);
+
 
   };
 
@@ -54,11 +54,25 @@ namespace cfglib
      * constructor function. */
     void SetAttributeType(std::string const&, SerialisableAttribute*) ;
 
-    /*! Access to global attribute factory */
+    /*! prototype registered for a type identifier, NULL if there is none */
+    SerialisableAttribute *GetAttributeType(std::string const& type) ;
+
+    /*! Access to global attribute factory (to the factory bound to
+     *  the calling thread, if any, see Bind) */
     static AttributesFactory* GetInstance();
 
     /*! Declare end of access of attribute factory */
     static void KillInstance();
+
+    /*! creation of a factory which is not the global one (basic types only) */
+    static AttributesFactory* Create();
+
+    /*! deletion of a factory built by Create, with its prototypes */
+    static void Destroy(AttributesFactory* factory);
+
+    /*! The calling thread uses factory instead of the global one (NULL: back
+     *  to the global one). @return the factory previously bound. */
+    static AttributesFactory* Bind(AttributesFactory* factory);
   } ;
 
 } // cfglib::
@@ -26,6 +26,7 @@ See CREDITS.txt for credits of authorship
 /*! #includes and forward declarations */
 #include <map>
 #include <set>
+#include <vector>
 #include "Factory.h"
 /*! #includes and forward declarations */
 #include "Serialisable.h"
@@ -46,6 +47,14 @@ namespace cfglib
     /*! map used to resolve the undefined referenced Serialisable associated to an id*/
     std::map<std::string,std::set<Serialisable**> > id_handle;
 
+    /*! same as id_serialisable and id_handle, for the integer identifiers
+     * (the ones given by identify, used by both serialisation formats) */
+    std::vector<Serialisable*> int_serialisable;
+    std::map<int, std::vector<Serialisable**> > int_handle;
+
+    /*! true, and sets id, when s is the decimal writing of an integer identifier */
+    static bool isIntegerId(std::string const& s, int& id);
+
     /*! maps used for serisalisation to attribute a unique identifier to a serialisable object*/
     std::map<Serialisable const*, int> identifiers ;
     
@@ -59,12 +68,14 @@ namespace cfglib
      * ATTENTION : ptr must be use only with no ordered structure !!! */
     //void decl_node_handle(Node*&, std::string const& id);
     void addID_handle(std::string const& id,Serialisable** ptr);
+    void addID_handle(int id,Serialisable** ptr);
 
     /*! Declare a Serialisable and its identifier. Objects are
      * declared by the library, an also by library
      * user. */
     //void decl_node_object(Node*, std::string const&);
     void addID_serialisable(std::string const& , Serialisable*);
+    void addID_serialisable(int, Serialisable*);
 
     /*! during serialisation give a unique identifier
      * for each Serialisable object. Identity of objects
@@ -73,6 +84,9 @@ namespace cfglib
      * serialisation. */
     std::string identify(Serialisable const* obj);
 
+    /*! integer form of identify */
+    int identifier(Serialisable const* obj);
+
 
     /*! Replace all handles with their final value.
      * not intended for library user, this function is
@@ -72,6 +72,10 @@ namespace cfglib
 
     /*! Unserialisation function */
     virtual void ReadXml( XmlTag const* tag, Handle& hand) ;
+
+    /*! Binary serialisation functions (see BinarySerialisation.h) */
+    void WriteBinary(BinaryWriter& w, Handle& hand);
+    void ReadBinary(BinaryReader& r, Handle& hand);
 			
     /*! get the assembly code line */
     std::string GetCode() ;
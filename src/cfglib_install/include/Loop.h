@@ -65,6 +65,10 @@ namespace cfglib
     /*! Deserialisation function. */
     virtual void ReadXml( XmlTag const *tag, Handle& hand) ;
 
+    /*! Binary serialisation functions (see BinarySerialisation.h) */
+    void WriteBinary(BinaryWriter& w, Handle& hand);
+    void ReadBinary(BinaryReader& r, Handle& hand);
+
     /*! Add nodes to the loop, the first Node added must be
      * the head of the loop */
     void AddNode(Node*) ;
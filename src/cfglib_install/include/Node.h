@@ -114,6 +114,10 @@ namespace cfglib
     /*! Unserialisation */
     virtual void ReadXml( XmlTag const* tag, Handle& hand); 
 
+    /*! Binary serialisation functions (see BinarySerialisation.h) */
+    void WriteBinary(BinaryWriter& w, Handle& hand);
+    void ReadBinary(BinaryReader& r, Handle& hand);
+
     /*! Returns the node type */
     node_type GetType() {return type;}
 
@@ -48,6 +48,7 @@ namespace cfglib
     listOfCfg cfgs_list ;
     Cfg* entry_point;
     string name;
+    Arena* arena; // Memory of the objects and attributes of this program
   public:
 
     Handle hand; // Memory of id-pointer mapping for all objects of this program
@@ -62,6 +63,14 @@ namespace cfglib
     /** destructor */
     ~Program();
 
+    /** The program itself is not allocated in its arena */
+    static void* operator new(size_t size) { return ::operator new(size); }
+    static void operator delete(void* p) { ::operator delete(p); }
+
+    /** Arena of the Cfgs, Nodes, Edges, Instructions, Loops and
+	attributes of the program (see Arena.h), freed with it */
+    Arena* GetArena();
+
     /** Get program name */
     string GetName() const;
 
@@ -107,7 +116,8 @@ namespace cfglib
     /** Deserialisation function. This function is the one
 	really meant for user usage. ReadXml should not be
 	used. cf. unserialise_program for precision on
-	arguments. */
+	arguments. The binary files (serialise_program_binary)
+	are recognised by their magic number. */
     static Program *unserialise_program_file(std::string const& file_name) ;
     
     /** Serialisation function. */
@@ -116,6 +126,21 @@ namespace cfglib
     /** Serialisation to file function */
     void serialise_program(std::string& file_name) ;
 
+    /** Binary serialisation functions (see BinarySerialisation.h) */
+    void WriteBinary(BinaryWriter& w, Handle& hand);
+    void ReadBinary(BinaryReader& r, Handle& hand);
+
+    /** Binary deserialisation function: file_name is mapped in memory and
+	the attributes of the Cfgs, Nodes, Instructions, Edges and Loops are
+	decoded at their first access. */
+    static Program *unserialise_program_binary(std::string const& file_name) ;
+
+    /** Binary serialisation to file function */
+    void serialise_program_binary(std::string const& file_name) ;
+
+    /** Returns true if file_name is a binary program file (magic number) */
+    static bool is_binary_program_file(std::string const& file_name) ;
+
   } ;
 
 } // cfglib::
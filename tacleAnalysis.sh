@@ -36,9 +36,9 @@ if [ ! -d "${RESULT_DIR}" ];then
     exit -1
 fi
 
-if [ "$3" != "lp_solve" ] && [ "$3" != "cplex" ]
+if [ "$3" != "lp_solve" ] && [ "$3" != "cplex" ] && [ "$3" != "simplex" ]
 then
-    echo ">>> ERROR: Unknown solver: $3 !, waiting for lp_solve or cplex."
+    echo ">>> ERROR: Unknown solver: $3 !, waiting for lp_solve, cplex or simplex."
     exit -1
 fi
 